@@ -56,6 +56,27 @@ struct HashInstantiationSignature
     size_t operator()(const InstantiationSignature& signature) const;
 };
 
+struct TypeFamilyApplication
+{
+    const TypeFamily* family = nullptr;
+    std::vector<TypeId> arguments;
+
+    bool operator==(const TypeFamilyApplication& rhs) const;
+};
+
+struct HashTypeFamilyApplication
+{
+    size_t operator()(const TypeFamilyApplication& application) const;
+};
+
+struct ConstraintSolverStats
+{
+    // Number of times the solver tried to dispatch an unblocked constraint
+    size_t dispatchAttempts = 0;
+    // Number of attempts that dispatched the constraint; all other attempts had to be retried later
+    size_t dispatched = 0;
+};
+
 struct ConstraintSolver
 {
     NotNull<TypeArena> arena;
@@ -83,6 +104,8 @@ struct ConstraintSolver
     std::unordered_map<BlockedConstraintId, DenseHashSet<const Constraint*>, HashBlockedConstraintId> blocked;
     // Memoized instantiations of type aliases.
     DenseHashMap<InstantiationSignature, TypeId, HashInstantiationSignature> instantiatedAliases{{}};
+    // Memoized reductions of type family instances that are applied to fully resolved types.
+    DenseHashMap<TypeFamilyApplication, TypeId, HashTypeFamilyApplication> reducedTypeFamilies{{}};
     // Breadcrumbs for where a free type's upper bound was expanded. We use
     // these to provide more helpful error messages when a free type is solved
     // as never unexpectedly.
@@ -109,6 +132,8 @@ struct ConstraintSolver
 
     DenseHashMap<TypeId, const Constraint*> typeFamiliesToFinalize{nullptr};
 
+    ConstraintSolverStats stats;
+
     explicit ConstraintSolver(NotNull<Normalizer> normalizer, NotNull<Scope> rootScope, std::vector<NotNull<Constraint>> constraints,
         ModuleName moduleName, NotNull<ModuleResolver> moduleResolver, std::vector<RequireCycle> requireCycles, DcrLogger* logger,
         TypeCheckLimits limits);
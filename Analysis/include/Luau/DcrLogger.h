@@ -16,6 +16,8 @@
 namespace Luau
 {
 
+struct ConstraintSolverStats;
+
 struct ErrorSnapshot
 {
     std::string message;
@@ -101,6 +103,8 @@ struct TypeSolveLog
     BoundarySnapshot initialState;
     std::vector<StepSnapshot> stepStates;
     BoundarySnapshot finalState;
+    size_t dispatchAttempts = 0;
+    size_t dispatched = 0;
 };
 
 struct TypeCheckLog
@@ -129,6 +133,7 @@ struct DcrLogger
         const Scope* rootScope, NotNull<const Constraint> current, bool force, const std::vector<NotNull<const Constraint>>& unsolvedConstraints);
     void commitStepSnapshot(StepSnapshot snapshot);
     void captureFinalSolverState(const Scope* rootScope, const std::vector<NotNull<const Constraint>>& unsolvedConstraints);
+    void captureSolverStats(const ConstraintSolverStats& stats);
 
     void captureTypeCheckError(const TypeError& error);
 
@@ -10,6 +10,8 @@
 #include "Luau/TypeCheckLimits.h"
 #include "Luau/Variant.h"
 
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -106,6 +108,20 @@ struct FrontendOptions
 
     // When true, some internal complexity limits will be scaled down for modules that miss the limit set by moduleTimeLimitSec
     bool applyInternalLimitScaling = false;
+
+    // When retaining full type graphs, limits the number of modules that keep them.
+    // Least recently checked modules only keep their public interface, errors and lint results.
+    // Use markDirty to check such a module again when its full type graph is needed.
+    std::optional<size_t> retainFullTypeGraphsLimit;
+
+    // When true, modules are only checked as much as needed to produce their public interface, which is cheaper for indexing modules that
+    // are not open for editing. Final error reporting passes, lints and full type graphs are skipped, and reported errors are incomplete.
+    // Checking such a module without this option will check it again along with its dependents.
+    bool interfaceOnly = false;
+
+    // When true, checkQueuedModules fully checks only the queued modules; the modules they require are only checked for their public interface.
+    // Used together with Frontend::shardModules when each process reports errors only for its own shard of a module graph.
+    bool dependenciesInterfaceOnly = false;
 };
 
 struct CheckResult
@@ -150,10 +166,18 @@ struct Frontend
         double timeParse = 0;
         double timeCheck = 0;
         double timeLint = 0;
+
+        // Breakdown of timeLint by lint pass
+        LintPassTimes timeLintPasses{};
     };
 
     Frontend(FileResolver* fileResolver, ConfigResolver* configResolver, const FrontendOptions& options = {});
 
+    // Creates a frontend that uses builtin types, global scopes, environments and builtin definitions of another frontend instead of its own
+    // The other frontend has to outlive this one; its global types have to be frozen and not modified after this point, through either frontend
+    // Since type checking only reads global types, frontends sharing them can check modules on different threads
+    Frontend(const Frontend& shared, FileResolver* fileResolver, ConfigResolver* configResolver, const FrontendOptions& options = {});
+
     // Parse module graph and prepare SourceNode/SourceModule data, including required dependencies without running typechecking
     void parse(const ModuleName& name);
 
@@ -188,6 +212,7 @@ struct Frontend
 
     // Batch module checking. Queue modules and check them together, retrieve results with 'getCheckResult'
     // If provided, 'executeTask' function is allowed to call the 'task' function on any thread and return without waiting for 'task' to complete
+    // In that case module sources are also read and parsed in parallel, so FileResolver methods have to be safe to call from multiple threads
     void queueModuleCheck(const std::vector<ModuleName>& names);
     void queueModuleCheck(const ModuleName& name);
     std::vector<ModuleName> checkQueuedModules(std::optional<FrontendOptions> optionOverride = {},
@@ -195,12 +220,30 @@ struct Frontend
 
     std::optional<CheckResult> getCheckResult(const ModuleName& name, bool accumulateNested, bool forAutocomplete = false);
 
+    // Splits modules into 'shardCount' groups of similar size for checking by separate processes, parsing the module graph if needed
+    // The result only depends on the module names and sources, so every process computes the same shards; dependencies are kept in earlier or
+    // the same shards as the modules requiring them, so that a shard and its dependencies overlap with few other shards
+    std::vector<std::vector<ModuleName>> shardModules(const std::vector<ModuleName>& names, size_t shardCount);
+
 private:
     ModulePtr check(const SourceModule& sourceModule, Mode mode, std::vector<RequireCycle> requireCycles, std::optional<ScopePtr> environmentScope,
-        bool forAutocomplete, bool recordJsonLog, TypeCheckLimits typeCheckLimits);
+        bool forAutocomplete, bool recordJsonLog, TypeCheckLimits typeCheckLimits, bool interfaceOnly = false);
+
+    struct ParsedSource
+    {
+        std::optional<SourceModule> sourceModule;
+        RequireTraceResult requireTrace;
+        Stats stats;
+    };
 
     std::pair<SourceNode*, SourceModule*> getSourceNode(const ModuleName& name);
+    ParsedSource parseSource(const ModuleName& name, const ParseOptions& parseOptions);
+    std::pair<SourceNode*, SourceModule*> commitSource(const ModuleName& name, ParsedSource&& parsed);
     SourceModule parse(const ModuleName& name, std::string_view src, const ParseOptions& parseOptions);
+    SourceModule parse(const ModuleName& name, std::string_view src, const ParseOptions& parseOptions, Stats& parseStats);
+
+    void parseModules(
+        const std::vector<ModuleName>& roots, bool forAutocomplete, const std::function<void(std::function<void()> task)>& executeTask);
 
     bool parseGraph(
         std::vector<ModuleName>& buildQueue, const ModuleName& root, bool forAutocomplete, std::function<bool(const ModuleName&)> canSkip = {});
@@ -210,6 +253,7 @@ private:
     void checkBuildQueueItem(BuildQueueItem& item);
     void checkBuildQueueItems(std::vector<BuildQueueItem>& items);
     void recordItemResult(const BuildQueueItem& item);
+    void releaseRetainedTypeGraphs(size_t limit);
 
     static LintResult classifyLints(const std::vector<LintWarning>& warnings, const Config& config);
 
@@ -220,6 +264,9 @@ private:
 
     BuiltinTypes builtinTypes_;
 
+    // Modules that keep full type graphs under FrontendOptions::retainFullTypeGraphsLimit, least recently checked first
+    std::deque<std::weak_ptr<Module>> retainedTypeGraphs;
+
 public:
     const NotNull<BuiltinTypes> builtinTypes;
 
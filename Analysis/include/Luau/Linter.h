@@ -4,6 +4,7 @@
 #include "Luau/LinterConfig.h"
 #include "Luau/Location.h"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,8 +26,12 @@ struct LintResult
     std::vector<LintWarning> warnings;
 };
 
+// Time spent in each lint pass, in seconds
+// Passes that report several kinds of warnings are accounted under the first warning code they report
+using LintPassTimes = std::array<double, LintWarning::Code__Count>;
+
 std::vector<LintWarning> lint(AstStat* root, const AstNameTable& names, const ScopePtr& env, const Module* module,
-    const std::vector<HotComment>& hotcomments, const LintOptions& options);
+    const std::vector<HotComment>& hotcomments, const LintOptions& options, LintPassTimes* passTimes = nullptr);
 
 std::vector<AstName> getDeprecatedGlobals(const AstNameTable& names);
 
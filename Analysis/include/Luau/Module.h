@@ -61,6 +61,8 @@ struct RequireCycle
     std::vector<ModuleName> path; // one of the paths for a require() to go all the way back to the originating module
 };
 
+struct AutocompletePropertyCache;
+
 struct Module
 {
     ~Module();
@@ -122,10 +124,14 @@ struct Module
     double checkDurationSec = 0.0;
     bool timeout = false;
     bool cancelled = false;
+    bool interfaceOnly = false;
 
     TypePackId returnType = nullptr;
     std::unordered_map<Name, TypeFun> exportedTypeBindings;
 
+    // Property completions of types referenced by this module, created by autocomplete and dropped together with the module on re-check
+    std::shared_ptr<AutocompletePropertyCache> autocompletePropertyCache;
+
     bool hasModuleScope() const;
     ScopePtr getModuleScope() const;
 
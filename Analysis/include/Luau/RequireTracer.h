@@ -4,8 +4,10 @@
 #include "Luau/DenseHash.h"
 #include "Luau/FileResolver.h"
 #include "Luau/Location.h"
+#include "Luau/ParseOptions.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Luau
@@ -25,4 +27,18 @@ struct RequireTraceResult
 
 RequireTraceResult traceRequires(FileResolver* fileResolver, AstStatBlock* root, const ModuleName& currentModuleName);
 
+struct RequireScanResult
+{
+    std::vector<std::pair<ModuleName, Location>> requireList;
+
+    // set when the source used patterns that the lexer scan doesn't handle and had to be parsed instead
+    bool parsed = false;
+};
+
+// Finds the modules required by the source without parsing it, for dependency queries that don't need the AST. The source is scanned with the
+// lexer for require calls with string or path arguments, where paths may start from locals initialized with a path; the argument expressions
+// are then resolved like traceRequires does. Sources with other uses of require, shadowed or reassigned path roots, or type assertions that
+// aren't simple expressions are parsed and traced instead, so the result matches the requireList of traceRequires for the parsed source.
+RequireScanResult scanRequires(FileResolver* fileResolver, std::string_view source, const ModuleName& currentModuleName, ParseOptions options = {});
+
 } // namespace Luau
@@ -4,6 +4,7 @@
 #include "Luau/Location.h"
 #include "Luau/ParseOptions.h"
 
+#include <functional>
 #include <string>
 
 namespace Luau
@@ -25,6 +26,9 @@ void dump(AstNode* node);
 std::string transpile(AstStatBlock& ast);
 std::string transpileWithTypes(AstStatBlock& block);
 
+// Passes the output to the callback in chunks of bounded size instead of building it in memory; the chunks add up to the result of transpile
+void transpile(AstStatBlock& ast, const std::function<void(std::string_view)>& output, bool withTypes = false);
+
 // Only fails when parsing fails
 TranspileResult transpile(std::string_view source, ParseOptions options = ParseOptions{}, bool withTypes = false);
 
@@ -20,6 +20,17 @@ namespace Luau
 namespace
 {
 
+// Statements of a block are ordered by their location, so only the few around the position need to be visited
+void visitStatementsAround(AstStatBlock* block, Position pos, AstVisitor* visitor)
+{
+    AstStat* const* it = std::lower_bound(block->body.begin(), block->body.end(), pos, [](AstStat* stat, Position pos) {
+        return stat->location.end < pos;
+    });
+
+    for (; it != block->body.end() && (*it)->location.begin <= pos; ++it)
+        (*it)->visit(visitor);
+}
+
 struct AutocompleteNodeFinder : public AstVisitor
 {
     const Position pos;
@@ -82,7 +93,8 @@ struct AutocompleteNodeFinder : public AstVisitor
         if (ancestry.empty())
         {
             ancestry.push_back(block);
-            return true;
+            visitStatementsAround(block, pos, this);
+            return false;
         }
 
         // AstExprIndexName nodes are nested outside-in, so we want the outermost node in the case of nested nodes.
@@ -111,7 +123,7 @@ struct AutocompleteNodeFinder : public AstVisitor
         if (block->location.begin <= pos && pos <= block->location.end)
         {
             ancestry.push_back(block);
-            return true;
+            visitStatementsAround(block, pos, this);
         }
         return false;
     }
@@ -162,17 +174,7 @@ struct FindNode : public AstVisitor
     bool visit(AstStatBlock* block) override
     {
         visit(static_cast<AstNode*>(block));
-
-        for (AstStat* stat : block->body)
-        {
-            if (stat->location.end < pos)
-                continue;
-            if (stat->location.begin > pos)
-                break;
-
-            stat->visit(this);
-        }
-
+        visitStatementsAround(block, pos, this);
         return false;
     }
 };
@@ -209,6 +211,13 @@ struct FindFullAncestry final : public AstVisitor
         return false;
     }
 
+    bool visit(AstStatBlock* block) override
+    {
+        if (visit(static_cast<AstNode*>(block)))
+            visitStatementsAround(block, pos, this);
+        return false;
+    }
+
     bool visit(AstNode* node) override
     {
         if (node->location.contains(pos))
@@ -398,15 +407,13 @@ struct FindExprOrLocal : public AstVisitor
 
     bool visit(AstStatBlock* block) override
     {
-        for (AstStat* stat : block->body)
-        {
-            if (stat->location.end <= pos)
-                continue;
-            if (stat->location.begin > pos)
-                break;
+        // like visitStatementsAround, but statements that end at the position are skipped
+        AstStat* const* it = std::lower_bound(block->body.begin(), block->body.end(), pos, [](AstStat* stat, Position pos) {
+            return stat->location.end <= pos;
+        });
 
-            stat->visit(this);
-        }
+        for (; it != block->body.end() && (*it)->location.begin <= pos; ++it)
+            (*it)->visit(this);
 
         return false;
     }
@@ -209,6 +209,19 @@ enum class PropIndexType
     Key,
 };
 
+// Type correctness and parentheses recommendations of Point and Colon completions depend on the completion location and are not cached
+struct AutocompletePropertyCache
+{
+    DenseHashMap<TypeId, AutocompleteEntryMap> point{nullptr};
+    DenseHashMap<TypeId, AutocompleteEntryMap> colon{nullptr};
+    DenseHashMap<TypeId, AutocompleteEntryMap> key{nullptr};
+
+    DenseHashMap<TypeId, AutocompleteEntryMap>& get(PropIndexType indexType)
+    {
+        return indexType == PropIndexType::Point ? point : indexType == PropIndexType::Colon ? colon : key;
+    }
+};
+
 static void autocompleteProps(const Module& module, TypeArena* typeArena, NotNull<BuiltinTypes> builtinTypes, TypeId rootTy, TypeId ty,
     PropIndexType indexType, const std::vector<AstNode*>& nodes, AutocompleteEntryMap& result, std::unordered_set<TypeId>& seen,
     std::optional<const ClassType*> containingClass = std::nullopt)
@@ -284,15 +297,11 @@ static void autocompleteProps(const Module& module, TypeArena* typeArena, NotNul
                 else
                     type = follow(prop.type());
 
-                TypeCorrectKind typeCorrect = indexType == PropIndexType::Key
-                                                  ? TypeCorrectKind::Correct
-                                                  : checkTypeCorrectKind(module, typeArena, builtinTypes, nodes.back(), {{}, {}}, type);
-
-                ParenthesesRecommendation parens =
-                    indexType == PropIndexType::Key ? ParenthesesRecommendation::None : getParenRecommendation(type, nodes, typeCorrect);
+                // Filled in by fillPropTypeCorrectness for Point and Colon completions
+                TypeCorrectKind typeCorrect = indexType == PropIndexType::Key ? TypeCorrectKind::Correct : TypeCorrectKind::None;
 
                 result[name] = AutocompleteEntry{AutocompleteEntryKind::Property, type, prop.deprecated, isWrongIndexer(type), typeCorrect,
-                    containingClass, &prop, prop.documentationSymbol, {}, parens, {}, indexType == PropIndexType::Colon};
+                    containingClass, &prop, prop.documentationSymbol, {}, ParenthesesRecommendation::None, {}, indexType == PropIndexType::Colon};
             }
         }
     };
@@ -429,11 +438,51 @@ static void autocompleteKeywords(
     }
 }
 
+static void fillPropTypeCorrectness(
+    const Module& module, TypeArena* typeArena, NotNull<BuiltinTypes> builtinTypes, const std::vector<AstNode*>& nodes, AutocompleteEntry& entry)
+{
+    LUAU_ASSERT(entry.type);
+
+    entry.typeCorrect = checkTypeCorrectKind(module, typeArena, builtinTypes, nodes.back(), {{}, {}}, *entry.type);
+    entry.parens = getParenRecommendation(*entry.type, nodes, entry.typeCorrect);
+}
+
 static void autocompleteProps(const Module& module, TypeArena* typeArena, NotNull<BuiltinTypes> builtinTypes, TypeId ty, PropIndexType indexType,
     const std::vector<AstNode*>& nodes, AutocompleteEntryMap& result)
 {
-    std::unordered_set<TypeId> seen;
-    autocompleteProps(module, typeArena, builtinTypes, ty, ty, indexType, nodes, result, seen);
+    ty = follow(ty);
+
+    // Types of a checked module do not change, so the walk over tables, metatables and class hierarchies is only done once per type
+    AutocompleteEntryMap uncached;
+    const AutocompleteEntryMap* props = nullptr;
+
+    if (AutocompletePropertyCache* cache = module.autocompletePropertyCache.get())
+    {
+        AutocompleteEntryMap& cached = cache->get(indexType)[ty];
+
+        if (cached.empty())
+        {
+            std::unordered_set<TypeId> seen;
+            autocompleteProps(module, typeArena, builtinTypes, ty, ty, indexType, nodes, cached, seen);
+        }
+
+        props = &cached;
+    }
+    else
+    {
+        std::unordered_set<TypeId> seen;
+        autocompleteProps(module, typeArena, builtinTypes, ty, ty, indexType, nodes, uncached, seen);
+
+        props = &uncached;
+    }
+
+    for (const auto& [name, entry] : *props)
+    {
+        auto [it, inserted] = result.insert({name, entry});
+
+        if (inserted && indexType != PropIndexType::Key)
+            fillPropTypeCorrectness(module, typeArena, builtinTypes, nodes, it->second);
+    }
 }
 
 AutocompleteEntryMap autocompleteProps(const Module& module, TypeArena* typeArena, NotNull<BuiltinTypes> builtinTypes, TypeId ty,
@@ -1839,6 +1888,9 @@ AutocompleteResult autocomplete(Frontend& frontend, const ModuleName& moduleName
     if (!module)
         return {};
 
+    if (!module->autocompletePropertyCache)
+        module->autocompletePropertyCache = std::make_shared<AutocompletePropertyCache>();
+
     NotNull<BuiltinTypes> builtinTypes = frontend.builtinTypes;
     Scope* globalScope;
     if (FFlag::DebugLuauDeferredConstraintResolution)
@@ -836,9 +836,9 @@ TypeId makeStringMetatable(NotNull<BuiltinTypes> builtinTypes)
     FunctionType stringDotChar{numberVariadicList, arena->addTypePack({stringType})};
     stringDotChar.isCheckedFunction = true;
 
-    // string.unpack : string -> string -> number? -> ...any
+    // string.unpack : string -> (string | buffer) -> number? -> ...any
     FunctionType stringDotUnpack{
-        arena->addTypePack(TypePack{{stringType, stringType, optionalNumber}}),
+        arena->addTypePack(TypePack{{stringType, arena->addType(UnionType{{stringType, builtinTypes->bufferType}}), optionalNumber}}),
         variadicTailPack,
     };
     stringDotUnpack.isCheckedFunction = true;
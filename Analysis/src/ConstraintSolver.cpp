@@ -259,6 +259,21 @@ size_t HashInstantiationSignature::operator()(const InstantiationSignature& sign
     return hash;
 }
 
+bool TypeFamilyApplication::operator==(const TypeFamilyApplication& rhs) const
+{
+    return family == rhs.family && arguments == rhs.arguments;
+}
+
+size_t HashTypeFamilyApplication::operator()(const TypeFamilyApplication& application) const
+{
+    size_t hash = std::hash<const TypeFamily*>{}(application.family);
+
+    for (TypeId a : application.arguments)
+        hash ^= (std::hash<TypeId>{}(a) << 1);
+
+    return hash;
+}
+
 void dump(ConstraintSolver* cs, ToStringOptions& opts)
 {
     printf("constraints:\n");
@@ -386,37 +401,61 @@ void ConstraintSolver::run()
     auto runSolverPass = [&](bool force) {
         bool progress = false;
 
+        // Constraints that remain unsolved are moved down over the dispatched ones, which preserves their order without moving the whole
+        // tail of the list on every dispatch; [kept, i) is the gap left by the constraints dispatched so far
         size_t i = 0;
+        size_t kept = 0;
+
+        auto closeGap = [&] {
+            unsolvedConstraints.erase(unsolvedConstraints.begin() + kept, unsolvedConstraints.begin() + i);
+            i = kept;
+        };
+
         while (i < unsolvedConstraints.size())
         {
             NotNull<const Constraint> c = unsolvedConstraints[i];
             if (!force && isBlocked(c))
             {
+                unsolvedConstraints[kept++] = c;
                 ++i;
                 continue;
             }
 
             if (limits.finishTime && TimeTrace::getClock() > *limits.finishTime)
+            {
+                closeGap();
                 throwTimeLimitError();
+            }
             if (limits.cancellationToken && limits.cancellationToken->requested())
+            {
+                closeGap();
                 throwUserCancelError();
+            }
 
             std::string saveMe = FFlag::DebugLuauLogSolver ? toString(*c, opts) : std::string{};
             StepSnapshot snapshot;
 
             if (logger)
             {
+                closeGap();
                 snapshot = logger->prepareStepSnapshot(rootScope, c, force, unsolvedConstraints);
             }
 
+            stats.dispatchAttempts++;
+
             bool success = tryDispatch(c, force);
 
             progress |= success;
 
             if (success)
             {
+                stats.dispatched++;
+
                 unblock(c);
-                unsolvedConstraints.erase(unsolvedConstraints.begin() + i);
+                ++i;
+
+                if (FFlag::DebugLuauLogSolver)
+                    closeGap();
 
                 // decrement the referenced free types for this constraint if we dispatched successfully!
                 for (auto ty : c->getMaybeMutatedFreeTypes())
@@ -469,12 +508,19 @@ void ConstraintSolver::run()
                 }
             }
             else
+            {
+                unsolvedConstraints[kept++] = c;
                 ++i;
+            }
 
             if (force && success)
+            {
+                closeGap();
                 return true;
+            }
         }
 
+        closeGap();
         return progress;
     };
 
@@ -498,6 +544,7 @@ void ConstraintSolver::run()
     if (logger)
     {
         logger->captureFinalSolverState(rootScope, unsolvedConstraints);
+        logger->captureSolverStats(stats);
     }
 }
 
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 
+#include "Luau/ConstraintSolver.h"
 #include "Luau/JsonEmitter.h"
 
 namespace Luau
@@ -185,6 +186,8 @@ void write(JsonEmitter& emitter, const TypeSolveLog& log)
     o.writePair("initialState", log.initialState);
     o.writePair("stepStates", log.stepStates);
     o.writePair("finalState", log.finalState);
+    o.writePair("dispatchAttempts", log.dispatchAttempts);
+    o.writePair("dispatched", log.dispatched);
     o.finish();
 }
 
@@ -427,6 +430,12 @@ void DcrLogger::captureFinalSolverState(const Scope* rootScope, const std::vecto
     captureBoundaryState(solveLog.finalState, rootScope, unsolvedConstraints);
 }
 
+void DcrLogger::captureSolverStats(const ConstraintSolverStats& stats)
+{
+    solveLog.dispatchAttempts = stats.dispatchAttempts;
+    solveLog.dispatched = stats.dispatched;
+}
+
 void DcrLogger::captureTypeCheckError(const TypeError& error)
 {
     std::string stringifiedError = toString(error);
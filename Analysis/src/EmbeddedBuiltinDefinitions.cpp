@@ -16,6 +16,22 @@ declare buffer: {
     len: (b: buffer) -> number,
     copy: (target: buffer, targetOffset: number, source: buffer, sourceOffset: number?, count: number?) -> (),
     fill: (b: buffer, offset: number, value: number, count: number?) -> (),
+    compare: (a: buffer, aOffset: number, b: buffer, bOffset: number?, count: number?) -> number,
+    find: (b: buffer, offset: number, value: string, count: number?) -> number?,
+    crc32: (b: buffer, offset: number?, count: number?) -> number,
+    swap: (b: buffer, offset: number, count: number, width: number) -> (),
+    sumf32: (b: buffer, offset: number, count: number) -> number,
+    minf32: (b: buffer, offset: number, count: number) -> number,
+    maxf32: (b: buffer, offset: number, count: number) -> number,
+    dotf32: (a: buffer, aOffset: number, b: buffer, bOffset: number, count: number) -> number,
+    axpyf32: (target: buffer, targetOffset: number, alpha: number, source: buffer, sourceOffset: number, count: number) -> (),
+    clampf32: (b: buffer, offset: number, count: number, min: number, max: number) -> (),
+    sumf64: (b: buffer, offset: number, count: number) -> number,
+    minf64: (b: buffer, offset: number, count: number) -> number,
+    maxf64: (b: buffer, offset: number, count: number) -> number,
+    dotf64: (a: buffer, aOffset: number, b: buffer, bOffset: number, count: number) -> number,
+    axpyf64: (target: buffer, targetOffset: number, alpha: number, source: buffer, sourceOffset: number, count: number) -> (),
+    clampf64: (b: buffer, offset: number, count: number, min: number, max: number) -> (),
     readi8: (b: buffer, offset: number) -> number,
     readu8: (b: buffer, offset: number) -> number,
     readi16: (b: buffer, offset: number) -> number,
@@ -217,6 +233,7 @@ declare utf8: {
     charpattern: string,
     codes: (str: string) -> ((string, number) -> (number, number), string, number),
     codepoint: (str: string, i: number?, j: number?) -> ...number,
+    codepoints: (str: string, i: number?, j: number?) -> {number},
     len: (s: string, i: number?, j: number?) -> (number?, number?),
     offset: (s: string, n: number?, i: number?) -> number,
 }
@@ -409,6 +426,7 @@ declare utf8: {
     charpattern: string,
     codes: @checked (str: string) -> ((string, number) -> (number, number), string, number),
     codepoint: @checked (str: string, i: number?, j: number?) -> ...number,
+    codepoints: @checked (str: string, i: number?, j: number?) -> {number},
     len: @checked (s: string, i: number?, j: number?) -> (number?, number?),
     offset: @checked (s: string, n: number?, i: number?) -> number,
 }
@@ -425,6 +443,22 @@ declare buffer: {
     len: @checked (b: buffer) -> number,
     copy: @checked (target: buffer, targetOffset: number, source: buffer, sourceOffset: number?, count: number?) -> (),
     fill: @checked (b: buffer, offset: number, value: number, count: number?) -> (),
+    compare: @checked (a: buffer, aOffset: number, b: buffer, bOffset: number?, count: number?) -> number,
+    find: @checked (b: buffer, offset: number, value: string, count: number?) -> number?,
+    crc32: @checked (b: buffer, offset: number?, count: number?) -> number,
+    swap: @checked (b: buffer, offset: number, count: number, width: number) -> (),
+    sumf32: @checked (b: buffer, offset: number, count: number) -> number,
+    minf32: @checked (b: buffer, offset: number, count: number) -> number,
+    maxf32: @checked (b: buffer, offset: number, count: number) -> number,
+    dotf32: @checked (a: buffer, aOffset: number, b: buffer, bOffset: number, count: number) -> number,
+    axpyf32: @checked (target: buffer, targetOffset: number, alpha: number, source: buffer, sourceOffset: number, count: number) -> (),
+    clampf32: @checked (b: buffer, offset: number, count: number, min: number, max: number) -> (),
+    sumf64: @checked (b: buffer, offset: number, count: number) -> number,
+    minf64: @checked (b: buffer, offset: number, count: number) -> number,
+    maxf64: @checked (b: buffer, offset: number, count: number) -> number,
+    dotf64: @checked (a: buffer, aOffset: number, b: buffer, bOffset: number, count: number) -> number,
+    axpyf64: @checked (target: buffer, targetOffset: number, alpha: number, source: buffer, sourceOffset: number, count: number) -> (),
+    clampf64: @checked (b: buffer, offset: number, count: number, min: number, max: number) -> (),
     readi8: @checked (b: buffer, offset: number) -> number,
     readu8: @checked (b: buffer, offset: number) -> number,
     readi16: @checked (b: buffer, offset: number) -> number,
@@ -64,12 +64,40 @@ struct BuildQueueItem
     int dirtyDependencies = 0;
     bool processing = false;
 
+    // Estimated cost of the longest chain of items that can't start until this item is checked, including the item itself
+    size_t criticalPath = 0;
+
     // Result
     std::exception_ptr exception;
     ModulePtr module;
     Frontend::Stats stats;
 };
 
+// Releases type information of the module that isn't reachable from its public interface
+static void releaseTypeGraphs(Module& module, NotNull<BuiltinTypes> builtinTypes)
+{
+    // copyErrors needs to allocate into interfaceTypes as it copies
+    // types out of internalTypes, so we unfreeze it here.
+    unfreeze(module.interfaceTypes);
+    copyErrors(module.errors, module.interfaceTypes, builtinTypes);
+    freeze(module.interfaceTypes);
+
+    module.internalTypes.clear();
+
+    module.astTypes.clear();
+    module.astTypePacks.clear();
+    module.astExpectedTypes.clear();
+    module.astOriginalCallTypes.clear();
+    module.astOverloadResolvedTypes.clear();
+    module.astForInNextTypes.clear();
+    module.astResolvedTypes.clear();
+    module.astResolvedTypePacks.clear();
+    module.astCompoundAssignResultTypes.clear();
+    module.astScopes.clear();
+    module.upperBoundContributors.clear();
+    module.scopes.clear();
+}
+
 std::optional<Mode> parseMode(const std::vector<HotComment>& hotcomments)
 {
     for (const HotComment& hc : hotcomments)
@@ -423,6 +451,24 @@ Frontend::Frontend(FileResolver* fileResolver, ConfigResolver* configResolver, c
 {
 }
 
+Frontend::Frontend(const Frontend& shared, FileResolver* fileResolver, ConfigResolver* configResolver, const FrontendOptions& options)
+    : builtinTypes(shared.builtinTypes)
+    , fileResolver(fileResolver)
+    , moduleResolver(this)
+    , moduleResolverForAutocomplete(this)
+    , globals(builtinTypes)
+    , globalsForAutocomplete(builtinTypes)
+    , configResolver(configResolver)
+    , options(options)
+{
+    // global types live in the arenas of the shared frontend, only the scopes referring to them are taken
+    globals.globalScope = shared.globals.globalScope;
+    globalsForAutocomplete.globalScope = shared.globalsForAutocomplete.globalScope;
+
+    environments = shared.environments;
+    builtinDefinitions = shared.builtinDefinitions;
+}
+
 void Frontend::parse(const ModuleName& name)
 {
     LUAU_TIMETRACE_SCOPE("Frontend::parse", "Frontend");
@@ -444,6 +490,13 @@ CheckResult Frontend::check(const ModuleName& name, std::optional<FrontendOption
     if (FFlag::DebugLuauDeferredConstraintResolution)
         frontendOptions.forAutocomplete = false;
 
+    // Module that was only checked for its public interface has to be checked fully, dependents refer to its interface types
+    if (!frontendOptions.interfaceOnly && !frontendOptions.forAutocomplete)
+    {
+        if (ModulePtr module = moduleResolver.getModule(name); module && module->interfaceOnly)
+            markDirty(name);
+    }
+
     if (std::optional<CheckResult> result = getCheckResult(name, true, frontendOptions.forAutocomplete))
         return std::move(*result);
 
@@ -463,6 +516,9 @@ CheckResult Frontend::check(const ModuleName& name, std::optional<FrontendOption
 
     checkBuildQueueItems(buildQueueItems);
 
+    if (frontendOptions.retainFullTypeGraphsLimit)
+        releaseRetainedTypeGraphs(*frontendOptions.retainFullTypeGraphsLimit);
+
     // Collect results only for checked modules, 'getCheckResult' produces a different result
     CheckResult checkResult;
 
@@ -505,9 +561,31 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
     std::vector<ModuleName> currModuleQueue;
     std::swap(currModuleQueue, moduleQueue);
 
+    // Queued modules that were only checked for their public interface have to be checked fully, same as in 'check'
+    if (!frontendOptions.interfaceOnly && !frontendOptions.forAutocomplete)
+    {
+        for (const ModuleName& name : currModuleQueue)
+        {
+            if (ModulePtr module = moduleResolver.getModule(name); module && module->interfaceOnly)
+                markDirty(name);
+        }
+    }
+
     DenseHashSet<Luau::ModuleName> seen{{}};
     std::vector<BuildQueueItem> buildQueueItems;
 
+    // when tasks can run in parallel, sources of the module graph are read and parsed in parallel first; parseGraph will find them in cache
+    if (executeTask)
+    {
+        std::vector<ModuleName> roots;
+
+        for (const ModuleName& name : currModuleQueue)
+            if (isDirty(name, frontendOptions.forAutocomplete))
+                roots.push_back(name);
+
+        parseModules(roots, frontendOptions.forAutocomplete, executeTask);
+    }
+
     for (const ModuleName& name : currModuleQueue)
     {
         if (seen.contains(name))
@@ -530,6 +608,20 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
     if (buildQueueItems.empty())
         return {};
 
+    if (frontendOptions.dependenciesInterfaceOnly)
+    {
+        DenseHashSet<Luau::ModuleName> queued{{}};
+
+        for (const ModuleName& name : currModuleQueue)
+            queued.insert(name);
+
+        for (BuildQueueItem& item : buildQueueItems)
+        {
+            if (!queued.contains(item.name))
+                item.options.interfaceOnly = true;
+        }
+    }
+
     // We need a mapping from modules to build queue slots
     std::unordered_map<ModuleName, size_t> moduleNameToQueue;
 
@@ -598,7 +690,19 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
         }
     };
 
-    // In a first pass, check modules that have no dependencies and record info of those modules that wait
+    // When multiple items are ready, items on longer dependency chains are sent first so that the chains don't delay the end of the build
+    auto sendItemTasks = [&](std::vector<size_t>& items) {
+        std::stable_sort(items.begin(), items.end(), [&](size_t lhs, size_t rhs) {
+            return buildQueueItems[lhs].criticalPath > buildQueueItems[rhs].criticalPath;
+        });
+
+        for (size_t i : items)
+            sendItemTask(i);
+
+        items.clear();
+    };
+
+    // In a first pass, record info of modules that wait on their dependencies
     for (size_t i = 0; i < buildQueueItems.size(); i++)
     {
         BuildQueueItem& item = buildQueueItems[i];
@@ -615,16 +719,39 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
                 }
             }
         }
+    }
 
-        if (item.dirtyDependencies == 0)
-            sendItemTask(i);
+    // Items are in dependency order, so the critical path of each item can be computed from the items that depend on it in a reverse pass
+    // Module size in lines is used as an estimate of the time it takes to check it; in case of cycles, this is an approximation
+    for (size_t i = buildQueueItems.size(); i > 0; i--)
+    {
+        BuildQueueItem& item = buildQueueItems[i - 1];
+
+        size_t longestDependent = 0;
+
+        for (size_t reverseDep : item.reverseDeps)
+            longestDependent = std::max(longestDependent, buildQueueItems[reverseDep].criticalPath);
+
+        size_t cost = item.sourceModule->root ? item.sourceModule->root->location.end.line + 1 : 1;
+
+        item.criticalPath = cost + longestDependent;
+    }
+
+    // Check modules that have no dependencies
+    std::vector<size_t> nextItems;
+
+    for (size_t i = 0; i < buildQueueItems.size(); i++)
+    {
+        if (buildQueueItems[i].dirtyDependencies == 0)
+            nextItems.push_back(i);
     }
 
+    sendItemTasks(nextItems);
+
     // Not a single item was found, a cycle in the graph was hit
     if (processing == 0)
         sendCycleItemTask();
 
-    std::vector<size_t> nextItems;
     std::optional<size_t> itemWithException;
     bool cancelled = false;
 
@@ -691,9 +818,7 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
         }
 
         // Items cannot be submitted while holding the lock
-        for (size_t i : nextItems)
-            sendItemTask(i);
-        nextItems.clear();
+        sendItemTasks(nextItems);
 
         if (processing == 0)
         {
@@ -711,6 +836,9 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
             sendCycleItemTask();
     }
 
+    if (frontendOptions.retainFullTypeGraphsLimit)
+        releaseRetainedTypeGraphs(*frontendOptions.retainFullTypeGraphsLimit);
+
     std::vector<ModuleName> checkedModules;
     checkedModules.reserve(buildQueueItems.size());
 
@@ -753,6 +881,106 @@ std::optional<CheckResult> Frontend::getCheckResult(const ModuleName& name, bool
     return checkResult;
 }
 
+std::vector<std::vector<ModuleName>> Frontend::shardModules(const std::vector<ModuleName>& names, size_t shardCount)
+{
+    LUAU_TIMETRACE_SCOPE("Frontend::shardModules", "Frontend");
+    LUAU_ASSERT(shardCount != 0);
+
+    for (const ModuleName& name : names)
+        parse(name);
+
+    // Sorted names make the result independent of the order in which modules are listed
+    std::vector<ModuleName> roots = names;
+    std::sort(roots.begin(), roots.end());
+    roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+
+    DenseHashSet<ModuleName> requested{{}};
+
+    for (const ModuleName& name : roots)
+        requested.insert(name);
+
+    // Requested modules are placed after the modules they require; requires are visited in source order, which doesn't depend on hashing
+    std::vector<ModuleName> order;
+    order.reserve(roots.size());
+
+    DenseHashSet<ModuleName> visited{{}};
+    std::vector<std::pair<const SourceNode*, size_t>> stack;
+
+    for (const ModuleName& root : roots)
+    {
+        if (visited.contains(root))
+            continue;
+
+        visited.insert(root);
+
+        auto it = sourceNodes.find(root);
+
+        if (it == sourceNodes.end())
+        {
+            order.push_back(root);
+            continue;
+        }
+
+        stack.push_back({it->second.get(), 0});
+
+        while (!stack.empty())
+        {
+            auto& [node, nextRequire] = stack.back();
+
+            if (nextRequire < node->requireLocations.size())
+            {
+                const ModuleName& dep = node->requireLocations[nextRequire++].first;
+
+                if (visited.contains(dep))
+                    continue;
+
+                visited.insert(dep);
+
+                if (auto depIt = sourceNodes.find(dep); depIt != sourceNodes.end())
+                    stack.push_back({depIt->second.get(), 0});
+                else if (requested.contains(dep))
+                    order.push_back(dep);
+            }
+            else
+            {
+                if (requested.contains(node->name))
+                    order.push_back(node->name);
+
+                stack.pop_back();
+            }
+        }
+    }
+
+    // Module size in lines is used as an estimate of the time it takes to check it, same as for the critical path in 'checkQueuedModules'
+    std::vector<size_t> costs;
+    costs.reserve(order.size());
+
+    size_t totalCost = 0;
+
+    for (const ModuleName& name : order)
+    {
+        auto it = sourceModules.find(name);
+        size_t cost = it != sourceModules.end() && it->second->root ? it->second->root->location.end.line + 1 : 1;
+
+        costs.push_back(cost);
+        totalCost += cost;
+    }
+
+    // Contiguous ranges of the order are assigned to shards by the position of the middle of each module in the total cost
+    std::vector<std::vector<ModuleName>> shards(shardCount);
+    size_t costBefore = 0;
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        size_t shard = std::min(shardCount - 1, (costBefore + costs[i] / 2) * shardCount / totalCost);
+
+        shards[shard].push_back(std::move(order[i]));
+        costBefore += costs[i];
+    }
+
+    return shards;
+}
+
 bool Frontend::parseGraph(
     std::vector<ModuleName>& buildQueue, const ModuleName& root, bool forAutocomplete, std::function<bool(const ModuleName&)> canSkip)
 {
@@ -908,6 +1136,16 @@ static void applyInternalLimitScaling(SourceNode& sourceNode, const ModulePtr mo
 
 void Frontend::checkBuildQueueItem(BuildQueueItem& item)
 {
+    // Items that didn't start before the check was cancelled are skipped, releasing the worker threads as early as possible
+    if (item.options.cancellationToken && item.options.cancellationToken->requested())
+    {
+        item.module = std::make_shared<Module>();
+        item.module->name = item.name;
+        item.module->humanReadableName = item.sourceModule->humanReadableName;
+        item.module->cancelled = true;
+        return;
+    }
+
     SourceNode& sourceNode = *item.sourceNode;
     const SourceModule& sourceModule = *item.sourceModule;
     const Config& config = item.config;
@@ -967,7 +1205,8 @@ void Frontend::checkBuildQueueItem(BuildQueueItem& item)
         return;
     }
 
-    ModulePtr module = check(sourceModule, mode, requireCycles, environmentScope, /*forAutocomplete*/ false, item.recordJsonLog, typeCheckLimits);
+    ModulePtr module = check(sourceModule, mode, requireCycles, environmentScope, /*forAutocomplete*/ false, item.recordJsonLog, typeCheckLimits,
+        item.options.interfaceOnly);
 
     double duration = getTimestamp() - timestamp;
 
@@ -986,7 +1225,7 @@ void Frontend::checkBuildQueueItem(BuildQueueItem& item)
     if (FFlag::DebugLuauDeferredConstraintResolution && mode == Mode::NoCheck)
         module->errors.clear();
 
-    if (item.options.runLintChecks)
+    if (item.options.runLintChecks && !item.options.interfaceOnly)
     {
         LUAU_TIMETRACE_SCOPE("lint", "Frontend");
 
@@ -996,36 +1235,16 @@ void Frontend::checkBuildQueueItem(BuildQueueItem& item)
         double timestamp = getTimestamp();
 
         std::vector<LintWarning> warnings =
-            Luau::lint(sourceModule.root, *sourceModule.names, environmentScope, module.get(), sourceModule.hotcomments, lintOptions);
+            Luau::lint(sourceModule.root, *sourceModule.names, environmentScope, module.get(), sourceModule.hotcomments, lintOptions,
+                &item.stats.timeLintPasses);
 
         item.stats.timeLint += getTimestamp() - timestamp;
 
         module->lintResult = classifyLints(warnings, config);
     }
 
-    if (!item.options.retainFullTypeGraphs)
-    {
-        // copyErrors needs to allocate into interfaceTypes as it copies
-        // types out of internalTypes, so we unfreeze it here.
-        unfreeze(module->interfaceTypes);
-        copyErrors(module->errors, module->interfaceTypes, builtinTypes);
-        freeze(module->interfaceTypes);
-
-        module->internalTypes.clear();
-
-        module->astTypes.clear();
-        module->astTypePacks.clear();
-        module->astExpectedTypes.clear();
-        module->astOriginalCallTypes.clear();
-        module->astOverloadResolvedTypes.clear();
-        module->astForInNextTypes.clear();
-        module->astResolvedTypes.clear();
-        module->astResolvedTypePacks.clear();
-        module->astCompoundAssignResultTypes.clear();
-        module->astScopes.clear();
-        module->upperBoundContributors.clear();
-        module->scopes.clear();
-    }
+    if (!item.options.retainFullTypeGraphs || item.options.interfaceOnly)
+        releaseTypeGraphs(*module, builtinTypes);
 
     if (mode != Mode::NoCheck)
     {
@@ -1076,13 +1295,37 @@ void Frontend::recordItemResult(const BuildQueueItem& item)
         item.sourceNode->dirtyModule = false;
     }
 
+    if (item.options.retainFullTypeGraphs && item.options.retainFullTypeGraphsLimit)
+        retainedTypeGraphs.push_back(item.module);
+
     stats.timeCheck += item.stats.timeCheck;
     stats.timeLint += item.stats.timeLint;
 
+    for (size_t i = 0; i < stats.timeLintPasses.size(); i++)
+        stats.timeLintPasses[i] += item.stats.timeLintPasses[i];
+
     stats.filesStrict += item.stats.filesStrict;
     stats.filesNonstrict += item.stats.filesNonstrict;
 }
 
+void Frontend::releaseRetainedTypeGraphs(size_t limit)
+{
+    // modules that were checked again or removed don't count towards the limit
+    retainedTypeGraphs.erase(std::remove_if(retainedTypeGraphs.begin(), retainedTypeGraphs.end(),
+                                 [](const std::weak_ptr<Module>& module) {
+                                     return module.expired();
+                                 }),
+        retainedTypeGraphs.end());
+
+    while (retainedTypeGraphs.size() > limit)
+    {
+        if (ModulePtr module = retainedTypeGraphs.front().lock())
+            releaseTypeGraphs(*module, builtinTypes);
+
+        retainedTypeGraphs.pop_front();
+    }
+}
+
 ScopePtr Frontend::getModuleEnvironment(const SourceModule& module, const Config& config, bool forAutocomplete) const
 {
     ScopePtr result;
@@ -1321,6 +1564,11 @@ ModulePtr check(const SourceModule& sourceModule, Mode mode, const std::vector<R
         for (auto& [name, tf] : result->exportedTypeBindings)
             tf.type = builtinTypes->errorRecoveryType();
     }
+    else if (options.interfaceOnly)
+    {
+        // Public interface is already known after constraint solving, final checks only report errors
+        result->interfaceOnly = true;
+    }
     else
     {
         if (mode == Mode::Nonstrict)
@@ -1378,10 +1626,13 @@ ModulePtr check(const SourceModule& sourceModule, Mode mode, const std::vector<R
 }
 
 ModulePtr Frontend::check(const SourceModule& sourceModule, Mode mode, std::vector<RequireCycle> requireCycles,
-    std::optional<ScopePtr> environmentScope, bool forAutocomplete, bool recordJsonLog, TypeCheckLimits typeCheckLimits)
+    std::optional<ScopePtr> environmentScope, bool forAutocomplete, bool recordJsonLog, TypeCheckLimits typeCheckLimits, bool interfaceOnly)
 {
     if (FFlag::DebugLuauDeferredConstraintResolution)
     {
+        FrontendOptions checkOptions = options;
+        checkOptions.interfaceOnly = interfaceOnly;
+
         auto prepareModuleScopeWrap = [this, forAutocomplete](const ModuleName& name, const ScopePtr& scope) {
             if (prepareModuleScope)
                 prepareModuleScope(name, scope, forAutocomplete);
@@ -1391,7 +1642,7 @@ ModulePtr Frontend::check(const SourceModule& sourceModule, Mode mode, std::vect
         {
             return Luau::check(sourceModule, mode, requireCycles, builtinTypes, NotNull{&iceHandler},
                 NotNull{forAutocomplete ? &moduleResolverForAutocomplete : &moduleResolver}, NotNull{fileResolver},
-                environmentScope ? *environmentScope : globals.globalScope, prepareModuleScopeWrap, options, typeCheckLimits, recordJsonLog,
+                environmentScope ? *environmentScope : globals.globalScope, prepareModuleScopeWrap, checkOptions, typeCheckLimits, recordJsonLog,
                 writeJsonLog);
         }
         catch (const InternalCompilerError& err)
@@ -1419,7 +1670,9 @@ ModulePtr Frontend::check(const SourceModule& sourceModule, Mode mode, std::vect
         typeChecker.unifierIterationLimit = typeCheckLimits.unifierIterationLimit;
         typeChecker.cancellationToken = typeCheckLimits.cancellationToken;
 
-        return typeChecker.check(sourceModule, mode, environmentScope);
+        ModulePtr module = typeChecker.check(sourceModule, mode, environmentScope);
+        module->interfaceOnly = interfaceOnly;
+        return module;
     }
 }
 
@@ -1442,27 +1695,60 @@ std::pair<SourceNode*, SourceModule*> Frontend::getSourceNode(const ModuleName&
     LUAU_TIMETRACE_SCOPE("Frontend::getSourceNode", "Frontend");
     LUAU_TIMETRACE_ARGUMENT("name", name.c_str());
 
+    const Config& config = configResolver->getConfig(name);
+    ParseOptions opts = config.parseOptions;
+    opts.captureComments = true;
+
+    return commitSource(name, parseSource(name, opts));
+}
+
+// Read and parse module source without touching the frontend state, so that this can run on any thread
+Frontend::ParsedSource Frontend::parseSource(const ModuleName& name, const ParseOptions& parseOptions)
+{
+    LUAU_TIMETRACE_SCOPE("Frontend::parseSource", "Frontend");
+    LUAU_TIMETRACE_ARGUMENT("name", name.c_str());
+
+    ParsedSource parsed;
+
     double timestamp = getTimestamp();
 
     std::optional<SourceCode> source = fileResolver->readSource(name);
     std::optional<std::string> environmentName = fileResolver->getEnvironmentForModule(name);
 
-    stats.timeRead += getTimestamp() - timestamp;
+    parsed.stats.timeRead += getTimestamp() - timestamp;
 
     if (!source)
+        return parsed;
+
+    SourceModule result = parse(name, source->source, parseOptions, parsed.stats);
+    result.type = source->type;
+    result.environmentName = environmentName;
+
+    parsed.requireTrace = traceRequires(fileResolver, result.root, name);
+    parsed.sourceModule = std::move(result);
+
+    return parsed;
+}
+
+// Record the result of parseSource in the module graph
+std::pair<SourceNode*, SourceModule*> Frontend::commitSource(const ModuleName& name, ParsedSource&& parsed)
+{
+    stats.files += parsed.stats.files;
+    stats.lines += parsed.stats.lines;
+    stats.timeRead += parsed.stats.timeRead;
+    stats.timeParse += parsed.stats.timeParse;
+
+    if (!parsed.sourceModule)
     {
         sourceModules.erase(name);
         return {nullptr, nullptr};
     }
 
-    const Config& config = configResolver->getConfig(name);
-    ParseOptions opts = config.parseOptions;
-    opts.captureComments = true;
-    SourceModule result = parse(name, source->source, opts);
-    result.type = source->type;
-
     RequireTraceResult& require = requireTrace[name];
-    require = traceRequires(fileResolver, result.root, name);
+    require = std::move(parsed.requireTrace);
+
+    auto it = sourceNodes.find(name);
+    bool isNew = it == sourceNodes.end();
 
     std::shared_ptr<SourceNode>& sourceNode = sourceNodes[name];
 
@@ -1474,8 +1760,7 @@ std::pair<SourceNode*, SourceModule*> Frontend::getSourceNode(const ModuleName&
     if (!sourceModule)
         sourceModule = std::make_shared<SourceModule>();
 
-    *sourceModule = std::move(result);
-    sourceModule->environmentName = environmentName;
+    *sourceModule = std::move(*parsed.sourceModule);
 
     sourceNode->name = sourceModule->name;
     sourceNode->humanReadableName = sourceModule->humanReadableName;
@@ -1483,7 +1768,7 @@ std::pair<SourceNode*, SourceModule*> Frontend::getSourceNode(const ModuleName&
     sourceNode->requireLocations.clear();
     sourceNode->dirtySourceModule = false;
 
-    if (it == sourceNodes.end())
+    if (isNew)
     {
         sourceNode->dirtyModule = true;
         sourceNode->dirtyModuleForAutocomplete = true;
@@ -1497,6 +1782,120 @@ std::pair<SourceNode*, SourceModule*> Frontend::getSourceNode(const ModuleName&
     return {sourceNode.get(), sourceModule.get()};
 }
 
+void Frontend::parseModules(
+    const std::vector<ModuleName>& roots, bool forAutocomplete, const std::function<void(std::function<void()> task)>& executeTask)
+{
+    LUAU_TIMETRACE_SCOPE("Frontend::parseModules", "Frontend");
+
+    struct ParseItem
+    {
+        ModuleName name;
+        ParseOptions options;
+        ParsedSource result;
+        std::exception_ptr exception;
+    };
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<ParseItem*> readyItems;
+
+    std::vector<std::unique_ptr<ParseItem>> items;
+    DenseHashSet<ModuleName> visited{{}};
+    std::vector<ModuleName> pending(roots.rbegin(), roots.rend());
+
+    size_t processing = 0;
+    std::exception_ptr exception;
+
+    while (true)
+    {
+        // once an exception is thrown, we only wait for the items that are already being processed
+        while (!pending.empty() && !exception)
+        {
+            ModuleName name = std::move(pending.back());
+            pending.pop_back();
+
+            if (visited.contains(name))
+                continue;
+
+            visited.insert(name);
+
+            if (auto it = sourceNodes.find(name); it != sourceNodes.end() && !it->second->hasDirtySourceModule())
+            {
+                // same as in parseGraph, dependencies of modules that aren't dirty won't need to be built
+                if (it->second->hasDirtyModule(forAutocomplete))
+                    pending.insert(pending.end(), it->second->requireSet.begin(), it->second->requireSet.end());
+
+                continue;
+            }
+
+            ParseItem* item = items.emplace_back(std::make_unique<ParseItem>()).get();
+            item->name = name;
+
+            // config resolvers are not required to be thread-safe
+            item->options = configResolver->getConfig(name).parseOptions;
+            item->options.captureComments = true;
+
+            processing++;
+
+            executeTask([this, item, &mtx, &cv, &readyItems]() {
+                try
+                {
+                    item->result = parseSource(item->name, item->options);
+                }
+                catch (...)
+                {
+                    item->exception = std::current_exception();
+                }
+
+                {
+                    std::unique_lock guard(mtx);
+                    readyItems.push_back(item);
+                }
+
+                cv.notify_one();
+            });
+        }
+
+        if (processing == 0)
+            break;
+
+        std::vector<ParseItem*> doneItems;
+
+        {
+            std::unique_lock guard(mtx);
+
+            cv.wait(guard, [&readyItems] {
+                return !readyItems.empty();
+            });
+
+            std::swap(doneItems, readyItems);
+        }
+
+        LUAU_ASSERT(processing >= doneItems.size());
+        processing -= doneItems.size();
+
+        // results are recorded on this thread, and new dependencies are queued as soon as they are discovered
+        for (ParseItem* item : doneItems)
+        {
+            if (item->exception)
+            {
+                if (!exception)
+                    exception = item->exception;
+
+                continue;
+            }
+
+            auto [sourceNode, _] = commitSource(item->name, std::move(item->result));
+
+            if (sourceNode)
+                pending.insert(pending.end(), sourceNode->requireSet.begin(), sourceNode->requireSet.end());
+        }
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
 /** Try to parse a source file into a SourceModule.
  *
  * The logic here is a little bit more complicated than we'd like it to be.
@@ -1511,6 +1910,11 @@ std::pair<SourceNode*, SourceModule*> Frontend::getSourceNode(const ModuleName&
  * result of the check()
  */
 SourceModule Frontend::parse(const ModuleName& name, std::string_view src, const ParseOptions& parseOptions)
+{
+    return parse(name, src, parseOptions, stats);
+}
+
+SourceModule Frontend::parse(const ModuleName& name, std::string_view src, const ParseOptions& parseOptions, Stats& parseStats)
 {
     LUAU_TIMETRACE_SCOPE("Frontend::parse", "Frontend");
     LUAU_TIMETRACE_ARGUMENT("name", name.c_str());
@@ -1521,9 +1925,9 @@ SourceModule Frontend::parse(const ModuleName& name, std::string_view src, const
 
     Luau::ParseResult parseResult = Luau::Parser::parse(src.data(), src.size(), *sourceModule.names, *sourceModule.allocator, parseOptions);
 
-    stats.timeParse += getTimestamp() - timestamp;
-    stats.files++;
-    stats.lines += parseResult.lines;
+    parseStats.timeParse += getTimestamp() - timestamp;
+    parseStats.files++;
+    parseStats.lines += parseResult.lines;
 
     if (!parseResult.errors.empty())
         sourceModule.parseErrors.insert(sourceModule.parseErrors.end(), parseResult.errors.begin(), parseResult.errors.end());
@@ -7,6 +7,7 @@
 #include "Luau/TypeInfer.h"
 #include "Luau/StringUtils.h"
 #include "Luau/Common.h"
+#include "Luau/TimeTrace.h"
 
 #include <algorithm>
 #include <math.h>
@@ -2985,8 +2986,28 @@ private:
     }
 };
 
+struct LintPassTimer
+{
+    LintPassTimer(LintPassTimes* passTimes, LintWarning::Code code)
+        : passTimes(passTimes)
+        , code(code)
+        , start(passTimes ? TimeTrace::getClock() : 0.0)
+    {
+    }
+
+    ~LintPassTimer()
+    {
+        if (passTimes)
+            (*passTimes)[code] += TimeTrace::getClock() - start;
+    }
+
+    LintPassTimes* passTimes;
+    LintWarning::Code code;
+    double start;
+};
+
 std::vector<LintWarning> lint(AstStat* root, const AstNameTable& names, const ScopePtr& env, const Module* module,
-    const std::vector<HotComment>& hotcomments, const LintOptions& options)
+    const std::vector<HotComment>& hotcomments, const LintOptions& options, LintPassTimes* passTimes)
 {
     LintContext context;
 
@@ -3002,78 +3023,142 @@ std::vector<LintWarning> lint(AstStat* root, const AstNameTable& names, const Sc
         context.warningEnabled(LintWarning::Code_GlobalUsedAsLocal) || context.warningEnabled(LintWarning::Code_PlaceholderRead) ||
         context.warningEnabled(LintWarning::Code_BuiltinGlobalWrite))
     {
+        LintPassTimer timer(passTimes, LintWarning::Code_UnknownGlobal);
         LintGlobalLocal::process(context);
     }
 
     if (context.warningEnabled(LintWarning::Code_MultiLineStatement))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_MultiLineStatement);
         LintMultiLineStatement::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_SameLineStatement))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_SameLineStatement);
         LintSameLineStatement::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_LocalShadow) || context.warningEnabled(LintWarning::Code_FunctionUnused) ||
         context.warningEnabled(LintWarning::Code_ImportUnused) || context.warningEnabled(LintWarning::Code_LocalUnused))
     {
+        LintPassTimer timer(passTimes, LintWarning::Code_LocalShadow);
         LintLocalHygiene::process(context);
     }
 
     if (context.warningEnabled(LintWarning::Code_FunctionUnused))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_FunctionUnused);
         LintUnusedFunction::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_UnreachableCode))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_UnreachableCode);
         LintUnreachableCode::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_UnknownType))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_UnknownType);
         LintUnknownType::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_ForRange))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_ForRange);
         LintForRange::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_UnbalancedAssignment))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_UnbalancedAssignment);
         LintUnbalancedAssignment::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_ImplicitReturn))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_ImplicitReturn);
         LintImplicitReturn::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_FormatString))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_FormatString);
         LintFormatString::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_TableLiteral))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_TableLiteral);
         LintTableLiteral::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_UninitializedLocal))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_UninitializedLocal);
         LintUninitializedLocal::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_DuplicateFunction))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_DuplicateFunction);
         LintDuplicateFunction::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_DeprecatedApi))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_DeprecatedApi);
         LintDeprecatedApi::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_TableOperations))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_TableOperations);
         LintTableOperations::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_DuplicateCondition))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_DuplicateCondition);
         LintDuplicateCondition::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_DuplicateLocal))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_DuplicateLocal);
         LintDuplicateLocal::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_MisleadingAndOr))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_MisleadingAndOr);
         LintMisleadingAndOr::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_CommentDirective))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_CommentDirective);
         lintComments(context, hotcomments);
+    }
 
     if (context.warningEnabled(LintWarning::Code_IntegerParsing))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_IntegerParsing);
         LintIntegerParsing::process(context);
+    }
 
     if (context.warningEnabled(LintWarning::Code_ComparisonPrecedence))
+    {
+        LintPassTimer timer(passTimes, LintWarning::Code_ComparisonPrecedence);
         LintComparisonPrecedence::process(context);
+    }
 
     if (FFlag::LuauAttributeSyntax && FFlag::LuauNativeAttribute && FFlag::LintRedundantNativeAttribute &&
         context.warningEnabled(LintWarning::Code_RedundantNativeAttribute))
     {
+        LintPassTimer timer(passTimes, LintWarning::Code_RedundantNativeAttribute);
+
         if (hasNativeCommentDirective(hotcomments))
             LintRedundantNativeAttribute::process(context);
     }
@@ -2,7 +2,11 @@
 #include "Luau/RequireTracer.h"
 
 #include "Luau/Ast.h"
+#include "Luau/Lexer.h"
 #include "Luau/Module.h"
+#include "Luau/Parser.h"
+
+#include <algorithm>
 
 namespace Luau
 {
@@ -163,4 +167,483 @@ RequireTraceResult traceRequires(FileResolver* fileResolver, AstStatBlock* root,
     return result;
 }
 
+struct RequireScanner
+{
+    static constexpr size_t kNone = ~size_t(0);
+    static constexpr int kMaxAliasDepth = 8;
+
+    struct NameInfo
+    {
+        int bindings = 0;
+        size_t declaration = kNone;
+        bool assigned = false;
+    };
+
+    RequireScanner(std::string_view source)
+        : source(source)
+        , names(allocator)
+        , nameInfo(AstName())
+    {
+    }
+
+    bool lex()
+    {
+        lineOffsets.push_back(0);
+
+        for (size_t i = source.find('\n'); i != std::string_view::npos; i = source.find('\n', i + 1))
+            lineOffsets.push_back(i + 1);
+
+        // typical sources average more than 4 bytes per token
+        tokens.reserve(source.size() / 4);
+        matching.reserve(source.size() / 4);
+        depths.reserve(source.size() / 4);
+
+        Lexer lexer(source.data(), source.size(), names);
+        lexer.setSkipComments(true);
+
+        std::vector<size_t> open;
+        int depth = 0;
+
+        for (;;)
+        {
+            const Lexeme& lexeme = lexer.next();
+
+            if (lexeme.type >= Lexeme::BrokenString && lexeme.type <= Lexeme::Error)
+                return false;
+
+            size_t index = tokens.size();
+            tokens.push_back(lexeme);
+            matching.push_back(kNone);
+            depths.push_back(depth);
+
+            switch (int(lexeme.type))
+            {
+            case '(':
+            case '[':
+            case '{':
+                open.push_back(index);
+                break;
+
+            case ')':
+            case ']':
+            case '}':
+            {
+                if (open.empty() || tokens[open.back()].type != (lexeme.type == ')' ? '(' : lexeme.type == ']' ? '[' : '{'))
+                    return false;
+
+                matching[index] = open.back();
+                matching[open.back()] = index;
+                open.pop_back();
+                break;
+            }
+
+            // block depth is only used to find locals declared at the top level of the module
+            case Lexeme::ReservedFunction:
+            case Lexeme::ReservedDo:
+            case Lexeme::ReservedThen:
+            case Lexeme::ReservedRepeat:
+                depth++;
+                break;
+
+            case Lexeme::ReservedEnd:
+            case Lexeme::ReservedUntil:
+            case Lexeme::ReservedElseif:
+                depth--;
+                break;
+
+            default:
+                break;
+            }
+
+            if (lexeme.type == Lexeme::Eof)
+                break;
+        }
+
+        return open.empty();
+    }
+
+    bool isType(size_t i, Lexeme::Type type) const
+    {
+        return i < tokens.size() && tokens[i].type == type;
+    }
+
+    // names that aren't fields or methods; these refer to locals or globals
+    bool isRootName(size_t i) const
+    {
+        return tokens[i].type == Lexeme::Name && (i == 0 || (tokens[i - 1].type != '.' && tokens[i - 1].type != ':'));
+    }
+
+    void markBindings()
+    {
+        bound.assign(tokens.size(), false);
+
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            Lexeme::Type type = tokens[i].type;
+
+            if (type == Lexeme::ReservedLocal || type == Lexeme::ReservedFor)
+            {
+                // the name list is assumed to extend up to the next '=' or keyword, which may include extra names but never misses any
+                for (size_t j = i + 1; j < tokens.size(); ++j)
+                {
+                    Lexeme::Type t = tokens[j].type;
+
+                    if (t == '=' || t == Lexeme::Eof || (t >= Lexeme::Reserved_BEGIN && t != Lexeme::ReservedNil))
+                        break;
+
+                    if (t == Lexeme::Name && (j == i + 1 || tokens[j - 1].type == ','))
+                        bound[j] = true;
+                }
+            }
+            else if (type == Lexeme::ReservedFunction)
+            {
+                if (i > 0 && tokens[i - 1].type == Lexeme::ReservedLocal && isType(i + 1, Lexeme::Name))
+                    bound[i + 1] = true;
+
+                // parameters are listed in the first parentheses after the keyword
+                size_t j = i + 1;
+                while (j < tokens.size() && tokens[j].type != '(' && tokens[j].type != Lexeme::Eof)
+                    ++j;
+
+                if (isType(j, Lexeme::Type('(')))
+                {
+                    for (size_t k = j + 1; k < matching[j]; ++k)
+                        if (tokens[k].type == Lexeme::Name && (tokens[k - 1].type == '(' || tokens[k - 1].type == ','))
+                            bound[k] = true;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (!isRootName(i))
+                continue;
+
+            NameInfo& info = nameInfo[AstName(tokens[i].name)];
+
+            if (bound[i])
+            {
+                info.bindings++;
+                info.declaration = i;
+            }
+            else if (i + 1 < tokens.size())
+            {
+                Lexeme::Type next = tokens[i + 1].type;
+
+                // this also covers table fields and function arguments, which only makes the scan more conservative
+                if (next == '=' || next == ',' || (next >= Lexeme::AddAssign && next <= Lexeme::ConcatAssign))
+                    info.assigned = true;
+            }
+        }
+    }
+
+    // returns the first token of the expression asserted with '::' at the given index, if the expression is a simple or postfix expression
+    size_t findAssertionStart(size_t i) const
+    {
+        if (i == 0)
+            return kNone;
+
+        i--;
+
+        for (;;)
+        {
+            Lexeme::Type type = tokens[i].type;
+
+            if (type == ')' || type == ']' || type == '}')
+                i = matching[i];
+            else if (type != Lexeme::Name && type != Lexeme::QuotedString && type != Lexeme::RawString && type != Lexeme::Number &&
+                     type != Lexeme::ReservedNil && type != Lexeme::ReservedTrue && type != Lexeme::ReservedFalse && type != Lexeme::Dot3)
+                return kNone;
+
+            if (i >= 2 && (tokens[i - 1].type == '.' || tokens[i - 1].type == ':'))
+            {
+                i -= 2;
+                continue;
+            }
+
+            // call or index of the preceding expression
+            type = tokens[i].type;
+            if (i >= 1 && (type == '(' || type == '[' || type == '{' || type == Lexeme::QuotedString || type == Lexeme::RawString))
+            {
+                Lexeme::Type prev = tokens[i - 1].type;
+
+                if (prev == Lexeme::Name || prev == ')' || prev == ']' || prev == Lexeme::QuotedString || prev == Lexeme::RawString)
+                {
+                    i -= 1;
+                    continue;
+                }
+            }
+
+            return i;
+        }
+    }
+
+    // paths are names followed by fields, method calls, calls and indexing with simple arguments, or a single string
+    bool isSimpleGroup(size_t open) const
+    {
+        for (size_t i = open + 1; i < matching[open]; ++i)
+        {
+            switch (int(tokens[i].type))
+            {
+            case Lexeme::Name:
+                if (isRootName(i) && tokens[i].name == requireName.value)
+                    return false;
+                break;
+            case Lexeme::QuotedString:
+            case Lexeme::RawString:
+            case Lexeme::Number:
+            case Lexeme::ReservedNil:
+            case Lexeme::ReservedTrue:
+            case Lexeme::ReservedFalse:
+            case '.':
+            case ':':
+            case ',':
+            case '(':
+            case ')':
+            case '[':
+            case ']':
+                break;
+            default:
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    size_t scanPath(size_t i) const
+    {
+        Lexeme::Type type = tokens[i].type;
+
+        if (type == Lexeme::QuotedString || type == Lexeme::RawString)
+            return i + 1;
+
+        if (type != Lexeme::Name)
+            return kNone;
+
+        for (i = i + 1;;)
+        {
+            type = tokens[i].type;
+
+            if (type == '.' && isType(i + 1, Lexeme::Name))
+                i += 2;
+            else if (type == ':' && isType(i + 1, Lexeme::Name) && isType(i + 2, Lexeme::Type('(')) && isSimpleGroup(i + 2))
+                i = matching[i + 2] + 1;
+            else if (type == '[' && isSimpleGroup(i))
+                i = matching[i] + 1;
+            else if (type == '(' && tokens[i].location.begin.line == tokens[i - 1].location.end.line && isSimpleGroup(i))
+                i = matching[i] + 1;
+            else
+                return i;
+        }
+    }
+
+    bool isStatementEnd(size_t i) const
+    {
+        Lexeme::Type type = tokens[i].type;
+
+        if (type == Lexeme::ReservedAnd || type == Lexeme::ReservedOr)
+            return false;
+
+        return type == Lexeme::Eof || type == ';' || type == Lexeme::Name || type == Lexeme::Attribute || type >= Lexeme::Reserved_BEGIN;
+    }
+
+    std::string_view getText(const Position& begin, const Position& end) const
+    {
+        size_t beginOffset = lineOffsets[begin.line] + begin.column;
+        size_t endOffset = lineOffsets[end.line] + end.column;
+
+        return source.substr(beginOffset, endOffset - beginOffset);
+    }
+
+    bool isGlobal(size_t i) const
+    {
+        const NameInfo* info = nameInfo.find(AstName(tokens[i].name));
+
+        return tokens[i].name != requireName.value && (!info || info->bindings == 0);
+    }
+
+    // appends the source of the path, replacing the root with the initializer when it's a local declared at the top level with a path
+    bool expandPath(size_t begin, size_t end, size_t use, std::string& result, int depth) const
+    {
+        for (size_t i = begin + 1; i < end; ++i)
+            if (isRootName(i) && !isGlobal(i))
+                return false;
+
+        if (tokens[begin].type == Lexeme::Name && !isGlobal(begin))
+        {
+            const NameInfo* info = nameInfo.find(AstName(tokens[begin].name));
+            LUAU_ASSERT(info);
+
+            size_t decl = info->declaration;
+
+            if (depth >= kMaxAliasDepth || tokens[begin].name == requireName.value || info->bindings != 1 || info->assigned || decl > use)
+                return false;
+
+            if (decl == 0 || tokens[decl - 1].type != Lexeme::ReservedLocal || depths[decl - 1] != 0 || !isType(decl + 1, Lexeme::Type('=')))
+                return false;
+
+            size_t initEnd = scanPath(decl + 2);
+
+            if (initEnd == kNone || !isStatementEnd(initEnd))
+                return false;
+
+            if (!expandPath(decl + 2, initEnd, decl, result, depth + 1))
+                return false;
+        }
+        else
+        {
+            result.append(getText(tokens[begin].location.begin, tokens[begin].location.end));
+        }
+
+        result.append(getText(tokens[begin].location.end, tokens[end - 1].location.end));
+        return true;
+    }
+
+    bool scan(FileResolver* fileResolver, const ModuleName& currentModuleName, const ParseOptions& options, RequireScanResult& result)
+    {
+        if (!lex())
+            return false;
+
+        requireName = names.getOrAdd("require");
+
+        if (std::none_of(tokens.begin(), tokens.end(), [&](const Lexeme& lexeme) {
+            return lexeme.type == Lexeme::Name && lexeme.name == requireName.value;
+        }))
+            return true;
+
+        markBindings();
+
+        // requires in type assertions are ignored by traceRequires; this includes typeof in the asserted type, which isn't tracked here
+        std::vector<bool> suppressed(tokens.size(), false);
+        bool hasAssertions = false;
+
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (tokens[i].type != Lexeme::DoubleColon)
+                continue;
+
+            size_t start = findAssertionStart(i);
+            if (start == kNone)
+                return false;
+
+            for (size_t j = start; j < i; ++j)
+                suppressed[j] = true;
+
+            hasAssertions = true;
+        }
+
+        if (hasAssertions)
+        {
+            AstName typeofName = names.getOrAdd("typeof");
+
+            for (size_t i = 0; i < tokens.size(); ++i)
+            {
+                if (tokens[i].type != Lexeme::Name || tokens[i].name != typeofName.value || !isType(i + 1, Lexeme::Type('(')))
+                    continue;
+
+                for (size_t j = i + 2; j < matching[i + 1]; ++j)
+                    if (tokens[j].type == Lexeme::Name && tokens[j].name == requireName.value)
+                        return false;
+            }
+        }
+
+        // each require is placed on its own line in a separate chunk which is parsed and traced instead of the source
+        std::string chunk;
+        unsigned int chunkLine = 0;
+        std::vector<std::pair<unsigned int, Location>> calls;
+
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (tokens[i].type != Lexeme::Name || tokens[i].name != requireName.value || !isRootName(i))
+                continue;
+
+            if (bound[i] || (i > 0 && tokens[i - 1].type == Lexeme::ReservedFunction) || !isType(i + 1, Lexeme::Type('(')))
+                return false;
+
+            size_t close = matching[i + 1];
+
+            if (suppressed[i] || close == i + 2)
+                continue;
+
+            size_t end = scanPath(i + 2);
+            if (end == kNone || (end != close && tokens[end].type != ','))
+                return false;
+
+            std::string path;
+            if (!expandPath(i + 2, end, i, path, 0))
+                return false;
+
+            calls.push_back({chunkLine, Location(tokens[i].location.begin, tokens[close].location.end)});
+
+            chunk += "require(";
+            chunk += path;
+            chunk += ")\n";
+            chunkLine += unsigned(std::count(path.begin(), path.end(), '\n')) + 1;
+        }
+
+        if (calls.empty())
+            return true;
+
+        Allocator chunkAllocator;
+        AstNameTable chunkNames(chunkAllocator);
+        ParseResult parseResult = Parser::parse(chunk.data(), chunk.size(), chunkNames, chunkAllocator, options);
+
+        if (!parseResult.errors.empty())
+            return false;
+
+        RequireTraceResult trace = traceRequires(fileResolver, parseResult.root, currentModuleName);
+
+        size_t next = 0;
+
+        for (auto& [name, location] : trace.requireList)
+        {
+            while (next < calls.size() && calls[next].first != location.begin.line)
+                next++;
+
+            if (next == calls.size())
+                return false;
+
+            result.requireList.push_back({std::move(name), calls[next].second});
+        }
+
+        return true;
+    }
+
+    std::string_view source;
+
+    Allocator allocator;
+    AstNameTable names;
+    AstName requireName;
+
+    std::vector<Lexeme> tokens;
+    std::vector<size_t> matching;
+    std::vector<int> depths;
+    std::vector<bool> bound;
+    std::vector<size_t> lineOffsets;
+
+    DenseHashMap<AstName, NameInfo> nameInfo;
+};
+
+RequireScanResult scanRequires(FileResolver* fileResolver, std::string_view source, const ModuleName& currentModuleName, ParseOptions options)
+{
+    RequireScanResult result;
+
+    {
+        RequireScanner scanner(source);
+
+        if (scanner.scan(fileResolver, currentModuleName, options, result))
+            return result;
+    }
+
+    result.requireList.clear();
+    result.parsed = true;
+    Allocator allocator;
+    AstNameTable names(allocator);
+    ParseResult parseResult = Parser::parse(source.data(), source.size(), names, allocator, options);
+
+    result.requireList = traceRequires(fileResolver, parseResult.root, currentModuleName).requireList;
+    return result;
+}
+
 } // namespace Luau
@@ -28,6 +28,9 @@ bool isIdentifierChar(char c)
     return isIdentifierStartChar(c) || isDigit(c);
 }
 
+// output is passed to the streaming callback once this much of it has accumulated
+const size_t kStreamChunkSize = 64 * 1024;
+
 const std::vector<std::string> keywords = {"and", "break", "do", "else", "elseif", "end", "false", "for", "function", "if", "in", "local", "nil",
     "not", "or", "repeat", "return", "then", "true", "until", "while"};
 
@@ -58,11 +61,23 @@ struct StringWriter : Writer
     Position pos{0, 0};
     char lastChar = '\0'; // used to determine whether we need to inject an extra space to preserve grammatical correctness.
 
+    // when set, the output is passed to the callback in chunks and 'ss' only holds the part that wasn't passed yet
+    const std::function<void(std::string_view)>* output = nullptr;
+
     const std::string& str() const
     {
         return ss;
     }
 
+    void flush()
+    {
+        if (output && !ss.empty())
+        {
+            (*output)(ss);
+            ss.clear();
+        }
+    }
+
     void advance(const Position& newPos) override
     {
         while (pos.line < newPos.line)
@@ -84,6 +99,9 @@ struct StringWriter : Writer
         pos.column = 0;
         ++pos.line;
         lastChar = '\n';
+
+        if (output && ss.size() >= kStreamChunkSize)
+            flush();
     }
 
     void space() override
@@ -101,6 +119,9 @@ struct StringWriter : Writer
         ss.append(s.data(), s.size());
         pos.column += unsigned(s.size());
         lastChar = s[s.size() - 1];
+
+        if (output && ss.size() >= kStreamChunkSize)
+            flush();
     }
 
     void write(char c)
@@ -1213,6 +1234,18 @@ std::string transpileWithTypes(AstStatBlock& block)
     return writer.str();
 }
 
+void transpile(AstStatBlock& block, const std::function<void(std::string_view)>& output, bool withTypes)
+{
+    StringWriter writer;
+    writer.output = &output;
+
+    Printer printer(writer);
+    printer.writeTypes = withTypes;
+    printer.visualizeBlock(block);
+
+    writer.flush();
+}
+
 TranspileResult transpile(std::string_view source, ParseOptions options, bool withTypes)
 {
     auto allocator = Allocator{};
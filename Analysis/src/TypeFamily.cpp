@@ -97,6 +97,96 @@ struct InstanceCollector : TypeOnceVisitor
     }
 };
 
+// Finds whether a type can still change as the solver makes progress, in which case type family reductions involving it can't be reused
+struct UnresolvedTypeFinder : TypeOnceVisitor
+{
+    bool found = false;
+
+    bool visit(TypeId ty) override
+    {
+        return !found;
+    }
+
+    bool visit(TypePackId tp) override
+    {
+        return !found;
+    }
+
+    bool visit(TypeId ty, const FreeType&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypeId ty, const GenericType&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypeId ty, const TableType& ttv) override
+    {
+        if (ttv.state != TableState::Sealed)
+            found = true;
+
+        return !found;
+    }
+
+    bool visit(TypeId ty, const ClassType&) override
+    {
+        return false;
+    }
+
+    bool visit(TypeId ty, const BlockedType&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypeId ty, const PendingExpansionType&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypeId ty, const TypeFamilyInstanceType&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypePackId tp, const FreeTypePack&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypePackId tp, const GenericTypePack&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypePackId tp, const BlockedTypePack&) override
+    {
+        found = true;
+        return false;
+    }
+
+    bool visit(TypePackId tp, const TypeFamilyInstanceTypePack&) override
+    {
+        found = true;
+        return false;
+    }
+};
+
+static bool isResolved(TypeId ty)
+{
+    UnresolvedTypeFinder finder;
+    finder.traverse(ty);
+    return !finder.found;
+}
+
 struct FamilyReducer
 {
     TypeFamilyContext ctx;
@@ -347,7 +437,41 @@ struct FamilyReducer
             if (tryGuessing(subject))
                 return;
 
+            // Reductions are reused between instances of the same family applied to the same types, as long as those types are final
+            std::optional<TypeFamilyApplication> application;
+
+            if (ctx.solver && tfit->packArguments.empty())
+            {
+                application = TypeFamilyApplication{tfit->family.get(), {}};
+
+                for (TypeId arg : tfit->typeArguments)
+                {
+                    TypeId followed = follow(arg);
+
+                    if (!isResolved(followed))
+                    {
+                        application.reset();
+                        break;
+                    }
+
+                    application->arguments.push_back(followed);
+                }
+            }
+
+            if (application)
+            {
+                if (TypeId* reduced = ctx.solver->reducedTypeFamilies.find(*application))
+                {
+                    replace(subject, *reduced);
+                    return;
+                }
+            }
+
             TypeFamilyReductionResult<TypeId> result = tfit->family->reducer(subject, tfit->typeArguments, tfit->packArguments, NotNull{&ctx});
+
+            if (application && result.result && isResolved(*result.result))
+                ctx.solver->reducedTypeFamilies[*application] = *result.result;
+
             handleFamilyReduction(subject, result);
         }
     }
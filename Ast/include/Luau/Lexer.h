@@ -15,6 +15,8 @@ class Allocator
 {
 public:
     Allocator();
+    // pages start at the given size and grow geometrically as more memory is requested
+    explicit Allocator(size_t initialPageSize);
     Allocator(Allocator&&);
 
     Allocator& operator=(Allocator&&) = delete;
@@ -23,6 +25,10 @@ public:
 
     void* allocate(size_t size);
 
+    // releases all allocations at once while keeping the pages for subsequent allocations
+    // note that this invalidates all objects allocated so far, including names from AstNameTable instances that use this allocator
+    void reset();
+
     template<typename T, typename... Args>
     T* alloc(Args&&... args)
     {
@@ -34,15 +40,23 @@ public:
     }
 
 private:
+    static constexpr size_t kMinPageSize = 8192;
+    static constexpr size_t kMaxPageSize = 256 * 1024;
+
     struct Page
     {
         Page* next;
+        size_t size;
 
-        char data[8192];
+        char data[kMinPageSize]; // actual size is stored in 'size'
     };
 
+    Page* newPage(size_t size);
+
     Page* root;
+    Page* spare;
     size_t offset;
+    size_t pageSize;
 };
 
 struct Lexeme
@@ -155,6 +169,10 @@ class AstNameTable
 public:
     AstNameTable(Allocator& allocator);
 
+    // names that are missing from this table are taken from the shared table before being added, so that common names are not copied
+    // in every table; the shared table must outlive this table and must not be modified while in use, so it can be read from multiple threads
+    AstNameTable(Allocator& allocator, const AstNameTable& shared);
+
     AstName addStatic(const char* name, Lexeme::Type type = Lexeme::Name);
 
     std::pair<AstName, Lexeme::Type> getOrAddWithType(const char* name, size_t length);
@@ -181,6 +199,7 @@ private:
     DenseHashSet<Entry, EntryHash> data;
 
     Allocator& allocator;
+    const AstNameTable* shared = nullptr;
 };
 
 class Lexer
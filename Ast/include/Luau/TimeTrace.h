@@ -7,6 +7,7 @@
 #include <memory>
 
 #include <stdint.h>
+#include <string.h>
 
 LUAU_FASTFLAG(DebugLuauTimeTracing)
 
@@ -62,6 +63,17 @@ uint32_t createThread(GlobalContext& context, ThreadContext* threadContext);
 void releaseThread(GlobalContext& context, ThreadContext* threadContext);
 void flushEvents(GlobalContext& context, uint32_t threadId, const std::vector<Event>& events, const std::vector<char>& data);
 
+// Receives the trace as consecutive fragments of a Chrome trace event array in JSON format
+using OutputCallback = void (*)(void* context, const char* data, size_t size);
+
+// Capture is enabled at runtime with DebugLuauTimeTracing; by default, events are written to trace.json in the working directory
+// Output can be redirected to a different file or to a callback; the new output receives events that are flushed after the call
+bool setOutputFile(const char* path);
+void setOutputCallback(OutputCallback callback, void* context);
+
+// Events are buffered per thread and are flushed when the buffer fills up or the thread exits; this flushes the calling thread early
+void flushThreadEvents();
+
 struct ThreadContext
 {
     ThreadContext()
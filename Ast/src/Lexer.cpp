@@ -14,31 +14,44 @@ namespace Luau
 {
 
 Allocator::Allocator()
-    : root(static_cast<Page*>(operator new(sizeof(Page))))
+    : Allocator(kMinPageSize)
+{
+}
+
+Allocator::Allocator(size_t initialPageSize)
+    : root(nullptr)
+    , spare(nullptr)
     , offset(0)
+    , pageSize(initialPageSize < kMinPageSize ? kMinPageSize : initialPageSize)
 {
-    root->next = nullptr;
+    root = newPage(pageSize);
 }
 
 Allocator::Allocator(Allocator&& rhs)
     : root(rhs.root)
+    , spare(rhs.spare)
     , offset(rhs.offset)
+    , pageSize(rhs.pageSize)
 {
     rhs.root = nullptr;
+    rhs.spare = nullptr;
     rhs.offset = 0;
 }
 
 Allocator::~Allocator()
 {
-    Page* page = root;
-
-    while (page)
+    for (Page* list : {root, spare})
     {
-        Page* next = page->next;
+        Page* page = list;
+
+        while (page)
+        {
+            Page* next = page->next;
 
-        operator delete(page);
+            operator delete(page);
 
-        page = next;
+            page = next;
+        }
     }
 }
 
@@ -50,18 +63,29 @@ void* Allocator::allocate(size_t size)
     {
         uintptr_t data = reinterpret_cast<uintptr_t>(root->data);
         uintptr_t result = (data + offset + align - 1) & ~(align - 1);
-        if (result + size <= data + sizeof(root->data))
+        if (result + size <= data + root->size)
         {
             offset = result - data + size;
             return reinterpret_cast<void*>(result);
         }
     }
 
-    // allocate new page
-    size_t pageSize = size > sizeof(root->data) ? size : sizeof(root->data);
-    void* pageData = operator new(offsetof(Page, data) + pageSize);
+    Page* page = nullptr;
 
-    Page* page = static_cast<Page*>(pageData);
+    if (spare && spare->size >= size)
+    {
+        // pages retained by reset() are reused before allocating new memory
+        page = spare;
+        spare = page->next;
+    }
+    else
+    {
+        // each new page is larger than the previous one to keep the number of pages logarithmic in the total size
+        if (root && pageSize < kMaxPageSize)
+            pageSize *= 2;
+
+        page = newPage(size > pageSize ? size : pageSize);
+    }
 
     page->next = root;
 
@@ -71,6 +95,34 @@ void* Allocator::allocate(size_t size)
     return page->data;
 }
 
+void Allocator::reset()
+{
+    // pages are moved to the spare list in reverse order, so that the smaller pages are reused first
+    while (root)
+    {
+        Page* next = root->next;
+
+        root->next = spare;
+        spare = root;
+
+        root = next;
+    }
+
+    offset = 0;
+}
+
+Allocator::Page* Allocator::newPage(size_t size)
+{
+    void* pageData = operator new(offsetof(Page, data) + size);
+
+    Page* page = static_cast<Page*>(pageData);
+
+    page->next = nullptr;
+    page->size = size;
+
+    return page;
+}
+
 Lexeme::Lexeme(const Location& location, Type type)
     : type(type)
     , location(location)
@@ -265,6 +317,12 @@ AstNameTable::AstNameTable(Allocator& allocator)
         addStatic(kReserved[i - Lexeme::Reserved_BEGIN], static_cast<Lexeme::Type>(i));
 }
 
+AstNameTable::AstNameTable(Allocator& allocator, const AstNameTable& shared)
+    : AstNameTable(allocator)
+{
+    this->shared = &shared;
+}
+
 AstName AstNameTable::addStatic(const char* name, Lexeme::Type type)
 {
     AstNameTable::Entry entry = {AstName(name), uint32_t(strlen(name)), type};
@@ -286,6 +344,14 @@ std::pair<AstName, Lexeme::Type> AstNameTable::getOrAddWithType(const char* name
 
     // we just inserted an entry with a non-owned pointer into the map
     // we need to correct it, *but* we need to be careful about not disturbing the hash value
+    if (const Entry* sharedEntry = shared ? shared->data.find(key) : nullptr)
+    {
+        const_cast<Entry&>(entry).value = sharedEntry->value;
+        const_cast<Entry&>(entry).type = sharedEntry->type;
+
+        return std::make_pair(entry.value, entry.type);
+    }
+
     char* nameData = static_cast<char*>(allocator.allocate(length + 1));
     memcpy(nameData, name, length);
     nameData[length] = 0;
@@ -298,10 +364,18 @@ std::pair<AstName, Lexeme::Type> AstNameTable::getOrAddWithType(const char* name
 
 std::pair<AstName, Lexeme::Type> AstNameTable::getWithType(const char* name, size_t length) const
 {
-    if (const Entry* entry = data.find({AstName(name), uint32_t(length), Lexeme::Eof}))
+    AstNameTable::Entry key = {AstName(name), uint32_t(length), Lexeme::Eof};
+
+    if (const Entry* entry = data.find(key))
     {
         return std::make_pair(entry->value, entry->type);
     }
+
+    if (const Entry* entry = shared ? shared->data.find(key) : nullptr)
+    {
+        return std::make_pair(entry->value, entry->type);
+    }
+
     return std::make_pair(AstName(), Lexeme::Name);
 }
 
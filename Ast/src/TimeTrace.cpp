@@ -3,6 +3,7 @@
 
 #include "Luau/StringUtils.h"
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 
@@ -102,6 +103,18 @@ struct GlobalContext
     std::vector<Token> tokens;
     FILE* traceFile = nullptr;
 
+    OutputCallback outputCallback = nullptr;
+    void* outputContext = nullptr;
+    bool outputStarted = false;
+
+    void write(const char* data, size_t size)
+    {
+        if (outputCallback)
+            outputCallback(outputContext, data, size);
+        else
+            fwrite(data, 1, size, traceFile);
+    }
+
 private:
     friend std::shared_ptr<GlobalContext> getGlobalContext();
     GlobalContext() = default;
@@ -144,14 +157,20 @@ void flushEvents(GlobalContext& context, uint32_t threadId, const std::vector<Ev
 {
     std::scoped_lock lock(context.mutex);
 
-    if (!context.traceFile)
+    if (!context.outputCallback && !context.traceFile)
     {
         context.traceFile = fopen("trace.json", "w");
 
         if (!context.traceFile)
             return;
 
-        fprintf(context.traceFile, "[\n");
+        context.outputStarted = false;
+    }
+
+    if (!context.outputStarted)
+    {
+        context.write("[\n", 2);
+        context.outputStarted = true;
     }
 
     std::string temp;
@@ -228,7 +247,7 @@ void flushEvents(GlobalContext& context, uint32_t threadId, const std::vector<Ev
         // Don't want to hit the string capacity and reallocate
         if (temp.size() > tempReserve - 1024)
         {
-            fwrite(temp.data(), 1, temp.size(), context.traceFile);
+            context.write(temp.data(), temp.size());
             temp.clear();
         }
     }
@@ -244,8 +263,54 @@ void flushEvents(GlobalContext& context, uint32_t threadId, const std::vector<Ev
         unfinishedEnter = false;
     }
 
-    fwrite(temp.data(), 1, temp.size(), context.traceFile);
-    fflush(context.traceFile);
+    context.write(temp.data(), temp.size());
+
+    if (context.traceFile)
+        fflush(context.traceFile);
+}
+
+bool setOutputFile(const char* path)
+{
+    GlobalContext& context = *getGlobalContext();
+    std::scoped_lock lock(context.mutex);
+
+    FILE* file = fopen(path, "w");
+
+    if (!file)
+        return false;
+
+    if (context.traceFile)
+        fclose(context.traceFile);
+
+    context.traceFile = file;
+    context.outputCallback = nullptr;
+    context.outputContext = nullptr;
+    context.outputStarted = false;
+    return true;
+}
+
+void setOutputCallback(OutputCallback callback, void* outputContext)
+{
+    GlobalContext& context = *getGlobalContext();
+    std::scoped_lock lock(context.mutex);
+
+    if (context.traceFile)
+    {
+        fclose(context.traceFile);
+        context.traceFile = nullptr;
+    }
+
+    context.outputCallback = callback;
+    context.outputContext = outputContext;
+    context.outputStarted = false;
+}
+
+void flushThreadEvents()
+{
+    ThreadContext& context = getThreadContext();
+
+    if (!context.events.empty())
+        context.flushEvents();
 }
 
 ThreadContext& getThreadContext()
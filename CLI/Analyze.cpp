@@ -5,10 +5,13 @@
 #include "Luau/Frontend.h"
 #include "Luau/TypeAttach.h"
 #include "Luau/Transpiler.h"
+#include "Luau/TimeTrace.h"
 
+#include "AnalyzeWatch.h"
 #include "FileUtils.h"
 #include "Flags.h"
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -105,9 +108,13 @@ static bool reportModuleResult(Luau::Frontend& frontend, const Luau::ModuleName&
 
         Luau::attachTypeData(*sm, *m);
 
-        std::string annotated = Luau::transpileWithTypes(*sm->root);
-
-        printf("%s", annotated.c_str());
+        // annotated source is written as it's produced, so that large modules don't need a copy of the output in memory
+        Luau::transpile(
+            *sm->root,
+            [](std::string_view chunk) {
+                fwrite(chunk.data(), 1, chunk.size(), stdout);
+            },
+            /* withTypes= */ true);
     }
 
     return cr->errors.empty() && cr->lintResult.errors.empty();
@@ -126,6 +133,8 @@ static void displayHelp(const char* argv0)
     printf("  --formatter=gnu: report analysis errors in GNU-compatible format\n");
     printf("  --mode=strict: default to strict mode when typechecking\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
+    printf("  --timetrace=<file>: record compiler time tracing information into a specified file\n");
+    printf("  --watch: keep running and check modules again when input files or modules they require change\n");
 }
 
 static int assertionHandler(const char* expr, const char* file, int line, const char* function)
@@ -164,8 +173,9 @@ struct CliFileResolver : Luau::FileResolver
     {
         if (Luau::AstExprConstantString* expr = node->as<Luau::AstExprConstantString>())
         {
+            // only existence matters here, the contents are read once when the module is parsed
             Luau::ModuleName name = std::string(expr->value.data, expr->value.size) + ".luau";
-            if (!readFile(name))
+            if (!isFile(name))
             {
                 // fall back to .lua if a module with .luau doesn't exist
                 name = std::string(expr->value.data, expr->value.size) + ".lua";
@@ -307,7 +317,9 @@ int main(int argc, char** argv)
     ReportFormat format = ReportFormat::Default;
     Luau::Mode mode = Luau::Mode::Nonstrict;
     bool annotate = false;
+    bool watch = false;
     int threadCount = 0;
+    const char* traceFile = nullptr;
     std::string basePath = "";
 
     for (int i = 1; i < argc; ++i)
@@ -323,8 +335,15 @@ int main(int argc, char** argv)
             mode = Luau::Mode::Strict;
         else if (strcmp(argv[i], "--annotate") == 0)
             annotate = true;
+        else if (strcmp(argv[i], "--watch") == 0)
+            watch = true;
         else if (strcmp(argv[i], "--timetrace") == 0)
             FFlag::DebugLuauTimeTracing.value = true;
+        else if (strncmp(argv[i], "--timetrace=", 12) == 0)
+        {
+            FFlag::DebugLuauTimeTracing.value = true;
+            traceFile = argv[i] + 12;
+        }
         else if (strncmp(argv[i], "--fflags=", 9) == 0)
             setLuauFlags(argv[i] + 9);
         else if (strncmp(argv[i], "-j", 2) == 0)
@@ -339,6 +358,12 @@ int main(int argc, char** argv)
         fprintf(stderr, "To run with --timetrace, Luau has to be built with LUAU_ENABLE_TIME_TRACE enabled\n");
         return 1;
     }
+#else
+    if (traceFile && !Luau::TimeTrace::setOutputFile(traceFile))
+    {
+        fprintf(stderr, "Error opening %s for time tracing\n", traceFile);
+        return 1;
+    }
 #endif
 
     Luau::FrontendOptions frontendOptions;
@@ -376,42 +401,84 @@ int main(int argc, char** argv)
 
     std::vector<std::string> files = getSourceFiles(argc, argv);
 
-    for (const std::string& path : files)
-        frontend.queueModuleCheck(path);
-
-    std::vector<Luau::ModuleName> checkedModules;
-
     // If thread count is not set, try to use HW thread count, but with an upper limit
     // When we improve scalability of typechecking, upper limit can be adjusted/removed
     if (threadCount <= 0)
         threadCount = std::min(TaskScheduler::getThreadCount(), 8u);
 
-    try
-    {
-        TaskScheduler scheduler(threadCount);
+    TaskScheduler scheduler(threadCount);
 
-        checkedModules = frontend.checkQueuedModules(std::nullopt, [&](std::function<void()> f) {
-            scheduler.push(std::move(f));
-        });
-    }
-    catch (const Luau::InternalCompilerError& ice)
+    // Checks modules that are dirty and reports their results; returns the number of failed modules, or nullopt on an internal compiler error
+    auto checkFiles = [&]() -> std::optional<int> {
+        for (const std::string& path : files)
+            frontend.queueModuleCheck(path);
+
+        std::vector<Luau::ModuleName> checkedModules;
+
+        try
+        {
+            checkedModules = frontend.checkQueuedModules(std::nullopt, [&](std::function<void()> f) {
+                scheduler.push(std::move(f));
+            });
+        }
+        catch (const Luau::InternalCompilerError& ice)
+        {
+            Luau::Location location = ice.location ? *ice.location : Luau::Location();
+
+            std::string moduleName = ice.moduleName ? *ice.moduleName : "<unknown module>";
+            std::string humanReadableName = frontend.fileResolver->getHumanReadableModuleName(moduleName);
+
+            Luau::TypeError error(location, moduleName, Luau::InternalError{ice.message});
+
+            report(format, humanReadableName.c_str(), location, "InternalCompilerError",
+                Luau::toString(error, Luau::TypeErrorToStringOptions{frontend.fileResolver}).c_str());
+            return std::nullopt;
+        }
+
+        int failed = 0;
+
+        for (const Luau::ModuleName& name : checkedModules)
+            failed += !reportModuleResult(frontend, name, format, annotate);
+
+        return failed;
+    };
+
+    std::optional<int> result = checkFiles();
+
+    if (watch)
     {
-        Luau::Location location = ice.location ? *ice.location : Luau::Location();
+        // Configuration files are read once, changes to them require a restart
+        for (const auto& pair : configResolver.configErrors)
+            fprintf(stderr, "%s: %s\n", pair.first.c_str(), pair.second.c_str());
 
-        std::string moduleName = ice.moduleName ? *ice.moduleName : "<unknown module>";
-        std::string humanReadableName = frontend.fileResolver->getHumanReadableModuleName(moduleName);
+        WatchedFiles watched;
+        addWatchedFiles(frontend, watched);
 
-        Luau::TypeError error(location, moduleName, Luau::InternalError{ice.message});
+        for (;;)
+        {
+            fflush(stdout);
 
-        report(format, humanReadableName.c_str(), location, "InternalCompilerError",
-            Luau::toString(error, Luau::TypeErrorToStringOptions{frontend.fileResolver}).c_str());
-        return 1;
+            // Files are polled, which works the same way on all platforms and only costs a stat call per module
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+            // Files added to the input directories are checked as well
+            std::vector<std::string> currentFiles = getSourceFiles(argc, argv);
+            bool filesAdded = currentFiles != files;
+            files = std::move(currentFiles);
+
+            if (!markChangedFiles(frontend, watched) && !filesAdded)
+                continue;
+
+            // Unchanged modules are not checked again, so diagnostics are only reported for changed modules and their dependents
+            checkFiles();
+            addWatchedFiles(frontend, watched);
+        }
     }
 
-    int failed = 0;
+    if (!result)
+        return 1;
 
-    for (const Luau::ModuleName& name : checkedModules)
-        failed += !reportModuleResult(frontend, name, format, annotate);
+    int failed = *result;
 
     if (!configResolver.configErrors.empty())
     {
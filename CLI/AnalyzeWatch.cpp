@@ -0,0 +1,62 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "AnalyzeWatch.h"
+
+#include "Luau/Frontend.h"
+
+#include "FileUtils.h"
+
+#include <vector>
+
+void addWatchedFiles(const Luau::Frontend& frontend, WatchedFiles& watched)
+{
+    auto add = [&watched](const std::string& path, const Luau::ModuleName& moduleName) {
+        if (path != "-" && watched.find(path) == watched.end())
+            watched[path] = {moduleName, getFileModificationTime(path)};
+    };
+
+    for (const auto& [name, sourceNode] : frontend.sourceNodes)
+    {
+        add(name, name);
+
+        for (const Luau::ModuleName& dep : sourceNode->requireSet)
+        {
+            add(dep, dep);
+
+            // Missing modules resolve to the .lua fallback in CliFileResolver, but creating the .luau file changes the resolution as well
+            if (dep.size() > 4 && dep.compare(dep.size() - 4, 4, ".lua") == 0)
+                add(dep + "u", dep);
+        }
+    }
+}
+
+bool markChangedFiles(Luau::Frontend& frontend, WatchedFiles& watched)
+{
+    bool changed = false;
+
+    for (auto& [path, file] : watched)
+    {
+        std::optional<int64_t> current = getFileModificationTime(path);
+
+        if (current == file.timestamp)
+            continue;
+
+        file.timestamp = current;
+        changed = true;
+
+        // Modules requiring the changed module are checked again even if it wasn't part of the graph before
+        std::vector<Luau::ModuleName> dependents;
+
+        for (const auto& [name, sourceNode] : frontend.sourceNodes)
+        {
+            if (sourceNode->requireSet.contains(file.moduleName))
+                dependents.push_back(name);
+        }
+
+        frontend.markDirty(file.moduleName);
+
+        for (const Luau::ModuleName& dependent : dependents)
+            frontend.markDirty(dependent);
+    }
+
+    return changed;
+}
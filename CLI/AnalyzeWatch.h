@@ -0,0 +1,30 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/FileResolver.h"
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <stdint.h>
+
+namespace Luau
+{
+class Frontend;
+}
+
+struct WatchedFile
+{
+    Luau::ModuleName moduleName;
+    std::optional<int64_t> timestamp;
+};
+
+// Maps file paths to the modules they affect; a file might not exist yet
+using WatchedFiles = std::unordered_map<std::string, WatchedFile>;
+
+// Records timestamps of the checked modules and of the modules they require
+void addWatchedFiles(const Luau::Frontend& frontend, WatchedFiles& watched);
+
+// Marks modules with changed files dirty, along with their dependents; returns true if any file changed
+bool markChangedFiles(Luau::Frontend& frontend, WatchedFiles& watched);
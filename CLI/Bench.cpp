@@ -0,0 +1,545 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lua.h"
+#include "lualib.h"
+
+#include "Luau/CodeGen.h"
+#include "Luau/Compiler.h"
+
+#include "BenchContainers.h"
+#include "BenchPipeline.h"
+#include "FileUtils.h"
+#include "Flags.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static int optimizationLevel = 1;
+static int iterations = 20;
+static int warmupIterations = 4;
+
+enum class BenchMode
+{
+    Interpreter,
+    Codegen,
+    Both,
+};
+
+// Hardware counters for the benchmark thread; when they can't be opened (e.g. in a container or on other platforms), values are reported as null
+struct PerfCounters
+{
+#ifdef __linux__
+    int cycles = -1;
+    int instructions = -1;
+
+    PerfCounters()
+    {
+        cycles = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+        instructions = cycles >= 0 ? open(PERF_COUNT_HW_INSTRUCTIONS, cycles) : -1;
+    }
+
+    ~PerfCounters()
+    {
+        if (instructions >= 0)
+            close(instructions);
+        if (cycles >= 0)
+            close(cycles);
+    }
+
+    bool available() const
+    {
+        return instructions >= 0;
+    }
+
+    void start()
+    {
+        ioctl(cycles, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(cycles, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void stop(uint64_t& cyclesValue, uint64_t& instructionsValue)
+    {
+        ioctl(cycles, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        if (read(cycles, &cyclesValue, sizeof(cyclesValue)) != sizeof(cyclesValue))
+            cyclesValue = 0;
+        if (read(instructions, &instructionsValue, sizeof(instructionsValue)) != sizeof(instructionsValue))
+            instructionsValue = 0;
+    }
+
+private:
+    static int open(uint64_t config, int group)
+    {
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = group < 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        return int(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+    }
+#else
+    bool available() const
+    {
+        return false;
+    }
+
+    void start() {}
+
+    void stop(uint64_t& cyclesValue, uint64_t& instructionsValue)
+    {
+        cyclesValue = 0;
+        instructionsValue = 0;
+    }
+#endif
+};
+
+struct BenchResult
+{
+    std::string name;
+
+    std::vector<double> times; // seconds; benchmarks can measure a part of their run and return its duration instead
+    std::vector<uint64_t> cycles;
+    std::vector<uint64_t> instructions;
+
+    uint64_t allocations = 0; // measured during a separate run, to keep the sampling callback out of the timed runs
+    uint64_t allocatedBytes = 0;
+
+    double gcTime = 0.0; // total over the timed runs
+    uint64_t gcSteps = 0;
+};
+
+struct BenchContext
+{
+    PerfCounters* counters = nullptr;
+
+    std::vector<BenchResult> results;
+    std::string error;
+
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+};
+
+static BenchContext* getContext(lua_State* L)
+{
+    return static_cast<BenchContext*>(lua_callbacks(L)->userdata);
+}
+
+static bool runIteration(lua_State* L, BenchContext& context, BenchResult* result)
+{
+    // like bench_support.lua, every run starts with a clean heap
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    lua_GCMetrics gcBefore;
+    lua_gcmetrics(L, &gcBefore);
+
+    lua_pushvalue(L, 1);
+
+    if (result && context.counters->available())
+        context.counters->start();
+
+    double start = lua_clock();
+    int status = lua_pcall(L, 0, 1, 0);
+    double end = lua_clock();
+
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+
+    if (result && context.counters->available())
+        context.counters->stop(cycles, instructions);
+
+    if (status != LUA_OK)
+    {
+        context.error = lua_tostring(L, -1) ? lua_tostring(L, -1) : "error object is not a string";
+        lua_pop(L, 1);
+        return false;
+    }
+
+    if (result)
+    {
+        lua_GCMetrics gcAfter;
+        lua_gcmetrics(L, &gcAfter);
+
+        result->times.push_back(lua_isnumber(L, -1) ? lua_tonumber(L, -1) : end - start);
+        result->cycles.push_back(cycles);
+        result->instructions.push_back(instructions);
+        result->gcTime += gcAfter.steptime - gcBefore.steptime;
+        result->gcSteps += gcAfter.steps - gcBefore.steps;
+    }
+
+    lua_pop(L, 1);
+    return true;
+}
+
+static void countAllocation(lua_State* L, int category, size_t size)
+{
+    BenchContext* context = getContext(L);
+
+    context->allocations++;
+    context->allocatedBytes += size;
+}
+
+// bench.runCode(f, description) from bench_support.lua; the function is run right away, in the same order as with the REPL
+static int benchRunCode(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+    const char* description = luaL_checkstring(L, 2);
+
+    BenchContext& context = *getContext(L);
+
+    BenchResult result;
+    result.name = description;
+
+    for (int i = 0; i < warmupIterations; ++i)
+        if (!runIteration(L, context, nullptr))
+            luaL_error(L, "%s", context.error.c_str());
+
+    for (int i = 0; i < iterations; ++i)
+        if (!runIteration(L, context, &result))
+            luaL_error(L, "%s", context.error.c_str());
+
+    // with a sample rate of 1 byte, every allocation is reported once with its exact size
+    context.allocations = 0;
+    context.allocatedBytes = 0;
+
+    lua_callbacks(L)->allocsample = countAllocation;
+    lua_setallocsamplerate(L, 1);
+
+    bool counted = runIteration(L, context, nullptr);
+
+    lua_setallocsamplerate(L, 0);
+    lua_callbacks(L)->allocsample = nullptr;
+
+    if (!counted)
+        luaL_error(L, "%s", context.error.c_str());
+
+    result.allocations = context.allocations;
+    result.allocatedBytes = context.allocatedBytes;
+
+    context.results.push_back(std::move(result));
+    return 0;
+}
+
+// benchmarks load bench_support with 'require'; there are no other modules available
+static int benchRequire(lua_State* L)
+{
+    std::string name = luaL_checkstring(L, 1);
+
+    if (name.size() < 13 || name.compare(name.size() - 13, 13, "bench_support") != 0)
+        luaL_error(L, "module '%s' is not available in the benchmark harness", name.c_str());
+
+    lua_getfield(L, LUA_REGISTRYINDEX, "bench_support");
+    return 1;
+}
+
+static bool runFile(const std::string& path, const std::string& source, bool codegen, PerfCounters& counters, std::vector<BenchResult>& results)
+{
+    std::unique_ptr<lua_State, void (*)(lua_State*)> globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    if (codegen)
+        Luau::CodeGen::create(L);
+
+    BenchContext context;
+    context.counters = &counters;
+
+    lua_callbacks(L)->userdata = &context;
+
+    luaL_openlibs(L);
+
+    lua_newtable(L);
+    lua_pushinteger(L, iterations);
+    lua_setfield(L, -2, "runs");
+    lua_pushinteger(L, warmupIterations);
+    lua_setfield(L, -2, "extraRuns");
+    lua_pushcfunction(L, benchRunCode, "runCode");
+    lua_setfield(L, -2, "runCode");
+    lua_setfield(L, LUA_REGISTRYINDEX, "bench_support");
+
+    lua_pushcfunction(L, benchRequire, "require");
+    lua_setglobal(L, "require");
+
+    Luau::CompileOptions options;
+    options.optimizationLevel = optimizationLevel;
+
+    std::string bytecode = Luau::compile(source, options);
+    std::string chunkname = "@" + path;
+
+    if (luau_load(L, chunkname.c_str(), bytecode.data(), bytecode.size(), 0) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", path.c_str(), lua_tostring(L, -1));
+        return false;
+    }
+
+    if (codegen)
+    {
+        Luau::CodeGen::CompilationOptions nativeOptions;
+        Luau::CodeGen::compile(L, -1, nativeOptions);
+    }
+
+    if (lua_pcall(L, 0, 0, 0) != LUA_OK)
+    {
+        fprintf(stderr, "%s: %s\n", path.c_str(), lua_tostring(L, -1));
+        return false;
+    }
+
+    results = std::move(context.results);
+    return true;
+}
+
+template<typename T>
+static T median(std::vector<T> values)
+{
+    std::sort(values.begin(), values.end());
+    return values.empty() ? T() : values[values.size() / 2];
+}
+
+static std::string escapeJson(const std::string& value)
+{
+    std::string result;
+
+    for (char ch : value)
+    {
+        if (ch == '"' || ch == '\\')
+            result += '\\';
+
+        if (unsigned(ch) < ' ')
+            result += ' ';
+        else
+            result += ch;
+    }
+
+    return result;
+}
+
+static void printResult(const char* mode, const BenchResult& result, bool counters, bool last)
+{
+    double minTime = *std::min_element(result.times.begin(), result.times.end());
+    double total = 0;
+
+    for (double time : result.times)
+        total += time;
+
+    printf("    \"%s\": {\"timeMs\": {\"min\": %.4f, \"median\": %.4f, \"mean\": %.4f}, ", mode, minTime * 1000, median(result.times) * 1000,
+        total / result.times.size() * 1000);
+
+    if (counters)
+        printf("\"cycles\": %llu, \"instructions\": %llu, ", (unsigned long long)median(result.cycles),
+            (unsigned long long)median(result.instructions));
+    else
+        printf("\"cycles\": null, \"instructions\": null, ");
+
+    printf("\"allocations\": %llu, \"allocatedBytes\": %llu, \"gcTimeMs\": %.4f, \"gcSteps\": %.1f}%s\n", (unsigned long long)result.allocations,
+        (unsigned long long)result.allocatedBytes, result.gcTime / result.times.size() * 1000, double(result.gcSteps) / result.times.size(),
+        last ? "" : ",");
+}
+
+static void displayHelp(const char* argv0)
+{
+    printf("Usage: %s [options] [file list]\n", argv0);
+    printf("\n");
+    printf("Runs benchmarks written for bench/bench_support.lua and prints results as JSON; directories are searched for .lua and .luau files.\n");
+    printf("Reported values are per run: time, cycles and instructions are medians, GC time and steps are means; cycles and instructions\n");
+    printf("are null when hardware counters aren't available.\n");
+    printf("\n");
+    printf("Available options:\n");
+    printf("  -h, --help: Display this usage message.\n");
+    printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 2).\n");
+    printf("  --iterations=<n>: number of measured runs of each benchmark (default 20).\n");
+    printf("  --warmup=<n>: number of runs of each benchmark before measurements start (default 4).\n");
+    printf("  --mode=<mode>: run benchmarks in interpreter, codegen or both (default) modes.\n");
+    printf("  --pipeline: measure lexing, parsing, compilation, type checking and native compilation of the files instead of running them.\n");
+    printf("  --repeat=<n>: with --pipeline, repeat each source n times to produce larger inputs (default 1).\n");
+    printf("  --containers: measure DenseHashMap and DenseHashGroupMap operations instead of running files.\n");
+    printf("  --fflags=<fflags>: flags to be enabled.\n");
+}
+
+int main(int argc, char** argv)
+{
+    setLuauFlagsDefault();
+
+    BenchMode mode = BenchMode::Both;
+    bool pipeline = false;
+    bool containers = false;
+    int repeat = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+        {
+            displayHelp(argv[0]);
+            return 0;
+        }
+        else if (strncmp(argv[i], "-O", 2) == 0)
+        {
+            int level = atoi(argv[i] + 2);
+            if (level < 0 || level > 2)
+            {
+                fprintf(stderr, "Error: Optimization level must be between 0 and 2 inclusive.\n");
+                return 1;
+            }
+            optimizationLevel = level;
+        }
+        else if (strncmp(argv[i], "--iterations=", 13) == 0)
+        {
+            iterations = atoi(argv[i] + 13);
+            if (iterations < 1)
+            {
+                fprintf(stderr, "Error: Iteration count must be positive.\n");
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--warmup=", 9) == 0)
+        {
+            warmupIterations = atoi(argv[i] + 9);
+            if (warmupIterations < 0)
+            {
+                fprintf(stderr, "Error: Warmup iteration count must be non-negative.\n");
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--mode=", 7) == 0)
+        {
+            const char* value = argv[i] + 7;
+
+            if (strcmp(value, "interpreter") == 0)
+                mode = BenchMode::Interpreter;
+            else if (strcmp(value, "codegen") == 0)
+                mode = BenchMode::Codegen;
+            else if (strcmp(value, "both") == 0)
+                mode = BenchMode::Both;
+            else
+            {
+                fprintf(stderr, "Error: unknown mode '%s'\n", value);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--pipeline") == 0)
+        {
+            pipeline = true;
+        }
+        else if (strcmp(argv[i], "--containers") == 0)
+        {
+            containers = true;
+        }
+        else if (strncmp(argv[i], "--repeat=", 9) == 0)
+        {
+            repeat = atoi(argv[i] + 9);
+            if (repeat < 1)
+            {
+                fprintf(stderr, "Error: Repeat count must be positive.\n");
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--fflags=", 9) == 0)
+        {
+            setLuauFlags(argv[i] + 9);
+        }
+        else if (argv[i][0] == '-')
+        {
+            fprintf(stderr, "Error: Unrecognized option '%s'.\n\n", argv[i]);
+            displayHelp(argv[0]);
+            return 1;
+        }
+    }
+
+    if (containers)
+    {
+        runContainerBenchmarks(iterations);
+        return 0;
+    }
+
+    if (pipeline)
+    {
+        std::vector<std::string> files = getSourceFiles(argc, argv);
+        std::sort(files.begin(), files.end());
+
+        return runPipelineBenchmarks(files, iterations, repeat) ? 1 : 0;
+    }
+
+    bool interpreter = mode != BenchMode::Codegen;
+    bool codegen = mode != BenchMode::Interpreter;
+
+    if (codegen && !Luau::CodeGen::isSupported())
+    {
+        fprintf(stderr, "Warning: Native code generation is not supported in current configuration\n");
+        codegen = false;
+    }
+
+    std::vector<std::string> files = getSourceFiles(argc, argv);
+    std::sort(files.begin(), files.end());
+
+    // bench_support itself is picked up when a whole directory is benchmarked
+    files.erase(std::remove_if(files.begin(), files.end(),
+                    [](const std::string& name) {
+                        return name.find("bench_support") != std::string::npos;
+                    }),
+        files.end());
+
+    PerfCounters counters;
+    int failed = 0;
+    bool first = true;
+
+    printf("[\n");
+
+    for (const std::string& path : files)
+    {
+        std::optional<std::string> source = readFile(path);
+
+        if (!source)
+        {
+            fprintf(stderr, "Error opening %s\n", path.c_str());
+            failed++;
+            continue;
+        }
+
+        std::vector<BenchResult> interpreterResults;
+        std::vector<BenchResult> codegenResults;
+
+        if ((interpreter && !runFile(path, *source, /* codegen= */ false, counters, interpreterResults)) ||
+            (codegen && !runFile(path, *source, /* codegen= */ true, counters, codegenResults)))
+        {
+            failed++;
+            continue;
+        }
+
+        size_t count = std::max(interpreterResults.size(), codegenResults.size());
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const BenchResult& any = i < interpreterResults.size() ? interpreterResults[i] : codegenResults[i];
+
+            printf("%s  {\n", first ? "" : ",\n");
+            printf("    \"name\": \"%s\",\n", escapeJson(any.name).c_str());
+            printf("    \"file\": \"%s\",\n", escapeJson(path).c_str());
+            printf("    \"iterations\": %d,\n", iterations);
+
+            bool hasCodegen = i < codegenResults.size();
+
+            if (i < interpreterResults.size())
+                printResult("interpreter", interpreterResults[i], counters.available(), !hasCodegen);
+
+            if (hasCodegen)
+                printResult("codegen", codegenResults[i], counters.available(), true);
+
+            printf("  }");
+            first = false;
+        }
+    }
+
+    printf("%s]\n", first ? "" : "\n");
+
+    return failed ? 1 : 0;
+}
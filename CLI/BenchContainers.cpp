@@ -0,0 +1,146 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "BenchContainers.h"
+
+#include "lua.h"
+
+#include "Luau/DenseHash.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+
+struct ContainerResult
+{
+    // per operation, medians over iterations
+    double insertNs = 0;
+    double hitNs = 0;
+    double missNs = 0;
+};
+
+static double median(std::vector<double>& values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// every round builds a new table from the keys and looks up each present and missing key once; small tables run more rounds so that every
+// measurement covers a similar number of operations
+template<typename Map, typename Key>
+static ContainerResult measure(const std::vector<Key>& keys, const std::vector<Key>& missing, const Key& emptyKey, int iterations)
+{
+    const size_t kOperations = 1 << 20;
+    size_t rounds = std::max(kOperations / keys.size(), size_t(1));
+    size_t ops = rounds * keys.size();
+
+    std::vector<double> insertTimes, hitTimes, missTimes;
+    size_t found = 0;
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        double insertTime = 0, hitTime = 0, missTime = 0;
+
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            Map map{emptyKey};
+
+            double start = lua_clock();
+
+            for (const Key& key : keys)
+                map[key] = 1;
+
+            double inserted = lua_clock();
+
+            for (const Key& key : keys)
+                found += map.contains(key);
+
+            double hit = lua_clock();
+
+            for (const Key& key : missing)
+                found += map.contains(key);
+
+            double end = lua_clock();
+
+            insertTime += inserted - start;
+            hitTime += hit - inserted;
+            missTime += end - hit;
+        }
+
+        insertTimes.push_back(insertTime * 1e9 / ops);
+        hitTimes.push_back(hitTime * 1e9 / ops);
+        missTimes.push_back(missTime * 1e9 / ops);
+    }
+
+    // every key is present exactly once
+    if (found != ops * iterations)
+        fprintf(stderr, "Warning: unexpected lookup results\n");
+
+    ContainerResult result;
+    result.insertNs = median(insertTimes);
+    result.hitNs = median(hitTimes);
+    result.missNs = median(missTimes);
+    return result;
+}
+
+static void printResult(const char* name, const ContainerResult& result, bool last)
+{
+    printf("    \"%s\": {\"insertNs\": %.2f, \"hitNs\": %.2f, \"missNs\": %.2f}%s\n", name, result.insertNs, result.hitNs, result.missNs, last ? "" : ",");
+}
+
+template<typename Key>
+static void runKeys(const char* kind, size_t size, const std::vector<Key>& keys, const std::vector<Key>& missing, const Key& emptyKey,
+    int iterations, bool& first)
+{
+    ContainerResult dense = measure<Luau::DenseHashMap<Key, int>>(keys, missing, emptyKey, iterations);
+    ContainerResult group = measure<Luau::DenseHashGroupMap<Key, int>>(keys, missing, emptyKey, iterations);
+
+    printf("%s  {\n", first ? "" : ",\n");
+    printf("    \"keys\": \"%s\",\n", kind);
+    printf("    \"size\": %d,\n", int(size));
+    printResult("DenseHashMap", dense, false);
+    printResult("DenseHashGroupMap", group, true);
+    printf("  }");
+
+    first = false;
+}
+
+void runContainerBenchmarks(int iterations)
+{
+    static const size_t kSizes[] = {16, 256, 4096, 65536};
+
+    bool first = true;
+
+    printf("[\n");
+
+    for (size_t size : kSizes)
+    {
+        // pointers to separate allocations are close to the typical keys in analysis and compiler maps (AST nodes, types)
+        std::vector<std::unique_ptr<char[]>> blocks;
+        std::vector<const void*> pointers;
+
+        for (size_t i = 0; i < size * 2; ++i)
+        {
+            blocks.push_back(std::make_unique<char[]>(48));
+            pointers.push_back(blocks.back().get());
+        }
+
+        std::vector<const void*> pointerKeys(pointers.begin(), pointers.begin() + size);
+        std::vector<const void*> pointerMissing(pointers.begin() + size, pointers.end());
+
+        runKeys<const void*>("pointer", size, pointerKeys, pointerMissing, nullptr, iterations, first);
+
+        std::vector<std::string> stringKeys, stringMissing;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            stringKeys.push_back("identifier_" + std::to_string(i));
+            stringMissing.push_back("identifier_" + std::to_string(i + size));
+        }
+
+        runKeys<std::string>("string", size, stringKeys, stringMissing, std::string(), iterations, first);
+    }
+
+    printf("%s]\n", first ? "" : "\n");
+}
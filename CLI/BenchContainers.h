@@ -0,0 +1,6 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+// Measures insertion and lookups of present and missing keys in DenseHashMap and DenseHashGroupMap with pointer and string keys at several
+// table sizes and prints results as JSON
+void runContainerBenchmarks(int iterations);
@@ -0,0 +1,286 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "BenchPipeline.h"
+
+#include "lua.h"
+#include "lualib.h"
+
+#include "Luau/BuiltinDefinitions.h"
+#include "Luau/CodeGen.h"
+#include "Luau/Common.h"
+#include "Luau/Compiler.h"
+#include "Luau/Frontend.h"
+#include "Luau/Lexer.h"
+#include "Luau/Parser.h"
+
+#include "FileUtils.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+LUAU_FASTFLAG(DebugLuauDeferredConstraintResolution)
+
+// Heap usage of the process, tracked by the replacement of the global allocation functions below; stages run on a single thread
+static size_t gHeapBytes = 0;
+static size_t gHeapPeakBytes = 0;
+
+// every block starts with a header that keeps its size; the header is padded to keep the default alignment of the data after it
+struct alignas(max_align_t) HeapHeader
+{
+    size_t size;
+};
+
+// note: allocation functions aren't inlined so that the compiler doesn't apply the bounds of the data to the header in front of it
+LUAU_NOINLINE void* operator new(size_t size)
+{
+    HeapHeader* header = static_cast<HeapHeader*>(malloc(sizeof(HeapHeader) + size));
+
+    if (!header)
+        throw std::bad_alloc();
+
+    header->size = size;
+
+    gHeapBytes += size;
+    gHeapPeakBytes = std::max(gHeapPeakBytes, gHeapBytes);
+
+    return header + 1;
+}
+
+LUAU_NOINLINE void operator delete(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    HeapHeader* header = static_cast<HeapHeader*>(ptr) - 1;
+
+    gHeapBytes -= header->size;
+
+    free(header);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+struct StageResult
+{
+    const char* name = nullptr;
+
+    std::vector<double> times;
+    size_t peakBytes = 0; // above the heap usage at the start of the iteration
+};
+
+struct BenchFileResolver : Luau::FileResolver
+{
+    std::string source;
+
+    std::optional<Luau::SourceCode> readSource(const Luau::ModuleName& name) override
+    {
+        return Luau::SourceCode{source, Luau::SourceCode::Module};
+    }
+};
+
+// runs 'setup' outside of the measurement, then measures 'stage'; setup can keep state alive until the next iteration starts
+static StageResult measure(const char* name, int iterations, const std::function<void()>& setup, const std::function<bool()>& stage)
+{
+    StageResult result;
+    result.name = name;
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        if (setup)
+            setup();
+
+        size_t startBytes = gHeapBytes;
+        gHeapPeakBytes = gHeapBytes;
+
+        double start = lua_clock();
+        bool success = stage();
+        double end = lua_clock();
+
+        if (!success)
+            return StageResult();
+
+        result.times.push_back(end - start);
+        result.peakBytes = std::max(result.peakBytes, gHeapPeakBytes - startBytes);
+    }
+
+    return result;
+}
+
+static int countLines(const std::string& source)
+{
+    return int(std::count(source.begin(), source.end(), '\n')) + 1;
+}
+
+static void printStage(const StageResult& stage, int lines, bool last)
+{
+    std::vector<double> times = stage.times;
+    std::sort(times.begin(), times.end());
+
+    double median = times[times.size() / 2];
+
+    printf("      \"%s\": {\"timeMs\": {\"min\": %.4f, \"median\": %.4f}, \"linesPerSecond\": %.0f, \"peakBytes\": %llu}%s\n", stage.name,
+        times[0] * 1000, median * 1000, median > 0 ? lines / median : 0.0, (unsigned long long)stage.peakBytes, last ? "" : ",");
+}
+
+static std::vector<StageResult> runStages(const std::string& path, const std::string& source, int iterations)
+{
+    std::vector<StageResult> stages;
+
+    stages.push_back(measure("lex", iterations, nullptr, [&]() {
+        Luau::Allocator allocator;
+        Luau::AstNameTable names(allocator);
+        Luau::Lexer lexer(source.data(), source.size(), names);
+
+        while (lexer.next().type != Luau::Lexeme::Eof)
+        {
+        }
+
+        return true;
+    }));
+
+    stages.push_back(measure("parse", iterations, nullptr, [&]() {
+        Luau::Allocator allocator;
+        Luau::AstNameTable names(allocator);
+        Luau::ParseResult result = Luau::Parser::parse(source.data(), source.size(), names, allocator);
+
+        return result.errors.empty();
+    }));
+
+    for (int level = 0; level <= 2; ++level)
+    {
+        static const char* const kCompileStages[] = {"compileO0", "compileO1", "compileO2"};
+
+        stages.push_back(measure(kCompileStages[level], iterations, nullptr, [&]() {
+            Luau::CompileOptions options;
+            options.optimizationLevel = level;
+
+            std::string bytecode = Luau::compile(source, options);
+            return !bytecode.empty() && bytecode[0] != 0;
+        }));
+    }
+
+    for (bool newSolver : {false, true})
+    {
+        BenchFileResolver fileResolver;
+        fileResolver.source = source;
+
+        Luau::NullConfigResolver configResolver;
+        configResolver.defaultConfig.mode = Luau::Mode::Nonstrict;
+
+        std::unique_ptr<Luau::Frontend> frontend;
+
+        bool oldSolver = FFlag::DebugLuauDeferredConstraintResolution;
+        FFlag::DebugLuauDeferredConstraintResolution.value = newSolver;
+
+        // builtin definitions are shared by all checks, so they are registered outside of the measurement
+        stages.push_back(measure(
+            newSolver ? "checkNewSolver" : "checkOldSolver", iterations,
+            [&]() {
+                frontend.reset();
+                frontend = std::make_unique<Luau::Frontend>(&fileResolver, &configResolver);
+
+                Luau::registerBuiltinGlobals(*frontend, frontend->globals);
+                Luau::freeze(frontend->globals.globalTypes);
+            },
+            [&]() {
+                frontend->check(path);
+                return true;
+            }));
+
+        frontend.reset();
+
+        FFlag::DebugLuauDeferredConstraintResolution.value = oldSolver;
+    }
+
+    if (Luau::CodeGen::isSupported())
+    {
+        std::string bytecode = Luau::compile(source);
+        std::unique_ptr<lua_State, void (*)(lua_State*)> globalState(nullptr, lua_close);
+
+        stages.push_back(measure(
+            "codegen", iterations,
+            [&]() {
+                globalState.reset(luaL_newstate());
+                Luau::CodeGen::create(globalState.get());
+
+                luau_load(globalState.get(), "=bench", bytecode.data(), bytecode.size(), 0);
+            },
+            [&]() {
+                Luau::CodeGen::CompilationOptions options;
+                options.flags = Luau::CodeGen::CodeGen_ColdFunctions;
+
+                Luau::CodeGen::CompilationResult result = Luau::CodeGen::compile(globalState.get(), -1, options);
+                return result.result == Luau::CodeGen::CodeGenCompilationResult::Success;
+            }));
+    }
+
+    return stages;
+}
+
+int runPipelineBenchmarks(const std::vector<std::string>& files, int iterations, int repeat)
+{
+    int failed = 0;
+    bool first = true;
+
+    printf("[\n");
+
+    for (const std::string& path : files)
+    {
+        std::optional<std::string> contents = readFile(path);
+
+        if (!contents)
+        {
+            fprintf(stderr, "Error opening %s\n", path.c_str());
+            failed++;
+            continue;
+        }
+
+        // blocks keep locals of each copy in a separate scope, so that the copies don't run into the limit on the number of locals
+        std::string source;
+
+        if (repeat > 1)
+        {
+            for (int i = 0; i < repeat; ++i)
+                source += "do\n" + *contents + "\nend\n";
+        }
+        else
+        {
+            source = *contents;
+        }
+
+        int lines = countLines(source);
+
+        std::vector<StageResult> stages = runStages(path, source, iterations);
+
+        printf("%s  {\n", first ? "" : ",\n");
+        printf("    \"file\": \"%s\",\n", path.c_str());
+        printf("    \"lines\": %d,\n", lines);
+        printf("    \"stages\": {\n");
+
+        // stages that failed (e.g. a source that doesn't parse) are omitted
+        stages.erase(std::remove_if(stages.begin(), stages.end(),
+                         [](const StageResult& stage) {
+                             return stage.times.empty();
+                         }),
+            stages.end());
+
+        for (size_t i = 0; i < stages.size(); ++i)
+            printStage(stages[i], lines, i + 1 == stages.size());
+
+        printf("    }\n");
+        printf("  }");
+
+        first = false;
+    }
+
+    printf("%s]\n", first ? "" : "\n");
+
+    return failed;
+}
@@ -0,0 +1,9 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Measures throughput of lexing, parsing, compilation, type checking and native compilation of the files and prints results as JSON;
+// each source is repeated 'repeat' times (in separate blocks) to produce larger inputs. Returns the number of files that failed
+int runPipelineBenchmarks(const std::vector<std::string>& files, int iterations, int repeat);
@@ -36,7 +36,7 @@ static void displayHelp(const char* argv0)
     printf("\n");
     printf("Available options:\n");
     printf("  -h, --help: Display this usage message.\n");
-    printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 2).\n");
+    printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 3).\n");
     printf("  -g<n>: compile with debug level n (default 1, n should be between 0 and 2).\n");
     printf("  --fflags=<fflags>: flags to be enabled.\n");
     printf("  --summary-file=<filename>: file in which bytecode analysis summary will be recorded (default 'bytecode-summary.json').\n");
@@ -55,9 +55,9 @@ static bool parseArgs(int argc, char** argv, std::string& summaryFile)
         else if (strncmp(argv[i], "-O", 2) == 0)
         {
             int level = atoi(argv[i] + 2);
-            if (level < 0 || level > 2)
+            if (level < 0 || level > 3)
             {
-                fprintf(stderr, "Error: Optimization level must be between 0 and 2 inclusive.\n");
+                fprintf(stderr, "Error: Optimization level must be between 0 and 3 inclusive.\n");
                 return false;
             }
             globalOptions.optimizationLevel = level;
@@ -11,7 +11,9 @@
 #include "FileUtils.h"
 #include "Flags.h"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
 #ifdef _WIN32
 #include <io.h>
@@ -289,7 +291,8 @@ static double recordDeltaTime(double& timer)
     return delta;
 }
 
-static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::AssemblyOptions::Target assemblyTarget, CompileStats& stats)
+static bool compileFile(
+    const char* name, CompileFormat format, Luau::CodeGen::AssemblyOptions::Target assemblyTarget, CompileStats& stats, std::string& output)
 {
     double currts = Luau::TimeTrace::getClock();
 
@@ -363,19 +366,19 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
         switch (format)
         {
         case CompileFormat::Text:
-            printf("%s", bcb.dumpEverything().c_str());
+            output += bcb.dumpEverything();
             break;
         case CompileFormat::Remarks:
-            printf("%s", bcb.dumpSourceRemarks().c_str());
+            output += bcb.dumpSourceRemarks();
             break;
         case CompileFormat::Binary:
-            fwrite(bcb.getBytecode().data(), 1, bcb.getBytecode().size(), stdout);
+            output += bcb.getBytecode();
             break;
         case CompileFormat::Codegen:
         case CompileFormat::CodegenAsm:
         case CompileFormat::CodegenIr:
         case CompileFormat::CodegenVerbose:
-            printf("%s", getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats).c_str());
+            output += getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats);
             break;
         case CompileFormat::CodegenNull:
             stats.codegen += getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats).size();
@@ -409,8 +412,9 @@ static void displayHelp(const char* argv0)
     printf("\n");
     printf("Available options:\n");
     printf("  -h, --help: Display this usage message.\n");
-    printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 2).\n");
+    printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 3).\n");
     printf("  -g<n>: compile with debug level n (default 1, n should be between 0 and 2).\n");
+    printf("  -j<n>: compile files using n threads (default 1, 0 uses all hardware threads).\n");
     printf("  --target=<target>: compile code for specific architecture (a64, x64, a64_nf, x64_ms).\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
     printf("  --record-stats=<granularity>: granularity of compilation stats (total, file, function).\n");
@@ -462,6 +466,7 @@ int main(int argc, char** argv)
     RecordStats recordStats = RecordStats::None;
     std::string statsFile("stats.json");
     bool bytecodeSummary = false;
+    int threadCount = 1;
 
     for (int i = 1; i < argc; i++)
     {
@@ -473,9 +478,9 @@ int main(int argc, char** argv)
         else if (strncmp(argv[i], "-O", 2) == 0)
         {
             int level = atoi(argv[i] + 2);
-            if (level < 0 || level > 2)
+            if (level < 0 || level > 3)
             {
-                fprintf(stderr, "Error: Optimization level must be between 0 and 2 inclusive.\n");
+                fprintf(stderr, "Error: Optimization level must be between 0 and 3 inclusive.\n");
                 return 1;
             }
             globalOptions.optimizationLevel = level;
@@ -490,6 +495,15 @@ int main(int argc, char** argv)
             }
             globalOptions.debugLevel = level;
         }
+        else if (strncmp(argv[i], "-j", 2) == 0)
+        {
+            threadCount = atoi(argv[i] + 2);
+            if (threadCount < 0)
+            {
+                fprintf(stderr, "Error: Thread count must be non-negative.\n");
+                return 1;
+            }
+        }
         else if (strncmp(argv[i], "-t", 2) == 0)
         {
             int level = atoi(argv[i] + 2);
@@ -604,21 +618,51 @@ int main(int argc, char** argv)
     const size_t fileCount = files.size();
     CompileStats stats = {};
 
-    std::vector<CompileStats> fileStats;
-    if (recordStats == RecordStats::File || recordStats == RecordStats::Function)
-        fileStats.reserve(fileCount);
+    std::vector<CompileStats> fileStats(fileCount);
+    std::vector<std::string> fileOutputs(fileCount);
+    std::vector<char> fileSucceeded(fileCount);
 
     int failed = 0;
     unsigned functionStats = (recordStats == RecordStats::Function ? Luau::CodeGen::FunctionStats_Enable : 0) |
                              (bytecodeSummary ? Luau::CodeGen::FunctionStats_BytecodeSummary : 0);
-    for (const std::string& path : files)
+
+    auto compileFileAt = [&](size_t index) {
+        fileStats[index].lowerStats.functionStatsFlags = functionStats;
+        fileSucceeded[index] = compileFile(files[index].c_str(), compileFormat, assemblyTarget, fileStats[index], fileOutputs[index]);
+    };
+
+    if (threadCount == 0)
+        threadCount = int(std::max(std::thread::hardware_concurrency(), 1u));
+
+    // files are compiled independently; with multiple threads, output is buffered and written in the original file order after all files are
+    // compiled so that it matches a single-threaded run (time stats are summed across threads in that case)
+    if (threadCount > 1)
     {
-        CompileStats fileStat = {};
-        fileStat.lowerStats.functionStatsFlags = functionStats;
-        failed += !compileFile(path.c_str(), compileFormat, assemblyTarget, fileStat);
-        stats += fileStat;
-        if (recordStats == RecordStats::File || recordStats == RecordStats::Function)
-            fileStats.push_back(fileStat);
+        std::atomic<size_t> nextFile = 0;
+        std::vector<std::thread> workers;
+
+        for (int i = 0; i < threadCount && size_t(i) < fileCount; ++i)
+        {
+            workers.emplace_back([&] {
+                for (size_t index = nextFile++; index < fileCount; index = nextFile++)
+                    compileFileAt(index);
+            });
+        }
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    for (size_t i = 0; i < fileCount; ++i)
+    {
+        if (threadCount <= 1)
+            compileFileAt(i);
+
+        fwrite(fileOutputs[i].data(), 1, fileOutputs[i].size(), stdout);
+        fileOutputs[i] = std::string();
+
+        failed += !fileSucceeded[i];
+        stats += fileStats[i];
     }
 
     if (compileFormat == CompileFormat::Null)
@@ -3,13 +3,29 @@
 
 #include "lua.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
+struct FunctionCoverage
+{
+    int linedefined = 0;
+    int hits = 0;
+};
+
+struct FileCoverage
+{
+    std::map<std::string, FunctionCoverage> functions;
+    std::map<int, int> lines;
+};
+
 struct Coverage
 {
     lua_State* L = nullptr;
     std::vector<int> functions;
+
+    // hits merged across all tracked functions, by source name
+    std::map<std::string, FileCoverage> files;
 } gCoverage;
 
 void coverageInit(lua_State* L)
@@ -30,7 +46,7 @@ void coverageTrack(lua_State* L, int funcindex)
 
 static void coverageCallback(void* context, const char* function, int linedefined, int depth, const int* hits, size_t size)
 {
-    FILE* f = static_cast<FILE*>(context);
+    FileCoverage* file = static_cast<FileCoverage*>(context);
 
     std::string name;
 
@@ -41,24 +57,37 @@ static void coverageCallback(void* context, const char* function, int linedefine
     else
         name = "<anonymous>:" + std::to_string(linedefined);
 
-    fprintf(f, "FN:%d,%s\n", linedefined, name.c_str());
+    FunctionCoverage& fn = file->functions[name];
+    fn.linedefined = linedefined;
 
     for (size_t i = 0; i < size; ++i)
         if (hits[i] != -1)
         {
-            fprintf(f, "FNDA:%d,%s\n", hits[i], name.c_str());
+            fn.hits += hits[i];
             break;
         }
 
     for (size_t i = 0; i < size; ++i)
         if (hits[i] != -1)
-            fprintf(f, "DA:%d,%d\n", int(i), hits[i]);
+            file->lines[int(i)] += hits[i];
 }
 
 void coverageDump(const char* path)
 {
     lua_State* L = gCoverage.L;
 
+    for (int fref : gCoverage.functions)
+    {
+        lua_getref(L, fref);
+
+        lua_Debug ar = {};
+        lua_getinfo(L, -1, "s", &ar);
+
+        lua_getcoverage(L, -1, &gCoverage.files[ar.short_src], coverageCallback);
+
+        lua_pop(L, 1);
+    }
+
     FILE* f = fopen(path, "w");
     if (!f)
     {
@@ -68,21 +97,37 @@ void coverageDump(const char* path)
 
     fprintf(f, "TN:\n");
 
-    for (int fref : gCoverage.functions)
+    for (const auto& [source, file] : gCoverage.files)
     {
-        lua_getref(L, fref);
+        fprintf(f, "SF:%s\n", source.c_str());
 
-        lua_Debug ar = {};
-        lua_getinfo(L, -1, "s", &ar);
+        for (const auto& [name, fn] : file.functions)
+            fprintf(f, "FN:%d,%s\n", fn.linedefined, name.c_str());
 
-        fprintf(f, "SF:%s\n", ar.short_src);
-        lua_getcoverage(L, -1, f, coverageCallback);
-        fprintf(f, "end_of_record\n");
+        int functionsHit = 0;
 
-        lua_pop(L, 1);
+        for (const auto& [name, fn] : file.functions)
+        {
+            fprintf(f, "FNDA:%d,%s\n", fn.hits, name.c_str());
+            functionsHit += fn.hits > 0;
+        }
+
+        fprintf(f, "FNF:%d\nFNH:%d\n", int(file.functions.size()), functionsHit);
+
+        int linesHit = 0;
+
+        for (const auto& [line, hits] : file.lines)
+        {
+            fprintf(f, "DA:%d,%d\n", line, hits);
+            linesHit += hits > 0;
+        }
+
+        fprintf(f, "LF:%d\nLH:%d\n", int(file.lines.size()), linesHit);
+
+        fprintf(f, "end_of_record\n");
     }
 
     fclose(f);
 
-    printf("Coverage dump written to %s (%d functions)\n", path, int(gCoverage.functions.size()));
+    printf("Coverage dump written to %s (%d files)\n", path, int(gCoverage.files.size()));
 }
@@ -7,4 +7,5 @@ void coverageInit(lua_State* L);
 bool coverageActive();
 
 void coverageTrack(lua_State* L, int funcindex);
+
 void coverageDump(const char* path);
@@ -19,6 +19,10 @@
 #include <sys/stat.h>
 #endif
 
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+
 #include <string.h>
 
 #ifdef _WIN32
@@ -237,6 +241,38 @@ std::optional<std::string> readStdin()
     return result;
 }
 
+bool writeFile(const std::string& name, const std::string& contents)
+{
+    // the contents are written to a temporary file first, so that other processes never observe a partially written file
+#ifdef _WIN32
+    std::string tempName = name + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+    FILE* file = _wfopen(fromUtf8(tempName).c_str(), L"wb");
+#else
+    std::string tempName = name + "." + std::to_string(getpid()) + ".tmp";
+    FILE* file = fopen(tempName.c_str(), "wb");
+#endif
+
+    if (!file)
+        return false;
+
+    size_t written = fwrite(contents.data(), 1, contents.size(), file);
+    bool success = fclose(file) == 0 && written == contents.size();
+
+#ifdef _WIN32
+    success = success && MoveFileExW(fromUtf8(tempName).c_str(), fromUtf8(name).c_str(), MOVEFILE_REPLACE_EXISTING);
+
+    if (!success)
+        _wremove(fromUtf8(tempName).c_str());
+#else
+    success = success && rename(tempName.c_str(), name.c_str()) == 0;
+
+    if (!success)
+        remove(tempName.c_str());
+#endif
+
+    return success;
+}
+
 template<typename Ch>
 static void joinPaths(std::basic_string<Ch>& str, const Ch* lhs, const Ch* rhs)
 {
@@ -367,6 +403,64 @@ bool isDirectory(const std::string& path)
 #endif
 }
 
+bool isFile(const std::string& path)
+{
+#ifdef _WIN32
+    DWORD fileAttributes = GetFileAttributesW(fromUtf8(path).c_str());
+    if (fileAttributes == INVALID_FILE_ATTRIBUTES)
+        return false;
+    return (fileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+#else
+    struct stat st = {};
+    if (stat(path.c_str(), &st) != 0)
+        return false;
+    return (st.st_mode & S_IFMT) == S_IFREG;
+#endif
+}
+
+std::optional<int64_t> getFileModificationTime(const std::string& path)
+{
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA data = {};
+    if (!GetFileAttributesExW(fromUtf8(path).c_str(), GetFileExInfoStandard, &data))
+        return std::nullopt;
+    return int64_t((uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime);
+#else
+    struct stat st = {};
+    if (stat(path.c_str(), &st) != 0)
+        return std::nullopt;
+#ifdef __APPLE__
+    return int64_t(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    return int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+#endif
+}
+
+std::optional<std::string> getExecutablePath()
+{
+#if defined(_WIN32)
+    std::wstring buf(MAX_PATH, L'\0');
+    DWORD length = GetModuleFileNameW(nullptr, &buf[0], DWORD(buf.size()));
+    if (length == 0 || length == buf.size())
+        return std::nullopt;
+    buf.resize(length);
+    return toUtf8(buf);
+#elif defined(__APPLE__)
+    char buf[4096];
+    uint32_t size = sizeof(buf);
+    if (_NSGetExecutablePath(buf, &size) != 0)
+        return std::nullopt;
+    return std::string(buf);
+#else
+    char buf[4096];
+    ssize_t length = readlink("/proc/self/exe", buf, sizeof(buf));
+    if (length <= 0 || size_t(length) == sizeof(buf))
+        return std::nullopt;
+    return std::string(buf, length);
+#endif
+}
+
 std::vector<std::string_view> splitPath(std::string_view path)
 {
     std::vector<std::string_view> components;
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <optional>
+#include <stdint.h>
 #include <string>
 #include <string_view>
 #include <functional>
@@ -15,9 +16,17 @@ std::string resolvePath(std::string_view relativePath, std::string_view baseFile
 std::optional<std::string> readFile(const std::string& name);
 std::optional<std::string> readStdin();
 
+bool writeFile(const std::string& name, const std::string& contents);
+
 bool isAbsolutePath(std::string_view path);
 bool isExplicitlyRelative(std::string_view path);
 bool isDirectory(const std::string& path);
+bool isFile(const std::string& path);
+
+// Returns an opaque timestamp of the last modification of a file, which changes when the file is written to
+std::optional<int64_t> getFileModificationTime(const std::string& path);
+// Returns the path of the running executable
+std::optional<std::string> getExecutablePath();
 bool traverseDirectory(const std::string& path, const std::function<void(const std::string& name)>& callback);
 
 std::vector<std::string_view> splitPath(std::string_view path);
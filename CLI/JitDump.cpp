@@ -0,0 +1,182 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "JitDump.h"
+
+#if __linux__
+#include "Luau/CodeGen.h"
+
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// The format is described in tools/perf/Documentation/jitdump-specification.txt of the Linux kernel source tree
+const uint32_t kJitDumpMagic = 0x4A695444;
+const uint32_t kJitDumpVersion = 1;
+
+const uint32_t kJitCodeLoad = 0;
+const uint32_t kJitCodeDebugInfo = 2;
+
+struct JitDumpHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t totalSize;
+    uint32_t elfMach;
+    uint32_t pad1;
+    uint32_t pid;
+    uint64_t timestamp;
+    uint64_t flags;
+};
+
+struct JitDumpRecordHeader
+{
+    uint32_t id;
+    uint32_t totalSize;
+    uint64_t timestamp;
+};
+
+struct JitDumpCodeLoad
+{
+    JitDumpRecordHeader header;
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t vma;
+    uint64_t codeAddr;
+    uint64_t codeSize;
+    uint64_t codeIndex;
+};
+
+struct JitDumpDebugInfo
+{
+    JitDumpRecordHeader header;
+    uint64_t codeAddr;
+    uint64_t entryCount;
+};
+
+struct JitDumpDebugEntry
+{
+    uint64_t codeAddr;
+    uint32_t line;
+    uint32_t discrim;
+};
+
+struct JitDumpLine
+{
+    uintptr_t addr;
+    int line;
+    std::string source;
+};
+
+struct JitDump
+{
+    FILE* file = nullptr;
+    uint64_t codeIndex = 0;
+
+    // line ranges of the function that is about to be reported
+    std::vector<JitDumpLine> lines;
+} gJitDump;
+
+// perf needs to be recorded with '-k mono' for the timestamps to match
+static uint64_t getTimestamp()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
+
+static void jitDumpLine(void* context, uintptr_t addr, unsigned size, const char* source, int line)
+{
+    gJitDump.lines.push_back({addr, line, source});
+}
+
+static void jitDumpFunction(void* context, uintptr_t addr, unsigned size, const char* symbol)
+{
+    FILE* f = gJitDump.file;
+    uint64_t timestamp = getTimestamp();
+
+    if (!gJitDump.lines.empty())
+    {
+        uint32_t totalSize = sizeof(JitDumpDebugInfo);
+
+        for (const JitDumpLine& l : gJitDump.lines)
+            totalSize += uint32_t(sizeof(JitDumpDebugEntry) + l.source.size() + 1);
+
+        JitDumpDebugInfo info = {{kJitCodeDebugInfo, totalSize, timestamp}, addr, gJitDump.lines.size()};
+        fwrite(&info, sizeof(info), 1, f);
+
+        for (const JitDumpLine& l : gJitDump.lines)
+        {
+            JitDumpDebugEntry entry = {l.addr, uint32_t(l.line), 0};
+            fwrite(&entry, sizeof(entry), 1, f);
+            fwrite(l.source.c_str(), l.source.size() + 1, 1, f);
+        }
+
+        gJitDump.lines.clear();
+    }
+
+    size_t symbolSize = strlen(symbol) + 1;
+
+    JitDumpCodeLoad load = {};
+    load.header = {kJitCodeLoad, uint32_t(sizeof(load) + symbolSize + size), timestamp};
+    load.pid = uint32_t(getpid());
+    load.tid = uint32_t(syscall(SYS_gettid));
+    load.vma = addr;
+    load.codeAddr = addr;
+    load.codeSize = size;
+    load.codeIndex = gJitDump.codeIndex++;
+
+    fwrite(&load, sizeof(load), 1, f);
+    fwrite(symbol, symbolSize, 1, f);
+    fwrite(reinterpret_cast<const void*>(addr), size, 1, f);
+}
+
+bool jitDumpStart()
+{
+    char path[128];
+    snprintf(path, sizeof(path), "/tmp/jit-%d.dump", getpid());
+
+    // note, there's no need to close the dump explicitly as it will be closed when the process exits
+    FILE* f = fopen(path, "w+");
+    if (!f)
+        return false;
+
+    // perf finds the dump through an executable mapping of the file that it observes while recording
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (mmap(nullptr, size_t(pageSize), PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(f), 0) == MAP_FAILED)
+    {
+        fclose(f);
+        return false;
+    }
+
+    JitDumpHeader header = {};
+    header.magic = kJitDumpMagic;
+    header.version = kJitDumpVersion;
+    header.totalSize = sizeof(header);
+#if defined(__aarch64__)
+    header.elfMach = EM_AARCH64;
+#else
+    header.elfMach = EM_X86_64;
+#endif
+    header.pid = uint32_t(getpid());
+    header.timestamp = getTimestamp();
+
+    fwrite(&header, sizeof(header), 1, f);
+
+    gJitDump.file = f;
+
+    Luau::CodeGen::setPerfLog(nullptr, jitDumpFunction, jitDumpLine);
+    return true;
+}
+#else
+bool jitDumpStart()
+{
+    return false;
+}
+#endif
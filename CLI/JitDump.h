@@ -0,0 +1,5 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+// Starts writing native code and its source line mapping to /tmp/jit-<pid>.dump in the jitdump format used by 'perf inject --jit'
+bool jitDumpStart();
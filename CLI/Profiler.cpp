@@ -1,11 +1,14 @@
 // This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
 #include "lua.h"
 
+#include "Luau/BytecodeUtils.h"
 #include "Luau/DenseHash.h"
 
 #include <thread>
 #include <atomic>
 #include <string>
+#include <vector>
+#include <algorithm>
 
 struct Profiler
 {
@@ -26,8 +29,30 @@ struct Profiler
     // statistics, updated by trigger
     Luau::DenseHashMap<std::string, uint64_t> data{""};
     uint64_t gc[16] = {};
+
+    // allocation statistics, updated by allocation sampling
+    Luau::DenseHashMap<std::string, uint64_t> allocData{""};
+    uint64_t allocSamples = 0;
 } gProfiler;
 
+static void appendStack(lua_State* L, std::string& stack)
+{
+    lua_Debug ar;
+    for (int level = 0; lua_getinfo(L, level, "sn", &ar); ++level)
+    {
+        if (!stack.empty())
+            stack += ';';
+
+        stack += ar.short_src;
+        stack += ',';
+        if (ar.name)
+            stack += ar.name;
+        stack += ',';
+        if (ar.linedefined > 0)
+            stack += std::to_string(ar.linedefined);
+    }
+}
+
 static void profilerTrigger(lua_State* L, int gc)
 {
     uint64_t currentTicks = gProfiler.ticks.load();
@@ -42,20 +67,7 @@ static void profilerTrigger(lua_State* L, int gc)
         if (gc > 0)
             stack += "GC,GC,";
 
-        lua_Debug ar;
-        for (int level = 0; lua_getinfo(L, level, "sn", &ar); ++level)
-        {
-            if (!stack.empty())
-                stack += ';';
-
-            stack += ar.short_src;
-            stack += ',';
-            if (ar.name)
-                stack += ar.name;
-            stack += ',';
-            if (ar.linedefined > 0)
-                stack += std::to_string(ar.linedefined);
-        }
+        appendStack(L, stack);
 
         if (!stack.empty())
         {
@@ -112,6 +124,56 @@ void profilerStop()
     gProfiler.thread.join();
 }
 
+static void allocProfilerSample(lua_State* L, int category, size_t size)
+{
+    std::string& stack = gProfiler.stackScratch;
+
+    stack.clear();
+    appendStack(L, stack);
+
+    // allocations made outside of Luau functions (e.g. while loading the chunk) are still accounted for
+    if (stack.empty())
+        stack += "[C],[native],";
+
+    gProfiler.allocData[stack] += size;
+    gProfiler.allocSamples++;
+}
+
+void allocProfilerStart(lua_State* L, int rate)
+{
+    lua_callbacks(L)->allocsample = allocProfilerSample;
+    lua_setallocsamplerate(L, rate);
+}
+
+void allocProfilerStop(lua_State* L)
+{
+    lua_setallocsamplerate(L, 0);
+    lua_callbacks(L)->allocsample = nullptr;
+}
+
+void allocProfilerDump(const char* path)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "Error opening allocation profile %s\n", path);
+        return;
+    }
+
+    uint64_t total = 0;
+
+    for (auto& p : gProfiler.allocData)
+    {
+        fprintf(f, "%lld %s\n", static_cast<long long>(p.second), p.first.c_str());
+        total += p.second;
+    }
+
+    fclose(f);
+
+    printf("Allocation profile written to %s (total %.3f MB allocated, %lld samples, %lld stacks)\n", path, double(total) / (1024 * 1024),
+        static_cast<long long>(gProfiler.allocSamples), static_cast<long long>(gProfiler.allocData.size()));
+}
+
 void profilerDump(const char* path)
 {
     FILE* f = fopen(path, "wb");
@@ -155,3 +217,81 @@ void profilerDump(const char* path)
         printf("\n");
     }
 }
+
+void opcodeProfilerStart(lua_State* L)
+{
+    lua_setopcodestats(L, true);
+}
+
+struct OpcodeProfileEntry
+{
+    uint64_t count;
+    uint64_t extra; // slow path hits for opcodes, fallbacks for fastcalls
+    int a;
+    int b;
+};
+
+static void dumpOpcodeProfileSection(FILE* f, const char* header, std::vector<OpcodeProfileEntry>& entries, bool builtins)
+{
+    std::sort(entries.begin(), entries.end(),
+        [](const OpcodeProfileEntry& l, const OpcodeProfileEntry& r) {
+            return l.count > r.count;
+        });
+
+    fprintf(f, "# %s\n", header);
+
+    for (const OpcodeProfileEntry& e : entries)
+    {
+        if (e.b >= 0)
+            fprintf(f, "%lld %s %s\n", static_cast<long long>(e.count), Luau::getOpName(LuauOpcode(e.a)), Luau::getOpName(LuauOpcode(e.b)));
+        else if (builtins)
+            fprintf(f, "%lld %lld %d\n", static_cast<long long>(e.count), static_cast<long long>(e.extra), e.a);
+        else
+            fprintf(f, "%lld %lld %s\n", static_cast<long long>(e.count), static_cast<long long>(e.extra), Luau::getOpName(LuauOpcode(e.a)));
+    }
+}
+
+void opcodeProfilerStop(lua_State* L, const char* path)
+{
+    std::vector<OpcodeProfileEntry> opcodes;
+    std::vector<OpcodeProfileEntry> pairs;
+    std::vector<OpcodeProfileEntry> fastcalls;
+
+    uint64_t total = 0;
+
+    for (int op = 0; op < LOP__COUNT; ++op)
+    {
+        if (uint64_t count = lua_getopcodestat(L, LUA_OPSTAT_EXEC, op, 0))
+        {
+            opcodes.push_back({count, lua_getopcodestat(L, LUA_OPSTAT_SLOWPATH, op, 0), op, -1});
+            total += count;
+        }
+
+        for (int next = 0; next < LOP__COUNT; ++next)
+            if (uint64_t count = lua_getopcodestat(L, LUA_OPSTAT_PAIR, op, next))
+                pairs.push_back({count, 0, op, next});
+    }
+
+    for (int bfid = 0; bfid < 256; ++bfid)
+        if (uint64_t count = lua_getopcodestat(L, LUA_OPSTAT_FASTCALL, bfid, 0))
+            fastcalls.push_back({count, lua_getopcodestat(L, LUA_OPSTAT_FASTCALLFALLBACK, bfid, 0), bfid, -1});
+
+    lua_setopcodestats(L, false);
+
+    FILE* f = fopen(path, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "Error opening opcode profile %s\n", path);
+        return;
+    }
+
+    // opcodes list execution and slow path counts, fastcalls list call and fallback counts per builtin id
+    dumpOpcodeProfileSection(f, "opcodes", opcodes, false);
+    dumpOpcodeProfileSection(f, "pairs", pairs, false);
+    dumpOpcodeProfileSection(f, "fastcalls", fastcalls, true);
+
+    fclose(f);
+
+    printf("Opcode profile written to %s (%lld instructions, %lld opcodes, %lld pairs)\n", path, static_cast<long long>(total),
+        static_cast<long long>(opcodes.size()), static_cast<long long>(pairs.size()));
+}
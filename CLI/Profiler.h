@@ -6,3 +6,10 @@ struct lua_State;
 void profilerStart(lua_State* L, int frequency);
 void profilerStop();
 void profilerDump(const char* path);
+
+void allocProfilerStart(lua_State* L, int rate);
+void allocProfilerStop(lua_State* L);
+void allocProfilerDump(const char* path);
+
+void opcodeProfilerStart(lua_State* L);
+void opcodeProfilerStop(lua_State* L, const char* path);
@@ -5,6 +5,7 @@
 #include "lua.h"
 #include "lualib.h"
 
+#include "Luau/Bytecode.h"
 #include "Luau/CodeGen.h"
 #include "Luau/Compiler.h"
 #include "Luau/Parser.h"
@@ -13,12 +14,14 @@
 #include "Coverage.h"
 #include "FileUtils.h"
 #include "Flags.h"
+#include "JitDump.h"
 #include "Profiler.h"
 #include "Require.h"
 
 #include "isocline.h"
 
 #include <memory>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <io.h>
@@ -28,7 +31,11 @@
 #include <windows.h>
 #endif
 
-#ifdef __linux__
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <unistd.h>
 #endif
 
@@ -94,6 +101,145 @@ static Luau::CompileOptions copts()
     return result;
 }
 
+// Directory of the on-disk bytecode cache shared by scripts and modules; empty when the cache is disabled
+static std::string bytecodeCacheDir;
+
+// Hash of everything besides the source and the options that affects compiler output
+static uint64_t bytecodeCacheSeed = 0;
+
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    // FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+
+    return hash;
+}
+
+static void enableBytecodeCache(const std::string& directory)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    int versions[] = {LBC_VERSION_TARGET, LBC_TYPE_VERSION_TARGET};
+    hash = hashBytes(hash, versions, sizeof(versions));
+
+    // the executable's modification time identifies the build, so that a rebuilt compiler doesn't reuse bytecode of an older one
+    std::optional<std::string> executable = getExecutablePath();
+    int64_t buildId = executable ? getFileModificationTime(*executable).value_or(0) : 0;
+    hash = hashBytes(hash, &buildId, sizeof(buildId));
+
+    // flags can change the compiler output, so every combination gets separate entries
+    for (Luau::FValue<bool>* flag = Luau::FValue<bool>::list; flag; flag = flag->next)
+    {
+        hash = hashBytes(hash, flag->name, strlen(flag->name));
+        hash = hashBytes(hash, &flag->value, sizeof(flag->value));
+    }
+
+    bytecodeCacheDir = directory;
+    bytecodeCacheSeed = hash;
+}
+
+static std::string compileCached(const std::string& source)
+{
+    Luau::CompileOptions options = copts();
+
+    if (bytecodeCacheDir.empty())
+        return Luau::compile(source, options);
+
+    int levels[] = {options.optimizationLevel, options.debugLevel, options.typeInfoLevel, options.coverageLevel};
+
+    uint64_t hash = hashBytes(bytecodeCacheSeed, levels, sizeof(levels));
+    hash = hashBytes(hash, source.data(), source.size());
+
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-%llx.luauc", (unsigned long long)hash, (unsigned long long)source.size());
+
+    std::string path = joinPaths(bytecodeCacheDir, name);
+
+    if (std::optional<std::string> bytecode = readFile(path); bytecode && !bytecode->empty())
+        return *bytecode;
+
+    std::string bytecode = Luau::compile(source, options);
+
+    // compilation errors are encoded in the bytecode with a leading zero; those are not cached and get reported again on every run
+    if (!bytecode.empty() && bytecode[0] != 0)
+        writeFile(path, bytecode);
+
+    return bytecode;
+}
+
+// In server mode, chunks loaded by earlier requests stay in the VM and later requests get new closures of them, reusing bytecode and native code
+static bool reuseLoadedChunks = false;
+
+struct LoadedChunk
+{
+    std::string source;
+    int ref = LUA_NOREF;
+};
+
+// Functions loaded on the main thread, keyed by chunk name; when the source of a chunk changes, the old function is released
+static std::unordered_map<std::string, LoadedChunk> loadedChunks;
+
+// Pushes the function of the chunk onto the stack of L, compiling it to native code when enabled; like luau_load, pushes an error message instead
+// and returns a non-zero value on failure
+static int loadChunk(lua_State* L, const std::string& chunkname, const std::string& source)
+{
+    if (!reuseLoadedChunks)
+    {
+        std::string bytecode = compileCached(source);
+
+        if (int status = luau_load(L, chunkname.c_str(), bytecode.data(), bytecode.size(), 0))
+            return status;
+
+        if (codegen)
+        {
+            Luau::CodeGen::CompilationOptions nativeOptions;
+            Luau::CodeGen::compile(L, -1, nativeOptions);
+        }
+
+        return 0;
+    }
+
+    lua_State* GL = lua_mainthread(L);
+    auto it = loadedChunks.find(chunkname);
+
+    if (it != loadedChunks.end() && it->second.source != source)
+    {
+        lua_unref(GL, it->second.ref);
+        loadedChunks.erase(it);
+        it = loadedChunks.end();
+    }
+
+    if (it == loadedChunks.end())
+    {
+        // the function is loaded on the main thread so that it doesn't keep the environment of the first requester alive
+        std::string bytecode = compileCached(source);
+
+        if (int status = luau_load(GL, chunkname.c_str(), bytecode.data(), bytecode.size(), 0))
+        {
+            lua_xmove(GL, L, 1);
+            return status;
+        }
+
+        if (codegen)
+        {
+            Luau::CodeGen::CompilationOptions nativeOptions;
+            Luau::CodeGen::compile(GL, -1, nativeOptions);
+        }
+
+        it = loadedChunks.insert({chunkname, {source, lua_ref(GL, -1)}}).first;
+        lua_pop(GL, 1);
+    }
+
+    // the new closure gets the environment of L
+    lua_getref(L, it->second.ref);
+    lua_clonefunction(L, -1);
+    lua_remove(L, -2);
+    return 0;
+}
+
 static int lua_loadstring(lua_State* L)
 {
     size_t l = 0;
@@ -140,15 +286,8 @@ static int lua_require(lua_State* L)
     luaL_sandboxthread(ML);
 
     // now we can compile & run module on the new thread
-    std::string bytecode = Luau::compile(resolvedRequire.sourceCode, copts());
-    if (luau_load(ML, resolvedRequire.chunkName.c_str(), bytecode.data(), bytecode.size(), 0) == 0)
+    if (loadChunk(ML, resolvedRequire.chunkName, resolvedRequire.sourceCode) == 0)
     {
-        if (codegen)
-        {
-            Luau::CodeGen::CompilationOptions nativeOptions;
-            Luau::CodeGen::compile(ML, -1, nativeOptions);
-        }
-
         if (coverageActive())
             coverageTrack(ML, -1);
 
@@ -605,17 +744,10 @@ static bool runFile(const char* name, lua_State* GL, bool repl)
 
     std::string chunkname = "=" + std::string(name);
 
-    std::string bytecode = Luau::compile(*source, copts());
     int status = 0;
 
-    if (luau_load(L, chunkname.c_str(), bytecode.data(), bytecode.size(), 0) == 0)
+    if (loadChunk(L, chunkname, *source) == 0)
     {
-        if (codegen)
-        {
-            Luau::CodeGen::CompilationOptions nativeOptions;
-            Luau::CodeGen::compile(L, -1, nativeOptions);
-        }
-
         if (coverageActive())
             coverageTrack(L, -1);
 
@@ -654,6 +786,323 @@ static bool runFile(const char* name, lua_State* GL, bool repl)
     return status == 0;
 }
 
+#ifndef _WIN32
+// Server mode keeps a VM with libraries loaded and native code generation initialized, and runs the scripts of each request in new sandboxed
+// threads; 'luau --connect=<path>' sends its file list, program arguments, working directory and standard streams as a request
+// A request is a 4-byte payload size sent together with the client's stdin, stdout, stderr and working directory descriptors, followed by the
+// payload with null-terminated arguments; the reply is a single byte with the exit code
+constexpr int kServerRequestFds = 4;
+constexpr uint32_t kServerMaxRequestSize = 1 << 20;
+
+static bool readAll(int fd, void* data, size_t size)
+{
+    char* ptr = static_cast<char*>(data);
+
+    while (size)
+    {
+        ssize_t result = read(fd, ptr, size);
+        if (result <= 0)
+            return false;
+
+        ptr += result;
+        size -= result;
+    }
+
+    return true;
+}
+
+static bool writeAll(int fd, const void* data, size_t size)
+{
+    const char* ptr = static_cast<const char*>(data);
+
+    while (size)
+    {
+        ssize_t result = write(fd, ptr, size);
+        if (result <= 0)
+            return false;
+
+        ptr += result;
+        size -= result;
+    }
+
+    return true;
+}
+
+static bool receiveRequest(int connection, int (&fds)[kServerRequestFds], std::vector<std::string>& args)
+{
+    uint32_t size = 0;
+
+    iovec iov = {&size, sizeof(size)};
+    char control[CMSG_SPACE(sizeof(fds))] = {};
+
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received = recvmsg(connection, &msg, 0);
+
+    // every descriptor that arrived is owned by the caller through fds or closed here, even if the request is rejected
+    int count = 0;
+    bool valid = received == sizeof(size) && (msg.msg_flags & MSG_CTRUNC) == 0;
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+        {
+            valid = false;
+            continue;
+        }
+
+        size_t length = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+
+        for (size_t i = 0; i < length; i++)
+        {
+            int fd = -1;
+            memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+
+            if (count < kServerRequestFds)
+                fds[count] = fd;
+            else
+                close(fd);
+
+            count++;
+        }
+    }
+
+    if (!valid || count != kServerRequestFds || size > kServerMaxRequestSize)
+        return false;
+
+    std::string payload(size, '\0');
+    if (!readAll(connection, payload.data(), size))
+        return false;
+
+    for (size_t pos = 0; pos < payload.size();)
+    {
+        size_t end = payload.find('\0', pos);
+        if (end == std::string::npos)
+            return false;
+
+        args.push_back(payload.substr(pos, end - pos));
+        pos = end + 1;
+    }
+
+    return true;
+}
+
+static bool runRequest(lua_State* GL, const int (&fds)[kServerRequestFds], const std::vector<std::string>& args)
+{
+    std::vector<char*> argv = {nullptr};
+
+    for (const std::string& arg : args)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+
+    // arguments are parsed the same way as on the command line of the client
+    int argc = int(argv.size());
+    int programArgs = argc;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--program-args") == 0 || strcmp(argv[i], "-a") == 0)
+        {
+            programArgs = i + 1;
+            break;
+        }
+    }
+
+    program_argc = argc - programArgs;
+    program_argv = argv.data() + programArgs;
+
+    fflush(stdout);
+    fflush(stderr);
+
+    int savedFds[3] = {dup(0), dup(1), dup(2)};
+    int savedCwd = open(".", O_RDONLY);
+
+    for (int i = 0; i < 3; i++)
+        dup2(fds[i], i);
+
+    int failed = 0;
+
+    if (fchdir(fds[3]) == 0)
+    {
+        // module paths are resolved relative to the working directory of the client and files can change between requests
+        RequireResolver::clearCaches();
+
+        for (const std::string& file : getSourceFiles(argc, argv.data()))
+            failed += !runFile(file.c_str(), GL, false);
+    }
+    else
+    {
+        fprintf(stderr, "Error changing to the working directory of the client\n");
+        failed = 1;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+
+    for (int i = 0; i < 3; i++)
+    {
+        dup2(savedFds[i], i);
+        close(savedFds[i]);
+    }
+
+    if (savedCwd >= 0)
+    {
+        if (fchdir(savedCwd) != 0)
+            fprintf(stderr, "Error restoring the working directory\n");
+
+        close(savedCwd);
+    }
+
+    // every request gets new instances of the modules it requires; their loaded chunks are kept
+    lua_pushnil(GL);
+    lua_setfield(GL, LUA_REGISTRYINDEX, "_MODULES");
+
+    program_argc = 0;
+    program_argv = nullptr;
+
+    return failed == 0;
+}
+
+static int runServer(const char* path)
+{
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Error: Socket path '%s' is too long\n", path);
+        return 1;
+    }
+
+    strcpy(addr.sun_path, path);
+
+    // a socket left behind by an earlier server is replaced, but other files are not
+    struct stat st = {};
+    if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener, 16) != 0)
+    {
+        fprintf(stderr, "Error: Failed to listen on '%s'\n", path);
+        return 1;
+    }
+
+    // clients that disconnect early must not stop the server
+    signal(SIGPIPE, SIG_IGN);
+
+    std::unique_ptr<lua_State, void (*)(lua_State*)> globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    setupState(L);
+
+    reuseLoadedChunks = true;
+
+    for (;;)
+    {
+        int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0)
+            continue;
+
+        int fds[kServerRequestFds] = {-1, -1, -1, -1};
+        std::vector<std::string> args;
+
+        if (receiveRequest(connection, fds, args))
+        {
+            char result = runRequest(L, fds, args) ? 0 : 1;
+            writeAll(connection, &result, 1);
+        }
+
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+
+        close(connection);
+    }
+}
+
+static int runClient(const char* path, int argc, char** argv)
+{
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Error: Socket path '%s' is too long\n", path);
+        return 1;
+    }
+
+    strcpy(addr.sun_path, path);
+
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (connection < 0 || connect(connection, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "Error: Failed to connect to '%s'\n", path);
+        return 1;
+    }
+
+    // options are set by the server, only the file list and program arguments are sent
+    std::string payload;
+    bool programArgs = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--program-args") == 0 || strcmp(argv[i], "-a") == 0)
+            programArgs = true;
+        else if (!programArgs && argv[i][0] == '-' && argv[i][1] != '\0')
+            continue;
+
+        payload += argv[i];
+        payload += '\0';
+    }
+
+    if (payload.size() > kServerMaxRequestSize)
+    {
+        fprintf(stderr, "Error: Request to '%s' is too large\n", path);
+        close(connection);
+        return 1;
+    }
+
+    int fds[kServerRequestFds] = {0, 1, 2, open(".", O_RDONLY)};
+    uint32_t size = uint32_t(payload.size());
+
+    iovec iov = {&size, sizeof(size)};
+    char control[CMSG_SPACE(sizeof(fds))] = {};
+
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    char result = 1;
+
+    if (fds[3] < 0 || sendmsg(connection, &msg, 0) != sizeof(size) || !writeAll(connection, payload.data(), payload.size()) ||
+        !readAll(connection, &result, 1))
+    {
+        fprintf(stderr, "Error: Request to '%s' failed\n", path);
+        result = 1;
+    }
+
+    if (fds[3] >= 0)
+        close(fds[3]);
+
+    close(connection);
+    return result;
+}
+#endif
+
 static void displayHelp(const char* argv0)
 {
     printf("Usage: %s [options] [file list] [-a] [arg list]\n", argv0);
@@ -664,11 +1113,17 @@ static void displayHelp(const char* argv0)
     printf("  --coverage: collect code coverage while running the code and output results to coverage.out\n");
     printf("  -h, --help: Display this usage message.\n");
     printf("  -i, --interactive: Run an interactive REPL after executing the last script specified.\n");
-    printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 2).\n");
+    printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 3).\n");
     printf("  -g<n>: compile with debug level n (default 1, n should be between 0 and 2).\n");
     printf("  --profile[=N]: profile the code using N Hz sampling (default 10000) and output results to profile.out\n");
+    printf("  --profile-alloc[=N]: sample allocations every N bytes (default 16384) and output results to profile-alloc.out\n");
+    printf("  --profile-opcodes: count executed opcodes, opcode pairs and fastcalls in the interpreter and output results to profile-opcodes.out\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
     printf("  --codegen: execute code using native code generation\n");
+    printf("  --codegen-jitdump: execute code using native code generation and write native code with line info to /tmp/jit-<pid>.dump\n");
+    printf("  --cache-dir=<path>: reuse bytecode of scripts and required modules compiled by earlier runs, stored in the existing directory <path>\n");
+    printf("  --server=<path>: keep running and execute scripts sent by --connect clients on a Unix socket at <path>, reusing loaded code\n");
+    printf("  --connect=<path>: execute the file list with arguments on a server started with --server=<path>\n");
     printf("  --program-args,-a: declare start of arguments to be passed to the Luau program\n");
 }
 
@@ -689,9 +1144,15 @@ int replMain(int argc, char** argv)
 #endif
 
     int profile = 0;
+    int profileAlloc = 0;
+    bool profileOpcodes = false;
     bool coverage = false;
     bool interactive = false;
     bool codegenPerf = false;
+    bool codegenJitDump = false;
+    const char* cacheDir = nullptr;
+    const char* serverPath = nullptr;
+    const char* connectPath = nullptr;
     int program_args = argc;
 
     for (int i = 1; i < argc; i++)
@@ -708,9 +1169,9 @@ int replMain(int argc, char** argv)
         else if (strncmp(argv[i], "-O", 2) == 0)
         {
             int level = atoi(argv[i] + 2);
-            if (level < 0 || level > 2)
+            if (level < 0 || level > 3)
             {
-                fprintf(stderr, "Error: Optimization level must be between 0 and 2 inclusive.\n");
+                fprintf(stderr, "Error: Optimization level must be between 0 and 3 inclusive.\n");
                 return 1;
             }
             globalOptions.optimizationLevel = level;
@@ -733,6 +1194,18 @@ int replMain(int argc, char** argv)
         {
             profile = atoi(argv[i] + 10);
         }
+        else if (strcmp(argv[i], "--profile-alloc") == 0)
+        {
+            profileAlloc = 16384;
+        }
+        else if (strncmp(argv[i], "--profile-alloc=", 16) == 0)
+        {
+            profileAlloc = atoi(argv[i] + 16);
+        }
+        else if (strcmp(argv[i], "--profile-opcodes") == 0)
+        {
+            profileOpcodes = true;
+        }
         else if (strcmp(argv[i], "--codegen") == 0)
         {
             codegen = true;
@@ -742,6 +1215,11 @@ int replMain(int argc, char** argv)
             codegen = true;
             codegenPerf = true;
         }
+        else if (strcmp(argv[i], "--codegen-jitdump") == 0)
+        {
+            codegen = true;
+            codegenJitDump = true;
+        }
         else if (strcmp(argv[i], "--coverage") == 0)
         {
             coverage = true;
@@ -754,6 +1232,18 @@ int replMain(int argc, char** argv)
         {
             setLuauFlags(argv[i] + 9);
         }
+        else if (strncmp(argv[i], "--cache-dir=", 12) == 0)
+        {
+            cacheDir = argv[i] + 12;
+        }
+        else if (strncmp(argv[i], "--server=", 9) == 0)
+        {
+            serverPath = argv[i] + 9;
+        }
+        else if (strncmp(argv[i], "--connect=", 10) == 0)
+        {
+            connectPath = argv[i] + 10;
+        }
         else if (strcmp(argv[i], "--program-args") == 0 || strcmp(argv[i], "-a") == 0)
         {
             program_args = i + 1;
@@ -770,6 +1260,17 @@ int replMain(int argc, char** argv)
     program_argc = argc - program_args;
     program_argv = &argv[program_args];
 
+    // the client only forwards its arguments, so it skips the rest of the setup
+    if (connectPath)
+    {
+#ifndef _WIN32
+        return runClient(connectPath, argc, argv);
+#else
+        fprintf(stderr, "--connect option is not supported on Windows\n");
+        return 1;
+#endif
+    }
+
 
 #if !defined(LUAU_ENABLE_TIME_TRACE)
     if (FFlag::DebugLuauTimeTracing)
@@ -797,9 +1298,45 @@ int replMain(int argc, char** argv)
 #endif
     }
 
+    if (codegenJitDump)
+    {
+#if __linux__
+        if (!jitDumpStart())
+        {
+            fprintf(stderr, "Error creating jitdump file\n");
+            return 1;
+        }
+#else
+        fprintf(stderr, "--codegen-jitdump option is only supported on Linux\n");
+        return 1;
+#endif
+    }
+
+    if (cacheDir)
+    {
+        if (!isDirectory(cacheDir))
+        {
+            fprintf(stderr, "Error: Cache directory '%s' does not exist.\n", cacheDir);
+            return 1;
+        }
+
+        // flags are final at this point
+        enableBytecodeCache(cacheDir);
+    }
+
     if (codegen && !Luau::CodeGen::isSupported())
         fprintf(stderr, "Warning: Native code generation is not supported in current configuration\n");
 
+    if (serverPath)
+    {
+#ifndef _WIN32
+        return runServer(serverPath);
+#else
+        fprintf(stderr, "--server option is not supported on Windows\n");
+        return 1;
+#endif
+    }
+
     const std::vector<std::string> files = getSourceFiles(argc, argv);
 
     if (files.empty())
@@ -817,6 +1354,12 @@ int replMain(int argc, char** argv)
         if (profile)
             profilerStart(L, profile);
 
+        if (profileAlloc)
+            allocProfilerStart(L, profileAlloc);
+
+        if (profileOpcodes)
+            opcodeProfilerStart(L);
+
         if (coverage)
             coverageInit(L);
 
@@ -834,6 +1377,15 @@ int replMain(int argc, char** argv)
             profilerDump("profile.out");
         }
 
+        if (profileAlloc)
+        {
+            allocProfilerStop(L);
+            allocProfilerDump("profile-alloc.out");
+        }
+
+        if (profileOpcodes)
+            opcodeProfilerStop(L, "profile-opcodes.out");
+
         if (coverage)
             coverageDump("coverage.out");
 
@@ -6,8 +6,35 @@
 
 #include <algorithm>
 #include <array>
+#include <unordered_map>
 #include <utility>
 
+struct ResolvedPath
+{
+    std::string chunkname;
+    std::string absolutePath;
+};
+
+// Resolution only depends on the requiring chunk and the path, so it's done once per process; keyed by both
+static std::unordered_map<std::string, ResolvedPath>& getResolvedPaths()
+{
+    static std::unordered_map<std::string, ResolvedPath> resolvedPaths;
+    return resolvedPaths;
+}
+
+// Contents of the configuration files read by this process, keyed by path; files that don't exist are remembered as well
+static std::unordered_map<std::string, std::optional<std::string>>& getConfigContents()
+{
+    static std::unordered_map<std::string, std::optional<std::string>> configContents;
+    return configContents;
+}
+
+void RequireResolver::clearCaches()
+{
+    getResolvedPaths().clear();
+    getConfigContents().clear();
+}
+
 RequireResolver::RequireResolver(lua_State* L, std::string path)
     : pathToResolve(std::move(path))
     , L(L)
@@ -23,14 +50,31 @@ RequireResolver::RequireResolver(lua_State* L, std::string path)
         luaL_argerrorL(L, 1, "cannot require an absolute path");
 
     std::replace(pathToResolve.begin(), pathToResolve.end(), '\\', '/');
-
-    substituteAliasIfPresent(pathToResolve);
 }
 
 [[nodiscard]] RequireResolver::ResolvedRequire RequireResolver::resolveRequire(lua_State* L, std::string path)
 {
     RequireResolver resolver(L, std::move(path));
-    ModuleStatus status = resolver.findModule();
+
+    std::string resolvedPathKey = std::string(resolver.sourceChunkname) + '\n' + resolver.pathToResolve;
+    std::unordered_map<std::string, ResolvedPath>& resolvedPaths = getResolvedPaths();
+
+    ModuleStatus status = ModuleStatus::NotFound;
+
+    if (auto it = resolvedPaths.find(resolvedPathKey); it != resolvedPaths.end())
+        status = resolver.findResolvedModule(it->second.chunkname, it->second.absolutePath);
+
+    // the module could have been removed since it was resolved, in which case the search starts over
+    if (status == ModuleStatus::NotFound)
+    {
+        resolver.substituteAliasIfPresent(resolver.pathToResolve);
+
+        status = resolver.findModule();
+
+        if (status != ModuleStatus::NotFound)
+            resolvedPaths[resolvedPathKey] = ResolvedPath{resolver.chunkname, resolver.absolutePath};
+    }
+
     if (status != ModuleStatus::FileRead)
         return ResolvedRequire{status};
     else
@@ -80,6 +124,29 @@ RequireResolver::ModuleStatus RequireResolver::findModule()
     return RequireResolver::ModuleStatus::NotFound;
 }
 
+RequireResolver::ModuleStatus RequireResolver::findResolvedModule(const std::string& resolvedChunkname, const std::string& resolvedAbsolutePath)
+{
+    // Put _MODULES table on stack for checking and saving to the cache
+    luaL_findtable(L, LUA_REGISTRYINDEX, "_MODULES", 1);
+
+    chunkname = resolvedChunkname;
+    absolutePath = resolvedAbsolutePath;
+
+    lua_getfield(L, -1, absolutePath.c_str());
+    if (!lua_isnil(L, -1))
+        return ModuleStatus::Cached;
+    lua_pop(L, 1);
+
+    if (std::optional<std::string> source = readFile(absolutePath))
+    {
+        sourceCode = std::move(*source);
+        return ModuleStatus::FileRead;
+    }
+
+    lua_pop(L, 1); // _MODULES is pushed again by the full search
+    return ModuleStatus::NotFound;
+}
+
 RequireResolver::ModuleStatus RequireResolver::findModuleImpl()
 {
     static const std::array<const char*, 4> possibleSuffixes = {".luau", ".lua", "/init.luau", "/init.lua"};
@@ -94,6 +161,7 @@ RequireResolver::ModuleStatus RequireResolver::findModuleImpl()
         lua_getfield(L, -1, absolutePath.c_str());
         if (!lua_isnil(L, -1))
         {
+            chunkname = "=" + chunkname + possibleSuffix;
             return ModuleStatus::Cached;
         }
         lua_pop(L, 1);
@@ -268,7 +336,11 @@ void RequireResolver::parseConfigInDirectory(const std::string& directory)
 
     size_t numPaths = config.paths.size();
 
-    if (std::optional<std::string> contents = readFile(configPath))
+    auto [it, inserted] = getConfigContents().try_emplace(configPath);
+    if (inserted)
+        it->second = readFile(configPath);
+
+    if (const std::optional<std::string>& contents = it->second)
     {
         std::optional<std::string> error = Luau::parseConfig(*contents, config);
         if (error)
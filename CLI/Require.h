@@ -33,6 +33,9 @@ public:
 
     [[nodiscard]] ResolvedRequire static resolveRequire(lua_State* L, std::string path);
 
+    // Forgets module paths and configuration files remembered by earlier requires, which depend on the working directory and files on disk
+    static void clearCaches();
+
 private:
     std::string pathToResolve;
     std::string_view sourceChunkname;
@@ -40,6 +43,7 @@ private:
     RequireResolver(lua_State* L, std::string path);
 
     ModuleStatus findModule();
+    ModuleStatus findResolvedModule(const std::string& resolvedChunkname, const std::string& resolvedAbsolutePath);
     lua_State* L;
     Luau::Config config;
     std::string lastSearchedDir;
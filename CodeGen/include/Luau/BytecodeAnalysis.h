@@ -18,6 +18,7 @@ struct HostIrHooks;
 void loadBytecodeTypeInfo(IrFunction& function);
 void buildBytecodeBlocks(IrFunction& function, const std::vector<uint8_t>& jumpTargets);
 void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks);
+void computeBytecodeLiveness(IrFunction& function);
 
 } // namespace CodeGen
 } // namespace Luau
@@ -79,5 +79,27 @@ private:
 
 std::vector<FunctionBytecodeSummary> summarizeBytecode(lua_State* L, int idx, unsigned nestingLimit);
 
+struct FunctionCodeGenEstimate
+{
+    unsigned instructionCount = 0;
+
+    // Instructions that are lowered to native fast paths for common types
+    unsigned fastInstructionCount = 0;
+
+    // Instructions that mostly call into VM helpers and run at about the same speed as in the interpreter
+    unsigned helperInstructionCount = 0;
+
+    // Rough size of generated native code in bytes
+    unsigned nativeCodeSizeBytes = 0;
+
+    bool hasLoops = false;
+
+    // Native code for functions with loops or with enough fast instructions compared to helper instructions is expected to be profitable
+    bool profitable = false;
+};
+
+// Estimates the benefit of native compilation from the instruction counts at nesting level 0
+FunctionCodeGenEstimate estimateCodeGenBenefit(const FunctionBytecodeSummary& summary);
+
 } // namespace CodeGen
 } // namespace Luau
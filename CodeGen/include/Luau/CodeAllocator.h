@@ -15,6 +15,21 @@ namespace CodeGen
 
 constexpr uint32_t kCodeAlignment = 32;
 
+struct CodeAllocationStats
+{
+    // Executable memory reserved in blocks
+    size_t blockCount = 0;
+    size_t blockSize = 0;
+
+    // Memory used by live allocations, including the padding to page boundaries
+    size_t allocatedSize = 0;
+
+    // Memory released by earlier allocations that can be reused by new allocations
+    size_t freeRangeCount = 0;
+    size_t freeRangeSize = 0;
+    size_t largestFreeRange = 0;
+};
+
 struct CodeAllocator
 {
     CodeAllocator(size_t blockSize, size_t maxTotalSize);
@@ -27,6 +42,12 @@ struct CodeAllocator
     bool allocate(
         const uint8_t* data, size_t dataSize, const uint8_t* code, size_t codeSize, uint8_t*& result, size_t& resultSize, uint8_t*& resultCodeStart);
 
+    // Releases memory of an allocation returned by 'allocate'; code in it must not be running and must not be entered again
+    // Released pages are reused by future allocations, and blocks that no longer hold any allocations are returned to the system
+    void deallocate(uint8_t* result, size_t resultSize);
+
+    CodeAllocationStats getStats() const;
+
     // Provided to unwind info callbacks
     void* context = nullptr;
 
@@ -42,7 +63,27 @@ private:
     // But to simplify block space checks, we limit the max size of all that data
     static const size_t kMaxReservedDataSize = 256;
 
+    struct Block
+    {
+        uint8_t* start = nullptr;
+        void* unwindInfo = nullptr;
+
+        // Number of live allocations placed in the block
+        size_t allocationCount = 0;
+    };
+
+    // Range of released memory inside a single block; 'start' is aligned to kCodeAlignment and 'end' to a page or to the block end
+    struct FreeRange
+    {
+        uint8_t* start = nullptr;
+        uint8_t* end = nullptr;
+    };
+
     bool allocateNewBlock(size_t& unwindInfoSize);
+    bool allocateFromFreeRange(size_t size, uint8_t*& result);
+
+    Block* findBlock(uint8_t* pos);
+    void releaseBlock(Block& block);
 
     uint8_t* allocatePages(size_t size) const;
     void freePages(uint8_t* mem, size_t size) const;
@@ -52,8 +93,12 @@ private:
     uint8_t* blockEnd = nullptr;
 
     // All allocated blocks
-    std::vector<uint8_t*> blocks;
-    std::vector<void*> unwindInfos;
+    std::vector<Block> blocks;
+
+    // Released memory available for reuse, sorted by address
+    std::vector<FreeRange> freeRanges;
+
+    size_t allocatedSize = 0;
 
     size_t blockSize = 0;
     size_t maxTotalSize = 0;
@@ -29,6 +29,10 @@ enum CodeGenFlags
     CodeGen_OnlyNativeModules = 1 << 0,
     // Run native codegen for functions that the compiler considers not profitable
     CodeGen_ColdFunctions = 1 << 1,
+    // Skip functions that are estimated to get little benefit from native compilation, see estimateCodeGenBenefit
+    CodeGen_SkipLowBenefit = 1 << 2,
+    // Native code only records that coverage points were reached (by setting the lowest bit of the hit count) instead of counting hits
+    CodeGen_CoverageHitOnly = 1 << 3,
 };
 
 // These enum values can be reported through telemetry.
@@ -46,8 +50,9 @@ enum class CodeGenCompilationResult
     CodeGenAssemblerFinalizationFailure = 7,  // Failure during assembler finalization
     CodeGenLoweringFailure = 8,               // Lowering failed
     AllocationFailed = 9,                     // Native codegen failed due to an allocation error
+    CodeGenLowBenefit = 10,                   // Function was skipped because native code is not expected to be profitable
 
-    Count = 10,
+    Count = 11,
 };
 
 std::string toString(const CodeGenCompilationResult& result);
@@ -105,6 +110,7 @@ using HostUserdataMetamethodHandler = bool (*)(
     IrBuilder& builder, uint8_t lhsTy, uint8_t rhsTy, int resultReg, IrOp lhs, IrOp rhs, HostMetamethod method, int pcpos);
 using HostUserdataNamecallHandler = bool (*)(
     IrBuilder& builder, uint8_t type, const char* member, size_t memberLength, int argResReg, int sourceReg, int params, int results, int pcpos);
+using HostBuiltinHandler = bool (*)(IrBuilder& builder, int id, int resultReg, int argReg, IrOp arg2, IrOp arg3, int params, int results, int pcpos);
 
 struct HostIrHooks
 {
@@ -152,6 +158,12 @@ struct HostIrHooks
     // All other arguments can be of any type
     // Guards should take a VM exit to 'pcpos'
     HostUserdataNamecallHandler userdataNamecall = nullptr;
+
+    // Handle a call of a host builtin with the index 'id' in CompileOptions::hostBuiltins (see lua_sethostbuiltin)
+    // First argument is in 'argReg'; 'arg2' and 'arg3' are registers or constants of the next arguments when 'params' is large enough
+    // All arguments can be of any type, and 'results' values have to be written starting at 'resultReg' ('results' is never LUA_MULTRET)
+    // Guards should take a VM exit to 'pcpos', which performs a regular call
+    HostBuiltinHandler hostBuiltin = nullptr;
 };
 
 struct CompilationOptions
@@ -161,6 +173,17 @@ struct CompilationOptions
 
     // null-terminated array of userdata types names that might have custom lowering
     const char* const* userdataTypes = nullptr;
+
+    // optional executor that runs 'job' for every index in [0, count) and returns when all jobs have completed; jobs may run concurrently
+    // when set, IR for the functions of the module is built and optimized in parallel, while lowering and code placement remain sequential
+    // note: IR building uses only the function prototypes, but host IR hooks will be invoked from the threads running the jobs
+    void (*parallel)(void* context, int count, void (*job)(void* jobContext, int index), void* jobContext) = nullptr;
+    void* parallelContext = nullptr;
+
+    // optional host profile used to lay out native code; functions are identified by debug name and line like in ProtoCompilationFailure
+    // functions with higher weight are placed first and next to each other, and get the module instruction budget before the rest
+    uint32_t (*functionWeight)(void* context, const char* debugname, int line) = nullptr;
+    void* functionWeightContext = nullptr;
 };
 
 struct CompilationStats
@@ -170,9 +193,16 @@ struct CompilationStats
     size_t nativeDataSizeBytes = 0;
     size_t nativeMetadataSizeBytes = 0;
 
+    // size of native code for functions that have a non-zero weight in the host profile
+    size_t nativeHotCodeSizeBytes = 0;
+
     uint32_t functionsTotal = 0;
     uint32_t functionsCompiled = 0;
     uint32_t functionsBound = 0;
+
+    // compilation requests with a ModuleId that were bound to an existing native module, or had to compile one
+    uint32_t moduleCacheHits = 0;
+    uint32_t moduleCacheMisses = 0;
 };
 
 using AllocationCallback = void(void* context, void* oldPointer, size_t oldSize, void* newPointer, size_t newSize);
@@ -388,7 +418,11 @@ std::string getAssembly(lua_State* L, int idx, AssemblyOptions options = {}, Low
 
 using PerfLogFn = void (*)(void* context, uintptr_t addr, unsigned size, const char* symbol);
 
-void setPerfLog(void* context, PerfLogFn logFn);
+// Gets called for each range of native code generated for a single source line; the ranges of a function are reported right before the
+// function itself is reported to PerfLogFn
+using PerfLineLogFn = void (*)(void* context, uintptr_t addr, unsigned size, const char* source, int line);
+
+void setPerfLog(void* context, PerfLogFn logFn, PerfLineLogFn lineLogFn = nullptr);
 
 } // namespace CodeGen
 } // namespace Luau
@@ -72,6 +72,9 @@ struct IrBuilder
     bool interruptRequested = false;
 
     bool activeFastcallFallback = false;
+
+    // Coverage points only record that they were reached, see CodeGen_CoverageHitOnly
+    bool coverageHitOnly = false;
     IrOp fastcallFallbackReturn;
 
     // Force builder to skip source commands
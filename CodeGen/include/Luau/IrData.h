@@ -194,6 +194,10 @@ enum class IrCmd : uint8_t
     // A: TValue
     UNM_VEC,
 
+    // Compute dot product between two vectors, components are summed in order in single precision
+    // A, B: TValue
+    DOT_VEC,
+
     // Compute Luau 'not' operation on destructured TValue
     // A: tag
     // B: int (value)
@@ -227,7 +231,8 @@ enum class IrCmd : uint8_t
     JUMP_EQ_TAG,
 
     // Perform a conditional jump based on the result of integer comparison
-    // A, B: int
+    // A: int
+    // B: int (constant or instruction)
     // C: condition
     // D: block (if true)
     // E: block (if false)
@@ -263,6 +268,7 @@ enum class IrCmd : uint8_t
 
     // Get table length
     // A: pointer (Table)
+    // Note: the array boundary cached in the table is checked and maintained inline, luaH_getn is only called when it can't be used
     TABLE_LEN,
 
     // Get string length
@@ -560,6 +566,7 @@ enum class IrCmd : uint8_t
 
     // Increment coverage data (saturating 24 bit add)
     // A: unsigned int (bytecode instruction index)
+    // B: int (optional, 1 when only the lowest bit of the hit count is set)
     COVERAGE,
 
     // Operations that have a translation, but use a full instruction fallback
@@ -686,6 +693,7 @@ enum class IrCmd : uint8_t
     // Read u8 (zero-extended to int) from buffer storage at specified offset
     // A: pointer (buffer)
     // B: int (offset)
+    // C: tag (LUA_TBUFFER by default; LUA_TSTRING reads string data instead)
     BUFFER_READU8,
 
     // Write i8/u8 value (int argument is truncated) to buffer storage at specified offset
@@ -1006,6 +1014,10 @@ struct BytecodeRegTypeInfo
 struct BytecodeTypeInfo
 {
     std::vector<uint8_t> argumentTypes;
+
+    // Argument types recorded by the interpreter (see lua_settypeprofiling), these are only established by the entry checks
+    std::vector<uint8_t> observedArgumentTypes;
+
     std::vector<BytecodeRegTypeInfo> regTypes;
     std::vector<uint8_t> upvalueTypes;
 
@@ -1023,6 +1035,9 @@ struct IrFunction
     std::vector<BytecodeBlock> bcBlocks;
     std::vector<BytecodeTypes> bcTypes;
 
+    // For each bytecode instruction, registers that the VM might read when execution continues from it
+    std::vector<std::bitset<256>> bcLiveIn;
+
     std::vector<BytecodeMapping> bcMapping;
     uint32_t entryBlock = 0;
     uint32_t entryLocation = 0;
@@ -177,6 +177,7 @@ inline bool hasResult(IrCmd cmd)
     case IrCmd::MUL_VEC:
     case IrCmd::DIV_VEC:
     case IrCmd::UNM_VEC:
+    case IrCmd::DOT_VEC:
     case IrCmd::NOT_ANY:
     case IrCmd::CMP_ANY:
     case IrCmd::TABLE_LEN:
@@ -1,6 +1,7 @@
 // This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
 #pragma once
 
+#include "Luau/CodeAllocator.h"
 #include "Luau/CodeGen.h"
 #include "Luau/Common.h"
 #include "Luau/NativeProtoExecData.h"
@@ -29,7 +30,6 @@ namespace CodeGen
 // count is maintained).
 
 
-struct CodeAllocator;
 class NativeModule;
 class NativeModuleRef;
 class SharedCodeAllocator;
@@ -43,7 +43,7 @@ class NativeModule
 {
 public:
     NativeModule(SharedCodeAllocator* allocator, const std::optional<ModuleId>& moduleId, const uint8_t* moduleBaseAddress,
-        std::vector<NativeProtoExecDataPtr> nativeProtos) noexcept;
+        std::vector<NativeProtoExecDataPtr> nativeProtos, uint8_t* allocationStart, size_t allocationSize) noexcept;
 
     NativeModule(const NativeModule&) = delete;
     NativeModule(NativeModule&&) = delete;
@@ -72,12 +72,18 @@ public:
     [[nodiscard]] const std::vector<NativeProtoExecDataPtr>& getNativeProtos() const noexcept;
 
 private:
+    friend class SharedCodeAllocator;
+
     mutable std::atomic<size_t> refcount = 0;
 
     SharedCodeAllocator* allocator = nullptr;
     std::optional<ModuleId> moduleId = {};
     const uint8_t* moduleBaseAddress = nullptr;
 
+    // Executable memory returned by the CodeAllocator, released together with the module
+    uint8_t* allocationStart = nullptr;
+    size_t allocationSize = 0;
+
     std::vector<NativeProtoExecDataPtr> nativeProtos = {};
 };
 
@@ -141,9 +147,12 @@ public:
     // If a NativeModule exists for the given ModuleId and that NativeModule
     // is no longer referenced, the NativeModule is destroyed.  This should
     // usually only be called by NativeModule::release() when the reference
-    // count becomes zero
+    // count becomes zero.  The executable memory of the module is returned to the
+    // CodeAllocator for reuse.
     void eraseNativeModuleIfUnreferenced(const NativeModule& nativeModule);
 
+    [[nodiscard]] CodeAllocationStats getCodeAllocationStats() const;
+
 private:
     struct ModuleIdHash
     {
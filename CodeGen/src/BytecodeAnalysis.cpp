@@ -10,6 +10,7 @@
 #include "lstate.h"
 
 #include <algorithm>
+#include <bitset>
 
 LUAU_FASTFLAGVARIABLE(LuauCodegenUserdataOps, false)
 LUAU_FASTFLAGVARIABLE(LuauCodegenFastcall3, false)
@@ -46,6 +47,46 @@ static uint32_t readVarInt(uint8_t* data, size_t& offset)
     return result;
 }
 
+static uint8_t getObservedArgumentType(uint8_t tag)
+{
+    switch (tag)
+    {
+    case LUA_TBOOLEAN:
+        return LBC_TYPE_BOOLEAN;
+    case LUA_TNUMBER:
+        return LBC_TYPE_NUMBER;
+    case LUA_TVECTOR:
+        return LBC_TYPE_VECTOR;
+    case LUA_TSTRING:
+        return LBC_TYPE_STRING;
+    case LUA_TTABLE:
+        return LBC_TYPE_TABLE;
+    case LUA_TFUNCTION:
+        return LBC_TYPE_FUNCTION;
+    case LUA_TUSERDATA:
+        return LBC_TYPE_USERDATA;
+    case LUA_TTHREAD:
+        return LBC_TYPE_THREAD;
+    case LUA_TBUFFER:
+        return LBC_TYPE_BUFFER;
+    }
+
+    // Arguments that are always 'nil' are usually unused or optional, and light userdata doesn't have a bytecode type
+    // Arguments that were never observed or had different types are not specialized
+    return LBC_TYPE_ANY;
+}
+
+static void loadObservedArgumentTypes(Proto* proto, BytecodeTypeInfo& typeInfo)
+{
+    if (!proto->argtypes)
+        return;
+
+    typeInfo.observedArgumentTypes.resize(proto->numparams);
+
+    for (int i = 0; i < proto->numparams; i++)
+        typeInfo.observedArgumentTypes[i] = getObservedArgumentType(proto->argtypes[i]);
+}
+
 void loadBytecodeTypeInfo(IrFunction& function)
 {
     Proto* proto = function.proto;
@@ -55,6 +96,8 @@ void loadBytecodeTypeInfo(IrFunction& function)
 
     BytecodeTypeInfo& typeInfo = function.bcTypeInfo;
 
+    loadObservedArgumentTypes(proto, typeInfo);
+
     // If there is no typeinfo, we generate default values for arguments and upvalues
     if (!proto->typeinfo)
     {
@@ -500,10 +543,58 @@ static void applyBuiltinCall(int bfid, BytecodeTypes& types)
         types.b = LBC_TYPE_NUMBER;
         types.c = LBC_TYPE_NUMBER;
         break;
+    case LBF_VECTOR_MAGNITUDE:
+        types.result = LBC_TYPE_NUMBER;
+        types.a = LBC_TYPE_VECTOR;
+        break;
+    case LBF_VECTOR_NORMALIZE:
+    case LBF_VECTOR_FLOOR:
+    case LBF_VECTOR_CEIL:
+    case LBF_VECTOR_ABS:
+    case LBF_VECTOR_SIGN:
+        types.result = LBC_TYPE_VECTOR;
+        types.a = LBC_TYPE_VECTOR;
+        break;
+    case LBF_VECTOR_CROSS:
+        types.result = LBC_TYPE_VECTOR;
+        types.a = LBC_TYPE_VECTOR;
+        types.b = LBC_TYPE_VECTOR;
+        break;
+    case LBF_VECTOR_DOT:
+        types.result = LBC_TYPE_NUMBER;
+        types.a = LBC_TYPE_VECTOR;
+        types.b = LBC_TYPE_VECTOR;
+        break;
+    case LBF_VECTOR_CLAMP:
+        types.result = LBC_TYPE_VECTOR;
+        types.a = LBC_TYPE_VECTOR;
+        types.b = LBC_TYPE_VECTOR;
+        types.c = LBC_TYPE_VECTOR;
+        break;
+    case LBF_VECTOR_MIN:
+    case LBF_VECTOR_MAX:
+        types.result = LBC_TYPE_VECTOR;
+        types.a = LBC_TYPE_VECTOR;
+        types.b = LBC_TYPE_VECTOR; // We can mark optional arguments
+        break;
+    case LBF_VECTOR_LERP:
+        types.result = LBC_TYPE_VECTOR;
+        types.a = LBC_TYPE_VECTOR;
+        types.b = LBC_TYPE_VECTOR;
+        types.c = LBC_TYPE_NUMBER;
+        break;
     case LBF_TABLE_INSERT:
         types.result = LBC_TYPE_NIL;
         types.a = LBC_TYPE_TABLE;
         break;
+    case LBF_TABLE_REMOVE:
+        types.result = LBC_TYPE_ANY;
+        types.a = LBC_TYPE_TABLE;
+        break;
+    case LBF_STRING_FORMAT:
+        types.result = LBC_TYPE_STRING;
+        types.a = LBC_TYPE_STRING;
+        break;
     case LBF_RAWSET:
         types.result = LBC_TYPE_ANY;
         types.a = LBC_TYPE_TABLE;
@@ -1311,5 +1402,258 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
     }
 }
 
+// Collects registers that are read by the instruction and registers that are always overwritten by it
+// When the exact set is not known, all registers from a starting point are considered to be used and none are defined
+static void getBytecodeRegUseDef(Proto* proto, int pcpos, std::bitset<256>& use, std::bitset<256>& def)
+{
+    const Instruction* pc = &proto->code[pcpos];
+    LuauOpcode op = LuauOpcode(LUAU_INSN_OP(*pc));
+
+    use.reset();
+    def.reset();
+
+    auto useFrom = [&](int reg) {
+        for (int i = reg; i < 256; i++)
+            use.set(i);
+    };
+
+    auto useRange = [&](int reg, int count) {
+        if (count < 0)
+            useFrom(reg);
+        else
+            for (int i = reg; i < reg + count; i++)
+                use.set(i);
+    };
+
+    int ra = LUAU_INSN_A(*pc);
+    int rb = LUAU_INSN_B(*pc);
+    int rc = LUAU_INSN_C(*pc);
+
+    switch (op)
+    {
+    case LOP_NOP:
+    case LOP_COVERAGE:
+    case LOP_JUMP:
+    case LOP_JUMPBACK:
+    case LOP_JUMPX:
+        break;
+    case LOP_LOADNIL:
+    case LOP_LOADB:
+    case LOP_LOADN:
+    case LOP_LOADK:
+    case LOP_LOADKX:
+    case LOP_GETGLOBAL:
+    case LOP_GETUPVAL:
+    case LOP_GETIMPORT:
+    case LOP_NEWTABLE:
+    case LOP_DUPTABLE:
+    case LOP_NEWCLOSURE:
+    case LOP_DUPCLOSURE:
+        def.set(ra);
+        break;
+    case LOP_MOVE:
+    case LOP_GETTABLEKS:
+    case LOP_GETTABLEN:
+    case LOP_ADDK:
+    case LOP_SUBK:
+    case LOP_MULK:
+    case LOP_DIVK:
+    case LOP_MODK:
+    case LOP_POWK:
+    case LOP_IDIVK:
+    case LOP_ANDK:
+    case LOP_ORK:
+    case LOP_NOT:
+    case LOP_MINUS:
+    case LOP_LENGTH:
+        use.set(rb);
+        def.set(ra);
+        break;
+    case LOP_SUBRK:
+    case LOP_DIVRK:
+        use.set(rc);
+        def.set(ra);
+        break;
+    case LOP_GETTABLE:
+    case LOP_ADD:
+    case LOP_SUB:
+    case LOP_MUL:
+    case LOP_DIV:
+    case LOP_MOD:
+    case LOP_POW:
+    case LOP_IDIV:
+    case LOP_AND:
+    case LOP_OR:
+        use.set(rb);
+        use.set(rc);
+        def.set(ra);
+        break;
+    case LOP_SETGLOBAL:
+    case LOP_SETUPVAL:
+    case LOP_JUMPIF:
+    case LOP_JUMPIFNOT:
+    case LOP_JUMPXEQKNIL:
+    case LOP_JUMPXEQKB:
+    case LOP_JUMPXEQKN:
+    case LOP_JUMPXEQKS:
+        use.set(ra);
+        break;
+    case LOP_SETTABLEKS:
+    case LOP_SETTABLEN:
+        use.set(ra);
+        use.set(rb);
+        break;
+    case LOP_SETTABLE:
+        use.set(ra);
+        use.set(rb);
+        use.set(rc);
+        break;
+    case LOP_JUMPIFEQ:
+    case LOP_JUMPIFLE:
+    case LOP_JUMPIFLT:
+    case LOP_JUMPIFNOTEQ:
+    case LOP_JUMPIFNOTLE:
+    case LOP_JUMPIFNOTLT:
+        use.set(ra);
+        use.set(pc[1]);
+        break;
+    case LOP_CONCAT:
+        useRange(rb, rc - rb + 1);
+        def.set(ra);
+        break;
+    case LOP_NAMECALL:
+        use.set(rb);
+        def.set(ra);
+        def.set(ra + 1);
+        break;
+    case LOP_CALL:
+        useRange(ra, rb == 0 ? -1 : rb);
+
+        // Only the expected results are written, the rest of the call frame is unspecified
+        if (rc > 0)
+        {
+            for (int i = ra; i < ra + rc - 1; i++)
+                def.set(i);
+        }
+        break;
+    case LOP_RETURN:
+        useRange(ra, rb - 1);
+        break;
+    case LOP_SETLIST:
+        use.set(ra);
+        useRange(rb, rc - 1);
+        break;
+    case LOP_GETVARARGS:
+        for (int i = ra; i < ra + rb - 1; i++)
+            def.set(i);
+        break;
+    case LOP_CAPTURE:
+        if (ra == LCT_VAL || ra == LCT_REF)
+            use.set(rb);
+        break;
+    case LOP_FORNPREP:
+    case LOP_FORNLOOP:
+    case LOP_FORGPREP:
+    case LOP_FORGPREP_INEXT:
+    case LOP_FORGPREP_NEXT:
+    case LOP_FORGLOOP:
+        // Loop variables are only overwritten when iteration continues
+        useRange(ra, 3);
+        break;
+    case LOP_FASTCALL:
+    case LOP_FASTCALL1:
+    case LOP_FASTCALL2:
+    case LOP_FASTCALL2K:
+    case LOP_FASTCALL3:
+    {
+        if (op != LOP_FASTCALL)
+            use.set(rb);
+
+        if (op == LOP_FASTCALL2)
+            use.set(pc[1] & 0xff);
+
+        if (op == LOP_FASTCALL3)
+        {
+            use.set(pc[1] & 0xff);
+            use.set((pc[1] >> 8) & 0xff);
+        }
+
+        // Builtin reads the arguments of the call that follows it
+        const Instruction* call = &proto->code[pcpos + rc + 1];
+
+        if (LUAU_INSN_OP(*call) == LOP_CALL)
+            useFrom(LUAU_INSN_A(*call));
+        else
+            useFrom(0);
+        break;
+    }
+    default:
+        // Instructions like CLOSEUPVALS and PREPVARARGS are not analyzed
+        useFrom(0);
+        break;
+    }
+}
+
+void computeBytecodeLiveness(IrFunction& function)
+{
+    Proto* proto = function.proto;
+    CODEGEN_ASSERT(proto);
+
+    std::vector<std::bitset<256>>& liveIn = function.bcLiveIn;
+
+    liveIn.clear();
+    liveIn.resize(proto->sizecode);
+
+    std::vector<int> pcs;
+
+    for (int i = 0; i < proto->sizecode; i += getOpLength(LuauOpcode(LUAU_INSN_OP(proto->code[i]))))
+        pcs.push_back(i);
+
+    std::bitset<256> use;
+    std::bitset<256> def;
+
+    // Iterating in reverse instruction order requires only a few passes, one more for each level of nested loops
+    bool changed = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        for (auto it = pcs.rbegin(); it != pcs.rend(); ++it)
+        {
+            int i = *it;
+            LuauOpcode op = LuauOpcode(LUAU_INSN_OP(proto->code[i]));
+
+            std::bitset<256> live;
+
+            int target = getJumpTarget(proto->code[i], uint32_t(i));
+            bool unconditional = op == LOP_JUMP || op == LOP_JUMPBACK || op == LOP_JUMPX || op == LOP_FORGPREP || op == LOP_FORGPREP_INEXT ||
+                                 op == LOP_FORGPREP_NEXT;
+
+            if (op != LOP_RETURN && !unconditional)
+            {
+                int nexti = i + getOpLength(op);
+
+                if (nexti < proto->sizecode)
+                    live |= liveIn[nexti];
+            }
+
+            if (target >= 0 && target < proto->sizecode)
+                live |= liveIn[target];
+
+            getBytecodeRegUseDef(proto, i, use, def);
+
+            live &= ~def;
+            live |= use;
+
+            if (live != liveIn[i])
+            {
+                liveIn[i] = live;
+                changed = true;
+            }
+        }
+    }
+}
+
 } // namespace CodeGen
 } // namespace Luau
@@ -9,6 +9,7 @@
 #include "lstate.h"
 
 LUAU_FASTFLAG(LuauNativeAttribute)
+LUAU_FASTINT(CodegenHeuristicsMinFastInstructionPercent)
 
 namespace Luau
 {
@@ -75,5 +76,124 @@ std::vector<FunctionBytecodeSummary> summarizeBytecode(lua_State* L, int idx, un
     return summaries;
 }
 
+// Approximate size of native code for an instruction that calls into a VM helper
+static const unsigned kHelperCallSize = 48;
+
+// Instructions with larger native code size are the ones that get fast paths for common types
+static const unsigned kMinFastPathSize = 64;
+
+// Approximate size of native code for an instruction; 0 marks instructions that mostly call into VM helpers
+// Loads, moves and simple jumps are cheap in the interpreter as well, so they don't count towards the benefit
+static unsigned getNativeCodeSize(LuauOpcode op)
+{
+    switch (op)
+    {
+    case LOP_LOADNIL:
+    case LOP_LOADB:
+    case LOP_LOADN:
+    case LOP_LOADK:
+    case LOP_LOADKX:
+    case LOP_MOVE:
+    case LOP_JUMP:
+    case LOP_JUMPBACK:
+    case LOP_JUMPX:
+        return 16;
+    case LOP_GETUPVAL:
+    case LOP_SETUPVAL:
+    case LOP_GETIMPORT:
+    case LOP_JUMPIF:
+    case LOP_JUMPIFNOT:
+    case LOP_JUMPXEQKNIL:
+    case LOP_JUMPXEQKB:
+    case LOP_NOT:
+    case LOP_AND:
+    case LOP_OR:
+    case LOP_ANDK:
+    case LOP_ORK:
+        return 32;
+    case LOP_JUMPIFEQ:
+    case LOP_JUMPIFLE:
+    case LOP_JUMPIFLT:
+    case LOP_JUMPIFNOTEQ:
+    case LOP_JUMPIFNOTLE:
+    case LOP_JUMPIFNOTLT:
+    case LOP_JUMPXEQKN:
+    case LOP_JUMPXEQKS:
+    case LOP_ADD:
+    case LOP_SUB:
+    case LOP_MUL:
+    case LOP_DIV:
+    case LOP_IDIV:
+    case LOP_MOD:
+    case LOP_POW:
+    case LOP_ADDK:
+    case LOP_SUBK:
+    case LOP_MULK:
+    case LOP_DIVK:
+    case LOP_IDIVK:
+    case LOP_MODK:
+    case LOP_POWK:
+    case LOP_SUBRK:
+    case LOP_DIVRK:
+    case LOP_MINUS:
+    case LOP_LENGTH:
+        return 64;
+    case LOP_GETTABLE:
+    case LOP_SETTABLE:
+    case LOP_GETTABLEKS:
+    case LOP_SETTABLEKS:
+    case LOP_GETTABLEN:
+    case LOP_SETTABLEN:
+    case LOP_FORNPREP:
+    case LOP_FORNLOOP:
+    case LOP_FORGPREP:
+    case LOP_FORGPREP_INEXT:
+    case LOP_FORGPREP_NEXT:
+    case LOP_FORGLOOP:
+    case LOP_FASTCALL:
+    case LOP_FASTCALL1:
+    case LOP_FASTCALL2:
+    case LOP_FASTCALL2K:
+    case LOP_FASTCALL3:
+        return 96;
+    default:
+        return 0;
+    }
+}
+
+FunctionCodeGenEstimate estimateCodeGenBenefit(const FunctionBytecodeSummary& summary)
+{
+    FunctionCodeGenEstimate estimate;
+
+    for (unsigned op = 0; op < summary.getOpLimit(); ++op)
+    {
+        unsigned count = summary.getCount(0, uint8_t(op));
+
+        if (count == 0)
+            continue;
+
+        unsigned size = getNativeCodeSize(LuauOpcode(op));
+
+        estimate.instructionCount += count;
+
+        if (size == 0)
+            estimate.helperInstructionCount += count;
+        else if (size >= kMinFastPathSize)
+            estimate.fastInstructionCount += count;
+
+        estimate.nativeCodeSizeBytes += count * (size != 0 ? size : kHelperCallSize);
+
+        if (op == LOP_FORNLOOP || op == LOP_FORGLOOP || op == LOP_JUMPBACK)
+            estimate.hasLoops = true;
+    }
+
+    unsigned weightedCount = estimate.fastInstructionCount + estimate.helperInstructionCount;
+
+    estimate.profitable =
+        estimate.hasLoops || estimate.fastInstructionCount * 100 >= weightedCount * unsigned(FInt::CodegenHeuristicsMinFastInstructionPercent);
+
+    return estimate;
+}
+
 } // namespace CodeGen
 } // namespace Luau
@@ -3,6 +3,8 @@
 
 #include "Luau/CodeGenCommon.h"
 
+#include <algorithm>
+
 #include <string.h>
 
 #if defined(_WIN32)
@@ -36,6 +38,16 @@ static size_t alignToPageSize(size_t size)
     return (size + kPageSize - 1) & ~(kPageSize - 1);
 }
 
+static uint8_t* alignDownToPage(uint8_t* pos)
+{
+    return reinterpret_cast<uint8_t*>(uintptr_t(pos) & ~(kPageSize - 1));
+}
+
+static uint8_t* alignUpToPage(uint8_t* pos)
+{
+    return reinterpret_cast<uint8_t*>(alignToPageSize(uintptr_t(pos)));
+}
+
 #if defined(_WIN32)
 static uint8_t* allocatePagesImpl(size_t size)
 {
@@ -62,6 +74,16 @@ static void makePagesExecutable(uint8_t* mem, size_t size)
         CODEGEN_ASSERT(!"Failed to change page protection");
 }
 
+static void makePagesWritable(uint8_t* mem, size_t size)
+{
+    CODEGEN_ASSERT((uintptr_t(mem) & (kPageSize - 1)) == 0);
+    CODEGEN_ASSERT(size == alignToPageSize(size));
+
+    DWORD oldProtect;
+    if (VirtualProtect(mem, size, PAGE_READWRITE, &oldProtect) == 0)
+        CODEGEN_ASSERT(!"Failed to change page protection");
+}
+
 static void flushInstructionCache(uint8_t* mem, size_t size)
 {
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_APP | WINAPI_PARTITION_SYSTEM)
@@ -100,6 +122,15 @@ static void makePagesExecutable(uint8_t* mem, size_t size)
         CODEGEN_ASSERT(!"Failed to change page protection");
 }
 
+static void makePagesWritable(uint8_t* mem, size_t size)
+{
+    CODEGEN_ASSERT((uintptr_t(mem) & (kPageSize - 1)) == 0);
+    CODEGEN_ASSERT(size == alignToPageSize(size));
+
+    if (mprotect(mem, size, PROT_READ | PROT_WRITE) != 0)
+        CODEGEN_ASSERT(!"Failed to change page protection");
+}
+
 static void flushInstructionCache(uint8_t* mem, size_t size)
 {
 #ifdef __APPLE__
@@ -132,14 +163,13 @@ CodeAllocator::CodeAllocator(size_t blockSize, size_t maxTotalSize, AllocationCa
 
 CodeAllocator::~CodeAllocator()
 {
-    if (destroyBlockUnwindInfo)
+    for (Block& block : blocks)
     {
-        for (void* unwindInfo : unwindInfos)
-            destroyBlockUnwindInfo(context, unwindInfo);
-    }
+        if (destroyBlockUnwindInfo && block.unwindInfo)
+            destroyBlockUnwindInfo(context, block.unwindInfo);
 
-    for (uint8_t* block : blocks)
-        freePages(block, blockSize);
+        freePages(block.start, blockSize);
+    }
 }
 
 bool CodeAllocator::allocate(
@@ -154,56 +184,136 @@ bool CodeAllocator::allocate(
     if (totalSize > blockSize - kMaxReservedDataSize)
         return false;
 
-    size_t startOffset = 0;
+    uint8_t* start = nullptr;
 
-    // We might need a new block
-    if (totalSize > size_t(blockEnd - blockPos))
+    // Memory released by earlier allocations is reused before we advance in the current block
+    if (!allocateFromFreeRange(totalSize, start))
     {
-        if (!allocateNewBlock(startOffset))
-            return false;
-
-        CODEGEN_ASSERT(totalSize <= size_t(blockEnd - blockPos));
+        size_t startOffset = 0;
+
+        // We might need a new block
+        if (totalSize > size_t(blockEnd - blockPos))
+        {
+            if (!allocateNewBlock(startOffset))
+                return false;
+
+            CODEGEN_ASSERT(totalSize <= size_t(blockEnd - blockPos));
+        }
+
+        CODEGEN_ASSERT((uintptr_t(blockPos) & (kPageSize - 1)) == 0); // Allocation starts on page boundary
+
+        start = blockPos + startOffset;
+
+        size_t pageAlignedSize = alignToPageSize(startOffset + totalSize);
+
+        // Ensure that future allocations from the block start from a page boundary.
+        // This is important since we use W^X, and writing to the previous page would require briefly removing
+        // executable bit from it, which may result in access violations if that code is being executed concurrently.
+        if (pageAlignedSize <= size_t(blockEnd - blockPos))
+        {
+            blockPos += pageAlignedSize;
+            CODEGEN_ASSERT((uintptr_t(blockPos) & (kPageSize - 1)) == 0);
+            CODEGEN_ASSERT(blockPos <= blockEnd);
+        }
+        else
+        {
+            // Future allocations will need to allocate fresh blocks
+            blockPos = blockEnd;
+        }
+
+        Block* block = findBlock(start);
+        CODEGEN_ASSERT(block);
+
+        block->allocationCount++;
+        allocatedSize += blockPos - start;
     }
 
-    CODEGEN_ASSERT((uintptr_t(blockPos) & (kPageSize - 1)) == 0); // Allocation starts on page boundary
-
-    size_t dataOffset = startOffset + alignedDataSize - dataSize;
-    size_t codeOffset = startOffset + alignedDataSize;
+    size_t dataOffset = alignedDataSize - dataSize;
+    size_t codeOffset = alignedDataSize;
 
     if (dataSize)
-        memcpy(blockPos + dataOffset, data, dataSize);
+        memcpy(start + dataOffset, data, dataSize);
     if (codeSize)
-        memcpy(blockPos + codeOffset, code, codeSize);
+        memcpy(start + codeOffset, code, codeSize);
 
-    size_t pageAlignedSize = alignToPageSize(startOffset + totalSize);
+    uint8_t* pageStart = alignDownToPage(start);
 
-    makePagesExecutable(blockPos, pageAlignedSize);
-    flushInstructionCache(blockPos + codeOffset, codeSize);
+    makePagesExecutable(pageStart, alignToPageSize(start + totalSize - pageStart));
+    flushInstructionCache(start + codeOffset, codeSize);
 
-    result = blockPos + startOffset;
+    result = start;
     resultSize = totalSize;
-    resultCodeStart = blockPos + codeOffset;
+    resultCodeStart = start + codeOffset;
+
+    return true;
+}
 
-    // Ensure that future allocations from the block start from a page boundary.
-    // This is important since we use W^X, and writing to the previous page would require briefly removing
-    // executable bit from it, which may result in access violations if that code is being executed concurrently.
-    if (pageAlignedSize <= size_t(blockEnd - blockPos))
+void CodeAllocator::deallocate(uint8_t* result, size_t resultSize)
+{
+    Block* block = findBlock(result);
+    CODEGEN_ASSERT(block);
+    CODEGEN_ASSERT(block->allocationCount != 0);
+
+    // Allocations own memory up to the next page boundary, see 'allocate'
+    uint8_t* start = result;
+    uint8_t* end = std::min(alignUpToPage(result + resultSize), block->start + blockSize);
+
+    allocatedSize -= end - start;
+
+    // Insert the range keeping the list sorted and merge it with adjacent ranges from the same block
+    auto it = std::lower_bound(freeRanges.begin(), freeRanges.end(), start, [](const FreeRange& range, uint8_t* pos) {
+        return range.start < pos;
+    });
+
+    CODEGEN_ASSERT(it == freeRanges.end() || it->start >= end);
+
+    it = freeRanges.insert(it, FreeRange{start, end});
+
+    if (std::next(it) != freeRanges.end() && std::next(it)->start == end && findBlock(std::next(it)->start) == block)
     {
-        blockPos += pageAlignedSize;
-        CODEGEN_ASSERT((uintptr_t(blockPos) & (kPageSize - 1)) == 0);
-        CODEGEN_ASSERT(blockPos <= blockEnd);
+        it->end = std::next(it)->end;
+        freeRanges.erase(std::next(it));
     }
-    else
+
+    if (it != freeRanges.begin() && std::prev(it)->end == start && findBlock(std::prev(it)->start) == block)
     {
-        // Future allocations will need to allocate fresh blocks
-        blockPos = blockEnd;
+        std::prev(it)->end = it->end;
+        freeRanges.erase(it);
     }
 
-    return true;
+    block->allocationCount--;
+
+    // Once a block no longer has live allocations, it can be returned to the system unless we are still advancing through it
+    if (block->allocationCount == 0 && block->start + blockSize != blockEnd)
+        releaseBlock(*block);
+}
+
+CodeAllocationStats CodeAllocator::getStats() const
+{
+    CodeAllocationStats stats;
+
+    stats.blockCount = blocks.size();
+    stats.blockSize = blocks.size() * blockSize;
+    stats.allocatedSize = allocatedSize;
+    stats.freeRangeCount = freeRanges.size();
+
+    for (const FreeRange& range : freeRanges)
+    {
+        size_t size = range.end - range.start;
+
+        stats.freeRangeSize += size;
+        stats.largestFreeRange = std::max(stats.largestFreeRange, size);
+    }
+
+    return stats;
 }
 
 bool CodeAllocator::allocateNewBlock(size_t& unwindInfoSize)
 {
+    // All allocations from the block we were advancing through might have been released already
+    if (Block* current = blockEnd ? findBlock(blockEnd - blockSize) : nullptr; current && current->allocationCount == 0)
+        releaseBlock(*current);
+
     // Stop allocating once we reach a global limit
     if ((blocks.size() + 1) * blockSize > maxTotalSize)
         return false;
@@ -216,7 +326,7 @@ bool CodeAllocator::allocateNewBlock(size_t& unwindInfoSize)
     blockPos = block;
     blockEnd = block + blockSize;
 
-    blocks.push_back(block);
+    blocks.push_back(Block{block});
 
     if (createBlockUnwindInfo)
     {
@@ -230,12 +340,80 @@ bool CodeAllocator::allocateNewBlock(size_t& unwindInfoSize)
         if (!unwindInfo)
             return false;
 
-        unwindInfos.push_back(unwindInfo);
+        blocks.back().unwindInfo = unwindInfo;
     }
 
     return true;
 }
 
+bool CodeAllocator::allocateFromFreeRange(size_t size, uint8_t*& result)
+{
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+    {
+        if (size > size_t(it->end - it->start))
+            continue;
+
+        uint8_t* start = it->start;
+        uint8_t* end = std::min(alignUpToPage(start + size), it->end);
+
+        // Code in the released range is no longer executed, so its pages can be made writable again
+        // Same as in the current block, the rest of the range starts from a page boundary
+        uint8_t* pageStart = alignDownToPage(start);
+        makePagesWritable(pageStart, alignToPageSize(end - pageStart));
+
+        if (end == it->end)
+            freeRanges.erase(it);
+        else
+            it->start = end;
+
+        Block* block = findBlock(start);
+        CODEGEN_ASSERT(block);
+
+        block->allocationCount++;
+        allocatedSize += end - start;
+
+        result = start;
+        return true;
+    }
+
+    return false;
+}
+
+CodeAllocator::Block* CodeAllocator::findBlock(uint8_t* pos)
+{
+    for (Block& block : blocks)
+    {
+        if (pos >= block.start && pos < block.start + blockSize)
+            return &block;
+    }
+
+    return nullptr;
+}
+
+void CodeAllocator::releaseBlock(Block& block)
+{
+    uint8_t* start = block.start;
+
+    freeRanges.erase(std::remove_if(freeRanges.begin(), freeRanges.end(),
+                         [&](const FreeRange& range) {
+                             return range.start >= start && range.start < start + blockSize;
+                         }),
+        freeRanges.end());
+
+    if (destroyBlockUnwindInfo && block.unwindInfo)
+        destroyBlockUnwindInfo(context, block.unwindInfo);
+
+    freePages(start, blockSize);
+
+    if (blockEnd == start + blockSize)
+    {
+        blockPos = nullptr;
+        blockEnd = nullptr;
+    }
+
+    blocks.erase(blocks.begin() + (&block - blocks.data()));
+}
+
 uint8_t* CodeAllocator::allocatePages(size_t size) const
 {
     const size_t pageAlignedSize = alignToPageSize(size);
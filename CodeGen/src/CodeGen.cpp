@@ -58,6 +58,9 @@ LUAU_FASTINTVARIABLE(CodegenHeuristicsBlockLimit, 32'768) // 32 K
 // Current value is based on some member variables being limited to 16 bits
 LUAU_FASTINTVARIABLE(CodegenHeuristicsBlockInstructionLimit, 65'536) // 64 K
 
+// Minimum share of instructions with native fast paths for a function without loops to be compiled with CodeGen_SkipLowBenefit
+LUAU_FASTINTVARIABLE(CodegenHeuristicsMinFastInstructionPercent, 40)
+
 namespace Luau
 {
 namespace CodeGen
@@ -87,6 +90,8 @@ std::string toString(const CodeGenCompilationResult& result)
         return "CodeGenLoweringFailure";
     case CodeGenCompilationResult::AllocationFailed:
         return "AllocationFailed";
+    case CodeGenCompilationResult::CodeGenLowBenefit:
+        return "CodeGenLowBenefit";
     case CodeGenCompilationResult::Count:
         return "Count";
     }
@@ -55,7 +55,7 @@ static void emitInterrupt(AssemblyBuilderA64& build)
     // x0 = pc offset
     // x1 = return address in native code
 
-    Label skip;
+    Label skip, exhausted;
 
     // Stash return address in rBase; we need to reload rBase anyway
     build.mov(rBase, x1);
@@ -65,6 +65,16 @@ static void emitInterrupt(AssemblyBuilderA64& build)
     build.ldr(x2, mem(x2, offsetof(global_State, cb.interrupt)));
     build.cbz(x2, skip);
 
+    // Consume the interrupt budget; the interrupt is only called once it runs out
+    build.ldr(w3, mem(rState, offsetof(lua_State, interruptbudget)));
+    build.cmp(w3, 0);
+    build.b(ConditionA64::LessEqual, exhausted);
+    build.sub(w3, w3, 1);
+    build.str(w3, mem(rState, offsetof(lua_State, interruptbudget)));
+    build.cbnz(w3, skip);
+
+    build.setLabel(exhausted);
+
     // Update savedpc; required in case interrupt errors
     build.add(x0, rCode, x0);
     build.ldr(x1, mem(rState, offsetof(lua_State, ci)));
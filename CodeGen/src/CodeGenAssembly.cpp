@@ -230,6 +230,7 @@ static std::string getAssemblyImpl(AssemblyBuilder& build, const TValue* func, A
     for (Proto* p : protos)
     {
         IrBuilder ir(options.compilationOptions.hooks);
+        ir.coverageHitOnly = (options.compilationOptions.flags & CodeGen_CoverageHitOnly) != 0;
         ir.buildFunctionIr(p);
         unsigned asmSize = build.getCodeSize();
         unsigned asmCount = build.getInstructionCount();
@@ -5,12 +5,16 @@
 #include "CodeGenLower.h"
 #include "CodeGenX64.h"
 
+#include "Luau/BytecodeSummary.h"
 #include "Luau/CodeBlockUnwind.h"
 #include "Luau/UnwindBuilder.h"
 #include "Luau/UnwindBuilderDwarf2.h"
 #include "Luau/UnwindBuilderWin.h"
 
 #include "lapi.h"
+#include "ldebug.h"
+
+#include <algorithm>
 
 LUAU_FASTINTVARIABLE(LuauCodeGenBlockSize, 4 * 1024 * 1024)
 LUAU_FASTINTVARIABLE(LuauCodeGenMaxTotalSize, 256 * 1024 * 1024)
@@ -26,22 +30,64 @@ static const Instruction kCodeEntryInsn = LOP_NATIVECALL;
 // From CodeGen.cpp
 static void* gPerfLogContext = nullptr;
 static PerfLogFn gPerfLogFn = nullptr;
+static PerfLineLogFn gPerfLineLogFn = nullptr;
 
 unsigned int getCpuFeaturesA64();
 
-void setPerfLog(void* context, PerfLogFn logFn)
+void setPerfLog(void* context, PerfLogFn logFn, PerfLineLogFn lineLogFn)
 {
     gPerfLogContext = context;
     gPerfLogFn = logFn;
+    gPerfLineLogFn = lineLogFn;
 }
 
-static void logPerfFunction(Proto* p, uintptr_t addr, unsigned size)
+static void logPerfLines(Proto* p, const char* source, uintptr_t addr, unsigned size, const uint32_t* instructionOffsets)
+{
+    if (!p->lineinfo)
+        return;
+
+    // Native code for bytecode instructions isn't laid out in bytecode order, so ranges are formed from sorted offsets; instructions that
+    // don't start native code (e.g. auxiliary words) have offsets that don't fit in the function and are skipped
+    std::vector<std::pair<uint32_t, int>> starts;
+
+    for (int pc = 0; pc < p->sizecode; ++pc)
+    {
+        if (instructionOffsets[pc] < size)
+            starts.push_back({instructionOffsets[pc], luaG_getline(p, pc)});
+    }
+
+    std::sort(starts.begin(), starts.end());
+
+    for (size_t i = 0; i < starts.size();)
+    {
+        size_t next = i + 1;
+
+        while (next < starts.size() && starts[next].second == starts[i].second)
+            next++;
+
+        uint32_t end = next < starts.size() ? starts[next].first : size;
+
+        if (end > starts[i].first)
+            gPerfLineLogFn(gPerfLogContext, addr + starts[i].first, end - starts[i].first, source, starts[i].second);
+
+        i = next;
+    }
+}
+
+static void logPerfFunction(Proto* p, const uint32_t* instructionOffsets)
 {
     CODEGEN_ASSERT(p->source);
 
+    const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(instructionOffsets);
+    uintptr_t addr = uintptr_t(header.entryOffsetOrAddress);
+    unsigned size = unsigned(header.nativeCodeSize);
+
     const char* source = getstr(p->source);
     source = (source[0] == '=' || source[0] == '@') ? source + 1 : "[string]";
 
+    if (gPerfLineLogFn)
+        logPerfLines(p, source, addr, size, instructionOffsets);
+
     char name[256];
     snprintf(name, sizeof(name), "<luau> %s:%d %s", source, p->linedefined, p->debugname ? getstr(p->debugname) : "");
 
@@ -56,8 +102,15 @@ static void logPerfFunctions(
         return;
 
     if (nativeProtos.size() > 0)
-        gPerfLogFn(gPerfLogContext, uintptr_t(nativeModuleBaseAddress),
-            unsigned(getNativeProtoExecDataHeader(nativeProtos[0].get()).entryOffsetOrAddress - nativeModuleBaseAddress), "<luau helpers>");
+    {
+        // Helpers are placed before all functions, which are not necessarily in bytecode order
+        const uint8_t* firstEntry = getNativeProtoExecDataHeader(nativeProtos[0].get()).entryOffsetOrAddress;
+
+        for (const NativeProtoExecDataPtr& nativeProto : nativeProtos)
+            firstEntry = std::min(firstEntry, getNativeProtoExecDataHeader(nativeProto.get()).entryOffsetOrAddress);
+
+        gPerfLogFn(gPerfLogContext, uintptr_t(nativeModuleBaseAddress), unsigned(firstEntry - nativeModuleBaseAddress), "<luau helpers>");
+    }
 
     auto protoIt = moduleProtos.begin();
 
@@ -72,7 +125,7 @@ static void logPerfFunctions(
 
         CODEGEN_ASSERT(protoIt != moduleProtos.end());
 
-        logPerfFunction(*protoIt, uintptr_t(header.entryOffsetOrAddress), uint32_t(header.nativeCodeSize));
+        logPerfFunction(*protoIt, nativeProto.get());
     }
 }
 
@@ -323,6 +376,19 @@ static void onDestroyFunction(lua_State* L, Proto* proto) noexcept
     proto->codeentry = proto->code;
 }
 
+static void onEnable(lua_State* L, Proto* proto) noexcept
+{
+    // do nothing if proto already uses native code
+    if (proto->codeentry != proto->code)
+        return;
+
+    // frames that are already running the bytecode finish in the VM, new calls enter native code again
+    const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(static_cast<const uint32_t*>(proto->execdata));
+
+    proto->exectarget = reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress);
+    proto->codeentry = &kCodeEntryInsn;
+}
+
 static int onEnter(lua_State* L, Proto* proto)
 {
     BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
@@ -367,6 +433,7 @@ static void initializeExecutionCallbacks(lua_State* L, BaseCodeGenContext* codeG
     ecb->destroy = onDestroyFunction;
     ecb->enter = onEnter;
     ecb->disable = onDisable;
+    ecb->enable = onEnable;
     ecb->getmemorysize = getMemorySize;
 }
 
@@ -421,29 +488,79 @@ void create(lua_State* L, SharedCodeGenContext* codeGenContext)
     return nativeExecData;
 }
 
+struct FunctionIr
+{
+    FunctionIr(const HostIrHooks& hooks, unsigned int flags)
+        : ir(hooks)
+    {
+        ir.coverageHitOnly = (flags & CodeGen_CoverageHitOnly) != 0;
+    }
+
+    IrBuilder ir;
+    unsigned instCount = 0;
+
+    bool optimized = false;
+    std::vector<uint32_t> sortedBlocks;
+    CodeGenCompilationResult result = CodeGenCompilationResult::Success;
+};
+
+static void buildFunctionIr(FunctionIr& function, Proto* proto)
+{
+    function.ir.buildFunctionIr(proto);
+    function.instCount = unsigned(function.ir.function.instructions.size());
+}
+
+static void optimizeFunctionIr(FunctionIr& function)
+{
+    function.optimized = optimizeFunction(function.ir, function.sortedBlocks, /* stats */ nullptr, function.result);
+}
+
+struct ParallelBuildContext
+{
+    std::vector<std::unique_ptr<FunctionIr>>& functions;
+    const std::vector<Proto*>& protos;
+};
+
+static void parallelBuildJob(void* context, int index)
+{
+    ParallelBuildContext* ctx = static_cast<ParallelBuildContext*>(context);
+
+    FunctionIr& function = *ctx->functions[index];
+
+    buildFunctionIr(function, ctx->protos[index]);
+    optimizeFunctionIr(function);
+}
+
 template<typename AssemblyBuilder>
 [[nodiscard]] static NativeProtoExecDataPtr createNativeFunction(AssemblyBuilder& build, ModuleHelpers& helpers, Proto* proto,
-    uint32_t& totalIrInstCount, const HostIrHooks& hooks, CodeGenCompilationResult& result)
+    uint32_t& totalIrInstCount, FunctionIr& function, bool prepared, CodeGenCompilationResult& result)
 {
-    IrBuilder ir(hooks);
-    ir.buildFunctionIr(proto);
-
-    unsigned instCount = unsigned(ir.function.instructions.size());
+    if (!prepared)
+        buildFunctionIr(function, proto);
 
-    if (totalIrInstCount + instCount >= unsigned(FInt::CodegenHeuristicsInstructionLimit.value))
+    if (totalIrInstCount + function.instCount >= unsigned(FInt::CodegenHeuristicsInstructionLimit.value))
     {
         result = CodeGenCompilationResult::CodeGenOverflowInstructionLimit;
         return {};
     }
 
-    totalIrInstCount += instCount;
+    totalIrInstCount += function.instCount;
+
+    if (!prepared)
+        optimizeFunctionIr(function);
+
+    if (!function.optimized)
+    {
+        result = function.result;
+        return {};
+    }
 
-    if (!lowerFunction(ir, build, helpers, proto, {}, /* stats */ nullptr, result))
+    if (!lowerOptimizedFunction(function.ir, function.sortedBlocks, build, helpers, proto, {}, /* stats */ nullptr, result))
     {
         return {};
     }
 
-    return createNativeProtoExecData(proto, ir);
+    return createNativeProtoExecData(proto, function.ir);
 }
 
 [[nodiscard]] static CompilationResult compileInternal(
@@ -480,15 +597,45 @@ template<typename AssemblyBuilder>
     if (stats != nullptr)
         stats->functionsTotal = uint32_t(protos.size());
 
+    // Modules that were already compiled through a shared context are bound before any per-function work is done
     if (moduleId.has_value())
     {
         if (std::optional<ModuleBindResult> existingModuleBindResult = codeGenContext->tryBindExistingModule(*moduleId, protos))
         {
             if (stats != nullptr)
+            {
                 stats->functionsBound = existingModuleBindResult->functionsBound;
+                stats->moduleCacheHits += 1;
+            }
 
             return CompilationResult{existingModuleBindResult->compilationResult};
         }
+
+        if (stats != nullptr)
+            stats->moduleCacheMisses += 1;
+    }
+
+    CompilationResult compilationResult;
+
+    // Functions rejected by the cost model are reported as failures, so that the decision is visible to the host
+    if ((options.flags & CodeGen_SkipLowBenefit) != 0)
+    {
+        protos.erase(std::remove_if(protos.begin(), protos.end(),
+                         [&](Proto* p) {
+                             if (estimateCodeGenBenefit(FunctionBytecodeSummary::fromProto(p, 0)).profitable)
+                                 return false;
+
+                             compilationResult.protoFailures.push_back(
+                                 {CodeGenCompilationResult::CodeGenLowBenefit, p->debugname ? getstr(p->debugname) : "", p->linedefined});
+                             return true;
+                         }),
+            protos.end());
+
+        if (protos.empty())
+        {
+            compilationResult.result = CodeGenCompilationResult::NothingToCompile;
+            return compilationResult;
+        }
     }
 
 #if defined(CODEGEN_TARGET_A64)
@@ -505,21 +652,61 @@ template<typename AssemblyBuilder>
     X64::assembleHelpers(build, helpers);
 #endif
 
-    CompilationResult compilationResult;
-
     std::vector<NativeProtoExecDataPtr> nativeProtos;
     nativeProtos.reserve(protos.size());
 
-    uint32_t totalIrInstCount = 0;
+    // When the host provides an executor, IR for all functions is prepared up front; instruction limits are still applied in order below
+    // so that the set of compiled functions doesn't depend on the executor
+    std::vector<std::unique_ptr<FunctionIr>> preparedFunctions;
+
+    if (options.parallel && protos.size() > 1)
+    {
+        preparedFunctions.reserve(protos.size());
+
+        for (size_t i = 0; i != protos.size(); ++i)
+            preparedFunctions.push_back(std::make_unique<FunctionIr>(options.hooks, options.flags));
+
+        ParallelBuildContext context{preparedFunctions, protos};
+        options.parallel(options.parallelContext, int(protos.size()), parallelBuildJob, &context);
+    }
+
+    // Functions are emitted in bytecode order, unless the host profile asks for hot functions to be placed together at the start
+    std::vector<uint32_t> weights(protos.size());
+    std::vector<size_t> emitOrder(protos.size());
 
     for (size_t i = 0; i != protos.size(); ++i)
+    {
+        if (options.functionWeight)
+            weights[i] = options.functionWeight(
+                options.functionWeightContext, protos[i]->debugname ? getstr(protos[i]->debugname) : "", protos[i]->linedefined);
+
+        emitOrder[i] = i;
+    }
+
+    if (options.functionWeight)
+    {
+        std::stable_sort(emitOrder.begin(), emitOrder.end(), [&](size_t a, size_t b) {
+            return weights[a] > weights[b];
+        });
+    }
+
+    std::vector<uint32_t> nativeProtoWeights;
+    nativeProtoWeights.reserve(protos.size());
+
+    uint32_t totalIrInstCount = 0;
+
+    for (size_t i : emitOrder)
     {
         CodeGenCompilationResult protoResult = CodeGenCompilationResult::Success;
 
-        NativeProtoExecDataPtr nativeExecData = createNativeFunction(build, helpers, protos[i], totalIrInstCount, options.hooks, protoResult);
+        bool prepared = !preparedFunctions.empty();
+        std::unique_ptr<FunctionIr> function = prepared ? std::move(preparedFunctions[i]) : std::make_unique<FunctionIr>(options.hooks, options.flags);
+
+        NativeProtoExecDataPtr nativeExecData = createNativeFunction(build, helpers, protos[i], totalIrInstCount, *function, prepared, protoResult);
         if (nativeExecData != nullptr)
         {
             nativeProtos.push_back(std::move(nativeExecData));
+            nativeProtoWeights.push_back(weights[i]);
         }
         else
         {
@@ -540,16 +727,32 @@ template<typename AssemblyBuilder>
     if (nativeProtos.empty())
         return compilationResult;
 
+    for (size_t i = 0; i < nativeProtos.size(); ++i)
+    {
+        NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProtos[i].get());
+
+        uint32_t begin = uint32_t(reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress));
+        uint32_t end = i + 1 < nativeProtos.size() ? uint32_t(uintptr_t(getNativeProtoExecDataHeader(nativeProtos[i + 1].get()).entryOffsetOrAddress))
+                                                   : uint32_t(build.code.size() * sizeof(build.code[0]));
+
+        CODEGEN_ASSERT(begin < end);
+
+        header.nativeCodeSize = end - begin;
+    }
+
     if (stats != nullptr)
     {
-        for (const NativeProtoExecDataPtr& nativeExecData : nativeProtos)
+        for (size_t i = 0; i < nativeProtos.size(); ++i)
         {
-            NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeExecData.get());
+            NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProtos[i].get());
 
             stats->bytecodeSizeBytes += header.bytecodeInstructionCount * sizeof(Instruction);
 
             // Account for the native -> bytecode instruction offsets mapping:
             stats->nativeMetadataSizeBytes += header.bytecodeInstructionCount * sizeof(uint32_t);
+
+            if (nativeProtoWeights[i] != 0)
+                stats->nativeHotCodeSizeBytes += header.nativeCodeSize;
         }
 
         stats->functionsCompiled += uint32_t(nativeProtos.size());
@@ -557,17 +760,12 @@ template<typename AssemblyBuilder>
         stats->nativeDataSizeBytes += build.data.size();
     }
 
-    for (size_t i = 0; i < nativeProtos.size(); ++i)
+    // Binding expects native protos in bytecode order, same as the module protos
+    if (options.functionWeight)
     {
-        NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProtos[i].get());
-
-        uint32_t begin = uint32_t(reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress));
-        uint32_t end = i + 1 < nativeProtos.size() ? uint32_t(uintptr_t(getNativeProtoExecDataHeader(nativeProtos[i + 1].get()).entryOffsetOrAddress))
-                                                   : uint32_t(build.code.size() * sizeof(build.code[0]));
-
-        CODEGEN_ASSERT(begin < end);
-
-        header.nativeCodeSize = end - begin;
+        std::sort(nativeProtos.begin(), nativeProtos.end(), [](const NativeProtoExecDataPtr& a, const NativeProtoExecDataPtr& b) {
+            return getNativeProtoExecDataHeader(a.get()).bytecodeId < getNativeProtoExecDataHeader(b.get()).bytecodeId;
+        });
     }
 
     const ModuleBindResult bindResult =
@@ -281,9 +281,9 @@ inline bool lowerIr(A64::AssemblyBuilderA64& build, IrBuilder& ir, const std::ve
     return lowerImpl(build, lowering, ir.function, sortedBlocks, proto->bytecodeid, options);
 }
 
-template<typename AssemblyBuilder>
-inline bool lowerFunction(IrBuilder& ir, AssemblyBuilder& build, ModuleHelpers& helpers, Proto* proto, AssemblyOptions options, LoweringStats* stats,
-    CodeGenCompilationResult& codeGenCompilationResult)
+// Runs the optimization pipeline and computes the block order for lowering; this only touches the IR and the source proto
+inline bool optimizeFunction(
+    IrBuilder& ir, std::vector<uint32_t>& sortedBlocks, LoweringStats* stats, CodeGenCompilationResult& codeGenCompilationResult)
 {
     killUnusedBlocks(ir.function);
 
@@ -349,7 +349,7 @@ inline bool lowerFunction(IrBuilder& ir, AssemblyBuilder& build, ModuleHelpers&
         markDeadStoresInBlockChains(ir);
     }
 
-    std::vector<uint32_t> sortedBlocks = getSortedBlockOrder(ir.function);
+    sortedBlocks = getSortedBlockOrder(ir.function);
 
     // In order to allocate registers during lowering, we need to know where instruction results are last used
     updateLastUseLocations(ir.function, sortedBlocks);
@@ -363,6 +363,13 @@ inline bool lowerFunction(IrBuilder& ir, AssemblyBuilder& build, ModuleHelpers&
         }
     }
 
+    return true;
+}
+
+template<typename AssemblyBuilder>
+inline bool lowerOptimizedFunction(IrBuilder& ir, const std::vector<uint32_t>& sortedBlocks, AssemblyBuilder& build, ModuleHelpers& helpers,
+    Proto* proto, AssemblyOptions options, LoweringStats* stats, CodeGenCompilationResult& codeGenCompilationResult)
+{
     bool result = lowerIr(build, ir, sortedBlocks, helpers, proto, options, stats);
 
     if (!result)
@@ -371,5 +378,17 @@ inline bool lowerFunction(IrBuilder& ir, AssemblyBuilder& build, ModuleHelpers&
     return result;
 }
 
+template<typename AssemblyBuilder>
+inline bool lowerFunction(IrBuilder& ir, AssemblyBuilder& build, ModuleHelpers& helpers, Proto* proto, AssemblyOptions options, LoweringStats* stats,
+    CodeGenCompilationResult& codeGenCompilationResult)
+{
+    std::vector<uint32_t> sortedBlocks;
+
+    if (!optimizeFunction(ir, sortedBlocks, stats, codeGenCompilationResult))
+        return false;
+
+    return lowerOptimizedFunction(ir, sortedBlocks, build, helpers, proto, options, stats, codeGenCompilationResult);
+}
+
 } // namespace CodeGen
 } // namespace Luau
@@ -45,7 +45,7 @@
 #define VM_INTERRUPT() \
     { \
         void (*interrupt)(lua_State*, int) = L->global->cb.interrupt; \
-        if (LUAU_UNLIKELY(!!interrupt)) \
+        if (LUAU_UNLIKELY(!!interrupt) && (L->interruptbudget <= 0 || --L->interruptbudget == 0)) \
         { /* the interrupt hook is called right before we advance pc */ \
             VM_PROTECT(L->ci->savedpc++; interrupt(L, -1)); \
             if (L->status != 0) \
@@ -104,31 +104,6 @@ bool forgLoopTableIter(lua_State* L, Table* h, int index, TValue* ra)
     return false;
 }
 
-bool forgLoopNodeIter(lua_State* L, Table* h, int index, TValue* ra)
-{
-    int sizearray = h->sizearray;
-    int sizenode = 1 << h->lsizenode;
-
-    // then we advance index through the hash portion
-    while (unsigned(index - sizearray) < unsigned(sizenode))
-    {
-        LuaNode* n = &h->node[index - sizearray];
-
-        if (!ttisnil(gval(n)))
-        {
-            setpvalue(ra + 2, reinterpret_cast<void*>(uintptr_t(index + 1)), LU_TAG_ITERATOR);
-            getnodekey(L, ra + 3, n);
-            setobj(L, ra + 4, gval(n));
-
-            return true;
-        }
-
-        index++;
-    }
-
-    return false;
-}
-
 bool forgLoopNonTableFallback(lua_State* L, int insnA, int aux)
 {
     TValue* base = L->base;
@@ -188,6 +163,10 @@ Closure* callProlog(lua_State* L, TValue* ra, StkId argtop, int nresults)
     L->base = ci->base;
     L->top = argtop;
 
+    // native code can call into functions that are still interpreted, types they observe are recorded here
+    if (!ccl->isC && LUAU_UNLIKELY(ccl->l.p->argtypes != NULL))
+        luaV_profileargs(ccl->l.p, ra + 1, argtop);
+
     // note: this reallocs stack, but we don't need to VM_PROTECT this
     // this is because we're going to modify base/savedpc manually anyhow
     // crucially, we can't use ra/argtop after this line
@@ -275,6 +254,9 @@ Closure* callFallback(lua_State* L, StkId ra, StkId argtop, int nresults)
             setnilvalue(argi++); // complete missing arguments
         L->top = p->is_vararg ? argi : ci->top;
 
+        if (LUAU_UNLIKELY(p->argtypes != NULL))
+            luaV_profileargs(p, L->base, argend);
+
         // keep executing new function
         ci->savedpc = p->code;
 
@@ -383,6 +365,16 @@ const Instruction* executeGETTABLEKS(lua_State* L, const Instruction* pc, StkId
 
         if (!h->metatable)
         {
+            // fast-path: value is in the secondary expected slot of a polymorphic instruction
+            int polyslot = luaV_slotcache(cl->l.p, pc - 2);
+            LuaNode* pn = &h->node[polyslot & h->nodemask8];
+
+            if (polyslot >= 0 && ttisstring(gkey(pn)) && tsvalue(gkey(pn)) == tsvalue(kv) && !ttisnil(gval(pn)))
+            {
+                setobj2s(L, ra, gval(pn));
+                return pc;
+            }
+
             // fast-path: value is not in expected slot, but the table lookup doesn't involve metatable
             const TValue* res = luaH_getstr(h, tsvalue(kv));
 
@@ -390,15 +382,23 @@ const Instruction* executeGETTABLEKS(lua_State* L, const Instruction* pc, StkId
             {
                 int cachedslot = gval2slot(h, res);
                 // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-                VM_PATCH_C(pc - 2, cachedslot);
+                VM_PROTECT(luaV_patchslot(L, cl->l.p, pc - 2, cachedslot));
+                ra = VM_REG(LUAU_INSN_A(insn));
             }
 
             setobj2s(L, ra, res);
             return pc;
         }
+        // fast-path: value is at the end of a chain of __index tables that was resolved before
+        else if (const TValue* res = luaV_indexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)))
+        {
+            setobj2s(L, ra, res);
+            return pc;
+        }
         else
         {
             // slow-path, may invoke Lua calls via __index metamethod
+            VM_PROTECT(luaV_cacheindexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)));
             int slot = LUAU_INSN_C(insn) & h->nodemask8;
             L->cachedslot = slot;
             VM_PROTECT(luaV_gettable(L, rb, kv, ra));
@@ -559,14 +559,47 @@ const Instruction* executeNAMECALL(lua_State* L, const Instruction* pc, StkId ba
     if (ttistable(rb))
     {
         // note: lvmexecute.cpp version of NAMECALL has two fast paths, but both fast paths are inlined into IR
-        // as such, if we get here we can just use the generic path which makes the fallback path a little faster
+        // as such, if we get here we only need to check the secondary slot of a polymorphic call site before using the generic path
+        Table* h = hvalue(rb);
+        LuaNode* n = &h->node[tsvalue(kv)->hash & (sizenode(h) - 1)];
+        int polyslot = luaV_slotcache(cl->l.p, pc - 2);
+
+        const TValue* mt = 0;
+        const LuaNode* mtn = 0;
+
+        // note: long strings aren't interned, so a key mismatch in the main position doesn't prove that a long key is absent
+        if (polyslot >= 0 && isshortstr(tsvalue(kv)) && gnext(n) == 0 && !(ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv)) &&
+            (mt = fasttm(L, h->metatable, TM_INDEX)) && ttistable(mt) && (mtn = &hvalue(mt)->node[polyslot & hvalue(mt)->nodemask8]) &&
+            ttisstring(gkey(mtn)) && tsvalue(gkey(mtn)) == tsvalue(kv) && !ttisnil(gval(mtn)))
+        {
+            // note: order of copies allows rb to alias ra+1 or ra
+            setobj2s(L, ra + 1, rb);
+            setobj2s(L, ra, gval(mtn));
+
+            // intentional fallthrough to CALL
+            LUAU_ASSERT(LUAU_INSN_OP(*pc) == LOP_CALL);
+            return pc;
+        }
+
+        // fast-path: the result is at the end of a chain of __index tables that was resolved before
+        if (const TValue* res = luaV_indexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)))
+        {
+            // note: order of copies allows rb to alias ra+1 or ra
+            setobj2s(L, ra + 1, rb);
+            setobj2s(L, ra, res);
+
+            // intentional fallthrough to CALL
+            LUAU_ASSERT(LUAU_INSN_OP(*pc) == LOP_CALL);
+            return pc;
+        }
 
         // slow-path: handles full table lookup
         setobj2s(L, ra + 1, rb);
+        VM_PROTECT(luaV_cacheindexchain(L, cl->l.p, pc - 2, ra + 1, tsvalue(kv)));
         L->cachedslot = LUAU_INSN_C(insn);
         VM_PROTECT(luaV_gettable(L, rb, kv, ra));
         // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-        VM_PATCH_C(pc - 2, L->cachedslot);
+        VM_PROTECT(luaV_patchslot(L, cl->l.p, pc - 2, L->cachedslot));
         // recompute ra since stack might have been reallocated
         ra = VM_REG(LUAU_INSN_A(insn));
         if (ttisnil(ra))
@@ -592,6 +625,9 @@ const Instruction* executeNAMECALL(lua_State* L, const Instruction* pc, StkId ba
             int slot = LUAU_INSN_C(insn) & h->nodemask8;
             LuaNode* n = &h->node[slot];
 
+            int polyslot = luaV_slotcache(cl->l.p, pc - 2);
+            LuaNode* pn = &h->node[polyslot & h->nodemask8];
+
             // fast-path: metatable with __index that has method in expected slot
             if (LUAU_LIKELY(ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv) && !ttisnil(gval(n))))
             {
@@ -599,14 +635,29 @@ const Instruction* executeNAMECALL(lua_State* L, const Instruction* pc, StkId ba
                 setobj2s(L, ra + 1, rb);
                 setobj2s(L, ra, gval(n));
             }
+            // fast-path: method is in the secondary expected slot of a polymorphic call site
+            else if (polyslot >= 0 && ttisstring(gkey(pn)) && tsvalue(gkey(pn)) == tsvalue(kv) && !ttisnil(gval(pn)))
+            {
+                // note: order of copies allows rb to alias ra+1 or ra
+                setobj2s(L, ra + 1, rb);
+                setobj2s(L, ra, gval(pn));
+            }
+            // fast-path: method is at the end of a chain of __index tables that was resolved before
+            else if (const TValue* res = luaV_indexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)))
+            {
+                // note: order of copies allows rb to alias ra+1 or ra
+                setobj2s(L, ra + 1, rb);
+                setobj2s(L, ra, res);
+            }
             else
             {
                 // slow-path: handles slot mismatch
                 setobj2s(L, ra + 1, rb);
+                VM_PROTECT(luaV_cacheindexchain(L, cl->l.p, pc - 2, ra + 1, tsvalue(kv)));
                 L->cachedslot = slot;
                 VM_PROTECT(luaV_gettable(L, rb, kv, ra));
                 // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-                VM_PATCH_C(pc - 2, L->cachedslot);
+                VM_PROTECT(luaV_patchslot(L, cl->l.p, pc - 2, L->cachedslot));
                 // recompute ra since stack might have been reallocated
                 ra = VM_REG(LUAU_INSN_A(insn));
                 if (ttisnil(ra))
@@ -9,7 +9,6 @@ namespace CodeGen
 {
 
 bool forgLoopTableIter(lua_State* L, Table* h, int index, TValue* ra);
-bool forgLoopNodeIter(lua_State* L, Table* h, int index, TValue* ra);
 bool forgLoopNonTableFallback(lua_State* L, int insnA, int aux);
 
 void forgPrepXnextFallback(lua_State* L, TValue* ra, int pc);
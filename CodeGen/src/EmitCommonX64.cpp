@@ -347,7 +347,7 @@ void emitInterrupt(AssemblyBuilderX64& build)
     RegisterX64 rArg1 = (build.abi == ABIX64::Windows) ? rcx : rdi;
     RegisterX64 rArg2 = (build.abi == ABIX64::Windows) ? rdx : rsi;
 
-    Label skip;
+    Label skip, exhausted;
 
     // Update L->ci->savedpc; required in case interrupt errors
     build.mov(rcx, sCode);
@@ -361,6 +361,14 @@ void emitInterrupt(AssemblyBuilderX64& build)
     build.test(rax, rax);
     build.jcc(ConditionX64::Zero, skip);
 
+    // Consume the interrupt budget; the interrupt is only called once it runs out
+    build.cmp(dword[rState + offsetof(lua_State, interruptbudget)], 0);
+    build.jcc(ConditionX64::LessEqual, exhausted);
+    build.sub(dword[rState + offsetof(lua_State, interruptbudget)], 1);
+    build.jcc(ConditionX64::NotZero, skip);
+
+    build.setLabel(exhausted);
+
     // Call interrupt
     build.mov(rArg1, rState);
     build.mov(dwordReg(rArg2), -1);
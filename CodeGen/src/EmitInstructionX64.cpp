@@ -361,17 +361,11 @@ void emitInstForGLoop(AssemblyBuilderX64& build, int ra, int aux, Label& loopRep
     // ipairs-style traversal is handled in IR
     CODEGEN_ASSERT(aux >= 0);
 
-    // TODO: This should use IrCallWrapperX64
-    RegisterX64 rArg1 = (build.abi == ABIX64::Windows) ? rcx : rdi;
-    RegisterX64 rArg2 = (build.abi == ABIX64::Windows) ? rdx : rsi;
-    RegisterX64 rArg3 = (build.abi == ABIX64::Windows) ? r8 : rdx;
-    RegisterX64 rArg4 = (build.abi == ABIX64::Windows) ? r9 : rcx;
-
     // This is a fast-path for builtin table iteration, tag check for 'ra' has to be performed before emitting this instruction
 
-    // Registers are chosen in this way to simplify fallback code for the node part
-    RegisterX64 table = rArg2;
-    RegisterX64 index = rArg3;
+    // Only volatile registers are used and rcx is kept free for the node count shift
+    RegisterX64 table = rdx;
+    RegisterX64 index = r8;
     RegisterX64 elemPtr = rax;
 
     build.mov(table, luauRegValue(ra + 1));
@@ -423,13 +417,56 @@ void emitInstForGLoop(AssemblyBuilderX64& build, int ra, int aux, Label& loopRep
 
     build.setLabel(skipArray);
 
-    // Call helper to assign next node value or to signal loop exit
-    build.mov(rArg1, rState);
-    // rArg2 and rArg3 are already set
-    build.lea(rArg4, luauRegAddress(ra));
-    build.call(qword[rNativeContext + offsetof(NativeContext, forgLoopNodeIter)]);
-    build.test(al, al);
-    build.jcc(ConditionX64::NotZero, loopRepeat);
+    // Then we advance index through the hash portion
+    RegisterX64 sizenode = r10;
+    RegisterX64 nodeIndex = r11;
+
+    // Custom bit shift value can only be placed in cl
+    build.mov(byteReg(rcx), byte[table + offsetof(Table, lsizenode)]);
+    build.mov(dwordReg(sizenode), 1);
+    build.shl(dwordReg(sizenode), byteReg(rcx));
+
+    build.mov(dwordReg(nodeIndex), dwordReg(index));
+    build.sub(dwordReg(nodeIndex), dword[table + offsetof(Table, sizearray)]);
+
+    // &node[index - sizearray]
+    build.mov(dwordReg(elemPtr), dwordReg(nodeIndex));
+    build.shl(elemPtr, kLuaNodeSizeLog2);
+    build.add(elemPtr, qword[table + offsetof(Table, node)]);
+
+    Label skipNode, skipNodeNil;
+
+    // while (unsigned(index - sizearray) < unsigned(sizenode))
+    Label nodeLoop = build.setLabel();
+    build.cmp(dwordReg(nodeIndex), dwordReg(sizenode));
+    build.jcc(ConditionX64::NotBelow, skipNode);
+
+    build.inc(index);
+    build.inc(dwordReg(nodeIndex));
+
+    // Nodes with dead keys always have a nil value, so they are skipped together with the empty ones
+    build.cmp(dword[elemPtr + offsetof(LuaNode, val) + offsetof(TValue, tt)], LUA_TNIL);
+    build.jcc(ConditionX64::Equal, skipNodeNil);
+
+    // setpvalue(ra + 2, reinterpret_cast<void*>(uintptr_t(index + 1)), LU_TAG_ITERATOR);
+    build.mov(luauRegValue(ra + 2), index);
+
+    // getnodekey(L, ra + 3, n);
+    setLuauReg(build, xmm0, ra + 3, xmmword[elemPtr + offsetof(LuaNode, key)]);
+    build.and_(luauRegTag(ra + 3), kTKeyTagMask); // TKey.tt is packed together with TKey.next
+
+    // setobj(L, ra + 4, gval(n));
+    setLuauReg(build, xmm2, ra + 4, xmmword[elemPtr + offsetof(LuaNode, val)]);
+
+    build.jmp(loopRepeat);
+
+    build.setLabel(skipNodeNil);
+
+    // Index already incremented, advance to next node
+    build.add(elemPtr, sizeof(LuaNode));
+    build.jmp(nodeLoop);
+
+    build.setLabel(skipNode);
 }
 
 } // namespace X64
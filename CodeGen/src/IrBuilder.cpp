@@ -13,6 +13,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 LUAU_FASTFLAG(LuauLoadUserdataInfo)
 LUAU_FASTFLAG(LuauCodegenInstG)
 LUAU_FASTFLAG(LuauCodegenFastcall3)
@@ -30,11 +32,27 @@ IrBuilder::IrBuilder(const HostIrHooks& hostHooks)
 {
 }
 
+// Argument type annotations take priority over the types observed at runtime
+static uint8_t getCheckedArgumentType(const BytecodeTypeInfo& typeInfo, size_t i)
+{
+    uint8_t et = i < typeInfo.argumentTypes.size() ? typeInfo.argumentTypes[i] : LBC_TYPE_ANY;
+
+    if (et == LBC_TYPE_ANY && i < typeInfo.observedArgumentTypes.size())
+        return typeInfo.observedArgumentTypes[i];
+
+    return et;
+}
+
+static size_t getCheckedArgumentCount(const BytecodeTypeInfo& typeInfo)
+{
+    return std::max(typeInfo.argumentTypes.size(), typeInfo.observedArgumentTypes.size());
+}
+
 static bool hasTypedParameters(const BytecodeTypeInfo& typeInfo)
 {
-    for (auto el : typeInfo.argumentTypes)
+    for (size_t i = 0; i < getCheckedArgumentCount(typeInfo); i++)
     {
-        if (el != LBC_TYPE_ANY)
+        if (getCheckedArgumentType(typeInfo, i) != LBC_TYPE_ANY)
             return true;
     }
 
@@ -46,9 +64,11 @@ static void buildArgumentTypeChecks(IrBuilder& build)
     const BytecodeTypeInfo& typeInfo = build.function.bcTypeInfo;
     CODEGEN_ASSERT(hasTypedParameters(typeInfo));
 
-    for (size_t i = 0; i < typeInfo.argumentTypes.size(); i++)
+    size_t count = getCheckedArgumentCount(typeInfo);
+
+    for (size_t i = 0; i < count; i++)
     {
-        uint8_t et = typeInfo.argumentTypes[i];
+        uint8_t et = getCheckedArgumentType(typeInfo, i);
 
         uint8_t tag = et & ~LBC_TYPE_OPTIONAL_BIT;
         uint8_t optional = et & LBC_TYPE_OPTIONAL_BIT;
@@ -124,7 +144,7 @@ static void buildArgumentTypeChecks(IrBuilder& build)
     }
 
     // If the last argument is optional, we can skip creating a new internal block since one will already have been created.
-    if (!(typeInfo.argumentTypes.back() & LBC_TYPE_OPTIONAL_BIT))
+    if (!(getCheckedArgumentType(typeInfo, count - 1) & LBC_TYPE_OPTIONAL_BIT))
     {
         IrOp next = build.block(IrBlockKind::Internal);
         build.inst(IrCmd::JUMP, next);
@@ -521,7 +541,10 @@ void IrBuilder::translateInst(LuauOpcode op, const Instruction* pc, int i)
         translateInstOrX(*this, pc, i, vmConst(LUAU_INSN_C(*pc)));
         break;
     case LOP_COVERAGE:
-        inst(IrCmd::COVERAGE, constUint(i));
+        if (coverageHitOnly)
+            inst(IrCmd::COVERAGE, constUint(i), constInt(1));
+        else
+            inst(IrCmd::COVERAGE, constUint(i));
         break;
     case LOP_GETIMPORT:
         translateInstGetImport(*this, pc, i);
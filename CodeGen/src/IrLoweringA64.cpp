@@ -24,6 +24,10 @@ namespace CodeGen
 namespace A64
 {
 
+// global_State fields are loaded with a scaled immediate offset from rGlobalState, so they have to be placed early in the structure
+static_assert(offsetof(global_State, cb.interrupt) <= AddressA64::kMaxOffset * sizeof(void*), "interrupt callback is out of load range");
+static_assert(offsetof(global_State, tmname[TM_N - 1]) <= AddressA64::kMaxOffset * sizeof(TString*), "tag method names are out of load range");
+
 inline ConditionA64 getConditionFP(IrCondition cond)
 {
     switch (cond)
@@ -277,7 +281,7 @@ IrLoweringA64::IrLoweringA64(AssemblyBuilderA64& build, ModuleHelpers& helpers,
     , helpers(helpers)
     , function(function)
     , stats(stats)
-    , regs(function, stats, {{x0, x15}, {x16, x17}, {q0, q7}, {q16, q31}})
+    , regs(build, function, stats, {{x0, x15}, {x16, x17}, {q0, q7}, {q16, q31}})
     , valueTracker(function)
     , exitHandlerMap(~0u)
 {
@@ -289,6 +293,8 @@ IrLoweringA64::IrLoweringA64(AssemblyBuilderA64& build, ModuleHelpers& helpers,
 
 void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
 {
+    regs.prepareInst(index);
+
     valueTracker.beforeInstLowering(inst);
 
     switch (inst.cmd)
@@ -751,6 +757,24 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.fneg(inst.regA64, regOp(inst.a));
         break;
     }
+    case IrCmd::DOT_VEC:
+    {
+        inst.regA64 = regs.allocReg(KindA64::d, index);
+
+        RegisterA64 temp = regs.allocTemp(KindA64::q);
+        RegisterA64 temps = castReg(KindA64::s, temp);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::s);
+        RegisterA64 results = castReg(KindA64::s, inst.regA64);
+
+        // x*x + y*y + z*z, summed in order to match the interpreter
+        build.fmul(temp, regOp(inst.a), regOp(inst.b));
+        build.dup_4s(results, temp, 1);
+        build.fadd(results, temps, results);
+        build.dup_4s(temp2, temp, 2);
+        build.fadd(results, results, temp2);
+        build.fcvt(inst.regA64, results);
+        break;
+    }
     case IrCmd::NOT_ANY:
     {
         inst.regA64 = regs.allocReuse(KindA64::w, index, {inst.a, inst.b});
@@ -893,7 +917,12 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     {
         IrCondition cond = conditionOp(inst.c);
 
-        if (cond == IrCondition::Equal && intOp(inst.b) == 0)
+        if (inst.b.kind == IrOpKind::Inst)
+        {
+            build.cmp(regOp(inst.a), regOp(inst.b));
+            build.b(getConditionInt(cond), labelOp(inst.d));
+        }
+        else if (cond == IrCondition::Equal && intOp(inst.b) == 0)
         {
             build.cbz(regOp(inst.a), labelOp(inst.d));
         }
@@ -901,12 +930,18 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         {
             build.cbnz(regOp(inst.a), labelOp(inst.d));
         }
-        else
+        else if (unsigned(intOp(inst.b)) <= AssemblyBuilderA64::kMaxImmediate)
         {
-            CODEGEN_ASSERT(unsigned(intOp(inst.b)) <= AssemblyBuilderA64::kMaxImmediate);
             build.cmp(regOp(inst.a), uint16_t(intOp(inst.b)));
             build.b(getConditionInt(cond), labelOp(inst.d));
         }
+        else
+        {
+            RegisterA64 temp = regs.allocTemp(KindA64::w);
+            build.mov(temp, intOp(inst.b));
+            build.cmp(regOp(inst.a), temp);
+            build.b(getConditionInt(cond), labelOp(inst.d));
+        }
         jumpOrFallthrough(blockOp(inst.e), next);
         break;
     }
@@ -965,13 +1000,77 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     // IrCmd::JUMP_SLOT_MATCH implemented below
     case IrCmd::TABLE_LEN:
     {
+        Label slow, prevnil, update, found, done;
+
         RegisterA64 reg = regOp(inst.a); // note: we need to call regOp before spill so that we don't do redundant reloads
-        regs.spill(build, index, {reg});
+        RegisterA64 boundary = regs.allocTemp(KindA64::w);
+        RegisterA64 temp = regs.allocTemp(KindA64::x);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::w);
+
+        // Boundary cached by luaH_getn is stored negated in 'aboundary'
+        build.ldr(boundary, mem(reg, offsetof(Table, aboundary)));
+        build.neg(boundary, boundary);
+        build.cmp(boundary, uint16_t(0));
+        build.b(ConditionA64::LessEqual, slow);
+        build.ldr(temp2, mem(reg, offsetof(Table, sizearray)));
+        build.cmp(boundary, temp2);
+        build.b(ConditionA64::GreaterEqual, slow);
+
+        // If the last array element is not nil, luaH_getn might return the array size instead
+        build.ldr(temp, mem(reg, offsetof(Table, array)));
+        build.add(temp, temp, temp2, kTValueSizeLog2); // implicit uxtw
+        build.ldr(temp2, mem(temp, -int(sizeof(TValue)) + int(offsetof(TValue, tt))));
+        build.cmp(temp2, LUA_TNIL);
+        build.b(ConditionA64::NotEqual, slow);
+
+        build.ldr(temp, mem(reg, offsetof(Table, array)));
+        build.add(temp, temp, boundary, kTValueSizeLog2); // implicit uxtw
+
+        // Cached boundary is still valid if array[boundary - 1] is not nil and array[boundary] is nil
+        build.ldr(temp2, mem(temp, -int(sizeof(TValue)) + int(offsetof(TValue, tt))));
+        build.cmp(temp2, LUA_TNIL);
+        build.b(ConditionA64::Equal, prevnil);
+        build.ldr(temp2, mem(temp, offsetof(TValue, tt)));
+        build.cmp(temp2, LUA_TNIL);
+        build.b(ConditionA64::Equal, found);
+
+        // An element was appended at the boundary; array[boundary + 1] is within the array since the last element is nil
+        build.ldr(temp2, mem(temp, sizeof(TValue) + offsetof(TValue, tt)));
+        build.cmp(temp2, LUA_TNIL);
+        build.b(ConditionA64::NotEqual, slow);
+        build.add(boundary, boundary, uint16_t(1));
+        build.b(update);
+
+        // An element was removed at the boundary
+        build.setLabel(prevnil);
+        build.cmp(boundary, uint16_t(2));
+        build.b(ConditionA64::Less, slow);
+        build.ldr(temp2, mem(temp, -2 * int(sizeof(TValue)) + int(offsetof(TValue, tt))));
+        build.cmp(temp2, LUA_TNIL);
+        build.b(ConditionA64::Equal, slow);
+        build.sub(boundary, boundary, uint16_t(1));
+
+        build.setLabel(update);
+        build.neg(temp2, boundary);
+        build.str(temp2, mem(reg, offsetof(Table, aboundary)));
+
+        build.setLabel(found);
+        build.str(boundary, sTemporary);
+        build.b(done);
+
+        build.setLabel(slow);
+        size_t spills = regs.spill(build, index, {reg});
         build.mov(x0, reg);
         build.ldr(x1, mem(rNativeContext, offsetof(NativeContext, luaH_getn)));
         build.blr(x1);
+        build.str(w0, sTemporary);
 
-        inst.regA64 = regs.takeReg(w0, index);
+        regs.restore(build, spills); // need to restore before done so that registers are in a consistent state
+
+        build.setLabel(done);
+
+        inst.regA64 = regs.allocReg(KindA64::w, index);
+        build.ldr(inst.regA64, sTemporary);
         break;
     }
     case IrCmd::STRING_LEN:
@@ -2005,6 +2104,19 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         break;
     case IrCmd::COVERAGE:
     {
+        if (inst.b.kind != IrOpKind::None)
+        {
+            RegisterA64 temp1 = regs.allocTemp(KindA64::x);
+            RegisterA64 temp2 = regs.allocTemp(KindA64::w);
+
+            // sets the lowest bit of E; hit counts recorded by the interpreter are kept and there is no overflow check
+            build.mov(temp1, uintOp(inst.a) * sizeof(Instruction));
+            build.ldr(temp2, mem(rCode, temp1));
+            build.orr(temp2, temp2, 1 << 8);
+            build.str(temp2, mem(rCode, temp1));
+            break;
+        }
+
         RegisterA64 temp1 = regs.allocTemp(KindA64::x);
         RegisterA64 temp2 = regs.allocTemp(KindA64::w);
         RegisterA64 temp3 = regs.allocTemp(KindA64::w);
@@ -2688,10 +2800,10 @@ AddressA64 IrLoweringA64::tempAddr(IrOp op, int offset)
 
 AddressA64 IrLoweringA64::tempAddrBuffer(IrOp bufferOp, IrOp indexOp, uint8_t tag)
 {
-    if (FFlag::LuauCodegenUserdataOps)
+    if (FFlag::LuauCodegenUserdataOps || tag == LUA_TSTRING)
     {
-        CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER);
-        int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : offsetof(Udata, data);
+        CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER || tag == LUA_TSTRING);
+        int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : tag == LUA_TSTRING ? offsetof(TString, data) : offsetof(Udata, data);
 
         if (indexOp.kind == IrOpKind::Inst)
         {
@@ -677,6 +677,26 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.vxorpd(inst.regX64, regOp(inst.a), build.f32x4(-0.0, -0.0, -0.0, -0.0));
         break;
     }
+    case IrCmd::DOT_VEC:
+    {
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        ScopedRegX64 tmp1{regs};
+        ScopedRegX64 tmp2{regs};
+        ScopedRegX64 tmp3{regs, SizeX64::xmmword};
+
+        RegisterX64 tmpa = vecOp(inst.a, tmp1);
+        RegisterX64 tmpb = (inst.a == inst.b) ? tmpa : vecOp(inst.b, tmp2);
+
+        // x*x + y*y + z*z, with lanes y and z shuffled into the low lane one by one
+        build.vmulps(inst.regX64, tmpa, tmpb);
+        build.vpshufps(tmp3.reg, inst.regX64, inst.regX64, 0b00'00'00'01);
+        build.vaddss(tmp3.reg, inst.regX64, tmp3.reg);
+        build.vpshufps(inst.regX64, inst.regX64, inst.regX64, 0b00'00'00'10);
+        build.vaddss(inst.regX64, tmp3.reg, inst.regX64);
+        build.vcvtss2sd(inst.regX64, inst.regX64, inst.regX64);
+        break;
+    }
     case IrCmd::NOT_ANY:
     {
         // TODO: if we have a single user which is a STORE_INT, we are missing the opportunity to write directly to target
@@ -780,7 +800,7 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     {
         IrCondition cond = conditionOp(inst.c);
 
-        if ((cond == IrCondition::Equal || cond == IrCondition::NotEqual) && intOp(inst.b) == 0)
+        if ((cond == IrCondition::Equal || cond == IrCondition::NotEqual) && inst.b.kind == IrOpKind::Constant && intOp(inst.b) == 0)
         {
             bool invert = cond == IrCondition::NotEqual;
 
@@ -799,7 +819,10 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         }
         else
         {
-            build.cmp(regOp(inst.a), intOp(inst.b));
+            if (inst.b.kind == IrOpKind::Inst)
+                build.cmp(regOp(inst.a), regOp(inst.b));
+            else
+                build.cmp(regOp(inst.a), intOp(inst.b));
 
             build.jcc(getConditionInt(cond), labelOp(inst.d));
             jumpOrFallthrough(blockOp(inst.e), next);
@@ -854,10 +877,78 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     }
     case IrCmd::TABLE_LEN:
     {
-        IrCallWrapperX64 callWrap(regs, build, index);
-        callWrap.addArgument(SizeX64::qword, regOp(inst.a), inst.a);
-        callWrap.call(qword[rNativeContext + offsetof(NativeContext, luaH_getn)]);
-        inst.regX64 = regs.takeReg(eax, index);
+        Label slow, prevnil, update, found, done;
+
+        {
+            ScopedRegX64 boundary{regs, SizeX64::dword};
+            ScopedRegX64 tmp{regs, SizeX64::qword};
+
+            RegisterX64 table = regOp(inst.a);
+
+            // Boundary cached by luaH_getn is stored negated in 'aboundary'
+            build.mov(boundary.reg, dword[table + offsetof(Table, aboundary)]);
+            build.neg(boundary.reg);
+            build.jcc(ConditionX64::LessEqual, slow);
+            build.cmp(boundary.reg, dword[table + offsetof(Table, sizearray)]);
+            build.jcc(ConditionX64::GreaterEqual, slow);
+
+            // If the last array element is not nil, luaH_getn might return the array size instead
+            build.mov(dwordReg(tmp.reg), dword[table + offsetof(Table, sizearray)]);
+            build.shl(dwordReg(tmp.reg), kTValueSizeLog2);
+            build.add(tmp.reg, qword[table + offsetof(Table, array)]);
+            build.cmp(dword[tmp.reg - sizeof(TValue) + offsetof(TValue, tt)], LUA_TNIL);
+            build.jcc(ConditionX64::NotEqual, slow);
+
+            build.mov(dwordReg(tmp.reg), boundary.reg);
+            build.shl(dwordReg(tmp.reg), kTValueSizeLog2);
+            build.add(tmp.reg, qword[table + offsetof(Table, array)]);
+
+            // Cached boundary is still valid if array[boundary - 1] is not nil and array[boundary] is nil
+            build.cmp(dword[tmp.reg - sizeof(TValue) + offsetof(TValue, tt)], LUA_TNIL);
+            build.jcc(ConditionX64::Equal, prevnil);
+            build.cmp(dword[tmp.reg + offsetof(TValue, tt)], LUA_TNIL);
+            build.jcc(ConditionX64::Equal, found);
+
+            // An element was appended at the boundary; array[boundary + 1] is within the array since the last element is nil
+            build.cmp(dword[tmp.reg + sizeof(TValue) + offsetof(TValue, tt)], LUA_TNIL);
+            build.jcc(ConditionX64::NotEqual, slow);
+            build.inc(boundary.reg);
+            build.jmp(update);
+
+            // An element was removed at the boundary
+            build.setLabel(prevnil);
+            build.cmp(boundary.reg, 2);
+            build.jcc(ConditionX64::Less, slow);
+            build.cmp(dword[tmp.reg - 2 * sizeof(TValue) + offsetof(TValue, tt)], LUA_TNIL);
+            build.jcc(ConditionX64::Equal, slow);
+            build.dec(boundary.reg);
+
+            build.setLabel(update);
+            build.mov(dwordReg(tmp.reg), boundary.reg);
+            build.neg(dwordReg(tmp.reg));
+            build.mov(dword[table + offsetof(Table, aboundary)], dwordReg(tmp.reg));
+
+            build.setLabel(found);
+            build.mov(dword[sTemporarySlot + 0], boundary.reg);
+            build.jmp(done);
+        }
+
+        build.setLabel(slow);
+
+        {
+            ScopedSpills spillGuard(regs);
+
+            IrCallWrapperX64 callWrap(regs, build, index);
+            callWrap.addArgument(SizeX64::qword, regOp(inst.a), inst.a);
+            callWrap.call(qword[rNativeContext + offsetof(NativeContext, luaH_getn)]);
+
+            build.mov(dword[sTemporarySlot + 0], eax);
+        }
+
+        build.setLabel(done);
+
+        inst.regX64 = regs.allocReg(SizeX64::dword, index);
+        build.mov(inst.regX64, dword[sTemporarySlot + 0]);
         break;
     }
     case IrCmd::TABLE_SETNUM:
@@ -1572,6 +1663,16 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     }
     case IrCmd::COVERAGE:
     {
+        if (inst.b.kind != IrOpKind::None)
+        {
+            ScopedRegX64 tmp{regs, SizeX64::qword};
+
+            // sets the lowest bit of E; hit counts recorded by the interpreter are kept and there is no overflow check
+            build.mov(tmp.reg, sCode);
+            build.or_(dword[tmp.reg + uintOp(inst.a) * sizeof(Instruction)], 1 << 8);
+            break;
+        }
+
         ScopedRegX64 tmp1{regs, SizeX64::qword};
         ScopedRegX64 tmp2{regs, SizeX64::dword};
         ScopedRegX64 tmp3{regs, SizeX64::dword};
@@ -2269,10 +2370,10 @@ RegisterX64 IrLoweringX64::regOp(IrOp op)
 
 OperandX64 IrLoweringX64::bufferAddrOp(IrOp bufferOp, IrOp indexOp, uint8_t tag)
 {
-    if (FFlag::LuauCodegenUserdataOps)
+    if (FFlag::LuauCodegenUserdataOps || tag == LUA_TSTRING)
     {
-        CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER);
-        int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : offsetof(Udata, data);
+        CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER || tag == LUA_TSTRING);
+        int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : tag == LUA_TSTRING ? offsetof(TString, data) : offsetof(Udata, data);
 
         if (indexOp.kind == IrOpKind::Inst)
             return regOp(bufferOp) + qwordReg(regOp(indexOp)) + dataOffset;
@@ -22,6 +22,20 @@ namespace A64
 
 static const int8_t kInvalidSpill = 64;
 
+// Registers kept free before lowering each instruction; covers the largest number of registers a single instruction allocates
+static const int kReservedGprs = 5;
+static const int kReservedSimds = 3;
+
+static int countBits(uint32_t n)
+{
+    int result = 0;
+
+    for (; n; n &= n - 1)
+        result++;
+
+    return result;
+}
+
 static int allocSpill(uint32_t& free, KindA64 kind)
 {
     CODEGEN_ASSERT(kStackSize <= 256); // to support larger stack frames, we need to ensure qN is allocated at 16b boundary to fit in ldr/str encoding
@@ -111,8 +125,10 @@ static void restoreInst(AssemblyBuilderA64& build, uint32_t& freeSpillSlots, IrF
     inst.regA64 = reg;
 }
 
-IrRegAllocA64::IrRegAllocA64(IrFunction& function, LoweringStats* stats, std::initializer_list<std::pair<RegisterA64, RegisterA64>> regs)
-    : function(function)
+IrRegAllocA64::IrRegAllocA64(
+    AssemblyBuilderA64& build, IrFunction& function, LoweringStats* stats, std::initializer_list<std::pair<RegisterA64, RegisterA64>> regs)
+    : build(build)
+    , function(function)
     , stats(stats)
 {
     for (auto& p : regs)
@@ -141,6 +157,8 @@ RegisterA64 IrRegAllocA64::allocReg(KindA64 kind, uint32_t index)
 
     if (set.free == 0)
     {
+        // note: spilling here would emit code in the middle of the instruction, possibly on a conditional path; prepareInst keeps enough
+        // registers free for any single instruction, so running out here falls back to the interpreter
         error = true;
         return RegisterA64{kind, 0};
     }
@@ -162,6 +180,8 @@ RegisterA64 IrRegAllocA64::allocTemp(KindA64 kind)
 
     if (set.free == 0)
     {
+        // note: spilling here would emit code in the middle of the instruction, possibly on a conditional path; prepareInst keeps enough
+        // registers free for any single instruction, so running out here falls back to the interpreter
         error = true;
         return RegisterA64{kind, 0};
     }
@@ -178,6 +198,35 @@ RegisterA64 IrRegAllocA64::allocTemp(KindA64 kind)
     return RegisterA64{kind, uint8_t(reg)};
 }
 
+void IrRegAllocA64::prepareInst(uint32_t index)
+{
+    currInstIdx = index;
+
+    IrInst& inst = function.instructions[index];
+
+    // Restore spilled operands up front so that the lowering never reloads them inside conditional code
+    for (IrOp op : {inst.a, inst.b, inst.c, inst.d, inst.e, inst.f, inst.g})
+    {
+        if (op.kind != IrOpKind::Inst)
+            continue;
+
+        IrInst& arg = function.instOp(op);
+
+        if (arg.spilled || arg.needsReload)
+        {
+            RegisterA64 origin = findSpillOrigin(function.getInstIndex(arg));
+
+            if (!ensureFree(getSet(origin.kind), 1))
+                return;
+
+            restoreReg(build, arg);
+        }
+    }
+
+    ensureFree(gpr, kReservedGprs);
+    ensureFree(simd, kReservedSimds);
+}
+
 RegisterA64 IrRegAllocA64::allocReuse(KindA64 kind, uint32_t index, std::initializer_list<IrOp> oprefs)
 {
     for (IrOp op : oprefs)
@@ -326,49 +375,15 @@ size_t IrRegAllocA64::spill(AssemblyBuilderA64& build, uint32_t index, std::init
             if (def.lastUse == index)
             {
                 // instead of spilling the register to never reload it, we assume the register is not needed anymore
-            }
-            else if (getReloadAddress(function, def, /*limitToCurrentBlock*/ true).base != xzr)
-            {
-                // instead of spilling the register to stack, we can reload it from VM stack/constants
-                // we still need to record the spill for restore(start) to work
-                Spill s = {inst, def.regA64, -1};
-                spills.push_back(s);
-
-                def.needsReload = true;
-
-                if (stats)
-                    stats->spillsToRestore++;
+                freeReg(def.regA64);
+                def.regA64 = noreg;
             }
             else
             {
-                int slot = allocSpill(freeSpillSlots, def.regA64.kind);
-                if (slot < 0)
-                {
-                    slot = kInvalidSpill;
-                    error = true;
-                }
-
-                build.str(def.regA64, mem(sp, sSpillArea.data + slot * 8));
-
-                Spill s = {inst, def.regA64, int8_t(slot)};
-                spills.push_back(s);
-
-                def.spilled = true;
-
-                if (stats)
-                {
-                    stats->spillsToSlot++;
-
-                    if (slot != kInvalidSpill && unsigned(slot + 1) > stats->maxSpillSlotsUsed)
-                        stats->maxSpillSlotsUsed = slot + 1;
-                }
+                spillValue(set, reg);
             }
 
-            def.regA64 = noreg;
-
             regs &= ~(1u << reg);
-            set.free |= 1u << reg;
-            set.defs[reg] = kInvalidInstIdx;
         }
 
         CODEGEN_ASSERT(set.free == set.base);
@@ -428,6 +443,121 @@ void IrRegAllocA64::restoreReg(AssemblyBuilderA64& build, IrInst& inst)
     CODEGEN_ASSERT(!"Expected to find a spill record");
 }
 
+uint32_t IrRegAllocA64::findInstructionWithFurthestNextUse(const Set& set) const
+{
+    uint32_t furthestUseTarget = kInvalidInstIdx;
+    uint32_t furthestUseLocation = 0;
+    bool furthestUseReload = false;
+
+    for (int reg = 0; reg < 32; ++reg)
+    {
+        uint32_t regInstUser = set.defs[reg];
+
+        // Cannot spill free or temporary registers or the register of the value that's defined in the current instruction
+        if (regInstUser == kInvalidInstIdx || regInstUser == currInstIdx || currInstIdx == kInvalidInstIdx)
+            continue;
+
+        uint32_t nextUse = getNextInstUse(function, regInstUser, currInstIdx);
+
+        // Cannot spill value that is about to be used in the current instruction
+        if (nextUse == currInstIdx)
+            continue;
+
+        // Values that can be reloaded from VM stack/constants don't need a store, so they are preferred when next uses are equally far
+        bool reload = getReloadAddress(function, function.instructions[regInstUser], /*limitToCurrentBlock*/ true).base != xzr;
+
+        if (furthestUseTarget == kInvalidInstIdx || nextUse > furthestUseLocation || (nextUse == furthestUseLocation && reload && !furthestUseReload))
+        {
+            furthestUseLocation = nextUse;
+            furthestUseTarget = regInstUser;
+            furthestUseReload = reload;
+        }
+    }
+
+    return furthestUseTarget;
+}
+
+bool IrRegAllocA64::ensureFree(Set& set, int count)
+{
+    while (countBits(set.free) < count)
+    {
+        uint32_t target = findInstructionWithFurthestNextUse(set);
+
+        if (target == kInvalidInstIdx)
+            return false;
+
+        spillValue(set, function.instructions[target].regA64.index);
+    }
+
+    return true;
+}
+
+RegisterA64 IrRegAllocA64::findSpillOrigin(uint32_t index) const
+{
+    for (const Spill& s : spills)
+    {
+        if (s.inst == index)
+            return s.origin;
+    }
+
+    CODEGEN_ASSERT(!"Expected to find a spill record");
+    return noreg;
+}
+
+void IrRegAllocA64::spillValue(Set& set, int reg)
+{
+    uint32_t inst = set.defs[reg];
+    CODEGEN_ASSERT(inst != kInvalidInstIdx);
+
+    IrInst& def = function.instructions[inst];
+    CODEGEN_ASSERT(def.regA64.index == reg);
+    CODEGEN_ASSERT(!def.reusedReg);
+    CODEGEN_ASSERT(!def.spilled);
+    CODEGEN_ASSERT(!def.needsReload);
+
+    if (getReloadAddress(function, def, /*limitToCurrentBlock*/ true).base != xzr)
+    {
+        // instead of spilling the register to stack, we can reload it from VM stack/constants
+        // we still need to record the spill for restore(start) to work
+        Spill s = {inst, def.regA64, -1};
+        spills.push_back(s);
+
+        def.needsReload = true;
+
+        if (stats)
+            stats->spillsToRestore++;
+    }
+    else
+    {
+        int slot = allocSpill(freeSpillSlots, def.regA64.kind);
+        if (slot < 0)
+        {
+            slot = kInvalidSpill;
+            error = true;
+        }
+
+        build.str(def.regA64, mem(sp, sSpillArea.data + slot * 8));
+
+        Spill s = {inst, def.regA64, int8_t(slot)};
+        spills.push_back(s);
+
+        def.spilled = true;
+
+        if (stats)
+        {
+            stats->spillsToSlot++;
+
+            if (slot != kInvalidSpill && unsigned(slot + 1) > stats->maxSpillSlotsUsed)
+                stats->maxSpillSlotsUsed = slot + 1;
+        }
+    }
+
+    def.regA64 = noreg;
+
+    set.free |= 1u << reg;
+    set.defs[reg] = kInvalidInstIdx;
+}
+
 IrRegAllocA64::Set& IrRegAllocA64::getSet(KindA64 kind)
 {
     switch (kind)
@@ -22,8 +22,14 @@ class AssemblyBuilderA64;
 
 struct IrRegAllocA64
 {
-    IrRegAllocA64(IrFunction& function, LoweringStats* stats, std::initializer_list<std::pair<RegisterA64, RegisterA64>> regs);
+    IrRegAllocA64(
+        AssemblyBuilderA64& build, IrFunction& function, LoweringStats* stats, std::initializer_list<std::pair<RegisterA64, RegisterA64>> regs);
 
+    // Spills values with the furthest next use so that the instruction can be lowered without running out of registers
+    // All spills are emitted before the instruction code, never in the middle of it
+    void prepareInst(uint32_t index);
+
+    // When out of registers, returns an arbitrary register and sets the error flag to fall back to the interpreter
     RegisterA64 allocReg(KindA64 kind, uint32_t index);
     RegisterA64 allocTemp(KindA64 kind);
     RegisterA64 allocReuse(KindA64 kind, uint32_t index, std::initializer_list<IrOp> oprefs);
@@ -71,6 +77,12 @@ struct IrRegAllocA64
 
     Set& getSet(KindA64 kind);
 
+    uint32_t findInstructionWithFurthestNextUse(const Set& set) const;
+    bool ensureFree(Set& set, int count);
+    RegisterA64 findSpillOrigin(uint32_t index) const;
+    void spillValue(Set& set, int reg);
+
+    AssemblyBuilderA64& build;
     IrFunction& function;
     LoweringStats* stats = nullptr;
     Set gpr, simd;
@@ -81,6 +93,8 @@ struct IrRegAllocA64
     uint32_t freeSpillSlots = 0;
 
     bool error = false;
+
+    uint32_t currInstIdx = kInvalidInstIdx;
 };
 
 } // namespace A64
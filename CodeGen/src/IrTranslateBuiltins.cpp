@@ -2,6 +2,7 @@
 #include "IrTranslateBuiltins.h"
 
 #include "Luau/Bytecode.h"
+#include "Luau/CodeGen.h"
 #include "Luau/IrBuilder.h"
 
 #include "lstate.h"
@@ -700,7 +701,69 @@ static BuiltinImplResult translateBuiltinVector(IrBuilder& build, int nparams, i
     return {BuiltinImplType::Full, 1};
 }
 
-static BuiltinImplResult translateBuiltinTableInsert(IrBuilder& build, int nparams, int ra, int arg, IrOp args, int nresults, int pcpos)
+static BuiltinImplResult translateBuiltinVectorDot(IrBuilder& build, int nparams, int ra, int arg, IrOp args, int nresults, int pcpos)
+{
+    if (nparams < 2 || nresults > 1 || args.kind != IrOpKind::VmReg)
+        return {BuiltinImplType::None, -1};
+
+    CODEGEN_ASSERT(LUA_VECTOR_SIZE == 3);
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TVECTOR, build.vmExit(pcpos));
+    build.loadAndCheckTag(args, LUA_TVECTOR, build.vmExit(pcpos));
+
+    IrOp va = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(arg));
+    IrOp vb = build.inst(IrCmd::LOAD_TVALUE, args);
+    IrOp result = build.inst(IrCmd::DOT_VEC, va, vb);
+
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), result);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+
+    return {BuiltinImplType::Full, 1};
+}
+
+static BuiltinImplResult translateBuiltinVectorMagnitude(IrBuilder& build, int nparams, int ra, int arg, int nresults, int pcpos)
+{
+    if (nparams < 1 || nresults > 1)
+        return {BuiltinImplType::None, -1};
+
+    CODEGEN_ASSERT(LUA_VECTOR_SIZE == 3);
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TVECTOR, build.vmExit(pcpos));
+
+    IrOp va = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(arg));
+    IrOp sum = build.inst(IrCmd::DOT_VEC, va, va);
+    IrOp result = build.inst(IrCmd::SQRT_NUM, sum);
+
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), result);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+
+    return {BuiltinImplType::Full, 1};
+}
+
+static BuiltinImplResult translateBuiltinVectorNormalize(IrBuilder& build, int nparams, int ra, int arg, int nresults, int pcpos)
+{
+    if (nparams < 1 || nresults > 1)
+        return {BuiltinImplType::None, -1};
+
+    CODEGEN_ASSERT(LUA_VECTOR_SIZE == 3);
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TVECTOR, build.vmExit(pcpos));
+
+    IrOp va = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(arg));
+    IrOp sum = build.inst(IrCmd::DOT_VEC, va, va);
+    IrOp mag = build.inst(IrCmd::SQRT_NUM, sum);
+    IrOp inv = build.inst(IrCmd::DIV_NUM, build.constDouble(1.0), mag);
+    IrOp invvec = build.inst(IrCmd::NUM_TO_VEC, inv);
+
+    IrOp result = build.inst(IrCmd::MUL_VEC, va, invvec);
+    result = build.inst(IrCmd::TAG_VECTOR, result);
+
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), result);
+
+    return {BuiltinImplType::Full, 1};
+}
+
+static BuiltinImplResult translateBuiltinTableInsert(IrBuilder& build, int nparams, int ra, int arg, IrOp args, int nresults, IrOp fallback, int pcpos)
 {
     if (nparams != 2 || nresults > 0)
         return {BuiltinImplType::None, -1};
@@ -708,24 +771,26 @@ static BuiltinImplResult translateBuiltinTableInsert(IrBuilder& build, int npara
     build.loadAndCheckTag(build.vmReg(arg), LUA_TTABLE, build.vmExit(pcpos));
 
     IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(arg));
-    build.inst(IrCmd::CHECK_READONLY, table, build.vmExit(pcpos));
+    build.inst(IrCmd::CHECK_READONLY, table, fallback);
 
-    IrOp pos = build.inst(IrCmd::ADD_INT, build.inst(IrCmd::TABLE_LEN, table), build.constInt(1));
+    // Appended element goes directly into the array part when it has space, growing the table is left to the library function
+    IrOp len = build.inst(IrCmd::TABLE_LEN, table);
+    build.inst(IrCmd::CHECK_ARRAY_SIZE, table, len, fallback);
 
-    IrOp setnum = build.inst(IrCmd::TABLE_SETNUM, table, pos);
+    IrOp slot = build.inst(IrCmd::GET_ARR_ADDR, table, len);
 
     if (args.kind == IrOpKind::Constant)
     {
         CODEGEN_ASSERT(build.function.constOp(args).kind == IrConstKind::Double);
 
         // No barrier necessary since numbers aren't collectable
-        build.inst(IrCmd::STORE_DOUBLE, setnum, args);
-        build.inst(IrCmd::STORE_TAG, setnum, build.constTag(LUA_TNUMBER));
+        build.inst(IrCmd::STORE_DOUBLE, slot, args);
+        build.inst(IrCmd::STORE_TAG, slot, build.constTag(LUA_TNUMBER));
     }
     else
     {
         IrOp va = build.inst(IrCmd::LOAD_TVALUE, args);
-        build.inst(IrCmd::STORE_TVALUE, setnum, va);
+        build.inst(IrCmd::STORE_TVALUE, slot, va);
 
         // Compiler only generates FASTCALL*K for source-level constants, so dynamic imports are not affected
         CODEGEN_ASSERT(build.function.proto);
@@ -734,7 +799,32 @@ static BuiltinImplResult translateBuiltinTableInsert(IrBuilder& build, int npara
         build.inst(IrCmd::BARRIER_TABLE_FORWARD, table, args, argstag);
     }
 
-    return {BuiltinImplType::Full, 0};
+    return {BuiltinImplType::UsesFallback, 0};
+}
+
+static BuiltinImplResult translateBuiltinTableRemove(IrBuilder& build, int nparams, int ra, int arg, IrOp args, int nresults, IrOp fallback, int pcpos)
+{
+    if (nparams != 1 || nresults > 1)
+        return {BuiltinImplType::None, -1};
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TTABLE, build.vmExit(pcpos));
+
+    IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(arg));
+    build.inst(IrCmd::CHECK_READONLY, table, fallback);
+
+    // Only the last element of the array part is removed here; empty tables fail the size check as the index becomes -1
+    IrOp index = build.inst(IrCmd::SUB_INT, build.inst(IrCmd::TABLE_LEN, table), build.constInt(1));
+    build.inst(IrCmd::CHECK_ARRAY_SIZE, table, index, fallback);
+
+    IrOp slot = build.inst(IrCmd::GET_ARR_ADDR, table, index);
+
+    if (nresults != 0)
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), build.inst(IrCmd::LOAD_TVALUE, slot));
+
+    // No barrier necessary since nil isn't collectable
+    build.inst(IrCmd::STORE_TAG, slot, build.constTag(LUA_TNIL));
+
+    return {BuiltinImplType::UsesFallback, 1};
 }
 
 static BuiltinImplResult translateBuiltinStringLen(IrBuilder& build, int nparams, int ra, int arg, IrOp args, int nresults, int pcpos)
@@ -754,6 +844,36 @@ static BuiltinImplResult translateBuiltinStringLen(IrBuilder& build, int nparams
     return {BuiltinImplType::Full, 1};
 }
 
+static BuiltinImplResult translateBuiltinStringByte(IrBuilder& build, int nparams, int ra, int arg, IrOp args, int nresults, IrOp fallback, int pcpos)
+{
+    // Only the single character form is handled, other forms go through the builtin
+    if (nparams != 2 || nresults > 1)
+        return {BuiltinImplType::None, -1};
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TSTRING, build.vmExit(pcpos));
+    builtinCheckDouble(build, args, pcpos);
+
+    IrOp ts = build.inst(IrCmd::LOAD_POINTER, build.vmReg(arg));
+
+    IrOp numIndex = builtinLoadDouble(build, args);
+    IrOp index = build.inst(IrCmd::SUB_INT, build.inst(IrCmd::NUM_TO_INT, numIndex), build.constInt(1));
+
+    // Index outside of the string produces no results, which is left to the builtin
+    // Length is the first operand since a constant index folds to a constant, which can only be the second operand
+    IrOp len = build.inst(IrCmd::STRING_LEN, ts);
+
+    IrOp block = build.block(IrBlockKind::Internal);
+    build.inst(IrCmd::JUMP_CMP_INT, len, index, build.cond(IrCondition::UnsignedLessEqual), fallback, block);
+    build.beginBlock(block);
+
+    IrOp value = build.inst(IrCmd::BUFFER_READU8, ts, index, build.constTag(LUA_TSTRING));
+
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), build.inst(IrCmd::INT_TO_NUM, value));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+
+    return {BuiltinImplType::UsesFallback, 1};
+}
+
 static void translateBufferArgsAndCheckBounds(
     IrBuilder& build, int nparams, int arg, IrOp args, IrOp arg3, int size, int pcpos, IrOp& buf, IrOp& intIndex)
 {
@@ -897,9 +1017,13 @@ BuiltinImplResult translateBuiltin(
     case LBF_VECTOR:
         return translateBuiltinVector(build, nparams, ra, arg, args, arg3, nresults, pcpos);
     case LBF_TABLE_INSERT:
-        return translateBuiltinTableInsert(build, nparams, ra, arg, args, nresults, pcpos);
+        return translateBuiltinTableInsert(build, nparams, ra, arg, args, nresults, fallback, pcpos);
+    case LBF_TABLE_REMOVE:
+        return translateBuiltinTableRemove(build, nparams, ra, arg, args, nresults, fallback, pcpos);
     case LBF_STRING_LEN:
         return translateBuiltinStringLen(build, nparams, ra, arg, args, nresults, pcpos);
+    case LBF_STRING_BYTE:
+        return translateBuiltinStringByte(build, nparams, ra, arg, args, nresults, fallback, pcpos);
     case LBF_BIT32_BYTESWAP:
         return translateBuiltinBit32Unary(build, IrCmd::BYTESWAP_UINT, nparams, ra, arg, args, nresults, pcpos);
     case LBF_BUFFER_READI8:
@@ -928,7 +1052,17 @@ BuiltinImplResult translateBuiltin(
         return translateBuiltinBufferRead(build, nparams, ra, arg, args, arg3, nresults, pcpos, IrCmd::BUFFER_READF64, 8, IrCmd::NOP);
     case LBF_BUFFER_WRITEF64:
         return translateBuiltinBufferWrite(build, nparams, ra, arg, args, arg3, nresults, pcpos, IrCmd::BUFFER_WRITEF64, 8, IrCmd::NOP);
+    case LBF_VECTOR_MAGNITUDE:
+        return translateBuiltinVectorMagnitude(build, nparams, ra, arg, nresults, pcpos);
+    case LBF_VECTOR_NORMALIZE:
+        return translateBuiltinVectorNormalize(build, nparams, ra, arg, nresults, pcpos);
+    case LBF_VECTOR_DOT:
+        return translateBuiltinVectorDot(build, nparams, ra, arg, args, nresults, pcpos);
     default:
+        if (bfid >= LBF_HOST_FIRST && nresults != LUA_MULTRET && build.hostHooks.hostBuiltin &&
+            build.hostHooks.hostBuiltin(build, bfid - LBF_HOST_FIRST, ra, arg, args, arg3, nparams, nresults, pcpos))
+            return {BuiltinImplType::Full, nresults};
+
         return {BuiltinImplType::None, -1};
     }
 }
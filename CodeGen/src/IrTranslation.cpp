@@ -343,7 +343,23 @@ void translateInstJumpxEqS(IrBuilder& build, const Instruction* pc, int pcpos)
     IrOp va = build.inst(IrCmd::LOAD_POINTER, build.vmReg(ra));
     IrOp vb = build.inst(IrCmd::LOAD_POINTER, build.vmConst(aux & 0xffffff));
 
-    build.inst(IrCmd::JUMP_EQ_POINTER, va, vb, not_ ? next : target, not_ ? target : next);
+    TValue protok = build.function.proto->k[aux & 0xffffff];
+    CODEGEN_ASSERT(protok.tt == LUA_TSTRING);
+
+    // long strings are not interned, so different objects can still be equal; the interpreter handles the full comparison
+    if (tsvalue(&protok)->len > LUAI_MAXSHORTLEN)
+    {
+        IrOp exit = build.block(IrBlockKind::Fallback);
+
+        build.inst(IrCmd::JUMP_EQ_POINTER, va, vb, not_ ? next : target, exit);
+
+        build.beginBlock(exit);
+        build.inst(IrCmd::JUMP, build.vmExit(pcpos));
+    }
+    else
+    {
+        build.inst(IrCmd::JUMP_EQ_POINTER, va, vb, not_ ? next : target, not_ ? target : next);
+    }
 
     // Fallthrough in original bytecode is implicit, so we start next internal block here
     if (build.isInternalBlock(next))
@@ -661,6 +677,19 @@ void translateInstLength(IrBuilder& build, const Instruction* pc, int pcpos)
         return;
     }
 
+    // Length of a string never invokes metamethods; values of other types exit to the VM
+    if (bcTypes.a == LBC_TYPE_STRING)
+    {
+        build.loadAndCheckTag(build.vmReg(rb), LUA_TSTRING, build.vmExit(pcpos));
+
+        IrOp ts = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
+        IrOp len = build.inst(IrCmd::STRING_LEN, ts);
+
+        build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), build.inst(IrCmd::INT_TO_NUM, len));
+        build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+        return;
+    }
+
     IrOp fallback = build.block(IrBlockKind::Fallback);
 
     IrOp tb = build.inst(IrCmd::LOAD_TAG, build.vmReg(rb));
@@ -1535,25 +1564,33 @@ bool translateInstNamecall(IrBuilder& build, const Instruction* pc, int pcpos)
 
     build.beginBlock(secondFastPath);
 
-    build.inst(IrCmd::CHECK_NODE_NO_NEXT, addrNodeEl, fallback);
+    // long strings are not interned, so a slot mismatch doesn't prove that the key is absent from the table
+    if (tsvalue(&build.function.proto->k[aux])->len > LUAI_MAXSHORTLEN)
+    {
+        build.inst(IrCmd::JUMP, fallback);
+    }
+    else
+    {
+        build.inst(IrCmd::CHECK_NODE_NO_NEXT, addrNodeEl, fallback);
 
-    IrOp indexPtr = build.inst(IrCmd::TRY_CALL_FASTGETTM, table, build.constInt(TM_INDEX), fallback);
+        IrOp indexPtr = build.inst(IrCmd::TRY_CALL_FASTGETTM, table, build.constInt(TM_INDEX), fallback);
 
-    build.loadAndCheckTag(indexPtr, LUA_TTABLE, fallback);
-    IrOp index = build.inst(IrCmd::LOAD_POINTER, indexPtr);
+        build.loadAndCheckTag(indexPtr, LUA_TTABLE, fallback);
+        IrOp index = build.inst(IrCmd::LOAD_POINTER, indexPtr);
 
-    IrOp addrIndexNodeEl = build.inst(IrCmd::GET_SLOT_NODE_ADDR, index, build.constUint(pcpos), build.vmConst(aux));
-    build.inst(IrCmd::CHECK_SLOT_MATCH, addrIndexNodeEl, build.vmConst(aux), fallback);
+        IrOp addrIndexNodeEl = build.inst(IrCmd::GET_SLOT_NODE_ADDR, index, build.constUint(pcpos), build.vmConst(aux));
+        build.inst(IrCmd::CHECK_SLOT_MATCH, addrIndexNodeEl, build.vmConst(aux), fallback);
 
-    // TODO: original 'table' was clobbered by a call inside 'FASTGETTM'
-    // Ideally, such calls should have to effect on SSA IR values, but simple register allocator doesn't support it
-    IrOp table2 = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
-    build.inst(IrCmd::STORE_POINTER, build.vmReg(ra + 1), table2);
-    build.inst(IrCmd::STORE_TAG, build.vmReg(ra + 1), build.constTag(LUA_TTABLE));
+        // TODO: original 'table' was clobbered by a call inside 'FASTGETTM'
+        // Ideally, such calls should have to effect on SSA IR values, but simple register allocator doesn't support it
+        IrOp table2 = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
+        build.inst(IrCmd::STORE_POINTER, build.vmReg(ra + 1), table2);
+        build.inst(IrCmd::STORE_TAG, build.vmReg(ra + 1), build.constTag(LUA_TTABLE));
 
-    IrOp indexNodeEl = build.inst(IrCmd::LOAD_TVALUE, addrIndexNodeEl, build.constInt(offsetof(LuaNode, val)));
-    build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), indexNodeEl);
-    build.inst(IrCmd::JUMP, next);
+        IrOp indexNodeEl = build.inst(IrCmd::LOAD_TVALUE, addrIndexNodeEl, build.constInt(offsetof(LuaNode, val)));
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), indexNodeEl);
+        build.inst(IrCmd::JUMP, next);
+    }
 
     build.beginBlock(fallback);
     build.inst(IrCmd::FALLBACK_NAMECALL, build.constUint(pcpos), build.vmReg(ra), build.vmReg(rb), build.vmConst(aux));
@@ -86,7 +86,6 @@ void initFunctions(NativeContext& context)
     context.libm_tanh = tanh;
 
     context.forgLoopTableIter = forgLoopTableIter;
-    context.forgLoopNodeIter = forgLoopNodeIter;
     context.forgLoopNonTableFallback = forgLoopNonTableFallback;
     context.forgPrepXnextFallback = forgPrepXnextFallback;
     context.callProlog = callProlog;
@@ -2,14 +2,18 @@
 #include "Luau/OptimizeConstProp.h"
 
 #include "Luau/DenseHash.h"
+#include "Luau/IrAnalysis.h"
 #include "Luau/IrData.h"
 #include "Luau/IrBuilder.h"
 #include "Luau/IrUtils.h"
+#include "Luau/IrVisitUseDef.h"
 
 #include "lua.h"
+#include "lobject.h"
 
 #include <limits.h>
 
+#include <algorithm>
 #include <array>
 #include <utility>
 #include <vector>
@@ -185,6 +189,9 @@ struct ConstPropState
     {
         valueMap.clear();
         tryNumToIndexCache.clear();
+
+        // Values stored into table slots are forwarded to later loads as SSA values
+        nodeSlotStoreCache.clear();
     }
 
     // If table memory has changed, we can't reuse previously computed and validated table slot lookups
@@ -193,6 +200,7 @@ struct ConstPropState
     {
         getSlotNodeCache.clear();
         checkSlotMatchCache.clear();
+        nodeSlotStoreCache.clear();
 
         getArrAddrCache.clear();
         checkArraySizeCache.clear();
@@ -452,6 +460,7 @@ struct ConstPropState
     // Heap changes might affect table state
     std::vector<uint32_t> getSlotNodeCache;    // Additionally, pcpos argument might be different
     std::vector<uint32_t> checkSlotMatchCache; // Additionally, fallback block argument might be different
+    std::vector<uint32_t> nodeSlotStoreCache;  // Stores into slots verified by CHECK_SLOT_MATCH
 
     std::vector<uint32_t> getArrAddrCache;
     std::vector<uint32_t> checkArraySizeCache; // Additionally, fallback block argument might be different
@@ -542,11 +551,25 @@ static void handleBuiltinEffects(ConstPropState& state, LuauBuiltinFunction bfid
     case LBF_BUFFER_WRITEF32:
     case LBF_BUFFER_READF64:
     case LBF_BUFFER_WRITEF64:
+    case LBF_VECTOR_MAGNITUDE:
+    case LBF_VECTOR_NORMALIZE:
+    case LBF_VECTOR_CROSS:
+    case LBF_VECTOR_DOT:
+    case LBF_VECTOR_FLOOR:
+    case LBF_VECTOR_CEIL:
+    case LBF_VECTOR_ABS:
+    case LBF_VECTOR_SIGN:
+    case LBF_VECTOR_CLAMP:
+    case LBF_VECTOR_MIN:
+    case LBF_VECTOR_MAX:
+    case LBF_VECTOR_LERP:
+    case LBF_STRING_FORMAT:
         break;
     case LBF_TABLE_INSERT:
         state.invalidateHeap();
         return; // table.insert does not modify result registers.
     case LBF_RAWSET:
+    case LBF_TABLE_REMOVE:
         state.invalidateHeap();
         break;
     case LBF_SETMETATABLE:
@@ -559,6 +582,152 @@ static void handleBuiltinEffects(ConstPropState& state, LuauBuiltinFunction bfid
     state.invalidateRegistersFrom(firstReturnReg);
 }
 
+// Merged buffer range checks are limited to sizes that can be encoded as an immediate on all targets
+constexpr int kMaxMergedBufferAccessSize = 4095;
+
+// Finds a constant 'k' such that a valid 'offset' is within [base, base + k] if 'base' is a valid buffer offset
+static std::optional<int> getBufferOffsetDelta(IrFunction& function, IrOp base, IrOp offset)
+{
+    if (base.kind != IrOpKind::Inst || offset.kind != IrOpKind::Inst)
+        return std::nullopt;
+
+    if (base == offset)
+        return 0;
+
+    IrInst& offsetInst = function.instOp(offset);
+
+    if (offsetInst.cmd == IrCmd::ADD_INT)
+    {
+        std::optional<int> k = offsetInst.a == base ? function.asIntOp(offsetInst.b) : std::nullopt;
+
+        if (!k && offsetInst.b == base)
+            k = function.asIntOp(offsetInst.a);
+
+        if (k && *k > 0 && *k <= kMaxMergedBufferAccessSize)
+            return k;
+    }
+
+    // Number offsets are truncated, so for a valid trunc(x) and an integer k >= 1, trunc(x + k) is either trunc(x) + k or trunc(x) + k - 1
+    // The second case happens when 'x' is in (-1, 0), but the result still stays within a range checked from the base offset
+    IrInst& baseInst = function.instOp(base);
+
+    if (offsetInst.cmd == IrCmd::NUM_TO_INT && baseInst.cmd == IrCmd::NUM_TO_INT)
+    {
+        if (IrInst* add = function.asInstOp(offsetInst.a); add && add->cmd == IrCmd::ADD_NUM)
+        {
+            std::optional<double> k = add->a == baseInst.a ? function.asDoubleOp(add->b) : std::nullopt;
+
+            if (!k && add->b == baseInst.a)
+                k = function.asDoubleOp(add->a);
+
+            if (k && *k >= 1.0 && *k <= double(kMaxMergedBufferAccessSize) && *k == double(int(*k)))
+                return int(*k);
+        }
+    }
+
+    return std::nullopt;
+}
+
+// Slots are only tracked when an earlier check has verified that the node holds the key, so slots with different keys can't alias
+static bool isVerifiedNodeSlot(IrFunction& function, ConstPropState& state, IrOp slot)
+{
+    IrInst* slotInst = function.asInstOp(slot);
+
+    if (!slotInst || slotInst->cmd != IrCmd::GET_SLOT_NODE_ADDR)
+        return false;
+
+    for (uint32_t prevIdx : state.checkSlotMatchCache)
+    {
+        const IrInst& prev = function.instructions[prevIdx];
+
+        if (prev.a == slot && prev.b == slotInst->c)
+            return true;
+    }
+
+    return false;
+}
+
+static int getNodeSlotStoreOffset(IrFunction& function, const IrInst& store)
+{
+    IrOp offset = store.cmd == IrCmd::STORE_SPLIT_TVALUE ? store.d : store.c;
+
+    return offset.kind == IrOpKind::None ? 0 : function.intOp(offset);
+}
+
+static uint8_t getNodeSlotStoreTag(IrFunction& function, ConstPropState& state, const IrInst& store)
+{
+    if (store.cmd == IrCmd::STORE_SPLIT_TVALUE)
+        return function.tagOp(store.b);
+
+    if (uint8_t tag = state.tryGetTag(store.b); tag != 0xff)
+        return tag;
+
+    if (IrInst* arg = function.asInstOp(store.b))
+    {
+        if (arg->cmd == IrCmd::TAG_VECTOR)
+            return LUA_TVECTOR;
+
+        if (arg->cmd == IrCmd::LOAD_TVALUE && arg->c.kind != IrOpKind::None)
+            return function.tagOp(arg->c);
+    }
+
+    return 0xff;
+}
+
+static IrInst* findNodeSlotStore(IrFunction& function, ConstPropState& state, IrOp slot, int offset)
+{
+    for (uint32_t storeIdx : state.nodeSlotStoreCache)
+    {
+        IrInst& store = function.instructions[storeIdx];
+
+        if (store.a == slot && getNodeSlotStoreOffset(function, store) == offset)
+            return &store;
+    }
+
+    return nullptr;
+}
+
+// Slot can't be nil if a non-nil value was stored in it
+static bool isNodeSlotKnownNotNil(IrFunction& function, ConstPropState& state, IrOp slot)
+{
+    if (IrInst* store = findNodeSlotStore(function, state, slot, offsetof(LuaNode, val)))
+    {
+        uint8_t tag = getNodeSlotStoreTag(function, state, *store);
+
+        return tag != 0xff && tag != LUA_TNIL;
+    }
+
+    return false;
+}
+
+static void handleNodeSlotStore(IrFunction& function, ConstPropState& state, uint32_t storeIdx)
+{
+    IrInst& store = function.instructions[storeIdx];
+    IrInst* ptr = function.asInstOp(store.a);
+
+    // Array part and upvalue storage can't alias table hash part
+    if (ptr && (ptr->cmd == IrCmd::GET_ARR_ADDR || ptr->cmd == IrCmd::GET_CLOSURE_UPVAL_ADDR))
+        return;
+
+    if (!isVerifiedNodeSlot(function, state, store.a))
+    {
+        state.nodeSlotStoreCache.clear();
+        return;
+    }
+
+    // A slot holding the same key might belong to the same table
+    auto sameKey = [&](uint32_t prevIdx) {
+        const IrInst& prevSlot = function.instOp(function.instructions[prevIdx].a);
+        return prevSlot.c == ptr->c;
+    };
+
+    state.nodeSlotStoreCache.erase(
+        std::remove_if(state.nodeSlotStoreCache.begin(), state.nodeSlotStoreCache.end(), sameKey), state.nodeSlotStoreCache.end());
+
+    if (int(state.nodeSlotStoreCache.size()) < FInt::LuauCodeGenReuseSlotLimit)
+        state.nodeSlotStoreCache.push_back(storeIdx);
+}
+
 static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction& function, IrBlock& block, IrInst& inst, uint32_t index)
 {
     switch (inst.cmd)
@@ -601,7 +770,22 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
         break;
     case IrCmd::LOAD_TVALUE:
         if (inst.a.kind == IrOpKind::VmReg)
+        {
             state.substituteOrRecordVmRegLoad(inst);
+        }
+        else if (inst.a.kind == IrOpKind::Inst)
+        {
+            int offset = inst.b.kind == IrOpKind::None ? 0 : function.intOp(inst.b);
+
+            // Value written to a table slot can be taken directly from the store
+            if (IrInst* store = findNodeSlotStore(function, state, inst.a, offset))
+            {
+                if (store->cmd == IrCmd::STORE_TVALUE)
+                    substitute(function, inst, store->b);
+                else if (inst.c.kind == IrOpKind::None)
+                    inst.c = store->b;
+            }
+        }
         break;
     case IrCmd::STORE_TAG:
         if (inst.a.kind == IrOpKind::VmReg)
@@ -781,6 +965,9 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             {
                 state.forwardVmRegStoreToLoad(inst, IrCmd::LOAD_TVALUE);
             }
+
+            if (inst.a.kind == IrOpKind::Inst)
+                handleNodeSlotStore(function, state, index);
         }
         break;
     case IrCmd::STORE_SPLIT_TVALUE:
@@ -793,6 +980,10 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             if (inst.c.kind == IrOpKind::Constant)
                 state.saveValue(inst.a, inst.c);
         }
+        else if (inst.a.kind == IrOpKind::Inst)
+        {
+            handleNodeSlotStore(function, state, index);
+        }
         break;
     case IrCmd::JUMP_IF_TRUTHY:
         if (uint8_t tag = state.tryGetTag(inst.a); tag != 0xff)
@@ -838,9 +1029,9 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
         if (valueA && valueB)
         {
             if (compare(*valueA, *valueB, conditionOp(inst.c)))
-                replace(function, block, index, {IrCmd::JUMP, inst.c});
-            else
                 replace(function, block, index, {IrCmd::JUMP, inst.d});
+            else
+                replace(function, block, index, {IrCmd::JUMP, inst.e});
         }
         break;
     }
@@ -1012,18 +1203,33 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
         {
             IrInst& prev = function.instructions[prevIdx];
 
-            if (prev.a != inst.a || prev.c != inst.c)
+            if (prev.a != inst.a)
                 continue;
 
-            if (prev.b == inst.b)
+            if (std::optional<int> delta = getBufferOffsetDelta(function, prev.b, inst.b))
             {
+                // If the offset is at a small distance after the previously checked one, the previous check can be extended to cover both accesses
+                int prevAccessSize = function.intOp(prev.c);
+
+                if (*delta + accessSize > prevAccessSize)
+                {
+                    if (*delta + accessSize > kMaxMergedBufferAccessSize)
+                        continue;
+
+                    replace(function, prev.c, build.constInt(*delta + accessSize));
+                }
+
                 if (FFlag::DebugLuauAbortingChecks)
                     replace(function, inst.d, build.undef());
                 else
                     kill(function, inst);
                 return; // Break out from both the loop and the switch
             }
-            else if (inst.b.kind == IrOpKind::Constant && prev.b.kind == IrOpKind::Constant)
+
+            if (prev.c != inst.c)
+                continue;
+
+            if (inst.b.kind == IrOpKind::Constant && prev.b.kind == IrOpKind::Constant)
             {
                 // If arguments are different constants, we can check if a larger bound was already tested or if the previous bound can be raised
                 int currBound = function.intOp(inst.b);
@@ -1334,7 +1540,10 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             if (prev.a == inst.a && prev.b == inst.b)
             {
                 // Only a check for 'nil' value is left
-                replace(function, block, index, {IrCmd::CHECK_NODE_VALUE, inst.a, inst.c});
+                if (isNodeSlotKnownNotNil(function, state, inst.a))
+                    kill(function, inst);
+                else
+                    replace(function, block, index, {IrCmd::CHECK_NODE_VALUE, inst.a, inst.c});
                 return; // Break out from both the loop and the switch
             }
         }
@@ -1347,6 +1556,7 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
     case IrCmd::SUB_VEC:
     case IrCmd::MUL_VEC:
     case IrCmd::DIV_VEC:
+    case IrCmd::DOT_VEC:
         if (IrInst* a = function.asInstOp(inst.a); a && a->cmd == IrCmd::TAG_VECTOR)
             replace(function, inst.a, a->a);
 
@@ -1359,8 +1569,11 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             replace(function, inst.a, a->a);
         break;
 
-    case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
+        if (isNodeSlotKnownNotNil(function, state, inst.a))
+            kill(function, inst);
+        break;
+    case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::BARRIER_TABLE_BACK:
     case IrCmd::RETURN:
     case IrCmd::COVERAGE:
@@ -1492,6 +1705,536 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
     }
 }
 
+// Natural loop in the CFG with the VM register tags that hold on every iteration of the loop
+struct LoopTagInfo
+{
+    uint32_t header = ~0u;
+
+    // All blocks of the loop, including the header
+    std::vector<uint32_t> blocks;
+
+    // Predecessors of the header block that are not a part of the loop
+    std::vector<uint32_t> entries;
+
+    bool computed = false;
+
+    // Register and tag pairs
+    std::vector<std::pair<uint8_t, uint8_t>> invariantTags;
+};
+
+struct LoopTagState
+{
+    std::vector<LoopTagInfo> loops;
+
+    // Indices of loops that contain each block
+    std::vector<std::vector<uint32_t>> blockLoops;
+
+    // Register tags and constant values that are known at the exit of each processed block
+    // Empty for blocks that haven't been processed yet
+    std::vector<std::vector<uint8_t>> exitTags;
+    std::vector<std::vector<IrOp>> exitValues;
+
+    // Reverse post-order of reachable blocks, predecessors are processed first unless they are reached through a back edge
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> orderPos;
+};
+
+static bool dominates(const CfgInfo& cfg, uint32_t a, uint32_t b)
+{
+    const BlockOrdering& ao = cfg.domOrdering[a];
+    const BlockOrdering& bo = cfg.domOrdering[b];
+
+    return ao.visited && bo.visited && ao.preOrder <= bo.preOrder && bo.postOrder <= ao.postOrder;
+}
+
+static void computeReversePostOrder(IrFunction& function, LoopTagState& loopState)
+{
+    const CfgInfo& cfg = function.cfg;
+
+    if (cfg.successorsOffsets.size() != function.blocks.size())
+        return;
+
+    struct StackItem
+    {
+        uint32_t blockIdx;
+        uint32_t itPos;
+    };
+
+    std::vector<StackItem> stack;
+    std::vector<uint8_t> visited(function.blocks.size(), false);
+
+    stack.push_back({function.entryBlock, 0});
+    visited[function.entryBlock] = true;
+
+    while (!stack.empty())
+    {
+        StackItem& item = stack.back();
+        BlockIteratorWrapper children = successors(cfg, item.blockIdx);
+
+        if (item.itPos < children.size())
+        {
+            uint32_t childIdx = children[item.itPos++];
+
+            if (!visited[childIdx])
+            {
+                visited[childIdx] = true;
+                stack.push_back({childIdx, 0});
+            }
+        }
+        else
+        {
+            loopState.order.push_back(item.blockIdx);
+            stack.pop_back();
+        }
+    }
+
+    std::reverse(loopState.order.begin(), loopState.order.end());
+
+    loopState.orderPos.resize(function.blocks.size(), ~0u);
+
+    for (uint32_t i = 0; i < loopState.order.size(); i++)
+        loopState.orderPos[loopState.order[i]] = i;
+}
+
+static void findNaturalLoops(IrFunction& function, LoopTagState& loopState)
+{
+    const CfgInfo& cfg = function.cfg;
+
+    // Tests might run constant propagation without computing the CFG
+    if (cfg.domOrdering.size() != function.blocks.size() || cfg.predecessorsOffsets.size() != function.blocks.size())
+        return;
+
+    loopState.blockLoops.resize(function.blocks.size());
+    loopState.exitTags.resize(function.blocks.size());
+    loopState.exitValues.resize(function.blocks.size());
+
+    std::vector<uint8_t> inLoop(function.blocks.size(), false);
+    std::vector<uint32_t> worklist;
+
+    for (uint32_t headerIdx = 0; headerIdx < function.blocks.size(); headerIdx++)
+    {
+        if (function.blocks[headerIdx].kind == IrBlockKind::Dead)
+            continue;
+
+        bool hasBackEdge = false;
+
+        // A back edge is an edge into a block from a block that it dominates
+        for (uint32_t predIdx : predecessors(cfg, headerIdx))
+        {
+            if (!dominates(cfg, headerIdx, predIdx))
+                continue;
+
+            hasBackEdge = true;
+
+            // Block can jump to itself, but its predecessors are not a part of the loop
+            if (predIdx != headerIdx && !inLoop[predIdx])
+            {
+                inLoop[predIdx] = true;
+                worklist.push_back(predIdx);
+            }
+        }
+
+        if (!hasBackEdge)
+            continue;
+
+        LoopTagInfo loop;
+        loop.header = headerIdx;
+        loop.blocks.push_back(headerIdx);
+        inLoop[headerIdx] = true;
+
+        // Loop body contains all blocks that can reach a back edge without going through the header
+        while (!worklist.empty())
+        {
+            uint32_t blockIdx = worklist.back();
+            worklist.pop_back();
+
+            loop.blocks.push_back(blockIdx);
+
+            for (uint32_t predIdx : predecessors(cfg, blockIdx))
+            {
+                if (!inLoop[predIdx])
+                {
+                    inLoop[predIdx] = true;
+                    worklist.push_back(predIdx);
+                }
+            }
+        }
+
+        // Loop blocks are visited in reverse post-order, header is always the first one
+        std::sort(loop.blocks.begin(), loop.blocks.end(), [&](uint32_t a, uint32_t b) {
+            return loopState.orderPos[a] < loopState.orderPos[b];
+        });
+
+        for (uint32_t predIdx : predecessors(cfg, headerIdx))
+        {
+            if (!inLoop[predIdx])
+                loop.entries.push_back(predIdx);
+        }
+
+        uint32_t loopIdx = uint32_t(loopState.loops.size());
+
+        for (uint32_t blockIdx : loop.blocks)
+        {
+            loopState.blockLoops[blockIdx].push_back(loopIdx);
+            inLoop[blockIdx] = false;
+        }
+
+        loopState.loops.push_back(std::move(loop));
+    }
+}
+
+struct LoopTagDefVisitor
+{
+    std::bitset<256> defs;
+
+    void def(IrOp op, int offset = 0)
+    {
+        defs.set(vmRegOp(op) + offset);
+    }
+
+    void maybeDef(IrOp op)
+    {
+        if (op.kind == IrOpKind::VmReg)
+            defs.set(vmRegOp(op));
+    }
+
+    void defRange(int start, int count)
+    {
+        int end = count == -1 ? 256 : start + count;
+
+        for (int i = start; i < end; i++)
+            defs.set(i);
+    }
+
+    void use(IrOp op, int offset = 0) {}
+    void maybeUse(IrOp op) {}
+    void useRange(int start, int count) {}
+    void useVarargs(int start) {}
+    void capture(int reg) {}
+};
+
+static int getCheckedTagReg(IrFunction& function, IrOp op)
+{
+    if (op.kind == IrOpKind::VmReg)
+        return vmRegOp(op);
+
+    if (IrInst* load = function.asInstOp(op); load && load->cmd == IrCmd::LOAD_TAG && load->a.kind == IrOpKind::VmReg)
+        return vmRegOp(load->a);
+
+    return -1;
+}
+
+// Starting with the tags known on entry into the loop, find which of them can't change inside the loop
+// Tag checks of such registers always succeed, so their fallback paths are ignored, which can keep more tags unchanged
+// Tags established in a block are also known in the blocks it jumps to, unless they have other reachable predecessors with a different tag
+static void computeLoopInvariantTags(IrFunction& function, const LoopTagState& loopState, LoopTagInfo& loop, std::array<uint8_t, 256> tags)
+{
+    std::vector<uint8_t> inLoop(function.blocks.size(), false);
+    for (uint32_t blockIdx : loop.blocks)
+        inLoop[blockIdx] = true;
+
+    std::vector<uint8_t> reached(function.blocks.size(), false);
+
+    // Local tags at the entry of each reached block, as an intersection of tags on all reached incoming edges
+    std::vector<uint32_t> entrySlot(function.blocks.size(), ~0u);
+    std::vector<std::array<uint8_t, 256>> entryTags;
+
+    std::array<uint8_t, 256> localTags;
+
+    auto addEdge = [&](uint32_t targetIdx, bool terminator) {
+        // Jumps from the middle of the block and retreating edges to inner loop headers don't carry local tags
+        bool inherit = terminator && targetIdx != loop.header;
+
+        for (uint32_t predIdx : predecessors(function.cfg, targetIdx))
+        {
+            if (loopState.orderPos[predIdx] >= loopState.orderPos[targetIdx])
+                inherit = false;
+        }
+
+        if (entrySlot[targetIdx] == ~0u)
+        {
+            entrySlot[targetIdx] = uint32_t(entryTags.size());
+            entryTags.emplace_back().fill(0xff);
+
+            if (inherit)
+                entryTags.back() = localTags;
+        }
+        else
+        {
+            std::array<uint8_t, 256>& target = entryTags[entrySlot[targetIdx]];
+
+            for (int i = 0; i < 256; i++)
+            {
+                if (!inherit || target[i] != localTags[i])
+                    target[i] = 0xff;
+            }
+        }
+    };
+
+    bool changed = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        std::fill(reached.begin(), reached.end(), false);
+        std::fill(entrySlot.begin(), entrySlot.end(), ~0u);
+        entryTags.clear();
+
+        reached[loop.header] = true;
+
+        std::bitset<256> clobbered;
+
+        // In reverse post-order, all blocks that can jump into the block (except for the retreating edges) are visited before it
+        for (uint32_t blockIdx : loop.blocks)
+        {
+            if (!reached[blockIdx])
+                continue;
+
+            IrBlock& block = function.blocks[blockIdx];
+
+            // Tags that are established inside the block help skip local checks
+            if (entrySlot[blockIdx] != ~0u)
+                localTags = entryTags[entrySlot[blockIdx]];
+            else
+                localTags.fill(0xff);
+
+            for (uint32_t instIdx = block.start; instIdx <= block.finish; instIdx++)
+            {
+                IrInst& inst = function.instructions[instIdx];
+
+                IrOp skipTarget;
+
+                switch (inst.cmd)
+                {
+                case IrCmd::CHECK_TAG:
+                    if (int reg = getCheckedTagReg(function, inst.a); reg >= 0)
+                    {
+                        uint8_t tag = function.tagOp(inst.b);
+
+                        if (tags[reg] == tag || localTags[reg] == tag)
+                            skipTarget = inst.c;
+
+                        localTags[reg] = tag;
+                    }
+                    break;
+                case IrCmd::STORE_TAG:
+                case IrCmd::STORE_SPLIT_TVALUE:
+                    if (inst.a.kind == IrOpKind::VmReg)
+                    {
+                        int reg = vmRegOp(inst.a);
+
+                        if (inst.b.kind == IrOpKind::Constant)
+                        {
+                            uint8_t tag = function.tagOp(inst.b);
+
+                            if (tags[reg] != tag)
+                                clobbered.set(reg);
+
+                            localTags[reg] = tag;
+                        }
+                        else
+                        {
+                            clobbered.set(reg);
+                            localTags[reg] = 0xff;
+                        }
+                    }
+                    break;
+                case IrCmd::STORE_EXTRA:
+                case IrCmd::STORE_POINTER:
+                case IrCmd::STORE_DOUBLE:
+                case IrCmd::STORE_INT:
+                case IrCmd::STORE_VECTOR:
+                    // Only the value is modified
+                    break;
+                default:
+                {
+                    LoopTagDefVisitor visitor;
+                    visitVmRegDefsUses(visitor, function, inst);
+
+                    if (visitor.defs.any())
+                    {
+                        clobbered |= visitor.defs;
+
+                        for (int i = 0; i < 256; i++)
+                        {
+                            if (visitor.defs.test(i))
+                                localTags[i] = 0xff;
+                        }
+                    }
+                    break;
+                }
+                }
+
+                for (IrOp op : {inst.a, inst.b, inst.c, inst.d, inst.e, inst.f, inst.g})
+                {
+                    if (op.kind != IrOpKind::Block || op == skipTarget || !inLoop[op.index])
+                        continue;
+
+                    reached[op.index] = true;
+                    addEdge(op.index, instIdx == block.finish);
+                }
+            }
+        }
+
+        for (int i = 0; i < 256; i++)
+        {
+            if (tags[i] != 0xff && clobbered.test(i))
+            {
+                tags[i] = 0xff;
+                changed = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < 256; i++)
+    {
+        if (tags[i] != 0xff)
+            loop.invariantTags.push_back({uint8_t(i), tags[i]});
+    }
+
+    loop.computed = true;
+}
+
+// Exit state of a block is only valid for the edge of its terminator, guards jump out of the middle of the block
+static bool isTerminatorOnlySuccessor(IrFunction& function, const IrBlock& pred, uint32_t targetIdx)
+{
+    for (uint32_t index = pred.start; index < pred.finish; index++)
+    {
+        const IrInst& inst = function.instructions[index];
+
+        for (IrOp op : {inst.a, inst.b, inst.c, inst.d, inst.e, inst.f, inst.g})
+        {
+            if (op.kind == IrOpKind::Block && op.index == targetIdx)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// Find register tags and constant values that are the same at the exit of all the specified predecessors of the block
+// This is only possible when every predecessor has already been processed
+static bool getKnownEntryState(IrFunction& function, const LoopTagState& loopState, uint32_t blockIdx, BlockIteratorWrapper preds,
+    std::array<uint8_t, 256>& tags, std::array<IrOp, 256>& values)
+{
+    tags.fill(0xff);
+    values.fill(IrOp{});
+
+    if (preds.empty())
+        return false;
+
+    bool first = true;
+
+    for (uint32_t predIdx : preds)
+    {
+        const std::vector<uint8_t>& exitTags = loopState.exitTags[predIdx];
+        const std::vector<IrOp>& exitValues = loopState.exitValues[predIdx];
+
+        if (exitTags.empty() || !isTerminatorOnlySuccessor(function, function.blocks[predIdx], blockIdx))
+        {
+            tags.fill(0xff);
+            values.fill(IrOp{});
+            return false;
+        }
+
+        for (int i = 0; i < 256; i++)
+        {
+            uint8_t tag = i < int(exitTags.size()) ? exitTags[i] : 0xff;
+            IrOp value = i < int(exitValues.size()) ? exitValues[i] : IrOp{};
+
+            if (first)
+            {
+                tags[i] = tag;
+                values[i] = value;
+            }
+            else
+            {
+                if (tags[i] != tag)
+                    tags[i] = 0xff;
+
+                if (values[i] != value)
+                    values[i] = IrOp{};
+            }
+        }
+
+        first = false;
+    }
+
+    // Values in captured registers can be changed by any call
+    for (int i = 0; i < 256; i++)
+    {
+        if (function.cfg.captured.regs.test(i))
+        {
+            tags[i] = 0xff;
+            values[i] = IrOp{};
+        }
+    }
+
+    return true;
+}
+
+// When a block chain starts at a block with already processed predecessors, register tags and constant values that match on all of them
+// are known on entry as well
+// When a block chain starts inside a loop, tags that don't change inside that loop are known from the loop entry
+static void applyKnownEntryState(IrFunction& function, LoopTagState& loopState, uint32_t blockIdx, ConstPropState& state)
+{
+    if (loopState.blockLoops.empty())
+        return;
+
+    std::array<uint8_t, 256> tags;
+    std::array<IrOp, 256> values;
+
+    bool isLoopHeader = false;
+
+    for (uint32_t loopIdx : loopState.blockLoops[blockIdx])
+    {
+        if (loopState.loops[loopIdx].header == blockIdx)
+            isLoopHeader = true;
+    }
+
+    // Back edges of a loop header are not processed yet, loop invariant tags are used instead
+    if (!isLoopHeader && getKnownEntryState(function, loopState, blockIdx, predecessors(function.cfg, blockIdx), tags, values))
+    {
+        const RegisterSet& in = function.cfg.in[blockIdx];
+
+        for (int i = 0; i < 256; i++)
+        {
+            // Knowledge of registers that are overwritten before use can only remove stores, which stops dead store elimination from
+            // removing both parts of the store pair later
+            if (!in.regs.test(i) && !(in.varargSeq && i >= in.varargStart))
+                continue;
+
+            if (tags[i] != 0xff)
+                state.saveTag(IrOp{IrOpKind::VmReg, uint8_t(i)}, tags[i]);
+
+            if (values[i].kind == IrOpKind::Constant)
+                state.saveValue(IrOp{IrOpKind::VmReg, uint8_t(i)}, values[i]);
+        }
+    }
+
+    for (uint32_t loopIdx : loopState.blockLoops[blockIdx])
+    {
+        LoopTagInfo& loop = loopState.loops[loopIdx];
+
+        if (!loop.computed && loop.header == blockIdx)
+        {
+            BlockIteratorWrapper entries{loop.entries.data(), loop.entries.data() + loop.entries.size()};
+
+            // Only tags that are the same on all entries into the loop are known
+            getKnownEntryState(function, loopState, blockIdx, entries, tags, values);
+
+            computeLoopInvariantTags(function, loopState, loop, tags);
+        }
+
+        if (loop.computed)
+        {
+            for (auto [reg, tag] : loop.invariantTags)
+                state.saveTag(IrOp{IrOpKind::VmReg, reg}, tag);
+        }
+    }
+}
+
 static void constPropInBlock(IrBuilder& build, IrBlock& block, ConstPropState& state)
 {
     IrFunction& function = build.function;
@@ -1509,12 +2252,15 @@ static void constPropInBlock(IrBuilder& build, IrBlock& block, ConstPropState& s
     }
 }
 
-static void constPropInBlockChain(IrBuilder& build, std::vector<uint8_t>& visited, IrBlock* block, ConstPropState& state)
+static void constPropInBlockChain(
+    IrBuilder& build, std::vector<uint8_t>& visited, IrBlock* block, ConstPropState& state, LoopTagState& loopState)
 {
     IrFunction& function = build.function;
 
     state.clear();
 
+    applyKnownEntryState(function, loopState, function.getBlockIndex(*block), state);
+
     const uint32_t startSortkey = block->sortkey;
     uint32_t chainPos = 0;
 
@@ -1526,6 +2272,21 @@ static void constPropInBlockChain(IrBuilder& build, std::vector<uint8_t>& visite
 
         constPropInBlock(build, *block, state);
 
+        if (!loopState.exitTags.empty())
+        {
+            std::vector<uint8_t>& exitTags = loopState.exitTags[blockIdx];
+            std::vector<IrOp>& exitValues = loopState.exitValues[blockIdx];
+
+            exitTags.resize(state.maxReg + 1);
+            exitValues.resize(state.maxReg + 1);
+
+            for (int i = 0; i <= state.maxReg; i++)
+            {
+                exitTags[i] = state.regs[i].tag;
+                exitValues[i] = state.regs[i].value;
+            }
+        }
+
         // Value numbering and load/store propagation is not performed between blocks
         state.invalidateValuePropagation();
 
@@ -1733,6 +2494,24 @@ void constPropInBlockChains(IrBuilder& build, bool useValueNumbering)
 
     std::vector<uint8_t> visited(function.blocks.size(), false);
 
+    LoopTagState loopState;
+    computeReversePostOrder(function, loopState);
+    findNaturalLoops(function, loopState);
+
+    // Block chains are processed in reverse post-order, this makes information from predecessors available at the start of most chains
+    for (uint32_t blockIdx : loopState.order)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        if (block.kind == IrBlockKind::Fallback || block.kind == IrBlockKind::Dead)
+            continue;
+
+        if (visited[blockIdx])
+            continue;
+
+        constPropInBlockChain(build, visited, &block, state, loopState);
+    }
+
     for (IrBlock& block : function.blocks)
     {
         if (block.kind == IrBlockKind::Fallback || block.kind == IrBlockKind::Dead)
@@ -1741,7 +2520,7 @@ void constPropInBlockChains(IrBuilder& build, bool useValueNumbering)
         if (visited[function.getBlockIndex(block)])
             continue;
 
-        constPropInBlockChain(build, visited, &block, state);
+        constPropInBlockChain(build, visited, &block, state, loopState);
     }
 }
 
@@ -1,6 +1,7 @@
 // This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
 #include "Luau/OptimizeDeadStore.h"
 
+#include "Luau/BytecodeAnalysis.h"
 #include "Luau/IrBuilder.h"
 #include "Luau/IrVisitUseDef.h"
 #include "Luau/IrUtils.h"
@@ -11,8 +12,6 @@
 
 LUAU_FASTFLAG(LuauCodegenUserdataOps)
 
-// TODO: optimization can be improved by knowing which registers are live in at each VM exit
-
 namespace Luau
 {
 namespace CodeGen
@@ -136,13 +135,28 @@ struct RemoveDeadStoreState
     }
 
     // When checking control flow, such as exit to fallback blocks:
-    // For VM exits, we keep all stores because we don't have information on what registers are live at the start of the VM assist
+    // For VM exits, we check which registers the VM might read when it continues from the exit instruction
     // For regular blocks, we check which registers are expected to be live at entry (if we have CFG information available)
     void checkLiveIns(IrOp op)
     {
         if (op.kind == IrOpKind::VmExit)
         {
-            readAllRegs();
+            uint32_t pcpos = vmExitOp(op);
+
+            if (pcpos < function.bcLiveIn.size())
+            {
+                const std::bitset<256>& in = function.bcLiveIn[pcpos];
+
+                for (int i = 0; i <= maxReg; i++)
+                {
+                    if (in.test(i))
+                        useReg(i);
+                }
+            }
+            else
+            {
+                readAllRegs();
+            }
         }
         else if (op.kind == IrOpKind::Block)
         {
@@ -700,6 +714,9 @@ void markDeadStoresInBlockChains(IrBuilder& build)
 {
     IrFunction& function = build.function;
 
+    if (function.proto)
+        computeBytecodeLiveness(function);
+
     std::vector<uint8_t> visited(function.blocks.size(), false);
 
     for (IrBlock& block : function.blocks)
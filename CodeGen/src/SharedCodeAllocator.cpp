@@ -41,10 +41,12 @@ struct NativeProtoBytecodeIdLess
 };
 
 NativeModule::NativeModule(SharedCodeAllocator* allocator, const std::optional<ModuleId>& moduleId, const uint8_t* moduleBaseAddress,
-    std::vector<NativeProtoExecDataPtr> nativeProtos) noexcept
+    std::vector<NativeProtoExecDataPtr> nativeProtos, uint8_t* allocationStart, size_t allocationSize) noexcept
     : allocator{allocator}
     , moduleId{moduleId}
     , moduleBaseAddress{moduleBaseAddress}
+    , allocationStart{allocationStart}
+    , allocationSize{allocationSize}
     , nativeProtos{std::move(nativeProtos)}
 {
     CODEGEN_ASSERT(allocator != nullptr);
@@ -233,7 +235,7 @@ std::pair<NativeModuleRef, bool> SharedCodeAllocator::getOrInsertNativeModule(co
     }
 
     std::unique_ptr<NativeModule>& nativeModule = identifiedModules[moduleId];
-    nativeModule = std::make_unique<NativeModule>(this, moduleId, codeStart, std::move(nativeProtos));
+    nativeModule = std::make_unique<NativeModule>(this, moduleId, codeStart, std::move(nativeProtos), nativeData, sizeNativeData);
 
     return {NativeModuleRef{nativeModule.get()}, true};
 }
@@ -251,7 +253,7 @@ NativeModuleRef SharedCodeAllocator::insertAnonymousNativeModule(
         return {};
     }
 
-    NativeModuleRef nativeModuleRef{new NativeModule{this, std::nullopt, codeStart, std::move(nativeProtos)}};
+    NativeModuleRef nativeModuleRef{new NativeModule{this, std::nullopt, codeStart, std::move(nativeProtos), nativeData, sizeNativeData}};
     ++anonymousModuleCount;
 
     return nativeModuleRef;
@@ -267,6 +269,9 @@ void SharedCodeAllocator::eraseNativeModuleIfUnreferenced(const NativeModule& na
     if (nativeModule.getRefcount() != 0)
         return;
 
+    // No native function of the module can be running or entered at this point
+    codeAllocator->deallocate(nativeModule.allocationStart, nativeModule.allocationSize);
+
     if (const std::optional<ModuleId>& moduleId = nativeModule.getModuleId())
     {
         const auto it = identifiedModules.find(*moduleId);
@@ -281,6 +286,13 @@ void SharedCodeAllocator::eraseNativeModuleIfUnreferenced(const NativeModule& na
     }
 }
 
+[[nodiscard]] CodeAllocationStats SharedCodeAllocator::getCodeAllocationStats() const
+{
+    std::unique_lock lock{mutex};
+
+    return codeAllocator->getStats();
+}
+
 [[nodiscard]] NativeModuleRef SharedCodeAllocator::tryGetNativeModuleWithLockHeld(const ModuleId& moduleId) const noexcept
 {
     const auto it = identifiedModules.find(moduleId);
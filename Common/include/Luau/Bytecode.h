@@ -46,7 +46,7 @@
 // Version 3: Adds FORGPREP/JUMPXEQK* and enhances AUX encoding for FORGLOOP. Removes FORGLOOP_NEXT/INEXT and JUMPIFEQK/JUMPIFNOTEQK. Currently supported.
 // Version 4: Adds Proto::flags, typeinfo, and floor division opcodes IDIV/IDIVK. Currently supported.
 // Version 5: Adds SUBRK/DIVRK and vector constants. Currently supported.
-// Version 6: Adds FASTCALL3. Currently supported.
+// Version 6: Adds FASTCALL3 and table template constants with values. Currently supported.
 
 // # Bytecode type information history
 // Version 1: (from bytecode version 4) Type information for function signature. Currently supported.
@@ -268,6 +268,7 @@ enum LuauOpcode
     // DUPTABLE: duplicate table using the constant table template to target register
     // A: target register
     // D: constant table index (0..32767)
+    // Note: templates with constant values (v6+) produce a table with these values already stored; other fields are set by subsequent instructions
     LOP_DUPTABLE,
 
     // SETLIST: set a list of values to table in target register
@@ -455,6 +456,7 @@ enum LuauBytecodeTag
     LBC_CONSTANT_TABLE,
     LBC_CONSTANT_CLOSURE,
     LBC_CONSTANT_VECTOR,
+    LBC_CONSTANT_TABLE_WITH_CONSTANTS,
 };
 
 // Type table tags
@@ -600,6 +602,33 @@ enum LuauBuiltinFunction
     LBF_BUFFER_WRITEF32,
     LBF_BUFFER_READF64,
     LBF_BUFFER_WRITEF64,
+
+    // vector.
+    LBF_VECTOR_MAGNITUDE,
+    LBF_VECTOR_NORMALIZE,
+    LBF_VECTOR_CROSS,
+    LBF_VECTOR_DOT,
+    LBF_VECTOR_FLOOR,
+    LBF_VECTOR_CEIL,
+    LBF_VECTOR_ABS,
+    LBF_VECTOR_SIGN,
+    LBF_VECTOR_CLAMP,
+    LBF_VECTOR_MIN,
+    LBF_VECTOR_MAX,
+    LBF_VECTOR_LERP,
+
+    // table.remove
+    LBF_TABLE_REMOVE,
+
+    // string.format
+    LBF_STRING_FORMAT,
+};
+
+// Builtin function ids reserved for functions of the host, see CompileOptions::hostBuiltins and lua_sethostbuiltin
+enum LuauHostBuiltinRange
+{
+    LBF_HOST_FIRST = 224,
+    LBF_HOST_COUNT = 32,
 };
 
 // Capture type, used in LOP_CAPTURE
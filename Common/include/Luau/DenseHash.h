@@ -4,11 +4,24 @@
 #include "Luau/Common.h"
 
 #include <stddef.h>
+#include <string.h>
 #include <functional>
 #include <utility>
 #include <type_traits>
 #include <stdint.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LUAU_DENSEHASH_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define LUAU_DENSEHASH_NEON
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace Luau
 {
 
@@ -419,6 +432,509 @@ private:
     Eq eq;
 };
 
+// Control bytes of DenseHashGroupTable; a group of slots is matched against a control byte at once
+// Masks have a bit set at (slot << kShift) for every matching slot of the group
+struct DenseHashGroup
+{
+    static constexpr size_t kSize = 16;
+    static constexpr uint8_t kEmpty = 0x80;
+
+#if defined(LUAU_DENSEHASH_NEON)
+    static constexpr int kShift = 2;
+#else
+    static constexpr int kShift = 0;
+#endif
+
+    static uint64_t match(const uint8_t* ctrl, uint8_t tag)
+    {
+#if defined(LUAU_DENSEHASH_SSE2)
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(char(tag)))));
+#elif defined(LUAU_DENSEHASH_NEON)
+        uint8x16_t eq = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(tag));
+        return narrow(eq);
+#else
+        uint64_t mask = 0;
+        for (size_t i = 0; i < kSize; ++i)
+            mask |= uint64_t(ctrl[i] == tag) << i;
+        return mask;
+#endif
+    }
+
+    static uint64_t matchEmpty(const uint8_t* ctrl)
+    {
+#if defined(LUAU_DENSEHASH_SSE2)
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return uint32_t(_mm_movemask_epi8(group));
+#elif defined(LUAU_DENSEHASH_NEON)
+        uint8x16_t empty = vtstq_u8(vld1q_u8(ctrl), vdupq_n_u8(kEmpty));
+        return narrow(empty);
+#else
+        uint64_t mask = 0;
+        for (size_t i = 0; i < kSize; ++i)
+            mask |= uint64_t(ctrl[i] >> 7) << i;
+        return mask;
+#endif
+    }
+
+    static size_t first(uint64_t mask)
+    {
+        LUAU_ASSERT(mask != 0);
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long rl;
+        _BitScanForward64(&rl, mask);
+        return size_t(rl) >> kShift;
+#elif defined(_MSC_VER)
+        unsigned long rl;
+        if (!_BitScanForward(&rl, uint32_t(mask)))
+        {
+            _BitScanForward(&rl, uint32_t(mask >> 32));
+            rl += 32;
+        }
+        return size_t(rl) >> kShift;
+#else
+        return size_t(__builtin_ctzll(mask)) >> kShift;
+#endif
+    }
+
+#if defined(LUAU_DENSEHASH_NEON)
+    // 16 byte lanes that are either 0 or 0xff are narrowed to 4 bits per lane, keeping one bit for each
+    static uint64_t narrow(uint8x16_t lanes)
+    {
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+    }
+#endif
+};
+
+// Variant of DenseHashTable that keeps a control byte per slot with 7 bits of the key hash; lookups match a group of control bytes at once
+// and only compare keys with matching bits, which makes probing cheaper for keys that are expensive to compare and keeps probe sequences
+// short at a higher load factor. It takes more memory per slot and more work per lookup than DenseHashTable, which is usually faster for
+// small tables with cheap keys (e.g. pointers).
+// Slots are never erased, so the table doesn't need tombstones; empty_key is only used to initialize unused slots
+template<typename Key, typename Item, typename MutableItem, typename ItemInterface, typename Hash, typename Eq>
+class DenseHashGroupTable
+{
+public:
+    class const_iterator;
+    class iterator;
+
+    explicit DenseHashGroupTable(const Key& empty_key, size_t buckets = 0)
+        : data(nullptr)
+        , ctrl(nullptr)
+        , capacity(0)
+        , count(0)
+        , empty_key(empty_key)
+    {
+        // validate that equality operator is at least somewhat functional
+        LUAU_ASSERT(eq(empty_key, empty_key));
+        // buckets has to be power-of-two or zero
+        LUAU_ASSERT((buckets & (buckets - 1)) == 0);
+
+        if (buckets)
+            allocate(buckets < DenseHashGroup::kSize ? DenseHashGroup::kSize : buckets);
+    }
+
+    ~DenseHashGroupTable()
+    {
+        if (data)
+            destroy();
+    }
+
+    DenseHashGroupTable(const DenseHashGroupTable& other)
+        : data(nullptr)
+        , ctrl(nullptr)
+        , capacity(0)
+        , count(other.count)
+        , empty_key(other.empty_key)
+    {
+        if (other.capacity)
+        {
+            data = static_cast<Item*>(::operator new(allocationSize(other.capacity)));
+            ctrl = reinterpret_cast<uint8_t*>(data + other.capacity);
+
+            memcpy(ctrl, other.ctrl, other.capacity);
+
+            for (size_t i = 0; i < other.capacity; ++i)
+            {
+                new (&data[i]) Item(other.data[i]);
+                capacity = i + 1; // if Item copy throws, capacity will note the number of initialized objects for destroy() to clean up
+            }
+        }
+    }
+
+    DenseHashGroupTable(DenseHashGroupTable&& other)
+        : data(other.data)
+        , ctrl(other.ctrl)
+        , capacity(other.capacity)
+        , count(other.count)
+        , empty_key(other.empty_key)
+    {
+        other.data = nullptr;
+        other.ctrl = nullptr;
+        other.capacity = 0;
+        other.count = 0;
+    }
+
+    DenseHashGroupTable& operator=(DenseHashGroupTable&& other)
+    {
+        if (this != &other)
+        {
+            if (data)
+                destroy();
+
+            data = other.data;
+            ctrl = other.ctrl;
+            capacity = other.capacity;
+            count = other.count;
+            empty_key = other.empty_key;
+
+            other.data = nullptr;
+            other.ctrl = nullptr;
+            other.capacity = 0;
+            other.count = 0;
+        }
+
+        return *this;
+    }
+
+    DenseHashGroupTable& operator=(const DenseHashGroupTable& other)
+    {
+        if (this != &other)
+        {
+            DenseHashGroupTable copy(other);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    void clear(size_t thresholdToDestroy = 32)
+    {
+        if (count == 0)
+            return;
+
+        if (capacity > thresholdToDestroy)
+        {
+            destroy();
+        }
+        else
+        {
+            ItemInterface::destroy(data, capacity);
+            ItemInterface::fill(data, capacity, empty_key);
+
+            memset(ctrl, DenseHashGroup::kEmpty, capacity);
+        }
+
+        count = 0;
+    }
+
+    void destroy()
+    {
+        ItemInterface::destroy(data, capacity);
+
+        ::operator delete(data);
+        data = nullptr;
+        ctrl = nullptr;
+
+        capacity = 0;
+    }
+
+    Item* insert_unsafe(const Key& key)
+    {
+        // It is invalid to insert empty_key into the table since it acts as a "entry does not exist" marker
+        LUAU_ASSERT(!eq(key, empty_key));
+
+        uint64_t hash = mix(key);
+        uint8_t tag = uint8_t(hash >> 57);
+
+        size_t groupmod = capacity / DenseHashGroup::kSize - 1;
+        size_t group = size_t(hash >> 25) & groupmod;
+
+        for (size_t probe = 0; probe <= groupmod; ++probe)
+        {
+            size_t base = group * DenseHashGroup::kSize;
+
+            for (uint64_t mask = DenseHashGroup::match(ctrl + base, tag); mask; mask &= mask - 1)
+            {
+                Item& probe_item = data[base + DenseHashGroup::first(mask)];
+
+                // Element already exists
+                if (eq(ItemInterface::getKey(probe_item), key))
+                    return &probe_item;
+            }
+
+            // Element does not exist, insert into the first free slot of the group since elements are never erased
+            if (uint64_t mask = DenseHashGroup::matchEmpty(ctrl + base))
+            {
+                size_t index = base + DenseHashGroup::first(mask);
+
+                ctrl[index] = tag;
+                ItemInterface::setKey(data[index], key);
+                count++;
+                return &data[index];
+            }
+
+            // Group is full, quadratic probing over groups
+            group = (group + probe + 1) & groupmod;
+        }
+
+        // Hash table is full - this should not happen
+        LUAU_ASSERT(false);
+        return NULL;
+    }
+
+    const Item* find(const Key& key) const
+    {
+        if (count == 0)
+            return 0;
+
+        uint64_t hash = mix(key);
+        uint8_t tag = uint8_t(hash >> 57);
+
+        size_t groupmod = capacity / DenseHashGroup::kSize - 1;
+        size_t group = size_t(hash >> 25) & groupmod;
+
+        for (size_t probe = 0; probe <= groupmod; ++probe)
+        {
+            size_t base = group * DenseHashGroup::kSize;
+
+            for (uint64_t mask = DenseHashGroup::match(ctrl + base, tag); mask; mask &= mask - 1)
+            {
+                const Item& probe_item = data[base + DenseHashGroup::first(mask)];
+
+                // Element exists
+                if (eq(ItemInterface::getKey(probe_item), key))
+                    return &probe_item;
+            }
+
+            // Element does not exist
+            if (DenseHashGroup::matchEmpty(ctrl + base))
+                return NULL;
+
+            // Group is full, quadratic probing over groups
+            group = (group + probe + 1) & groupmod;
+        }
+
+        // Hash table is full - this should not happen
+        LUAU_ASSERT(false);
+        return NULL;
+    }
+
+    void rehash()
+    {
+        size_t newsize = capacity == 0 ? DenseHashGroup::kSize : capacity * 2;
+
+        DenseHashGroupTable newtable(empty_key, newsize);
+
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            if (!(ctrl[i] & DenseHashGroup::kEmpty))
+            {
+                Item* item = newtable.insert_unsafe(ItemInterface::getKey(data[i]));
+                *item = std::move(data[i]);
+            }
+        }
+
+        LUAU_ASSERT(count == newtable.count);
+
+        std::swap(data, newtable.data);
+        std::swap(ctrl, newtable.ctrl);
+        std::swap(capacity, newtable.capacity);
+    }
+
+    void rehash_if_full(const Key& key)
+    {
+        if (count >= capacity * 7 / 8 && !find(key))
+        {
+            rehash();
+        }
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, skipEmpty(0));
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, capacity);
+    }
+
+    iterator begin()
+    {
+        return iterator(this, skipEmpty(0));
+    }
+
+    iterator end()
+    {
+        return iterator(this, capacity);
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    class const_iterator
+    {
+    public:
+        using value_type = Item;
+        using reference = Item&;
+        using pointer = Item*;
+        using difference_type = ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator()
+            : set(0)
+            , index(0)
+        {
+        }
+
+        const_iterator(const DenseHashGroupTable<Key, Item, MutableItem, ItemInterface, Hash, Eq>* set, size_t index)
+            : set(set)
+            , index(index)
+        {
+        }
+
+        const Item& operator*() const
+        {
+            return set->data[index];
+        }
+
+        const Item* operator->() const
+        {
+            return &set->data[index];
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return set == other.set && index == other.index;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return set != other.set || index != other.index;
+        }
+
+        const_iterator& operator++()
+        {
+            index = set->skipEmpty(index + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator res = *this;
+            ++*this;
+            return res;
+        }
+
+    private:
+        const DenseHashGroupTable<Key, Item, MutableItem, ItemInterface, Hash, Eq>* set;
+        size_t index;
+    };
+
+    class iterator
+    {
+    public:
+        using value_type = MutableItem;
+        using reference = MutableItem&;
+        using pointer = MutableItem*;
+        using difference_type = ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator()
+            : set(0)
+            , index(0)
+        {
+        }
+
+        iterator(DenseHashGroupTable<Key, Item, MutableItem, ItemInterface, Hash, Eq>* set, size_t index)
+            : set(set)
+            , index(index)
+        {
+        }
+
+        MutableItem& operator*() const
+        {
+            return *reinterpret_cast<MutableItem*>(&set->data[index]);
+        }
+
+        MutableItem* operator->() const
+        {
+            return reinterpret_cast<MutableItem*>(&set->data[index]);
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return set == other.set && index == other.index;
+        }
+
+        bool operator!=(const iterator& other) const
+        {
+            return set != other.set || index != other.index;
+        }
+
+        iterator& operator++()
+        {
+            index = set->skipEmpty(index + 1);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator res = *this;
+            ++*this;
+            return res;
+        }
+
+    private:
+        DenseHashGroupTable<Key, Item, MutableItem, ItemInterface, Hash, Eq>* set;
+        size_t index;
+    };
+
+private:
+    static size_t allocationSize(size_t buckets)
+    {
+        // control bytes are placed after the items in the same allocation
+        return sizeof(Item) * buckets + buckets;
+    }
+
+    void allocate(size_t buckets)
+    {
+        data = static_cast<Item*>(::operator new(allocationSize(buckets)));
+        ctrl = reinterpret_cast<uint8_t*>(data + buckets);
+        capacity = buckets;
+
+        ItemInterface::fill(data, buckets, empty_key);
+        memset(ctrl, DenseHashGroup::kEmpty, buckets);
+    }
+
+    // hashes are often weak in high bits (e.g. identity hash of integers), which select the group and the control byte
+    uint64_t mix(const Key& key) const
+    {
+        return uint64_t(hasher(key)) * 0x9E3779B97F4A7C15ull;
+    }
+
+    size_t skipEmpty(size_t index) const
+    {
+        while (index < capacity && (ctrl[index] & DenseHashGroup::kEmpty))
+            index++;
+
+        return index;
+    }
+
+    Item* data;
+    uint8_t* ctrl;
+    size_t capacity;
+    size_t count;
+    Key empty_key;
+    Hash hasher;
+    Eq eq;
+};
+
 template<typename Key>
 struct ItemInterfaceSet
 {
@@ -480,10 +996,11 @@ struct ItemInterfaceMap
 } // namespace detail
 
 // This is a faster alternative of unordered_set, but it does not implement the same interface (i.e. it does not support erasing)
-template<typename Key, typename Hash = detail::DenseHashDefault<Key>, typename Eq = std::equal_to<Key>>
+template<typename Key, typename Hash = detail::DenseHashDefault<Key>, typename Eq = std::equal_to<Key>,
+    template<typename, typename, typename, typename, typename, typename> class Table = detail::DenseHashTable>
 class DenseHashSet
 {
-    typedef detail::DenseHashTable<Key, Key, Key, detail::ItemInterfaceSet<Key>, Hash, Eq> Impl;
+    typedef Table<Key, Key, Key, detail::ItemInterfaceSet<Key>, Hash, Eq> Impl;
     Impl impl;
 
 public:
@@ -546,7 +1063,7 @@ public:
         return impl.end();
     }
 
-    bool operator==(const DenseHashSet<Key, Hash, Eq>& other) const
+    bool operator==(const DenseHashSet& other) const
     {
         if (size() != other.size())
             return false;
@@ -560,7 +1077,7 @@ public:
         return true;
     }
 
-    bool operator!=(const DenseHashSet<Key, Hash, Eq>& other) const
+    bool operator!=(const DenseHashSet& other) const
     {
         return !(*this == other);
     }
@@ -568,10 +1085,11 @@ public:
 
 // This is a faster alternative of unordered_map, but it does not implement the same interface (i.e. it does not support erasing and has
 // contains() instead of find())
-template<typename Key, typename Value, typename Hash = detail::DenseHashDefault<Key>, typename Eq = std::equal_to<Key>>
+template<typename Key, typename Value, typename Hash = detail::DenseHashDefault<Key>, typename Eq = std::equal_to<Key>,
+    template<typename, typename, typename, typename, typename, typename> class Table = detail::DenseHashTable>
 class DenseHashMap
 {
-    typedef detail::DenseHashTable<Key, std::pair<Key, Value>, std::pair<const Key, Value>, detail::ItemInterfaceMap<Key, Value>, Hash, Eq> Impl;
+    typedef Table<Key, std::pair<Key, Value>, std::pair<const Key, Value>, detail::ItemInterfaceMap<Key, Value>, Hash, Eq> Impl;
     Impl impl;
 
 public:
@@ -663,4 +1181,11 @@ public:
     }
 };
 
+// DenseHashSet and DenseHashMap that probe groups of slots with control bytes; see DenseHashGroupTable for when these are faster
+template<typename Key, typename Hash = detail::DenseHashDefault<Key>, typename Eq = std::equal_to<Key>>
+using DenseHashGroupSet = DenseHashSet<Key, Hash, Eq, detail::DenseHashGroupTable>;
+
+template<typename Key, typename Value, typename Hash = detail::DenseHashDefault<Key>, typename Eq = std::equal_to<Key>>
+using DenseHashGroupMap = DenseHashMap<Key, Value, Hash, Eq, detail::DenseHashGroupTable>;
+
 } // namespace Luau
@@ -39,7 +39,9 @@ public:
         static const unsigned int kMaxLength = 32;
 
         int32_t keys[kMaxLength];
+        int32_t constants[kMaxLength]; // constant value for each key or -1; only valid when hasConstants is set
         unsigned int length = 0;
+        bool hasConstants = false;
 
         bool operator==(const TableShape& other) const;
     };
@@ -74,6 +76,7 @@ public:
 
     void foldJumps();
     void expandJumps();
+    void removeRedundantInstructions();
 
     void setFunctionTypeInfo(std::string value);
     void pushLocalTypeInfo(LuauBytecodeType type, uint8_t reg, uint32_t startpc, uint32_t endpc);
@@ -13,12 +13,19 @@ struct ParseResult;
 class BytecodeBuilder;
 class BytecodeEncoder;
 
+// opaque compile-time constant, filled by the host through setCompileConstant* functions
+struct CompileConstant;
+
+// callback used to determine the value of a global listed in CompileOptions::constantGlobals; leaving the constant unset keeps the global dynamic
+using GlobalConstantCallback = void (*)(const char* name, CompileConstant* constant);
+
 // Note: this structure is duplicated in luacode.h, don't forget to change these in sync!
 struct CompileOptions
 {
     // 0 - no optimization
     // 1 - baseline optimization level that doesn't prevent debuggability
     // 2 - includes optimizations that harm debuggability such as inlining
+    // 3 - includes whole-module optimizations such as compile-time evaluation of calls to local functions with constant arguments
     int optimizationLevel = 1;
 
     // 0 - no debugging support
@@ -49,6 +56,14 @@ struct CompileOptions
 
     // null-terminated array of userdata types that will be included in the type information
     const char* const* userdataTypes = nullptr;
+
+    // null-terminated array of globals that have a value known at compile time, provided through globalConstantCb; used for constant folding
+    const char* const* constantGlobals = nullptr;
+    GlobalConstantCallback globalConstantCb = nullptr;
+
+    // null-terminated array of global functions ("lerp" or "Vector3.new") that are called through FASTCALL like builtins; the function at
+    // index i uses the fast path registered with lua_sethostbuiltin for id i, and up to 32 functions are supported
+    const char* const* hostBuiltins = nullptr;
 };
 
 class CompileError : public std::exception
@@ -69,6 +84,12 @@ private:
     std::string message;
 };
 
+// sets the value of a compile-time constant from GlobalConstantCallback; string contents are copied
+void setCompileConstantNil(CompileConstant* constant);
+void setCompileConstantBoolean(CompileConstant* constant, bool b);
+void setCompileConstantNumber(CompileConstant* constant, double n);
+void setCompileConstantString(CompileConstant* constant, const char* s, size_t l);
+
 // compiles bytecode into bytecode builder using either a pre-parsed AST or parsing it from source; throws on errors
 void compileOrThrow(BytecodeBuilder& bytecode, const ParseResult& parseResult, const AstNameTable& names, const CompileOptions& options = {});
 void compileOrThrow(BytecodeBuilder& bytecode, const std::string& source, const CompileOptions& options = {}, const ParseOptions& parseOptions = {});
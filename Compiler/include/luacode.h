@@ -9,12 +9,17 @@
 #endif
 
 typedef struct lua_CompileOptions lua_CompileOptions;
+typedef struct lua_CompileConstant lua_CompileConstant;
+
+// callback used to determine the value of a global listed in lua_CompileOptions::constantGlobals; leaving the constant unset keeps the global dynamic
+typedef void (*lua_GlobalConstantCallback)(const char* name, lua_CompileConstant* constant);
 
 struct lua_CompileOptions
 {
     // 0 - no optimization
     // 1 - baseline optimization level that doesn't prevent debuggability
     // 2 - includes optimizations that harm debuggability such as inlining
+    // 3 - includes whole-module optimizations such as compile-time evaluation of calls to local functions with constant arguments
     int optimizationLevel; // default=1
 
     // 0 - no debugging support
@@ -45,7 +50,21 @@ struct lua_CompileOptions
 
     // null-terminated array of userdata types that will be included in the type information
     const char* const* userdataTypes;
+
+    // null-terminated array of globals that have a value known at compile time, provided through globalConstantCb; used for constant folding
+    const char* const* constantGlobals;
+    lua_GlobalConstantCallback globalConstantCb;
+
+    // null-terminated array of global functions ("lerp" or "Vector3.new") that are called through FASTCALL like builtins; the function at
+    // index i uses the fast path registered with lua_sethostbuiltin for id i, and up to 32 functions are supported
+    const char* const* hostBuiltins;
 };
 
 // compile source to bytecode; when source compilation fails, the resulting bytecode contains the encoded error. use free() to destroy
 LUACODE_API char* luau_compile(const char* source, size_t size, lua_CompileOptions* options, size_t* outsize);
+
+// sets the value of a compile-time constant from lua_GlobalConstantCallback; string contents are copied
+LUACODE_API void luau_set_compile_constant_nil(lua_CompileConstant* constant);
+LUACODE_API void luau_set_compile_constant_boolean(lua_CompileConstant* constant, int b);
+LUACODE_API void luau_set_compile_constant_number(lua_CompileConstant* constant, double n);
+LUACODE_API void luau_set_compile_constant_string(lua_CompileConstant* constant, const char* s, size_t l);
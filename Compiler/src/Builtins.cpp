@@ -4,6 +4,12 @@
 #include "Luau/Bytecode.h"
 #include "Luau/Compiler.h"
 
+#include <string.h>
+
+LUAU_FASTFLAG(LuauCompileVectorLibrary)
+LUAU_FASTFLAG(LuauCompileTableRemove)
+LUAU_FASTFLAG(LuauCompileStringFormat)
+
 namespace Luau
 {
 namespace Compile
@@ -38,6 +44,20 @@ Builtin getBuiltin(AstExpr* node, const DenseHashMap<AstName, Global>& globals,
     }
 }
 
+// host builtins are named either as globals or as library members, like "lerp" or "Vector3.new"
+static bool isHostBuiltin(const Builtin& builtin, const char* name)
+{
+    const char* dot = strchr(name, '.');
+
+    if (!dot)
+        return builtin.isGlobal(name);
+
+    size_t objectLength = dot - name;
+
+    return builtin.object.value && strlen(builtin.object.value) == objectLength && memcmp(builtin.object.value, name, objectLength) == 0 &&
+           builtin.method == dot + 1;
+}
+
 static int getBuiltinFunctionId(const Builtin& builtin, const CompileOptions& options)
 {
     if (builtin.isGlobal("assert"))
@@ -180,12 +200,16 @@ static int getBuiltinFunctionId(const Builtin& builtin, const CompileOptions& op
             return LBF_STRING_LEN;
         if (builtin.method == "sub")
             return LBF_STRING_SUB;
+        if (FFlag::LuauCompileStringFormat && builtin.method == "format")
+            return LBF_STRING_FORMAT;
     }
 
     if (builtin.object == "table")
     {
         if (builtin.method == "insert")
             return LBF_TABLE_INSERT;
+        if (FFlag::LuauCompileTableRemove && builtin.method == "remove")
+            return LBF_TABLE_REMOVE;
         if (builtin.method == "unpack")
             return LBF_TABLE_UNPACK;
     }
@@ -220,6 +244,36 @@ static int getBuiltinFunctionId(const Builtin& builtin, const CompileOptions& op
             return LBF_BUFFER_WRITEF64;
     }
 
+    if (FFlag::LuauCompileVectorLibrary && builtin.object == "vector")
+    {
+        if (builtin.method == "create")
+            return LBF_VECTOR;
+        if (builtin.method == "magnitude")
+            return LBF_VECTOR_MAGNITUDE;
+        if (builtin.method == "normalize")
+            return LBF_VECTOR_NORMALIZE;
+        if (builtin.method == "cross")
+            return LBF_VECTOR_CROSS;
+        if (builtin.method == "dot")
+            return LBF_VECTOR_DOT;
+        if (builtin.method == "floor")
+            return LBF_VECTOR_FLOOR;
+        if (builtin.method == "ceil")
+            return LBF_VECTOR_CEIL;
+        if (builtin.method == "abs")
+            return LBF_VECTOR_ABS;
+        if (builtin.method == "sign")
+            return LBF_VECTOR_SIGN;
+        if (builtin.method == "clamp")
+            return LBF_VECTOR_CLAMP;
+        if (builtin.method == "min")
+            return LBF_VECTOR_MIN;
+        if (builtin.method == "max")
+            return LBF_VECTOR_MAX;
+        if (builtin.method == "lerp")
+            return LBF_VECTOR_LERP;
+    }
+
     if (options.vectorCtor)
     {
         if (options.vectorLib)
@@ -234,6 +288,13 @@ static int getBuiltinFunctionId(const Builtin& builtin, const CompileOptions& op
         }
     }
 
+    if (options.hostBuiltins)
+    {
+        for (int i = 0; i < LBF_HOST_COUNT && options.hostBuiltins[i]; ++i)
+            if (isHostBuiltin(builtin, options.hostBuiltins[i]))
+                return LBF_HOST_FIRST + i;
+    }
+
     return -1;
 }
 
@@ -283,6 +344,10 @@ void analyzeBuiltins(DenseHashMap<AstExprCall*, int>& result, const DenseHashMap
 
 BuiltinInfo getBuiltinInfo(int bfid)
 {
+    // host builtins can take and return any number of values
+    if (bfid >= LBF_HOST_FIRST)
+        return {-1, -1};
+
     switch (LuauBuiltinFunction(bfid))
     {
     case LBF_NONE:
@@ -387,6 +452,9 @@ BuiltinInfo getBuiltinInfo(int bfid)
     case LBF_STRING_SUB:
         return {-1, 1}; // 2 or 3 parameters
 
+    case LBF_STRING_FORMAT:
+        return {-1, 1}; // variadic
+
     case LBF_MATH_CLAMP:
         return {3, 1, BuiltinInfo::Flag_NoneSafe};
 
@@ -404,6 +472,9 @@ BuiltinInfo getBuiltinInfo(int bfid)
     case LBF_TABLE_INSERT:
         return {-1, 0}; // 2 or 3 parameters
 
+    case LBF_TABLE_REMOVE:
+        return {-1, -1}; // 1 or 2 parameters, 0 or 1 results
+
     case LBF_TABLE_UNPACK:
         return {-1, -1}; // 1, 2 or 3 parameters
 
@@ -454,6 +525,26 @@ BuiltinInfo getBuiltinInfo(int bfid)
     case LBF_BUFFER_WRITEF32:
     case LBF_BUFFER_WRITEF64:
         return {3, 0, BuiltinInfo::Flag_NoneSafe};
+
+    case LBF_VECTOR_MAGNITUDE:
+    case LBF_VECTOR_NORMALIZE:
+    case LBF_VECTOR_FLOOR:
+    case LBF_VECTOR_CEIL:
+    case LBF_VECTOR_ABS:
+    case LBF_VECTOR_SIGN:
+        return {1, 1, BuiltinInfo::Flag_NoneSafe};
+
+    case LBF_VECTOR_CROSS:
+    case LBF_VECTOR_DOT:
+        return {2, 1, BuiltinInfo::Flag_NoneSafe};
+
+    case LBF_VECTOR_CLAMP:
+    case LBF_VECTOR_LERP:
+        return {3, 1, BuiltinInfo::Flag_NoneSafe};
+
+    case LBF_VECTOR_MIN:
+    case LBF_VECTOR_MAX:
+        return {-1, 1}; // variadic
     }
 
     LUAU_UNREACHABLE();
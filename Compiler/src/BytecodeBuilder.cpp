@@ -9,6 +9,7 @@
 
 LUAU_FASTFLAG(LuauCompileUserdataInfo)
 LUAU_FASTFLAG(LuauCompileFastcall3)
+LUAU_FASTFLAG(LuauCompileTableConstants)
 
 namespace Luau
 {
@@ -144,7 +145,13 @@ bool BytecodeBuilder::StringRef::operator==(const StringRef& other) const
 
 bool BytecodeBuilder::TableShape::operator==(const TableShape& other) const
 {
-    return length == other.length && memcmp(keys, other.keys, length * sizeof(keys[0])) == 0;
+    if (length != other.length || hasConstants != other.hasConstants)
+        return false;
+
+    if (memcmp(keys, other.keys, length * sizeof(keys[0])) != 0)
+        return false;
+
+    return !hasConstants || memcmp(constants, other.constants, length * sizeof(constants[0])) == 0;
 }
 
 size_t BytecodeBuilder::StringRefHash::operator()(const StringRef& v) const
@@ -204,6 +211,15 @@ size_t BytecodeBuilder::TableShapeHash::operator()(const TableShape& v) const
         hash *= 16777619;
     }
 
+    if (v.hasConstants)
+    {
+        for (size_t i = 0; i < v.length; ++i)
+        {
+            hash ^= v.constants[i];
+            hash *= 16777619;
+        }
+    }
+
     return hash;
 }
 
@@ -817,10 +833,23 @@ void BytecodeBuilder::writeFunction(std::string& ss, uint32_t id, uint8_t flags)
         case Constant::Type_Table:
         {
             const TableShape& shape = tableShapes[c.valueTable];
-            writeByte(ss, LBC_CONSTANT_TABLE);
-            writeVarInt(ss, uint32_t(shape.length));
-            for (unsigned int i = 0; i < shape.length; ++i)
-                writeVarInt(ss, shape.keys[i]);
+            if (shape.hasConstants)
+            {
+                writeByte(ss, LBC_CONSTANT_TABLE_WITH_CONSTANTS);
+                writeVarInt(ss, uint32_t(shape.length));
+                for (unsigned int i = 0; i < shape.length; ++i)
+                {
+                    writeVarInt(ss, shape.keys[i]);
+                    writeInt(ss, shape.constants[i]);
+                }
+            }
+            else
+            {
+                writeByte(ss, LBC_CONSTANT_TABLE);
+                writeVarInt(ss, uint32_t(shape.length));
+                for (unsigned int i = 0; i < shape.length; ++i)
+                    writeVarInt(ss, shape.keys[i]);
+            }
             break;
         }
 
@@ -1214,6 +1243,263 @@ void BytecodeBuilder::expandJumps()
     lines.swap(newlines);
 }
 
+void BytecodeBuilder::removeRedundantInstructions()
+{
+    // jump trampolines and JUMPX make offset rewriting more complicated; this is rare enough that we skip the processing
+    if (hasLongJumps)
+        return;
+
+    size_t count = insns.size();
+
+    LUAU_ASSERT(lines.size() == count);
+
+    // instructions that can be reached through a jump, and instructions that are covered by a skip offset which we can't rewrite
+    std::vector<bool> targets(count + 1);
+    std::vector<bool> pinned(count);
+
+    size_t last = 0;
+
+    for (size_t i = 0; i < count;)
+    {
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insns[i]));
+        int target = getJumpTarget(insns[i], uint32_t(i));
+
+        if (target >= 0)
+        {
+            LUAU_ASSERT(size_t(target) <= count);
+            targets[target] = true;
+
+            if (isFastCall(op) || isSkipC(op))
+                for (size_t j = i + 1; j < size_t(target); ++j)
+                    pinned[j] = true;
+        }
+
+        // coverage instructions in unreachable code are kept to report the lines as not executed
+        // CLOSEUPVALS is kept since bytecode validation expects every CAPTURE REF to be followed by one in the instruction stream
+        if (op == LOP_COVERAGE || op == LOP_CLOSEUPVALS)
+            pinned[i] = true;
+
+        last = i;
+        i += getOpLength(op);
+    }
+
+    // the last instruction is kept even if it's unreachable so that the function never ends with a jump that could fall through
+    pinned[last] = true;
+
+    enum RemovalReason : uint8_t
+    {
+        Removal_None,
+        Removal_Unreachable,
+        Removal_Jump,
+        Removal_Move,
+    };
+
+    std::vector<uint8_t> removed(count, Removal_None);
+    bool changed = false;
+
+    // remove code that follows an unconditional control transfer and is not a jump target
+    bool reachable = true;
+
+    for (size_t i = 0; i < count;)
+    {
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insns[i]));
+        int oplen = getOpLength(op);
+
+        if (targets[i])
+            reachable = true;
+
+        if (!reachable && !pinned[i])
+        {
+            for (int j = 0; j < oplen; ++j)
+                removed[i + j] = Removal_Unreachable;
+
+            changed = true;
+        }
+        else if (op == LOP_JUMP || op == LOP_JUMPBACK || op == LOP_RETURN)
+        {
+            reachable = false;
+        }
+
+        i += oplen;
+    }
+
+    // remove forward jumps that only skip over removed instructions; conditional jumps are only removed when the condition has no side effects
+    // we process jumps from the end so that a chain of jumps to the same target gets removed completely
+    std::sort(jumps.begin(), jumps.end(), [](const Jump& lhs, const Jump& rhs) {
+        return lhs.source > rhs.source;
+    });
+
+    for (const Jump& jump : jumps)
+    {
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insns[jump.source]));
+
+        if (op != LOP_JUMP && op != LOP_JUMPIF && op != LOP_JUMPIFNOT)
+            continue;
+
+        if (removed[jump.source] || pinned[jump.source] || jump.target <= jump.source)
+            continue;
+
+        bool skipsRemoved = true;
+
+        for (uint32_t j = jump.source + 1; j < jump.target && skipsRemoved; ++j)
+            skipsRemoved = removed[j] != Removal_None;
+
+        if (skipsRemoved)
+        {
+            removed[jump.source] = Removal_Jump;
+            changed = true;
+        }
+    }
+
+    // remove moves that undo the move immediately preceding them (MOVE R1 R2; MOVE R2 R1), as well as moves of a register into itself
+    size_t previous = ~size_t(0);
+
+    for (size_t i = 0; i < count;)
+    {
+        uint32_t insn = insns[i];
+        int oplen = getOpLength(LuauOpcode(LUAU_INSN_OP(insn)));
+
+        if (LUAU_INSN_OP(insn) == LOP_MOVE && !removed[i] && !pinned[i] && !targets[i])
+        {
+            bool redundant = LUAU_INSN_A(insn) == LUAU_INSN_B(insn);
+
+            if (!redundant && previous != ~size_t(0) && previous + 1 == i && !removed[previous])
+            {
+                uint32_t prev = insns[previous];
+
+                redundant = LUAU_INSN_OP(prev) == LOP_MOVE && LUAU_INSN_A(prev) == LUAU_INSN_B(insn) && LUAU_INSN_B(prev) == LUAU_INSN_A(insn);
+            }
+
+            if (redundant)
+            {
+                removed[i] = Removal_Move;
+                changed = true;
+            }
+        }
+
+        previous = i;
+        i += oplen;
+    }
+
+    if (!changed)
+        return;
+
+    // compact instruction stream, remap[oldpc] = newpc; removed instructions are mapped to the next instruction that was kept
+    std::vector<uint32_t> remap(count + 1);
+
+    std::vector<uint32_t> newinsns;
+    std::vector<int> newlines;
+
+    newinsns.reserve(count);
+    newlines.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        remap[i] = uint32_t(newinsns.size());
+
+        if (!removed[i])
+        {
+            newinsns.push_back(insns[i]);
+            newlines.push_back(lines[i]);
+        }
+    }
+
+    remap[count] = uint32_t(newinsns.size());
+
+    // debug remarks describe each removal at the location of the next instruction that was kept
+    std::vector<std::pair<uint32_t, std::string>> remarks;
+
+    if (dumpFlags & Dump_Remarks)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t pc = std::min(remap[i], uint32_t(newinsns.size() - 1));
+
+            if (removed[i] == Removal_Unreachable && (i == 0 || removed[i - 1] != Removal_Unreachable))
+            {
+                int unreachable = 0;
+
+                for (size_t j = i; j < count && removed[j] == Removal_Unreachable; j += getOpLength(LuauOpcode(LUAU_INSN_OP(insns[j]))))
+                    unreachable++;
+
+                remarks.emplace_back(pc, format("removed %d unreachable instructions", unreachable));
+            }
+            else if (removed[i] == Removal_Jump)
+            {
+                remarks.emplace_back(pc, "removed jump to next instruction");
+            }
+            else if (removed[i] == Removal_Move)
+            {
+                remarks.emplace_back(pc, format("removed redundant MOVE R%d R%d", LUAU_INSN_A(insns[i]), LUAU_INSN_B(insns[i])));
+            }
+        }
+    }
+
+    // patch jump offsets; skip offsets don't need patching since the instructions they cover are never removed
+    for (size_t i = 0; i < count;)
+    {
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insns[i]));
+
+        if (!removed[i] && isJumpD(op))
+        {
+            uint32_t target = uint32_t(getJumpTarget(insns[i], uint32_t(i)));
+            int offset = int(remap[target]) - int(remap[i]) - 1;
+
+            // removal can only make jumps shorter
+            LUAU_ASSERT(int16_t(offset) == offset);
+
+            uint32_t& insn = newinsns[remap[i]];
+
+            insn &= 0xffff;
+            insn |= uint16_t(offset) << 16;
+        }
+
+        i += getOpLength(op);
+    }
+
+    std::vector<Jump> newjumps;
+    newjumps.reserve(jumps.size());
+
+    for (const Jump& jump : jumps)
+        if (!removed[jump.source])
+            newjumps.push_back({remap[jump.source], remap[jump.target]});
+
+    for (DebugLocal& local : debugLocals)
+    {
+        local.startpc = remap[local.startpc];
+        local.endpc = remap[local.endpc];
+    }
+
+    for (TypedLocal& local : typedLocals)
+    {
+        local.startpc = remap[local.startpc];
+        local.endpc = remap[local.endpc];
+    }
+
+    for (auto& remark : debugRemarks)
+        remark.first = remap[remark.first];
+
+    for (auto& [pc, text] : remarks)
+    {
+        size_t offset = debugRemarkBuffer.size();
+
+        debugRemarkBuffer += text;
+        debugRemarkBuffer += '\0';
+
+        debugRemarks.emplace_back(pc, uint32_t(offset));
+        dumpRemarks.emplace_back(newlines[pc], std::move(text));
+    }
+
+    // remarks are dumped in instruction order
+    std::stable_sort(debugRemarks.begin(), debugRemarks.end(), [](auto& lhs, auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    insns.swap(newinsns);
+    lines.swap(newlines);
+    jumps.swap(newjumps);
+}
+
 std::string BytecodeBuilder::getError(const std::string& message)
 {
     // 0 acts as a special marker for error bytecode (it's equal to LBC_VERSION_TARGET for valid bytecode blobs)
@@ -1227,7 +1513,7 @@ std::string BytecodeBuilder::getError(const std::string& message)
 uint8_t BytecodeBuilder::getVersion()
 {
     // This function usually returns LBC_VERSION_TARGET but may sometimes return a higher number (within LBC_VERSION_MIN/MAX) under fast flags
-    if (FFlag::LuauCompileFastcall3)
+    if (FFlag::LuauCompileFastcall3 || FFlag::LuauCompileTableConstants)
         return 6;
 
     return LBC_VERSION_TARGET;
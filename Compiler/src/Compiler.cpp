@@ -28,6 +28,10 @@ LUAU_FASTINTVARIABLE(LuauCompileInlineDepth, 5)
 
 LUAU_FASTFLAGVARIABLE(LuauCompileUserdataInfo, false)
 LUAU_FASTFLAGVARIABLE(LuauCompileFastcall3, false)
+LUAU_FASTFLAGVARIABLE(LuauCompileVectorLibrary, false)
+LUAU_FASTFLAGVARIABLE(LuauCompileTableRemove, false)
+LUAU_FASTFLAGVARIABLE(LuauCompileTableConstants, false)
+LUAU_FASTFLAGVARIABLE(LuauCompileStringFormat, false)
 
 LUAU_FASTFLAG(LuauNativeAttribute)
 
@@ -45,6 +49,13 @@ static const uint8_t kInvalidReg = 255;
 
 static const uint32_t kDefaultAllocPc = ~0u;
 
+// marks locals that have to stay in their register until the end of the declaring block
+static const size_t kLocalAlwaysLive = ~size_t(0);
+
+// limits on closures created ahead of a loop; each of them keeps a register occupied for the duration of the loop
+static const size_t kMaxHoistedClosures = 8;
+static const unsigned int kMaxHoistedClosureTop = 64;
+
 CompileError::CompileError(const Location& location, const std::string& message)
     : location(location)
     , message(message)
@@ -101,7 +112,10 @@ struct Compiler
         , options(options)
         , functions(nullptr)
         , locals(nullptr)
+        , localLifetimes(nullptr)
+        , readonlyTables(nullptr)
         , globals(AstName())
+        , globalConstants(AstName())
         , variables(nullptr)
         , constants(nullptr)
         , locstants(nullptr)
@@ -208,6 +222,8 @@ struct Compiler
 
         RegScope rs(this);
 
+        topLevel = func->functionDepth == 0;
+
         bool self = func->self != 0;
         uint32_t fid = bytecode.beginFunction(uint8_t(self + func->args.size), func->vararg);
 
@@ -229,7 +245,10 @@ struct Compiler
         AstStatBlock* stat = func->body;
 
         for (size_t i = 0; i < stat->body.size; ++i)
+        {
             compileStat(stat->body.data[i]);
+            popDeadLocals(stat, argCount, i);
+        }
 
         // valid function bytecode must always end with RETURN
         // we elide this if we're guaranteed to hit a RETURN statement regardless of the control flow
@@ -276,6 +295,10 @@ struct Compiler
 
         popLocals(0);
 
+        // this needs to run after all debug locals have been recorded since it remaps their ranges
+        if (options.optimizationLevel >= 2)
+            bytecode.removeRedundantInstructions();
+
         if (bytecode.getInstructionCount() > kMaxInstructionCount)
             CompileError::raise(func->location, "Exceeded function instruction limit; split the function into parts to compile");
 
@@ -318,6 +341,7 @@ struct Compiler
         argCount = 0;
 
         hasLoops = false;
+        topLevel = false;
 
         return fid;
     }
@@ -411,7 +435,6 @@ struct Compiler
 
     void compileExprSelectVararg(AstExprCall* expr, uint8_t target, uint8_t targetCount, bool targetTop, bool multRet, uint8_t regs)
     {
-        LUAU_ASSERT(targetCount == 1);
         LUAU_ASSERT(!expr->self);
         LUAU_ASSERT(expr->args.size == 2 && expr->args.data[1]->is<AstExprVarargs>());
 
@@ -723,7 +746,7 @@ struct Compiler
         inlineFrames.push_back({func, oldLocals, target, targetCount});
 
         // fold constant values updated above into expressions in the function body
-        foldConstants(constants, variables, locstants, builtinsFold, builtinsFoldMathK, func->body);
+        foldConstants(constants, variables, locstants, globalConstantsFold, builtinsFold, builtinsFoldMathK, pureCallsFold, func->body);
 
         bool usedFallthrough = false;
 
@@ -768,7 +791,7 @@ struct Compiler
                 var->type = Constant::Type_Unknown;
         }
 
-        foldConstants(constants, variables, locstants, builtinsFold, builtinsFoldMathK, func->body);
+        foldConstants(constants, variables, locstants, globalConstantsFold, builtinsFold, builtinsFoldMathK, pureCallsFold, func->body);
     }
 
     void compileExprCall(AstExprCall* expr, uint8_t target, uint8_t targetCount, bool targetTop = false, bool multRet = false)
@@ -826,15 +849,9 @@ struct Compiler
                 bytecode.addDebugRemark("builtin %s/%d%s", builtin.method.value, int(expr->args.size), lastMult ? "+" : "");
         }
 
+        // Optimization: compile select(_, ...) as FASTCALL1; the builtin will read variadic arguments directly
         if (bfid == LBF_SELECT_VARARG)
-        {
-            // Optimization: compile select(_, ...) as FASTCALL1; the builtin will read variadic arguments directly
-            // note: for now we restrict this to single-return expressions since our runtime code doesn't deal with general cases
-            if (multRet == false && targetCount == 1)
-                return compileExprSelectVararg(expr, target, targetCount, targetTop, multRet, regs);
-            else
-                bfid = -1;
-        }
+            return compileExprSelectVararg(expr, target, targetCount, targetTop, multRet, regs);
 
         // Optimization: for bit32.extract with constant in-range f/w we compile using FASTCALL2K and a special builtin
         if (bfid == LBF_BIT32_EXTRACT && expr->args.size == 3 && isConstant(expr->args.data[1]) && isConstant(expr->args.data[2]))
@@ -1004,6 +1021,18 @@ struct Compiler
 
     void compileExprFunction(AstExprFunction* expr, uint8_t target)
     {
+        // closures hoisted out of the loop we're in have already been created
+        for (const HoistedClosure& hc : hoistedClosures)
+        {
+            if (hc.func == expr)
+            {
+                if (hc.reg != target)
+                    bytecode.emitABC(LOP_MOVE, target, hc.reg, 0);
+
+                return;
+            }
+        }
+
         RegScope rs(this);
 
         const Function* f = functions.find(expr);
@@ -1079,6 +1108,114 @@ struct Compiler
         }
     }
 
+    bool isLoopInvariantClosure(AstExprFunction* func)
+    {
+        const Function* f = functions.find(func);
+        if (!f || f->upvals.empty())
+            return false;
+
+        for (AstLocal* uv : f->upvals)
+        {
+            // note: arguments and loop variables are only tracked when they are written to
+            Variable* ul = variables.find(uv);
+
+            if (ul && ul->written)
+                return false;
+
+            // locals declared inside the loop don't have a register yet; constants and upvalues of the current function are always invariant
+            if (getLocalReg(uv) < 0 && uv->functionDepth >= func->functionDepth - 1)
+            {
+                const Constant* uc = locstants.find(uv);
+
+                if (!uc || uc->type == Constant::Type_Unknown)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool isHoistedClosure(AstExprFunction* func) const
+    {
+        for (const HoistedClosure& hc : hoistedClosures)
+        {
+            if (hc.func == func)
+                return true;
+        }
+
+        return false;
+    }
+
+    // Optimization: closures in a loop that only capture immutable values that are defined outside of the loop get the same upvalues on
+    // every iteration, so they are created once before the loop instead of allocating a new closure per iteration. Closures that refer to
+    // top-level upvalues are already shared via DUPCLOSURE; like DUPCLOSURE, this breaks function identity so it's disabled with setfenv.
+    // Returns the previous size of hoistedClosures which needs to be restored once the loop is compiled.
+    size_t hoistLoopClosures(AstStat* loop)
+    {
+        struct Visitor : AstVisitor
+        {
+            std::vector<AstExprFunction*> closures;
+
+            bool visit(AstExprFunction* node) override
+            {
+                closures.push_back(node);
+
+                // closures nested in the function body are created when the function runs
+                return false;
+            }
+        };
+
+        size_t oldHoisted = hoistedClosures.size();
+
+        if (options.optimizationLevel < 1 || setfenvUsed || !inlineFrames.empty())
+            return oldHoisted;
+
+        Visitor visitor;
+
+        if (AstStatWhile* stat = loop->as<AstStatWhile>())
+        {
+            // the loop is removed entirely when the condition is always false
+            if (isConstantFalse(stat->condition))
+                return oldHoisted;
+
+            stat->condition->visit(&visitor);
+            stat->body->visit(&visitor);
+        }
+        else if (AstStatRepeat* stat = loop->as<AstStatRepeat>())
+        {
+            stat->body->visit(&visitor);
+            stat->condition->visit(&visitor);
+        }
+        else if (AstStatFor* stat = loop->as<AstStatFor>())
+        {
+            stat->body->visit(&visitor);
+        }
+        else if (AstStatForIn* stat = loop->as<AstStatForIn>())
+        {
+            stat->body->visit(&visitor);
+        }
+
+        size_t count = 0;
+
+        for (AstExprFunction* func : visitor.closures)
+        {
+            if (count >= kMaxHoistedClosures || regTop >= kMaxHoistedClosureTop)
+                break;
+
+            // closures that are shared or were hoisted out of an enclosing loop are already cheap
+            if (shouldShareClosure(func) || isHoistedClosure(func) || !isLoopInvariantClosure(func))
+                continue;
+
+            uint8_t reg = allocReg(func, 1);
+            compileExprFunction(func, reg);
+
+            hoistedClosures.push_back({func, reg});
+            count++;
+        }
+
+        return oldHoisted;
+    }
+
     LuauOpcode getUnaryOp(AstExprUnary::Op op)
     {
         switch (op)
@@ -1786,7 +1923,10 @@ struct Compiler
 
         uint8_t baseReg = allocReg(expr, unsigned(2 + expr->expressions.size));
 
-        emitLoadK(baseReg, formatStringIndex);
+        // Optimization: the format string is placed in the self slot so that FASTCALL can see it as the first argument of the call
+        bool fastcall = FFlag::LuauCompileStringFormat && options.optimizationLevel >= 1;
+
+        emitLoadK(fastcall ? uint8_t(baseReg + 1) : baseReg, formatStringIndex);
 
         for (size_t index = 0; index < expr->expressions.size; ++index)
             compileExprTempTop(expr->expressions.data[index], uint8_t(baseReg + 2 + index));
@@ -1797,8 +1937,27 @@ struct Compiler
         if (formatMethodIndex < 0)
             CompileError::raise(expr->location, "Exceeded constant limit; simplify the code to compile");
 
-        bytecode.emitABC(LOP_NAMECALL, baseReg, baseReg, uint8_t(BytecodeBuilder::getStringHash(formatMethod)));
+        size_t fastcallLabel = 0;
+
+        // Optimization: the builtin concatenates literal text and converted values into a single allocation, and the method call is only used
+        // as a fallback for values that may have a __tostring metamethod
+        if (fastcall)
+        {
+            fastcallLabel = bytecode.emitLabel();
+            bytecode.emitABC(LOP_FASTCALL, LBF_STRING_FORMAT, 0, 0);
+        }
+
+        bytecode.emitABC(LOP_NAMECALL, baseReg, fastcall ? uint8_t(baseReg + 1) : baseReg, uint8_t(BytecodeBuilder::getStringHash(formatMethod)));
         bytecode.emitAux(formatMethodIndex);
+
+        if (fastcall)
+        {
+            size_t callLabel = bytecode.emitLabel();
+
+            if (!bytecode.patchSkipC(fastcallLabel, callLabel))
+                CompileError::raise(expr->location, "Exceeded jump distance limit; simplify the code to compile");
+        }
+
         bytecode.emitABC(LOP_CALL, baseReg, uint8_t(expr->expressions.size + 2), 2);
         bytecode.emitABC(LOP_MOVE, target, baseReg, 0);
     }
@@ -1812,6 +1971,30 @@ struct Compiler
         return hashSize == 0 ? 0 : uint8_t(hashSizeLog2 + 1);
     }
 
+    bool isTemplateValue(AstExprTable* expr, size_t index)
+    {
+        const AstExprTable::Item& item = expr->items.data[index];
+
+        const Constant* cv = constants.find(item.value);
+
+        if (!cv || cv->type == Constant::Type_Unknown || cv->type == Constant::Type_Nil)
+            return false;
+
+        AstExprConstantString* ckey = item.key->as<AstExprConstantString>();
+        LUAU_ASSERT(ckey);
+
+        // when the key is repeated, the assignments have to be performed in order
+        for (size_t i = 0; i < expr->items.size; ++i)
+        {
+            AstExprConstantString* other = expr->items.data[i].key->as<AstExprConstantString>();
+
+            if (i != index && other && sref(other->value) == sref(ckey->value))
+                return false;
+        }
+
+        return true;
+    }
+
     void compileExprTable(AstExprTable* expr, uint8_t target, bool targetTemp)
     {
         // Optimization: if the table is empty, we can compute it directly into the target
@@ -1868,6 +2051,9 @@ struct Compiler
         // Optimization: if target is a temp register, we can clobber it which allows us to compute the result directly into it
         uint8_t reg = targetTemp ? target : allocReg(expr, 1);
 
+        // fields with constant values that are stored in the table template and don't need to be assigned after DUPTABLE
+        bool templateValues[BytecodeBuilder::TableShape::kMaxLength] = {};
+
         // Optimization: when all items are record fields, use template tables to compile expression
         if (arraySize == 0 && indexSize == 0 && hashSize == recordSize && recordSize >= 1 && recordSize <= BytecodeBuilder::TableShape::kMaxLength)
         {
@@ -1886,7 +2072,20 @@ struct Compiler
                     CompileError::raise(ckey->location, "Exceeded constant limit; simplify the code to compile");
 
                 LUAU_ASSERT(shape.length < BytecodeBuilder::TableShape::kMaxLength);
-                shape.keys[shape.length++] = int16_t(cid);
+                shape.keys[shape.length] = int16_t(cid);
+                shape.constants[shape.length] = -1;
+
+                // Optimization: constant values are stored in the template, so repeatedly constructed tables are created by a single DUPTABLE
+                // top-level code outside of loops only executes once, and building a template for it at load time would allocate the table twice
+                // note that nil values and values of repeated keys are still assigned explicitly
+                if (FFlag::LuauCompileTableConstants && options.optimizationLevel >= 1 && (!topLevel || !loops.empty()) && isTemplateValue(expr, i))
+                {
+                    shape.constants[shape.length] = getConstantIndex(item.value);
+                    shape.hasConstants = true;
+                    templateValues[i] = true;
+                }
+
+                shape.length++;
             }
 
             int32_t tid = bytecode.addConstantTable(shape);
@@ -1903,6 +2102,9 @@ struct Compiler
             {
                 bytecode.emitABC(LOP_NEWTABLE, reg, uint8_t(encodedHashSize), 0);
                 bytecode.emitAux(0);
+
+                // without a template, all values need to be assigned
+                std::fill(templateValues, templateValues + BytecodeBuilder::TableShape::kMaxLength, false);
             }
         }
         else
@@ -1959,7 +2161,11 @@ struct Compiler
             }
 
             // items with a key are set one by one via SETTABLE/SETTABLEKS/SETTABLEN
-            if (key)
+            if (key && i < BytecodeBuilder::TableShape::kMaxLength && templateValues[i])
+            {
+                // value is already stored in the table template
+            }
+            else if (key)
             {
                 RegScope rsi(this);
 
@@ -3023,7 +3229,7 @@ struct Compiler
             locstants[var].type = Constant::Type_Number;
             locstants[var].valueNumber = from + iv * step;
 
-            foldConstants(constants, variables, locstants, builtinsFold, builtinsFoldMathK, stat);
+            foldConstants(constants, variables, locstants, globalConstantsFold, builtinsFold, builtinsFoldMathK, pureCallsFold, stat);
 
             size_t iterJumps = loopJumps.size();
 
@@ -3051,7 +3257,132 @@ struct Compiler
         // clean up fold state in case we need to recompile - normally we compile the loop body once, but due to inlining we may need to do it again
         locstants[var].type = Constant::Type_Unknown;
 
-        foldConstants(constants, variables, locstants, builtinsFold, builtinsFoldMathK, stat);
+        foldConstants(constants, variables, locstants, globalConstantsFold, builtinsFold, builtinsFoldMathK, pureCallsFold, stat);
+    }
+
+    AstExprTable* getReadonlyArray(AstExprCall* call)
+    {
+        if (!builtinsFold || call->args.size != 1 || !getBuiltin(call->func, globals, variables).isGlobal("ipairs"))
+            return nullptr;
+
+        AstExprLocal* arg = call->args.data[0]->as<AstExprLocal>();
+        if (!arg)
+            return nullptr;
+
+        const bool* readonly = readonlyTables.find(arg->local);
+        const Variable* var = variables.find(arg->local);
+
+        if (!readonly || !*readonly || !var || var->written || !var->init)
+            return nullptr;
+
+        return var->init->as<AstExprTable>();
+    }
+
+    bool tryCompileUnrolledForIn(AstStatForIn* stat, AstExprTable* table, int thresholdBase, int thresholdMaxBoost)
+    {
+        // ipairs stops at the first nil element, so we need to know all elements of the array
+        for (const AstExprTable::Item& item : table->items)
+        {
+            Constant c = item.kind == AstExprTable::Item::List ? getConstant(item.value) : Constant();
+
+            if (c.type == Constant::Type_Unknown || c.type == Constant::Type_Nil)
+            {
+                bytecode.addDebugRemark("loop unroll failed: array elements are not constant");
+                return false;
+            }
+        }
+
+        int tripCount = int(table->items.size);
+
+        if (tripCount > thresholdBase)
+        {
+            bytecode.addDebugRemark("loop unroll failed: too many iterations (%d)", tripCount);
+            return false;
+        }
+
+        for (AstLocal* var : stat->vars)
+        {
+            if (Variable* lv = variables.find(var); lv && lv->written)
+            {
+                bytecode.addDebugRemark("loop unroll failed: mutable loop variable");
+                return false;
+            }
+        }
+
+        uint64_t costModel = modelCost(stat->body, stat->vars.data, stat->vars.size, builtins);
+
+        // we use the same dynamic cost threshold as numeric loops; the key and the value are both constant after unrolling
+        bool varc[2] = {true, true};
+        int unrolledCost = computeCost(costModel, varc, stat->vars.size) * tripCount;
+        int baselineCost = (computeCost(costModel, nullptr, 0) + 1) * tripCount;
+        int unrollProfit = (unrolledCost == 0) ? thresholdMaxBoost : std::min(thresholdMaxBoost, 100 * baselineCost / unrolledCost);
+
+        int threshold = thresholdBase * unrollProfit / 100;
+
+        if (unrolledCost > threshold)
+        {
+            bytecode.addDebugRemark(
+                "loop unroll failed: too expensive (iterations %d, cost %d, profit %.2fx)", tripCount, unrolledCost, double(unrollProfit) / 100);
+            return false;
+        }
+
+        bytecode.addDebugRemark("loop unroll succeeded (iterations %d, cost %d, profit %.2fx)", tripCount, unrolledCost, double(unrollProfit) / 100);
+
+        compileUnrolledForIn(stat, table);
+        return true;
+    }
+
+    void compileUnrolledForIn(AstStatForIn* stat, AstExprTable* table)
+    {
+        AstLocal* key = stat->vars.data[0];
+        AstLocal* value = stat->vars.size > 1 ? stat->vars.data[1] : nullptr;
+
+        size_t oldLocals = localStack.size();
+        size_t oldJumps = loopJumps.size();
+
+        loops.push_back({oldLocals, oldLocals, nullptr});
+
+        for (size_t iv = 0; iv < table->items.size; ++iv)
+        {
+            // we need to re-fold constants in the loop body with the new values; this reuses computed constant values elsewhere in the tree
+            locstants[key].type = Constant::Type_Number;
+            locstants[key].valueNumber = double(iv + 1);
+
+            if (value)
+                locstants[value] = getConstant(table->items.data[iv].value);
+
+            foldConstants(constants, variables, locstants, globalConstantsFold, builtinsFold, builtinsFoldMathK, pureCallsFold, stat);
+
+            size_t iterJumps = loopJumps.size();
+
+            compileStat(stat->body);
+
+            // all continue jumps need to go to the next iteration
+            size_t contLabel = bytecode.emitLabel();
+
+            for (size_t i = iterJumps; i < loopJumps.size(); ++i)
+                if (loopJumps[i].type == LoopJump::Continue)
+                    patchJump(stat, loopJumps[i].label, contLabel);
+        }
+
+        // all break jumps need to go past the loop
+        size_t endLabel = bytecode.emitLabel();
+
+        for (size_t i = oldJumps; i < loopJumps.size(); ++i)
+            if (loopJumps[i].type == LoopJump::Break)
+                patchJump(stat, loopJumps[i].label, endLabel);
+
+        loopJumps.resize(oldJumps);
+
+        loops.pop_back();
+
+        // clean up fold state in case we need to recompile - normally we compile the loop body once, but due to inlining we may need to do it again
+        locstants[key].type = Constant::Type_Unknown;
+
+        if (value)
+            locstants[value].type = Constant::Type_Unknown;
+
+        foldConstants(constants, variables, locstants, globalConstantsFold, builtinsFold, builtinsFoldMathK, pureCallsFold, stat);
     }
 
     void compileStatFor(AstStatFor* stat)
@@ -3129,6 +3460,12 @@ struct Compiler
     {
         RegScope rs(this);
 
+        // Optimization: small loops over arrays that are never modified can be unrolled when it is profitable
+        if (options.optimizationLevel >= 2 && stat->vars.size <= 2 && stat->values.size == 1 && stat->values.data[0]->is<AstExprCall>())
+            if (AstExprTable* table = getReadonlyArray(stat->values.data[0]->as<AstExprCall>()))
+                if (tryCompileUnrolledForIn(stat, table, FInt::LuauCompileLoopUnrollThreshold, FInt::LuauCompileLoopUnrollThresholdMaxBoost))
+                    return;
+
         size_t oldLocals = localStack.size();
         size_t oldJumps = loopJumps.size();
 
@@ -3509,7 +3846,10 @@ struct Compiler
             size_t oldLocals = localStack.size();
 
             for (size_t i = 0; i < stat->body.size; ++i)
+            {
                 compileStat(stat->body.data[i]);
+                popDeadLocals(stat, oldLocals, i);
+            }
 
             closeLocals(oldLocals);
 
@@ -3521,11 +3861,19 @@ struct Compiler
         }
         else if (AstStatWhile* stat = node->as<AstStatWhile>())
         {
+            RegScope rs(this);
+            size_t oldHoisted = hoistLoopClosures(stat);
+
             compileStatWhile(stat);
+            hoistedClosures.resize(oldHoisted);
         }
         else if (AstStatRepeat* stat = node->as<AstStatRepeat>())
         {
+            RegScope rs(this);
+            size_t oldHoisted = hoistLoopClosures(stat);
+
             compileStatRepeat(stat);
+            hoistedClosures.resize(oldHoisted);
         }
         else if (node->is<AstStatBreak>())
         {
@@ -3587,11 +3935,19 @@ struct Compiler
         }
         else if (AstStatFor* stat = node->as<AstStatFor>())
         {
+            RegScope rs(this);
+            size_t oldHoisted = hoistLoopClosures(stat);
+
             compileStatFor(stat);
+            hoistedClosures.resize(oldHoisted);
         }
         else if (AstStatForIn* stat = node->as<AstStatForIn>())
         {
+            RegScope rs(this);
+            size_t oldHoisted = hoistLoopClosures(stat);
+
             compileStatForIn(stat);
+            hoistedClosures.resize(oldHoisted);
         }
         else if (AstStatAssign* stat = node->as<AstStatAssign>())
         {
@@ -3756,6 +4112,121 @@ struct Compiler
         localStack.resize(start);
     }
 
+    static bool isValueType(LuauBytecodeType ty)
+    {
+        ty = LuauBytecodeType(ty & ~LBC_TYPE_OPTIONAL_BIT);
+
+        return ty == LBC_TYPE_NIL || ty == LBC_TYPE_BOOLEAN || ty == LBC_TYPE_NUMBER || ty == LBC_TYPE_VECTOR;
+    }
+
+    // checks if the local can only hold values that don't reference GC objects; note that type annotations are trusted here
+    bool isValueTypeLocal(AstLocal* local, int depth = 0)
+    {
+        if (LuauBytecodeType* ty = localTypes.find(local))
+            return isValueType(*ty);
+
+        Variable* v = variables.find(local);
+
+        return v && !v->written && v->init && isValueTypeExpr(v->init, depth + 1);
+    }
+
+    bool isValueTypeExpr(AstExpr* node, int depth)
+    {
+        // limits the traversal of local initializers
+        if (depth > 16)
+            return false;
+
+        if (const Constant* cv = constants.find(node); cv && cv->type != Constant::Type_Unknown)
+            return cv->type != Constant::Type_String;
+
+        if (LuauBytecodeType* ty = exprTypes.find(node))
+            if (isValueType(*ty))
+                return true;
+
+        if (AstExprGroup* expr = node->as<AstExprGroup>())
+            return isValueTypeExpr(expr->expr, depth);
+        else if (AstExprTypeAssertion* expr = node->as<AstExprTypeAssertion>())
+            return isValueTypeExpr(expr->expr, depth);
+        else if (AstExprLocal* expr = node->as<AstExprLocal>())
+            return isValueTypeLocal(expr->local, depth);
+        else if (AstExprUnary* expr = node->as<AstExprUnary>())
+            return expr->op == AstExprUnary::Not || (expr->op == AstExprUnary::Minus && isValueTypeExpr(expr->expr, depth));
+        else if (AstExprIfElse* expr = node->as<AstExprIfElse>())
+            return isValueTypeExpr(expr->trueExpr, depth) && isValueTypeExpr(expr->falseExpr, depth);
+        else if (AstExprBinary* expr = node->as<AstExprBinary>())
+        {
+            switch (expr->op)
+            {
+            case AstExprBinary::CompareNe:
+            case AstExprBinary::CompareEq:
+            case AstExprBinary::CompareLt:
+            case AstExprBinary::CompareLe:
+            case AstExprBinary::CompareGt:
+            case AstExprBinary::CompareGe:
+                return true;
+
+            case AstExprBinary::Concat:
+                return false;
+
+            default:
+                // arithmetic on values that aren't GC objects can't invoke metamethods, and 'and'/'or' return one of the operands
+                return isValueTypeExpr(expr->left, depth) && isValueTypeExpr(expr->right, depth);
+            }
+        }
+
+        return false;
+    }
+
+    // Optimization: locals declared in the block that aren't used by the remaining statements release their registers for future locals
+    // this is limited to locals that don't hold references to GC objects, so that the lifetime of objects isn't affected
+    void popDeadLocals(AstStatBlock* block, size_t start, size_t index)
+    {
+        if (localLifetimes.empty())
+            return;
+
+        size_t dead = localStack.size();
+
+        while (dead > start)
+        {
+            const LocalLifetime* lifetime = localLifetimes.find(localStack[dead - 1]);
+            const Local* l = locals.find(localStack[dead - 1]);
+            LUAU_ASSERT(l);
+
+            if (!lifetime || lifetime->block != block || lifetime->lastUse > index || l->captured || !isValueTypeLocal(localStack[dead - 1]))
+                break;
+
+            dead--;
+        }
+
+        if (dead == localStack.size())
+            return;
+
+        // registers are allocated as a stack, so we can only release them when dead locals occupy all registers at the top
+        bool owned[256] = {};
+        unsigned int reg = regTop;
+
+        for (size_t i = dead; i < localStack.size(); ++i)
+        {
+            const Local* l = locals.find(localStack[i]);
+
+            owned[l->reg] = true;
+            reg = std::min(reg, unsigned(l->reg));
+        }
+
+        for (unsigned int r = reg; r < regTop; ++r)
+            if (!owned[r])
+                return;
+
+        // locals that alias a register of a dead local (see compileStatLocal) keep it alive
+        for (size_t i = 0; i < dead; ++i)
+            if (locals.find(localStack[i])->reg >= reg)
+                return;
+
+        popLocals(dead);
+
+        regTop = reg;
+    }
+
     void patchJump(AstNode* node, size_t label, size_t target)
     {
         if (!bytecode.patchJumpD(label, target))
@@ -3967,6 +4438,176 @@ struct Compiler
         std::vector<AstLocal*> upvals;
     };
 
+    struct LocalLifetime
+    {
+        AstStatBlock* block = nullptr;
+        size_t lastUse = 0; // index of the last statement in the declaring block that refers to the local
+    };
+
+    struct LocalLifetimeVisitor : AstVisitor
+    {
+        struct Frame
+        {
+            AstStatBlock* block;
+            size_t index;
+        };
+
+        DenseHashMap<AstLocal*, LocalLifetime>& lifetimes;
+        std::vector<Frame> frames;
+
+        LocalLifetimeVisitor(DenseHashMap<AstLocal*, LocalLifetime>& lifetimes)
+            : lifetimes(lifetimes)
+        {
+        }
+
+        void declare(AstLocal* local)
+        {
+            LUAU_ASSERT(!frames.empty());
+
+            lifetimes[local] = {frames.back().block, frames.back().index};
+        }
+
+        bool visit(AstStatBlock* node) override
+        {
+            frames.push_back({node, 0});
+
+            for (size_t i = 0; i < node->body.size; ++i)
+            {
+                frames.back().index = i;
+                node->body.data[i]->visit(this);
+            }
+
+            frames.pop_back();
+
+            return false;
+        }
+
+        bool visit(AstStatLocal* node) override
+        {
+            for (AstLocal* local : node->vars)
+                declare(local);
+
+            return true;
+        }
+
+        bool visit(AstStatLocalFunction* node) override
+        {
+            declare(node->name);
+
+            return true;
+        }
+
+        bool visit(AstExprLocal* node) override
+        {
+            LocalLifetime* lifetime = lifetimes.find(node->local);
+
+            if (!lifetime)
+                return false;
+
+            // uses from nested functions can happen at any point, and so can uses that aren't nested in the declaring block (repeat..until)
+            if (!node->upvalue)
+            {
+                for (size_t i = frames.size(); i > 0; --i)
+                {
+                    if (frames[i - 1].block == lifetime->block)
+                    {
+                        lifetime->lastUse = std::max(lifetime->lastUse, frames[i - 1].index);
+                        return false;
+                    }
+                }
+            }
+
+            lifetime->lastUse = kLocalAlwaysLive;
+            return false;
+        }
+    };
+
+    // tracks locals initialized with table constructors that are only ever read from; since the table is never modified or exposed to other
+    // code, its contents stay the same as the contents of the constructor
+    struct ReadonlyTableVisitor : AstVisitor
+    {
+        DenseHashMap<AstLocal*, bool>& tables;
+
+        ReadonlyTableVisitor(DenseHashMap<AstLocal*, bool>& tables)
+            : tables(tables)
+        {
+        }
+
+        void escape(AstExpr* expr)
+        {
+            if (AstExprLocal* el = expr->as<AstExprLocal>())
+                if (bool* readonly = tables.find(el->local))
+                    *readonly = false;
+        }
+
+        bool visit(AstStatLocal* node) override
+        {
+            for (size_t i = 0; i < node->vars.size && i < node->values.size; ++i)
+                if (node->values.data[i]->is<AstExprTable>())
+                    tables[node->vars.data[i]] = true;
+
+            return true;
+        }
+
+        bool visit(AstStatAssign* node) override
+        {
+            for (AstExpr* var : node->vars)
+            {
+                if (AstExprIndexName* expr = var->as<AstExprIndexName>())
+                    escape(expr->expr);
+                else if (AstExprIndexExpr* expr = var->as<AstExprIndexExpr>())
+                    escape(expr->expr);
+            }
+
+            return true;
+        }
+
+        bool visit(AstStatCompoundAssign* node) override
+        {
+            if (AstExprIndexName* expr = node->var->as<AstExprIndexName>())
+                escape(expr->expr);
+            else if (AstExprIndexExpr* expr = node->var->as<AstExprIndexExpr>())
+                escape(expr->expr);
+
+            return true;
+        }
+
+        bool visit(AstExprLocal* node) override
+        {
+            // any use of the table other than the ones allowed below could modify it
+            escape(node);
+
+            return false;
+        }
+
+        bool visit(AstExprIndexName* node) override
+        {
+            // method calls pass the table to the method
+            if (node->op == ':' || !node->expr->is<AstExprLocal>())
+                return true;
+
+            return false;
+        }
+
+        bool visit(AstExprIndexExpr* node) override
+        {
+            if (!node->expr->is<AstExprLocal>())
+                return true;
+
+            node->index->visit(this);
+            return false;
+        }
+
+        bool visit(AstExprCall* node) override
+        {
+            // the compiler only relies on this for ipairs calls that resolve to the builtin, which doesn't modify the table
+            if (AstExprGlobal* func = node->func->as<AstExprGlobal>(); func && func->name == "ipairs" && node->args.size == 1)
+                return !node->args.data[0]->is<AstExprLocal>();
+
+            return true;
+        }
+    };
+
     struct ReturnVisitor : AstVisitor
     {
         Compiler* self;
@@ -4084,13 +4725,22 @@ struct Compiler
         uint8_t data;
     };
 
+    struct HoistedClosure
+    {
+        AstExprFunction* func;
+        uint8_t reg;
+    };
+
     BytecodeBuilder& bytecode;
 
     CompileOptions options;
 
     DenseHashMap<AstExprFunction*, Function> functions;
     DenseHashMap<AstLocal*, Local> locals;
+    DenseHashMap<AstLocal*, LocalLifetime> localLifetimes;
+    DenseHashMap<AstLocal*, bool> readonlyTables;
     DenseHashMap<AstName, Global> globals;
+    DenseHashMap<AstName, Constant> globalConstants;
     DenseHashMap<AstLocal*, Variable> variables;
     DenseHashMap<AstExpr*, Constant> constants;
     DenseHashMap<AstLocal*, Constant> locstants;
@@ -4103,14 +4753,20 @@ struct Compiler
 
     BuiltinTypes builtinTypes;
 
+    // storage for string values of global constants provided by the host
+    std::vector<std::string> globalConstantStrings;
+
+    const DenseHashMap<AstName, Constant>* globalConstantsFold = nullptr;
     const DenseHashMap<AstExprCall*, int>* builtinsFold = nullptr;
     bool builtinsFoldMathK = false;
+    bool pureCallsFold = false;
 
     // compileFunction state, gets reset for every function
     unsigned int regTop = 0;
     unsigned int stackSize = 0;
     size_t argCount = 0;
     bool hasLoops = false;
+    bool topLevel = false;
 
     bool getfenvUsed = false;
     bool setfenvUsed = false;
@@ -4121,12 +4777,13 @@ struct Compiler
     std::vector<Loop> loops;
     std::vector<InlineFrame> inlineFrames;
     std::vector<Capture> captures;
+    std::vector<HoistedClosure> hoistedClosures;
     std::vector<std::unique_ptr<char[]>> interpStrings;
 };
 
 static void setCompileOptionsForNativeCompilation(CompileOptions& options)
 {
-    options.optimizationLevel = 2; // note: this might be removed in the future in favor of --!optimize
+    options.optimizationLevel = std::max(options.optimizationLevel, 2); // note: this might be removed in the future in favor of --!optimize
     options.typeInfoLevel = 1;
 }
 
@@ -4143,7 +4800,7 @@ void compileOrThrow(BytecodeBuilder& bytecode, const ParseResult& parseResult, c
     for (const HotComment& hc : parseResult.hotcomments)
     {
         if (hc.header && hc.content.compare(0, 9, "optimize ") == 0)
-            options.optimizationLevel = std::max(0, std::min(2, atoi(hc.content.c_str() + 9)));
+            options.optimizationLevel = std::max(0, std::min(3, atoi(hc.content.c_str() + 9)));
 
         if (hc.header && hc.content == "native")
         {
@@ -4187,18 +4844,72 @@ void compileOrThrow(BytecodeBuilder& bytecode, const ParseResult& parseResult, c
             compiler.builtinsFoldMathK = true;
     }
 
+    // globals with host-provided values are treated as constants, unless the module can observe or change them through assignments or fenv
+    if (options.optimizationLevel >= 1 && options.constantGlobals && options.globalConstantCb && (!compiler.getfenvUsed && !compiler.setfenvUsed))
+    {
+        size_t count = 0;
+        for (const char* const* ptr = options.constantGlobals; *ptr; ++ptr)
+            count++;
+
+        // string values are copied, so constants have to be stable in memory once recorded
+        compiler.globalConstantStrings.reserve(count);
+
+        for (const char* const* ptr = options.constantGlobals; *ptr; ++ptr)
+        {
+            AstName name = names.get(*ptr);
+
+            // globals that aren't mentioned in the source don't need to be resolved
+            if (!name.value || getGlobalState(compiler.globals, name) == Global::Written)
+                continue;
+
+            Constant value;
+            options.globalConstantCb(*ptr, reinterpret_cast<CompileConstant*>(&value));
+
+            if (value.type == Constant::Type_String)
+            {
+                std::string& storage = compiler.globalConstantStrings.emplace_back(value.valueString, value.stringLength);
+                value.valueString = storage.data();
+            }
+
+            if (value.type != Constant::Type_Unknown)
+                compiler.globalConstants[name] = value;
+        }
+
+        if (!compiler.globalConstants.empty())
+            compiler.globalConstantsFold = &compiler.globalConstants;
+    }
+
+    // calls to local functions are evaluated at compile time on optimization level 3 since this requires whole-module analysis
+    if (options.optimizationLevel >= 3 && (!compiler.getfenvUsed && !compiler.setfenvUsed))
+        compiler.pureCallsFold = true;
+
     if (options.optimizationLevel >= 1)
     {
         // this pass tracks which calls are builtins and can be compiled more efficiently
         analyzeBuiltins(compiler.builtins, compiler.globals, compiler.variables, options, root);
 
         // this pass analyzes constantness of expressions
-        foldConstants(compiler.constants, compiler.variables, compiler.locstants, compiler.builtinsFold, compiler.builtinsFoldMathK, root);
+        foldConstants(compiler.constants, compiler.variables, compiler.locstants, compiler.globalConstantsFold, compiler.builtinsFold,
+            compiler.builtinsFoldMathK, compiler.pureCallsFold, root);
 
         // this pass analyzes table assignments to estimate table shapes for initially empty tables
         predictTableShapes(compiler.tableShapes, root);
     }
 
+    // loops over tables that are never modified can be unrolled on optimization level 2
+    if (options.optimizationLevel >= 2 && names.get("ipairs").value)
+    {
+        Compiler::ReadonlyTableVisitor readonlyTableVisitor(compiler.readonlyTables);
+        root->visit(&readonlyTableVisitor);
+    }
+
+    // register reuse for dead locals ends their debug lifetime early, so it's only enabled when debug info for locals isn't needed
+    if (options.optimizationLevel >= 2 && options.debugLevel <= 1)
+    {
+        Compiler::LocalLifetimeVisitor lifetimeVisitor(compiler.localLifetimes);
+        root->visit(&lifetimeVisitor);
+    }
+
     if (FFlag::LuauCompileUserdataInfo)
     {
         if (const char* const* ptr = options.userdataTypes)
@@ -4244,6 +4955,41 @@ void compileOrThrow(BytecodeBuilder& bytecode, const ParseResult& parseResult, c
     bytecode.finalize();
 }
 
+void setCompileConstantNil(CompileConstant* constant)
+{
+    Constant* target = reinterpret_cast<Constant*>(constant);
+
+    target->type = Constant::Type_Nil;
+}
+
+void setCompileConstantBoolean(CompileConstant* constant, bool b)
+{
+    Constant* target = reinterpret_cast<Constant*>(constant);
+
+    target->type = Constant::Type_Boolean;
+    target->valueBoolean = b;
+}
+
+void setCompileConstantNumber(CompileConstant* constant, double n)
+{
+    Constant* target = reinterpret_cast<Constant*>(constant);
+
+    target->type = Constant::Type_Number;
+    target->valueNumber = n;
+}
+
+void setCompileConstantString(CompileConstant* constant, const char* s, size_t l)
+{
+    Constant* target = reinterpret_cast<Constant*>(constant);
+
+    if (l > std::numeric_limits<unsigned int>::max())
+        CompileError::raise({}, "Exceeded custom string constant length limit");
+
+    target->type = Constant::Type_String;
+    target->stringLength = unsigned(l);
+    target->valueString = s;
+}
+
 void compileOrThrow(BytecodeBuilder& bytecode, const std::string& source, const CompileOptions& options, const ParseOptions& parseOptions)
 {
     Allocator allocator;
@@ -3,6 +3,7 @@
 
 #include "BuiltinFolding.h"
 
+#include <algorithm>
 #include <vector>
 #include <math.h>
 
@@ -202,26 +203,35 @@ static void foldBinary(Constant& result, AstExprBinary::Op op, const Constant& l
     }
 }
 
+// limits the nesting of pure calls evaluated at compile time, e.g. f(g(h(1))) where each function calls the next one
+const size_t kMaxPureCallDepth = 8;
+
 struct ConstantVisitor : AstVisitor
 {
     DenseHashMap<AstExpr*, Constant>& constants;
     DenseHashMap<AstLocal*, Variable>& variables;
     DenseHashMap<AstLocal*, Constant>& locals;
 
+    const DenseHashMap<AstName, Constant>* globals;
     const DenseHashMap<AstExprCall*, int>* builtins;
     bool foldMathK = false;
+    bool foldPureCalls = false;
 
     bool wasEmpty = false;
 
     std::vector<Constant> builtinArgs;
+    std::vector<AstExprFunction*> pureCalls;
 
     ConstantVisitor(DenseHashMap<AstExpr*, Constant>& constants, DenseHashMap<AstLocal*, Variable>& variables,
-        DenseHashMap<AstLocal*, Constant>& locals, const DenseHashMap<AstExprCall*, int>* builtins, bool foldMathK)
+        DenseHashMap<AstLocal*, Constant>& locals, const DenseHashMap<AstName, Constant>* globals, const DenseHashMap<AstExprCall*, int>* builtins,
+        bool foldMathK, bool foldPureCalls)
         : constants(constants)
         , variables(variables)
         , locals(locals)
+        , globals(globals)
         , builtins(builtins)
         , foldMathK(foldMathK)
+        , foldPureCalls(foldPureCalls)
     {
         // since we do a single pass over the tree, if the initial state was empty we don't need to clear out old entries
         wasEmpty = constants.empty() && locals.empty();
@@ -263,9 +273,11 @@ struct ConstantVisitor : AstVisitor
             if (l)
                 result = *l;
         }
-        else if (node->is<AstExprGlobal>())
+        else if (AstExprGlobal* expr = node->as<AstExprGlobal>())
         {
-            // nope
+            // globals are only known when their values are provided by the host
+            if (const Constant* g = globals ? globals->find(expr->name) : nullptr)
+                result = *g;
         }
         else if (node->is<AstExprVarargs>())
         {
@@ -305,6 +317,9 @@ struct ConstantVisitor : AstVisitor
             {
                 for (size_t i = 0; i < expr->args.size; ++i)
                     analyze(expr->args.data[i]);
+
+                if (foldPureCalls)
+                    result = foldPureCall(expr);
             }
         }
         else if (AstExprIndexName* expr = node->as<AstExprIndexName>())
@@ -387,6 +402,93 @@ struct ConstantVisitor : AstVisitor
         return result;
     }
 
+    AstExprFunction* getFunctionExpr(AstExpr* node)
+    {
+        if (AstExprLocal* expr = node->as<AstExprLocal>())
+        {
+            Variable* lv = variables.find(expr->local);
+
+            if (!lv || lv->written || !lv->init)
+                return nullptr;
+
+            return getFunctionExpr(lv->init);
+        }
+        else if (AstExprGroup* expr = node->as<AstExprGroup>())
+            return getFunctionExpr(expr->expr);
+        else if (AstExprTypeAssertion* expr = node->as<AstExprTypeAssertion>())
+            return getFunctionExpr(expr->expr);
+        else
+            return node->as<AstExprFunction>();
+    }
+
+    // a call to a local function that consists of a single return of one expression is evaluated with the constant arguments bound to its
+    // parameters; the call folds when the expression does, which also means that evaluating it has no side effects
+    Constant foldPureCall(AstExprCall* expr)
+    {
+        Constant result;
+        result.type = Constant::Type_Unknown;
+
+        AstExprFunction* func = expr->self ? nullptr : getFunctionExpr(expr->func);
+
+        if (!func || func->vararg || func->self || func->body->body.size != 1)
+            return result;
+
+        AstStatReturn* ret = func->body->body.data[0]->as<AstStatReturn>();
+
+        if (!ret || ret->list.size != 1)
+            return result;
+
+        if (pureCalls.size() >= kMaxPureCallDepth || std::find(pureCalls.begin(), pureCalls.end(), func) != pureCalls.end())
+            return result;
+
+        // missing arguments are nil unless the last argument can expand into multiple values
+        if (expr->args.size < func->args.size && expr->args.size != 0)
+        {
+            AstExpr* last = expr->args.data[expr->args.size - 1];
+
+            if (last->is<AstExprCall>() || last->is<AstExprVarargs>())
+                return result;
+        }
+
+        for (size_t i = 0; i < expr->args.size; ++i)
+        {
+            const Constant* ac = constants.find(expr->args.data[i]);
+
+            if (!ac || ac->type == Constant::Type_Unknown)
+                return result;
+        }
+
+        std::vector<Constant> saved;
+        saved.reserve(func->args.size);
+
+        for (size_t i = 0; i < func->args.size; ++i)
+        {
+            AstLocal* arg = func->args.data[i];
+
+            const Constant* old = locals.find(arg);
+            saved.push_back(old ? *old : Constant{});
+
+            locals[arg] = i < expr->args.size ? *constants.find(expr->args.data[i]) : Constant{Constant::Type_Nil};
+        }
+
+        pureCalls.push_back(func);
+        result = analyze(ret->list.data[0]);
+
+        // restore the state of the function body so that it's compiled using the values it had before the call was evaluated
+        // note: the function stays on the call stack so that recursive calls in the body don't get evaluated again
+        for (size_t i = 0; i < func->args.size; ++i)
+            locals[func->args.data[i]] = saved[i];
+
+        bool oldWasEmpty = wasEmpty;
+        wasEmpty = false;
+        analyze(ret->list.data[0]);
+        wasEmpty = oldWasEmpty;
+
+        pureCalls.pop_back();
+
+        return result;
+    }
+
     template<typename T>
     void recordConstant(DenseHashMap<T, Constant>& map, T key, const Constant& value)
     {
@@ -459,9 +561,10 @@ struct ConstantVisitor : AstVisitor
 };
 
 void foldConstants(DenseHashMap<AstExpr*, Constant>& constants, DenseHashMap<AstLocal*, Variable>& variables,
-    DenseHashMap<AstLocal*, Constant>& locals, const DenseHashMap<AstExprCall*, int>* builtins, bool foldMathK, AstNode* root)
+    DenseHashMap<AstLocal*, Constant>& locals, const DenseHashMap<AstName, Constant>* globals, const DenseHashMap<AstExprCall*, int>* builtins,
+    bool foldMathK, bool foldPureCalls, AstNode* root)
 {
-    ConstantVisitor visitor{constants, variables, locals, builtins, foldMathK};
+    ConstantVisitor visitor{constants, variables, locals, globals, builtins, foldMathK, foldPureCalls};
     root->visit(&visitor);
 }
 
@@ -45,7 +45,8 @@ struct Constant
 };
 
 void foldConstants(DenseHashMap<AstExpr*, Constant>& constants, DenseHashMap<AstLocal*, Variable>& variables,
-    DenseHashMap<AstLocal*, Constant>& locals, const DenseHashMap<AstExprCall*, int>* builtins, bool foldMathK, AstNode* root);
+    DenseHashMap<AstLocal*, Constant>& locals, const DenseHashMap<AstName, Constant>* globals, const DenseHashMap<AstExprCall*, int>* builtins,
+    bool foldMathK, bool foldPureCalls, AstNode* root);
 
 } // namespace Compile
 } // namespace Luau
@@ -595,6 +595,7 @@ struct TypeMapVisitor : AstVisitor
             case LBF_RAWSET:
             case LBF_RAWGET:
             case LBF_TABLE_INSERT:
+            case LBF_TABLE_REMOVE:
             case LBF_TABLE_UNPACK:
             case LBF_SELECT_VARARG:
             case LBF_GETMETATABLE:
@@ -662,6 +663,8 @@ struct TypeMapVisitor : AstVisitor
             case LBF_BUFFER_READU32:
             case LBF_BUFFER_READF32:
             case LBF_BUFFER_READF64:
+            case LBF_VECTOR_MAGNITUDE:
+            case LBF_VECTOR_DOT:
                 recordResolvedType(node, &builtinTypes.numberType);
                 break;
 
@@ -670,6 +673,7 @@ struct TypeMapVisitor : AstVisitor
             case LBF_TYPEOF:
             case LBF_STRING_SUB:
             case LBF_TOSTRING:
+            case LBF_STRING_FORMAT:
                 recordResolvedType(node, &builtinTypes.stringType);
                 break;
 
@@ -678,6 +682,16 @@ struct TypeMapVisitor : AstVisitor
                 break;
 
             case LBF_VECTOR:
+            case LBF_VECTOR_NORMALIZE:
+            case LBF_VECTOR_CROSS:
+            case LBF_VECTOR_FLOOR:
+            case LBF_VECTOR_CEIL:
+            case LBF_VECTOR_ABS:
+            case LBF_VECTOR_SIGN:
+            case LBF_VECTOR_CLAMP:
+            case LBF_VECTOR_MIN:
+            case LBF_VECTOR_MAX:
+            case LBF_VECTOR_LERP:
                 recordResolvedType(node, &builtinTypes.vectorType);
                 break;
             }
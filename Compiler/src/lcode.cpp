@@ -27,3 +27,23 @@ char* luau_compile(const char* source, size_t size, lua_CompileOptions* options,
     *outsize = result.size();
     return copy;
 }
+
+void luau_set_compile_constant_nil(lua_CompileConstant* constant)
+{
+    Luau::setCompileConstantNil(reinterpret_cast<Luau::CompileConstant*>(constant));
+}
+
+void luau_set_compile_constant_boolean(lua_CompileConstant* constant, int b)
+{
+    Luau::setCompileConstantBoolean(reinterpret_cast<Luau::CompileConstant*>(constant), b != 0);
+}
+
+void luau_set_compile_constant_number(lua_CompileConstant* constant, double n)
+{
+    Luau::setCompileConstantNumber(reinterpret_cast<Luau::CompileConstant*>(constant), n);
+}
+
+void luau_set_compile_constant_string(lua_CompileConstant* constant, const char* s, size_t l)
+{
+    Luau::setCompileConstantString(reinterpret_cast<Luau::CompileConstant*>(constant), s, l);
+}
@@ -308,6 +308,7 @@ target_sources(Luau.VM PRIVATE
     VM/src/lbuffer.cpp
     VM/src/lbuflib.cpp
     VM/src/lbuiltins.cpp
+    VM/src/lclone.cpp
     VM/src/lcorolib.cpp
     VM/src/ldblib.cpp
     VM/src/ldebug.cpp
@@ -316,6 +317,7 @@ target_sources(Luau.VM PRIVATE
     VM/src/lgc.cpp
     VM/src/lgcdebug.cpp
     VM/src/linit.cpp
+    VM/src/ljsonlib.cpp
     VM/src/lmathlib.cpp
     VM/src/lmem.cpp
     VM/src/lnumprint.cpp
@@ -327,9 +329,11 @@ target_sources(Luau.VM PRIVATE
     VM/src/lstrlib.cpp
     VM/src/ltable.cpp
     VM/src/ltablib.cpp
+    VM/src/ltasklib.cpp
     VM/src/ltm.cpp
     VM/src/ludata.cpp
     VM/src/lutf8lib.cpp
+    VM/src/lveclib.cpp
     VM/src/lvmexecute.cpp
     VM/src/lvmload.cpp
     VM/src/lvmutils.cpp
@@ -372,6 +376,8 @@ if(TARGET Luau.Repl.CLI)
     target_sources(Luau.Repl.CLI PRIVATE
         CLI/Coverage.h
         CLI/Coverage.cpp
+        CLI/JitDump.h
+        CLI/JitDump.cpp
         CLI/Profiler.h
         CLI/Profiler.cpp
         CLI/Repl.cpp
@@ -382,7 +388,9 @@ endif()
 if(TARGET Luau.Analyze.CLI)
     # Luau.Analyze.CLI Sources
     target_sources(Luau.Analyze.CLI PRIVATE
-        CLI/Analyze.cpp)
+        CLI/Analyze.cpp
+        CLI/AnalyzeWatch.h
+        CLI/AnalyzeWatch.cpp)
 endif()
 
 if(TARGET Luau.Ast.CLI)
@@ -506,13 +514,18 @@ endif()
 if(TARGET Luau.CLI.Test)
     # Luau.CLI.Test Sources
     target_sources(Luau.CLI.Test PRIVATE
+        CLI/AnalyzeWatch.h
+        CLI/AnalyzeWatch.cpp
         CLI/Coverage.h
         CLI/Coverage.cpp
+        CLI/JitDump.h
+        CLI/JitDump.cpp
         CLI/Profiler.h
         CLI/Profiler.cpp
         CLI/Repl.cpp
         CLI/Require.cpp
 
+        tests/AnalyzeWatch.test.cpp
         tests/RegisterCallbacks.h
         tests/RegisterCallbacks.cpp
         tests/Repl.test.cpp
@@ -520,6 +533,16 @@ if(TARGET Luau.CLI.Test)
         tests/main.cpp)
 endif()
 
+if(TARGET Luau.Bench)
+    # Luau.Bench Sources
+    target_sources(Luau.Bench PRIVATE
+        CLI/Bench.cpp
+        CLI/BenchContainers.h
+        CLI/BenchContainers.cpp
+        CLI/BenchPipeline.h
+        CLI/BenchPipeline.cpp)
+endif()
+
 if(TARGET Luau.Web)
     # Luau.Web Sources
     target_sources(Luau.Web PRIVATE
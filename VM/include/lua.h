@@ -109,6 +109,18 @@ typedef unsigned lua_Unsigned;
 ** state manipulation
 */
 LUA_API lua_State* lua_newstate(lua_Alloc f, void* ud);
+LUA_API lua_State* lua_newsharedstate(lua_Alloc f, void* ud, lua_State* published);
+// creates a new state with a copy of everything that is reachable from the globals and the registry of the state, along with its
+// callbacks and metatables; threads other than the main thread and userdata with destructors can't be copied, and native code isn't kept
+LUA_API lua_State* lua_clonestate(lua_State* L);
+
+// immutable table of string atoms where the atom of names[i] is i; the table is never modified after creation, so states running on
+// different threads can share it. lua_setatomtable makes a state assign atoms from the table instead of the useratom callback; strings
+// that aren't in the table get atom -1. states created with lua_newsharedstate inherit the table of the published state
+typedef struct lua_AtomTable lua_AtomTable;
+LUA_API lua_AtomTable* lua_newatomtable(lua_Alloc f, void* ud, const char* const* names, int count);
+LUA_API void lua_freeatomtable(lua_AtomTable* t);
+LUA_API void lua_setatomtable(lua_State* L, const lua_AtomTable* t);
 LUA_API void lua_close(lua_State* L);
 LUA_API lua_State* lua_newthread(lua_State* L);
 LUA_API lua_State* lua_mainthread(lua_State* L);
@@ -190,6 +202,8 @@ LUA_API int lua_pushthread(lua_State* L);
 LUA_API void lua_pushlightuserdatatagged(lua_State* L, void* p, int tag);
 LUA_API void* lua_newuserdatatagged(lua_State* L, size_t sz, int tag);
 LUA_API void* lua_newuserdatadtor(lua_State* L, size_t sz, void (*dtor)(void*));
+// pushes an array of 'count' new userdata with the metatable registered for the tag, and stores the pointers to their data in 'data' if set
+LUA_API void lua_newuserdatataggedbatch(lua_State* L, size_t sz, int tag, int count, void** data);
 
 LUA_API void* lua_newbuffer(lua_State* L, size_t sz);
 
@@ -202,9 +216,26 @@ LUA_API int lua_rawgetfield(lua_State* L, int idx, const char* k);
 LUA_API int lua_rawget(lua_State* L, int idx);
 LUA_API int lua_rawgeti(lua_State* L, int idx, int n);
 LUA_API void lua_createtable(lua_State* L, int narr, int nrec);
+LUA_API void lua_createtablefrom(lua_State* L, const char* const* keys, int nkeys);
 
 LUA_API void lua_setreadonly(lua_State* L, int idx, int enabled);
 LUA_API int lua_getreadonly(lua_State* L, int idx);
+// permanently excludes a readonly table and the readonly tables and strings reachable from it from garbage collection
+LUA_API void lua_freeze(lua_State* L, int idx);
+LUA_API int lua_getfrozen(lua_State* L, int idx);
+// creates a state that holds a frozen copy of a table, which can only contain tables without metatables, strings, numbers, booleans
+// and vectors; states created with lua_newsharedstate from any thread reference the copy directly, without copying or scanning it.
+// the published state can't be used for anything else and has to be closed after all states that share it
+LUA_API lua_State* lua_publish(lua_State* L, int idx);
+LUA_API void lua_getpublished(lua_State* L);
+
+// copies a value to a state of another global state (or the same one) and pushes it there, preserving cycles and shared references; tables
+// can't have metatables, and functions, userdata and threads can't be copied. errors are raised in the source state, and neither state
+// can run on another thread during the copy
+LUA_API void lua_xclone(lua_State* from, lua_State* to, int idx);
+// encodes a value into a buffer, with the same limitations as lua_xclone, and decodes it back; the encoding uses the native byte order
+LUA_API void lua_encodevalue(lua_State* L, int idx);
+LUA_API void lua_decodevalue(lua_State* L, int idx);
 LUA_API void lua_setsafeenv(lua_State* L, int idx, int enabled);
 
 LUA_API int lua_getmetatable(lua_State* L, int objindex);
@@ -224,10 +255,17 @@ LUA_API int lua_setfenv(lua_State* L, int idx);
 /*
 ** `load' and `call' functions (load and run Luau bytecode)
 */
+// bytecode is only read during the call, so the data can point into a memory-mapped file that is unmapped afterwards
 LUA_API int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size, int env);
 LUA_API void lua_call(lua_State* L, int nargs, int nresults);
 LUA_API int lua_pcall(lua_State* L, int nargs, int nresults, int errfunc);
 
+// prepared calls keep a function that is called repeatedly in the registry; lua_pcallprepared calls it with the arguments on top of the
+// stack, like lua_pcall without an error handler, but without pushing the function first
+LUA_API int lua_preparecall(lua_State* L, int idx);
+LUA_API int lua_pcallprepared(lua_State* L, int call, int nargs, int nresults);
+LUA_API void lua_unpreparecall(lua_State* L, int call);
+
 /*
 ** coroutine functions
 */
@@ -290,18 +328,180 @@ enum lua_GCOp
     LUA_GCSETGOAL,
     LUA_GCSETSTEPMUL,
     LUA_GCSETSTEPSIZE,
+
+    /*
+    ** enable (data = 1) or disable (data = 0) generational mode; returns 1 if generational mode was enabled before the call
+    **
+    ** in generational mode, objects that survive a collection cycle become old and are not traversed again by the following minor
+    ** cycles, which only mark objects that were allocated or modified since; this reduces the time spent in GC for applications that
+    ** keep a large amount of long-lived data while allocating many short-lived objects.
+    ** a minor cycle starts after the heap grows by GM% (minor multiplier) of its size after the last cycle; a major cycle that traverses
+    ** the entire heap happens once the heap grows by GJ% (major multiplier) since the last major cycle. both values are specified in
+    ** percentages; by default GM=20% and GJ=100%.
+    */
+    LUA_GCGEN,
+    LUA_GCSETGENMINORMUL,
+    LUA_GCSETGENMAJORMUL,
+
+    /*
+    ** set the number of worker threads that full collections (LUA_GCCOLLECT) may use to mark and sweep the heap in parallel
+    **
+    ** workers are provided by the host via lua_Callbacks::gcparallel; when the callback isn't set or the number of workers is 1 or less,
+    ** the collection runs on the calling thread. the number of workers is capped at an internal limit (LUAI_GCMAXWORKERS).
+    */
+    LUA_GCSETWORKERS,
+
+    // previous name of LUA_GCSETWORKERS from when the workers were only used to mark the heap; kept for source compatibility
+    LUA_GCSETMARKWORKERS = LUA_GCSETWORKERS,
+
+    /*
+    ** set the number of free blocks that each thread can cache for each allocation size class; 0 (default) disables the caches
+    **
+    ** threads refill their caches in batches from the shared page free lists, which makes allocation cheaper for threads that allocate
+    ** many small objects; the cached blocks are held by the thread until it is collected.
+    */
+    LUA_GCSETALLOCCACHE,
+
+    // returns the percentage of object allocations served from thread allocation caches; when data is not 0, the counters are reset
+    LUA_GCALLOCCACHEHITRATE,
+
+    /*
+    ** time budget pacing
+    **
+    ** when the frame budget is set (in microseconds), GC assists performed during allocation stop once they take the budgeted amount
+    ** of time in the current frame; the remaining work is performed in the next frames, when the host reports idle time or with explicit
+    ** steps (see LUA_GCDEBT). the amount of work that fits into the remaining time is estimated from the observed rate of GC work.
+    ** budget is ignored when the collector falls behind the heap goal. 0 (default) disables time budget pacing.
+    **
+    ** LUA_GCFRAME starts a new frame and returns the time spent in GC assists during the previous frame in microseconds.
+    ** LUA_GCIDLE performs GC work for up to the specified number of microseconds; returns 1 if the cycle was completed.
+    */
+    LUA_GCSETFRAMEBUDGET,
+    LUA_GCFRAME,
+    LUA_GCIDLE,
+
+    /*
+    ** perform a full collection and move tables out of the pages where at most data% of blocks are used (25% when data is 0), which
+    ** allows the pages to be freed; returns the number of freed pages.
+    **
+    ** moved tables get a new address, which changes the result of lua_topointer; this must only be called from the host when no
+    ** functions are running in the VM, since C functions might hold pointers to tables.
+    */
+    LUA_GCCOMPACT,
+
+    /*
+    ** shrink the array and hash parts of live tables during sweep when at most data% of their slots are used (0 disables shrinking,
+    ** which is the default); returns the previous setting.
+    **
+    ** tables that are traversed with next/pairs while elements are being removed can be shrunk mid-traversal, which changes the
+    ** traversal order, and next raises an 'invalid key to next' error when the key it is given was removed by the shrink; this
+    ** should only be enabled when the host doesn't rely on removing elements during traversal. tables are only shrunk after they
+    ** survived a complete collection cycle.
+    */
+    LUA_GCSETTABLESHRINK,
+
+    /*
+    ** set the number of thread stacks that are kept for reuse by new threads after their threads are collected; 0 (default) disables
+    ** the pool; returns the previous setting.
+    **
+    ** only stacks that have their initial size are kept; pooled stacks are attributed to memory category 0 and count towards the heap
+    ** size until they are reused or the pool is trimmed. reusing a stack charges it to the category of the new thread, subject to the
+    ** limits set by lua_setmemcatlimit.
+    */
+    LUA_GCSETTHREADPOOL,
+
+    /*
+    ** return the GC debt in KB, which is the amount of GC work that the collector is behind its pace by, including the work that GC
+    ** assists postponed because of the frame budget; 0 when the collector is on pace or stopped. an explicit step (LUA_GCSTEP) of this
+    ** size pays the debt.
+    */
+    LUA_GCDEBT,
 };
 
 LUA_API int lua_gc(lua_State* L, int what, int data);
 
+// performs explicit GC steps for independent states that aren't running any code, splitting up to budget KB of GC work between the
+// states in proportion to their debt (see LUA_GCDEBT); the states are stepped concurrently through the gcparallel callback of the
+// first state when it's set, so userdata destructors may be called on the worker threads. returns the number of finished GC cycles
+LUA_API int lua_gcstepmany(lua_State** states, int count, int budget);
+
+/*
+** garbage collector metrics
+** times are in seconds (timestamps use lua_clock), sizes are in bytes; a full collection (LUA_GCCOLLECT) is recorded as a single step
+*/
+struct lua_GCCycleMetrics
+{
+    double starttimestamp;
+    double endtimestamp;
+
+    double marktime;
+    double atomictime;
+    double sweeptime;
+    double assisttime; // part of the step time spent in steps that were performed by allocations
+    double maxsteptime;
+
+    size_t steps;
+
+    size_t starttotalsizebytes;
+    size_t atomicstarttotalsizebytes;
+    size_t endtotalsizebytes;
+    size_t heapgoalsizebytes;
+};
+typedef struct lua_GCCycleMetrics lua_GCCycleMetrics;
+
+struct lua_GCMetrics
+{
+    uint64_t completedcycles;
+
+    // accumulated over the lifetime of the state, including the current cycle
+    uint64_t steps;
+    double steptime;
+    double assisttime;
+    double maxsteptime;
+
+    lua_GCCycleMetrics lastcycle; // last completed cycle
+    lua_GCCycleMetrics currcycle; // cycle in progress (only step data is meaningful until it completes)
+};
+typedef struct lua_GCMetrics lua_GCMetrics;
+
+LUA_API void lua_gcmetrics(lua_State* L, lua_GCMetrics* metrics);
+
 /*
 ** memory statistics
 ** all allocated bytes are attributed to the memory category of the running thread (0..LUA_MEMORY_CATEGORIES-1)
 */
 
 LUA_API void lua_setmemcat(lua_State* L, int category);
+LUA_API void lua_setmemcatlimit(lua_State* L, int category, size_t softlimit, size_t hardlimit);
 LUA_API size_t lua_totalbytes(lua_State* L, int category);
 
+// stack growth of threads, attributed to the memory category of the thread
+struct lua_StackStats
+{
+    uint64_t stackgrowths; // number of times a value stack was reallocated to fit more values
+    uint64_t cigrowths;    // number of times a call frame array was reallocated to fit more calls
+    int maxstacksize;      // largest value stack size reached by a thread, in values
+    int maxcisize;         // largest call frame array size reached by a thread, in frames
+};
+typedef struct lua_StackStats lua_StackStats;
+
+// gets stack growth statistics for a memory category, or combined statistics of all categories when category is negative
+LUA_API void lua_getstackstats(lua_State* L, int category, lua_StackStats* stats);
+
+/*
+** heap snapshots
+** a snapshot is captured incrementally and passed to the write callback in chunks of a compact binary format (see lgcdebug.cpp and
+** tools/heapsnapshot.py); the heap can change between steps, and objects are reported as they are when their page is visited
+*/
+typedef struct lua_HeapSnapshot lua_HeapSnapshot;
+typedef void (*lua_HeapSnapshotWrite)(void* context, const void* data, size_t size);
+
+// only one snapshot can be in progress at a time, and heap compaction (LUA_GCCOMPACT) can't run until it ends
+LUA_API lua_HeapSnapshot* lua_heapsnapshotbegin(lua_State* L, void* context, lua_HeapSnapshotWrite write);
+// visits the heap for at least one page and until 'budget' seconds pass; returns 1 when the snapshot is complete
+LUA_API int lua_heapsnapshotstep(lua_State* L, lua_HeapSnapshot* snapshot, double budget);
+LUA_API void lua_heapsnapshotend(lua_State* L, lua_HeapSnapshot* snapshot);
+
 /*
 ** miscellaneous functions
 */
@@ -324,10 +524,34 @@ typedef void (*lua_Destructor)(lua_State* L, void* userdata);
 LUA_API void lua_setuserdatadtor(lua_State* L, int tag, lua_Destructor dtor);
 LUA_API lua_Destructor lua_getuserdatadtor(lua_State* L, int tag);
 
+// destructor that receives the data of dead userdata of one tag in batches, up to one batch per page of objects in each sweep step; a
+// tag can have either a destructor or a batch destructor
+typedef void (*lua_BatchDestructor)(lua_State* L, void** userdata, int count);
+
+LUA_API void lua_setuserdatabatchdtor(lua_State* L, int tag, lua_BatchDestructor dtor);
+
 // alternative access for metatables already registered with luaL_newmetatable
 LUA_API void lua_setuserdatametatable(lua_State* L, int tag, int idx);
 LUA_API void lua_getuserdatametatable(lua_State* L, int tag);
 
+// native operators for userdata of one tag, used instead of the metamethods when both operands are userdata with this tag; arithmetic
+// operators write the result to the data of a new userdata with the size, tag and metatable of the first operand. operators run without a
+// call frame, so they must not call other API functions; unset operators use the metamethods and the structure must outlive the state
+typedef struct lua_UserdataOps
+{
+    void (*add)(lua_State* L, void* res, const void* a, const void* b);
+    void (*sub)(lua_State* L, void* res, const void* a, const void* b);
+    void (*mul)(lua_State* L, void* res, const void* a, const void* b);
+    void (*div)(lua_State* L, void* res, const void* a, const void* b);
+    void (*unm)(lua_State* L, void* res, const void* a);
+
+    int (*eq)(lua_State* L, const void* a, const void* b);
+    int (*lt)(lua_State* L, const void* a, const void* b);
+    int (*le)(lua_State* L, const void* a, const void* b);
+} lua_UserdataOps;
+
+LUA_API void lua_setuserdataops(lua_State* L, int tag, const lua_UserdataOps* ops);
+
 LUA_API void lua_setlightuserdataname(lua_State* L, int tag, const char* name);
 LUA_API const char* lua_getlightuserdataname(lua_State* L, int tag);
 
@@ -337,16 +561,41 @@ LUA_API void lua_cleartable(lua_State* L, int idx);
 
 LUA_API lua_Alloc lua_getallocf(lua_State* L, void** ud);
 
+// fast path of a host function that is called through FASTCALL instructions (see CompileOptions::hostBuiltins) when all arguments are
+// numbers; receives up to 8 arguments and writes up to 3 results to res, returning their count, or returns -1 to call the function normally.
+// the fast path runs without a call frame, so it must not call other API functions
+typedef int (*lua_HostBuiltin)(lua_State* L, double* res, const double* args, int nargs);
+
+LUA_API void lua_sethostbuiltin(lua_State* L, int id, lua_HostBuiltin f);
+
+// sets the number of calls and loop iterations after which functions executed by the interpreter are reported to the hotfunction callback
+// (0 disables the reports, which is the default); applies to functions loaded after the call
+LUA_API void lua_sethotthreshold(lua_State* L, int threshold);
+
+// sets the number of allocated bytes between calls to the allocsample callback (0 disables sampling, which is the default)
+LUA_API void lua_setallocsamplerate(lua_State* L, int bytes);
+
+// enables recording of argument types that the interpreter observes on calls; native code generation specializes functions for
+// the recorded types, guarded with entry checks; applies to functions loaded after the call
+LUA_API void lua_settypeprofiling(lua_State* L, int enable);
+
+// sets the number of safepoints (loop back edges, calls and returns) that the thread passes before the interrupt callback is called;
+// the budget is only consumed while the callback is set, and once it's exhausted the callback is called at every safepoint until it
+// sets a new budget (0 calls the callback at every safepoint, which is the default). the budget is updated by the running thread without
+// synchronization, so it must only be set while the thread isn't running or from the thread itself, e.g. from the interrupt callback
+LUA_API void lua_setinterruptbudget(lua_State* L, int budget);
+LUA_API int lua_getinterruptbudget(lua_State* L);
+
 /*
 ** reference system, can be used to pin objects
+** references are handles into a slab owned by the state; lua_getref pushes nil for references that were released
 */
 #define LUA_NOREF -1
 #define LUA_REFNIL 0
 
 LUA_API int lua_ref(lua_State* L, int idx);
 LUA_API void lua_unref(lua_State* L, int ref);
-
-#define lua_getref(L, ref) lua_rawgeti(L, LUA_REGISTRYINDEX, (ref))
+LUA_API int lua_getref(lua_State* L, int ref);
 
 /*
 ** ===============================================================
@@ -409,6 +658,20 @@ LUA_API const char* lua_setupvalue(lua_State* L, int funcindex, int n);
 LUA_API void lua_singlestep(lua_State* L, int enabled);
 LUA_API int lua_breakpoint(lua_State* L, int funcindex, int line, int enabled);
 
+// opcode execution statistics, indexed by LuauOpcode and LuauBuiltinFunction values
+enum lua_OpcodeStat
+{
+    LUA_OPSTAT_EXEC,             // executions of opcode a
+    LUA_OPSTAT_PAIR,             // executions of opcode b immediately after opcode a
+    LUA_OPSTAT_SLOWPATH,         // executions of opcode a that left the fast path (metamethods, generic table access, etc.)
+    LUA_OPSTAT_FASTCALL,         // fastcalls of builtin a
+    LUA_OPSTAT_FASTCALLFALLBACK, // fastcalls of builtin a that continued through the regular call
+};
+
+// while statistics are collected, all threads run in single-step mode without executing native code; enabling resets the counts
+LUA_API void lua_setopcodestats(lua_State* L, int enabled);
+LUA_API uint64_t lua_getopcodestat(lua_State* L, int stat, int a, int b);
+
 typedef void (*lua_Coverage)(void* context, const char* function, int linedefined, int depth, const int* hits, size_t size);
 
 LUA_API void lua_getcoverage(lua_State* L, int funcindex, void* context, lua_Coverage callback);
@@ -416,6 +679,20 @@ LUA_API void lua_getcoverage(lua_State* L, int funcindex, void* context, lua_Cov
 // Warning: this function is not thread-safe since it stores the result in a shared global array! Only use for debugging.
 LUA_API const char* lua_debugtrace(lua_State* L);
 
+// frame of a stack trace captured by lua_capturetrace; frames reference function prototypes without keeping them alive, so they have to be
+// symbolized with lua_gettraceframe before the functions are collected
+typedef struct lua_TraceFrame
+{
+    const void* proto;     // prototype of a Luau function, NULL for C functions
+    const char* debugname; // debug name of a C function
+    int pc;                // index of the current instruction of a Luau function
+} lua_TraceFrame;
+
+// records up to size frames starting at level into frames without allocating or formatting anything; returns the number of frames recorded
+LUA_API int lua_capturetrace(lua_State* L, int level, lua_TraceFrame* frames, int size);
+// fills in the (s), (l) and (n) fields of ar for a captured frame, like lua_getinfo does for a stack level
+LUA_API void lua_gettraceframe(lua_State* L, const lua_TraceFrame* frame, const char* what, lua_Debug* ar);
+
 struct lua_Debug
 {
     const char* name;      // (n)
@@ -453,6 +730,26 @@ struct lua_Callbacks
     void (*debugstep)(lua_State* L, lua_Debug* ar);      // gets called after each instruction in single step mode
     void (*debuginterrupt)(lua_State* L, lua_Debug* ar); // gets called when thread execution is interrupted by break in another thread
     void (*debugprotectederror)(lua_State* L);           // gets called when protected call results in an error
+
+    // gets called when an allocation makes memory category usage exceed its soft limit (see lua_setmemcatlimit); the callback runs in the
+    // middle of the allocation, when new objects might not be reachable yet, so it must not run the garbage collector; it can raise errors
+    // crossing the soft limit also schedules a collector step that runs at the next GC check, e.g. the next allocation by the VM
+    void (*memcatlimit)(lua_State* L, int category, size_t size);
+
+    // gets called during full GC to run job(context, index) for each index in 0..count-1 on separate threads; must return after all jobs finish
+    void (*gcparallel)(lua_State* L, int count, void (*job)(void* context, int index), void* context);
+
+    // gets called once when a function without native code reaches the threshold set by lua_sethotthreshold; the function is at level 0
+    // (lua_getinfo with "f" pushes it, so it can be compiled) and the callback must not yield
+    void (*hotfunction)(lua_State* L);
+
+    // gets called before an allocation that crosses a sampling point set by lua_setallocsamplerate; size is the number of bytes the sample
+    // represents (a multiple of the sample rate); like memcatlimit, the callback runs in the middle of an allocation and must not allocate
+    void (*allocsample)(lua_State* L, int category, size_t size);
+
+    // gets called when a garbage collection cycle completes, after the metrics returned by lua_gcmetrics are updated; the collector can
+    // run during an allocation, so the callback must not allocate
+    void (*gccycle)(lua_State* L);
 };
 typedef struct lua_Callbacks lua_Callbacks;
 
@@ -66,6 +66,12 @@
 #define LUA_USE_LONGJMP 0
 #endif
 
+// Can be used with C++ EH to unwind errors raised by the VM with longjmp when only Luau functions separate them from the enclosing
+// protected call; requires callbacks invoked without a call frame (interrupt, debug hooks) to not rely on C++ EH when raising VM errors
+#ifndef LUA_USE_FASTERRORS
+#define LUA_USE_FASTERRORS 0
+#endif
+
 // LUA_IDSIZE gives the maximum size for the description of the source
 #ifndef LUA_IDSIZE
 #define LUA_IDSIZE 256
@@ -91,6 +97,11 @@
 #define LUAI_MAXCCALLS 200
 #endif
 
+// strings longer than this are not interned in the string table; their hash is only computed when they are used as table keys
+#ifndef LUAI_MAXSHORTLEN
+#define LUAI_MAXSHORTLEN 1024
+#endif
+
 // buffer size used for on-stack string operations; this limit depends on native stack size
 #ifndef LUA_BUFFERSIZE
 #define LUA_BUFFERSIZE 512
@@ -106,6 +117,9 @@
 #define LUA_LUTAG_LIMIT 128
 #endif
 
+// number of builtin function ids reserved for fast paths of host functions, see lua_sethostbuiltin; fixed by the bytecode format
+#define LUA_HOSTBUILTIN_LIMIT 32
+
 // upper bound for number of size classes used by page allocator
 #ifndef LUA_SIZECLASSES
 #define LUA_SIZECLASSES 40
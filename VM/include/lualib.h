@@ -93,6 +93,7 @@ typedef struct luaL_Strbuf luaL_Buffer;
 // when internal buffer storage is exhausted, a mutable string value 'storage' will be placed on the stack
 // in general, functions expect the mutable string buffer to be placed on top of the stack (top-1)
 // with the exception of luaL_addvalue that expects the value at the top and string buffer further away (top-2)
+// luaL_buffinitsize reserves exactly 'size' bytes; when the buffer is filled completely, luaL_pushresult doesn't copy the data
 
 #define luaL_addchar(B, c) ((void)((B)->p < (B)->end || luaL_prepbuffsize(B, 1)), (*(B)->p++ = (char)(c)))
 #define luaL_addstring(B, s) luaL_addlstring(B, s, strlen(s))
@@ -127,6 +128,9 @@ LUALIB_API int luaopen_bit32(lua_State* L);
 #define LUA_BUFFERLIBNAME "buffer"
 LUALIB_API int luaopen_buffer(lua_State* L);
 
+#define LUA_VECLIBNAME "vector"
+LUALIB_API int luaopen_vector(lua_State* L);
+
 #define LUA_UTF8LIBNAME "utf8"
 LUALIB_API int luaopen_utf8(lua_State* L);
 
@@ -136,6 +140,20 @@ LUALIB_API int luaopen_math(lua_State* L);
 #define LUA_DBLIBNAME "debug"
 LUALIB_API int luaopen_debug(lua_State* L);
 
+// optional JSON library, not opened by luaL_openlibs
+#define LUA_JSONLIBNAME "json"
+LUALIB_API int luaopen_json(lua_State* L);
+
+// optional task scheduler, not opened by luaL_openlibs; the host drives it by calling luaL_taskstep with the current time
+#define LUA_TASKLIBNAME "task"
+LUALIB_API int luaopen_task(lua_State* L);
+
+// resumes the tasks that are ready at 'now'; on error, returns the status with the error object at the top of the stack
+// tasks that are scheduled during the step run in the next step, and the remaining tasks stay queued when a task fails
+LUALIB_API int luaL_taskstep(lua_State* L, double now);
+// returns the number of queued tasks, including cancelled ones that haven't been dequeued yet, and the time of the earliest one
+LUALIB_API int luaL_taskpending(lua_State* L, double* next);
+
 // open all builtin libraries
 LUALIB_API void luaL_openlibs(lua_State* L);
 
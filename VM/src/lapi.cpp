@@ -7,12 +7,16 @@
 #include "ltable.h"
 #include "lfunc.h"
 #include "lgc.h"
+#include "lmem.h"
 #include "ldo.h"
+#include "ldebug.h"
 #include "ludata.h"
 #include "lvm.h"
 #include "lnumutils.h"
 #include "lbuffer.h"
 
+#include <atomic>
+
 #include <string.h>
 
 /*
@@ -58,12 +62,6 @@ const char* luau_ident = "$Luau: Copyright (C) 2019-2023 Roblox Corporation $\n"
         L->top = p; \
     }
 
-#define updateatom(L, ts) \
-    { \
-        if (ts->atom == ATOM_UNDEF) \
-            ts->atom = L->global->cb.useratom ? L->global->cb.useratom(ts->data, ts->len) : -1; \
-    }
-
 static Table* getcurrenv(lua_State* L)
 {
     if (L->ci == L->base_ci) // no enclosing function?
@@ -447,10 +445,7 @@ const char* lua_tostringatom(lua_State* L, int idx, int* atom)
         return NULL;
     TString* s = tsvalue(o);
     if (atom)
-    {
-        updateatom(L, s);
-        *atom = s->atom;
-    }
+        *atom = luaS_getatom(L->global, s);
     return getstr(s);
 }
 
@@ -460,10 +455,7 @@ const char* lua_namecallatom(lua_State* L, int* atom)
     if (!s)
         return NULL;
     if (atom)
-    {
-        updateatom(L, s);
-        *atom = s->atom;
-    }
+        *atom = luaS_getatom(L->global, s);
     return getstr(s);
 }
 
@@ -758,13 +750,51 @@ void lua_createtable(lua_State* L, int narray, int nrec)
     api_incr_top(L);
 }
 
+void lua_createtablefrom(lua_State* L, const char* const* keys, int nkeys)
+{
+    api_checknelems(L, nkeys);
+    luaC_checkGC(L);
+    luaC_threadbarrier(L);
+    Table* t = luaH_new(L, 0, nkeys);
+    sethvalue(L, L->top, t);
+    api_incr_top(L);
+    StkId values = L->top - 1 - nkeys;
+    // the table is new so it has no metatable, isn't readonly and is never black, which means we don't need barriers
+    for (int i = 0; i < nkeys; i++)
+    {
+        if (!ttisnil(values + i))
+            setobj2t(L, luaH_setstr(L, t, luaS_new(L, keys[i])), values + i);
+    }
+    setobj2s(L, values, L->top - 1);
+    L->top = values + 1;
+}
+
 void lua_setreadonly(lua_State* L, int objindex, int enabled)
 {
     const TValue* o = index2addr(L, objindex);
     api_check(L, ttistable(o));
     Table* t = hvalue(o);
     api_check(L, t != hvalue(registry(L)));
-    t->readonly = bool(enabled);
+    api_check(L, enabled || !isfrozen(obj2gco(t))); // frozen tables must stay readonly
+    if (enabled)
+        t->readonly |= TABLE_READONLY;
+    else
+        t->readonly &= ~TABLE_READONLY;
+}
+
+void lua_freeze(lua_State* L, int objindex)
+{
+    const TValue* o = index2addr(L, objindex);
+    api_check(L, ttistable(o));
+    Table* t = hvalue(o);
+    api_check(L, t != hvalue(registry(L)));
+    luaC_freeze(L, t);
+}
+
+int lua_getfrozen(lua_State* L, int objindex)
+{
+    const TValue* o = index2addr(L, objindex);
+    return iscollectable(o) && isfrozen(gcvalue(o));
 }
 
 int lua_getreadonly(lua_State* L, int objindex)
@@ -772,7 +802,7 @@ int lua_getreadonly(lua_State* L, int objindex)
     const TValue* o = index2addr(L, objindex);
     api_check(L, ttistable(o));
     Table* t = hvalue(o);
-    int res = t->readonly;
+    int res = isreadonly(t);
     return res;
 }
 
@@ -859,7 +889,7 @@ void lua_rawsetfield(lua_State* L, int idx, const char* k)
     StkId t = index2addr(L, idx);
     api_check(L, ttistable(t));
     if (hvalue(t)->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, hvalue(t));
     setobj2t(L, luaH_setstr(L, hvalue(t), luaS_new(L, k)), L->top - 1);
     luaC_barriert(L, hvalue(t), L->top - 1);
     L->top--;
@@ -871,7 +901,7 @@ void lua_rawset(lua_State* L, int idx)
     StkId t = index2addr(L, idx);
     api_check(L, ttistable(t));
     if (hvalue(t)->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, hvalue(t));
     setobj2t(L, luaH_set(L, hvalue(t), L->top - 2), L->top - 1);
     luaC_barriert(L, hvalue(t), L->top - 1);
     L->top -= 2;
@@ -883,7 +913,7 @@ void lua_rawseti(lua_State* L, int idx, int n)
     StkId o = index2addr(L, idx);
     api_check(L, ttistable(o));
     if (hvalue(o)->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, hvalue(o));
     setobj2t(L, luaH_setnum(L, hvalue(o), n), L->top - 1);
     luaC_barriert(L, hvalue(o), L->top - 1);
     L->top--;
@@ -905,7 +935,7 @@ int lua_setmetatable(lua_State* L, int objindex)
     case LUA_TTABLE:
     {
         if (hvalue(obj)->readonly)
-            luaG_readonlyerror(L);
+            luaH_makewritable(L, hvalue(obj));
         hvalue(obj)->metatable = mt;
         if (mt)
             luaC_objbarrier(L, hvalue(obj), mt);
@@ -1017,6 +1047,61 @@ int lua_pcall(lua_State* L, int nargs, int nresults, int errfunc)
     return status;
 }
 
+static TValue* getrefslot(lua_State* L, int ref)
+{
+    global_State* g = L->global;
+    int index = refindex(ref);
+
+    // stale references fail the generation check since the generation of the slot changes when it's released
+    if (ref <= LUA_REFNIL || index == 0 || index >= g->reftop || g->refgens[index] != (LUAI_REFUSED | refgeneration(ref)))
+        return NULL;
+
+    return &g->refs[index];
+}
+
+int lua_preparecall(lua_State* L, int idx)
+{
+    api_check(L, ttisfunction(index2addr(L, idx)));
+    return lua_ref(L, idx);
+}
+
+void lua_unpreparecall(lua_State* L, int call)
+{
+    lua_unref(L, call);
+}
+
+int lua_pcallprepared(lua_State* L, int call, int nargs, int nresults)
+{
+    api_checknelems(L, nargs);
+    api_check(L, L->status == 0);
+
+    // the function was checked when the call was prepared, so it's taken from the reference slab without going through the stack API
+    const TValue* f = getrefslot(L, call);
+    api_check(L, f && ttisfunction(f));
+
+    // the function is inserted below the arguments, which needs one more stack slot than the caller has pushed
+    luaD_checkstack(L, 1);
+    expandstacklimit(L, L->top + 1);
+    luaC_threadbarrier(L);
+
+    StkId func = L->top - nargs;
+    for (StkId p = L->top; p > func; --p)
+        setobj2s(L, p, p - 1);
+    setobj2s(L, func, f);
+    api_incr_top(L);
+
+    checkresults(L, nargs, nresults);
+
+    struct CallS c;
+    c.func = func;
+    c.nresults = nresults;
+
+    int status = luaD_pcall(L, f_call, &c, savestack(L, c.func), 0);
+
+    adjustresults(L, nresults);
+    return status;
+}
+
 int lua_status(lua_State* L)
 {
     return L->status;
@@ -1053,6 +1138,76 @@ void lua_setthreaddata(lua_State* L, void* data)
 ** Garbage-collection function
 */
 
+// performs an explicit step of the given amount of GC work in bytes; returns true if the step finished a cycle
+static bool gcstep(lua_State* L, size_t amount)
+{
+    global_State* g = L->global;
+    bool finished = false;
+
+    ptrdiff_t oldcredit = g->gcstate == GCSpause ? 0 : g->GCthreshold - g->totalbytes;
+
+    // temporarily adjust the threshold so that we can perform GC work
+    if (amount <= g->totalbytes)
+        g->GCthreshold = g->totalbytes - amount;
+    else
+        g->GCthreshold = 0;
+
+#ifdef LUAI_GCMETRICS
+    double startmarktime = g->gcmetrics.currcycle.marktime;
+    double startsweeptime = g->gcmetrics.currcycle.sweeptime;
+#endif
+
+    // track how much work the loop will actually perform
+    size_t actualwork = 0;
+
+    while (g->GCthreshold <= g->totalbytes)
+    {
+        size_t stepsize = luaC_step(L, false);
+
+        actualwork += stepsize;
+
+        if (g->gcstate == GCSpause)
+        {                    // end of cycle?
+            finished = true; // signal it
+            break;
+        }
+    }
+
+#ifdef LUAI_GCMETRICS
+    // record explicit step statistics
+    GCCycleMetrics* cyclemetrics = g->gcstate == GCSpause ? &g->gcmetrics.lastcycle : &g->gcmetrics.currcycle;
+
+    double totalmarktime = cyclemetrics->marktime - startmarktime;
+    double totalsweeptime = cyclemetrics->sweeptime - startsweeptime;
+
+    if (totalmarktime > 0.0)
+    {
+        cyclemetrics->markexplicitsteps++;
+
+        if (totalmarktime > cyclemetrics->markmaxexplicittime)
+            cyclemetrics->markmaxexplicittime = totalmarktime;
+    }
+
+    if (totalsweeptime > 0.0)
+    {
+        cyclemetrics->sweepexplicitsteps++;
+
+        if (totalsweeptime > cyclemetrics->sweepmaxexplicittime)
+            cyclemetrics->sweepmaxexplicittime = totalsweeptime;
+    }
+#endif
+
+    // if cycle hasn't finished, advance threshold forward for the amount of extra work performed
+    if (g->gcstate != GCSpause)
+    {
+        // if a new cycle was triggered by explicit step, old 'credit' of GC work is 0
+        ptrdiff_t newthreshold = g->totalbytes + actualwork + oldcredit;
+        g->GCthreshold = newthreshold < 0 ? 0 : newthreshold;
+    }
+
+    return finished;
+}
+
 int lua_gc(lua_State* L, int what, int data)
 {
     int res = 0;
@@ -1093,67 +1248,7 @@ int lua_gc(lua_State* L, int what, int data)
     }
     case LUA_GCSTEP:
     {
-        size_t amount = (cast_to(size_t, data) << 10);
-        ptrdiff_t oldcredit = g->gcstate == GCSpause ? 0 : g->GCthreshold - g->totalbytes;
-
-        // temporarily adjust the threshold so that we can perform GC work
-        if (amount <= g->totalbytes)
-            g->GCthreshold = g->totalbytes - amount;
-        else
-            g->GCthreshold = 0;
-
-#ifdef LUAI_GCMETRICS
-        double startmarktime = g->gcmetrics.currcycle.marktime;
-        double startsweeptime = g->gcmetrics.currcycle.sweeptime;
-#endif
-
-        // track how much work the loop will actually perform
-        size_t actualwork = 0;
-
-        while (g->GCthreshold <= g->totalbytes)
-        {
-            size_t stepsize = luaC_step(L, false);
-
-            actualwork += stepsize;
-
-            if (g->gcstate == GCSpause)
-            {            // end of cycle?
-                res = 1; // signal it
-                break;
-            }
-        }
-
-#ifdef LUAI_GCMETRICS
-        // record explicit step statistics
-        GCCycleMetrics* cyclemetrics = g->gcstate == GCSpause ? &g->gcmetrics.lastcycle : &g->gcmetrics.currcycle;
-
-        double totalmarktime = cyclemetrics->marktime - startmarktime;
-        double totalsweeptime = cyclemetrics->sweeptime - startsweeptime;
-
-        if (totalmarktime > 0.0)
-        {
-            cyclemetrics->markexplicitsteps++;
-
-            if (totalmarktime > cyclemetrics->markmaxexplicittime)
-                cyclemetrics->markmaxexplicittime = totalmarktime;
-        }
-
-        if (totalsweeptime > 0.0)
-        {
-            cyclemetrics->sweepexplicitsteps++;
-
-            if (totalsweeptime > cyclemetrics->sweepmaxexplicittime)
-                cyclemetrics->sweepmaxexplicittime = totalsweeptime;
-        }
-#endif
-
-        // if cycle hasn't finished, advance threshold forward for the amount of extra work performed
-        if (g->gcstate != GCSpause)
-        {
-            // if a new cycle was triggered by explicit step, old 'credit' of GC work is 0
-            ptrdiff_t newthreshold = g->totalbytes + actualwork + oldcredit;
-            g->GCthreshold = newthreshold < 0 ? 0 : newthreshold;
-        }
+        res = gcstep(L, cast_to(size_t, data) << 10) ? 1 : 0;
         break;
     }
     case LUA_GCSETGOAL:
@@ -1175,12 +1270,145 @@ int lua_gc(lua_State* L, int what, int data)
         g->gcstepsize = data << 10;
         break;
     }
+    case LUA_GCGEN:
+    {
+        res = g->gcgen;
+        g->gcgen = data != 0;
+        break;
+    }
+    case LUA_GCSETGENMINORMUL:
+    {
+        res = g->gcgenminormul;
+        g->gcgenminormul = data;
+        break;
+    }
+    case LUA_GCSETGENMAJORMUL:
+    {
+        res = g->gcgenmajormul;
+        g->gcgenmajormul = data;
+        break;
+    }
+    case LUA_GCSETWORKERS:
+    {
+        res = g->gcworkers;
+        g->gcworkers = data;
+        break;
+    }
+    case LUA_GCCOMPACT:
+    {
+        res = luaC_compact(L, data > 0 ? data : LUAI_GCCOMPACTOCCUPANCY);
+        break;
+    }
+    case LUA_GCSETTABLESHRINK:
+    {
+        res = g->gctableshrink;
+        g->gctableshrink = data;
+        break;
+    }
+    case LUA_GCSETTHREADPOOL:
+    {
+        res = g->threadpoollimit;
+        g->threadpoollimit = data;
+        luaE_trimthreadpool(L);
+        break;
+    }
+    case LUA_GCSETFRAMEBUDGET:
+    {
+        res = g->gcframebudget;
+        g->gcframebudget = data;
+        break;
+    }
+    case LUA_GCFRAME:
+    {
+        res = int(luaC_frame(L) * 1e6);
+        break;
+    }
+    case LUA_GCIDLE:
+    {
+        res = luaC_idle(L, data * 1e-6) ? 1 : 0;
+        break;
+    }
+    case LUA_GCSETALLOCCACHE:
+    {
+        res = g->alloccachesize;
+        g->alloccachesize = data;
+        break;
+    }
+    case LUA_GCDEBT:
+    {
+        size_t debt = luaC_debt(g) >> 10;
+        res = debt > INT_MAX ? INT_MAX : int(debt);
+        break;
+    }
+    case LUA_GCALLOCCACHEHITRATE:
+    {
+        uint64_t total = g->gcstats.alloccachehits + g->gcstats.alloccachemisses;
+        res = total ? int(g->gcstats.alloccachehits * 100 / total) : 0;
+
+        if (data)
+            g->gcstats.alloccachehits = g->gcstats.alloccachemisses = 0;
+        break;
+    }
     default:
         res = -1; // invalid option
     }
     return res;
 }
 
+struct GCStepManyContext
+{
+    lua_State** states;
+    size_t budget;
+    size_t totaldebt;
+    std::atomic<int> finished;
+};
+
+static void gcstepmanyjob(void* context, int index)
+{
+    GCStepManyContext* ctx = (GCStepManyContext*)context;
+    lua_State* L = ctx->states[index];
+    size_t debt = luaC_debt(L->global);
+
+    if (debt == 0)
+        return;
+
+    // when the budget doesn't cover all debt, every state gets a share of the budget that matches its share of the debt
+    size_t amount = ctx->totaldebt <= ctx->budget ? debt : size_t(double(ctx->budget) * double(debt) / double(ctx->totaldebt));
+
+    if (amount > 0 && gcstep(L, amount))
+        ctx->finished++;
+}
+
+int lua_gcstepmany(lua_State** states, int count, int budget)
+{
+    GCStepManyContext ctx = {states, cast_to(size_t, budget) << 10, 0};
+
+    for (int i = 0; i < count; ++i)
+        ctx.totaldebt += luaC_debt(states[i]->global);
+
+    if (ctx.totaldebt == 0 || ctx.budget == 0)
+        return 0;
+
+    lua_State* L = states[0];
+
+    if (L->global->cb.gcparallel && count > 1)
+    {
+        L->global->cb.gcparallel(L, count, gcstepmanyjob, &ctx);
+    }
+    else
+    {
+        for (int i = 0; i < count; ++i)
+            gcstepmanyjob(&ctx, i);
+    }
+
+    return ctx.finished;
+}
+
+void lua_gcmetrics(lua_State* L, lua_GCMetrics* metrics)
+{
+    *metrics = L->global->gcstats.metrics;
+}
+
 /*
 ** miscellaneous functions
 */
@@ -1283,6 +1511,29 @@ void* lua_newuserdatatagged(lua_State* L, size_t sz, int tag)
     return u->data;
 }
 
+void lua_newuserdatataggedbatch(lua_State* L, size_t sz, int tag, int count, void** data)
+{
+    api_check(L, unsigned(tag) < LUA_UTAG_LIMIT);
+    api_check(L, count >= 0);
+    luaC_checkGC(L);
+    luaC_threadbarrier(L);
+    Table* t = luaH_new(L, count, 0);
+    sethvalue(L, L->top, t);
+    api_incr_top(L);
+
+    // all objects are new, so they can be stored in the array without barriers
+    Table* mt = L->global->udatamt[tag];
+    for (int i = 0; i < count; ++i)
+    {
+        Udata* u = luaU_newudata(L, sz, tag);
+        u->metatable = mt;
+        setuvalue(L, &t->array[i], u);
+
+        if (data)
+            data[i] = u->data;
+    }
+}
+
 void* lua_newuserdatadtor(lua_State* L, size_t sz, void (*dtor)(void*))
 {
     luaC_checkGC(L);
@@ -1366,33 +1617,67 @@ uintptr_t lua_encodepointer(lua_State* L, uintptr_t p)
     return uintptr_t((g->ptrenckey[0] * p + g->ptrenckey[2]) ^ (g->ptrenckey[1] * p + g->ptrenckey[3]));
 }
 
+static void growrefs(lua_State* L, void* ud)
+{
+    global_State* g = L->global;
+    int newsize = *(int*)ud;
+
+    luaM_reallocarray(L, g->refs, g->refsize, newsize, TValue, 0);
+}
+
 int lua_ref(lua_State* L, int idx)
 {
     api_check(L, idx != LUA_REGISTRYINDEX); // idx is a stack index for value
-    int ref = LUA_REFNIL;
     global_State* g = L->global;
     StkId p = index2addr(L, idx);
-    if (!ttisnil(p))
-    {
-        Table* reg = hvalue(registry(L));
+    if (ttisnil(p))
+        return LUA_REFNIL;
 
-        if (g->registryfree != 0)
-        { // reuse existing slot
-            ref = g->registryfree;
-        }
-        else
-        { // no free elements
-            ref = luaH_getn(reg);
-            ref++; // create new reference
+    int index = g->reffree;
+
+    if (index != 0)
+    { // reuse released slot
+        g->reffree = int(nvalue(&g->refs[index]));
+    }
+    else
+    { // no released slots
+        if (g->reftop >= g->refsize)
+        {
+            if (g->refsize >= LUAI_REFMAXSLOTS)
+                luaG_runerror(L, "too many references");
+
+            int newsize = g->refsize == 0 ? 16 : g->refsize * 2;
+            if (newsize > LUAI_REFMAXSLOTS)
+                newsize = LUAI_REFMAXSLOTS;
+
+            // both arrays are allocated before either is changed, so that a failed allocation leaves them consistent
+            uint8_t* refgens = luaM_newarray(L, newsize, uint8_t, 0);
+
+            int status = luaD_rawrunprotected(L, growrefs, &newsize);
+
+            if (status != 0)
+            {
+                luaM_freearray(L, refgens, newsize, uint8_t, 0);
+                luaD_throw(L, status);
+            }
+
+            if (g->refsize)
+                memcpy(refgens, g->refgens, g->refsize);
+            memset(refgens + g->refsize, 0, newsize - g->refsize);
+
+            luaM_freearray(L, g->refgens, g->refsize, uint8_t, 0);
+            g->refgens = refgens;
+            g->refsize = newsize;
         }
 
-        TValue* slot = luaH_setnum(L, reg, ref);
-        if (g->registryfree != 0)
-            g->registryfree = int(nvalue(slot));
-        setobj2t(L, slot, p);
-        luaC_barriert(L, reg, p);
+        index = g->reftop++;
     }
-    return ref;
+
+    setobj(L, &g->refs[index], p);
+    luaC_barrierref(L, p);
+
+    g->refgens[index] |= LUAI_REFUSED;
+    return (g->refgens[index] & LUAI_REFGENMASK) << LUAI_REFINDEXBITS | index;
 }
 
 void lua_unref(lua_State* L, int ref)
@@ -1400,11 +1685,33 @@ void lua_unref(lua_State* L, int ref)
     if (ref <= LUA_REFNIL)
         return;
 
+    TValue* slot = getrefslot(L, ref);
+    api_check(L, slot); // the reference was already released or wasn't created by lua_ref
+    if (!slot)
+        return;
+
     global_State* g = L->global;
-    Table* reg = hvalue(registry(L));
-    TValue* slot = luaH_setnum(L, reg, ref);
-    setnvalue(slot, g->registryfree); // NB: no barrier needed because value isn't collectable
-    g->registryfree = ref;
+    int index = refindex(ref);
+
+    setnvalue(slot, g->reffree); // NB: no barrier needed because value isn't collectable
+    g->reffree = index;
+    g->refgens[index] = (g->refgens[index] + 1) & LUAI_REFGENMASK;
+}
+
+int lua_getref(lua_State* L, int ref)
+{
+    luaC_threadbarrier(L);
+    const TValue* slot = getrefslot(L, ref);
+    if (slot)
+    {
+        setobj2s(L, L->top, slot);
+    }
+    else
+    {
+        setnilvalue(L->top);
+    }
+    api_incr_top(L);
+    return ttype(L->top - 1);
 }
 
 void lua_setuserdatatag(lua_State* L, int idx, int tag)
@@ -1418,6 +1725,7 @@ void lua_setuserdatatag(lua_State* L, int idx, int tag)
 void lua_setuserdatadtor(lua_State* L, int tag, lua_Destructor dtor)
 {
     api_check(L, unsigned(tag) < LUA_UTAG_LIMIT);
+    api_check(L, !dtor || !L->global->udatabatchgc[tag]);
     L->global->udatagc[tag] = dtor;
 }
 
@@ -1427,6 +1735,13 @@ lua_Destructor lua_getuserdatadtor(lua_State* L, int tag)
     return L->global->udatagc[tag];
 }
 
+void lua_setuserdatabatchdtor(lua_State* L, int tag, lua_BatchDestructor dtor)
+{
+    api_check(L, unsigned(tag) < LUA_UTAG_LIMIT);
+    api_check(L, !dtor || !L->global->udatagc[tag]);
+    L->global->udatabatchgc[tag] = dtor;
+}
+
 void lua_setuserdatametatable(lua_State* L, int tag, int idx)
 {
     api_check(L, unsigned(tag) < LUA_UTAG_LIMIT);
@@ -1437,6 +1752,12 @@ void lua_setuserdatametatable(lua_State* L, int tag, int idx)
     L->top--;
 }
 
+void lua_setuserdataops(lua_State* L, int tag, const lua_UserdataOps* ops)
+{
+    api_check(L, unsigned(tag) < LUA_UTAG_LIMIT);
+    L->global->udataops[tag] = ops;
+}
+
 void lua_getuserdatametatable(lua_State* L, int tag)
 {
     api_check(L, unsigned(tag) < LUA_UTAG_LIMIT);
@@ -1492,7 +1813,7 @@ void lua_cleartable(lua_State* L, int idx)
     api_check(L, ttistable(t));
     Table* tt = hvalue(t);
     if (tt->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, tt);
     luaH_clear(tt);
 }
 
@@ -1507,12 +1828,93 @@ void lua_setmemcat(lua_State* L, int category)
     L->activememcat = uint8_t(category);
 }
 
+void lua_sethotthreshold(lua_State* L, int threshold)
+{
+    api_check(L, threshold >= 0);
+    L->global->hotthreshold = unsigned(threshold);
+}
+
+void lua_setatomtable(lua_State* L, const lua_AtomTable* t)
+{
+    L->global->atomtable = t;
+}
+
+void lua_setinterruptbudget(lua_State* L, int budget)
+{
+    api_check(L, budget >= 0);
+    L->interruptbudget = budget;
+}
+
+int lua_getinterruptbudget(lua_State* L)
+{
+    return L->interruptbudget;
+}
+
+void lua_setallocsamplerate(lua_State* L, int bytes)
+{
+    api_check(L, bytes >= 0);
+    L->global->allocsamplerate = size_t(bytes);
+    L->global->allocsampleleft = size_t(bytes);
+}
+
+void lua_settypeprofiling(lua_State* L, int enable)
+{
+    L->global->typeprofiling = enable != 0;
+}
+
+void lua_setmemcatlimit(lua_State* L, int category, size_t softlimit, size_t hardlimit)
+{
+    api_check(L, unsigned(category) < LUA_MEMORY_CATEGORIES);
+    luaM_setmemcatlimit(L, uint8_t(category), softlimit, hardlimit);
+}
+
 size_t lua_totalbytes(lua_State* L, int category)
 {
     api_check(L, category < LUA_MEMORY_CATEGORIES);
     return category < 0 ? L->global->totalbytes : L->global->memcatbytes[category];
 }
 
+void lua_getstackstats(lua_State* L, int category, lua_StackStats* stats)
+{
+    api_check(L, category < LUA_MEMORY_CATEGORIES);
+
+    if (category >= 0)
+    {
+        *stats = L->global->memcatstackstats[category];
+        return;
+    }
+
+    *stats = lua_StackStats();
+
+    for (int i = 0; i < LUA_MEMORY_CATEGORIES; i++)
+    {
+        const lua_StackStats& cat = L->global->memcatstackstats[i];
+
+        stats->stackgrowths += cat.stackgrowths;
+        stats->cigrowths += cat.cigrowths;
+        stats->maxstacksize = cat.maxstacksize > stats->maxstacksize ? cat.maxstacksize : stats->maxstacksize;
+        stats->maxcisize = cat.maxcisize > stats->maxcisize ? cat.maxcisize : stats->maxcisize;
+    }
+}
+
+lua_HeapSnapshot* lua_heapsnapshotbegin(lua_State* L, void* context, lua_HeapSnapshotWrite write)
+{
+    api_check(L, !L->global->heapsnapshot);
+    return luaC_heapsnapshotbegin(L, context, write);
+}
+
+int lua_heapsnapshotstep(lua_State* L, lua_HeapSnapshot* snapshot, double budget)
+{
+    api_check(L, L->global->heapsnapshot == snapshot);
+    return luaC_heapsnapshotstep(L, snapshot, budget);
+}
+
+void lua_heapsnapshotend(lua_State* L, lua_HeapSnapshot* snapshot)
+{
+    api_check(L, L->global->heapsnapshot == snapshot);
+    luaC_heapsnapshotend(L, snapshot);
+}
+
 lua_Alloc lua_getallocf(lua_State* L, void** ud)
 {
     lua_Alloc f = L->global->frealloc;
@@ -1520,3 +1922,9 @@ lua_Alloc lua_getallocf(lua_State* L, void** ud)
         *ud = L->global->ud;
     return f;
 }
+
+void lua_sethostbuiltin(lua_State* L, int id, lua_HostBuiltin f)
+{
+    api_check(L, unsigned(id) < LUA_HOSTBUILTIN_LIMIT);
+    L->global->hostbuiltins[id] = f;
+}
@@ -412,7 +412,21 @@ void luaL_buffinit(lua_State* L, luaL_Strbuf* B)
 char* luaL_buffinitsize(lua_State* L, luaL_Strbuf* B, size_t size)
 {
     luaL_buffinit(L, B);
-    return luaL_prepbuffsize(B, size);
+
+    if (size <= LUA_BUFFERSIZE)
+        return B->p;
+
+    // reserve exactly the requested size, so that a buffer that is filled completely is finished without a copy
+    TString* storage = luaS_bufstart(L, size);
+
+    lua_pushnil(L);
+    setsvalue(L, L->top - 1, storage);
+
+    B->p = storage->data;
+    B->end = storage->data + size;
+    B->storage = storage;
+
+    return B->p;
 }
 
 char* luaL_prepbuffsize(luaL_Strbuf* B, size_t size)
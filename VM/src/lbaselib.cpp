@@ -78,7 +78,7 @@ static int luaB_error(lua_State* L)
         lua_pushvalue(L, 1);
         lua_concat(L, 2);
     }
-    lua_error(L);
+    luaD_throwvm(L, LUA_ERRRUN, true);
 }
 
 static int luaB_getmetatable(lua_State* L)
@@ -294,6 +294,10 @@ static int luaB_pcally(lua_State* L)
     // any errors from this point on are handled by continuation
     L->ci->flags |= LUA_CALLINFO_HANDLE;
 
+    // when the caller ignores all results, the error object is never observed so VM errors can skip building the message
+    if (L->ci->nresults == 0)
+        L->ci->flags |= LUA_CALLINFO_DISCARD;
+
     // maintain yieldable invariant (baseCcalls <= nCcalls)
     L->baseCcalls++;
     int status = luaD_pcall(L, luaB_pcallrun, func, savestack(L, func), 0);
@@ -247,6 +247,326 @@ static int buffer_fill(lua_State* L)
     return 0;
 }
 
+static int buffer_compare(lua_State* L)
+{
+    size_t alen = 0;
+    void* abuf = luaL_checkbuffer(L, 1, &alen);
+    int aoffset = luaL_checkinteger(L, 2);
+
+    size_t blen = 0;
+    void* bbuf = luaL_checkbuffer(L, 3, &blen);
+    int boffset = luaL_optinteger(L, 4, 0);
+
+    int size = luaL_optinteger(L, 5, int(blen) - boffset);
+
+    if (size < 0)
+        luaL_error(L, "buffer access out of bounds");
+
+    if (isoutofbounds(aoffset, alen, unsigned(size)))
+        luaL_error(L, "buffer access out of bounds");
+
+    if (isoutofbounds(boffset, blen, unsigned(size)))
+        luaL_error(L, "buffer access out of bounds");
+
+    int res = memcmp((char*)abuf + aoffset, (char*)bbuf + boffset, size);
+
+    lua_pushnumber(L, res < 0 ? -1 : res > 0 ? 1 : 0);
+    return 1;
+}
+
+static int buffer_find(lua_State* L)
+{
+    size_t len = 0;
+    void* buf = luaL_checkbuffer(L, 1, &len);
+    int offset = luaL_checkinteger(L, 2);
+    size_t vlen = 0;
+    const char* val = luaL_checklstring(L, 3, &vlen);
+    int size = luaL_optinteger(L, 4, int(len) - offset);
+
+    if (size < 0)
+        luaL_error(L, "buffer access out of bounds");
+
+    if (isoutofbounds(offset, len, unsigned(size)))
+        luaL_error(L, "buffer access out of bounds");
+
+    const char* begin = (char*)buf + offset;
+    const char* end = begin + size;
+
+    if (vlen == 0)
+    {
+        lua_pushnumber(L, offset);
+        return 1;
+    }
+
+    // memchr finds candidates for the first byte, which is usually vectorized by the C library
+    for (const char* pos = begin; size_t(end - pos) >= vlen;)
+    {
+        pos = (const char*)memchr(pos, val[0], (end - pos) - (vlen - 1));
+        if (!pos)
+            break;
+
+        if (memcmp(pos + 1, val + 1, vlen - 1) == 0)
+        {
+            lua_pushnumber(L, double(pos - (char*)buf));
+            return 1;
+        }
+
+        pos++;
+    }
+
+    lua_pushnil(L);
+    return 1;
+}
+
+struct Crc32Table
+{
+    uint32_t data[256];
+
+    constexpr Crc32Table()
+        : data()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+            data[i] = c;
+        }
+    }
+};
+
+// CRC-32 with the polynomial used by zlib, PNG and Ethernet
+static constexpr Crc32Table kCrc32Table;
+
+static int buffer_crc32(lua_State* L)
+{
+    size_t len = 0;
+    void* buf = luaL_checkbuffer(L, 1, &len);
+    int offset = luaL_optinteger(L, 2, 0);
+    int size = luaL_optinteger(L, 3, int(len) - offset);
+
+    if (size < 0)
+        luaL_error(L, "buffer access out of bounds");
+
+    if (isoutofbounds(offset, len, unsigned(size)))
+        luaL_error(L, "buffer access out of bounds");
+
+    const unsigned char* data = (unsigned char*)buf + offset;
+    uint32_t crc = 0xffffffff;
+
+    for (int i = 0; i < size; i++)
+        crc = kCrc32Table.data[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+
+    lua_pushnumber(L, double(crc ^ 0xffffffff));
+    return 1;
+}
+
+// reverses the byte order of each element; with a constant width, compilers turn this into byte shuffles
+template<int Width>
+static void buffer_swaprange(char* data, int size)
+{
+    for (int i = 0; i < size; i += Width)
+    {
+        for (int j = 0; j < Width / 2; j++)
+        {
+            char t = data[i + j];
+            data[i + j] = data[i + Width - 1 - j];
+            data[i + Width - 1 - j] = t;
+        }
+    }
+}
+
+static int buffer_swap(lua_State* L)
+{
+    size_t len = 0;
+    void* buf = luaL_checkbuffer(L, 1, &len);
+    int offset = luaL_checkinteger(L, 2);
+    int size = luaL_checkinteger(L, 3);
+    int width = luaL_checkinteger(L, 4);
+
+    luaL_argcheck(L, width == 2 || width == 4 || width == 8, 4, "width must be 2, 4 or 8");
+    luaL_argcheck(L, size >= 0 && size % width == 0, 3, "count must be a multiple of width");
+
+    if (isoutofbounds(offset, len, unsigned(size)))
+        luaL_error(L, "buffer access out of bounds");
+
+    char* data = (char*)buf + offset;
+
+    if (width == 8)
+        buffer_swaprange<8>(data, size);
+    else if (width == 4)
+        buffer_swaprange<4>(data, size);
+    else
+        buffer_swaprange<2>(data, size);
+
+    return 0;
+}
+
+template<typename T, typename StorageType>
+inline T buffer_loadfp(const char* data)
+{
+    T val;
+
+#if defined(LUAU_BIG_ENDIAN)
+    StorageType tmp;
+    memcpy(&tmp, data, sizeof(tmp));
+    tmp = buffer_swapbe(tmp);
+
+    memcpy(&val, &tmp, sizeof(tmp));
+#else
+    memcpy(&val, data, sizeof(T));
+#endif
+
+    return val;
+}
+
+template<typename T, typename StorageType>
+inline void buffer_storefp(char* data, T val)
+{
+#if defined(LUAU_BIG_ENDIAN)
+    StorageType tmp;
+    memcpy(&tmp, &val, sizeof(tmp));
+    tmp = buffer_swapbe(tmp);
+
+    memcpy(data, &tmp, sizeof(tmp));
+#else
+    memcpy(data, &val, sizeof(T));
+#endif
+}
+
+// checks the range of 'count' elements of type T at the offset stored in argument 'arg' and returns its start
+template<typename T>
+static char* buffer_checkrange(lua_State* L, int arg, int count)
+{
+    size_t len = 0;
+    void* buf = luaL_checkbuffer(L, arg, &len);
+    int offset = luaL_checkinteger(L, arg + 1);
+
+    if (isoutofbounds(offset, len, uint64_t(unsigned(count)) * sizeof(T)))
+        luaL_error(L, "buffer access out of bounds");
+
+    return (char*)buf + offset;
+}
+
+template<typename T, typename StorageType>
+static int buffer_sumfp(lua_State* L)
+{
+    int count = luaL_checkinteger(L, 3);
+    luaL_argcheck(L, count >= 0, 3, "count");
+
+    const char* data = buffer_checkrange<T>(L, 1, count);
+
+    // independent partial sums let the loop run without waiting on the latency of each addition
+    double sum[4] = {};
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        for (int k = 0; k < 4; k++)
+            sum[k] += double(buffer_loadfp<T, StorageType>(data + (i + k) * sizeof(T)));
+    }
+
+    for (; i < count; i++)
+        sum[0] += double(buffer_loadfp<T, StorageType>(data + i * sizeof(T)));
+
+    lua_pushnumber(L, (sum[0] + sum[1]) + (sum[2] + sum[3]));
+    return 1;
+}
+
+template<typename T, typename StorageType, bool Max>
+static int buffer_minmaxfp(lua_State* L)
+{
+    int count = luaL_checkinteger(L, 3);
+    luaL_argcheck(L, count > 0, 3, "count");
+
+    const char* data = buffer_checkrange<T>(L, 1, count);
+
+    // like math.min and math.max, NaN elements are skipped unless the first element is NaN
+    T res = buffer_loadfp<T, StorageType>(data);
+
+    for (int i = 1; i < count; i++)
+    {
+        T v = buffer_loadfp<T, StorageType>(data + i * sizeof(T));
+        res = Max ? (v > res ? v : res) : (v < res ? v : res);
+    }
+
+    lua_pushnumber(L, double(res));
+    return 1;
+}
+
+template<typename T, typename StorageType>
+static int buffer_dotfp(lua_State* L)
+{
+    int count = luaL_checkinteger(L, 5);
+    luaL_argcheck(L, count >= 0, 5, "count");
+
+    const char* a = buffer_checkrange<T>(L, 1, count);
+    const char* b = buffer_checkrange<T>(L, 3, count);
+
+    double sum[4] = {};
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            size_t pos = (i + k) * sizeof(T);
+            sum[k] += double(buffer_loadfp<T, StorageType>(a + pos)) * double(buffer_loadfp<T, StorageType>(b + pos));
+        }
+    }
+
+    for (; i < count; i++)
+        sum[0] += double(buffer_loadfp<T, StorageType>(a + i * sizeof(T))) * double(buffer_loadfp<T, StorageType>(b + i * sizeof(T)));
+
+    lua_pushnumber(L, (sum[0] + sum[1]) + (sum[2] + sum[3]));
+    return 1;
+}
+
+// target[i] += alpha * source[i]
+template<typename T, typename StorageType>
+static int buffer_axpyfp(lua_State* L)
+{
+    double alpha = luaL_checknumber(L, 3);
+    int count = luaL_checkinteger(L, 6);
+    luaL_argcheck(L, count >= 0, 6, "count");
+
+    char* target = buffer_checkrange<T>(L, 1, count);
+    const char* source = buffer_checkrange<T>(L, 4, count);
+
+    // overlapping ranges are processed in order, like a loop in Luau would
+    for (int i = 0; i < count; i++)
+    {
+        size_t pos = i * sizeof(T);
+        double v = double(buffer_loadfp<T, StorageType>(target + pos)) + alpha * double(buffer_loadfp<T, StorageType>(source + pos));
+        buffer_storefp<T, StorageType>(target + pos, T(v));
+    }
+
+    return 0;
+}
+
+template<typename T, typename StorageType>
+static int buffer_clampfp(lua_State* L)
+{
+    int count = luaL_checkinteger(L, 3);
+    T minv = T(luaL_checknumber(L, 4));
+    T maxv = T(luaL_checknumber(L, 5));
+
+    luaL_argcheck(L, count >= 0, 3, "count");
+    luaL_argcheck(L, minv <= maxv, 5, "max must be greater than or equal to min");
+
+    char* data = buffer_checkrange<T>(L, 1, count);
+
+    for (int i = 0; i < count; i++)
+    {
+        T v = buffer_loadfp<T, StorageType>(data + i * sizeof(T));
+        v = v < minv ? minv : v;
+        v = v > maxv ? maxv : v;
+        buffer_storefp<T, StorageType>(data + i * sizeof(T), v);
+    }
+
+    return 0;
+}
+
 static const luaL_Reg bufferlib[] = {
     {"create", buffer_create},
     {"fromstring", buffer_fromstring},
@@ -272,6 +592,22 @@ static const luaL_Reg bufferlib[] = {
     {"len", buffer_len},
     {"copy", buffer_copy},
     {"fill", buffer_fill},
+    {"compare", buffer_compare},
+    {"find", buffer_find},
+    {"crc32", buffer_crc32},
+    {"swap", buffer_swap},
+    {"sumf32", buffer_sumfp<float, uint32_t>},
+    {"sumf64", buffer_sumfp<double, uint64_t>},
+    {"minf32", buffer_minmaxfp<float, uint32_t, false>},
+    {"minf64", buffer_minmaxfp<double, uint64_t, false>},
+    {"maxf32", buffer_minmaxfp<float, uint32_t, true>},
+    {"maxf64", buffer_minmaxfp<double, uint64_t, true>},
+    {"dotf32", buffer_dotfp<float, uint32_t>},
+    {"dotf64", buffer_dotfp<double, uint64_t>},
+    {"axpyf32", buffer_axpyfp<float, uint32_t>},
+    {"axpyf64", buffer_axpyfp<double, uint64_t>},
+    {"clampf32", buffer_clampfp<float, uint32_t>},
+    {"clampf64", buffer_clampfp<double, uint64_t>},
     {NULL, NULL},
 };
 
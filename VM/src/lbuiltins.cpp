@@ -10,6 +10,8 @@
 #include "ldo.h"
 #include "lbuffer.h"
 
+#include "Luau/Bytecode.h"
+
 #include <math.h>
 #include <string.h>
 
@@ -917,6 +919,161 @@ static int luauF_sub(lua_State* L, StkId res, TValue* arg0, int nresults, StkId
     return -1;
 }
 
+// only literal text, '%%' and '%*' items are handled here, which covers the format strings of interpolated strings; '%*' items are limited to
+// values that can't have a __tostring metamethod, and other format items use the full parser in str_format
+static bool formatsize(const TString* fmt, const TValue* args, int nargs, size_t& size, bool& numbers)
+{
+    const char* p = getstr(fmt);
+    const char* end = p + fmt->len;
+    int arg = 0;
+
+    size = 0;
+    numbers = false;
+
+    while (p < end)
+    {
+        if (*p != '%')
+        {
+            const char* next = (const char*)memchr(p, '%', end - p);
+            if (!next)
+                next = end;
+
+            size += next - p;
+            p = next;
+        }
+        else if (p + 1 < end && p[1] == '%')
+        {
+            size += 1;
+            p += 2;
+        }
+        else if (p + 1 < end && p[1] == '*' && arg < nargs)
+        {
+            const TValue* v = &args[arg++];
+
+            switch (ttype(v))
+            {
+            case LUA_TNIL:
+                size += 3;
+                break;
+            case LUA_TBOOLEAN:
+                size += bvalue(v) ? 4 : 5;
+                break;
+            case LUA_TNUMBER:
+                size += LUAI_MAXNUM2STR; // upper bound, the exact length is only known after printing
+                numbers = true;
+                break;
+            case LUA_TSTRING:
+                size += tsvalue(v)->len;
+                break;
+            default:
+                return false;
+            }
+
+            p += 2;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static char* formatwrite(char* buf, const TString* fmt, const TValue* args)
+{
+    const char* p = getstr(fmt);
+    const char* end = p + fmt->len;
+    int arg = 0;
+
+    while (p < end)
+    {
+        if (*p != '%')
+        {
+            const char* next = (const char*)memchr(p, '%', end - p);
+            if (!next)
+                next = end;
+
+            memcpy(buf, p, next - p);
+            buf += next - p;
+            p = next;
+        }
+        else if (p[1] == '%')
+        {
+            *buf++ = '%';
+            p += 2;
+        }
+        else
+        {
+            const TValue* v = &args[arg++];
+
+            switch (ttype(v))
+            {
+            case LUA_TNIL:
+                memcpy(buf, "nil", 3);
+                buf += 3;
+                break;
+            case LUA_TBOOLEAN:
+                memcpy(buf, bvalue(v) ? "true" : "false", bvalue(v) ? 4 : 5);
+                buf += bvalue(v) ? 4 : 5;
+                break;
+            case LUA_TNUMBER:
+                buf = luai_num2str(buf, nvalue(v));
+                break;
+            case LUA_TSTRING:
+                memcpy(buf, getstr(tsvalue(v)), tsvalue(v)->len);
+                buf += tsvalue(v)->len;
+                break;
+            default:
+                LUAU_ASSERT(!"unexpected value type");
+            }
+
+            p += 2;
+        }
+    }
+
+    return buf;
+}
+
+static int luauF_format(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 1 && nresults <= 1 && ttisstring(arg0))
+    {
+        TString* fmt = tsvalue(arg0);
+        size_t size = 0;
+        bool numbers = false;
+
+        if (!formatsize(fmt, args, nparams - 1, size, numbers))
+            return -1;
+
+        if (luaC_needsGC(L))
+            return -1; // we can't call luaC_checkGC so fall back to C implementation
+
+        if (size < LUA_BUFFERSIZE)
+        {
+            char buf[LUA_BUFFERSIZE];
+            char* e = formatwrite(buf, fmt, args);
+
+            setsvalue(L, res, luaS_newlstr(L, buf, e - buf));
+            return 1;
+        }
+
+        // long results are written directly into the string object, which requires the exact size
+        if (!numbers)
+        {
+            TString* ts = luaS_bufstart(L, size);
+            char* e = formatwrite(ts->data, fmt, args);
+            LUAU_ASSERT(size_t(e - ts->data) == size);
+            (void)e;
+
+            setsvalue(L, res, luaS_buffinish(L, ts));
+            return 1;
+        }
+    }
+
+    return -1;
+}
+
 static int luauF_clamp(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
 {
     if (nparams >= 3 && nresults <= 1 && ttisnumber(arg0) && ttisnumber(args) && ttisnumber(args + 1))
@@ -1028,6 +1185,32 @@ static int luauF_tinsert(lua_State* L, StkId res, TValue* arg0, int nresults, St
     return -1;
 }
 
+static int luauF_tremove(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams == 1 && nresults <= 1 && ttistable(arg0))
+    {
+        Table* t = hvalue(arg0);
+        if (t->readonly)
+            return -1;
+
+        // only the last element of the array part is handled here; empty tables and elements in the hash part use the library function
+        int n = luaH_getn(t);
+
+        if (n > 0 && n <= t->sizearray)
+        {
+            TValue* e = &t->array[n - 1];
+
+            if (nresults != 0)
+                setobj2s(L, res, e);
+
+            setnilvalue(e);
+            return nresults == 0 ? 0 : 1;
+        }
+    }
+
+    return -1;
+}
+
 static int luauF_tunpack(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
 {
     if (nparams >= 1 && nresults < 0 && ttistable(arg0))
@@ -1128,7 +1311,7 @@ static int luauF_countrz(lua_State* L, StkId res, TValue* arg0, int nresults, St
 
 static int luauF_select(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
 {
-    if (nparams == 1 && nresults == 1)
+    if (nparams == 1)
     {
         int n = cast_int(L->base - L->ci->func) - clvalue(L->ci->func)->l.p->numparams - 1;
 
@@ -1136,15 +1319,40 @@ static int luauF_select(lua_State* L, StkId res, TValue* arg0, int nresults, Stk
         {
             int i = int(nvalue(arg0));
 
-            // i >= 1 && i <= n
-            if (unsigned(i - 1) < unsigned(n))
+            // index of the first selected argument and the number of selected arguments; negative indices count from the end
+            int first = i > 0 ? i - 1 : n + i;
+            int count = i > 0 ? (i <= n ? n - i + 1 : 0) : -i;
+
+            // note: zero and negative indices that are out of range are errors, so we defer to fallback
+            if (first < 0 || i == 0)
+                return -1;
+
+            if (nresults == LUA_MULTRET)
             {
-                setobj2s(L, res, L->base - n + (i - 1));
-                return 1;
+                // results can extend past the frame of the function when they are used as arguments of another call
+                if (count > L->stack_last - res)
+                    return -1;
+
+                nresults = count;
+            }
+
+            StkId varargs = L->base - n;
+
+            for (int j = 0; j < nresults; ++j)
+            {
+                if (j < count)
+                {
+                    setobj2s(L, res + j, varargs + first + j);
+                }
+                else
+                {
+                    setnilvalue(res + j);
+                }
             }
-            // note: for now we don't handle negative case (wrap around) and defer to fallback
+
+            return nresults;
         }
-        else if (ttisstring(arg0) && *svalue(arg0) == '#')
+        else if (ttisstring(arg0) && *svalue(arg0) == '#' && nresults <= 1)
         {
             setnvalue(res, double(n));
             return 1;
@@ -1437,11 +1645,249 @@ static int luauF_writefp(lua_State* L, StkId res, TValue* arg0, int nresults, St
     return -1;
 }
 
+// vector library fast paths, these need to produce the same results as lveclib.cpp
+static float luauF_dotproduct(const float* a, const float* b)
+{
+    float r = a[0] * b[0];
+
+    for (int i = 1; i < LUA_VECTOR_SIZE; ++i)
+    {
+        float p = a[i] * b[i];
+        r += p;
+    }
+
+    return r;
+}
+
+static int luauF_vectormagnitude(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 1 && nresults <= 1 && ttisvector(arg0))
+    {
+        const float* v = vvalue(arg0);
+
+        setnvalue(res, sqrt(double(luauF_dotproduct(v, v))));
+        return 1;
+    }
+
+    return -1;
+}
+
+static int luauF_vectornormalize(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 1 && nresults <= 1 && ttisvector(arg0))
+    {
+        const float* v = vvalue(arg0);
+
+        float inv = float(1.0 / sqrt(double(luauF_dotproduct(v, v))));
+
+        float r[4] = {};
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+            r[i] = v[i] * inv;
+
+        setvvalue(res, r[0], r[1], r[2], r[3]);
+        return 1;
+    }
+
+    return -1;
+}
+
+static int luauF_vectorcross(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 2 && nresults <= 1 && ttisvector(arg0) && ttisvector(args))
+    {
+        const float* a = vvalue(arg0);
+        const float* b = vvalue(args);
+
+        float x = a[1] * b[2] - a[2] * b[1];
+        float y = a[2] * b[0] - a[0] * b[2];
+        float z = a[0] * b[1] - a[1] * b[0];
+
+        setvvalue(res, x, y, z, 0.0f);
+        return 1;
+    }
+
+    return -1;
+}
+
+static int luauF_vectordot(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 2 && nresults <= 1 && ttisvector(arg0) && ttisvector(args))
+    {
+        setnvalue(res, double(luauF_dotproduct(vvalue(arg0), vvalue(args))));
+        return 1;
+    }
+
+    return -1;
+}
+
+template<float (*Op)(float)>
+static int luauF_vectorunary(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 1 && nresults <= 1 && ttisvector(arg0))
+    {
+        const float* v = vvalue(arg0);
+
+        float r[4] = {};
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+            r[i] = Op(v[i]);
+
+        setvvalue(res, r[0], r[1], r[2], r[3]);
+        return 1;
+    }
+
+    return -1;
+}
+
+static float luauF_floorf(float v)
+{
+    return floorf(v);
+}
+
+static float luauF_ceilf(float v)
+{
+    return ceilf(v);
+}
+
+static float luauF_fabsf(float v)
+{
+    return fabsf(v);
+}
+
+static float luauF_signf(float v)
+{
+    return v > 0.0f ? 1.0f : v < 0.0f ? -1.0f : 0.0f;
+}
+
+static int luauF_vectorclamp(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 3 && nresults <= 1 && ttisvector(arg0) && ttisvector(args) && ttisvector(args + 1))
+    {
+        const float* v = vvalue(arg0);
+        const float* min = vvalue(args);
+        const float* max = vvalue(args + 1);
+
+        float r[4] = {};
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        {
+            // the library function reports the error
+            if (!(min[i] <= max[i]))
+                return -1;
+
+            r[i] = v[i] < min[i] ? min[i] : v[i];
+            r[i] = r[i] > max[i] ? max[i] : r[i];
+        }
+
+        setvvalue(res, r[0], r[1], r[2], r[3]);
+        return 1;
+    }
+
+    return -1;
+}
+
+template<bool Max>
+static int luauF_vectorminmax(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 1 && nresults <= 1 && ttisvector(arg0))
+    {
+        for (int arg = 1; arg < nparams; ++arg)
+            if (!ttisvector(args + arg - 1))
+                return -1;
+
+        const float* v = vvalue(arg0);
+
+        float r[4] = {};
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+            r[i] = v[i];
+
+        for (int arg = 1; arg < nparams; ++arg)
+        {
+            const float* b = vvalue(args + arg - 1);
+
+            for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+                r[i] = (Max ? b[i] > r[i] : b[i] < r[i]) ? b[i] : r[i];
+        }
+
+        setvvalue(res, r[0], r[1], r[2], r[3]);
+        return 1;
+    }
+
+    return -1;
+}
+
+static int luauF_vectorlerp(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams >= 3 && nresults <= 1 && ttisvector(arg0) && ttisvector(args) && ttisnumber(args + 1))
+    {
+        const float* a = vvalue(arg0);
+        const float* b = vvalue(args);
+        float t = float(nvalue(args + 1));
+
+        float r[4] = {};
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        {
+            float d = (b[i] - a[i]) * t;
+            r[i] = a[i] + d;
+        }
+
+        setvvalue(res, r[0], r[1], r[2], r[3]);
+        return 1;
+    }
+
+    return -1;
+}
+
 static int luauF_missing(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
 {
     return -1;
 }
 
+// host builtins convert numeric arguments for the fast path registered with lua_sethostbuiltin
+template<int Id>
+static int luauF_host(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    lua_HostBuiltin f = L->global->hostbuiltins[Id];
+
+    // multiple results are written past the call frame, like with other builtins that return multiple values
+    if (!f || nparams > 8 || nresults > 3 || (nresults == LUA_MULTRET && res + 3 > L->stack_last))
+        return -1;
+
+    double argv[8];
+
+    for (int i = 0; i < nparams; ++i)
+    {
+        const TValue* arg = i == 0 ? arg0 : args + (i - 1);
+
+        if (!ttisnumber(arg))
+            return -1;
+
+        argv[i] = nvalue(arg);
+    }
+
+    double resv[3];
+    int n = f(L, resv, argv, nparams);
+
+    if (n < 0)
+        return -1;
+
+    LUAU_ASSERT(n <= 3);
+
+    int count = nresults == LUA_MULTRET ? n : nresults;
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (i < n)
+        {
+            setnvalue(res + i, resv[i]);
+        }
+        else
+        {
+            setnilvalue(res + i);
+        }
+    }
+
+    return count;
+}
+
 #ifdef LUAU_TARGET_SSE41
 template<int Rounding>
 LUAU_TARGET_SSE41 inline double roundsd_sse41(double v)
@@ -1620,6 +2066,22 @@ const luau_FastFunction luauF_table[256] = {
     luauF_readfp<double>,
     luauF_writefp<double>,
 
+    luauF_vectormagnitude,
+    luauF_vectornormalize,
+    luauF_vectorcross,
+    luauF_vectordot,
+    luauF_vectorunary<luauF_floorf>,
+    luauF_vectorunary<luauF_ceilf>,
+    luauF_vectorunary<luauF_fabsf>,
+    luauF_vectorunary<luauF_signf>,
+    luauF_vectorclamp,
+    luauF_vectorminmax<false>,
+    luauF_vectorminmax<true>,
+    luauF_vectorlerp,
+
+    luauF_tremove,
+    luauF_format,
+
 // When adding builtins, add them above this line; what follows is 64 "dummy" entries with luauF_missing fallback.
 // This is important so that older versions of the runtime that don't support newer builtins automatically fall back via luauF_missing.
 // Given the builtin addition velocity this should always provide a larger compatibility window than bytecode versions suggest.
@@ -1634,5 +2096,34 @@ const luau_FastFunction luauF_table[256] = {
     MISSING8,
     MISSING8,
 
+// The rest of the table up to the ids reserved for host builtins is filled with luauF_missing as well; when adding builtins, remove the same
+// number of entries here to keep host builtins at their ids (HostBuiltins conformance test checks this).
+    MISSING8,
+    MISSING8,
+    MISSING8,
+    MISSING8,
+    MISSING8,
+    MISSING8,
+    MISSING8,
+    MISSING8,
+    luauF_missing,
+    luauF_missing,
+    luauF_missing,
+    luauF_missing,
+
 #undef MISSING8
+
+// Host builtins, LBF_HOST_FIRST..LBF_HOST_FIRST + LBF_HOST_COUNT - 1
+#define HOST8(id) \
+    luauF_host<id>, luauF_host<id + 1>, luauF_host<id + 2>, luauF_host<id + 3>, luauF_host<id + 4>, luauF_host<id + 5>, luauF_host<id + 6>, \
+        luauF_host<id + 7>
+
+    HOST8(0),
+    HOST8(8),
+    HOST8(16),
+    HOST8(24),
+
+#undef HOST8
 };
+
+static_assert(LBF_HOST_FIRST + LBF_HOST_COUNT == 256 && LBF_HOST_COUNT == LUA_HOSTBUILTIN_LIMIT, "host builtins must be at the end of the table");
@@ -0,0 +1,1095 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lua.h"
+
+#include "lapi.h"
+#include "lstate.h"
+#include "lstring.h"
+#include "ltable.h"
+#include "lgc.h"
+#include "lmem.h"
+#include "ldo.h"
+#include "ldebug.h"
+#include "lbuffer.h"
+#include "lfunc.h"
+#include "ludata.h"
+
+#include <string.h>
+
+/*
+** Copying of values between global states
+**
+** The copy is performed in the destination state, which doesn't run the collector while objects are allocated, so the new objects don't
+** need to be anchored until the copy is complete. Objects that were already copied are found by the address of the source object, which
+** preserves cycles and shared references, and lets repeated strings (like keys of records) skip interning.
+**
+** Objects with references to other objects are created first and filled in later from a list of pending objects, so the depth of the
+** copied structure isn't limited by the C stack.
+*/
+
+struct CloneContext
+{
+    lua_State* from;
+    lua_State* to;
+    const TValue* source;
+
+    Table* copies;  // copies in the destination state, keyed by the source object pointer
+    Table* pending; // stack of source objects with copies that still need to be filled in
+    int npending;
+
+    const char* verb;
+    bool immutable; // tables are made readonly and only immutable values are accepted
+    bool full;      // functions, userdata and metatables are copied as well, and objects keep their memory category
+
+    const char* error;
+    const char* errortype; // type of the value that can't be copied
+};
+
+static l_noret clonefail(CloneContext* ctx, const char* error, const char* errortype)
+{
+    ctx->error = error;
+    ctx->errortype = errortype;
+    luaD_throw(ctx->to, LUA_ERRRUN);
+}
+
+static void* findcopy(CloneContext* ctx, void* source)
+{
+    TValue key;
+    setpvalue(&key, source, 0);
+
+    const TValue* copy = luaH_get(ctx->copies, &key);
+    return ttisnil(copy) ? NULL : pvalue(copy);
+}
+
+static void addcopy(CloneContext* ctx, void* source, void* copy)
+{
+    TValue key;
+    setpvalue(&key, source, 0);
+    setpvalue(luaH_set(ctx->to, ctx->copies, &key), copy, 0);
+}
+
+// registers the copy and schedules the source object to be filled in
+static void addpending(CloneContext* ctx, GCObject* source, void* copy)
+{
+    addcopy(ctx, source, copy);
+    setpvalue(luaH_setnum(ctx->to, ctx->pending, ++ctx->npending), source, 0);
+}
+
+// objects keep their memory category in a cloned state
+static void setmemcat(CloneContext* ctx, GCObject* source)
+{
+    if (ctx->full)
+        ctx->to->activememcat = source->gch.memcat;
+}
+
+static TString* clonestring(CloneContext* ctx, TString* ts)
+{
+    // strings are interned by the state, so the same object can be used when both states are the same
+    if (ctx->from->global == ctx->to->global)
+        return ts;
+
+    if (void* copy = findcopy(ctx, ts))
+        return (TString*)copy;
+
+    lua_State* L = ctx->to;
+    setmemcat(ctx, obj2gco(ts));
+
+    TString* res = isshortstr(ts) ? luaS_newshortstr(L, getstr(ts), ts->len, ts->hash) : luaS_newlstr(L, getstr(ts), ts->len);
+
+    // a cloned state assigns atoms with the same callback and atom table
+    if (ctx->full && res->atom == ATOM_UNDEF)
+        res->atom = ts->atom;
+
+    addcopy(ctx, ts, res);
+    return res;
+}
+
+static TString* cloneoptstring(CloneContext* ctx, TString* ts)
+{
+    return ts ? clonestring(ctx, ts) : NULL;
+}
+
+static Buffer* clonebuffer(CloneContext* ctx, Buffer* b)
+{
+    if (void* copy = findcopy(ctx, b))
+        return (Buffer*)copy;
+
+    lua_State* L = ctx->to;
+    setmemcat(ctx, obj2gco(b));
+
+    Buffer* res = luaB_newbuffer(L, b->len);
+    memcpy(res->data, b->data, b->len);
+
+    addcopy(ctx, b, res);
+    return res;
+}
+
+static Table* clonetable(CloneContext* ctx, Table* h)
+{
+    if (void* copy = findcopy(ctx, h))
+        return (Table*)copy;
+
+    if (h->metatable && !ctx->full)
+        clonefail(ctx, "cannot %s a table with a metatable", NULL);
+
+    lua_State* L = ctx->to;
+    setmemcat(ctx, obj2gco(h));
+
+    int nhash = 0;
+    for (int i = 0; i < sizenode(h); ++i)
+        nhash += !ttisnil(gval(gnode(h, i)));
+
+    // the copy is created with the final size, so that it isn't rehashed while it's filled
+    Table* c = luaH_new(L, h->sizearray, nhash);
+
+    if (ctx->immutable)
+    {
+        c->readonly = TABLE_READONLY;
+    }
+    else if (ctx->full)
+    {
+        c->readonly = isreadonly(h);
+        c->safeenv = h->safeenv;
+    }
+
+    addpending(ctx, obj2gco(h), c);
+    return c;
+}
+
+static Proto* cloneproto(CloneContext* ctx, Proto* p)
+{
+    if (void* copy = findcopy(ctx, p))
+        return (Proto*)copy;
+
+    lua_State* L = ctx->to;
+    setmemcat(ctx, obj2gco(p));
+
+    Proto* c = luaF_newproto(L);
+    c->nups = p->nups;
+    c->numparams = p->numparams;
+    c->is_vararg = p->is_vararg;
+    c->maxstacksize = p->maxstacksize;
+    c->flags = p->flags;
+    c->userdata = p->userdata;
+    c->linegaplog2 = p->linegaplog2;
+    c->linedefined = p->linedefined;
+    c->bytecodeid = p->bytecodeid;
+    c->hotcount = p->hotcount;
+
+    addpending(ctx, obj2gco(p), c);
+    return c;
+}
+
+static UpVal* cloneupval(CloneContext* ctx, UpVal* uv)
+{
+    if (void* copy = findcopy(ctx, uv))
+        return (UpVal*)copy;
+
+    lua_State* L = ctx->to;
+    setmemcat(ctx, obj2gco(uv));
+
+    // upvalues that are still open in the source state are closed in the copy
+    UpVal* c = luaM_newgco(L, UpVal, sizeof(UpVal), L->activememcat);
+    luaC_init(L, c, LUA_TUPVAL);
+    c->markedopen = 0;
+    c->v = &c->u.value;
+    setnilvalue(c->v);
+
+    addpending(ctx, obj2gco(uv), c);
+    return c;
+}
+
+static Closure* cloneclosure(CloneContext* ctx, Closure* cl)
+{
+    if (void* copy = findcopy(ctx, cl))
+        return (Closure*)copy;
+
+    lua_State* L = ctx->to;
+    Closure* c;
+
+    if (cl->isC)
+    {
+        setmemcat(ctx, obj2gco(cl));
+        c = luaF_newCclosure(L, cl->nupvalues, NULL);
+        c->c.f = cl->c.f;
+        c->c.cont = cl->c.cont;
+        c->c.debugname = cl->c.debugname;
+    }
+    else
+    {
+        Proto* p = cloneproto(ctx, cl->l.p);
+
+        setmemcat(ctx, obj2gco(cl));
+        c = luaF_newLclosure(L, cl->nupvalues, NULL, p);
+        c->preload = cl->preload;
+    }
+
+    addpending(ctx, obj2gco(cl), c);
+    return c;
+}
+
+static Udata* cloneudata(CloneContext* ctx, Udata* u)
+{
+    if (void* copy = findcopy(ctx, u))
+        return (Udata*)copy;
+
+    // the copied memory would be destroyed twice
+    global_State* g = ctx->from->global;
+    if (u->tag == UTAG_IDTOR || (u->tag < LUA_UTAG_LIMIT && (g->udatagc[u->tag] || g->udatabatchgc[u->tag])))
+        clonefail(ctx, "cannot %s a userdata with a destructor", NULL);
+
+    lua_State* L = ctx->to;
+    setmemcat(ctx, obj2gco(u));
+
+    Udata* c = luaU_newudata(L, u->len, u->tag);
+    memcpy(c->data, u->data, u->len);
+
+    addpending(ctx, obj2gco(u), c);
+    return c;
+}
+
+static void clonevalue(CloneContext* ctx, TValue* res, const TValue* v)
+{
+    lua_State* L = ctx->to;
+
+    switch (ttype(v))
+    {
+    case LUA_TNIL:
+    case LUA_TBOOLEAN:
+    case LUA_TLIGHTUSERDATA:
+    case LUA_TNUMBER:
+    case LUA_TVECTOR:
+        setobj(L, res, v);
+        break;
+    case LUA_TSTRING:
+        setsvalue(L, res, clonestring(ctx, tsvalue(v)));
+        break;
+    case LUA_TTABLE:
+        sethvalue(L, res, clonetable(ctx, hvalue(v)));
+        break;
+    case LUA_TBUFFER:
+        if (ctx->immutable)
+            clonefail(ctx, "cannot %s a %s value", luaT_typenames[ttype(v)]);
+
+        setbufvalue(L, res, clonebuffer(ctx, bufvalue(v)));
+        break;
+    case LUA_TFUNCTION:
+        if (!ctx->full)
+            clonefail(ctx, "cannot %s a %s value", luaT_typenames[ttype(v)]);
+
+        setclvalue(L, res, cloneclosure(ctx, clvalue(v)));
+        break;
+    case LUA_TUSERDATA:
+        if (!ctx->full)
+            clonefail(ctx, "cannot %s a %s value", luaT_typenames[ttype(v)]);
+
+        setuvalue(L, res, cloneudata(ctx, uvalue(v)));
+        break;
+    case LUA_TTHREAD:
+        // the main thread of a cloned state takes the place of the source main thread; other threads aren't copied
+        if (!ctx->full || thvalue(v) != ctx->from->global->mainthread)
+            clonefail(ctx, "cannot %s a %s value", luaT_typenames[ttype(v)]);
+
+        setthvalue(L, res, ctx->to->global->mainthread);
+        break;
+    case LUA_TUPVAL:
+        setupvalue(L, res, cloneupval(ctx, upvalue(v)));
+        break;
+    default:
+        clonefail(ctx, "cannot %s a %s value", luaT_typenames[ttype(v)]);
+    }
+}
+
+static void filltable(CloneContext* ctx, Table* h, Table* c)
+{
+    lua_State* L = ctx->to;
+
+    if (h->metatable)
+        c->metatable = clonetable(ctx, h->metatable);
+
+    for (int i = 0; i < h->sizearray; ++i)
+        clonevalue(ctx, &c->array[i], &h->array[i]);
+
+    for (int i = 0; i < sizenode(h); ++i)
+    {
+        LuaNode* n = gnode(h, i);
+
+        if (ttisnil(gval(n)))
+            continue;
+
+        TValue k, v;
+        getnodekey(ctx->from, &k, n);
+        clonevalue(ctx, &k, &k);
+        clonevalue(ctx, &v, gval(n));
+
+        setobj2t(L, luaH_set(L, c, &k), &v);
+    }
+}
+
+static void fillproto(CloneContext* ctx, Proto* p, Proto* c)
+{
+    lua_State* L = ctx->to;
+
+    // native code isn't copied, the cloned functions run in the interpreter until they are compiled again
+    c->code = luaM_newarray(L, p->sizecode, Instruction, c->memcat);
+    c->sizecode = p->sizecode;
+    memcpy(c->code, p->code, p->sizecode * sizeof(Instruction));
+    c->codeentry = c->code;
+
+    c->k = luaM_newarray(L, p->sizek, TValue, c->memcat);
+    c->sizek = p->sizek;
+    for (int i = 0; i < p->sizek; ++i)
+        setnilvalue(&c->k[i]);
+    for (int i = 0; i < p->sizek; ++i)
+        clonevalue(ctx, &c->k[i], &p->k[i]);
+
+    c->p = luaM_newarray(L, p->sizep, Proto*, c->memcat);
+    c->sizep = p->sizep;
+    for (int i = 0; i < p->sizep; ++i)
+        c->p[i] = cloneproto(ctx, p->p[i]);
+
+    if (p->lineinfo)
+    {
+        c->lineinfo = luaM_newarray(L, p->sizelineinfo, uint8_t, c->memcat);
+        c->sizelineinfo = p->sizelineinfo;
+        memcpy(c->lineinfo, p->lineinfo, p->sizelineinfo);
+        c->abslineinfo = (int*)(c->lineinfo + ((uint8_t*)p->abslineinfo - p->lineinfo));
+    }
+
+    c->locvars = luaM_newarray(L, p->sizelocvars, LocVar, c->memcat);
+    c->sizelocvars = p->sizelocvars;
+    for (int i = 0; i < p->sizelocvars; ++i)
+    {
+        c->locvars[i] = p->locvars[i];
+        c->locvars[i].varname = cloneoptstring(ctx, p->locvars[i].varname);
+    }
+
+    c->upvalues = luaM_newarray(L, p->sizeupvalues, TString*, c->memcat);
+    c->sizeupvalues = p->sizeupvalues;
+    for (int i = 0; i < p->sizeupvalues; ++i)
+        c->upvalues[i] = cloneoptstring(ctx, p->upvalues[i]);
+
+    c->source = cloneoptstring(ctx, p->source);
+    c->debugname = cloneoptstring(ctx, p->debugname);
+
+    if (p->debuginsn)
+    {
+        c->debuginsn = luaM_newarray(L, p->sizecode, uint8_t, c->memcat);
+        memcpy(c->debuginsn, p->debuginsn, p->sizecode);
+    }
+
+    if (p->slotcache)
+    {
+        c->slotcache = luaM_newarray(L, p->sizecode, uint8_t, c->memcat);
+        memcpy(c->slotcache, p->slotcache, p->sizecode);
+    }
+
+    if (p->indexchain)
+    {
+        c->indexchain = luaM_newarray(L, p->sizecode, IndexChain, c->memcat);
+        memcpy(c->indexchain, p->indexchain, p->sizecode * sizeof(IndexChain));
+    }
+
+    if (p->typeinfo)
+    {
+        c->typeinfo = luaM_newarray(L, p->sizetypeinfo, uint8_t, c->memcat);
+        c->sizetypeinfo = p->sizetypeinfo;
+        memcpy(c->typeinfo, p->typeinfo, p->sizetypeinfo);
+    }
+
+    if (p->argtypes)
+    {
+        c->argtypes = luaM_newarray(L, p->numparams, uint8_t, c->memcat);
+        memcpy(c->argtypes, p->argtypes, p->numparams);
+    }
+}
+
+static void fillclosure(CloneContext* ctx, Closure* cl, Closure* c)
+{
+    c->env = clonetable(ctx, cl->env);
+
+    for (int i = 0; i < cl->nupvalues; ++i)
+    {
+        if (cl->isC)
+            clonevalue(ctx, &c->c.upvals[i], &cl->c.upvals[i]);
+        else
+            clonevalue(ctx, &c->l.uprefs[i], &cl->l.uprefs[i]);
+    }
+}
+
+static void fillobject(CloneContext* ctx, GCObject* o)
+{
+    void* copy = findcopy(ctx, o);
+
+    switch (o->gch.tt)
+    {
+    case LUA_TTABLE:
+        filltable(ctx, gco2h(o), (Table*)copy);
+        break;
+    case LUA_TPROTO:
+        fillproto(ctx, gco2p(o), (Proto*)copy);
+        break;
+    case LUA_TFUNCTION:
+        fillclosure(ctx, gco2cl(o), (Closure*)copy);
+        break;
+    case LUA_TUPVAL:
+        clonevalue(ctx, &((UpVal*)copy)->u.value, gco2uv(o)->v);
+        break;
+    case LUA_TUSERDATA:
+        if (gco2u(o)->metatable)
+            ((Udata*)copy)->metatable = clonetable(ctx, gco2u(o)->metatable);
+        break;
+    default:
+        LUAU_ASSERT(!"Unexpected object type");
+    }
+}
+
+static void clonepending(CloneContext* ctx)
+{
+    while (ctx->npending > 0)
+    {
+        const TValue* source = luaH_getnum(ctx->pending, ctx->npending--);
+        fillobject(ctx, (GCObject*)pvalue(source));
+    }
+}
+
+static void clonebegin(lua_State* L, CloneContext* ctx)
+{
+    ctx->copies = luaH_new(L, 0, 0);
+    ctx->pending = luaH_new(L, 0, 0);
+    ctx->npending = 0;
+}
+
+static void f_clone(lua_State* L, void* ud)
+{
+    CloneContext* ctx = (CloneContext*)ud;
+
+    clonebegin(L, ctx);
+
+    TValue res;
+    clonevalue(ctx, &res, ctx->source);
+    clonepending(ctx);
+
+    luaD_checkstack(L, 1);
+    luaC_threadbarrier(L);
+    setobj2s(L, L->top, &res);
+    L->top++;
+}
+
+// copies the value into the destination state and pushes it there
+static int clone(CloneContext* ctx)
+{
+    return luaD_rawrunprotected(ctx->to, f_clone, ctx);
+}
+
+// errors are raised in the source state, since the copy is usually requested by a function running there
+static l_noret cloneerror(CloneContext* ctx, int status)
+{
+    if (ctx->errortype)
+        luaG_runerror(ctx->from, ctx->error, ctx->verb, ctx->errortype);
+    else if (ctx->error)
+        luaG_runerror(ctx->from, ctx->error, ctx->verb);
+    else
+        luaD_throw(ctx->from, status);
+}
+
+void lua_xclone(lua_State* from, lua_State* to, int idx)
+{
+    const TValue* o = luaA_toobject(from, idx);
+    api_check(from, o);
+
+    CloneContext ctx = {from, to, o};
+    ctx.verb = "clone";
+
+    if (int status = clone(&ctx))
+        cloneerror(&ctx, status);
+
+    luaC_checkGC(to);
+}
+
+/*
+** Binary encoding
+**
+** Values are encoded in the native byte order, for passing them between states of the same process. Tables, strings and buffers that
+** appear more than once are encoded once and then referenced by their index in the order of appearance, which preserves cycles.
+*/
+
+#define ENCODE_VERSION 1
+
+enum EncodeTag
+{
+    ENCODE_NIL,
+    ENCODE_FALSE,
+    ENCODE_TRUE,
+    ENCODE_NUMBER,
+    ENCODE_VECTOR,
+    ENCODE_STRING,
+    ENCODE_BUFFER,
+    ENCODE_TABLE,
+    ENCODE_REF,
+};
+
+struct EncodeState
+{
+    lua_State* L;
+    StkId out; // stack slot of the buffer that holds the encoded data, which is replaced with a larger one as needed
+    size_t size;
+
+    Table* refs; // indices of the encoded objects, keyed by the object pointer
+    int nextref;
+};
+
+static void encodereserve(EncodeState* es, size_t extra)
+{
+    Buffer* b = bufvalue(es->out);
+
+    if (extra <= b->len - es->size)
+        return;
+
+    size_t capacity = size_t(b->len) * 2;
+    while (capacity < es->size + extra)
+        capacity *= 2;
+
+    if (capacity > MAX_BUFFER_SIZE)
+        capacity = es->size + extra; // fails in luaB_newbuffer if it's still too large
+
+    Buffer* nb = luaB_newbuffer(es->L, capacity);
+    memcpy(nb->data, b->data, es->size);
+    setbufvalue(es->L, es->out, nb);
+}
+
+static void encodebytes(EncodeState* es, const void* data, size_t size)
+{
+    encodereserve(es, size);
+    memcpy(bufvalue(es->out)->data + es->size, data, size);
+    es->size += size;
+}
+
+static void encodebyte(EncodeState* es, uint8_t value)
+{
+    encodebytes(es, &value, 1);
+}
+
+static void encodevarint(EncodeState* es, size_t value)
+{
+    do
+    {
+        uint8_t byte = value & 127;
+        value >>= 7;
+        encodebyte(es, uint8_t(byte | (value ? 128 : 0)));
+    } while (value);
+}
+
+// encodes a reference to an object that was already encoded, or assigns the next index to it
+static bool encoderef(EncodeState* es, void* object)
+{
+    TValue key;
+    setpvalue(&key, object, 0);
+
+    const TValue* ref = luaH_get(es->refs, &key);
+
+    if (!ttisnil(ref))
+    {
+        encodebyte(es, ENCODE_REF);
+        encodevarint(es, size_t(nvalue(ref)));
+        return true;
+    }
+
+    setnvalue(luaH_set(es->L, es->refs, &key), es->nextref++);
+    return false;
+}
+
+static void encodevalue(EncodeState* es, const TValue* v, int depth)
+{
+    lua_State* L = es->L;
+
+    switch (ttype(v))
+    {
+    case LUA_TNIL:
+        encodebyte(es, ENCODE_NIL);
+        break;
+    case LUA_TBOOLEAN:
+        encodebyte(es, bvalue(v) ? ENCODE_TRUE : ENCODE_FALSE);
+        break;
+    case LUA_TNUMBER:
+        encodebyte(es, ENCODE_NUMBER);
+        encodebytes(es, &nvalue(v), sizeof(double));
+        break;
+    case LUA_TVECTOR:
+        encodebyte(es, ENCODE_VECTOR);
+        encodebytes(es, vvalue(v), sizeof(float) * LUA_VECTOR_SIZE);
+        break;
+    case LUA_TSTRING:
+    {
+        TString* ts = tsvalue(v);
+        if (encoderef(es, ts))
+            break;
+
+        encodebyte(es, ENCODE_STRING);
+        encodevarint(es, ts->len);
+        encodebytes(es, getstr(ts), ts->len);
+        break;
+    }
+    case LUA_TBUFFER:
+    {
+        Buffer* b = bufvalue(v);
+        if (encoderef(es, b))
+            break;
+
+        encodebyte(es, ENCODE_BUFFER);
+        encodevarint(es, b->len);
+        encodebytes(es, b->data, b->len);
+        break;
+    }
+    case LUA_TTABLE:
+    {
+        Table* h = hvalue(v);
+        if (encoderef(es, h))
+            break;
+
+        if (h->metatable)
+            luaG_runerror(L, "cannot encode a table with a metatable");
+
+        if (depth >= LUAI_MAXCCALLS)
+            luaG_runerror(L, "table is nested too deeply to encode");
+
+        int nhash = 0;
+        for (int i = 0; i < sizenode(h); ++i)
+            nhash += !ttisnil(gval(gnode(h, i)));
+
+        encodebyte(es, ENCODE_TABLE);
+        encodevarint(es, h->sizearray);
+        encodevarint(es, nhash);
+
+        for (int i = 0; i < h->sizearray; ++i)
+            encodevalue(es, &h->array[i], depth + 1);
+
+        for (int i = 0; i < sizenode(h); ++i)
+        {
+            LuaNode* n = gnode(h, i);
+
+            if (ttisnil(gval(n)))
+                continue;
+
+            TValue key;
+            getnodekey(L, &key, n);
+            encodevalue(es, &key, depth + 1);
+            encodevalue(es, gval(n), depth + 1);
+        }
+        break;
+    }
+    default:
+        luaG_runerror(L, "cannot encode a %s value", luaT_typenames[ttype(v)]);
+    }
+}
+
+void lua_encodevalue(lua_State* L, int idx)
+{
+    luaC_checkGC(L);
+    luaC_threadbarrier(L);
+    luaD_checkstack(L, 2);
+
+    const TValue* o = luaA_toobject(L, idx);
+    api_check(L, o);
+
+    // the temporary objects are anchored on the stack; the stack isn't reallocated during encoding
+    sethvalue(L, L->top, luaH_new(L, 0, 0));
+    setbufvalue(L, L->top + 1, luaB_newbuffer(L, 64));
+    L->top += 2;
+
+    EncodeState es = {L, L->top - 1, 0, hvalue(L->top - 2), 0};
+    encodebyte(&es, ENCODE_VERSION);
+    encodevalue(&es, o, 0);
+
+    Buffer* res = luaB_newbuffer(L, es.size);
+    memcpy(res->data, bufvalue(es.out)->data, es.size);
+
+    L->top -= 2;
+
+    TValue v;
+    setbufvalue(L, &v, res);
+    luaA_pushobject(L, &v);
+}
+
+struct DecodeState
+{
+    lua_State* L;
+    const char* data;
+    size_t size;
+    size_t offset;
+
+    Table* refs; // decoded objects by their index
+    int nextref;
+};
+
+static l_noret decodeerror(DecodeState* ds)
+{
+    luaG_runerror(ds->L, "malformed encoded value");
+}
+
+static const char* decodebytes(DecodeState* ds, size_t size)
+{
+    if (size > ds->size - ds->offset)
+        decodeerror(ds);
+
+    const char* result = ds->data + ds->offset;
+    ds->offset += size;
+    return result;
+}
+
+static uint8_t decodebyte(DecodeState* ds)
+{
+    return uint8_t(*decodebytes(ds, 1));
+}
+
+static size_t decodevarint(DecodeState* ds)
+{
+    size_t result = 0;
+
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte = decodebyte(ds);
+        result |= size_t(byte & 127) << shift;
+
+        if ((byte & 128) == 0)
+            return result;
+    }
+
+    decodeerror(ds);
+}
+
+static void decoderef(DecodeState* ds, const TValue* v)
+{
+    setobj2t(ds->L, luaH_setnum(ds->L, ds->refs, ++ds->nextref), v);
+}
+
+static void decodevalue(DecodeState* ds, TValue* res, int depth)
+{
+    lua_State* L = ds->L;
+
+    switch (decodebyte(ds))
+    {
+    case ENCODE_NIL:
+        setnilvalue(res);
+        break;
+    case ENCODE_FALSE:
+        setbvalue(res, false);
+        break;
+    case ENCODE_TRUE:
+        setbvalue(res, true);
+        break;
+    case ENCODE_NUMBER:
+    {
+        double n;
+        memcpy(&n, decodebytes(ds, sizeof(double)), sizeof(double));
+        setnvalue(res, n);
+        break;
+    }
+    case ENCODE_VECTOR:
+    {
+        float v[LUA_VECTOR_SIZE];
+        memcpy(v, decodebytes(ds, sizeof(v)), sizeof(v));
+#if LUA_VECTOR_SIZE == 4
+        setvvalue(res, v[0], v[1], v[2], v[3]);
+#else
+        setvvalue(res, v[0], v[1], v[2], 0.0f);
+#endif
+        break;
+    }
+    case ENCODE_STRING:
+    {
+        size_t len = decodevarint(ds);
+        const char* data = decodebytes(ds, len);
+        setsvalue(L, res, luaS_newlstr(L, data, len));
+        decoderef(ds, res);
+        break;
+    }
+    case ENCODE_BUFFER:
+    {
+        size_t len = decodevarint(ds);
+        const char* data = decodebytes(ds, len);
+        Buffer* b = luaB_newbuffer(L, len);
+        memcpy(b->data, data, len);
+        setbufvalue(L, res, b);
+        decoderef(ds, res);
+        break;
+    }
+    case ENCODE_TABLE:
+    {
+        size_t narray = decodevarint(ds);
+        size_t nhash = decodevarint(ds);
+
+        // every value takes at least a byte, which rejects sizes that can't be valid before anything is allocated
+        size_t remaining = ds->size - ds->offset;
+        if (narray > remaining || nhash > remaining / 2 || depth >= LUAI_MAXCCALLS)
+            decodeerror(ds);
+
+        Table* h = luaH_new(L, int(narray), int(nhash));
+        sethvalue(L, res, h);
+        decoderef(ds, res);
+
+        for (size_t i = 0; i < narray; ++i)
+        {
+            TValue v;
+            decodevalue(ds, &v, depth + 1);
+            setobj2t(L, &h->array[i], &v);
+        }
+
+        for (size_t i = 0; i < nhash; ++i)
+        {
+            TValue k, v;
+            decodevalue(ds, &k, depth + 1);
+            decodevalue(ds, &v, depth + 1);
+
+            if (ttisnil(&k) || (ttisnumber(&k) && nvalue(&k) != nvalue(&k)) || ttisnil(&v))
+                decodeerror(ds);
+
+            setobj2t(L, luaH_set(L, h, &k), &v);
+        }
+        break;
+    }
+    case ENCODE_REF:
+    {
+        size_t index = decodevarint(ds);
+        if (index >= size_t(ds->nextref))
+            decodeerror(ds);
+
+        setobj(L, res, luaH_getnum(ds->refs, int(index) + 1));
+        break;
+    }
+    default:
+        decodeerror(ds);
+    }
+}
+
+void lua_decodevalue(lua_State* L, int idx)
+{
+    luaC_checkGC(L);
+    luaC_threadbarrier(L);
+    luaD_checkstack(L, 1);
+
+    const TValue* o = luaA_toobject(L, idx);
+    api_check(L, o && ttisbuffer(o));
+    Buffer* b = bufvalue(o);
+
+    // decoded objects are reachable from the table of references, which is anchored on the stack
+    sethvalue(L, L->top, luaH_new(L, 0, 0));
+    L->top++;
+
+    DecodeState ds = {L, b->data, b->len, 0, hvalue(L->top - 1), 0};
+
+    if (decodebyte(&ds) != ENCODE_VERSION)
+        decodeerror(&ds);
+
+    TValue res;
+    decodevalue(&ds, &res, 0);
+
+    if (ds.offset != ds.size)
+        decodeerror(&ds);
+
+    L->top--;
+    luaA_pushobject(L, &res);
+}
+
+/*
+** Published states
+*/
+
+static bool publishstring(void* context, lua_Page* page, GCObject* gco)
+{
+    lua_State* A = (lua_State*)context;
+
+    if (gco->gch.tt != LUA_TSTRING)
+        return false;
+
+    // other states only read the published strings, so everything that is computed lazily is computed up front
+    TString* ts = gco2ts(gco);
+    if (!isshortstr(ts))
+        luaS_hashlong(ts);
+    luaS_getatom(A->global, ts);
+
+    resetbits(gco->gch.marked, WHITEBITS);
+    setbits(gco->gch.marked, bitmask(FIXEDBIT) | bitmask(FROZENBIT));
+    return false;
+}
+
+lua_State* lua_publish(lua_State* L, int idx)
+{
+    const TValue* o = luaA_toobject(L, idx);
+    api_check(L, o && ttistable(o));
+
+    global_State* g = L->global;
+    lua_State* A = lua_newstate(g->frealloc, g->ud);
+    if (!A)
+        luaD_throw(L, LUA_ERRMEM);
+
+    // atoms of published strings are assigned by the publishing state
+    A->global->cb.useratom = g->cb.useratom;
+    A->global->atomtable = g->atomtable;
+
+    CloneContext ctx = {L, A, o};
+    ctx.verb = "publish";
+    ctx.immutable = true;
+
+    if (int status = clone(&ctx))
+    {
+        lua_close(A);
+        cloneerror(&ctx, status);
+    }
+
+    Table* root = hvalue(A->top - 1);
+    A->top--;
+
+    luaC_freeze(A, root);
+    A->global->published = root;
+
+    // the table of copies and other temporary objects are released before the remaining objects are frozen
+    luaC_fullgc(A);
+
+    // all strings of the published state are frozen, including the ones that are created with the state, which lets the states that share
+    // it find the reserved strings (like metamethod names) in the published state as well
+    luaM_visitgco(A, A, publishstring);
+
+    return A;
+}
+
+void lua_getpublished(lua_State* L)
+{
+    global_State* sg = L->global->sharedstate;
+
+    TValue v;
+    if (sg)
+    {
+        sethvalue(L, &v, sg->published);
+    }
+    else
+    {
+        setnilvalue(&v);
+    }
+    luaA_pushobject(L, &v);
+}
+
+/*
+** Cloned states
+*/
+
+// tables published to the source state are shared with the cloned state instead of being copied
+static void sharepublished(CloneContext* ctx, Table* published)
+{
+    addpending(ctx, obj2gco(published), published);
+
+    while (ctx->npending > 0)
+    {
+        const TValue* source = luaH_getnum(ctx->pending, ctx->npending--);
+        Table* h = gco2h((GCObject*)pvalue(source));
+
+        for (int i = 0; i < h->sizearray; ++i)
+        {
+            if (ttistable(&h->array[i]) && !findcopy(ctx, hvalue(&h->array[i])))
+                addpending(ctx, gcvalue(&h->array[i]), hvalue(&h->array[i]));
+        }
+
+        for (int i = 0; i < sizenode(h); ++i)
+        {
+            LuaNode* n = gnode(h, i);
+
+            if (ttisnil(gval(n)))
+                continue;
+
+            TValue k;
+            getnodekey(ctx->from, &k, n);
+
+            if (ttistable(&k) && !findcopy(ctx, hvalue(&k)))
+                addpending(ctx, gcvalue(&k), hvalue(&k));
+
+            if (ttistable(gval(n)) && !findcopy(ctx, hvalue(gval(n))))
+                addpending(ctx, gcvalue(gval(n)), hvalue(gval(n)));
+        }
+    }
+}
+
+static void f_clonestate(lua_State* L, void* ud)
+{
+    CloneContext* ctx = (CloneContext*)ud;
+    global_State* g = ctx->from->global;
+    global_State* cg = L->global;
+
+    clonebegin(L, ctx);
+
+    if (g->sharedstate)
+        sharepublished(ctx, g->sharedstate->published);
+
+    // everything that the source state can reach, except for the stacks of its threads, is reachable from these roots
+    clonevalue(ctx, &cg->registry, &g->registry);
+
+    if (g->refsize)
+    {
+        cg->refs = luaM_newarray(L, g->refsize, TValue, 0);
+        cg->refgens = luaM_newarray(L, g->refsize, uint8_t, 0);
+        cg->refsize = g->refsize;
+
+        for (int i = 0; i < g->refsize; ++i)
+            setnilvalue(&cg->refs[i]);
+        memcpy(cg->refgens, g->refgens, g->refsize);
+
+        // slot indices and generations are kept, so references created in the source state stay valid in the clone
+        cg->reftop = g->reftop;
+        cg->reffree = g->reffree;
+
+        for (int i = 1; i < g->reftop; ++i)
+            clonevalue(ctx, &cg->refs[i], &g->refs[i]);
+    }
+
+    L->gt = clonetable(ctx, g->mainthread->gt);
+
+    for (int i = 0; i < LUA_T_COUNT; ++i)
+    {
+        if (g->mt[i])
+            cg->mt[i] = clonetable(ctx, g->mt[i]);
+    }
+
+    for (int i = 0; i < LUA_LUTAG_LIMIT; ++i)
+    {
+        if (g->udatamt[i])
+            cg->udatamt[i] = clonetable(ctx, g->udatamt[i]);
+
+        cg->lightuserdataname[i] = cloneoptstring(ctx, g->lightuserdataname[i]);
+    }
+
+    clonepending(ctx);
+
+    L->activememcat = g->mainthread->activememcat;
+}
+
+lua_State* lua_clonestate(lua_State* L)
+{
+    global_State* g = L->global;
+    lua_State* C = g->sharedstate ? lua_newsharedstate(g->frealloc, g->ud, g->sharedstate->mainthread) : lua_newstate(g->frealloc, g->ud);
+    if (!C)
+        luaD_throw(L, LUA_ERRMEM);
+
+    global_State* cg = C->global;
+    cg->cb = g->cb;
+    cg->atomtable = g->atomtable;
+    memcpy(cg->udatagc, g->udatagc, sizeof(g->udatagc));
+    memcpy(cg->udatabatchgc, g->udatabatchgc, sizeof(g->udatabatchgc));
+    memcpy(cg->udataops, g->udataops, sizeof(g->udataops));
+    memcpy(cg->hostbuiltins, g->hostbuiltins, sizeof(g->hostbuiltins));
+
+    cg->gcgoal = g->gcgoal;
+    cg->gcstepmul = g->gcstepmul;
+    cg->gcstepsize = g->gcstepsize;
+    cg->hotthreshold = g->hotthreshold;
+    cg->typeprofiling = g->typeprofiling;
+
+    CloneContext ctx = {L, C};
+    ctx.verb = "clone";
+    ctx.full = true;
+
+    if (int status = luaD_rawrunprotected(C, f_clonestate, &ctx))
+    {
+        lua_close(C);
+        cloneerror(&ctx, status);
+    }
+
+    return C;
+}
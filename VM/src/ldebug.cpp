@@ -322,8 +322,33 @@ static void pusherror(lua_State* L, const char* msg)
     }
 }
 
+// errors raised in Luau functions are unobservable when the nearest C frame is a pcall with discarded results
+// C frames in between could catch the error with lua_pcall, and the protected error callback receives the error object
+static bool isdiscardederror(lua_State* L)
+{
+    if (L->global->cb.debugprotectederror)
+        return false;
+
+    for (CallInfo* ci = L->ci; ci > L->base_ci; ci--)
+    {
+        if (!isLua(ci))
+            return (ci->flags & (LUA_CALLINFO_HANDLE | LUA_CALLINFO_DISCARD)) == (LUA_CALLINFO_HANDLE | LUA_CALLINFO_DISCARD);
+    }
+
+    return false;
+}
+
 l_noret luaG_runerrorL(lua_State* L, const char* fmt, ...)
 {
+    if (isdiscardederror(L))
+    {
+        lua_rawcheckstack(L, 1);
+
+        setnilvalue(L->top);
+        L->top++;
+        luaD_throwvm(L, LUA_ERRRUN, false);
+    }
+
     va_list argp;
     va_start(argp, fmt);
     char result[LUA_BUFFERSIZE];
@@ -333,7 +358,7 @@ l_noret luaG_runerrorL(lua_State* L, const char* fmt, ...)
     lua_rawcheckstack(L, 1);
 
     pusherror(L, result);
-    luaD_throw(L, LUA_ERRRUN);
+    luaD_throwvm(L, LUA_ERRRUN, false);
 }
 
 void luaG_pusherror(lua_State* L, const char* error)
@@ -343,9 +368,19 @@ void luaG_pusherror(lua_State* L, const char* error)
     pusherror(L, error);
 }
 
+static bool hasbreakpoints(Proto* p)
+{
+    for (int i = 0; i < p->sizecode; ++i)
+        if (LUAU_INSN_OP(p->code[i]) == LOP_BREAK)
+            return true;
+
+    return false;
+}
+
 void luaG_breakpoint(lua_State* L, Proto* p, int line, bool enable)
 {
     void (*ondisable)(lua_State*, Proto*) = L->global->ecb.disable;
+    void (*onenable)(lua_State*, Proto*) = L->global->ecb.enable;
 
     // since native code doesn't support breakpoints, we would need to update all call frames with LUAU_CALLINFO_NATIVE that refer to p
     if (p->lineinfo && (ondisable || !p->execdata))
@@ -374,10 +409,11 @@ void luaG_breakpoint(lua_State* L, Proto* p, int line, bool enable)
             p->code[i] |= op;
             LUAU_ASSERT(LUAU_INSN_OP(p->code[i]) == op);
 
-            // currently we don't restore native code when breakpoint is disabled.
-            // this will be addressed in the future.
+            // only the function with the breakpoint switches to bytecode, native code is restored when its last breakpoint is removed
             if (enable && p->execdata && ondisable)
                 ondisable(L, p);
+            else if (!enable && p->execdata && onenable && !hasbreakpoints(p))
+                onenable(L, p);
 
             // note: this is important!
             // we only patch the *first* instruction in each proto that's attributed to a given line
@@ -427,6 +463,59 @@ void lua_singlestep(lua_State* L, int enabled)
     L->singlestep = bool(enabled);
 }
 
+void lua_setopcodestats(lua_State* L, int enabled)
+{
+    global_State* g = L->global;
+
+    if (enabled)
+    {
+        if (!g->opstats)
+            g->opstats = (lua_OpcodeStats*)luaM_new_(L, sizeof(lua_OpcodeStats), 0);
+
+        memset(g->opstats, 0, sizeof(lua_OpcodeStats));
+        g->opstats->lastop = -1;
+    }
+    else
+    {
+        luaG_freeopcodestats(L);
+    }
+}
+
+uint64_t lua_getopcodestat(lua_State* L, int stat, int a, int b)
+{
+    lua_OpcodeStats* stats = L->global->opstats;
+
+    if (!stats)
+        return 0;
+
+    switch (stat)
+    {
+    case LUA_OPSTAT_EXEC:
+        return unsigned(a) < LOP__COUNT ? stats->exec[a] : 0;
+    case LUA_OPSTAT_PAIR:
+        return unsigned(a) < LOP__COUNT && unsigned(b) < LOP__COUNT ? stats->pairs[a][b] : 0;
+    case LUA_OPSTAT_SLOWPATH:
+        return unsigned(a) < LOP__COUNT ? stats->slowpath[a] : 0;
+    case LUA_OPSTAT_FASTCALL:
+        return unsigned(a) < 256 ? stats->fastcall[a] : 0;
+    case LUA_OPSTAT_FASTCALLFALLBACK:
+        return unsigned(a) < 256 ? stats->fastcallfallback[a] : 0;
+    default:
+        return 0;
+    }
+}
+
+void luaG_freeopcodestats(lua_State* L)
+{
+    global_State* g = L->global;
+
+    if (g->opstats)
+    {
+        luaM_free_(L, g->opstats, sizeof(lua_OpcodeStats), 0);
+        g->opstats = NULL;
+    }
+}
+
 static int getmaxline(Proto* p)
 {
     int result = -1;
@@ -551,6 +640,79 @@ static size_t append(char* buf, size_t bufsize, size_t offset, const char* data)
     return offset + copy;
 }
 
+int lua_capturetrace(lua_State* L, int level, lua_TraceFrame* frames, int size)
+{
+    api_check(L, level >= 0);
+
+    // like lua_getinfo, levels past the bottom of the call stack have no frames
+    if (unsigned(level) >= unsigned(L->ci - L->base_ci))
+        return 0;
+
+    int count = 0;
+
+    for (CallInfo* ci = L->ci - level; ci > L->base_ci && count < size; --ci)
+    {
+        lua_TraceFrame& frame = frames[count++];
+        Closure* cl = ci_func(ci);
+
+        if (cl->isC)
+        {
+            frame.proto = NULL;
+            frame.debugname = cl->c.debugname;
+            frame.pc = -1;
+        }
+        else
+        {
+            frame.proto = cl->l.p;
+            frame.debugname = NULL;
+            frame.pc = currentpc(L, ci);
+        }
+    }
+
+    return count;
+}
+
+void lua_gettraceframe(lua_State* L, const lua_TraceFrame* frame, const char* what, lua_Debug* ar)
+{
+    Proto* p = cast_to(Proto*, frame->proto);
+
+    for (; *what; what++)
+    {
+        switch (*what)
+        {
+        case 's':
+        {
+            if (!p)
+            {
+                ar->source = "=[C]";
+                ar->what = "C";
+                ar->linedefined = -1;
+                ar->short_src = "[C]";
+            }
+            else
+            {
+                ar->source = getstr(p->source);
+                ar->what = "Lua";
+                ar->linedefined = p->linedefined;
+                ar->short_src = luaO_chunkid(ar->ssbuf, sizeof(ar->ssbuf), getstr(p->source), p->source->len);
+            }
+            break;
+        }
+        case 'l':
+        {
+            ar->currentline = p ? luaG_getline(p, frame->pc) : -1;
+            break;
+        }
+        case 'n':
+        {
+            ar->name = p ? (p->debugname ? getstr(p->debugname) : NULL) : frame->debugname;
+            break;
+        }
+        default:;
+        }
+    }
+}
+
 const char* lua_debugtrace(lua_State* L)
 {
     static char buf[4096];
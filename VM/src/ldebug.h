@@ -3,6 +3,7 @@
 #pragma once
 
 #include "lstate.h"
+#include "lbytecode.h"
 
 #define pcRel(pc, p) ((pc) ? cast_to(int, (pc) - (p)->code) - 1 : 0)
 
@@ -13,6 +14,19 @@
 #define LUA_MEMERRMSG "not enough memory"
 #define LUA_ERRERRMSG "error in error handling"
 
+// opcode execution counts, collected by the interpreter in single-step mode while enabled with lua_setopcodestats
+struct lua_OpcodeStats
+{
+    uint64_t exec[LOP__COUNT];
+    uint64_t pairs[LOP__COUNT][LOP__COUNT]; // indexed by the previous and the current opcode
+    uint64_t slowpath[LOP__COUNT];
+
+    uint64_t fastcall[256];
+    uint64_t fastcallfallback[256];
+
+    int lastop; // opcode of the last executed instruction, or -1 when no instructions were executed yet
+};
+
 LUAI_FUNC l_noret luaG_typeerrorL(lua_State* L, const TValue* o, const char* opname);
 LUAI_FUNC l_noret luaG_forerrorL(lua_State* L, const TValue* o, const char* what);
 LUAI_FUNC l_noret luaG_concaterror(lua_State* L, StkId p1, StkId p2);
@@ -31,3 +45,5 @@ LUAI_FUNC bool luaG_onbreak(lua_State* L);
 LUAI_FUNC int luaG_getline(Proto* p, int pc);
 
 LUAI_FUNC int luaG_isnative(lua_State* L, int level);
+
+LUAI_FUNC void luaG_freeopcodestats(lua_State* L);
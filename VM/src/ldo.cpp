@@ -8,10 +8,12 @@
 #include "lmem.h"
 #include "lvm.h"
 
-#if LUA_USE_LONGJMP
+#if LUA_USE_LONGJMP || LUA_USE_FASTERRORS
 #include <setjmp.h>
 #include <stdlib.h>
-#else
+#endif
+
+#if !LUA_USE_LONGJMP
 #include <stdexcept>
 #endif
 
@@ -23,14 +25,7 @@
 ** =======================================================
 */
 
-#if LUA_USE_LONGJMP
-struct lua_jmpbuf
-{
-    lua_jmpbuf* volatile prev;
-    volatile int status;
-    jmp_buf buf;
-};
-
+#if LUA_USE_LONGJMP || LUA_USE_FASTERRORS
 // use POSIX versions of setjmp/longjmp if possible: they don't save/restore signal mask and are therefore faster
 #if defined(__linux__) || defined(__APPLE__)
 #define LUAU_SETJMP(buf) _setjmp(buf)
@@ -39,6 +34,15 @@ struct lua_jmpbuf
 #define LUAU_SETJMP(buf) setjmp(buf)
 #define LUAU_LONGJMP(buf, code) longjmp(buf, code)
 #endif
+#endif
+
+#if LUA_USE_LONGJMP
+struct lua_jmpbuf
+{
+    lua_jmpbuf* volatile prev;
+    volatile int status;
+    jmp_buf buf;
+};
 
 int luaD_rawrunprotected(lua_State* L, Pfunc f, void* ud)
 {
@@ -67,7 +71,23 @@ l_noret luaD_throw(lua_State* L, int errcode)
 
     abort();
 }
+
+l_noret luaD_throwvm(lua_State* L, int errcode, bool ctop)
+{
+    luaD_throw(L, errcode);
+}
 #else
+#if LUA_USE_FASTERRORS
+struct lua_jmpbuf
+{
+    lua_jmpbuf* volatile prev;
+    lua_State* L;
+    ptrdiff_t ci; // call frames above this one can be unwound with longjmp when they all belong to Luau functions
+    volatile int status;
+    jmp_buf buf;
+};
+#endif
+
 class lua_exception : public std::exception
 {
 public:
@@ -118,10 +138,24 @@ int luaD_rawrunprotected(lua_State* L, Pfunc f, void* ud)
 {
     int status = 0;
 
+#if LUA_USE_FASTERRORS
+    lua_jmpbuf jb;
+    jb.prev = L->global->errorjmp;
+    jb.L = L;
+    jb.ci = saveci(L, L->ci);
+    jb.status = 0;
+    L->global->errorjmp = &jb;
+
+    if (LUAU_SETJMP(jb.buf) != 0)
+    {
+        L->global->errorjmp = jb.prev;
+        return jb.status;
+    }
+#endif
+
     try
     {
         f(L, ud);
-        return 0;
     }
     catch (lua_exception& e)
     {
@@ -148,6 +182,15 @@ int luaD_rawrunprotected(lua_State* L, Pfunc f, void* ud)
             status = LUA_ERRMEM;
         }
     }
+#if LUA_USE_FASTERRORS
+    catch (...)
+    {
+        L->global->errorjmp = jb.prev;
+        throw;
+    }
+
+    L->global->errorjmp = jb.prev;
+#endif
 
     return status;
 }
@@ -156,6 +199,34 @@ l_noret luaD_throw(lua_State* L, int errcode)
 {
     throw lua_exception(L, errcode);
 }
+
+l_noret luaD_throwvm(lua_State* L, int errcode, bool ctop)
+{
+#if LUA_USE_FASTERRORS
+    // Luau frames and the VM code that runs them don't have destructors, so they can be skipped; C functions can be written in C++, so
+    // the error can only bypass C++ EH if no C function frames are on the stack, except the top one when the caller knows it's safe
+    lua_jmpbuf* jb = L->global->errorjmp;
+    if (jb && jb->L == L)
+    {
+        CallInfo* base = restoreci(L, jb->ci);
+        CallInfo* ci = L->ci;
+
+        if (ctop && ci > base && !isLua(ci))
+            ci--;
+
+        while (ci > base && isLua(ci))
+            ci--;
+
+        if (ci == base)
+        {
+            jb->status = errcode;
+            LUAU_LONGJMP(jb->buf, 1);
+        }
+    }
+#endif
+
+    throw lua_exception(L, errcode);
+}
 #endif
 
 // }======================================================
@@ -203,6 +274,11 @@ void luaD_growstack(lua_State* L, int n)
         luaD_reallocstack(L, 2 * L->stacksize);
     else
         luaD_reallocstack(L, L->stacksize + n);
+
+    lua_StackStats* stats = &L->global->memcatstackstats[L->memcat];
+    stats->stackgrowths++;
+    if (L->stacksize > stats->maxstacksize)
+        stats->maxstacksize = L->stacksize;
 }
 
 CallInfo* luaD_growCI(lua_State* L)
@@ -216,6 +292,11 @@ CallInfo* luaD_growCI(lua_State* L)
     int request = L->size_ci * 2;
     luaD_reallocCI(L, L->size_ci >= LUAI_MAXCALLS ? hardlimit : request < LUAI_MAXCALLS ? request : LUAI_MAXCALLS);
 
+    lua_StackStats* stats = &L->global->memcatstackstats[L->memcat];
+    stats->cigrowths++;
+    if (L->size_ci > stats->maxcisize)
+        stats->maxcisize = L->size_ci;
+
     if (L->size_ci > LUAI_MAXCALLS)
         luaG_runerror(L, "stack overflow");
 
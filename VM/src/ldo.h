@@ -52,4 +52,5 @@ LUAI_FUNC void luaD_growstack(lua_State* L, int n);
 LUAI_FUNC void luaD_checkCstack(lua_State* L);
 
 LUAI_FUNC l_noret luaD_throw(lua_State* L, int errcode);
+LUAI_FUNC l_noret luaD_throwvm(lua_State* L, int errcode, bool ctop);
 LUAI_FUNC int luaD_rawrunprotected(lua_State* L, Pfunc f, void* ud);
@@ -34,8 +34,12 @@ Proto* luaF_newproto(lua_State* L)
 
     f->debugname = NULL;
     f->debuginsn = NULL;
+    f->slotcache = NULL;
+    f->indexchain = NULL;
+    f->hotcount = L->global->hotthreshold;
 
     f->typeinfo = NULL;
+    f->argtypes = NULL;
 
     f->userdata = NULL;
 
@@ -170,6 +174,11 @@ void luaF_freeproto(lua_State* L, Proto* f, lua_Page* page)
     luaM_freearray(L, f->upvalues, f->sizeupvalues, TString*, f->memcat);
     if (f->debuginsn)
         luaM_freearray(L, f->debuginsn, f->sizecode, uint8_t, f->memcat);
+    if (f->slotcache)
+        luaM_freearray(L, f->slotcache, f->sizecode, uint8_t, f->memcat);
+
+    if (f->indexchain)
+        luaM_freearray(L, f->indexchain, f->sizecode, IndexChain, f->memcat);
 
     if (f->execdata)
         L->global->ecb.destroy(L, f);
@@ -177,6 +186,9 @@ void luaF_freeproto(lua_State* L, Proto* f, lua_Page* page)
     if (f->typeinfo)
         luaM_freearray(L, f->typeinfo, f->sizetypeinfo, uint8_t, f->memcat);
 
+    if (f->argtypes)
+        luaM_freearray(L, f->argtypes, f->numparams, uint8_t, f->memcat);
+
     luaM_freegco(L, f, sizeof(Proto), f->memcat, page);
 }
 
@@ -11,11 +11,15 @@
 #include "lmem.h"
 #include "ludata.h"
 #include "lbuffer.h"
+#include "ldebug.h"
+
+#include <atomic>
+#include <thread>
 
 #include <string.h>
 
 /*
- * Luau uses an incremental non-generational non-moving mark&sweep garbage collector.
+ * Luau uses an incremental non-moving mark&sweep garbage collector, with an optional generational mode.
  *
  * The collector runs in three stages: mark, atomic and sweep. Mark and sweep are incremental and try to do a limited amount
  * of work every GC step; atomic is ran once per the GC cycle and is indivisible. In either case, the work happens during GC
@@ -115,6 +119,27 @@
  * as black (doing so would violate the GC invariant), and they are kept in a special global list (global_State::uvhead) which is traversed
  * during atomic phase. This is needed because an open upvalue might point to a stack location in a dead thread that never marked the stack
  * slot - upvalues like this are identified since they don't have `markedopen` bit set during thread traversal and closed in `clearupvals`.
+ *
+ * Generational mode (enabled via LUA_GCGEN) is built on top of the same incremental algorithm using "sticky" mark bits. When a cycle
+ * decides that its survivors should be promoted, sweep doesn't recolor surviving objects, so they stay black (or gray) and are considered to
+ * be old by the next cycle. Since old objects are not white, the next mark (called minor) doesn't traverse them again; instead, it starts from
+ * the objects that were caught by write barriers since the last atomic phase, which serve as the remembered set. To make this work, the
+ * invariant is maintained outside of the mark (see keepinvariant), gray lists are carried over to the next cycle instead of being reset,
+ * and objects that are never black (active threads and weak tables) are kept on the `grayagain` list so that every minor mark revisits them.
+ * Minor sweep only frees young objects, as old objects can't be white. When the heap grows enough since the last major collection, atomic
+ * phase of a minor cycle requests a regular sweep that recolors all objects white, which makes the next cycle perform a full (major) mark.
+ *
+ * Full collections can optionally perform the initial mark and sweep in parallel using worker threads provided by the host (see LUA_GCSETWORKERS).
+ * Since the mutator is not running during a full collection, marking can be split across workers as long as the workers agree on which
+ * worker traverses which object: objects are claimed by atomically clearing their white bits, and each worker keeps its own gray list
+ * which other workers can steal from when they run out of work. To keep the workers from racing on shared data, parallel traversal
+ * doesn't have any side effects beyond the mark bits and gray list links - weak tables and traversed threads are put on per-worker lists
+ * and processed on the calling thread once marking completes, and dead table keys are removed by a later traversal.
+ *
+ * The sweep of a full collection can use the same workers. Freeing an object has side effects outside of its page (string table, memory
+ * accounting, userdata destructors), so workers only scan the pages: they recolor surviving objects and flag pages that contain dead objects.
+ * Since most pages of a large heap only contain surviving objects, the calling thread then needs to visit a small subset of pages to free
+ * the dead objects. Incremental sweep steps always run on the calling thread, as the mutator modifies mark bits via write barriers.
  */
 
 #define GC_SWEEPPAGESTEPCOST 16
@@ -302,6 +327,34 @@ static const char* gettablemode(global_State* g, Table* h)
     return NULL;
 }
 
+// strings are never removed from weak tables, see isobjcleared
+#define isweakref(o) (iscollectable(o) && !ttisstring(o))
+
+/*
+** Weak tables that only hold non-collectable values and strings in their weak parts are traversed as strong tables, which skips the
+** remark and clearing of these tables in the atomic phase. If a collectable value is stored after the traversal, the write barrier puts
+** the table back on the gray list, and the next traversal finds the weak references.
+*/
+static bool hasweakrefs(Table* h, bool weakkey, bool weakvalue)
+{
+    if (weakvalue)
+    {
+        for (int i = 0; i < h->sizearray; ++i)
+            if (isweakref(&h->array[i]))
+                return true;
+    }
+
+    for (int i = 0; i < sizenode(h); ++i)
+    {
+        LuaNode* n = gnode(h, i);
+
+        if (!ttisnil(gval(n)) && ((weakkey && isweakref(gkey(n))) || (weakvalue && isweakref(gval(n)))))
+            return true;
+    }
+
+    return false;
+}
+
 static int traversetable(global_State* g, Table* h)
 {
     int i;
@@ -310,11 +363,13 @@ static int traversetable(global_State* g, Table* h)
     if (h->metatable)
         markobject(g, cast_to(Table*, h->metatable));
 
-    // is there a weak mode?
-    if (const char* modev = gettablemode(g, h))
+    // is there a weak mode? tables with shared parts are traversed as strong, since clearing would affect the other tables
+    if (const char* modev = isshared(h) ? NULL : gettablemode(g, h))
     {
         weakkey = (strchr(modev, 'k') != NULL);
         weakvalue = (strchr(modev, 'v') != NULL);
+        if ((weakkey || weakvalue) && !hasweakrefs(h, weakkey, weakvalue))
+            weakkey = weakvalue = 0;
         if (weakkey || weakvalue)
         {                         // is really weak?
             h->gclist = g->weak;  // must be cleared after GC, ...
@@ -524,238 +579,740 @@ static size_t propagateall(global_State* g)
     return work;
 }
 
-/*
-** The next function tells whether a key or value can be cleared from
-** a weak table. Non-collectable objects are never removed from weak
-** tables. Strings behave as `values', so are never removed too. for
-** other objects: if really collected, cannot keep them.
-*/
-static int isobjcleared(GCObject* o)
+struct GCMarkWorker
 {
-    if (o->gch.tt == LUA_TSTRING)
-    {
-        stringmark(&o->ts); // strings are `values', so are never weak
-        return 0;
-    }
-
-    return iswhite(o);
-}
+    alignas(64) std::atomic<bool> lock;
 
-#define iscleared(o) (iscollectable(o) && isobjcleared(gcvalue(o)))
+    GCObject* gray;    // objects claimed by this worker that need to be traversed
+    GCObject* weak;     // weak tables traversed by this worker
+    GCObject* threads;  // threads traversed by this worker
+    GCObject* deadkeys; // tables traversed by this worker that have empty entries with collectable keys
+};
 
-/*
-** clear collected entries from weaktables
-*/
-static size_t cleartable(lua_State* L, GCObject* l)
+struct GCMarkContext
 {
-    size_t work = 0;
-    while (l)
-    {
-        Table* h = gco2h(l);
-        work += sizeof(Table) + sizeof(TValue) * h->sizearray + sizeof(LuaNode) * sizenode(h);
-
-        int i = h->sizearray;
-        while (i--)
-        {
-            TValue* o = &h->array[i];
-            if (iscleared(o))   // value was collected?
-                setnilvalue(o); // remove value
-        }
-        i = sizenode(h);
-        int activevalues = 0;
-        while (i--)
-        {
-            LuaNode* n = gnode(h, i);
+    global_State* g;
 
-            // non-empty entry?
-            if (!ttisnil(gval(n)))
-            {
-                // can we clear key or value?
-                if (iscleared(gkey(n)) || iscleared(gval(n)))
-                {
-                    setnilvalue(gval(n)); // remove value ...
-                    removeentry(n);       // remove entry from table
-                }
-                else
-                {
-                    activevalues++;
-                }
-            }
-        }
+    GCMarkWorker workers[LUAI_GCMAXWORKERS];
+    int count;
 
-        if (const char* modev = gettablemode(L->global, h))
-        {
-            // are we allowed to shrink this weak table?
-            if (strchr(modev, 's'))
-            {
-                // shrink at 37.5% occupancy
-                if (activevalues < sizenode(h) * 3 / 8)
-                    luaH_resizehash(L, h, activevalues);
-            }
-        }
+    std::atomic<int> idle; // number of workers that ran out of work
+};
 
-        l = h->gclist;
-    }
-    return work;
-}
+#define markedatomic(o) (*reinterpret_cast<std::atomic<uint8_t>*>(&(o)->gch.marked))
 
-static void freeobj(lua_State* L, GCObject* o, lua_Page* page)
+static GCObject** gcolist(GCObject* o)
 {
     switch (o->gch.tt)
     {
-    case LUA_TPROTO:
-        luaF_freeproto(L, gco2p(o), page);
-        break;
-    case LUA_TFUNCTION:
-        luaF_freeclosure(L, gco2cl(o), page);
-        break;
-    case LUA_TUPVAL:
-        luaF_freeupval(L, gco2uv(o), page);
-        break;
     case LUA_TTABLE:
-        luaH_free(L, gco2h(o), page);
-        break;
+        return &gco2h(o)->gclist;
+    case LUA_TFUNCTION:
+        return &gco2cl(o)->gclist;
     case LUA_TTHREAD:
-        LUAU_ASSERT(gco2th(o) != L && gco2th(o) != L->global->mainthread);
-        luaE_freethread(L, gco2th(o), page);
-        break;
-    case LUA_TSTRING:
-        luaS_free(L, gco2ts(o), page);
-        break;
-    case LUA_TUSERDATA:
-        luaU_freeudata(L, gco2u(o), page);
-        break;
-    case LUA_TBUFFER:
-        luaB_freebuffer(L, gco2buf(o), page);
-        break;
+        return &gco2th(o)->gclist;
+    case LUA_TPROTO:
+        return &gco2p(o)->gclist;
     default:
-        LUAU_ASSERT(0);
+        LUAU_ASSERT(!"Unexpected object in gray list");
+        return NULL;
     }
 }
 
-static void shrinkbuffers(lua_State* L)
+static void lockworker(GCMarkWorker* w)
 {
-    global_State* g = L->global;
-    // check size of string hash
-    if (g->strt.nuse < cast_to(uint32_t, g->strt.size / 4) && g->strt.size > LUA_MINSTRTABSIZE * 2)
-        luaS_resize(L, g->strt.size / 2); // table is too big
+    while (w->lock.exchange(true, std::memory_order_acquire))
+        ;
 }
 
-static void shrinkbuffersfull(lua_State* L)
+static void unlockworker(GCMarkWorker* w)
 {
-    global_State* g = L->global;
-    // check size of string hash
-    int hashsize = g->strt.size;
-    while (g->strt.nuse < cast_to(uint32_t, hashsize / 4) && hashsize > LUA_MINSTRTABSIZE * 2)
-        hashsize /= 2;
-    if (hashsize != g->strt.size)
-        luaS_resize(L, hashsize); // table is too big
+    w->lock.store(false, std::memory_order_release);
 }
 
-static bool deletegco(void* context, lua_Page* page, GCObject* gco)
+static void pushworker(GCMarkWorker* w, GCObject* o)
 {
-    lua_State* L = (lua_State*)context;
-    freeobj(L, gco, page);
-    return true;
+    lockworker(w);
+    *gcolist(o) = w->gray;
+    w->gray = o;
+    unlockworker(w);
 }
 
-void luaC_freeall(lua_State* L)
+static GCObject* popworker(GCMarkWorker* w)
 {
-    global_State* g = L->global;
+    lockworker(w);
+    GCObject* o = w->gray;
+    if (o)
+        w->gray = *gcolist(o);
+    unlockworker(w);
+    return o;
+}
 
-    LUAU_ASSERT(L == g->mainthread);
+// take the second half of the victim's gray list
+static bool stealworker(GCMarkWorker* w, GCMarkWorker* victim)
+{
+    lockworker(victim);
 
-    luaM_visitgco(L, L, deletegco);
+    GCObject* mid = victim->gray;
+    for (GCObject* fast = victim->gray; mid && fast;)
+    {
+        fast = *gcolist(fast);
+        if (fast)
+            fast = *gcolist(fast);
 
-    for (int i = 0; i < g->strt.size; i++) // free all string lists
-        LUAU_ASSERT(g->strt.hash[i] == NULL);
+        if (fast)
+            mid = *gcolist(mid);
+    }
 
-    LUAU_ASSERT(L->global->strt.nuse == 0);
-}
+    // leave a single object to its owner
+    GCObject* stolen = mid ? *gcolist(mid) : NULL;
+    if (stolen)
+        *gcolist(mid) = NULL;
 
-static void markmt(global_State* g)
-{
-    int i;
-    for (i = 0; i < LUA_T_COUNT; i++)
-        if (g->mt[i])
-            markobject(g, g->mt[i]);
-}
+    unlockworker(victim);
 
-// mark root set
-static void markroot(lua_State* L)
-{
-    global_State* g = L->global;
-    g->gray = NULL;
-    g->grayagain = NULL;
-    g->weak = NULL;
-    markobject(g, g->mainthread);
-    // make global table be traversed before main stack
-    markobject(g, g->mainthread->gt);
-    markvalue(g, registry(L));
-    markmt(g);
-    g->gcstate = GCSpropagate;
+    if (!stolen)
+        return false;
+
+    GCObject* last = stolen;
+    while (*gcolist(last))
+        last = *gcolist(last);
+
+    lockworker(w);
+    *gcolist(last) = w->gray;
+    w->gray = stolen;
+    unlockworker(w);
+
+    return true;
 }
 
-static size_t remarkupvals(global_State* g)
+// claims a white object for the calling worker by turning it gray; returns false if the object was claimed by another worker
+static bool claimobject(GCObject* o)
 {
-    size_t work = 0;
+    uint8_t marked = markedatomic(o).load(std::memory_order_relaxed);
 
-    for (UpVal* uv = g->uvhead.u.open.next; uv != &g->uvhead; uv = uv->u.open.next)
+    while (marked & WHITEBITS)
     {
-        work += sizeof(UpVal);
+        if (markedatomic(o).compare_exchange_weak(marked, cast_byte(marked & ~WHITEBITS), std::memory_order_relaxed))
+            return true;
+    }
 
-        LUAU_ASSERT(upisopen(uv));
-        LUAU_ASSERT(uv->u.open.next->u.open.prev == uv && uv->u.open.prev->u.open.next == uv);
-        LUAU_ASSERT(!isblack(obj2gco(uv))); // open upvalues are never black
+    return false;
+}
 
-        if (isgray(obj2gco(uv)))
-            markvalue(g, uv->v);
+static void parallelmarkobject(GCMarkWorker* w, GCObject* o);
+
+#define parallelmarkvalue(w, o) \
+    { \
+        checkconsistency(o); \
+        if (iscollectable(o)) \
+            parallelmarkobject(w, gcvalue(o)); \
     }
 
-    return work;
+static void parallelmarkobject(GCMarkWorker* w, GCObject* o)
+{
+    if (!claimobject(o))
+        return;
+
+    switch (o->gch.tt)
+    {
+    case LUA_TSTRING:
+        return;
+    case LUA_TUSERDATA:
+    {
+        Table* mt = gco2u(o)->metatable;
+        markedatomic(o).fetch_or(bitmask(BLACKBIT), std::memory_order_relaxed); // udata are never gray
+        if (mt)
+            parallelmarkobject(w, obj2gco(mt));
+        return;
+    }
+    case LUA_TUPVAL:
+    {
+        UpVal* uv = gco2uv(o);
+        parallelmarkvalue(w, uv->v);
+        // open upvalues are never black
+        if (!upisopen(uv))
+            markedatomic(o).fetch_or(bitmask(BLACKBIT), std::memory_order_relaxed);
+        return;
+    }
+    case LUA_TBUFFER:
+    {
+        markedatomic(o).fetch_or(bitmask(BLACKBIT), std::memory_order_relaxed); // buffers are never gray
+        return;
+    }
+    case LUA_TFUNCTION:
+    case LUA_TTABLE:
+    case LUA_TTHREAD:
+    case LUA_TPROTO:
+    {
+        pushworker(w, o);
+        return;
+    }
+    default:
+        LUAU_ASSERT(0);
+    }
 }
 
-static size_t clearupvals(lua_State* L)
+static size_t paralleltraversetable(GCMarkWorker* w, global_State* g, Table* h)
 {
-    global_State* g = L->global;
+    bool weakkey = false;
+    bool weakvalue = false;
+    if (h->metatable)
+        parallelmarkobject(w, obj2gco(h->metatable));
 
-    size_t work = 0;
+    // gfasttm can update the metatable cache, so we need to look up the mode without it
+    if (h->metatable && !(h->metatable->tmcache & (1u << TM_MODE)))
+    {
+        const TValue* mode = luaH_getstr(h->metatable, g->tmname[TM_MODE]);
 
-    for (UpVal* uv = g->uvhead.u.open.next; uv != &g->uvhead;)
+        if (ttisstring(mode))
+        {
+            weakkey = (strchr(svalue(mode), 'k') != NULL);
+            weakvalue = (strchr(svalue(mode), 'v') != NULL);
+        }
+    }
+
+    if ((weakkey || weakvalue) && !hasweakrefs(h, weakkey, weakvalue))
+        weakkey = weakvalue = false;
+
+    if (weakkey || weakvalue)
     {
-        work += sizeof(UpVal);
+        markedatomic(obj2gco(h)).fetch_and(cast_byte(~bitmask(BLACKBIT)), std::memory_order_relaxed); // keep it gray
+        h->gclist = w->weak;
+        w->weak = obj2gco(h);
+    }
 
-        LUAU_ASSERT(upisopen(uv));
-        LUAU_ASSERT(uv->u.open.next->u.open.prev == uv && uv->u.open.prev->u.open.next == uv);
-        LUAU_ASSERT(!isblack(obj2gco(uv))); // open upvalues are never black
-        LUAU_ASSERT(iswhite(obj2gco(uv)) || !iscollectable(uv->v) || !iswhite(gcvalue(uv->v)));
+    if (!weakvalue)
+    {
+        int i = h->sizearray;
+        while (i--)
+            parallelmarkvalue(w, &h->array[i]);
+    }
 
-        if (uv->markedopen)
+    if (!weakkey || !weakvalue)
+    {
+        bool deadkeys = false;
+
+        int i = sizenode(h);
+        while (i--)
         {
-            // upvalue is still open (belongs to alive thread)
-            LUAU_ASSERT(isgray(obj2gco(uv)));
-            uv->markedopen = 0; // for next cycle
-            uv = uv->u.open.next;
+            LuaNode* n = gnode(h, i);
+
+            // empty entries are left as is, since other workers might be reading the contents of this table if it's a metatable
+            if (!ttisnil(gval(n)))
+            {
+                if (!weakkey)
+                    parallelmarkvalue(w, gkey(n));
+                if (!weakvalue)
+                    parallelmarkvalue(w, gval(n));
+            }
+            else if (iscollectable(gkey(n)))
+            {
+                deadkeys = true;
+            }
         }
-        else
+
+        // keys of empty entries aren't marked, so they are removed after the parallel mark (weak tables are traversed again in atomic)
+        if (deadkeys && !weakkey && !weakvalue)
         {
-            // upvalue is either dead, or alive but the thread is dead; unlink and close
-            UpVal* next = uv->u.open.next;
-            luaF_closeupval(L, uv, /* dead= */ iswhite(obj2gco(uv)));
-            uv = next;
+            h->gclist = w->deadkeys;
+            w->deadkeys = obj2gco(h);
         }
     }
 
-    return work;
+    return sizeof(Table) + sizeof(TValue) * h->sizearray + sizeof(LuaNode) * sizenode(h);
 }
 
-static size_t atomic(lua_State* L)
+static size_t paralleltraverseproto(GCMarkWorker* w, Proto* f)
+{
+    if (f->source)
+        parallelmarkobject(w, obj2gco(f->source));
+    if (f->debugname)
+        parallelmarkobject(w, obj2gco(f->debugname));
+    for (int i = 0; i < f->sizek; i++)
+        parallelmarkvalue(w, &f->k[i]);
+    for (int i = 0; i < f->sizeupvalues; i++)
+        if (f->upvalues[i])
+            parallelmarkobject(w, obj2gco(f->upvalues[i]));
+    for (int i = 0; i < f->sizep; i++)
+        if (f->p[i])
+            parallelmarkobject(w, obj2gco(f->p[i]));
+    for (int i = 0; i < f->sizelocvars; i++)
+        if (f->locvars[i].varname)
+            parallelmarkobject(w, obj2gco(f->locvars[i].varname));
+
+    return sizeof(Proto) + sizeof(Instruction) * f->sizecode + sizeof(Proto*) * f->sizep + sizeof(TValue) * f->sizek + f->sizelineinfo +
+           sizeof(LocVar) * f->sizelocvars + sizeof(TString*) * f->sizeupvalues + f->sizetypeinfo;
+}
+
+static size_t paralleltraverseclosure(GCMarkWorker* w, Closure* cl)
+{
+    parallelmarkobject(w, obj2gco(cl->env));
+
+    if (cl->isC)
+    {
+        for (int i = 0; i < cl->nupvalues; i++)
+            parallelmarkvalue(w, &cl->c.upvals[i]);
+
+        return sizeCclosure(cl->nupvalues);
+    }
+    else
+    {
+        parallelmarkobject(w, obj2gco(cl->l.p));
+        for (int i = 0; i < cl->nupvalues; i++)
+            parallelmarkvalue(w, &cl->l.uprefs[i]);
+
+        return sizeLclosure(cl->nupvalues);
+    }
+}
+
+static size_t paralleltraversethread(GCMarkWorker* w, lua_State* th)
+{
+    parallelmarkobject(w, obj2gco(th->gt));
+    if (th->namecall)
+        parallelmarkobject(w, obj2gco(th->namecall));
+    for (StkId o = th->stack; o < th->top; o++)
+        parallelmarkvalue(w, o);
+    for (UpVal* uv = th->openupval; uv; uv = uv->u.open.threadnext)
+    {
+        LUAU_ASSERT(upisopen(uv));
+        uv->markedopen = 1;
+        parallelmarkobject(w, obj2gco(uv));
+    }
+
+    // active threads are rescanned later, so only inactive threads can have their stacks cleared
+    if (!(th->isactive || th == th->global->mainthread))
+        clearstack(th);
+
+    // stack shrinking needs to allocate memory so it's performed by the calling thread
+    th->gclist = w->threads;
+    w->threads = obj2gco(th);
+
+    return sizeof(lua_State) + sizeof(TValue) * th->stacksize + sizeof(CallInfo) * th->size_ci;
+}
+
+static size_t parallelpropagatemark(GCMarkWorker* w, global_State* g, GCObject* o)
+{
+    markedatomic(o).fetch_or(bitmask(BLACKBIT), std::memory_order_relaxed);
+
+    switch (o->gch.tt)
+    {
+    case LUA_TTABLE:
+        return paralleltraversetable(w, g, gco2h(o));
+    case LUA_TFUNCTION:
+        return paralleltraverseclosure(w, gco2cl(o));
+    case LUA_TTHREAD:
+        return paralleltraversethread(w, gco2th(o));
+    case LUA_TPROTO:
+        return paralleltraverseproto(w, gco2p(o));
+    default:
+        LUAU_ASSERT(0);
+        return 0;
+    }
+}
+
+static bool stealwork(GCMarkContext* ctx, int index)
+{
+    for (int i = 1; i < ctx->count; ++i)
+    {
+        GCMarkWorker* victim = &ctx->workers[(index + i) % ctx->count];
+
+        if (stealworker(&ctx->workers[index], victim))
+            return true;
+    }
+
+    return false;
+}
+
+static bool haswork(GCMarkContext* ctx)
+{
+    for (int i = 0; i < ctx->count; ++i)
+    {
+        GCMarkWorker* w = &ctx->workers[i];
+
+        lockworker(w);
+        bool result = w->gray != NULL;
+        unlockworker(w);
+
+        if (result)
+            return true;
+    }
+
+    return false;
+}
+
+static void parallelmarkjob(void* context, int index)
+{
+    GCMarkContext* ctx = (GCMarkContext*)context;
+    GCMarkWorker* w = &ctx->workers[index];
+
+    for (;;)
+    {
+        while (GCObject* o = popworker(w))
+            parallelpropagatemark(w, ctx->g, o);
+
+        if (stealwork(ctx, index))
+            continue;
+
+        // we are out of work; marking completes once all workers are out of work
+        ctx->idle.fetch_add(1);
+
+        for (;;)
+        {
+            if (ctx->idle.load() == ctx->count)
+                return;
+
+            if (haswork(ctx))
+            {
+                ctx->idle.fetch_sub(1);
+                break;
+            }
+
+            // pool threads can outnumber free cores, so idle workers give up their time slice to the workers that still have work
+            std::this_thread::yield();
+        }
+    }
+}
+
+// performs the initial mark using worker threads provided by the host
+static void propagateparallel(lua_State* L)
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(g->gcstate == GCSpropagate);
+
+    GCMarkContext ctx;
+    ctx.g = g;
+    ctx.count = g->gcworkers < LUAI_GCMAXWORKERS ? g->gcworkers : LUAI_GCMAXWORKERS;
+    ctx.idle.store(0);
+
+    for (int i = 0; i < ctx.count; ++i)
+    {
+        GCMarkWorker* w = &ctx.workers[i];
+        w->lock.store(false);
+        w->gray = NULL;
+        w->weak = NULL;
+        w->threads = NULL;
+        w->deadkeys = NULL;
+    }
+
+    // distribute the roots between workers
+    for (int i = 0; g->gray; ++i)
+    {
+        GCObject* o = g->gray;
+        g->gray = *gcolist(o);
+
+        GCMarkWorker* w = &ctx.workers[i % ctx.count];
+        *gcolist(o) = w->gray;
+        w->gray = o;
+    }
+
+    g->cb.gcparallel(L, ctx.count, parallelmarkjob, &ctx);
+
+    // post-process objects that were traversed with deferred side effects
+    for (int i = 0; i < ctx.count; ++i)
+    {
+        GCMarkWorker* w = &ctx.workers[i];
+        LUAU_ASSERT(!w->gray);
+
+        for (GCObject* o = w->weak; o;)
+        {
+            Table* h = gco2h(o);
+            GCObject* next = h->gclist;
+            h->gclist = g->weak;
+            g->weak = o;
+            o = next;
+        }
+
+        for (GCObject* o = w->threads; o;)
+        {
+            lua_State* th = gco2th(o);
+            GCObject* next = th->gclist;
+
+            // active threads will need to be rescanned later to mark new stack writes so we mark them gray again
+            if (th->isactive || th == g->mainthread)
+            {
+                th->gclist = g->grayagain;
+                g->grayagain = o;
+
+                black2gray(o);
+            }
+
+            shrinkstack(th);
+
+            o = next;
+        }
+
+        for (GCObject* o = w->deadkeys; o;)
+        {
+            Table* h = gco2h(o);
+            GCObject* next = h->gclist;
+
+            for (int i = 0; i < sizenode(h); ++i)
+            {
+                LuaNode* n = gnode(h, i);
+
+                if (ttisnil(gval(n)))
+                    removeentry(n);
+            }
+
+            o = next;
+        }
+    }
+}
+
+/*
+** The next function tells whether a key or value can be cleared from
+** a weak table. Non-collectable objects are never removed from weak
+** tables. Strings behave as `values', so are never removed too. for
+** other objects: if really collected, cannot keep them.
+*/
+static int isobjcleared(GCObject* o)
+{
+    if (o->gch.tt == LUA_TSTRING)
+    {
+        stringmark(&o->ts); // strings are `values', so are never weak
+        return 0;
+    }
+
+    return iswhite(o);
+}
+
+#define iscleared(o) (iscollectable(o) && isobjcleared(gcvalue(o)))
+
+/*
+** clear collected entries from weaktables
+*/
+static size_t cleartable(lua_State* L, GCObject* l)
+{
+    size_t work = 0;
+    while (l)
+    {
+        Table* h = gco2h(l);
+        work += sizeof(Table) + sizeof(TValue) * h->sizearray + sizeof(LuaNode) * sizenode(h);
+
+        int i = h->sizearray;
+        while (i--)
+        {
+            TValue* o = &h->array[i];
+            if (iscleared(o))   // value was collected?
+                setnilvalue(o); // remove value
+        }
+        i = sizenode(h);
+        int activevalues = 0;
+        while (i--)
+        {
+            LuaNode* n = gnode(h, i);
+
+            // non-empty entry?
+            if (!ttisnil(gval(n)))
+            {
+                // can we clear key or value?
+                if (iscleared(gkey(n)) || iscleared(gval(n)))
+                {
+                    setnilvalue(gval(n)); // remove value ...
+                    removeentry(n);       // remove entry from table
+                }
+                else
+                {
+                    activevalues++;
+                }
+            }
+        }
+
+        if (const char* modev = gettablemode(L->global, h))
+        {
+            // are we allowed to shrink this weak table?
+            if (strchr(modev, 's'))
+            {
+                // shrink at 37.5% occupancy
+                if (activevalues < sizenode(h) * 3 / 8)
+                    luaH_resizehash(L, h, activevalues);
+            }
+        }
+
+        l = h->gclist;
+    }
+    return work;
+}
+
+static void freeobj(lua_State* L, GCObject* o, lua_Page* page)
+{
+    switch (o->gch.tt)
+    {
+    case LUA_TPROTO:
+        luaF_freeproto(L, gco2p(o), page);
+        break;
+    case LUA_TFUNCTION:
+        luaF_freeclosure(L, gco2cl(o), page);
+        break;
+    case LUA_TUPVAL:
+        luaF_freeupval(L, gco2uv(o), page);
+        break;
+    case LUA_TTABLE:
+        luaH_free(L, gco2h(o), page);
+        break;
+    case LUA_TTHREAD:
+        LUAU_ASSERT(gco2th(o) != L && gco2th(o) != L->global->mainthread);
+        luaE_freethread(L, gco2th(o), page);
+        break;
+    case LUA_TSTRING:
+        luaS_free(L, gco2ts(o), page);
+        break;
+    case LUA_TUSERDATA:
+        luaU_freeudata(L, gco2u(o), page);
+        break;
+    case LUA_TBUFFER:
+        luaB_freebuffer(L, gco2buf(o), page);
+        break;
+    default:
+        LUAU_ASSERT(0);
+    }
+}
+
+static void shrinkbuffers(lua_State* L)
+{
+    global_State* g = L->global;
+    // check size of string hash
+    if (g->strt.nuse < cast_to(uint32_t, g->strt.size / 4) && g->strt.size > LUA_MINSTRTABSIZE * 2)
+        luaS_resize(L, g->strt.size / 2); // table is too big
+}
+
+static void shrinkbuffersfull(lua_State* L)
+{
+    global_State* g = L->global;
+    // check size of string hash
+    int hashsize = g->strt.size;
+    while (g->strt.nuse < cast_to(uint32_t, hashsize / 4) && hashsize > LUA_MINSTRTABSIZE * 2)
+        hashsize /= 2;
+    if (hashsize != g->strt.size)
+        luaS_resize(L, hashsize); // table is too big
+}
+
+static bool deletegco(void* context, lua_Page* page, GCObject* gco)
+{
+    lua_State* L = (lua_State*)context;
+    freeobj(L, gco, page);
+    return true;
+}
+
+void luaC_freeall(lua_State* L)
+{
+    global_State* g = L->global;
+
+    LUAU_ASSERT(L == g->mainthread);
+
+    luaM_freealloccache(L, L);
+
+    luaM_visitgco(L, L, deletegco);
+
+    // blocks cached by the threads are returned to pages once all objects are deleted
+    luaM_releasealloccache(L);
+
+    for (int i = 0; i < g->strt.size; i++) // free all string lists
+        LUAU_ASSERT(g->strt.hash[i] == NULL);
+
+    LUAU_ASSERT(L->global->strt.nuse == 0);
+}
+
+static void markmt(global_State* g)
+{
+    int i;
+    for (i = 0; i < LUA_T_COUNT; i++)
+        if (g->mt[i])
+            markobject(g, g->mt[i]);
+}
+
+// mark root set
+static void markroot(lua_State* L)
+{
+    global_State* g = L->global;
+    // in a minor collection, gray lists carry the objects modified since the last atomic phase
+    if (!g->gcsticky)
+    {
+        g->gray = NULL;
+        g->grayagain = NULL;
+        g->weak = NULL;
+    }
+    markobject(g, g->mainthread);
+    // make global table be traversed before main stack
+    markobject(g, g->mainthread->gt);
+    markvalue(g, registry(L));
+    for (int i = 1; i < g->reftop; i++)
+        markvalue(g, &g->refs[i]);
+    markmt(g);
+    g->gcstate = GCSpropagate;
+}
+
+static size_t remarkupvals(global_State* g)
+{
+    size_t work = 0;
+
+    for (UpVal* uv = g->uvhead.u.open.next; uv != &g->uvhead; uv = uv->u.open.next)
+    {
+        work += sizeof(UpVal);
+
+        LUAU_ASSERT(upisopen(uv));
+        LUAU_ASSERT(uv->u.open.next->u.open.prev == uv && uv->u.open.prev->u.open.next == uv);
+        LUAU_ASSERT(!isblack(obj2gco(uv))); // open upvalues are never black
+
+        if (isgray(obj2gco(uv)))
+            markvalue(g, uv->v);
+    }
+
+    return work;
+}
+
+static size_t clearupvals(lua_State* L, bool minor)
+{
+    global_State* g = L->global;
+
+    size_t work = 0;
+
+    for (UpVal* uv = g->uvhead.u.open.next; uv != &g->uvhead;)
+    {
+        work += sizeof(UpVal);
+
+        LUAU_ASSERT(upisopen(uv));
+        LUAU_ASSERT(uv->u.open.next->u.open.prev == uv && uv->u.open.prev->u.open.next == uv);
+        LUAU_ASSERT(!isblack(obj2gco(uv))); // open upvalues are never black
+        LUAU_ASSERT(iswhite(obj2gco(uv)) || !iscollectable(uv->v) || !iswhite(gcvalue(uv->v)));
+
+        if (uv->markedopen)
+        {
+            // upvalue is still open (belongs to alive thread)
+            LUAU_ASSERT(isgray(obj2gco(uv)));
+            uv->markedopen = 0; // for next cycle
+            uv = uv->u.open.next;
+        }
+        else if (minor && !iswhite(obj2gco(uv)))
+        {
+            // old upvalue belongs to an old thread that might not have been traversed by minor mark; old threads can't die in a minor cycle
+            uv = uv->u.open.next;
+        }
+        else
+        {
+            // upvalue is either dead, or alive but the thread is dead; unlink and close
+            UpVal* next = uv->u.open.next;
+            luaF_closeupval(L, uv, /* dead= */ iswhite(obj2gco(uv)));
+            uv = next;
+        }
+    }
+
+    return work;
+}
+
+static size_t atomic(lua_State* L)
 {
     global_State* g = L->global;
     LUAU_ASSERT(g->gcstate == GCSatomic);
 
     size_t work = 0;
 
+    // in generational mode, survivors of a major mark are promoted to the old generation; after a minor mark they are only promoted if the
+    // heap didn't grow too much since the last major collection, otherwise the objects are made white and the next cycle performs a major mark
+    bool minor = g->gcsticky;
+    bool sticky = g->gcgen && (!minor || g->gcstats.endtotalsizebytes <= g->gcstats.genbasesizebytes / 100 * (100 + g->gcgenmajormul));
+
 #ifdef LUAI_GCMETRICS
     double currts = lua_clock();
 #endif
@@ -792,6 +1349,20 @@ static size_t atomic(lua_State* L)
 
     // remove collected objects from weak tables
     work += cleartable(L, g->weak);
+
+    // weak tables are never black, so when survivors keep their color we need to revisit the tables in the next cycle
+    if (sticky)
+    {
+        for (GCObject* o = g->weak; o;)
+        {
+            Table* h = gco2h(o);
+            GCObject* next = h->gclist;
+            h->gclist = g->grayagain;
+            g->grayagain = o;
+            o = next;
+        }
+    }
+
     g->weak = NULL;
 
 #ifdef LUAI_GCMETRICS
@@ -799,7 +1370,7 @@ static size_t atomic(lua_State* L)
 #endif
 
     // close orphaned live upvalues of dead threads and clear dead upvalues
-    work += clearupvals(L);
+    work += clearupvals(L, minor);
 
 #ifdef LUAI_GCMETRICS
     g->gcmetrics.currcycle.atomictimeupval += recordGcDeltaTime(currts);
@@ -810,6 +1381,9 @@ static size_t atomic(lua_State* L)
     g->sweepgcopage = g->allgcopages;
     g->gcstate = GCSsweep;
 
+    g->gcsticky = sticky;
+    g->gcstats.genminorcycles = minor ? g->gcstats.genminorcycles + 1 : 0;
+
     return work;
 }
 
@@ -830,21 +1404,52 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
     LUAU_ASSERT(testbit(deadmask, FIXEDBIT)); // make sure we never sweep fixed objects
 
     int newwhite = luaC_white(g);
+    bool sticky = g->gcsticky;
+    int tableshrink = g->gctableshrink;
+
+    // dead userdata with a batch destructor are released together; they are still counted as busy blocks until then
+    Udata* batch[UDATA_BATCHSIZE];
+    int batchcount = 0;
 
     for (char* pos = start; pos != end; pos += blockSize)
     {
         GCObject* gco = (GCObject*)pos;
 
-        // skip memory blocks that are already freed
-        if (gco->gch.tt == LUA_TNIL)
+        // skip memory blocks that are already freed, as well as frozen objects which keep their marks
+        if (gco->gch.tt == LUA_TNIL || isfrozen(gco))
             continue;
 
         // is the object alive?
         if ((gco->gch.marked ^ WHITEBITS) & deadmask)
         {
             LUAU_ASSERT(!isdead(g, gco));
-            // make it white (for next cycle)
-            gco->gch.marked = cast_byte((gco->gch.marked & maskmarks) | newwhite);
+            // make it white (for next cycle), unless it's promoted to the old generation
+            if (!sticky)
+                gco->gch.marked = cast_byte((gco->gch.marked & maskmarks) | newwhite);
+
+            // release memory of tables that grew large and were mostly cleared since
+            // tables created since the previous sweep are left alone: native code keeps the array size of a new table across GC checks
+            if (gco->gch.tt == LUA_TTABLE)
+            {
+                if (tableshrink && testbit(gco->gch.marked, SWEPTBIT))
+                    luaH_shrink(L, gco2h(gco), tableshrink);
+
+                l_setbit(gco->gch.marked, SWEPTBIT);
+            }
+        }
+        else if (gco->gch.tt == LUA_TUSERDATA && gco2u(gco)->tag < LUA_UTAG_LIMIT && g->udatabatchgc[gco2u(gco)->tag])
+        {
+            LUAU_ASSERT(isdead(g, gco));
+
+            // the current object is still busy, so the page can't be freed by this
+            if (batchcount == UDATA_BATCHSIZE || (batchcount > 0 && batch[0]->tag != gco2u(gco)->tag))
+            {
+                luaU_freeudatabatch(L, batch, batchcount, page);
+                busyBlocks -= batchcount;
+                batchcount = 0;
+            }
+
+            batch[batchcount++] = gco2u(gco);
         }
         else
         {
@@ -857,9 +1462,136 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
         }
     }
 
+    // the page can be removed when the batch is released
+    if (batchcount > 0)
+        luaU_freeudatabatch(L, batch, batchcount, page);
+
     return int(end - start) / blockSize;
 }
 
+struct GCSweepContext
+{
+    global_State* g;
+
+    lua_Page** pages;
+    uint8_t* dead; // set for pages that have dead objects or tables that might need to be shrunk
+    int count;
+
+    std::atomic<int> next; // next page to be scanned
+};
+
+// number of pages that a sweep worker claims at once
+#define GC_SWEEPPAGEBATCH 16
+
+// scans pages to find dead objects and recolors surviving objects; this doesn't free anything so pages can be processed concurrently
+static void parallelsweepjob(void* context, int index)
+{
+    GCSweepContext* ctx = (GCSweepContext*)context;
+    global_State* g = ctx->g;
+
+    int deadmask = otherwhite(g);
+    int newwhite = luaC_white(g);
+    bool sticky = g->gcsticky;
+    bool tableshrink = g->gctableshrink != 0;
+
+    for (;;)
+    {
+        int first = ctx->next.fetch_add(GC_SWEEPPAGEBATCH);
+        if (first >= ctx->count)
+            return;
+
+        int last = first + GC_SWEEPPAGEBATCH < ctx->count ? first + GC_SWEEPPAGEBATCH : ctx->count;
+
+        for (int i = first; i < last; ++i)
+        {
+            char* start;
+            char* end;
+            int busyBlocks;
+            int blockSize;
+            luaM_getpagewalkinfo(ctx->pages[i], &start, &end, &busyBlocks, &blockSize);
+
+            for (char* pos = start; pos != end; pos += blockSize)
+            {
+                GCObject* gco = (GCObject*)pos;
+
+                // skip memory blocks that are already freed, as well as frozen objects which keep their marks
+                if (gco->gch.tt == LUA_TNIL || isfrozen(gco))
+                    continue;
+
+                // is the object alive?
+                if ((gco->gch.marked ^ WHITEBITS) & deadmask)
+                {
+                    if (!sticky)
+                        gco->gch.marked = cast_byte((gco->gch.marked & maskmarks) | newwhite);
+
+                    // shrinking allocates memory, so it's deferred to the calling thread, which also marks the table as swept
+                    if (gco->gch.tt == LUA_TTABLE)
+                    {
+                        if (tableshrink)
+                            ctx->dead[i] = 1;
+                        else
+                            l_setbit(gco->gch.marked, SWEPTBIT);
+                    }
+                }
+                else
+                {
+                    ctx->dead[i] = 1;
+                }
+            }
+        }
+    }
+}
+
+// performs the sweep using worker threads provided by the host
+// workers scan and recolor all pages, and only the pages that have dead objects are swept again on the calling thread to free them
+static void sweepparallel(lua_State* L)
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(g->gcstate == GCSsweep && g->sweepgcopage == g->allgcopages);
+
+    int count = 0;
+    for (lua_Page* page = g->allgcopages; page; page = luaM_getnextpage(page))
+        count++;
+
+    if (count == 0)
+        return;
+
+    // the page list is temporary and isn't accounted for; if it can't be allocated, the sweep proceeds on the calling thread
+    size_t size = count * (sizeof(lua_Page*) + sizeof(uint8_t));
+    lua_Page** pages = (lua_Page**)(*g->frealloc)(g->ud, NULL, 0, size);
+    if (!pages)
+        return;
+
+    GCSweepContext ctx;
+    ctx.g = g;
+    ctx.pages = pages;
+    ctx.dead = (uint8_t*)(pages + count);
+    ctx.count = count;
+    ctx.next.store(0);
+
+    int index = 0;
+    for (lua_Page* page = g->allgcopages; page; page = luaM_getnextpage(page))
+    {
+        pages[index] = page;
+        ctx.dead[index] = 0;
+        index++;
+    }
+
+    int workers = g->gcworkers < LUAI_GCMAXWORKERS ? g->gcworkers : LUAI_GCMAXWORKERS;
+
+    g->cb.gcparallel(L, workers, parallelsweepjob, &ctx);
+
+    // free dead objects and shrink tables; surviving objects have already been recolored, so sweeping them again is harmless
+    for (int i = 0; i < count; ++i)
+        if (ctx.dead[i])
+            sweepgcopage(L, pages[i]);
+
+    (*g->frealloc)(g->ud, pages, size, 0);
+
+    // sweep is complete, but the final sweep step still needs to run
+    g->sweepgcopage = NULL;
+}
+
 static size_t gcstep(lua_State* L, size_t limit)
 {
     size_t cost = 0;
@@ -943,10 +1675,18 @@ static size_t gcstep(lua_State* L, size_t limit)
         {
             // don't forget to visit main thread, it's the only object not allocated in GCO pages
             LUAU_ASSERT(!isdead(g, obj2gco(g->mainthread)));
-            makewhite(g, obj2gco(g->mainthread)); // make it white (for next cycle)
+            if (!g->gcsticky)
+                makewhite(g, obj2gco(g->mainthread)); // make it white (for next cycle)
+
+            // old generation size is measured after the sweep that follows a major mark
+            if (g->gcsticky && g->gcstats.genminorcycles == 0)
+                g->gcstats.genbasesizebytes = g->totalbytes;
 
             shrinkbuffers(L);
 
+            // pages are no longer being swept, so blocks cached by freed threads can be returned to them
+            luaM_releasealloccache(L);
+
             g->gcstate = GCSpause; // end collection
         }
         break;
@@ -1011,6 +1751,89 @@ static size_t getheaptrigger(global_State* g, size_t heapgoal)
     return heaptrigger < int64_t(g->totalbytes) ? g->totalbytes : (heaptrigger > int64_t(heapgoal) ? heapgoal : size_t(heaptrigger));
 }
 
+// when the frame budget is set, assists only perform as much work as the remaining frame time allows based on the observed work rate
+static int getframesteplimit(global_State* g, int lim)
+{
+    // the budget can't be respected once the heap grows past the goal, as the heap would grow without bounds
+    if (g->totalbytes > g->gcstats.heapgoalsizebytes)
+        return lim;
+
+    double remaining = g->gcframebudget - g->gcframetime * 1e6;
+
+    if (remaining <= 0.0)
+        return 0;
+
+    // until the work rate is known, steps use the default size
+    if (g->gcstats.workrate > 0.0 && remaining * g->gcstats.workrate < lim)
+        return int(remaining * g->gcstats.workrate) + 1;
+
+    return lim;
+}
+
+static void recordworkrate(global_State* g, size_t work, double seconds)
+{
+    // short steps are dominated by timer resolution and fixed overhead
+    if (work == 0 || seconds < 1e-6)
+        return;
+
+    double rate = double(work) / (seconds * 1e6);
+
+    g->gcstats.workrate = g->gcstats.workrate > 0.0 ? g->gcstats.workrate * 0.75 + rate * 0.25 : rate;
+}
+
+static void startcyclemetrics(global_State* g, double timestamp)
+{
+    lua_GCCycleMetrics& cycle = g->gcstats.metrics.currcycle;
+
+    cycle = lua_GCCycleMetrics();
+    cycle.starttimestamp = timestamp;
+    cycle.starttotalsizebytes = g->totalbytes;
+}
+
+static void recordstepmetrics(global_State* g, int gcstate, double seconds, bool assist)
+{
+    lua_GCMetrics& metrics = g->gcstats.metrics;
+    lua_GCCycleMetrics& cycle = metrics.currcycle;
+
+    if (gcstate == GCSatomic)
+        cycle.atomictime += seconds;
+    else if (gcstate == GCSsweep)
+        cycle.sweeptime += seconds;
+    else
+        cycle.marktime += seconds;
+
+    cycle.steps++;
+    cycle.maxsteptime = seconds > cycle.maxsteptime ? seconds : cycle.maxsteptime;
+
+    metrics.steps++;
+    metrics.steptime += seconds;
+    metrics.maxsteptime = seconds > metrics.maxsteptime ? seconds : metrics.maxsteptime;
+
+    if (assist)
+    {
+        cycle.assisttime += seconds;
+        metrics.assisttime += seconds;
+    }
+}
+
+static void finishcyclemetrics(lua_State* L, double timestamp)
+{
+    global_State* g = L->global;
+    lua_GCMetrics& metrics = g->gcstats.metrics;
+    lua_GCCycleMetrics& cycle = metrics.currcycle;
+
+    cycle.endtimestamp = timestamp;
+    cycle.atomicstarttotalsizebytes = g->gcstats.atomicstarttotalsizebytes;
+    cycle.endtotalsizebytes = g->totalbytes;
+    cycle.heapgoalsizebytes = g->gcstats.heapgoalsizebytes;
+
+    metrics.lastcycle = cycle;
+    metrics.completedcycles++;
+
+    if (g->cb.gccycle)
+        g->cb.gccycle(L);
+}
+
 size_t luaC_step(lua_State* L, bool assist)
 {
     global_State* g = L->global;
@@ -1019,35 +1842,79 @@ size_t luaC_step(lua_State* L, bool assist)
     LUAU_ASSERT(g->totalbytes >= g->GCthreshold);
     size_t debt = g->totalbytes - g->GCthreshold;
 
+    if (assist && g->gcframebudget > 0)
+    {
+        lim = getframesteplimit(g, lim);
+
+        // out of time in the current frame; the work is postponed to the next frame or to the idle time
+        if (lim == 0)
+        {
+            // the allocations until the next assist are owed in advance, so that explicit steps can pay for them
+            g->gcdeferred += debt + g->gcstepsize;
+            g->GCthreshold = g->totalbytes + g->gcstepsize;
+            return 0;
+        }
+    }
+
     GC_INTERRUPT(0);
 
     // at the start of the new cycle
     if (g->gcstate == GCSpause)
+    {
         g->gcstats.starttimestamp = lua_clock();
+        startcyclemetrics(g, g->gcstats.starttimestamp);
+    }
 
 #ifdef LUAI_GCMETRICS
     if (g->gcstate == GCSpause)
         startGcCycleMetrics(g);
+#endif
 
+    // steps are always timed for lua_gcmetrics
     double lasttimestamp = lua_clock();
-#endif
 
     int lastgcstate = g->gcstate;
 
     size_t work = gcstep(L, lim);
 
+    double seconds = lua_clock() - lasttimestamp;
+
 #ifdef LUAI_GCMETRICS
-    recordGcStateStep(g, lastgcstate, lua_clock() - lasttimestamp, assist, work);
+    recordGcStateStep(g, lastgcstate, seconds, assist, work);
 #endif
 
+    recordstepmetrics(g, lastgcstate, seconds, assist);
+    recordworkrate(g, work, seconds);
+
+    if (assist && g->gcframebudget > 0)
+        g->gcframetime += seconds;
+
     size_t actualstepsize = work * 100 / g->gcstepmul;
 
+    // work outside of assists pays for the work that assists postponed
+    if (!assist)
+        g->gcdeferred = g->gcdeferred > actualstepsize ? g->gcdeferred - actualstepsize : 0;
+
     // at the end of the last cycle
     if (g->gcstate == GCSpause)
     {
-        // at the end of a collection cycle, set goal based on gcgoal setting
-        size_t heapgoal = (g->totalbytes / 100) * g->gcgoal;
-        size_t heaptrigger = getheaptrigger(g, heapgoal);
+        g->gcdeferred = 0;
+
+        size_t heapgoal;
+        size_t heaptrigger;
+
+        if (g->gcsticky)
+        {
+            // minor cycles only need to traverse young objects, so we start them once the heap grows by a fraction of the old generation
+            heapgoal = g->totalbytes + (g->totalbytes / 100) * g->gcgenminormul;
+            heaptrigger = heapgoal;
+        }
+        else
+        {
+            // at the end of a collection cycle, set goal based on gcgoal setting
+            heapgoal = (g->totalbytes / 100) * g->gcgoal;
+            heaptrigger = getheaptrigger(g, heapgoal);
+        }
 
         g->GCthreshold = heaptrigger;
 
@@ -1055,6 +1922,8 @@ size_t luaC_step(lua_State* L, bool assist)
         g->gcstats.endtimestamp = lua_clock();
         g->gcstats.endtotalsizebytes = g->totalbytes;
 
+        finishcyclemetrics(L, g->gcstats.endtimestamp);
+
 #ifdef LUAI_GCMETRICS
         finishGcCycleMetrics(g);
 #endif
@@ -1073,6 +1942,50 @@ size_t luaC_step(lua_State* L, bool assist)
     return actualstepsize;
 }
 
+double luaC_frame(lua_State* L)
+{
+    global_State* g = L->global;
+
+    double spent = g->gcframetime;
+    g->gcframetime = 0.0;
+
+    return spent;
+}
+
+size_t luaC_debt(global_State* g)
+{
+    // stopped collector doesn't owe any work
+    if (g->GCthreshold == SIZE_MAX)
+        return 0;
+
+    return (g->totalbytes > g->GCthreshold ? g->totalbytes - g->GCthreshold : 0) + g->gcdeferred;
+}
+
+bool luaC_idle(lua_State* L, double budget)
+{
+    global_State* g = L->global;
+
+    // there is no work to do until the next cycle is triggered
+    if (g->gcstate == GCSpause && g->totalbytes < g->GCthreshold)
+        return false;
+
+    double start = lua_clock();
+
+    do
+    {
+        // perform the work scheduled for later allocations now
+        if (g->GCthreshold > g->totalbytes)
+            g->GCthreshold = g->totalbytes;
+
+        luaC_step(L, false);
+
+        if (g->gcstate == GCSpause)
+            return true;
+    } while (lua_clock() - start < budget);
+
+    return false;
+}
+
 void luaC_fullgc(lua_State* L)
 {
     global_State* g = L->global;
@@ -1092,6 +2005,8 @@ void luaC_fullgc(lua_State* L)
         g->weak = NULL;
         g->gcstate = GCSsweep;
     }
+    // full collection needs to mark old objects as well
+    g->gcsticky = 0;
     LUAU_ASSERT(g->gcstate == GCSpause || g->gcstate == GCSsweep);
     // finish any pending sweep phase
     while (g->gcstate != GCSpause)
@@ -1112,8 +2027,30 @@ void luaC_fullgc(lua_State* L)
     startGcCycleMetrics(g);
 #endif
 
+    // a partially completed cycle is abandoned, so the full collection starts a new one
+    double starttimestamp = lua_clock();
+
+    startcyclemetrics(g, starttimestamp);
+
     // run a full collection cycle
     markroot(L);
+
+    // initial mark and sweep can be performed in parallel when the host provides worker threads
+    bool parallel = g->cb.gcparallel && g->gcworkers > 1;
+
+    if (parallel)
+        propagateparallel(L);
+
+    while (g->gcstate != GCSsweep)
+    {
+        gcstep(L, SIZE_MAX);
+    }
+
+    double sweepstarttimestamp = lua_clock();
+
+    if (parallel)
+        sweepparallel(L);
+
     while (g->gcstate != GCSpause)
     {
         gcstep(L, SIZE_MAX);
@@ -1134,18 +2071,434 @@ void luaC_fullgc(lua_State* L)
     if (g->GCthreshold < g->totalbytes)
         g->GCthreshold = g->totalbytes;
 
+    g->gcdeferred = 0;
+
     g->gcstats.heapgoalsizebytes = heapgoalsizebytes;
 
+    double endtimestamp = lua_clock();
+
+    // the whole collection is recorded as a single step, with phase times split at the start of the atomic and sweep stages
+    lua_GCCycleMetrics& cycle = g->gcstats.metrics.currcycle;
+
+    recordstepmetrics(g, GCSpause, endtimestamp - starttimestamp, false);
+    cycle.marktime = g->gcstats.atomicstarttimestamp - starttimestamp;
+    cycle.atomictime = sweepstarttimestamp - g->gcstats.atomicstarttimestamp;
+    cycle.sweeptime = endtimestamp - sweepstarttimestamp;
+
+    finishcyclemetrics(L, endtimestamp);
+
 #ifdef LUAI_GCMETRICS
     finishGcCycleMetrics(g);
 #endif
 }
 
+/*
+ * Compaction moves tables out of sparsely occupied pages so that the pages can be freed. It runs right after a full collection, so
+ * there are no dead objects left in the heap and all objects are white. Each moved table is copied to a new block in a page that isn't
+ * being evacuated and the old block keeps a forwarding pointer (in gclist) until all references in the heap are updated; after that,
+ * old blocks are freed, which frees pages that only contained tables. Tables that use moved tables as keys are rehashed.
+ */
+struct GCCompactContext
+{
+    lua_Page** pages;
+    int count;
+};
+
+#define isforwarded(o) testbit((o)->gch.marked, FORWARDBIT)
+#define forwardtable(h) gco2h(gco2h(h)->gclist)
+
+static bool fixupvalue(TValue* v)
+{
+    if (ttistable(v) && isforwarded(gcvalue(v)))
+    {
+        v->value.gc = obj2gco(forwardtable(gcvalue(v)));
+        return true;
+    }
+
+    return false;
+}
+
+static void fixuptable(Table** h)
+{
+    if (*h && isforwarded(obj2gco(*h)))
+        *h = forwardtable(obj2gco(*h));
+}
+
+static void fixupvalues(TValue* data, int size)
+{
+    for (int i = 0; i < size; ++i)
+        fixupvalue(&data[i]);
+}
+
+static bool hasforwardedkeys(Table* h)
+{
+    for (int i = 0; i < sizenode(h); ++i)
+    {
+        LuaNode* n = gnode(h, i);
+
+        if (n->key.tt == LUA_TTABLE && isforwarded(n->key.value.gc))
+            return true;
+    }
+
+    return false;
+}
+
+static bool fixupgco(void* context, lua_Page* page, GCObject* gco)
+{
+    lua_State* L = (lua_State*)context;
+
+    // old copies of moved tables are freed later
+    if (isforwarded(gco))
+        return false;
+
+    switch (gco->gch.tt)
+    {
+    case LUA_TTABLE:
+    {
+        Table* h = gco2h(gco);
+
+        // the hash part is rehashed in place below, which other tables that share it wouldn't see
+        if (isshared(h) && hasforwardedkeys(h))
+            luaH_unshare(L, h);
+
+        fixuptable(&h->metatable);
+        fixupvalues(h->array, h->sizearray);
+
+        bool rehash = false;
+
+        for (int i = 0; i < sizenode(h); ++i)
+        {
+            LuaNode* n = gnode(h, i);
+
+            if (n->key.tt == LUA_TTABLE && isforwarded(n->key.value.gc))
+            {
+                n->key.value.gc = obj2gco(forwardtable(n->key.value.gc));
+                rehash = true;
+            }
+
+            fixupvalue(gval(n));
+        }
+
+        // hash of the moved keys changed, so the nodes need to be reinserted
+        if (rehash)
+            luaH_resizehash(L, h, sizenode(h));
+        break;
+    }
+    case LUA_TFUNCTION:
+    {
+        Closure* cl = gco2cl(gco);
+
+        fixuptable(&cl->env);
+
+        if (cl->isC)
+            fixupvalues(cl->c.upvals, cl->nupvalues);
+        else
+            fixupvalues(cl->l.uprefs, cl->nupvalues);
+        break;
+    }
+    case LUA_TTHREAD:
+    {
+        lua_State* th = gco2th(gco);
+
+        fixuptable(&th->gt);
+        fixupvalues(th->stack, int(th->top - th->stack));
+        break;
+    }
+    case LUA_TUSERDATA:
+        fixuptable(&gco2u(gco)->metatable);
+        break;
+
+    case LUA_TPROTO:
+    {
+        Proto* p = gco2p(gco);
+
+        fixupvalues(p->k, p->sizek);
+        break;
+    }
+    case LUA_TUPVAL:
+    {
+        UpVal* uv = gco2uv(gco);
+
+        // open upvalues point to thread stacks which are updated separately
+        if (!upisopen(uv))
+            fixupvalue(uv->v);
+        break;
+    }
+    default:
+        break;
+    }
+
+    return false;
+}
+
+static bool evacuategco(void* context, lua_Page* page, GCObject* gco)
+{
+    lua_State* L = (lua_State*)context;
+
+    if (gco->gch.tt != LUA_TTABLE || isfixed(gco))
+        return false;
+
+    Table* h = gco2h(gco);
+
+    // new block is taken from a page that isn't being evacuated
+    Table* nh = luaM_newgco(L, Table, sizeof(Table), h->memcat);
+    memcpy(nh, h, sizeof(Table));
+
+    l_setbit(h->marked, FORWARDBIT);
+    h->gclist = obj2gco(nh);
+
+    return false;
+}
+
+static bool freeforwarded(void* context, lua_Page* page, GCObject* gco)
+{
+    lua_State* L = (lua_State*)context;
+
+    if (!isforwarded(gco))
+        return false;
+
+    // node and array parts are owned by the new copy now
+    luaM_freegco(L, gco2h(gco), sizeof(Table), gco->gch.memcat, page);
+    return true;
+}
+
+static void evacuatepages(lua_State* L, void* ud)
+{
+    GCCompactContext* ctx = (GCCompactContext*)ud;
+
+    for (int i = 0; i < ctx->count; ++i)
+        luaM_visitpage(ctx->pages[i], L, evacuategco);
+}
+
+int luaC_compact(lua_State* L, int occupancy)
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(!g->heapsnapshot);
+
+    // in generational mode, survivors keep their marks and gray lists point at old objects after a collection, so the collection that
+    // precedes evacuation is a non-generational one; the next generational cycle performs a major mark
+    uint8_t gcgen = g->gcgen;
+    g->gcgen = 0;
+    luaC_fullgc(L);
+    g->gcgen = gcgen;
+    LUAU_ASSERT(g->gcstate == GCSpause && !g->gcsticky);
+
+    // cached blocks of the current thread would be used for new copies, but they might be located in the pages we evacuate
+    luaM_freealloccache(L, L);
+    luaM_releasealloccache(L);
+
+    int total = 0;
+    int count = 0;
+
+    for (lua_Page* page = g->allgcopages; page; page = luaM_getnextpage(page))
+    {
+        int pageBlocks, busyBlocks, blockSize, pageSize;
+        luaM_getpageinfo(page, &pageBlocks, &busyBlocks, &blockSize, &pageSize);
+
+        if (blockSize == sizeof(Table) && pageBlocks > 1 && busyBlocks * 100 <= pageBlocks * occupancy)
+            count++;
+
+        total++;
+    }
+
+    if (count == 0)
+        return 0;
+
+    // the page list is temporary and isn't accounted for
+    size_t size = count * sizeof(lua_Page*);
+    lua_Page** pages = (lua_Page**)(*g->frealloc)(g->ud, NULL, 0, size);
+    if (!pages)
+        return 0;
+
+    GCCompactContext ctx = {pages, 0};
+
+    for (lua_Page* page = g->allgcopages; page; page = luaM_getnextpage(page))
+    {
+        int pageBlocks, busyBlocks, blockSize, pageSize;
+        luaM_getpageinfo(page, &pageBlocks, &busyBlocks, &blockSize, &pageSize);
+
+        if (blockSize == sizeof(Table) && pageBlocks > 1 && busyBlocks * 100 <= pageBlocks * occupancy)
+            pages[ctx.count++] = page;
+    }
+
+    LUAU_ASSERT(ctx.count == count);
+
+    // new copies can't be allocated in the pages we're trying to free
+    for (int i = 0; i < count; ++i)
+        luaM_detachgcopage(L, pages[i]);
+
+    // moved tables temporarily use twice the memory, which shouldn't count towards memory category limits
+    lua_MemcatLimits* memcatlimits = g->memcatlimits;
+    g->memcatlimits = NULL;
+
+    // if we run out of memory, the tables that were moved so far are still valid
+    luaD_rawrunprotected(L, evacuatepages, &ctx);
+
+    g->memcatlimits = memcatlimits;
+
+    // update all references to the moved tables
+    fixupgco(L, NULL, obj2gco(g->mainthread));
+    luaM_visitgco(L, L, fixupgco);
+
+    fixupvalue(&g->registry);
+    fixupvalue(&g->pseudotemp);
+
+    // slot 0 of the reference slab is never used or initialized
+    if (g->refs)
+        fixupvalues(g->refs + 1, g->reftop - 1);
+
+    for (int i = 0; i < LUA_T_COUNT; i++)
+        fixuptable(&g->mt[i]);
+
+    for (int i = 0; i < LUA_LUTAG_LIMIT; i++)
+        fixuptable(&g->udatamt[i]);
+
+    // free the old copies; pages that become empty are freed as well
+    for (int i = 0; i < count; ++i)
+    {
+        luaM_attachgcopage(L, pages[i]);
+        luaM_visitpage(pages[i], L, freeforwarded);
+    }
+
+    (*g->frealloc)(g->ud, pages, size, 0);
+
+    for (lua_Page* page = g->allgcopages; page; page = luaM_getnextpage(page))
+        total--;
+
+    return total;
+}
+
+// adds the objects reachable from the value to the 'visited' set; raises an error if any of them can't be frozen
+static void freezecollect(lua_State* L, Table* visited, const TValue* v, int depth)
+{
+    if (!iscollectable(v) || isfrozen(gcvalue(v)))
+        return;
+
+    if (!ttisstring(v) && !ttistable(v))
+        luaG_runerror(L, "cannot freeze a %s value", luaT_objtypename(L, v));
+
+    TValue* seen = luaH_set(L, visited, v);
+    if (!ttisnil(seen))
+        return;
+
+    setbvalue(seen, true);
+
+    if (ttisstring(v))
+        return;
+
+    Table* h = hvalue(v);
+
+    if (!isreadonly(h))
+        luaG_runerror(L, "cannot freeze a table that isn't readonly");
+
+    if (depth >= LUAI_MAXCCALLS)
+        luaG_runerror(L, "table is nested too deeply to freeze");
+
+    if (h->metatable)
+    {
+        TValue mt;
+        sethvalue(L, &mt, h->metatable);
+        freezecollect(L, visited, &mt, depth + 1);
+    }
+
+    for (int i = 0; i < h->sizearray; ++i)
+        freezecollect(L, visited, &h->array[i], depth + 1);
+
+    for (int i = 0; i < sizenode(h); ++i)
+    {
+        LuaNode* n = gnode(h, i);
+
+        if (!ttisnil(gval(n)))
+        {
+            TValue key;
+            getnodekey(L, &key, n);
+
+            freezecollect(L, visited, &key, depth + 1);
+            freezecollect(L, visited, gval(n), depth + 1);
+        }
+    }
+}
+
+// Freezes the table together with all tables and strings reachable from it; the tables have to be readonly and can't reference other
+// kinds of objects. Since readonly tables can't be modified, frozen objects can only reference other frozen objects, and the collector
+// no longer needs to traverse or sweep them; they live until the state is closed.
+void luaC_freeze(lua_State* L, Table* t)
+{
+    // all objects are checked before any of them are frozen, so that an error leaves the heap unchanged
+    Table* visited = luaH_new(L, 0, 0);
+
+    TValue root;
+    sethvalue(L, &root, t);
+    freezecollect(L, visited, &root, 0);
+
+    // frozen tables can be read by several threads at once when they are published, so their arrays are trimmed to end with a non-nil
+    // element and the cached boundary is reset; luaH_getn and the native length fast paths never update such tables
+    for (int i = 0; i < sizenode(visited); ++i)
+    {
+        LuaNode* n = gnode(visited, i);
+
+        if (ttisnil(gval(n)) || gkey(n)->tt != LUA_TTABLE)
+            continue;
+
+        Table* h = gco2h(gkey(n)->value.gc);
+
+        if (h->sizearray > 0 && ttisnil(&h->array[h->sizearray - 1]))
+        {
+            int size = h->sizearray;
+            while (size > 0 && ttisnil(&h->array[size - 1]))
+                size--;
+
+            if (isshared(h))
+                luaH_unshare(L, h);
+
+            luaH_resizearray(L, h, size);
+        }
+
+        if (h->aboundary < 0)
+            h->aboundary = 0;
+    }
+
+    for (int i = 0; i < sizenode(visited); ++i)
+    {
+        LuaNode* n = gnode(visited, i);
+
+        if (ttisnil(gval(n)))
+            continue;
+
+        GCObject* o = gkey(n)->value.gc;
+
+        // white tables are made black; gray ones are in one of the gray lists and will be made black when the collector traverses them
+        if (iswhite(o))
+        {
+            resetbits(o->gch.marked, WHITEBITS);
+
+            if (o->gch.tt == LUA_TTABLE)
+                gray2black(o);
+        }
+
+        // frozen tables aren't traversed, so keys of empty entries that aren't frozen have to be removed now
+        if (o->gch.tt == LUA_TTABLE)
+        {
+            Table* h = gco2h(o);
+
+            for (int j = 0; j < sizenode(h); ++j)
+            {
+                LuaNode* hn = gnode(h, j);
+
+                if (ttisnil(gval(hn)))
+                    removeentry(hn);
+            }
+        }
+
+        setbits(o->gch.marked, bitmask(FIXEDBIT) | bitmask(FROZENBIT));
+    }
+}
+
 void luaC_barrierf(lua_State* L, GCObject* o, GCObject* v)
 {
     global_State* g = L->global;
     LUAU_ASSERT(isblack(o) && iswhite(v) && !isdead(g, v) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
     // must keep invariant?
     if (keepinvariant(g))
         reallymarkobject(g, v); // restore invariant
@@ -1153,6 +2506,15 @@ void luaC_barrierf(lua_State* L, GCObject* o, GCObject* v)
         makewhite(g, o);        // mark as white just to avoid other barriers
 }
 
+void luaC_barrierroot(lua_State* L, GCObject* v)
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(iswhite(v) && !isdead(g, v));
+    // roots are only marked when the cycle starts, so objects stored into roots after that have to be marked to keep the invariant
+    if (keepinvariant(g))
+        reallymarkobject(g, v);
+}
+
 void luaC_barriertable(lua_State* L, Table* t, GCObject* v)
 {
     global_State* g = L->global;
@@ -1167,7 +2529,7 @@ void luaC_barriertable(lua_State* L, Table* t, GCObject* v)
     }
 
     LUAU_ASSERT(isblack(o) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
     black2gray(o); // make table gray (again)
     t->gclist = g->grayagain;
     g->grayagain = o;
@@ -1177,7 +2539,7 @@ void luaC_barrierback(lua_State* L, GCObject* o, GCObject** gclist)
 {
     global_State* g = L->global;
     LUAU_ASSERT(isblack(o) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
 
     black2gray(o); // make object gray (again)
     *gclist = g->grayagain;
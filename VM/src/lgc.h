@@ -13,6 +13,22 @@
 #define LUAI_GCSTEPMUL 200 // GC runs 'twice the speed' of memory allocation
 #define LUAI_GCSTEPSIZE 1  // GC runs every KB of memory allocation
 
+/*
+** Default settings for generational mode (see LUA_GCGEN)
+*/
+#define LUAI_GCGENMINORMUL 20  // minor collection starts after the heap grows by 20% of the old generation size
+#define LUAI_GCGENMAJORMUL 100 // major collection happens when the old generation doubles since the last major collection
+
+/*
+** Default occupancy threshold for compaction (see LUA_GCCOMPACT)
+*/
+#define LUAI_GCCOMPACTOCCUPANCY 25 // pages where at most 25% of blocks are in use are evacuated
+
+/*
+** Maximum number of workers that can be used for parallel mark and sweep (see LUA_GCSETWORKERS)
+*/
+#define LUAI_GCMAXWORKERS 16
+
 /*
 ** Possible states of the Garbage Collector
 */
@@ -27,8 +43,11 @@
 ** is that a black object can never point to a white one. This invariant
 ** is not being enforced during a sweep phase, and is restored when sweep
 ** ends.
+** In generational mode, objects that survive a cycle keep their color and
+** are considered 'old' by the next (minor) cycle; the invariant must then
+** be maintained during sweep and pause as well (see g->gcsticky).
 */
-#define keepinvariant(g) ((g)->gcstate == GCSpropagate || (g)->gcstate == GCSpropagateagain || (g)->gcstate == GCSatomic)
+#define keepinvariant(g) ((g)->gcstate == GCSpropagate || (g)->gcstate == GCSpropagateagain || (g)->gcstate == GCSatomic || (g)->gcsticky)
 
 /*
 ** some useful bit tricks
@@ -51,18 +70,25 @@
 ** bit 1 - object is white (type 1)
 ** bit 2 - object is black
 ** bit 3 - object is fixed (should not be collected)
+** bit 4 - object was moved by compaction and its references need to be updated (see luaC_compact)
+** bit 5 - object is frozen: it is never white, so the collector doesn't traverse or sweep it (see luaC_freeze)
+** bit 6 - table survived a sweep, so it can be shrunk by later ones (see LUA_GCSETTABLESHRINK)
 */
 
 #define WHITE0BIT 0
 #define WHITE1BIT 1
 #define BLACKBIT 2
 #define FIXEDBIT 3
+#define FORWARDBIT 4
+#define FROZENBIT 5
+#define SWEPTBIT 6
 #define WHITEBITS bit2mask(WHITE0BIT, WHITE1BIT)
 
 #define iswhite(x) test2bits((x)->gch.marked, WHITE0BIT, WHITE1BIT)
 #define isblack(x) testbit((x)->gch.marked, BLACKBIT)
 #define isgray(x) (!testbits((x)->gch.marked, WHITEBITS | bitmask(BLACKBIT)))
 #define isfixed(x) testbit((x)->gch.marked, FIXEDBIT)
+#define isfrozen(x) testbit((x)->gch.marked, FROZENBIT)
 
 #define otherwhite(g) (g->currentwhite ^ WHITEBITS)
 #define isdead(g, v) (((v)->gch.marked & (WHITEBITS | bitmask(FIXEDBIT))) == (otherwhite(g) & WHITEBITS))
@@ -112,6 +138,12 @@
             luaC_barrierf(L, obj2gco(p), obj2gco(o)); \
     }
 
+#define luaC_barrierref(L, v) \
+    { \
+        if (iscollectable(v) && iswhite(gcvalue(v))) \
+            luaC_barrierroot(L, gcvalue(v)); \
+    }
+
 #define luaC_threadbarrier(L) \
     { \
         if (isblack(obj2gco(L))) \
@@ -128,15 +160,24 @@
 LUAI_FUNC void luaC_freeall(lua_State* L);
 LUAI_FUNC size_t luaC_step(lua_State* L, bool assist);
 LUAI_FUNC void luaC_fullgc(lua_State* L);
+LUAI_FUNC int luaC_compact(lua_State* L, int occupancy);
+LUAI_FUNC double luaC_frame(lua_State* L);
+LUAI_FUNC size_t luaC_debt(global_State* g);
+LUAI_FUNC bool luaC_idle(lua_State* L, double budget);
 LUAI_FUNC void luaC_initobj(lua_State* L, GCObject* o, uint8_t tt);
 LUAI_FUNC void luaC_upvalclosed(lua_State* L, UpVal* uv);
 LUAI_FUNC void luaC_barrierf(lua_State* L, GCObject* o, GCObject* v);
 LUAI_FUNC void luaC_barriertable(lua_State* L, Table* t, GCObject* v);
+LUAI_FUNC void luaC_barrierroot(lua_State* L, GCObject* v);
 LUAI_FUNC void luaC_barrierback(lua_State* L, GCObject* o, GCObject** gclist);
+LUAI_FUNC void luaC_freeze(lua_State* L, Table* t);
 LUAI_FUNC void luaC_validate(lua_State* L);
 LUAI_FUNC void luaC_dump(lua_State* L, void* file, const char* (*categoryName)(lua_State* L, uint8_t memcat));
 LUAI_FUNC void luaC_enumheap(lua_State* L, void* context,
     void (*node)(void* context, void* ptr, uint8_t tt, uint8_t memcat, size_t size, const char* name),
     void (*edge)(void* context, void* from, void* to, const char* name));
+LUAI_FUNC struct lua_HeapSnapshot* luaC_heapsnapshotbegin(lua_State* L, void* context, void (*write)(void* context, const void* data, size_t size));
+LUAI_FUNC bool luaC_heapsnapshotstep(lua_State* L, struct lua_HeapSnapshot* snapshot, double budget);
+LUAI_FUNC void luaC_heapsnapshotend(lua_State* L, struct lua_HeapSnapshot* snapshot);
 LUAI_FUNC int64_t luaC_allocationrate(lua_State* L);
 LUAI_FUNC const char* luaC_statename(int state);
@@ -62,6 +62,15 @@ static void validatetable(global_State* g, Table* h)
             validateref(g, obj2gco(h), &k);
             validateref(g, obj2gco(h), gval(n));
         }
+        else if (g->gcstate == GCSpause && !g->gcsticky && iscollectable(gkey(n)) && ttype(gkey(n)) != LUA_TDEADKEY)
+        {
+            // a full cycle marks keys of empty entries as dead unless they are still alive
+            TValue k = {};
+            k.tt = gkey(n)->tt;
+            k.value = gkey(n)->value;
+
+            validateref(g, obj2gco(h), &k);
+        }
     }
 }
 
@@ -229,6 +238,9 @@ void luaC_validate(lua_State* L)
     LUAU_ASSERT(!isdead(g, obj2gco(g->mainthread)));
     checkliveness(g, &g->registry);
 
+    for (int i = 1; i < g->reftop; ++i)
+        checkliveness(g, &g->refs[i]);
+
     for (int i = 0; i < LUA_T_COUNT; ++i)
         if (g->mt[i])
             LUAU_ASSERT(!isdead(g, obj2gco(g->mt[i])));
@@ -595,6 +607,15 @@ void luaC_dump(lua_State* L, void* file, const char* (*categoryName)(lua_State*
     fprintf(f, ",\"registry\":");
     dumpref(f, gcvalue(&g->registry));
 
+    for (int i = 1; i < g->reftop; ++i)
+    {
+        if (iscollectable(&g->refs[i]))
+        {
+            fprintf(f, ",\"ref%d\":", i);
+            dumpref(f, gcvalue(&g->refs[i]));
+        }
+    }
+
     fprintf(f, "},\"stats\":{\n");
 
     fprintf(f, "\"size\":%d,\n", int(g->totalbytes));
@@ -903,3 +924,283 @@ void luaC_enumheap(lua_State* L, void* context, void (*node)(void* context, void
 
     luaM_visitgco(L, &ctx, enumgco);
 }
+
+/*
+ * Heap snapshots are produced incrementally: every step visits as many GCO pages as it can within its time budget, so objects are
+ * reported as they exist at the time their page is visited. Pages allocated after the snapshot begins are not visited, and pages
+ * freed between steps are skipped (see global_State::heapsnapshotpage).
+ *
+ * The snapshot is a compact binary stream that starts with the "LHSN" magic followed by a version byte and a sequence of records; each
+ * record starts with a tag byte. Unsigned integers are stored as LEB128 varints, signed integers use zigzag encoding. Pointers are
+ * delta-encoded: node pointer is relative to the previous node, edge source is relative to the previous node and edge target is
+ * relative to the source. Names are stored as varint N: 0 is no name, odd N refers to a previously defined name in slot N/2, other even N
+ * are followed by a slot byte and N/2-1 bytes of name data that also define the contents of the slot.
+ *
+ * HS_NODE: pointer, type byte, memory category byte, size, name
+ * HS_EDGE: source, target, name
+ * HS_ROOT: pointer, name
+ * HS_CATEGORY: memory category byte, size in bytes
+ * HS_END: total heap size in bytes
+ */
+#define HS_VERSION 2
+#define HS_BUFFERSIZE 4096
+#define HS_NAMESLOTS 256
+#define HS_NAMECACHED 32
+
+enum HeapSnapshotRecord
+{
+    HS_END,
+    HS_NODE,
+    HS_EDGE,
+    HS_ROOT,
+    HS_CATEGORY,
+};
+
+struct HeapSnapshotName
+{
+    uint8_t len;
+    char data[HS_NAMECACHED];
+};
+
+struct lua_HeapSnapshot
+{
+    void* context;
+    void (*write)(void* context, const void* data, size_t size);
+
+    uintptr_t lastnode;
+    bool done;
+
+    HeapSnapshotName names[HS_NAMESLOTS]; // names that can be referred to by slot
+
+    size_t pos;
+    uint8_t buffer[HS_BUFFERSIZE];
+};
+
+static void hsflush(lua_HeapSnapshot* hs)
+{
+    if (hs->pos)
+        hs->write(hs->context, hs->buffer, hs->pos);
+
+    hs->pos = 0;
+}
+
+static void hsbytes(lua_HeapSnapshot* hs, const void* data, size_t size)
+{
+    while (size)
+    {
+        if (hs->pos == HS_BUFFERSIZE)
+            hsflush(hs);
+
+        size_t chunk = HS_BUFFERSIZE - hs->pos < size ? HS_BUFFERSIZE - hs->pos : size;
+        memcpy(hs->buffer + hs->pos, data, chunk);
+
+        hs->pos += chunk;
+        data = (const char*)data + chunk;
+        size -= chunk;
+    }
+}
+
+static void hsbyte(lua_HeapSnapshot* hs, uint8_t value)
+{
+    if (hs->pos == HS_BUFFERSIZE)
+        hsflush(hs);
+
+    hs->buffer[hs->pos++] = value;
+}
+
+static void hsvarint(lua_HeapSnapshot* hs, uint64_t value)
+{
+    do
+    {
+        uint8_t byte = value & 127;
+        value >>= 7;
+        hsbyte(hs, value ? byte | 128 : byte);
+    } while (value);
+}
+
+static void hsdelta(lua_HeapSnapshot* hs, uintptr_t value, uintptr_t base)
+{
+    int64_t delta = int64_t(value - base);
+    hsvarint(hs, (uint64_t(delta) << 1) ^ uint64_t(delta >> 63));
+}
+
+static void hsname(lua_HeapSnapshot* hs, const char* name)
+{
+    if (!name)
+    {
+        hsvarint(hs, 0);
+        return;
+    }
+
+    size_t len = strlen(name);
+
+    // names are compared by contents because some names are formatted into temporary buffers
+    unsigned int h = unsigned(len);
+    for (size_t i = 0; i < len; ++i)
+        h = h * 31 + uint8_t(name[i]);
+
+    uint8_t slot = uint8_t(h % HS_NAMESLOTS);
+    HeapSnapshotName& entry = hs->names[slot];
+
+    if (len < HS_NAMECACHED && entry.len == len && memcmp(entry.data, name, len) == 0)
+    {
+        hsvarint(hs, (uint64_t(slot) << 1) | 1);
+        return;
+    }
+
+    hsvarint(hs, uint64_t(len + 1) << 1);
+    hsbyte(hs, slot);
+    hsbytes(hs, name, len);
+
+    // long names are not cached since they are usually unique; slot contents are still updated to keep the decoder in sync
+    if (len < HS_NAMECACHED)
+    {
+        entry.len = uint8_t(len);
+        memcpy(entry.data, name, len);
+    }
+    else
+    {
+        entry.len = 0xff;
+    }
+}
+
+static void hsnode(void* context, void* ptr, uint8_t tt, uint8_t memcat, size_t size, const char* name)
+{
+    lua_HeapSnapshot* hs = (lua_HeapSnapshot*)context;
+
+    hsbyte(hs, HS_NODE);
+    hsdelta(hs, uintptr_t(ptr), hs->lastnode);
+    hsbyte(hs, tt);
+    hsbyte(hs, memcat);
+    hsvarint(hs, size);
+    hsname(hs, name);
+
+    hs->lastnode = uintptr_t(ptr);
+}
+
+static void hsedge(void* context, void* from, void* to, const char* name)
+{
+    lua_HeapSnapshot* hs = (lua_HeapSnapshot*)context;
+
+    hsbyte(hs, HS_EDGE);
+    hsdelta(hs, uintptr_t(from), hs->lastnode);
+    hsdelta(hs, uintptr_t(to), uintptr_t(from));
+    hsname(hs, name);
+}
+
+static void hsroot(lua_HeapSnapshot* hs, GCObject* gco, const char* name)
+{
+    hsbyte(hs, HS_ROOT);
+    hsdelta(hs, uintptr_t(enumtopointer(gco)), 0);
+    hsname(hs, name);
+}
+
+static EnumContext hsenumcontext(lua_State* L, lua_HeapSnapshot* hs)
+{
+    EnumContext ctx;
+    ctx.L = L;
+    ctx.context = hs;
+    ctx.node = hsnode;
+    ctx.edge = hsedge;
+    return ctx;
+}
+
+lua_HeapSnapshot* luaC_heapsnapshotbegin(lua_State* L, void* context, void (*write)(void* context, const void* data, size_t size))
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(!g->heapsnapshot); // only one snapshot can be in progress at a time
+
+    lua_HeapSnapshot* hs = (lua_HeapSnapshot*)luaM_new_(L, sizeof(lua_HeapSnapshot), 0);
+
+    hs->context = context;
+    hs->write = write;
+    hs->lastnode = 0;
+    hs->done = false;
+    hs->pos = 0;
+
+    for (int i = 0; i < HS_NAMESLOTS; ++i)
+        hs->names[i].len = 0xff;
+
+    g->heapsnapshot = hs;
+    g->heapsnapshotpage = g->allgcopages;
+
+    hsbytes(hs, "LHSN", 4);
+    hsbyte(hs, HS_VERSION);
+
+    // main thread is not allocated in GCO pages
+    EnumContext ctx = hsenumcontext(L, hs);
+    enumobj(&ctx, obj2gco(g->mainthread));
+
+    return hs;
+}
+
+bool luaC_heapsnapshotstep(lua_State* L, lua_HeapSnapshot* hs, double budget)
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(g->heapsnapshot == hs);
+
+    if (hs->done)
+        return true;
+
+    EnumContext ctx = hsenumcontext(L, hs);
+
+    double start = lua_clock();
+
+    while (lua_Page* page = g->heapsnapshotpage)
+    {
+        g->heapsnapshotpage = luaM_getnextpage(page);
+
+        luaM_visitpage(page, &ctx, enumgco);
+
+        if (lua_clock() - start >= budget)
+            break;
+    }
+
+    if (g->heapsnapshotpage)
+    {
+        // push visited data to the writer so that memory use stays bounded
+        hsflush(hs);
+        return false;
+    }
+
+    hsroot(hs, obj2gco(g->mainthread), "mainthread");
+    hsroot(hs, gcvalue(&g->registry), "registry");
+
+    for (int i = 1; i < g->reftop; ++i)
+    {
+        if (iscollectable(&g->refs[i]))
+        {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "ref%d", i);
+            hsroot(hs, gcvalue(&g->refs[i]), buf);
+        }
+    }
+
+    for (int i = 0; i < LUA_MEMORY_CATEGORIES; i++)
+    {
+        if (size_t bytes = g->memcatbytes[i])
+        {
+            hsbyte(hs, HS_CATEGORY);
+            hsbyte(hs, uint8_t(i));
+            hsvarint(hs, bytes);
+        }
+    }
+
+    hsbyte(hs, HS_END);
+    hsvarint(hs, g->totalbytes);
+    hsflush(hs);
+
+    hs->done = true;
+    return true;
+}
+
+void luaC_heapsnapshotend(lua_State* L, lua_HeapSnapshot* hs)
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(g->heapsnapshot == hs);
+
+    g->heapsnapshot = NULL;
+    g->heapsnapshotpage = NULL;
+
+    luaM_free_(L, hs, sizeof(lua_HeapSnapshot), 0);
+}
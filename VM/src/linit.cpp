@@ -3,6 +3,11 @@
 #include "lualib.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 static const luaL_Reg lualibs[] = {
     {"", luaopen_base},
@@ -15,6 +20,7 @@ static const luaL_Reg lualibs[] = {
     {LUA_UTF8LIBNAME, luaopen_utf8},
     {LUA_BITLIBNAME, luaopen_bit32},
     {LUA_BUFFERLIBNAME, luaopen_buffer},
+    {LUA_VECLIBNAME, luaopen_vector},
     {NULL, NULL},
 };
 
@@ -75,10 +81,81 @@ void luaL_sandboxthread(lua_State* L)
     lua_setsafeenv(L, LUA_GLOBALSINDEX, true);
 }
 
+#if defined(__linux__)
+// large blocks are allocated directly from the OS so that they can be resized without copying and don't fragment the heap
+#define LARGEALLOC_SIZE (1 << 20)
+#define LARGEALLOC_PAGE 4096
+#define LARGEALLOC_HUGEPAGE (2 << 20)
+
+#define largeallocround(size) (((size) + LARGEALLOC_PAGE - 1) & ~size_t(LARGEALLOC_PAGE - 1))
+
+static void* largeallocadvise(void* block, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    // huge pages reduce TLB pressure when traversing large arrays; this is just a hint, so errors are ignored
+    if (size >= LARGEALLOC_HUGEPAGE)
+        madvise(block, size, MADV_HUGEPAGE);
+#endif
+
+    return block;
+}
+
+// since allocation sizes are always known, blocks of at least LARGEALLOC_SIZE bytes are always mapped and smaller blocks never are
+static void* l_alloclarge(void* ptr, size_t osize, size_t nsize)
+{
+    if (nsize == 0)
+    {
+        munmap(ptr, largeallocround(osize));
+        return NULL;
+    }
+
+    if (osize < LARGEALLOC_SIZE)
+    {
+        void* result = mmap(NULL, largeallocround(nsize), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (result == MAP_FAILED)
+            return NULL;
+
+        if (ptr)
+        {
+            memcpy(result, ptr, osize);
+            free(ptr);
+        }
+
+        return largeallocadvise(result, largeallocround(nsize));
+    }
+
+    if (nsize < LARGEALLOC_SIZE)
+    {
+        void* result = malloc(nsize);
+        if (!result)
+            return NULL;
+
+        memcpy(result, ptr, nsize);
+        munmap(ptr, largeallocround(osize));
+
+        return result;
+    }
+
+    if (largeallocround(osize) == largeallocround(nsize))
+        return ptr;
+
+    // the kernel moves the pages to the new location if the mapping can't be extended in place, which avoids copying the contents
+    void* result = mremap(ptr, largeallocround(osize), largeallocround(nsize), MREMAP_MAYMOVE);
+    if (result == MAP_FAILED)
+        return NULL;
+
+    return largeallocadvise(result, largeallocround(nsize));
+}
+#endif
+
 static void* l_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
 {
     (void)ud;
     (void)osize;
+#if defined(__linux__)
+    if (osize >= LARGEALLOC_SIZE || nsize >= LARGEALLOC_SIZE)
+        return l_alloclarge(ptr, osize, nsize);
+#endif
     if (nsize == 0)
     {
         free(ptr);
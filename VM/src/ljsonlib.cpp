@@ -0,0 +1,824 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lualib.h"
+
+#include "lcommon.h"
+#include "lnumutils.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define uchar(c) ((unsigned char)(c))
+
+// maximum nesting of arrays and objects, for both decoding and encoding
+#define JSON_MAXDEPTH 128
+
+// number of stack slots used to collect array elements or object fields before they are stored in the table;
+// tables with fewer elements are created with the exact size
+#define JSON_BATCH 32
+
+// object keys are looked up in a small direct-mapped cache before they are interned
+#define JSON_KEYCACHE 64
+#define JSON_KEYCACHELEN 32
+
+// numbers longer than this can't be decoded
+#define JSON_MAXNUMBER 128
+
+/*
+** {======================================================
+** Decoding
+** =======================================================
+*/
+
+struct JsonKey
+{
+    const char* data;
+    size_t len;
+};
+
+struct JsonDecoder
+{
+    lua_State* L;
+    const char* begin;
+    const char* pos;
+    const char* end;
+    int depth;
+
+    int keycache; // stack index of the table that anchors the cached key strings
+    JsonKey keys[JSON_KEYCACHE];
+};
+
+static l_noret json_error(JsonDecoder* d, const char* msg)
+{
+    luaL_error(d->L, "invalid JSON at offset %d: %s", int(d->pos - d->begin), msg);
+}
+
+static void json_skipspace(JsonDecoder* d)
+{
+    while (d->pos < d->end && (*d->pos == ' ' || *d->pos == '\t' || *d->pos == '\n' || *d->pos == '\r'))
+        d->pos++;
+}
+
+static int json_hexdigit(int c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+static unsigned json_readhex(JsonDecoder* d)
+{
+    if (d->end - d->pos < 4)
+        json_error(d, "invalid unicode escape");
+
+    unsigned res = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        int digit = json_hexdigit(uchar(d->pos[i]));
+        if (digit < 0)
+            json_error(d, "invalid unicode escape");
+
+        res = res * 16 + digit;
+    }
+
+    d->pos += 4;
+    return res;
+}
+
+static void json_addutf8(luaL_Strbuf* b, unsigned cp)
+{
+    char* p = luaL_prepbuffsize(b, 4);
+
+    if (cp < 0x80)
+    {
+        p[0] = char(cp);
+        b->p += 1;
+    }
+    else if (cp < 0x800)
+    {
+        p[0] = char(0xc0 | (cp >> 6));
+        p[1] = char(0x80 | (cp & 0x3f));
+        b->p += 2;
+    }
+    else if (cp < 0x10000)
+    {
+        p[0] = char(0xe0 | (cp >> 12));
+        p[1] = char(0x80 | ((cp >> 6) & 0x3f));
+        p[2] = char(0x80 | (cp & 0x3f));
+        b->p += 3;
+    }
+    else
+    {
+        p[0] = char(0xf0 | (cp >> 18));
+        p[1] = char(0x80 | ((cp >> 12) & 0x3f));
+        p[2] = char(0x80 | ((cp >> 6) & 0x3f));
+        p[3] = char(0x80 | (cp & 0x3f));
+        b->p += 4;
+    }
+}
+
+// decodes the remainder of a string that has escape sequences; 'start' points after the opening quote
+static void json_decodeescaped(JsonDecoder* d, const char* start)
+{
+    luaL_Strbuf b;
+    luaL_buffinit(d->L, &b);
+    luaL_addlstring(&b, start, d->pos - start);
+
+    for (;;)
+    {
+        const char* run = d->pos;
+        while (d->pos < d->end && *d->pos != '"' && *d->pos != '\\' && uchar(*d->pos) >= 0x20)
+            d->pos++;
+
+        luaL_addlstring(&b, run, d->pos - run);
+
+        if (d->pos == d->end)
+            json_error(d, "unfinished string");
+
+        if (*d->pos == '"')
+            break;
+
+        if (*d->pos != '\\')
+            json_error(d, "control character in string");
+
+        if (++d->pos == d->end)
+            json_error(d, "unfinished string");
+
+        switch (*d->pos++)
+        {
+        case '"':
+            luaL_addchar(&b, '"');
+            break;
+        case '\\':
+            luaL_addchar(&b, '\\');
+            break;
+        case '/':
+            luaL_addchar(&b, '/');
+            break;
+        case 'b':
+            luaL_addchar(&b, '\b');
+            break;
+        case 'f':
+            luaL_addchar(&b, '\f');
+            break;
+        case 'n':
+            luaL_addchar(&b, '\n');
+            break;
+        case 'r':
+            luaL_addchar(&b, '\r');
+            break;
+        case 't':
+            luaL_addchar(&b, '\t');
+            break;
+        case 'u':
+        {
+            unsigned cp = json_readhex(d);
+
+            // characters outside of the basic plane are encoded as surrogate pairs
+            if (cp >= 0xd800 && cp <= 0xdbff)
+            {
+                if (d->end - d->pos < 2 || d->pos[0] != '\\' || d->pos[1] != 'u')
+                    json_error(d, "invalid unicode escape");
+
+                d->pos += 2;
+                unsigned low = json_readhex(d);
+
+                if (low < 0xdc00 || low > 0xdfff)
+                    json_error(d, "invalid unicode escape");
+
+                cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+            }
+            else if (cp >= 0xdc00 && cp <= 0xdfff)
+            {
+                json_error(d, "invalid unicode escape");
+            }
+
+            json_addutf8(&b, cp);
+            break;
+        }
+        default:
+            d->pos--;
+            json_error(d, "invalid escape sequence");
+        }
+    }
+
+    d->pos++; // closing quote
+    luaL_pushresult(&b);
+}
+
+static void json_decodestring(JsonDecoder* d, bool key)
+{
+    const char* start = ++d->pos;
+
+    while (d->pos < d->end && *d->pos != '"' && *d->pos != '\\' && uchar(*d->pos) >= 0x20)
+        d->pos++;
+
+    if (d->pos == d->end)
+        json_error(d, "unfinished string");
+
+    if (*d->pos != '"')
+    {
+        json_decodeescaped(d, start);
+        return;
+    }
+
+    size_t len = d->pos - start;
+    d->pos++;
+
+    if (key && len <= JSON_KEYCACHELEN)
+    {
+        // objects in the same document tend to repeat the same keys, which can be reused without hashing
+        unsigned slot = (unsigned(len) * 31 + (len ? uchar(start[0]) * 7 + uchar(start[len - 1]) : 0)) % JSON_KEYCACHE;
+        JsonKey& entry = d->keys[slot];
+
+        if (entry.data && entry.len == len && memcmp(entry.data, start, len) == 0)
+        {
+            lua_rawgeti(d->L, d->keycache, slot + 1);
+            return;
+        }
+
+        lua_pushlstring(d->L, start, len);
+        lua_pushvalue(d->L, -1);
+        lua_rawseti(d->L, d->keycache, slot + 1);
+
+        // the string data stays valid while the string is anchored by the cache table
+        entry.data = lua_tostring(d->L, -1);
+        entry.len = len;
+        return;
+    }
+
+    lua_pushlstring(d->L, start, len);
+}
+
+static void json_skipdigits(JsonDecoder* d)
+{
+    if (d->pos == d->end || !isdigit(uchar(*d->pos)))
+        json_error(d, "invalid number");
+
+    while (d->pos < d->end && isdigit(uchar(*d->pos)))
+        d->pos++;
+}
+
+static void json_decodenumber(JsonDecoder* d)
+{
+    const char* start = d->pos;
+
+    if (*d->pos == '-')
+        d->pos++;
+
+    // leading zeroes are not allowed
+    if (d->pos < d->end && *d->pos == '0')
+        d->pos++;
+    else
+        json_skipdigits(d);
+
+    bool integer = true;
+
+    if (d->pos < d->end && *d->pos == '.')
+    {
+        integer = false;
+        d->pos++;
+        json_skipdigits(d);
+    }
+
+    if (d->pos < d->end && (*d->pos == 'e' || *d->pos == 'E'))
+    {
+        integer = false;
+        d->pos++;
+
+        if (d->pos < d->end && (*d->pos == '+' || *d->pos == '-'))
+            d->pos++;
+
+        json_skipdigits(d);
+    }
+
+    const char* p = d->pos;
+
+    // integers with up to 15 digits are exactly representable, so they can be accumulated directly
+    if (integer && p - start <= 15)
+    {
+        const char* digits = start + (*start == '-');
+        double value = 0;
+
+        for (const char* q = digits; q < p; q++)
+            value = value * 10 + (*q - '0');
+
+        lua_pushnumber(d->L, *start == '-' ? -value : value);
+        return;
+    }
+
+    if (p - start >= JSON_MAXNUMBER)
+        json_error(d, "number is too long");
+
+    // the input is not zero-terminated
+    char buf[JSON_MAXNUMBER];
+    memcpy(buf, start, p - start);
+    buf[p - start] = '\0';
+
+    lua_pushnumber(d->L, luai_str2num(buf, NULL));
+}
+
+static void json_decodeliteral(JsonDecoder* d, const char* literal, size_t len)
+{
+    if (size_t(d->end - d->pos) < len || memcmp(d->pos, literal, len) != 0)
+        json_error(d, "unexpected character");
+
+    d->pos += len;
+}
+
+static void json_decodevalue(JsonDecoder* d);
+
+// stores the elements collected at the top of the stack in the table at 'idx', creating the table if necessary
+static void json_flusharray(JsonDecoder* d, int idx, int count, int pending)
+{
+    lua_State* L = d->L;
+    luaL_checkstack(L, 2, "nesting is too deep");
+
+    if (count == 0)
+    {
+        lua_createtable(L, pending, 0);
+        lua_insert(L, idx);
+    }
+
+    for (int i = pending; i > 0; i--)
+        lua_rawseti(L, idx, count + i);
+}
+
+static void json_decodearray(JsonDecoder* d)
+{
+    lua_State* L = d->L;
+    int idx = lua_gettop(L) + 1;
+
+    d->pos++;
+    json_skipspace(d);
+
+    if (d->pos < d->end && *d->pos == ']')
+    {
+        d->pos++;
+        lua_createtable(L, 0, 0);
+        return;
+    }
+
+    int count = 0;
+    int pending = 0;
+
+    for (;;)
+    {
+        json_decodevalue(d);
+        pending++;
+
+        json_skipspace(d);
+
+        if (d->pos == d->end)
+            json_error(d, "unfinished array");
+
+        char c = *d->pos++;
+
+        if (c == ']')
+            break;
+
+        if (c != ',')
+        {
+            d->pos--;
+            json_error(d, "expected ',' or ']'");
+        }
+
+        json_skipspace(d);
+
+        if (pending == JSON_BATCH)
+        {
+            json_flusharray(d, idx, count, pending);
+            count += pending;
+            pending = 0;
+        }
+    }
+
+    json_flusharray(d, idx, count, pending);
+}
+
+// stores the fields collected at the top of the stack in the table at 'idx' in document order, so that the last duplicate key wins
+static void json_flushobject(JsonDecoder* d, int idx, int count, int pending)
+{
+    lua_State* L = d->L;
+    luaL_checkstack(L, 3, "nesting is too deep");
+
+    if (count == 0)
+    {
+        lua_createtable(L, 0, pending);
+        lua_insert(L, idx);
+    }
+
+    for (int i = 0; i < pending; i++)
+    {
+        lua_pushvalue(L, idx + 1 + i * 2);
+        lua_pushvalue(L, idx + 2 + i * 2);
+        lua_rawset(L, idx);
+    }
+
+    lua_settop(L, idx);
+}
+
+static void json_decodeobject(JsonDecoder* d)
+{
+    lua_State* L = d->L;
+    int idx = lua_gettop(L) + 1;
+
+    d->pos++;
+    json_skipspace(d);
+
+    if (d->pos < d->end && *d->pos == '}')
+    {
+        d->pos++;
+        lua_createtable(L, 0, 0);
+        return;
+    }
+
+    int count = 0;
+    int pending = 0;
+
+    for (;;)
+    {
+        if (d->pos == d->end || *d->pos != '"')
+            json_error(d, "expected string key");
+
+        luaL_checkstack(L, 2, "nesting is too deep");
+        json_decodestring(d, /* key= */ true);
+
+        json_skipspace(d);
+
+        if (d->pos == d->end || *d->pos != ':')
+            json_error(d, "expected ':'");
+
+        d->pos++;
+        json_skipspace(d);
+
+        json_decodevalue(d);
+        pending++;
+
+        json_skipspace(d);
+
+        if (d->pos == d->end)
+            json_error(d, "unfinished object");
+
+        char c = *d->pos++;
+
+        if (c == '}')
+            break;
+
+        if (c != ',')
+        {
+            d->pos--;
+            json_error(d, "expected ',' or '}'");
+        }
+
+        json_skipspace(d);
+
+        if (pending * 2 == JSON_BATCH)
+        {
+            json_flushobject(d, idx, count, pending);
+            count += pending;
+            pending = 0;
+        }
+    }
+
+    json_flushobject(d, idx, count, pending);
+}
+
+static void json_decodevalue(JsonDecoder* d)
+{
+    luaL_checkstack(d->L, 2, "nesting is too deep");
+
+    if (d->pos == d->end)
+        json_error(d, "unexpected end of input");
+
+    switch (*d->pos)
+    {
+    case '{':
+    case '[':
+        if (++d->depth > JSON_MAXDEPTH)
+            json_error(d, "nesting is too deep");
+
+        if (*d->pos == '{')
+            json_decodeobject(d);
+        else
+            json_decodearray(d);
+
+        d->depth--;
+        break;
+    case '"':
+        json_decodestring(d, /* key= */ false);
+        break;
+    case 't':
+        json_decodeliteral(d, "true", 4);
+        lua_pushboolean(d->L, 1);
+        break;
+    case 'f':
+        json_decodeliteral(d, "false", 5);
+        lua_pushboolean(d->L, 0);
+        break;
+    case 'n':
+        json_decodeliteral(d, "null", 4);
+        lua_pushnil(d->L);
+        break;
+    default:
+        if (*d->pos != '-' && !isdigit(uchar(*d->pos)))
+            json_error(d, "unexpected character");
+
+        json_decodenumber(d);
+    }
+}
+
+static int json_decode(lua_State* L)
+{
+    size_t len = 0;
+    // buffers are parsed in place
+    const char* data = lua_isbuffer(L, 1) ? (const char*)lua_tobuffer(L, 1, &len) : luaL_checklstring(L, 1, &len);
+
+    lua_settop(L, 1);
+    lua_createtable(L, JSON_KEYCACHE, 0);
+
+    JsonDecoder d;
+    d.L = L;
+    d.begin = data;
+    d.pos = data;
+    d.end = data + len;
+    d.depth = 0;
+    d.keycache = lua_gettop(L);
+    memset(d.keys, 0, sizeof(d.keys));
+
+    json_skipspace(&d);
+    json_decodevalue(&d);
+    json_skipspace(&d);
+
+    if (d.pos != d.end)
+        json_error(&d, "unexpected character after the value");
+
+    return 1;
+}
+
+// }======================================================
+
+/*
+** {======================================================
+** Encoding
+** =======================================================
+*/
+
+struct JsonEncoder
+{
+    lua_State* L;
+    int output; // stack index of the buffer object that holds the output
+    char* data;
+    size_t size;
+    size_t capacity;
+    int depth;
+};
+
+static char* json_reserve(JsonEncoder* e, size_t size)
+{
+    if (e->capacity - e->size < size)
+    {
+        size_t capacity = e->capacity * 2;
+        if (capacity < e->size + size)
+            capacity = e->size + size;
+
+        // the output is kept in a buffer object, so that it's released by the GC if encoding fails
+        char* data = (char*)lua_newbuffer(e->L, capacity);
+        memcpy(data, e->data, e->size);
+        lua_replace(e->L, e->output);
+
+        e->data = data;
+        e->capacity = capacity;
+    }
+
+    return e->data + e->size;
+}
+
+static void json_addlstring(JsonEncoder* e, const char* s, size_t len)
+{
+    memcpy(json_reserve(e, len), s, len);
+    e->size += len;
+}
+
+static void json_addchar(JsonEncoder* e, char c)
+{
+    *json_reserve(e, 1) = c;
+    e->size++;
+}
+
+static void json_encodestring(JsonEncoder* e, const char* s, size_t len)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    // each character takes at most 6 bytes with the \u00XX escape
+    char* p = json_reserve(e, len * 6 + 2);
+    char* start = p;
+
+    *p++ = '"';
+
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned char c = uchar(s[i]);
+
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            *p++ = char(c);
+            continue;
+        }
+
+        *p++ = '\\';
+
+        switch (c)
+        {
+        case '"':
+            *p++ = '"';
+            break;
+        case '\\':
+            *p++ = '\\';
+            break;
+        case '\b':
+            *p++ = 'b';
+            break;
+        case '\f':
+            *p++ = 'f';
+            break;
+        case '\n':
+            *p++ = 'n';
+            break;
+        case '\r':
+            *p++ = 'r';
+            break;
+        case '\t':
+            *p++ = 't';
+            break;
+        default:
+            *p++ = 'u';
+            *p++ = '0';
+            *p++ = '0';
+            *p++ = hex[c >> 4];
+            *p++ = hex[c & 15];
+        }
+    }
+
+    *p++ = '"';
+
+    e->size += p - start;
+}
+
+static void json_encodevalue(JsonEncoder* e, int idx);
+
+static void json_encodetable(JsonEncoder* e, int idx)
+{
+    lua_State* L = e->L;
+
+    if (++e->depth > JSON_MAXDEPTH)
+        luaL_error(L, "cannot encode JSON: nesting is too deep or the table has a cycle");
+
+    luaL_checkstack(L, 3, "nesting is too deep");
+
+    // tables where all keys are 1..n are encoded as arrays; empty tables are encoded as empty arrays
+    int n = lua_objlen(L, idx);
+    int count = 0;
+    bool array = true;
+
+    lua_pushnil(L);
+    while (lua_next(L, idx))
+    {
+        lua_pop(L, 1);
+        count++;
+
+        if (count > n)
+        {
+            array = false;
+            lua_pop(L, 1);
+            break;
+        }
+    }
+
+    if (array)
+    {
+        json_addchar(e, '[');
+
+        for (int i = 1; i <= n; i++)
+        {
+            if (i > 1)
+                json_addchar(e, ',');
+
+            lua_rawgeti(L, idx, i);
+            json_encodevalue(e, lua_gettop(L));
+            lua_pop(L, 1);
+        }
+
+        json_addchar(e, ']');
+    }
+    else
+    {
+        json_addchar(e, '{');
+
+        bool first = true;
+
+        lua_pushnil(L);
+        while (lua_next(L, idx))
+        {
+            if (lua_type(L, -2) != LUA_TSTRING)
+                luaL_error(L, "cannot encode JSON: object keys must be strings, got %s", luaL_typename(L, -2));
+
+            if (!first)
+                json_addchar(e, ',');
+            first = false;
+
+            size_t len = 0;
+            const char* key = lua_tolstring(L, -2, &len);
+            json_encodestring(e, key, len);
+            json_addchar(e, ':');
+
+            json_encodevalue(e, lua_gettop(L));
+            lua_pop(L, 1);
+        }
+
+        json_addchar(e, '}');
+    }
+
+    e->depth--;
+}
+
+static void json_encodevalue(JsonEncoder* e, int idx)
+{
+    lua_State* L = e->L;
+
+    switch (lua_type(L, idx))
+    {
+    case LUA_TNIL:
+        json_addlstring(e, "null", 4);
+        break;
+    case LUA_TBOOLEAN:
+        if (lua_toboolean(L, idx))
+            json_addlstring(e, "true", 4);
+        else
+            json_addlstring(e, "false", 5);
+        break;
+    case LUA_TNUMBER:
+    {
+        double n = lua_tonumber(L, idx);
+
+        if (!isfinite(n))
+            luaL_error(L, "cannot encode JSON: number is not finite");
+
+        char* p = json_reserve(e, LUAI_MAXNUM2STR);
+        e->size += luai_num2str(p, n) - p;
+        break;
+    }
+    case LUA_TSTRING:
+    {
+        size_t len = 0;
+        const char* s = lua_tolstring(L, idx, &len);
+        json_encodestring(e, s, len);
+        break;
+    }
+    case LUA_TTABLE:
+        json_encodetable(e, idx);
+        break;
+    default:
+        luaL_error(L, "cannot encode JSON: unsupported type %s", luaL_typename(L, idx));
+    }
+}
+
+static int json_encode(lua_State* L)
+{
+    luaL_checkany(L, 1);
+    lua_settop(L, 1);
+
+    JsonEncoder e;
+    e.L = L;
+    e.size = 0;
+    e.capacity = LUA_BUFFERSIZE;
+    e.depth = 0;
+    e.data = (char*)lua_newbuffer(L, e.capacity);
+    e.output = lua_gettop(L);
+
+    json_encodevalue(&e, 1);
+
+    lua_pushlstring(L, e.data, e.size);
+    return 1;
+}
+
+// }======================================================
+
+static const luaL_Reg json_funcs[] = {
+    {"decode", json_decode},
+    {"encode", json_encode},
+    {NULL, NULL},
+};
+
+int luaopen_json(lua_State* L)
+{
+    luaL_register(L, LUA_JSONLIBNAME, json_funcs);
+
+    return 1;
+}
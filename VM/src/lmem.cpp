@@ -80,6 +80,19 @@
  * the contents of the page, and the free list for further reuse; this allows shorter page setup times
  * which results in less variance between allocation cost, as well as tighter sweep bounds for newly
  * allocated pages.
+ *
+ * Optionally (see LUA_GCSETALLOCCACHE), each thread can keep a small cache of free GCO blocks for every size
+ * class (lua_AllocCache). When the cache for a size class runs out, it is refilled in a batch from the page free
+ * list; blocks in the cache stay allocated from the page's point of view, but have the type set to TNIL so that
+ * the sweeper and heap walkers skip them. Since GCO blocks can only be freed together with their page, cached
+ * blocks store the page pointer after the free list link, so only size classes that can fit both are cached.
+ * When a thread is freed, its cached blocks can't be returned to their pages immediately because that might
+ * free a page that is being swept; instead, they are put on a deferred list that is released after the sweep.
+ *
+ * Memory categories can optionally have limits (see lua_setmemcatlimit) which are checked before every allocation
+ * that increases the category usage. Exceeding the soft limit calls lua_Callbacks::memcatlimit, which can raise an
+ * error, and schedules a GC step for the next GC check, since the collector can't run in the middle of an allocation;
+ * an allocation that would exceed the hard limit fails with a memory error.
  */
 
 #ifndef __has_feature
@@ -198,6 +211,10 @@ const SizeClassConfig kSizeClassConfig;
 #define metadata(block) (*(void**)(block))
 #define freegcolink(block) (*(void**)((char*)block + kGCOLinkOffset))
 
+// cached GCO blocks store the page they belong to after the free list link
+#define cachepage(block) (*(lua_Page**)((char*)block + kGCOLinkOffset + sizeof(void*)))
+#define cacheable(sizeClass) (size_t(kSizeClassConfig.sizeOfClass[sizeClass]) >= kGCOLinkOffset + 2 * sizeof(void*))
+
 #if defined(LUAU_ASSERTENABLED)
 #define debugpageset(x) (x)
 #else
@@ -229,6 +246,19 @@ struct lua_Page
     };
 };
 
+struct lua_MemcatLimits
+{
+    size_t soft[LUA_MEMORY_CATEGORIES]; // 0 if the category has no soft limit
+    size_t hard[LUA_MEMORY_CATEGORIES]; // 0 if the category has no hard limit
+
+    bool incallback; // allocations performed by the limit callback are not reported again
+};
+
+struct lua_AllocCache
+{
+    void* blocks[kSizeClasses]; // free GCO blocks for each size class; linked with freegcolink()
+};
+
 l_noret luaM_toobig(lua_State* L)
 {
     luaG_runerror(L, "memory allocation error: block too big");
@@ -297,6 +327,10 @@ static void freepage(lua_State* L, lua_Page** pageset, lua_Page* page)
 {
     global_State* g = L->global;
 
+    // heap snapshot in progress skips the pages that are freed before it gets to them
+    if (g->heapsnapshotpage == page)
+        g->heapsnapshotpage = page->listnext;
+
     if (pageset)
     {
         // remove page from alllist
@@ -375,15 +409,9 @@ static void* newblock(lua_State* L, int sizeClass)
     return (char*)block + kBlockHeader;
 }
 
-static void* newgcoblock(lua_State* L, int sizeClass)
+static void* newgcoblockfrompage(global_State* g, lua_Page* page, int sizeClass)
 {
-    global_State* g = L->global;
-    lua_Page* page = g->freegcopages[sizeClass];
-
-    // slow path: no page in the freelist, allocate a new one
-    if (!page)
-        page = newclasspage(L, g->freegcopages, &g->allgcopages, sizeClass, false);
-
+    LUAU_ASSERT(page == g->freegcopages[sizeClass]);
     LUAU_ASSERT(!page->prev);
     LUAU_ASSERT(page->freeList || page->freeNext >= 0);
     LUAU_ASSERT(page->blockSize == kSizeClassConfig.sizeOfClass[sizeClass]);
@@ -420,6 +448,62 @@ static void* newgcoblock(lua_State* L, int sizeClass)
     return block;
 }
 
+static void* newgcoblock(lua_State* L, int sizeClass)
+{
+    global_State* g = L->global;
+    lua_Page* page = g->freegcopages[sizeClass];
+
+    // slow path: no page in the freelist, allocate a new one
+    if (!page)
+        page = newclasspage(L, g->freegcopages, &g->allgcopages, sizeClass, false);
+
+    return newgcoblockfrompage(g, page, sizeClass);
+}
+
+// this is the slow path of GCO allocation when thread allocation caches are enabled
+LUAU_NOINLINE static void* newgcoblockcached(lua_State* L, int sizeClass)
+{
+    global_State* g = L->global;
+
+    if (!cacheable(sizeClass))
+        return newgcoblock(L, sizeClass);
+
+    // cache is allocated before the block so that allocation failure doesn't leave the block in limbo
+    lua_AllocCache* cache = L->alloccache;
+
+    if (!cache)
+    {
+        cache = (lua_AllocCache*)luaM_new_(L, sizeof(lua_AllocCache), 0);
+        memset(cache, 0, sizeof(lua_AllocCache));
+        L->alloccache = cache;
+    }
+
+    void* block = newgcoblock(L, sizeClass);
+
+    g->gcstats.alloccachemisses++;
+
+    // refill the cache with free blocks from existing pages; we don't allocate new pages to keep cache memory bounded
+    LUAU_ASSERT(!cache->blocks[sizeClass]);
+
+    for (int i = 0; i < g->alloccachesize; ++i)
+    {
+        lua_Page* page = g->freegcopages[sizeClass];
+        if (!page)
+            break;
+
+        void* cached = newgcoblockfrompage(g, page, sizeClass);
+
+        // the block is still treated as free by the sweeper
+        ((GCObject*)cached)->gch.tt = LUA_TNIL;
+
+        freegcolink(cached) = cache->blocks[sizeClass];
+        cachepage(cached) = page;
+        cache->blocks[sizeClass] = cached;
+    }
+
+    return block;
+}
+
 static void freeblock(lua_State* L, int sizeClass, void* block)
 {
     global_State* g = L->global;
@@ -491,10 +575,89 @@ static void freegcoblock(lua_State* L, int sizeClass, void* block, lua_Page* pag
         freeclasspage(L, g->freegcopages, &g->allgcopages, page, sizeClass);
 }
 
+struct MemcatLimitCall
+{
+    uint8_t memcat;
+    size_t size;
+};
+
+static void callmemcatlimit(lua_State* L, void* ud)
+{
+    MemcatLimitCall* call = (MemcatLimitCall*)ud;
+
+    L->global->cb.memcatlimit(L, call->memcat, call->size);
+}
+
+LUAU_NOINLINE static void checkmemcatlimit(lua_State* L, uint8_t memcat, size_t nsize)
+{
+    global_State* g = L->global;
+    lua_MemcatLimits* limits = g->memcatlimits;
+
+    size_t soft = limits->soft[memcat];
+
+    if (soft && g->memcatbytes[memcat] <= soft && g->memcatbytes[memcat] + nsize > soft)
+    {
+        // the collector can't run in the middle of an allocation, so a step is scheduled for the next GC check instead
+        if (g->GCthreshold != SIZE_MAX)
+            g->GCthreshold = g->totalbytes;
+    }
+
+    if (soft && g->memcatbytes[memcat] <= soft && g->memcatbytes[memcat] + nsize > soft && g->cb.memcatlimit && !limits->incallback)
+    {
+        MemcatLimitCall call = {memcat, g->memcatbytes[memcat] + nsize};
+
+        // the callback can raise an error; we need to reset the recursion guard before propagating it
+        limits->incallback = true;
+        int status = luaD_rawrunprotected(L, callmemcatlimit, &call);
+        limits->incallback = false;
+
+        if (status != 0)
+            luaD_throw(L, status);
+    }
+
+    size_t hard = limits->hard[memcat];
+
+    if (hard && g->memcatbytes[memcat] + nsize > hard)
+        luaD_throw(L, LUA_ERRMEM);
+}
+
+// checks the memory category limits for an allocation that increases memory category usage by nsize bytes
+#define checkmemcat(L, g, memcat, nsize) \
+    if (LUAU_UNLIKELY(g->memcatlimits != NULL)) \
+        checkmemcatlimit(L, memcat, nsize);
+
+LUAU_NOINLINE static void sampleallocation(lua_State* L, uint8_t memcat, size_t nsize)
+{
+    global_State* g = L->global;
+
+    if (nsize < g->allocsampleleft)
+    {
+        g->allocsampleleft -= nsize;
+        return;
+    }
+
+    // a large allocation can cross several sampling points; the sample accounts for all of them to keep the byte totals unbiased
+    size_t excess = nsize - g->allocsampleleft;
+    size_t samples = 1 + excess / g->allocsamplerate;
+
+    g->allocsampleleft = g->allocsamplerate - excess % g->allocsamplerate;
+
+    if (g->cb.allocsample)
+        g->cb.allocsample(L, memcat, samples * g->allocsamplerate);
+}
+
+// samples an allocation of nsize bytes; this runs before the allocation so that the callback observes a consistent call stack
+#define checkallocsample(L, g, memcat, nsize) \
+    if (LUAU_UNLIKELY(g->allocsamplerate != 0)) \
+        sampleallocation(L, memcat, nsize);
+
 void* luaM_new_(lua_State* L, size_t nsize, uint8_t memcat)
 {
     global_State* g = L->global;
 
+    checkmemcat(L, g, memcat, nsize);
+    checkallocsample(L, g, memcat, nsize);
+
     int nclass = sizeclass(nsize);
 
     void* block = nclass >= 0 ? newblock(L, nclass) : (*g->frealloc)(g->ud, NULL, 0, nsize);
@@ -514,13 +677,28 @@ GCObject* luaM_newgco_(lua_State* L, size_t nsize, uint8_t memcat)
 
     global_State* g = L->global;
 
+    checkmemcat(L, g, memcat, nsize);
+    checkallocsample(L, g, memcat, nsize);
+
     int nclass = sizeclass(nsize);
 
     void* block = NULL;
 
     if (nclass >= 0)
     {
-        block = newgcoblock(L, nclass);
+        lua_AllocCache* cache = L->alloccache;
+
+        if (cache && cache->blocks[nclass])
+        {
+            block = cache->blocks[nclass];
+            cache->blocks[nclass] = freegcolink(block);
+
+            g->gcstats.alloccachehits++;
+        }
+        else
+        {
+            block = g->alloccachesize > 0 ? newgcoblockcached(L, nclass) : newgcoblock(L, nclass);
+        }
     }
     else
     {
@@ -589,6 +767,12 @@ void* luaM_realloc_(lua_State* L, void* block, size_t osize, size_t nsize, uint8
     global_State* g = L->global;
     LUAU_ASSERT((osize == 0) == (block == NULL));
 
+    if (nsize > osize)
+    {
+        checkmemcat(L, g, memcat, nsize - osize);
+        checkallocsample(L, g, memcat, nsize - osize);
+    }
+
     int nclass = sizeclass(nsize);
     int oclass = sizeclass(osize);
     void* result;
@@ -621,6 +805,82 @@ void* luaM_realloc_(lua_State* L, void* block, size_t osize, size_t nsize, uint8
     return result;
 }
 
+void luaM_checkmemcat(lua_State* L, uint8_t memcat, size_t nsize)
+{
+    global_State* g = L->global;
+
+    checkmemcat(L, g, memcat, nsize);
+}
+
+void luaM_setmemcatlimit(lua_State* L, uint8_t memcat, size_t softlimit, size_t hardlimit)
+{
+    global_State* g = L->global;
+
+    if (!g->memcatlimits)
+    {
+        // allocate the limits before they are enabled so that the allocation itself isn't checked
+        lua_MemcatLimits* limits = (lua_MemcatLimits*)luaM_new_(L, sizeof(lua_MemcatLimits), 0);
+        memset(limits, 0, sizeof(lua_MemcatLimits));
+        g->memcatlimits = limits;
+    }
+
+    g->memcatlimits->soft[memcat] = softlimit;
+    g->memcatlimits->hard[memcat] = hardlimit;
+}
+
+void luaM_freememcatlimits(lua_State* L)
+{
+    global_State* g = L->global;
+
+    if (g->memcatlimits)
+    {
+        luaM_free_(L, g->memcatlimits, sizeof(lua_MemcatLimits), 0);
+        g->memcatlimits = NULL;
+    }
+}
+
+void luaM_freealloccache(lua_State* L, lua_State* L1)
+{
+    global_State* g = L->global;
+    lua_AllocCache* cache = L1->alloccache;
+
+    if (!cache)
+        return;
+
+    for (size_t i = 0; i < kSizeClasses; ++i)
+    {
+        for (void* block = cache->blocks[i]; block;)
+        {
+            void* next = freegcolink(block);
+
+            freegcolink(block) = g->alloccachedeferred;
+            g->alloccachedeferred = block;
+
+            block = next;
+        }
+    }
+
+    luaM_free_(L, cache, sizeof(lua_AllocCache), 0);
+    L1->alloccache = NULL;
+}
+
+void luaM_releasealloccache(lua_State* L)
+{
+    global_State* g = L->global;
+
+    for (void* block = g->alloccachedeferred; block;)
+    {
+        void* next = freegcolink(block);
+        lua_Page* page = cachepage(block);
+
+        freegcoblock(L, kSizeClassConfig.classForSize[page->blockSize], block, page);
+
+        block = next;
+    }
+
+    g->alloccachedeferred = NULL;
+}
+
 void luaM_getpagewalkinfo(lua_Page* page, char** start, char** end, int* busyBlocks, int* blockSize)
 {
     int blockCount = (page->pageSize - offsetof(lua_Page, data)) / page->blockSize;
@@ -648,6 +908,43 @@ lua_Page* luaM_getnextpage(lua_Page* page)
     return page->listnext;
 }
 
+void luaM_detachgcopage(lua_State* L, lua_Page* page)
+{
+    global_State* g = L->global;
+
+    // only pages with free blocks are in the free list
+    LUAU_ASSERT(page->freeList || page->freeNext >= 0);
+    LUAU_ASSERT(size_t(page->blockSize) <= kMaxSmallSizeUsed);
+
+    int sizeClass = kSizeClassConfig.classForSize[page->blockSize];
+
+    if (page->next)
+        page->next->prev = page->prev;
+
+    if (page->prev)
+        page->prev->next = page->next;
+    else if (g->freegcopages[sizeClass] == page)
+        g->freegcopages[sizeClass] = page->next;
+
+    page->prev = NULL;
+    page->next = NULL;
+}
+
+void luaM_attachgcopage(lua_State* L, lua_Page* page)
+{
+    global_State* g = L->global;
+
+    LUAU_ASSERT(page->freeList || page->freeNext >= 0);
+    LUAU_ASSERT(!page->prev && !page->next);
+
+    int sizeClass = kSizeClassConfig.classForSize[page->blockSize];
+
+    page->next = g->freegcopages[sizeClass];
+    if (page->next)
+        page->next->prev = page;
+    g->freegcopages[sizeClass] = page;
+}
+
 void luaM_visitpage(lua_Page* page, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco))
 {
     char* start;
@@ -25,9 +25,18 @@ LUAI_FUNC void* luaM_realloc_(lua_State* L, void* block, size_t osize, size_t ns
 
 LUAI_FUNC l_noret luaM_toobig(lua_State* L);
 
+LUAI_FUNC void luaM_checkmemcat(lua_State* L, uint8_t memcat, size_t nsize);
+LUAI_FUNC void luaM_setmemcatlimit(lua_State* L, uint8_t memcat, size_t softlimit, size_t hardlimit);
+LUAI_FUNC void luaM_freememcatlimits(lua_State* L);
+
+LUAI_FUNC void luaM_freealloccache(lua_State* L, lua_State* L1);
+LUAI_FUNC void luaM_releasealloccache(lua_State* L);
+
 LUAI_FUNC void luaM_getpagewalkinfo(lua_Page* page, char** start, char** end, int* busyBlocks, int* blockSize);
 LUAI_FUNC void luaM_getpageinfo(lua_Page* page, int* pageBlocks, int* busyBlocks, int* blockSize, int* pageSize);
 LUAI_FUNC lua_Page* luaM_getnextpage(lua_Page* page);
+LUAI_FUNC void luaM_detachgcopage(lua_State* L, lua_Page* page);
+LUAI_FUNC void luaM_attachgcopage(lua_State* L, lua_Page* page);
 
 LUAI_FUNC void luaM_visitpage(lua_Page* page, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco));
 LUAI_FUNC void luaM_visitgco(lua_State* L, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco));
@@ -49,6 +49,8 @@ int luaO_rawequalObj(const TValue* t1, const TValue* t2)
             return bvalue(t1) == bvalue(t2); // boolean true must be 1 !!
         case LUA_TLIGHTUSERDATA:
             return pvalue(t1) == pvalue(t2) && lightuserdatatag(t1) == lightuserdatatag(t2);
+        case LUA_TSTRING:
+            return luaS_eqstr(tsvalue(t1), tsvalue(t2));
         default:
             LUAU_ASSERT(iscollectable(t1));
             return gcvalue(t1) == gcvalue(t2);
@@ -72,6 +74,8 @@ int luaO_rawequalKey(const TKey* t1, const TValue* t2)
             return bvalue(t1) == bvalue(t2); // boolean true must be 1 !!
         case LUA_TLIGHTUSERDATA:
             return pvalue(t1) == pvalue(t2) && lightuserdatatag(t1) == lightuserdatatag(t2);
+        case LUA_TSTRING:
+            return luaS_eqstr(tsvalue(t1), tsvalue(t2));
         default:
             LUAU_ASSERT(iscollectable(t1));
             return gcvalue(t1) == gcvalue(t2);
@@ -237,7 +237,8 @@ typedef TValue* StkId; // index to stack elements
 typedef struct TString
 {
     CommonHeader;
-    // 1 byte padding
+
+    uint8_t hashed; // long strings only: the hash has been computed
 
     int16_t atom;
 
@@ -285,6 +286,17 @@ typedef struct Buffer
     };
 } Buffer;
 
+// longest chain of __index tables that GETTABLEKS/NAMECALL can resolve without a full lookup, see luaV_getindexchain
+#define LUAI_MAXINDEXCHAIN 6
+
+// resolution of a string key through a chain of __index tables; slots are truncated to 8 bits like instruction slot hints
+typedef struct IndexChain
+{
+    uint8_t depth;                         // number of __index tables in the chain, or 0 if nothing was recorded
+    uint8_t slot;                          // slot of the key in the last __index table
+    uint8_t indexslot[LUAI_MAXINDEXCHAIN]; // slot of __index in each metatable of the chain
+} IndexChain;
+
 /*
 ** Function Prototypes
 */
@@ -318,8 +330,11 @@ typedef struct Proto
 
     TString* debugname;
     uint8_t* debuginsn; // a copy of code[] array with just opcodes
+    uint8_t* slotcache; // for each instruction, secondary slot hint of polymorphic GETTABLEKS/NAMECALL (allocated on first hint change)
+    IndexChain* indexchain; // for each instruction, __index chain that resolved GETTABLEKS/NAMECALL (allocated on first deep lookup)
 
     uint8_t* typeinfo;
+    uint8_t* argtypes; // for each parameter, type tag observed on all calls so far (or ARGTYPE_*), see lua_settypeprofiling
 
     void* userdata;
 
@@ -336,9 +351,15 @@ typedef struct Proto
     int linedefined;
     int bytecodeid;
     int sizetypeinfo;
+
+    unsigned int hotcount; // calls and loop iterations left before the function is reported as hot, see lua_sethotthreshold
 } Proto;
 // clang-format on
 
+// values of Proto::argtypes elements that don't correspond to a single observed type tag
+#define ARGTYPE_NONE 0xff
+#define ARGTYPE_MIXED 0xfe
+
 typedef struct LocVar
 {
     TString* varname;
@@ -460,7 +481,7 @@ typedef struct Table
 
 
     uint8_t tmcache;    // 1<<p means tagmethod(p) is not present
-    uint8_t readonly;   // sandboxing feature to prohibit writes to table
+    uint8_t readonly;   // sandboxing feature to prohibit writes to table; also marks storage shared with clones, see ltable.h
     uint8_t safeenv;    // environment doesn't share globals with other scripts
     uint8_t lsizenode;  // log2 of size of `node' array
     uint8_t nodemask8; // (1<<lsizenode)-1, truncated to 8 bits
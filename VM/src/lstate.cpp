@@ -19,15 +19,43 @@ typedef struct LG
     global_State g;
 } LG;
 
+// pooled stacks keep their CallInfo array in the second slot of the stack
+#define poolnext(stack) ((TValue*)(stack)[0].value.p)
+#define poolci(stack) ((CallInfo*)(stack)[1].value.p)
+
+static void movememcat(global_State* g, size_t size, uint8_t from, uint8_t to)
+{
+    g->memcatbytes[from] -= size;
+    g->memcatbytes[to] += size;
+}
+
 static void stack_init(lua_State* L1, lua_State* L)
 {
+    global_State* g = L->global;
+    if (TValue* pooled = g->threadpool)
+    {
+        size_t size = BASIC_CI_SIZE * sizeof(CallInfo) + (BASIC_STACK_SIZE + EXTRA_STACK) * sizeof(TValue);
+
+        // reuse the stack of a collected thread; pooled memory is attributed to category 0 until it's reused, and then it's subject to
+        // the limits of the new category like an allocation would be
+        luaM_checkmemcat(L, L1->memcat, size);
+
+        g->threadpool = poolnext(pooled);
+        g->threadpoolsize--;
+        L1->base_ci = poolci(pooled);
+        L1->stack = pooled;
+        movememcat(g, size, 0, L1->memcat);
+    }
+    else
+    {
+        L1->base_ci = luaM_newarray(L, BASIC_CI_SIZE, CallInfo, L1->memcat);
+        L1->stack = luaM_newarray(L, BASIC_STACK_SIZE + EXTRA_STACK, TValue, L1->memcat);
+    }
     // initialize CallInfo array
-    L1->base_ci = luaM_newarray(L, BASIC_CI_SIZE, CallInfo, L1->memcat);
     L1->ci = L1->base_ci;
     L1->size_ci = BASIC_CI_SIZE;
     L1->end_ci = L1->base_ci + L1->size_ci - 1;
     // initialize stack array
-    L1->stack = luaM_newarray(L, BASIC_STACK_SIZE + EXTRA_STACK, TValue, L1->memcat);
     L1->stacksize = BASIC_STACK_SIZE + EXTRA_STACK;
     TValue* stack = L1->stack;
     for (int i = 0; i < BASIC_STACK_SIZE + EXTRA_STACK; i++)
@@ -43,10 +71,38 @@ static void stack_init(lua_State* L1, lua_State* L)
 
 static void freestack(lua_State* L, lua_State* L1)
 {
+    global_State* g = L->global;
+    if (g->threadpoolsize < g->threadpoollimit && L1->size_ci == BASIC_CI_SIZE && L1->stacksize == BASIC_STACK_SIZE + EXTRA_STACK)
+    {
+        TValue* stack = L1->stack;
+        stack[0].value.p = g->threadpool;
+        stack[1].value.p = L1->base_ci;
+        g->threadpool = stack;
+        g->threadpoolsize++;
+        movememcat(g, BASIC_CI_SIZE * sizeof(CallInfo) + (BASIC_STACK_SIZE + EXTRA_STACK) * sizeof(TValue), L1->memcat, 0);
+        return;
+    }
+
     luaM_freearray(L, L1->base_ci, L1->size_ci, CallInfo, L1->memcat);
     luaM_freearray(L, L1->stack, L1->stacksize, TValue, L1->memcat);
 }
 
+void luaE_trimthreadpool(lua_State* L)
+{
+    global_State* g = L->global;
+    while (g->threadpoolsize > g->threadpoollimit)
+    {
+        TValue* stack = g->threadpool;
+        g->threadpool = poolnext(stack);
+        g->threadpoolsize--;
+        luaM_freearray(L, poolci(stack), BASIC_CI_SIZE, CallInfo, 0);
+        luaM_freearray(L, stack, BASIC_STACK_SIZE + EXTRA_STACK, TValue, 0);
+    }
+}
+
+// pinned error messages are found by interning, which only works for short strings
+static_assert(sizeof(LUA_MEMERRMSG) - 1 <= LUAI_MAXSHORTLEN && sizeof(LUA_ERRERRMSG) - 1 <= LUAI_MAXSHORTLEN, "error messages must be short strings");
+
 /*
 ** open parts that may cause memory-allocation errors
 */
@@ -76,10 +132,12 @@ static void preinit_state(lua_State* L, global_State* g)
     L->base_ci = L->ci = NULL;
     L->namecall = NULL;
     L->cachedslot = 0;
+    L->interruptbudget = 0;
     L->singlestep = false;
     L->isactive = false;
     L->activememcat = 0;
     L->userdata = NULL;
+    L->alloccache = NULL;
 }
 
 static void close_state(lua_State* L)
@@ -89,7 +147,15 @@ static void close_state(lua_State* L)
     luaC_freeall(L);         // collect all objects
     LUAU_ASSERT(g->strt.nuse == 0);
     luaM_freearray(L, L->global->strt.hash, L->global->strt.size, TString*, 0);
+    luaM_freearray(L, g->refs, g->refsize, TValue, 0);
+    luaM_freearray(L, g->refgens, g->refsize, uint8_t, 0);
     freestack(L, L);
+    g->threadpoollimit = 0;
+    luaE_trimthreadpool(L);
+    luaM_freememcatlimits(L);
+    luaG_freeopcodestats(L);
+    luaS_freepackcache(L);
+    luaH_freeshares(L);
     for (int i = 0; i < LUA_SIZECLASSES; i++)
     {
         LUAU_ASSERT(g->freepages[i] == NULL);
@@ -126,6 +192,7 @@ void luaE_freethread(lua_State* L, lua_State* L1, lua_Page* page)
     if (g->cb.userthread)
         g->cb.userthread(NULL, L1);
     freestack(L, L1);
+    luaM_freealloccache(L, L1);
     luaM_freegco(L, L1, sizeof(lua_State), L1->memcat, page);
 }
 
@@ -159,7 +226,7 @@ int lua_isthreadreset(lua_State* L)
     return L->ci == L->base_ci && L->base == L->top && L->status == LUA_OK;
 }
 
-lua_State* lua_newstate(lua_Alloc f, void* ud)
+static lua_State* newstate(lua_Alloc f, void* ud, global_State* shared)
 {
     int i;
     lua_State* L;
@@ -179,7 +246,11 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->uvhead.u.open.prev = &g->uvhead;
     g->uvhead.u.open.next = &g->uvhead;
     g->GCthreshold = 0; // mark it as unfinished state
-    g->registryfree = 0;
+    g->refs = NULL;
+    g->refgens = NULL;
+    g->refsize = 0;
+    g->reftop = 1;
+    g->reffree = 0;
     g->errorjmp = NULL;
     g->rngstate = 0;
     g->ptrenckey[0] = 1;
@@ -192,6 +263,8 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     setnilvalue(&g->pseudotemp);
     setnilvalue(registry(L));
     g->gcstate = GCSpause;
+    g->gcgen = 0;
+    g->gcsticky = 0;
     g->gray = NULL;
     g->grayagain = NULL;
     g->weak = NULL;
@@ -199,6 +272,21 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->gcgoal = LUAI_GCGOAL;
     g->gcstepmul = LUAI_GCSTEPMUL;
     g->gcstepsize = LUAI_GCSTEPSIZE << 10;
+    g->gcgenminormul = LUAI_GCGENMINORMUL;
+    g->gcgenmajormul = LUAI_GCGENMAJORMUL;
+    g->gcworkers = 0;
+    g->gctableshrink = 0;
+    g->hotthreshold = 0;
+    g->typeprofiling = false;
+    g->allocsamplerate = 0;
+    g->allocsampleleft = 0;
+    g->threadpoollimit = 0;
+    g->threadpoolsize = 0;
+    g->threadpool = NULL;
+    g->alloccachesize = 0;
+    g->gcframebudget = 0;
+    g->gcframetime = 0.0;
+    g->gcdeferred = 0;
     for (i = 0; i < LUA_SIZECLASSES; i++)
     {
         g->freepages[i] = NULL;
@@ -207,17 +295,34 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->allpages = NULL;
     g->allgcopages = NULL;
     g->sweepgcopage = NULL;
+    g->alloccachedeferred = NULL;
+    g->memcatlimits = NULL;
+    g->opstats = NULL;
+    g->packcache = NULL;
+    g->tableshares = NULL;
+    g->sharedstate = shared;
+    g->published = NULL;
+    g->atomtable = shared ? shared->atomtable : NULL;
+    g->heapsnapshot = NULL;
+    g->heapsnapshotpage = NULL;
     for (i = 0; i < LUA_T_COUNT; i++)
         g->mt[i] = NULL;
     for (i = 0; i < LUA_UTAG_LIMIT; i++)
     {
         g->udatagc[i] = NULL;
+        g->udatabatchgc[i] = NULL;
         g->udatamt[i] = NULL;
+        g->udataops[i] = NULL;
     }
     for (i = 0; i < LUA_LUTAG_LIMIT; i++)
         g->lightuserdataname[i] = NULL;
+    for (i = 0; i < LUA_HOSTBUILTIN_LIMIT; i++)
+        g->hostbuiltins[i] = NULL;
     for (i = 0; i < LUA_MEMORY_CATEGORIES; i++)
+    {
         g->memcatbytes[i] = 0;
+        g->memcatstackstats[i] = lua_StackStats();
+    }
 
     g->memcatbytes[0] = sizeof(LG);
 
@@ -240,6 +345,17 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     return L;
 }
 
+lua_State* lua_newstate(lua_Alloc f, void* ud)
+{
+    return newstate(f, ud, NULL);
+}
+
+lua_State* lua_newsharedstate(lua_Alloc f, void* ud, lua_State* published)
+{
+    LUAU_ASSERT(published->global->published);
+    return newstate(f, ud, published->global);
+}
+
 void lua_close(lua_State* L)
 {
     L = L->global->mainthread; // only the main thread can be closed
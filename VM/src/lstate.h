@@ -8,6 +8,16 @@
 // registry
 #define registry(L) (&L->global->registry)
 
+// references returned by lua_ref encode the slab slot in the low bits and the slot generation in the high bits
+// the generation changes every time a slot is released, which makes stale references to a reused slot detectable
+#define LUAI_REFINDEXBITS 24
+#define LUAI_REFMAXSLOTS (1 << LUAI_REFINDEXBITS)
+#define LUAI_REFGENMASK 0x7f
+#define LUAI_REFUSED 0x80
+
+#define refindex(ref) ((ref) & (LUAI_REFMAXSLOTS - 1))
+#define refgeneration(ref) (unsigned(ref) >> LUAI_REFINDEXBITS)
+
 // extra stack space to handle TM calls and some other extras
 #define EXTRA_STACK 5
 
@@ -70,6 +80,7 @@ typedef struct CallInfo
 #define LUA_CALLINFO_RETURN (1 << 0) // should the interpreter return after returning from this callinfo? first frame must have this set
 #define LUA_CALLINFO_HANDLE (1 << 1) // should the error thrown during execution get handled by continuation from this callinfo? func must be C
 #define LUA_CALLINFO_NATIVE (1 << 2) // should this function be executed using execution callback for native code
+#define LUA_CALLINFO_DISCARD (1 << 3) // are the results of the protected call handled by this callinfo discarded by the caller? func must be C
 
 #define curr_func(L) (clvalue(L->ci->func))
 #define ci_func(ci) (clvalue((ci)->func))
@@ -87,9 +98,23 @@ struct GCStats
     size_t endtotalsizebytes = 0;
     size_t heapgoalsizebytes = 0;
 
+    // data for generational mode
+    size_t genbasesizebytes = 0; // heap size at the end of the last major collection
+    uint32_t genminorcycles = 0; // number of minor collections since the last major collection
+
+    // data for thread allocation caches
+    uint64_t alloccachehits = 0;   // number of GCO allocations served from thread allocation caches
+    uint64_t alloccachemisses = 0; // number of GCO allocations that had to refill the thread allocation cache
+
+    // data for time budget pacing
+    double workrate = 0; // GC work units performed per microsecond, measured over recent steps
+
     double starttimestamp = 0;
     double atomicstarttimestamp = 0;
     double endtimestamp = 0;
+
+    // data reported by lua_gcmetrics
+    lua_GCMetrics metrics = {};
 };
 
 #ifdef LUAI_GCMETRICS
@@ -155,6 +180,7 @@ struct lua_ExecutionCallbacks
     void (*destroy)(lua_State* L, Proto* proto); // called when function is destroyed
     int (*enter)(lua_State* L, Proto* proto);    // called when function is about to start/resume (when execdata is present), return 0 to exit VM
     void (*disable)(lua_State* L, Proto* proto); // called when function has to be switched from native to bytecode in the debugger
+    void (*enable)(lua_State* L, Proto* proto);  // called when function can be switched back to native code after its last breakpoint is removed
     size_t (*getmemorysize)(lua_State* L, Proto* proto); // called to request the size of memory associated with native part of the Proto
     uint8_t (*gettypemapping)(lua_State* L, const char* str, size_t len); // called to get the userdata type index
 };
@@ -174,6 +200,8 @@ typedef struct global_State
 
     uint8_t currentwhite;
     uint8_t gcstate; // state of garbage collector
+    uint8_t gcgen;    // generational mode is enabled, see LUA_GCGEN
+    uint8_t gcsticky; // objects that survived the last atomic phase keep their color and are treated as old by the next (minor) mark
 
 
     GCObject* gray;      // list of gray objects
@@ -186,12 +214,44 @@ typedef struct global_State
     int gcgoal;                               // see LUAI_GCGOAL
     int gcstepmul;                            // see LUAI_GCSTEPMUL
     int gcstepsize;                          // see LUAI_GCSTEPSIZE
+    int gcgenminormul;                        // see LUAI_GCGENMINORMUL
+    int gcgenmajormul;                        // see LUAI_GCGENMAJORMUL
+    int gcworkers;                            // number of workers used by parallel mark and sweep, see LUA_GCSETWORKERS
+    int alloccachesize;                       // number of blocks per size class in thread allocation caches, see LUA_GCSETALLOCCACHE
+    int gcframebudget;                        // time in microseconds that GC assists can take in a frame, see LUA_GCSETFRAMEBUDGET
+    double gcframetime;                       // time in seconds spent in GC assists in the current frame
+    size_t gcdeferred;                        // GC work in bytes that assists postponed because of the frame budget, see LUA_GCDEBT
+    int gctableshrink;                        // occupancy percentage at which live tables are shrunk during sweep, see LUA_GCSETTABLESHRINK
+    unsigned int hotthreshold;                // initial value of Proto::hotcount for new functions, see lua_sethotthreshold
+    bool typeprofiling;                       // whether new functions record observed argument types in Proto::argtypes
+    size_t allocsamplerate;                   // number of allocated bytes between allocsample callbacks, see lua_setallocsamplerate
+    size_t allocsampleleft;                   // number of bytes left to allocate before the next allocsample callback
+    int threadpoollimit;                      // maximum number of stacks in `threadpool', see LUA_GCSETTHREADPOOL
+    int threadpoolsize;                       // number of stacks in `threadpool'
+    TValue* threadpool;                       // stacks of collected threads, linked through the first slot of each stack
 
     struct lua_Page* freepages[LUA_SIZECLASSES]; // free page linked list for each size class for non-collectable objects
     struct lua_Page* freegcopages[LUA_SIZECLASSES]; // free page linked list for each size class for collectable objects
     struct lua_Page* allpages; // page linked list with all pages for all non-collectable object classes (available with LUAU_ASSERTENABLED)
     struct lua_Page* allgcopages; // page linked list with all pages for all collectable object classes
     struct lua_Page* sweepgcopage; // position of the sweep in `allgcopages'
+    void* alloccachedeferred;      // blocks from caches of freed threads that will be returned to their pages after the sweep
+
+    struct lua_MemcatLimits* memcatlimits; // limits for memory categories, see lua_setmemcatlimit
+
+    struct lua_OpcodeStats* opstats; // opcode execution counts, see lua_setopcodestats
+
+    struct lua_PackCache* packcache; // parsed formats of string.pack and string.unpack, see lstrlib.cpp
+
+    struct lua_TableShares* tableshares; // reference counts of table parts shared by copy-on-write clones, see ltable.cpp
+
+    struct global_State* sharedstate; // published state with data shared by this state, see lua_newsharedstate
+    struct Table* published;          // frozen table published by this state, see lua_publish
+
+    const struct lua_AtomTable* atomtable; // table that assigns string atoms, see lua_setatomtable
+
+    struct lua_HeapSnapshot* heapsnapshot; // heap snapshot in progress, see luaC_heapsnapshotbegin
+    struct lua_Page* heapsnapshotpage;     // next page to be visited by the heap snapshot; advanced when the page is freed
 
     size_t memcatbytes[LUA_MEMORY_CATEGORIES]; // total amount of memory used by each memory category
 
@@ -204,8 +264,13 @@ typedef struct global_State
 
     TValue pseudotemp; // storage for temporary values used in pseudo2addr
 
-    TValue registry; // registry table, used by lua_ref and LUA_REGISTRYINDEX
-    int registryfree; // next free slot in registry
+    TValue registry; // registry table, used by LUA_REGISTRYINDEX
+
+    TValue* refs;     // reference slab used by lua_ref; slot 0 is never used so that LUA_REFNIL stays invalid
+    uint8_t* refgens; // generation of each slot, with LUAI_REFUSED set while the slot holds a value
+    int refsize;      // size of refs and refgens
+    int reftop;       // first slot that was never used
+    int reffree;      // first released slot; released slots hold the index of the next one as a number, 0 terminates the list
 
     struct lua_jmpbuf* errorjmp; // jump buffer data for longjmp-style error handling
 
@@ -217,10 +282,18 @@ typedef struct global_State
     lua_ExecutionCallbacks ecb;
 
     void (*udatagc[LUA_UTAG_LIMIT])(lua_State*, void*); // for each userdata tag, a gc callback to be called immediately before freeing memory
+    void (*udatabatchgc[LUA_UTAG_LIMIT])(lua_State*, void**, int); // for each userdata tag, a gc callback that receives dead data in batches
     Table* udatamt[LUA_LUTAG_LIMIT]; // metatables for tagged userdata
 
+    lua_HostBuiltin hostbuiltins[LUA_HOSTBUILTIN_LIMIT]; // fast paths of host functions, see lua_sethostbuiltin
+
     TString* lightuserdataname[LUA_LUTAG_LIMIT]; // names for tagged lightuserdata
 
+    // placed after the fields that native code reads, since A64 loads can only reach the first 8KB of the structure
+    lua_StackStats memcatstackstats[LUA_MEMORY_CATEGORIES]; // stack growth of threads in each memory category, see lua_getstackstats
+
+    const lua_UserdataOps* udataops[LUA_UTAG_LIMIT]; // native operators for tagged userdata, see lua_setuserdataops
+
     GCStats gcstats;
 
 #ifdef LUAI_GCMETRICS
@@ -265,6 +338,8 @@ struct lua_State
 
     int cachedslot;    // when table operations or INDEX/NEWINDEX is invoked from Luau, what is the expected slot for lookup?
 
+    int interruptbudget; // safepoints left before the interrupt callback is called, see lua_setinterruptbudget
+
 
     Table* gt;           // table of globals
     UpVal* openupval;    // list of open upvalues in this stack
@@ -272,6 +347,8 @@ struct lua_State
 
     TString* namecall; // when invoked from Luau using NAMECALL, what method do we need to invoke?
 
+    struct lua_AllocCache* alloccache; // cache of free GCO blocks, see LUA_GCSETALLOCCACHE
+
     void* userdata;
 };
 // clang-format on
@@ -307,3 +384,4 @@ union GCObject
 
 LUAI_FUNC lua_State* luaE_newthread(lua_State* L);
 LUAI_FUNC void luaE_freethread(lua_State* L, lua_State* L1, struct lua_Page* page);
+LUAI_FUNC void luaE_trimthreadpool(lua_State* L);
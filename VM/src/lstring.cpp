@@ -42,6 +42,26 @@ unsigned int luaS_hash(const char* str, size_t len)
     return h;
 }
 
+unsigned int luaS_hashlong(TString* ts)
+{
+    LUAU_ASSERT(!isshortstr(ts));
+
+    if (!ts->hashed)
+    {
+        ts->hash = luaS_hash(ts->data, ts->len);
+        ts->hashed = 1;
+    }
+
+    return ts->hash;
+}
+
+int luaS_eqlong(TString* a, TString* b)
+{
+    LUAU_ASSERT(!isshortstr(a));
+
+    return a->len == b->len && memcmp(a->data, b->data, a->len) == 0;
+}
+
 void luaS_resize(lua_State* L, int newsize)
 {
     TString** newhash = luaM_newarray(L, newsize, TString*, 0);
@@ -68,6 +88,36 @@ void luaS_resize(lua_State* L, int newsize)
     tb->hash = newhash;
 }
 
+void luaS_reserve(lua_State* L, unsigned int count)
+{
+    stringtable* tb = &L->global->strt;
+    // grow the table once up front instead of doubling it repeatedly while the strings are being created
+    int newsize = tb->size;
+    while (tb->nuse + count > cast_to(uint32_t, newsize) && newsize <= INT_MAX / 2)
+        newsize *= 2;
+    if (newsize != tb->size)
+        luaS_resize(L, newsize);
+}
+
+static TString* newlongstr(lua_State* L, const char* str, size_t l)
+{
+    if (l > MAXSSIZE)
+        luaM_toobig(L);
+
+    TString* ts = luaM_newgco(L, TString, sizestring(l), L->activememcat);
+    luaC_init(L, ts, LUA_TSTRING);
+    ts->hashed = 0;
+    ts->atom = ATOM_UNDEF;
+    ts->hash = 0; // computed in luaS_hashlong
+    ts->len = unsigned(l);
+    ts->next = NULL;
+
+    memcpy(ts->data, str, l);
+    ts->data[l] = '\0'; // ending 0
+
+    return ts;
+}
+
 static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
 {
     if (l > MAXSSIZE)
@@ -75,6 +125,7 @@ static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
 
     TString* ts = luaM_newgco(L, TString, sizestring(l), L->activememcat);
     luaC_init(L, ts, LUA_TSTRING);
+    ts->hashed = 0;
     ts->atom = ATOM_UNDEF;
     ts->hash = h;
     ts->len = unsigned(l);
@@ -94,6 +145,23 @@ static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
     return ts;
 }
 
+// short strings are interned in the published state first, so that tables shared with lua_newsharedstate can be indexed with them
+static TString* findsharedstr(global_State* g, const char* str, size_t l, unsigned int h)
+{
+    global_State* sg = g->sharedstate;
+
+    if (!sg)
+        return NULL;
+
+    for (TString* el = sg->strt.hash[lmod(h, sg->strt.size)]; el != NULL; el = el->next)
+    {
+        if (el->hash == h && el->len == l && memcmp(str, getstr(el), l) == 0)
+            return el;
+    }
+
+    return NULL;
+}
+
 TString* luaS_bufstart(lua_State* L, size_t size)
 {
     if (size > MAXSSIZE)
@@ -101,6 +169,7 @@ TString* luaS_bufstart(lua_State* L, size_t size)
 
     TString* ts = luaM_newgco(L, TString, sizestring(size), L->activememcat);
     luaC_init(L, ts, LUA_TSTRING);
+    ts->hashed = 0;
     ts->atom = ATOM_UNDEF;
     ts->hash = 0; // computed in luaS_buffinish
     ts->len = unsigned(size);
@@ -112,14 +181,28 @@ TString* luaS_bufstart(lua_State* L, size_t size)
 
 TString* luaS_buffinish(lua_State* L, TString* ts)
 {
+    if (!isshortstr(ts))
+    {
+        LUAU_ASSERT(ts->next == NULL);
+
+        ts->data[ts->len] = '\0'; // ending 0
+        ts->atom = ATOM_UNDEF;
+        return ts;
+    }
+
     unsigned int h = luaS_hash(ts->data, ts->len);
+
+    if (TString* shared = findsharedstr(L->global, ts->data, ts->len, h))
+        return shared;
+
     stringtable* tb = &L->global->strt;
     int bucket = lmod(h, tb->size);
 
     // search if we already have this string in the hash table
     for (TString* el = tb->hash[bucket]; el != NULL; el = el->next)
     {
-        if (el->len == ts->len && memcmp(el->data, ts->data, ts->len) == 0)
+        // comparing full hashes first rejects most of the chain entries without touching string contents
+        if (el->hash == h && el->len == ts->len && memcmp(el->data, ts->data, ts->len) == 0)
         {
             // string may be dead
             if (isdead(L->global, obj2gco(el)))
@@ -146,10 +229,23 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
 
 TString* luaS_newlstr(lua_State* L, const char* str, size_t l)
 {
-    unsigned int h = luaS_hash(str, l);
+    if (l > LUAI_MAXSHORTLEN)
+        return newlongstr(L, str, l);
+
+    return luaS_newshortstr(L, str, l, luaS_hash(str, l));
+}
+
+TString* luaS_newshortstr(lua_State* L, const char* str, size_t l, unsigned int h)
+{
+    LUAU_ASSERT(l <= LUAI_MAXSHORTLEN && h == luaS_hash(str, l));
+
+    if (TString* shared = findsharedstr(L->global, str, l, h))
+        return shared;
+
     for (TString* el = L->global->strt.hash[lmod(h, L->global->strt.size)]; el != NULL; el = el->next)
     {
-        if (el->len == l && (memcmp(str, getstr(el), l) == 0))
+        // comparing full hashes first rejects most of the chain entries without touching string contents
+        if (el->hash == h && el->len == l && (memcmp(str, getstr(el), l) == 0))
         {
             // string may be dead
             if (isdead(L->global, obj2gco(el)))
@@ -160,6 +256,13 @@ TString* luaS_newlstr(lua_State* L, const char* str, size_t l)
     return newlstr(L, str, l, h); // not found
 }
 
+void luaS_fix(TString* ts)
+{
+    // strings of a published state are already fixed, and they can't be written to since they are read by other threads
+    if (!isfixed(obj2gco(ts)))
+        l_setbit(ts->marked, FIXEDBIT);
+}
+
 static bool unlinkstr(lua_State* L, TString* ts)
 {
     global_State* g = L->global;
@@ -184,10 +287,115 @@ static bool unlinkstr(lua_State* L, TString* ts)
 
 void luaS_free(lua_State* L, TString* ts, lua_Page* page)
 {
-    if (unlinkstr(L, ts))
+    if (isshortstr(ts) && unlinkstr(L, ts))
         L->global->strt.nuse--;
     else
-        LUAU_ASSERT(ts->next == NULL); // orphaned string buffer
+        LUAU_ASSERT(ts->next == NULL); // long string or orphaned string buffer
 
     luaM_freegco(L, ts, sizestring(ts->len), ts->memcat, page);
 }
+
+struct AtomSlot
+{
+    const char* name; // NULL for empty slots
+    unsigned int len;
+    unsigned int hash;
+    int16_t atom;
+};
+
+struct lua_AtomTable
+{
+    lua_Alloc frealloc;
+    void* ud;
+    size_t size; // size of the allocation that holds the table, the slots and the names
+
+    unsigned int mask;
+    AtomSlot slots[1];
+};
+
+// slots are looked up with the hash that every string already carries, so finding the atom of a string doesn't need to hash it again
+lua_AtomTable* lua_newatomtable(lua_Alloc f, void* ud, const char* const* names, int count)
+{
+    LUAU_ASSERT(unsigned(count) <= 32768); // atoms are 16-bit integers
+
+    // at most half of the slots are used to keep the probe sequences short
+    unsigned int slots = 1;
+    while (slots < unsigned(count) * 2)
+        slots *= 2;
+
+    size_t size = offsetof(lua_AtomTable, slots) + sizeof(AtomSlot) * slots;
+    for (int i = 0; i < count; ++i)
+        size += strlen(names[i]) + 1;
+
+    lua_AtomTable* t = (lua_AtomTable*)f(ud, NULL, 0, size);
+    if (!t)
+        return NULL;
+
+    t->frealloc = f;
+    t->ud = ud;
+    t->size = size;
+    t->mask = slots - 1;
+
+    for (unsigned int i = 0; i < slots; ++i)
+        t->slots[i].name = NULL;
+
+    char* data = (char*)&t->slots[slots];
+
+    for (int i = 0; i < count; ++i)
+    {
+        size_t len = strlen(names[i]);
+        unsigned int h = luaS_hash(names[i], len);
+        unsigned int pos = h & t->mask;
+
+        while (t->slots[pos].name && !(t->slots[pos].hash == h && t->slots[pos].len == len && memcmp(t->slots[pos].name, names[i], len) == 0))
+            pos = (pos + 1) & t->mask;
+
+        // duplicate names keep the first atom
+        if (t->slots[pos].name)
+            continue;
+
+        memcpy(data, names[i], len + 1);
+
+        t->slots[pos].name = data;
+        t->slots[pos].len = unsigned(len);
+        t->slots[pos].hash = h;
+        t->slots[pos].atom = int16_t(i);
+
+        data += len + 1;
+    }
+
+    return t;
+}
+
+void lua_freeatomtable(lua_AtomTable* t)
+{
+    t->frealloc(t->ud, t, t->size, 0);
+}
+
+static int16_t findatom(const lua_AtomTable* t, TString* ts)
+{
+    unsigned int h = luaS_gethash(ts);
+
+    for (unsigned int pos = h & t->mask; const char* name = t->slots[pos].name; pos = (pos + 1) & t->mask)
+    {
+        const AtomSlot& slot = t->slots[pos];
+
+        if (slot.hash == h && slot.len == ts->len && memcmp(name, ts->data, ts->len) == 0)
+            return slot.atom;
+    }
+
+    return -1;
+}
+
+int16_t luaS_getatom(global_State* g, TString* ts)
+{
+    if (ts->atom == ATOM_UNDEF)
+    {
+        if (g->atomtable)
+            ts->atom = findatom(g->atomtable, ts);
+        else
+            ts->atom = g->cb.useratom ? g->cb.useratom(ts->data, ts->len) : -1;
+    }
+
+    return ts->atom;
+}
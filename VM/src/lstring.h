@@ -16,14 +16,30 @@
 #define luaS_new(L, s) (luaS_newlstr(L, s, strlen(s)))
 #define luaS_newliteral(L, s) (luaS_newlstr(L, "" s, (sizeof(s) / sizeof(char)) - 1))
 
-#define luaS_fix(s) l_setbit((s)->marked, FIXEDBIT)
+// long strings are not interned, so two long strings with the same contents can be different objects
+#define isshortstr(ts) ((ts)->len <= LUAI_MAXSHORTLEN)
+
+#define luaS_gethash(ts) (isshortstr(ts) || (ts)->hashed ? (ts)->hash : luaS_hashlong(ts))
+#define luaS_eqstr(a, b) ((a) == (b) || (!isshortstr(a) && luaS_eqlong(a, b)))
 
 LUAI_FUNC unsigned int luaS_hash(const char* str, size_t len);
+LUAI_FUNC unsigned int luaS_hashlong(TString* ts);
+LUAI_FUNC int luaS_eqlong(TString* a, TString* b);
 
 LUAI_FUNC void luaS_resize(lua_State* L, int newsize);
+LUAI_FUNC void luaS_reserve(lua_State* L, unsigned int count);
 
 LUAI_FUNC TString* luaS_newlstr(lua_State* L, const char* str, size_t l);
+// interns a short string with a known hash, like the hash of the same string in another state
+LUAI_FUNC TString* luaS_newshortstr(lua_State* L, const char* str, size_t l, unsigned int h);
+LUAI_FUNC void luaS_fix(TString* ts);
 LUAI_FUNC void luaS_free(lua_State* L, TString* ts, struct lua_Page* page);
 
+// returns the atom of the string, assigning it from the atom table or the useratom callback on first use
+LUAI_FUNC int16_t luaS_getatom(global_State* g, TString* ts);
+
 LUAI_FUNC TString* luaS_bufstart(lua_State* L, size_t size);
 LUAI_FUNC TString* luaS_buffinish(lua_State* L, TString* ts);
+
+// implemented in lstrlib.cpp next to string.pack
+LUAI_FUNC void luaS_freepackcache(lua_State* L);
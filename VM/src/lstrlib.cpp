@@ -3,10 +3,13 @@
 #include "lualib.h"
 
 #include "lstring.h"
+#include "lapi.h"
+#include "lmem.h"
 
 #include <ctype.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 // macro to `unsign' a character
 #define uchar(c) ((unsigned char)(c))
@@ -645,6 +648,41 @@ static int nospecials(const char* p, size_t l)
     return 1; // no special chars found
 }
 
+// returns the first item of the pattern if every match must start with a character that this item matches, NULL otherwise
+static const char* firstclass(MatchState* ms, const char* p)
+{
+    // captures don't consume characters
+    while (p < ms->p_end && *p == '(')
+        p += (p + 1 < ms->p_end && *(p + 1) == ')') ? 2 : 1;
+
+    if (p == ms->p_end || *p == ')' || *p == '.' || (*p == '$' && p + 1 == ms->p_end))
+        return NULL;
+
+    if (*p == L_ESC && (*(p + 1) == 'b' || *(p + 1) == 'f' || isdigit(uchar(*(p + 1)))))
+        return NULL;
+
+    const char* ep = classend(ms, p);
+    if (*ep == '*' || *ep == '?' || *ep == '-')
+        return NULL;
+
+    return p;
+}
+
+// skips the characters that can't start a match of a pattern that begins with the item 'p'; returns src_end if none can
+static const char* skipclass(MatchState* ms, const char* s, const char* p)
+{
+    if (*p != L_ESC && *p != '[')
+    {
+        const char* res = (const char*)memchr(s, *p, ms->src_end - s);
+        return res ? res : ms->src_end;
+    }
+
+    const char* ep = classend(ms, p);
+    while (s < ms->src_end && !singlematch(ms, s, p, ep))
+        s++;
+    return s;
+}
+
 static void prepstate(MatchState* ms, lua_State* L, const char* s, size_t ls, const char* p, size_t lp)
 {
     ms->L = L;
@@ -696,9 +734,12 @@ static int str_find_aux(lua_State* L, int find)
             lp--; // skip anchor character
         }
         prepstate(&ms, L, s, ls, p, lp);
+        const char* first = anchor ? NULL : firstclass(&ms, p);
         do
         {
             const char* res;
+            if (first && (s1 = skipclass(&ms, s1, first)) == ms.src_end)
+                break;
             reprepstate(&ms);
             if ((res = match(&ms, s1, p)) != NULL)
             {
@@ -735,9 +776,13 @@ static int gmatch_aux(lua_State* L)
     const char* p = lua_tolstring(L, lua_upvalueindex(2), &lp);
     const char* src;
     prepstate(&ms, L, s, ls, p, lp);
-    for (src = s + (size_t)lua_tointeger(L, lua_upvalueindex(3)); src <= ms.src_end; src++)
+    src = s + (size_t)lua_tointeger(L, lua_upvalueindex(3));
+    const char* first = src <= ms.src_end ? firstclass(&ms, p) : NULL;
+    for (; src <= ms.src_end; src++)
     {
         const char* e;
+        if (first && (src = skipclass(&ms, src, first)) == ms.src_end)
+            break;
         reprepstate(&ms);
         if ((e = match(&ms, src, p)) != NULL)
         {
@@ -847,9 +892,19 @@ static int str_gsub(lua_State* L)
         lp--; // skip anchor character
     }
     prepstate(&ms, L, src, srcl, p, lp);
+    const char* first = (anchor || n >= max_s) ? NULL : firstclass(&ms, p);
     while (n < max_s)
     {
         const char* e;
+        if (first)
+        {
+            // copy the characters that can't start a match in one go
+            const char* next = skipclass(&ms, src, first);
+            luaL_addlstring(&b, src, next - src);
+            src = next;
+            if (src == ms.src_end)
+                break;
+        }
         reprepstate(&ms);
         e = match(&ms, src, p);
         if (e)
@@ -963,6 +1018,27 @@ static void addInt64Format(char form[MAX_FORMAT], char formatIndicator, size_t f
     form[formatItemSize + 3] = 0;
 }
 
+// formats a signed integer without going through snprintf; used for format items without flags, width or precision
+static void addinteger(luaL_Strbuf* b, long long value)
+{
+    char buff[32];
+    char* end = buff + sizeof(buff);
+    char* p = end;
+
+    unsigned long long v = value < 0 ? 0ull - (unsigned long long)value : (unsigned long long)value;
+
+    do
+    {
+        *--p = char('0' + v % 10);
+        v /= 10;
+    } while (v);
+
+    if (value < 0)
+        *--p = '-';
+
+    luaL_addlstring(b, p, end - p);
+}
+
 static int str_format(lua_State* L)
 {
     int top = lua_gettop(L);
@@ -975,7 +1051,15 @@ static int str_format(lua_State* L)
     while (strfrmt < strfrmt_end)
     {
         if (*strfrmt != L_ESC)
-            luaL_addchar(&b, *strfrmt++);
+        {
+            // copy the literal text up to the next format item in one go
+            const char* next = (const char*)memchr(strfrmt, L_ESC, strfrmt_end - strfrmt);
+            if (!next)
+                next = strfrmt_end;
+
+            luaL_addlstring(&b, strfrmt, next - strfrmt);
+            strfrmt = next;
+        }
         else if (*++strfrmt == L_ESC)
             luaL_addchar(&b, *strfrmt++); // %%
         else if (*strfrmt == '*')
@@ -992,6 +1076,28 @@ static int str_format(lua_State* L)
             char buff[MAX_ITEM];   // to store the formatted item
             if (++arg > top)
                 luaL_error(L, "missing argument #%d", arg);
+
+            // fast paths for plain format items, which don't need a format specification
+            if (*strfrmt == 'd' || *strfrmt == 'i')
+            {
+                strfrmt++;
+                addinteger(&b, (long long)luaL_checknumber(L, arg));
+                continue;
+            }
+            else if (*strfrmt == 'f')
+            {
+                double v = luaL_checknumber(L, arg);
+
+                // integers below 2^53 are formatted exactly, with all six fractional digits being zero
+                if (fabs(v) < 9007199254740992.0 && v == double((long long)v) && !(v == 0 && signbit(v)))
+                {
+                    strfrmt++;
+                    addinteger(&b, (long long)v);
+                    luaL_addlstring(&b, ".000000", 7);
+                    continue;
+                }
+            }
+
             size_t formatItemSize = 0;
             strfrmt = scanformat(L, strfrmt, form, &formatItemSize);
             char formatIndicator = *strfrmt++;
@@ -1082,36 +1188,31 @@ static int str_split(lua_State* L)
     lua_createtable(L, 0, 0);
 
     if (needleLen == 0)
-        begin++;
-
-    // Don't iterate the last needleLen - 1 bytes of the string - they are
-    // impossible to be splits and would let us memcmp past the end of the
-    // buffer.
-    for (const char* iter = begin; iter <= end - needleLen; iter++)
     {
-        // Use of memcmp here instead of strncmp is so that we allow embedded
-        // nulls to be used in either of the haystack or the needle strings.
-        // Most Lua string APIs allow embedded nulls, and this should be no
-        // exception.
-        if (memcmp(iter, needle, needleLen) == 0)
+        // an empty separator splits the string into individual characters
+        for (const char* iter = begin + 1; iter <= end; iter++)
         {
-            lua_pushinteger(L, ++numMatches);
             lua_pushlstring(L, spanStart, iter - spanStart);
-            lua_settable(L, -3);
+            lua_rawseti(L, -2, ++numMatches);
 
-            spanStart = iter + needleLen;
-            if (needleLen > 0)
-                iter += needleLen - 1;
+            spanStart = iter;
         }
+
+        return 1;
     }
 
-    if (needleLen > 0)
+    // lmemfind uses memchr to find the first character of the separator, which is vectorized by the C library
+    while (const char* iter = lmemfind(spanStart, end - spanStart, needle, needleLen))
     {
-        lua_pushinteger(L, ++numMatches);
-        lua_pushlstring(L, spanStart, end - spanStart);
-        lua_settable(L, -3);
+        lua_pushlstring(L, spanStart, iter - spanStart);
+        lua_rawseti(L, -2, ++numMatches);
+
+        spanStart = iter + needleLen;
     }
 
+    lua_pushlstring(L, spanStart, end - spanStart);
+    lua_rawseti(L, -2, ++numMatches);
+
     return 1;
 }
 
@@ -1321,14 +1422,14 @@ static KOption getoption(Header* h, const char** fmt, int* size)
 
 /*
 ** Read, classify, and fill other details about the next option.
-** 'psize' is filled with option's size, 'notoalign' with its
-** alignment requirements.
+** 'psize' is filled with option's size, 'palign' with its
+** alignment requirements (0 when no alignment is needed).
 ** Local variable 'size' gets the size to be aligned. (Kpadal option
 ** always gets its full alignment, other options are limited by
 ** the maximum alignment ('maxalign'). Kchar option needs no alignment
 ** despite its size.
 */
-static KOption getdetails(Header* h, size_t totalsize, const char** fmt, int* psize, int* ntoalign)
+static KOption getdetails(Header* h, const char** fmt, int* psize, int* palign)
 {
     KOption opt = getoption(h, fmt, psize);
     int align = *psize; // usually, alignment follows size
@@ -1338,18 +1439,165 @@ static KOption getdetails(Header* h, size_t totalsize, const char** fmt, int* ps
             luaL_argerror(h->L, 1, "invalid next option for option 'X'");
     }
     if (align <= 1 || opt == Kchar) // need no alignment?
-        *ntoalign = 0;
+        *palign = 0;
     else
     {
         if (align > h->maxalign) // enforce maximum alignment
             align = h->maxalign;
         if ((align & (align - 1)) != 0) // is 'align' not a power of 2?
             luaL_argerror(h->L, 1, "format asks for alignment not power of 2");
-        *ntoalign = (align - (int)(totalsize & (align - 1))) & (align - 1);
+        *palign = align;
     }
     return opt;
 }
 
+/*
+** Parsed formats are kept in a small per-state cache, so that formats
+** that are used repeatedly are only parsed once. Entries are indexed by
+** the string hash and hold a copy of the format, which keeps them valid
+** after the format string is collected.
+** A descriptor is only recorded once a call with that format finishes
+** without errors, so cached formats are always valid.
+*/
+#define PACKCACHE_SIZE 16
+#define PACKCACHE_MAXLEN 32
+#define PACKCACHE_MAXITEMS 16
+
+typedef struct PackItem
+{
+    uint8_t opt;
+    uint8_t islittle;
+    uint8_t align; // 0 when no alignment is needed
+    int size;
+} PackItem;
+
+typedef struct PackFormat
+{
+    unsigned int len; // 0 for unused entries
+    char fmt[PACKCACHE_MAXLEN];
+    int count;
+    PackItem items[PACKCACHE_MAXITEMS]; // options besides Knop, which only change the header
+} PackFormat;
+
+struct lua_PackCache
+{
+    PackFormat entries[PACKCACHE_SIZE];
+};
+
+void luaS_freepackcache(lua_State* L)
+{
+    global_State* g = L->global;
+
+    if (g->packcache)
+    {
+        luaM_free_(L, g->packcache, sizeof(lua_PackCache), 0);
+        g->packcache = NULL;
+    }
+}
+
+/*
+** Reads options of a format, either from a cached descriptor or by
+** parsing the format string
+*/
+typedef struct FormatReader
+{
+    Header h;
+    const char* fmt;
+    const PackFormat* cached; // descriptor to read options from, NULL when parsing
+    int next;                 // next item of 'cached'
+    PackFormat* record;       // descriptor that parsed options are recorded to, NULL when the format isn't cached
+    unsigned int slot;        // cache entry of the format
+} FormatReader;
+
+static void initreader(lua_State* L, FormatReader* r, int arg, PackFormat* record)
+{
+    TString* ts = tsvalue(luaA_toobject(L, arg));
+
+    initheader(L, &r->h);
+    r->fmt = getstr(ts);
+    r->cached = NULL;
+    r->next = 0;
+    r->record = NULL;
+    r->slot = ts->hash % PACKCACHE_SIZE;
+
+    if (ts->len == 0 || ts->len > PACKCACHE_MAXLEN)
+        return;
+
+    if (lua_PackCache* cache = L->global->packcache)
+    {
+        const PackFormat* entry = &cache->entries[r->slot];
+
+        if (entry->len == ts->len && memcmp(entry->fmt, getstr(ts), ts->len) == 0)
+        {
+            r->cached = entry;
+            return;
+        }
+    }
+
+    record->len = ts->len;
+    memcpy(record->fmt, getstr(ts), ts->len);
+    record->count = 0;
+    r->record = record;
+}
+
+/*
+** Read the next option; 'ntoalign' is filled with the padding that
+** aligns it after 'totalsize' bytes. Returns false at the end of the format.
+*/
+static bool nextoption(FormatReader* r, size_t totalsize, KOption* opt, int* size, int* ntoalign)
+{
+    int align;
+
+    if (r->cached)
+    {
+        if (r->next == r->cached->count)
+            return false;
+
+        const PackItem* item = &r->cached->items[r->next++];
+        *opt = KOption(item->opt);
+        *size = item->size;
+        align = item->align;
+        r->h.islittle = item->islittle;
+    }
+    else
+    {
+        if (*r->fmt == '\0')
+            return false;
+
+        *opt = getdetails(&r->h, &r->fmt, size, &align);
+
+        if (r->record && *opt != Knop)
+        {
+            if (r->record->count < PACKCACHE_MAXITEMS)
+                r->record->items[r->record->count++] = {uint8_t(*opt), uint8_t(r->h.islittle), uint8_t(align), *size};
+            else
+                r->record = NULL; // too many options to cache
+        }
+    }
+
+    *ntoalign = align > 1 ? (align - (int)(totalsize & (align - 1))) & (align - 1) : 0;
+    return true;
+}
+
+/*
+** Store the descriptor recorded by a call that finished without errors
+*/
+static void cacheformat(lua_State* L, FormatReader* r)
+{
+    if (!r->record)
+        return;
+
+    global_State* g = L->global;
+
+    if (!g->packcache)
+    {
+        g->packcache = (lua_PackCache*)luaM_new_(L, sizeof(lua_PackCache), 0);
+        memset(g->packcache, 0, sizeof(lua_PackCache));
+    }
+
+    g->packcache->entries[r->slot] = *r->record;
+}
+
 /*
 ** Pack integer 'n' with 'size' bytes and 'islittle' endianness.
 ** The final 'if' handles the case when 'size' is larger than
@@ -1397,17 +1645,18 @@ static void copywithendian(volatile char* dest, volatile const char* src, int si
 static int str_pack(lua_State* L)
 {
     luaL_Strbuf b;
-    Header h;
-    const char* fmt = luaL_checkstring(L, 1); // format string
-    int arg = 1;                              // current argument to pack
-    size_t totalsize = 0;                     // accumulate total size of result
-    initheader(L, &h);
+    FormatReader r;
+    PackFormat record;
+    luaL_checkstring(L, 1); // format string
+    int arg = 1;            // current argument to pack
+    size_t totalsize = 0;   // accumulate total size of result
+    initreader(L, &r, 1, &record);
     lua_pushnil(L); // mark to separate arguments from string buffer
     luaL_buffinit(L, &b);
-    while (*fmt != '\0')
+    KOption opt;
+    int size, ntoalign;
+    while (nextoption(&r, totalsize, &opt, &size, &ntoalign))
     {
-        int size, ntoalign;
-        KOption opt = getdetails(&h, totalsize, &fmt, &size, &ntoalign);
         totalsize += ntoalign + size;
         while (ntoalign-- > 0)
             luaL_addchar(&b, LUAL_PACKPADBYTE); // fill alignment
@@ -1422,7 +1671,7 @@ static int str_pack(lua_State* L)
                 long long lim = (long long)1 << ((size * NB) - 1);
                 luaL_argcheck(L, -lim <= n && n < lim, arg, "integer overflow");
             }
-            packint(&b, n, h.islittle, size, (n < 0));
+            packint(&b, n, r.h.islittle, size, (n < 0));
             break;
         }
         case Kuint:
@@ -1430,7 +1679,7 @@ static int str_pack(lua_State* L)
             long long n = (long long)luaL_checknumber(L, arg);
             if (size < SZINT) // need overflow check?
                 luaL_argcheck(L, (unsigned long long)n < ((unsigned long long)1 << (size * NB)), arg, "unsigned overflow");
-            packint(&b, (unsigned long long)n, h.islittle, size, 0);
+            packint(&b, (unsigned long long)n, r.h.islittle, size, 0);
             break;
         }
         case Kfloat:
@@ -1445,7 +1694,7 @@ static int str_pack(lua_State* L)
             else
                 u.n = n;
             // move 'u' to final result, correcting endianness if needed
-            copywithendian(buff, u.buff, size, h.islittle);
+            copywithendian(buff, u.buff, size, r.h.islittle);
             luaL_addlstring(&b, buff, size);
             break;
         }
@@ -1464,7 +1713,7 @@ static int str_pack(lua_State* L)
             size_t len;
             const char* s = luaL_checklstring(L, arg, &len);
             luaL_argcheck(L, size >= (int)sizeof(size_t) || len < ((size_t)1 << (size * NB)), arg, "string length does not fit in given size");
-            packint(&b, len, h.islittle, size, 0); // pack length
+            packint(&b, len, r.h.islittle, size, 0); // pack length
             luaL_addlstring(&b, s, len);
             totalsize += len;
             break;
@@ -1487,25 +1736,28 @@ static int str_pack(lua_State* L)
             break;
         }
     }
+    cacheformat(L, &r);
     luaL_pushresult(&b);
     return 1;
 }
 
 static int str_packsize(lua_State* L)
 {
-    Header h;
-    const char* fmt = luaL_checkstring(L, 1); // format string
-    int totalsize = 0;                        // accumulate total size of result
-    initheader(L, &h);
-    while (*fmt != '\0')
+    FormatReader r;
+    PackFormat record;
+    luaL_checkstring(L, 1); // format string
+    int totalsize = 0;      // accumulate total size of result
+    initreader(L, &r, 1, &record);
+    KOption opt;
+    int size, ntoalign;
+    while (nextoption(&r, totalsize, &opt, &size, &ntoalign))
     {
-        int size, ntoalign;
-        KOption opt = getdetails(&h, totalsize, &fmt, &size, &ntoalign);
         luaL_argcheck(L, opt != Kstring && opt != Kzstr, 1, "variable-length format");
         size += ntoalign; // total space used by option
         luaL_argcheck(L, totalsize <= MAXSSIZE - size, 1, "format result too large");
         totalsize += size;
     }
+    cacheformat(L, &r);
     lua_pushinteger(L, totalsize);
     return 1;
 }
@@ -1550,20 +1802,22 @@ static long long unpackint(lua_State* L, const char* str, int islittle, int size
 
 static int str_unpack(lua_State* L)
 {
-    Header h;
-    const char* fmt = luaL_checkstring(L, 1);
+    FormatReader r;
+    PackFormat record;
+    luaL_checkstring(L, 1);
     size_t ld;
-    const char* data = luaL_checklstring(L, 2, &ld);
+    // buffers are read in place, so that binary data doesn't need to be copied into a string first
+    const char* data = lua_isbuffer(L, 2) ? (const char*)lua_tobuffer(L, 2, &ld) : luaL_checklstring(L, 2, &ld);
     int pos = posrelat(luaL_optinteger(L, 3, 1), ld) - 1;
     if (pos < 0)
         pos = 0;
     int n = 0; // number of results
     luaL_argcheck(L, size_t(pos) <= ld, 3, "initial position out of string");
-    initheader(L, &h);
-    while (*fmt != '\0')
+    initreader(L, &r, 1, &record);
+    KOption opt;
+    int size, ntoalign;
+    while (nextoption(&r, pos, &opt, &size, &ntoalign))
     {
-        int size, ntoalign;
-        KOption opt = getdetails(&h, pos, &fmt, &size, &ntoalign);
         luaL_argcheck(L, (size_t)ntoalign + size <= ld - pos, 2, "data string too short");
         pos += ntoalign; // skip alignment
         // stack space for item + next position
@@ -1573,13 +1827,13 @@ static int str_unpack(lua_State* L)
         {
         case Kint:
         {
-            long long res = unpackint(L, data + pos, h.islittle, size, true);
+            long long res = unpackint(L, data + pos, r.h.islittle, size, true);
             lua_pushnumber(L, (double)res);
             break;
         }
         case Kuint:
         {
-            unsigned long long res = unpackint(L, data + pos, h.islittle, size, false);
+            unsigned long long res = unpackint(L, data + pos, r.h.islittle, size, false);
             lua_pushnumber(L, (double)res);
             break;
         }
@@ -1587,7 +1841,7 @@ static int str_unpack(lua_State* L)
         {
             volatile Ftypes u;
             double num;
-            copywithendian(u.buff, data + pos, size, h.islittle);
+            copywithendian(u.buff, data + pos, size, r.h.islittle);
             if (size == sizeof(u.f))
                 num = (double)u.f;
             else if (size == sizeof(u.d))
@@ -1604,7 +1858,7 @@ static int str_unpack(lua_State* L)
         }
         case Kstring:
         {
-            size_t len = (size_t)unpackint(L, data + pos, h.islittle, size, 0);
+            size_t len = (size_t)unpackint(L, data + pos, r.h.islittle, size, 0);
             luaL_argcheck(L, len <= ld - pos - size, 2, "data string too short");
             lua_pushlstring(L, data + pos + size, len);
             pos += (int)len; // skip string
@@ -1612,8 +1866,10 @@ static int str_unpack(lua_State* L)
         }
         case Kzstr:
         {
-            size_t len = strlen(data + pos);
-            luaL_argcheck(L, pos + len < ld, 2, "unfinished string for format 'z'");
+            // buffer contents are not zero-terminated
+            const char* end = (const char*)memchr(data + pos, '\0', ld - pos);
+            luaL_argcheck(L, end, 2, "unfinished string for format 'z'");
+            size_t len = end - (data + pos);
             lua_pushlstring(L, data + pos, len);
             pos += (int)len + 1; // skip string plus final '\0'
             break;
@@ -1626,6 +1882,7 @@ static int str_unpack(lua_State* L)
         }
         pos += size;
     }
+    cacheformat(L, &r);
     lua_pushinteger(L, pos + 1); // next position
     return n + 1;
 }
@@ -26,6 +26,7 @@
 #include "ltable.h"
 
 #include "lstate.h"
+#include "lstring.h"
 #include "ldebug.h"
 #include "lgc.h"
 #include "lmem.h"
@@ -37,6 +38,10 @@
 #define MAXBITS 26
 #define MAXSIZE (1 << MAXBITS)
 
+// hash parts with at most 2^MAXSCANBITS nodes search the entire node array for a free position instead of tracking
+// `lastfree', which keeps the field available for the array boundary hint
+#define MAXSCANBITS 3
+
 static_assert(offsetof(LuaNode, val) == 0, "Unexpected Node memory layout, pointer cast in gval2slot is incorrect");
 
 // TKey is bitpacked for memory efficiency so we need to validate bit counts for worst case
@@ -55,7 +60,7 @@ const LuaNode luaH_dummynode = {
 // hash is always reduced mod 2^k
 #define hashpow2(t, n) (gnode(t, lmod((n), sizenode(t))))
 
-#define hashstr(t, str) hashpow2(t, (str)->hash)
+#define hashstr(t, str) hashpow2(t, luaS_gethash(str))
 #define hashboolean(t, p) hashpow2(t, p)
 
 static LuaNode* hashpointer(const Table* t, const void* p)
@@ -354,7 +359,7 @@ static void setnodevector(lua_State* L, Table* t, int size)
     }
     t->lsizenode = cast_byte(lsize);
     t->nodemask8 = cast_byte((1 << lsize) - 1);
-    t->lastfree = size; // all positions are free
+    t->lastfree = lsize > MAXSCANBITS ? size : 0; // all positions are free
 }
 
 static TValue* newkey(lua_State* L, Table* t, const TValue* key);
@@ -375,6 +380,7 @@ static TValue* arrayornewkey(lua_State* L, Table* t, const TValue* key)
 
 static void resize(lua_State* L, Table* t, int nasize, int nhsize)
 {
+    LUAU_ASSERT(!isshared(t));
     if (nasize > MAXSIZE || nhsize > MAXSIZE)
         luaG_runerror(L, "table overflow");
     int oldasize = t->sizearray;
@@ -487,6 +493,49 @@ static void rehash(lua_State* L, Table* t, const TValue* ek)
     resize(L, t, nasize, nh);
 }
 
+// tables with fewer slots than this are never shrunk because counting the elements costs more than it can save
+#define MINSHRINKSLOTS 64
+
+bool luaH_shrink(lua_State* L, Table* t, int occupancy)
+{
+    // shared parts can't be resized in place and copying them would defeat the purpose of shrinking
+    if (isshared(t))
+        return false;
+
+    int nodesize = (t->node == dummynode) ? 0 : sizenode(t);
+    int slots = t->sizearray + nodesize;
+
+    if (slots < MINSHRINKSLOTS)
+        return false;
+
+    int nums[MAXBITS + 1]; // nums[i] = number of keys between 2^(i-1) and 2^i
+    for (int i = 0; i <= MAXBITS; i++)
+        nums[i] = 0;                          // reset counts
+    int nasize = numusearray(t, nums);        // count keys in array part
+    int totaluse = nasize;                    // all those keys are integer keys
+    totaluse += numusehash(t, nums, &nasize); // count keys in hash part
+
+    // note: slots can be large enough for the product to overflow int
+    if (double(totaluse) * 100 > double(slots) * occupancy)
+        return false;
+
+    // compute new sizes the same way rehash does, but without an extra key
+    int na = computesizes(nums, &nasize);
+    int nh = totaluse - na;
+
+    int nadjusted = adjustasize(t, nasize, NULL);
+    nh -= nadjusted - nasize;
+
+    // a hash part that would be smaller after the resize can still have the same size class
+    bool smaller = nadjusted < t->sizearray || (nh > 0 ? ceillog2(nh) : -1) < (nodesize > 0 ? t->lsizenode : -1);
+
+    if (!smaller)
+        return false;
+
+    resize(L, t, nadjusted, nh);
+    return true;
+}
+
 /*
 ** }=============================================================
 */
@@ -512,17 +561,36 @@ Table* luaH_new(lua_State* L, int narray, int nhash)
     return t;
 }
 
+static bool releasepart(lua_State* L, const void* part);
+
 void luaH_free(lua_State* L, Table* t, lua_Page* page)
 {
-    if (t->node != dummynode)
+    // parts that are still used by other tables are left to them
+    bool shared = isshared(t) != 0;
+
+    if (t->node != dummynode && !(shared && releasepart(L, t->node)))
         luaM_freearray(L, t->node, sizenode(t), LuaNode, t->memcat);
-    if (t->array)
+    if (t->array && !(shared && releasepart(L, t->array)))
         luaM_freearray(L, t->array, t->sizearray, TValue, t->memcat);
     luaM_freegco(L, t, sizeof(Table), t->memcat, page);
 }
 
 static LuaNode* getfreepos(Table* t)
 {
+    if (t->lsizenode <= MAXSCANBITS)
+    {
+        if (t->node == dummynode)
+            return NULL;
+
+        for (int i = sizenode(t) - 1; i >= 0; i--)
+        {
+            LuaNode* n = gnode(t, i);
+            if (ttisnil(gkey(n)))
+                return n;
+        }
+        return NULL; // could not find a free place
+    }
+
     while (t->lastfree > 0)
     {
         t->lastfree--;
@@ -632,7 +700,7 @@ const TValue* luaH_getstr(Table* t, TString* key)
     LuaNode* n = hashstr(t, key);
     for (;;)
     { // check whether `key' is somewhere in the chain
-        if (ttisstring(gkey(n)) && tsvalue(gkey(n)) == key)
+        if (ttisstring(gkey(n)) && luaS_eqstr(key, tsvalue(gkey(n))))
             return gval(n); // that's it
         if (gnext(n) == 0)
             break;
@@ -830,6 +898,275 @@ Table* luaH_clone(lua_State* L, Table* tt)
     return t;
 }
 
+/*
+** {=============================================================
+** Copy-on-write clones
+** ==============================================================
+*/
+
+/*
+ * Clones created by luaH_cloneshared use the array and hash parts of the source table until either table is modified. Tables that may
+ * share a part have TABLE_SHARED set in 'readonly', so every write path reaches luaH_makewritable, which copies the shared parts first.
+ * The number of tables that use each shared part is kept in a global hash map keyed by the part pointer; a part without an entry is
+ * owned by its table. Parts of frozen tables are pinned instead of counted: frozen tables can be used by other states, so their header
+ * is never modified, and since they are never freed before the state is closed, clones never free the pinned parts either.
+ */
+struct TableShare
+{
+    const void* part; // array or node vector; NULL for empty entries
+    int refs;         // number of tables with TABLE_SHARED that use the part
+    bool pinned;      // part belongs to a frozen table that isn't counted in refs
+};
+
+struct lua_TableShares
+{
+    TableShare* entries;
+    int size; // power of 2, at least twice the count
+    int count;
+};
+
+#define MINSHARESIZE 16
+
+static unsigned int sharehash(const void* part)
+{
+    unsigned int h = unsigned(uintptr_t(part) >> 4);
+    return h ^ (h >> 13);
+}
+
+static TableShare* findshare(global_State* g, const void* part)
+{
+    lua_TableShares* shares = g->tableshares;
+    if (!shares || shares->count == 0)
+        return NULL;
+
+    unsigned int mask = shares->size - 1;
+
+    for (unsigned int i = sharehash(part) & mask;; i = (i + 1) & mask)
+    {
+        TableShare* e = &shares->entries[i];
+
+        if (e->part == part)
+            return e;
+        if (!e->part)
+            return NULL;
+    }
+}
+
+static TableShare* insertshare(lua_TableShares* shares, const void* part)
+{
+    unsigned int mask = shares->size - 1;
+    unsigned int i = sharehash(part) & mask;
+
+    while (shares->entries[i].part)
+        i = (i + 1) & mask;
+
+    TableShare* e = &shares->entries[i];
+    e->part = part;
+    e->refs = 0;
+    e->pinned = false;
+    shares->count++;
+    return e;
+}
+
+// makes sure that 'extra' entries can be inserted without allocating
+static void reserveshares(lua_State* L, int extra)
+{
+    global_State* g = L->global;
+
+    if (!g->tableshares)
+    {
+        lua_TableShares* shares = (lua_TableShares*)luaM_new_(L, sizeof(lua_TableShares), 0);
+        shares->entries = NULL;
+        shares->size = 0;
+        shares->count = 0;
+        g->tableshares = shares;
+    }
+
+    lua_TableShares* shares = g->tableshares;
+
+    if ((shares->count + extra) * 2 <= shares->size)
+        return;
+
+    int newsize = shares->size ? shares->size : MINSHARESIZE;
+    while ((shares->count + extra) * 2 > newsize)
+        newsize *= 2;
+
+    TableShare* entries = luaM_newarray(L, newsize, TableShare, 0);
+    memset(entries, 0, newsize * sizeof(TableShare));
+
+    TableShare* oldentries = shares->entries;
+    int oldsize = shares->size;
+
+    shares->entries = entries;
+    shares->size = newsize;
+    shares->count = 0;
+
+    for (int i = 0; i < oldsize; ++i)
+        if (oldentries[i].part)
+            *insertshare(shares, oldentries[i].part) = oldentries[i];
+
+    if (oldentries)
+        luaM_freearray(L, oldentries, oldsize, TableShare, 0);
+}
+
+static void removeshare(lua_TableShares* shares, TableShare* e)
+{
+    unsigned int mask = shares->size - 1;
+    unsigned int hole = unsigned(e - shares->entries);
+
+    // backward shift deletion: entries after the hole move into it unless that would put them before their home position
+    for (unsigned int i = (hole + 1) & mask; shares->entries[i].part; i = (i + 1) & mask)
+    {
+        unsigned int home = sharehash(shares->entries[i].part) & mask;
+
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            shares->entries[hole] = shares->entries[i];
+            hole = i;
+        }
+    }
+
+    shares->entries[hole].part = NULL;
+    shares->count--;
+}
+
+// drops the reference of a table to the part; returns true if the part is still used by other tables
+static bool releasepart(lua_State* L, const void* part)
+{
+    global_State* g = L->global;
+    TableShare* e = findshare(g, part);
+
+    if (!e)
+        return false;
+
+    e->refs--;
+
+    // the last remaining table becomes the owner of the part, unless the part is pinned
+    if (e->refs == 0 || (e->refs == 1 && !e->pinned))
+        removeshare(g->tableshares, e);
+
+    return true;
+}
+
+static void sharepart(Table* tt, TableShare* e)
+{
+    if (e->refs == 0 && !e->pinned)
+    {
+        // a new entry: the source is counted, unless it's frozen
+        if (isfrozen(obj2gco(tt)))
+        {
+            e->pinned = true;
+        }
+        else
+        {
+            e->refs++;
+            tt->readonly |= TABLE_SHARED;
+        }
+    }
+
+    e->refs++;
+}
+
+Table* luaH_cloneshared(lua_State* L, Table* tt)
+{
+    bool frozen = isfrozen(obj2gco(tt));
+
+    // empty tables have nothing to share, and parts in other memory categories would be released with the wrong category
+    if ((!tt->array && tt->node == dummynode) || (!frozen && tt->memcat != L->activememcat))
+        return luaH_clone(L, tt);
+
+    // entries are reserved first so that an allocation failure can't leave a part half-shared
+    reserveshares(L, 2);
+
+    Table* t = luaM_newgco(L, Table, sizeof(Table), L->activememcat);
+    luaC_init(L, t, LUA_TTABLE);
+    t->metatable = tt->metatable;
+    t->tmcache = tt->tmcache;
+    t->readonly = TABLE_SHARED;
+    t->safeenv = 0;
+
+    global_State* g = L->global;
+
+    if (tt->array)
+    {
+        TableShare* e = findshare(g, tt->array);
+        sharepart(tt, e ? e : insertshare(g->tableshares, tt->array));
+    }
+
+    if (tt->node != dummynode)
+    {
+        TableShare* e = findshare(g, tt->node);
+        sharepart(tt, e ? e : insertshare(g->tableshares, tt->node));
+    }
+
+    t->array = tt->array;
+    t->sizearray = tt->sizearray;
+    t->node = tt->node;
+    t->lsizenode = tt->lsizenode;
+    t->nodemask8 = tt->nodemask8;
+    t->lastfree = tt->lastfree; // also copies aboundary
+
+    return t;
+}
+
+void luaH_unshare(lua_State* L, Table* t)
+{
+    LUAU_ASSERT(isshared(t));
+    global_State* g = L->global;
+
+    // each part is copied before its reference is released, so that an allocation failure leaves the table in a consistent state
+    if (t->array && findshare(g, t->array))
+    {
+        TValue* array = luaM_newarray(L, t->sizearray, TValue, t->memcat);
+        memcpy(array, t->array, t->sizearray * sizeof(TValue));
+
+        bool released = releasepart(L, t->array);
+        LUAU_ASSERT(released);
+        t->array = array;
+    }
+
+    if (t->node != dummynode && findshare(g, t->node))
+    {
+        LuaNode* node = luaM_newarray(L, sizenode(t), LuaNode, t->memcat);
+        memcpy(node, t->node, sizenode(t) * sizeof(LuaNode));
+
+        bool released = releasepart(L, t->node);
+        LUAU_ASSERT(released);
+        t->node = node;
+    }
+
+    t->readonly &= ~TABLE_SHARED;
+}
+
+void luaH_makewritable(lua_State* L, Table* t)
+{
+    if (isreadonly(t))
+        luaG_readonlyerror(L);
+
+    if (isshared(t))
+        luaH_unshare(L, t);
+}
+
+void luaH_freeshares(lua_State* L)
+{
+    global_State* g = L->global;
+
+    if (lua_TableShares* shares = g->tableshares)
+    {
+        LUAU_ASSERT(shares->count == 0);
+
+        if (shares->entries)
+            luaM_freearray(L, shares->entries, shares->size, TableShare, 0);
+
+        luaM_free_(L, shares, sizeof(lua_TableShares), 0);
+        g->tableshares = NULL;
+    }
+}
+
+/*
+** }=============================================================
+*/
+
 void luaH_clear(Table* tt)
 {
     // clear array part
@@ -844,7 +1181,7 @@ void luaH_clear(Table* tt)
     if (tt->node != dummynode)
     {
         int size = sizenode(tt);
-        tt->lastfree = size;
+        tt->lastfree = tt->lsizenode > MAXSCANBITS ? size : 0;
         for (int i = 0; i < size; ++i)
         {
             LuaNode* n = gnode(tt, i);
@@ -14,6 +14,13 @@
 // reset cache of absent metamethods, cache is updated in luaT_gettm
 #define invalidateTMcache(t) t->tmcache = 0
 
+// bits of Table::readonly; fast paths only check that the field is zero, and writes to tables with any bit set go through luaH_makewritable
+#define TABLE_READONLY 1 // table can't be modified (table.freeze, lua_setreadonly)
+#define TABLE_SHARED 2   // array and hash parts are shared with other tables and are copied on the first write, see luaH_cloneshared
+
+#define isreadonly(t) ((t)->readonly & TABLE_READONLY)
+#define isshared(t) ((t)->readonly & TABLE_SHARED)
+
 LUAI_FUNC const TValue* luaH_getnum(Table* t, int key);
 LUAI_FUNC TValue* luaH_setnum(lua_State* L, Table* t, int key);
 LUAI_FUNC const TValue* luaH_getstr(Table* t, TString* key);
@@ -24,10 +31,15 @@ LUAI_FUNC TValue* luaH_newkey(lua_State* L, Table* t, const TValue* key);
 LUAI_FUNC Table* luaH_new(lua_State* L, int narray, int lnhash);
 LUAI_FUNC void luaH_resizearray(lua_State* L, Table* t, int nasize);
 LUAI_FUNC void luaH_resizehash(lua_State* L, Table* t, int nhsize);
+LUAI_FUNC bool luaH_shrink(lua_State* L, Table* t, int occupancy);
 LUAI_FUNC void luaH_free(lua_State* L, Table* t, struct lua_Page* page);
 LUAI_FUNC int luaH_next(lua_State* L, Table* t, StkId key);
 LUAI_FUNC int luaH_getn(Table* t);
 LUAI_FUNC Table* luaH_clone(lua_State* L, Table* tt);
+LUAI_FUNC Table* luaH_cloneshared(lua_State* L, Table* tt);
+LUAI_FUNC void luaH_unshare(lua_State* L, Table* t);
+LUAI_FUNC void luaH_makewritable(lua_State* L, Table* t);
+LUAI_FUNC void luaH_freeshares(lua_State* L);
 LUAI_FUNC void luaH_clear(Table* tt);
 
 #define luaH_setslot(L, t, slot, key) (invalidateTMcache(t), (slot == luaO_nilobject ? luaH_newkey(L, t, key) : cast_to(TValue*, slot)))
@@ -11,6 +11,8 @@
 #include "ldebug.h"
 #include "lvm.h"
 
+#include <string.h>
+
 static int foreachi(lua_State* L)
 {
     luaL_checktype(L, 1, LUA_TTABLE);
@@ -91,7 +93,7 @@ static void moveelements(lua_State* L, int srct, int dstt, int f, int e, int t)
     Table* dst = hvalue(L->base + (dstt - 1));
 
     if (dst->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, dst);
 
     int n = e - f + 1; // number of elements to move
 
@@ -216,7 +218,7 @@ static int tmove(lua_State* L)
         Table* dst = hvalue(L->base + (tt - 1));
 
         if (dst->readonly) // also checked in moveelements, but this blocks resizes of r/o tables
-            luaG_readonlyerror(L);
+            luaH_makewritable(L, dst);
 
         if (t > 0 && (t - 1) <= dst->sizearray && (t - 1 + n) > dst->sizearray)
         { // grow the destination table array
@@ -245,6 +247,35 @@ static void addfield(lua_State* L, luaL_Strbuf* b, int i, Table* t)
     }
 }
 
+// computes the length of the result when all values in [i, last] are strings in the array part; returns false otherwise
+static bool concatlength(Table* t, int i, int last, size_t lsep, size_t* result)
+{
+    if (i < 1 || last > t->sizearray)
+        return false;
+
+    if (lsep != 0 && size_t(last - i) > MAXSSIZE / lsep)
+        return false;
+
+    size_t total = size_t(last - i) * lsep;
+
+    for (int k = i; k <= last; k++)
+    {
+        const TValue* v = &t->array[k - 1];
+
+        if (!ttisstring(v))
+            return false;
+
+        total += tsvalue(v)->len;
+
+        // leave oversized results to the generic path
+        if (total > MAXSSIZE)
+            return false;
+    }
+
+    *result = total;
+    return true;
+}
+
 static int tconcat(lua_State* L)
 {
     size_t lsep;
@@ -255,6 +286,31 @@ static int tconcat(lua_State* L)
 
     Table* t = hvalue(L->base);
 
+    size_t total = 0;
+    if (i <= last && concatlength(t, i, last, lsep, &total))
+    {
+        // the buffer is filled exactly, so the result doesn't need to be copied again
+        luaL_Strbuf b;
+        char* p = luaL_buffinitsize(L, &b, total);
+
+        for (int k = i; k <= last; k++)
+        {
+            TString* ts = tsvalue(&t->array[k - 1]);
+
+            if (k != i && lsep != 0)
+            {
+                memcpy(p, sep, lsep);
+                p += lsep;
+            }
+
+            memcpy(p, getstr(ts), ts->len);
+            p += ts->len;
+        }
+
+        luaL_pushresultsize(&b, total);
+        return 1;
+    }
+
     luaL_Strbuf b;
     luaL_buffinit(L, &b);
     for (; i < last; i++)
@@ -474,13 +530,134 @@ static void sort_rec(lua_State* L, Table* t, int l, int u, int limit, SortPredic
     }
 }
 
+struct SortNumberLess
+{
+    bool operator()(const TValue* l, const TValue* r) const
+    {
+        return nvalue(l) < nvalue(r);
+    }
+};
+
+struct SortStringLess
+{
+    bool operator()(const TValue* l, const TValue* r) const
+    {
+        return luaV_strcmp(tsvalue(l), tsvalue(r)) < 0;
+    }
+};
+
+template<typename Less>
+static void sort_insertion(lua_State* L, TValue* arr, int l, int u, Less less)
+{
+    for (int i = l + 1; i <= u; i++)
+    {
+        TValue v;
+        setobj2s(L, &v, &arr[i]);
+
+        int j = i - 1;
+        for (; j >= l && less(&v, &arr[j]); j--)
+            setobj2t(L, &arr[j + 1], &arr[j]);
+
+        setobj2t(L, &arr[j + 1], &v);
+    }
+}
+
+// same algorithm as sort_rec, but elements are compared directly without calling into the VM so the table can't change during sorting
+template<typename Less>
+static void sort_values(lua_State* L, Table* t, int l, int u, int limit, Less less)
+{
+    TValue* arr = t->array;
+
+    // small ranges are finished with insertion sort
+    while (u - l > 16)
+    {
+        if (limit == 0)
+            return sort_heap(L, t, l, u, luaV_lessthan);
+
+        int m = l + ((u - l) >> 1);
+        if (less(&arr[u], &arr[l]))
+            sort_swap(L, t, u, l);
+        if (less(&arr[m], &arr[l]))
+            sort_swap(L, t, m, l);
+        else if (less(&arr[u], &arr[m]))
+            sort_swap(L, t, m, u);
+
+        int p = u - 1;
+        sort_swap(L, t, m, p);
+
+        // a[l] <= P == a[u-1] <= a[u] act as sentinels for the scans
+        int i = l;
+        int j = u - 1;
+        for (;;)
+        {
+            while (less(&arr[++i], &arr[p]))
+                ;
+            while (less(&arr[p], &arr[--j]))
+                ;
+            if (j < i)
+                break;
+            sort_swap(L, t, i, j);
+        }
+
+        sort_swap(L, t, p, i);
+
+        limit = (limit >> 1) + (limit >> 2);
+
+        if (i - l < u - i)
+        {
+            sort_values(L, t, l, i - 1, limit, less);
+            l = i + 1;
+        }
+        else
+        {
+            sort_values(L, t, i + 1, u, limit, less);
+            u = i - 1;
+        }
+    }
+
+    sort_insertion(L, arr, l, u, less);
+}
+
+// sorts arrays where all elements are numbers or strings using the default order; returns false if the array has other values
+static bool sort_primitive(lua_State* L, Table* t, int n)
+{
+    TValue* arr = t->array;
+
+    if (ttisnumber(&arr[0]))
+    {
+        for (int i = 0; i < n; i++)
+        {
+            // NaN makes the order inconsistent, which the generic path handles
+            if (!ttisnumber(&arr[i]) || nvalue(&arr[i]) != nvalue(&arr[i]))
+                return false;
+        }
+
+        sort_values(L, t, 0, n - 1, n, SortNumberLess());
+        return true;
+    }
+
+    if (ttisstring(&arr[0]))
+    {
+        for (int i = 0; i < n; i++)
+        {
+            if (!ttisstring(&arr[i]))
+                return false;
+        }
+
+        sort_values(L, t, 0, n - 1, n, SortStringLess());
+        return true;
+    }
+
+    return false;
+}
+
 static int tsort(lua_State* L)
 {
     luaL_checktype(L, 1, LUA_TTABLE);
     Table* t = hvalue(L->base);
     int n = luaH_getn(t);
     if (t->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, t);
 
     SortPredicate pred = luaV_lessthan;
     if (!lua_isnoneornil(L, 2)) // is there a 2nd argument?
@@ -491,7 +668,12 @@ static int tsort(lua_State* L)
     lua_settop(L, 2); // make sure there are two arguments
 
     if (n > 0)
+    {
+        if (pred == luaV_lessthan && n <= t->sizearray && sort_primitive(L, t, n))
+            return 0;
+
         sort_rec(L, t, 0, n - 1, n, pred);
+    }
     return 0;
 }
 
@@ -556,7 +738,7 @@ static int tclear(lua_State* L)
 
     Table* tt = hvalue(L->base);
     if (tt->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, tt);
 
     luaH_clear(tt);
     return 0;
@@ -587,7 +769,8 @@ static int tclone(lua_State* L)
     luaL_checktype(L, 1, LUA_TTABLE);
     luaL_argcheck(L, !luaL_getmetafield(L, 1, "__metatable"), 1, "table has a protected metatable");
 
-    Table* tt = luaH_clone(L, hvalue(L->base));
+    // the clone shares the array and hash parts with the source until either table is modified
+    Table* tt = luaH_cloneshared(L, hvalue(L->base));
 
     TValue v;
     sethvalue(L, &v, tt);
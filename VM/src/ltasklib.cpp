@@ -0,0 +1,433 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lualib.h"
+
+#include <string.h>
+
+#define TASK_SCHEDULER "_TASKS"
+
+// initial capacity of the ready queue and the timer heap; both double in size when full
+#define TASK_MINSIZE 16
+
+struct Task
+{
+    double time;  // wakeup time for timers; unused for ready tasks
+    double id;    // increasing sequence number; orders timers with equal wakeup time and identifies the live entry of a thread
+    double start; // time when the thread started waiting, used to compute the result of task.wait
+    int ref;      // registry reference to the thread that keeps it alive while it's in the queue
+    int nargs;    // number of arguments at the top of the thread stack, or -1 to resume with the elapsed wait time
+};
+
+struct Scheduler
+{
+    double now;
+    double lastid;
+
+    // thread -> id of its live entry; entries with other ids were superseded by a later call or cancelled
+    int pendingref;
+
+    // ready queue, a ring buffer stored in a buffer object
+    Task* ready;
+    int readyref;
+    int readyhead;
+    int readycount;
+    int readysize;
+
+    // timers, a binary min-heap ordered by (time, id) stored in a buffer object
+    Task* timers;
+    int timersref;
+    int timercount;
+    int timersize;
+};
+
+static Scheduler* getscheduler(lua_State* L)
+{
+    lua_getfield(L, LUA_REGISTRYINDEX, TASK_SCHEDULER);
+    Scheduler* s = (Scheduler*)lua_touserdata(L, -1);
+    lua_pop(L, 1);
+    return s; // the scheduler is anchored by the registry
+}
+
+static Task* allocqueue(lua_State* L, int* ref, int size)
+{
+    Task* data = (Task*)lua_newbuffer(L, size * sizeof(Task));
+
+    if (*ref)
+        lua_unref(L, *ref);
+    *ref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    return data;
+}
+
+static void pushready(lua_State* L, Scheduler* s, const Task& task)
+{
+    if (s->readycount == s->readysize)
+    {
+        int oldref = s->readyref;
+        s->readyref = 0; // keep the old contents alive until they are copied
+
+        int size = s->readysize ? s->readysize * 2 : TASK_MINSIZE;
+        Task* data = allocqueue(L, &s->readyref, size);
+
+        // unwrap the ring buffer so that the queue starts at the beginning of the new storage
+        int tail = s->readysize - s->readyhead;
+        if (s->readycount)
+        {
+            memcpy(data, s->ready + s->readyhead, (s->readycount < tail ? s->readycount : tail) * sizeof(Task));
+            if (s->readycount > tail)
+                memcpy(data + tail, s->ready, (s->readycount - tail) * sizeof(Task));
+        }
+
+        if (oldref)
+            lua_unref(L, oldref);
+
+        s->ready = data;
+        s->readyhead = 0;
+        s->readysize = size;
+    }
+
+    s->ready[(s->readyhead + s->readycount) % s->readysize] = task;
+    s->readycount++;
+}
+
+static Task popready(Scheduler* s)
+{
+    Task task = s->ready[s->readyhead];
+    s->readyhead = (s->readyhead + 1) % s->readysize;
+    s->readycount--;
+    return task;
+}
+
+static bool timerless(const Task& a, const Task& b)
+{
+    return a.time < b.time || (a.time == b.time && a.id < b.id);
+}
+
+static void pushtimer(lua_State* L, Scheduler* s, const Task& task)
+{
+    if (s->timercount == s->timersize)
+    {
+        int oldref = s->timersref;
+        s->timersref = 0; // keep the old contents alive until they are copied
+
+        int size = s->timersize ? s->timersize * 2 : TASK_MINSIZE;
+        Task* data = allocqueue(L, &s->timersref, size);
+
+        if (s->timercount)
+            memcpy(data, s->timers, s->timercount * sizeof(Task));
+
+        if (oldref)
+            lua_unref(L, oldref);
+
+        s->timers = data;
+        s->timersize = size;
+    }
+
+    // sift up
+    int i = s->timercount++;
+    while (i > 0 && timerless(task, s->timers[(i - 1) / 2]))
+    {
+        s->timers[i] = s->timers[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    s->timers[i] = task;
+}
+
+static Task poptimer(Scheduler* s)
+{
+    Task task = s->timers[0];
+    Task last = s->timers[--s->timercount];
+
+    // sift down
+    int i = 0;
+    for (;;)
+    {
+        int child = i * 2 + 1;
+        if (child >= s->timercount)
+            break;
+        if (child + 1 < s->timercount && timerless(s->timers[child + 1], s->timers[child]))
+            child++;
+        if (!timerless(s->timers[child], last))
+            break;
+
+        s->timers[i] = s->timers[child];
+        i = child;
+    }
+
+    if (s->timercount)
+        s->timers[i] = last;
+
+    return task;
+}
+
+// returns the id of the live entry of the thread at the top of the stack, 0 if there is none
+static double getpending(lua_State* L, Scheduler* s)
+{
+    lua_getref(L, s->pendingref);
+    lua_pushvalue(L, -2);
+    lua_rawget(L, -2);
+    double id = lua_tonumber(L, -1);
+    lua_pop(L, 2);
+    return id;
+}
+
+// updates the live entry of the thread at the top of the stack; 0 removes the thread from the scheduler
+static void setpending(lua_State* L, Scheduler* s, double id)
+{
+    lua_getref(L, s->pendingref);
+    lua_pushvalue(L, -2);
+    if (id)
+        lua_pushnumber(L, id);
+    else
+        lua_pushnil(L);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+}
+
+// schedules the thread at the top of the stack and pops it; the thread is resumed at 'time', or in the next step if it's not in the future
+static void schedule(lua_State* L, Scheduler* s, double time, int nargs)
+{
+    Task task;
+    task.time = time;
+    task.id = ++s->lastid;
+    task.start = s->now;
+    task.nargs = nargs;
+
+    setpending(L, s, task.id);
+
+    task.ref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    if (time > s->now)
+        pushtimer(L, s, task);
+    else
+        pushready(L, s, task);
+}
+
+// replaces the function or thread at index 'idx' with the thread that runs it and moves all arguments after it to that thread
+static lua_State* prepare(lua_State* L, Scheduler* s, int idx)
+{
+    int nargs = lua_gettop(L) - idx;
+    lua_State* co = NULL;
+
+    if (lua_isfunction(L, idx))
+    {
+        co = lua_newthread(L);
+        lua_pushvalue(L, idx);
+        lua_xmove(L, co, 1);
+        lua_replace(L, idx);
+    }
+    else
+    {
+        co = lua_tothread(L, idx);
+        luaL_argexpected(L, co, idx, "function or thread");
+        luaL_argcheck(L, lua_costatus(L, co) == LUA_COSUS, idx, "thread must be suspended");
+
+        // arguments for a thread that is already scheduled would be interleaved with the arguments of its live entry
+        lua_pushvalue(L, idx);
+        bool scheduled = getpending(L, s) != 0;
+        lua_pop(L, 1);
+
+        luaL_argcheck(L, nargs == 0 || !scheduled, idx, "thread is already scheduled");
+    }
+
+    if (nargs)
+    {
+        if (!lua_checkstack(co, nargs))
+            luaL_error(L, "too many arguments to resume");
+        lua_xmove(L, co, nargs);
+    }
+
+    return co;
+}
+
+static int task_spawn(lua_State* L)
+{
+    Scheduler* s = (Scheduler*)lua_touserdata(L, lua_upvalueindex(1));
+    int nargs = lua_gettop(L) - 1;
+    lua_State* co = prepare(L, s, 1);
+
+    // the thread runs now, so any earlier entry for it must not resume it again
+    lua_pushvalue(L, 1);
+    setpending(L, s, 0);
+    lua_pop(L, 1);
+
+    int status = lua_resume(co, L, nargs);
+
+    if (status != LUA_OK && status != LUA_YIELD && status != LUA_BREAK)
+    {
+        lua_xmove(co, L, 1); // move error message
+        lua_error(L);
+    }
+
+    lua_settop(co, 0); // discard results
+    return 1;
+}
+
+static int task_defer(lua_State* L)
+{
+    Scheduler* s = (Scheduler*)lua_touserdata(L, lua_upvalueindex(1));
+    int nargs = lua_gettop(L) - 1;
+    prepare(L, s, 1);
+
+    lua_pushvalue(L, 1);
+    schedule(L, s, s->now, nargs);
+    return 1;
+}
+
+static int task_delay(lua_State* L)
+{
+    Scheduler* s = (Scheduler*)lua_touserdata(L, lua_upvalueindex(1));
+    double delay = luaL_checknumber(L, 1);
+    int nargs = lua_gettop(L) - 2;
+    prepare(L, s, 2);
+
+    lua_pushvalue(L, 2);
+    schedule(L, s, s->now + delay, nargs);
+    return 1;
+}
+
+static int task_wait(lua_State* L)
+{
+    Scheduler* s = (Scheduler*)lua_touserdata(L, lua_upvalueindex(1));
+    double delay = luaL_optnumber(L, 1, 0);
+
+    // check before scheduling so that a failed wait doesn't leave an entry behind
+    if (!lua_isyieldable(L))
+        luaL_error(L, "attempt to yield across metamethod/C-call boundary");
+
+    lua_pushthread(L);
+    schedule(L, s, s->now + delay, -1);
+    return lua_yield(L, 0);
+}
+
+static int task_cancel(lua_State* L)
+{
+    Scheduler* s = (Scheduler*)lua_touserdata(L, lua_upvalueindex(1));
+    lua_State* co = lua_tothread(L, 1);
+    luaL_argexpected(L, co, 1, "thread");
+
+    int status = lua_costatus(L, co);
+    if (status != LUA_COFIN && status != LUA_COERR && status != LUA_COSUS)
+        luaL_error(L, "cannot cancel a running coroutine");
+
+    // pending entries of the thread become stale and are discarded when they are dequeued
+    lua_pushvalue(L, 1);
+    setpending(L, s, 0);
+    lua_pop(L, 1);
+
+    lua_resetthread(co);
+    return 0;
+}
+
+static const luaL_Reg task_funcs[] = {
+    {"spawn", task_spawn},
+    {"defer", task_defer},
+    {"delay", task_delay},
+    {"wait", task_wait},
+    {"cancel", task_cancel},
+    {NULL, NULL},
+};
+
+int luaopen_task(lua_State* L)
+{
+    static const luaL_Reg empty[] = {{NULL, NULL}};
+    luaL_register(L, LUA_TASKLIBNAME, empty);
+
+    Scheduler* s = (Scheduler*)lua_newuserdata(L, sizeof(Scheduler));
+    memset(s, 0, sizeof(Scheduler));
+
+    lua_newtable(L);
+    s->pendingref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    lua_pushvalue(L, -1);
+    lua_setfield(L, LUA_REGISTRYINDEX, TASK_SCHEDULER);
+
+    // library functions access the scheduler through an upvalue to avoid a registry lookup per call
+    for (const luaL_Reg* l = task_funcs; l->name; l++)
+    {
+        lua_pushvalue(L, -1);
+        lua_pushcclosure(L, l->func, l->name, 1);
+        lua_setfield(L, -3, l->name);
+    }
+
+    lua_pop(L, 1);
+
+    return 1;
+}
+
+// resumes the thread of the task unless its entry is stale; returns the resume status with the error at the top of the stack on failure
+static int runtask(lua_State* L, Scheduler* s, const Task& task)
+{
+    lua_getref(L, task.ref);
+    lua_unref(L, task.ref);
+
+    lua_State* co = lua_tothread(L, -1);
+
+    if (getpending(L, s) != task.id || lua_costatus(L, co) != LUA_COSUS)
+    {
+        lua_pop(L, 1);
+        return LUA_OK;
+    }
+
+    setpending(L, s, 0);
+
+    int nargs = task.nargs;
+
+    if (nargs < 0)
+    {
+        lua_pushnumber(co, s->now - task.start);
+        nargs = 1;
+    }
+
+    int status = lua_resume(co, L, nargs);
+
+    if (status != LUA_OK && status != LUA_YIELD && status != LUA_BREAK)
+    {
+        lua_xmove(co, L, 1); // move error message
+        lua_remove(L, -2);
+        return status;
+    }
+
+    lua_settop(co, 0); // discard results
+    lua_pop(L, 1);
+    return LUA_OK;
+}
+
+int luaL_taskstep(lua_State* L, double now)
+{
+    Scheduler* s = getscheduler(L);
+    if (!s)
+        return LUA_OK;
+
+    s->now = now;
+
+    // expired timers are moved to the ready queue in the order of their wakeup time
+    while (s->timercount && s->timers[0].time <= now)
+        pushready(L, s, poptimer(s));
+
+    // tasks that are scheduled while the queue runs are left for the next step
+    for (int count = s->readycount; count > 0 && s->readycount > 0; count--)
+    {
+        int status = runtask(L, s, popready(s));
+
+        if (status != LUA_OK)
+            return status;
+    }
+
+    return LUA_OK;
+}
+
+int luaL_taskpending(lua_State* L, double* next)
+{
+    Scheduler* s = getscheduler(L);
+    if (!s)
+        return 0;
+
+    if (next)
+        *next = s->readycount ? s->now : s->timercount ? s->timers[0].time : 0;
+
+    return s->readycount + s->timercount;
+}
@@ -29,6 +29,11 @@ void luaU_freeudata(lua_State* L, Udata* u, lua_Page* page)
         // certain operations such as lua_getthreaddata are okay, but by and large this risks crashes on improper use
         if (dtor)
             dtor(L, u->data);
+        else if (lua_BatchDestructor batchdtor = L->global->udatabatchgc[u->tag])
+        {
+            void* data = u->data;
+            batchdtor(L, &data, 1);
+        }
     }
     else if (u->tag == UTAG_IDTOR)
     {
@@ -41,3 +46,21 @@ void luaU_freeudata(lua_State* L, Udata* u, lua_Page* page)
 
     luaM_freegco(L, u, sizeudata(u->len), u->memcat, page);
 }
+
+// all userdata in the batch have the same tag, which has a batch destructor
+void luaU_freeudatabatch(lua_State* L, Udata** batch, int count, lua_Page* page)
+{
+    LUAU_ASSERT(count > 0 && count <= UDATA_BATCHSIZE);
+
+    void* data[UDATA_BATCHSIZE];
+    for (int i = 0; i < count; ++i)
+    {
+        LUAU_ASSERT(batch[i]->tag == batch[0]->tag);
+        data[i] = batch[i]->data;
+    }
+
+    L->global->udatabatchgc[batch[0]->tag](L, data, count);
+
+    for (int i = 0; i < count; ++i)
+        luaM_freegco(L, batch[i], sizeudata(batch[i]->len), batch[i]->memcat, page);
+}
@@ -12,5 +12,12 @@
 
 #define sizeudata(len) (offsetof(Udata, data) + len)
 
+// native operators for the tag of the userdata, see lua_setuserdataops
+#define udataops(g, u) ((u)->tag < LUA_UTAG_LIMIT ? (g)->udataops[(u)->tag] : NULL)
+
 LUAI_FUNC Udata* luaU_newudata(lua_State* L, size_t s, int tag);
 LUAI_FUNC void luaU_freeudata(lua_State* L, Udata* u, struct lua_Page* page);
+LUAI_FUNC void luaU_freeudatabatch(lua_State* L, Udata** batch, int count, struct lua_Page* page);
+
+// number of dead userdata with a batch destructor that the sweep passes to the destructor at once
+#define UDATA_BATCHSIZE 64
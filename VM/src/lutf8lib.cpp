@@ -4,6 +4,8 @@
 
 #include "lcommon.h"
 
+#include <string.h>
+
 #define MAXUNICODE 0x10FFFF
 
 #define iscont(p) ((*(p)&0xC0) == 0x80)
@@ -54,6 +56,26 @@ static const char* utf8_decode(const char* o, int* val)
     return (const char*)s + 1; // +1 to include first byte
 }
 
+// returns the number of ASCII characters at the start of [s, e); checks 8 bytes at a time while possible
+static size_t asciirun(const char* s, const char* e)
+{
+    const char* p = s;
+
+    for (; e - p >= 8; p += 8)
+    {
+        uint64_t w;
+        memcpy(&w, p, sizeof(w));
+
+        if (w & 0x8080808080808080ull)
+            break;
+    }
+
+    while (p < e && (unsigned char)*p < 0x80)
+        p++;
+
+    return p - s;
+}
+
 /*
 ** utf8len(s [, i [, j]]) --> number of characters that start in the
 ** range [i,j], or nil + current position if 's' is not well formed in
@@ -70,6 +92,14 @@ static int utflen(lua_State* L)
     luaL_argcheck(L, --posj < (int)len, 3, "final position out of string");
     while (posi <= posj)
     {
+        // ASCII characters are always valid and take one byte each
+        int run = int(asciirun(s + posi, s + posj + 1));
+        posi += run;
+        n += run;
+
+        if (posi > posj)
+            break;
+
         const char* s1 = utf8_decode(s + posi, NULL);
         if (s1 == NULL)
         {                                 // conversion error?
@@ -118,6 +148,41 @@ static int codepoint(lua_State* L)
     return n;
 }
 
+/*
+** codepoints(s, [i, [j]])  -> returns a table with codepoints for all
+** characters that start in the range [i,j]
+*/
+static int codepoints(lua_State* L)
+{
+    size_t len;
+    const char* s = luaL_checklstring(L, 1, &len);
+    int posi = u_posrelat(luaL_optinteger(L, 2, 1), len);
+    int pose = u_posrelat(luaL_optinteger(L, 3, -1), len);
+    luaL_argcheck(L, posi >= 1, 2, "out of range");
+    luaL_argcheck(L, pose <= (int)len, 3, "out of range");
+
+    const char* se = s + (posi > pose ? posi - 1 : pose);
+
+    // every character starts with a byte that is not a continuation byte, which gives an exact size for valid strings
+    int count = 0;
+    for (const char* p = s + posi - 1; p < se; p++)
+        count += !iscont(p);
+
+    lua_createtable(L, count, 0);
+
+    int n = 0;
+    for (s += posi - 1; s < se;)
+    {
+        int code;
+        s = utf8_decode(s, &code);
+        if (s == NULL)
+            luaL_error(L, "invalid UTF-8 code");
+        lua_pushinteger(L, code);
+        lua_rawseti(L, -2, ++n);
+    }
+    return 1;
+}
+
 // from Lua 5.3 lobject.h
 #define UTF8BUFFSZ 8
 
@@ -279,6 +344,7 @@ static int iter_codes(lua_State* L)
 static const luaL_Reg funcs[] = {
     {"offset", byteoffset},
     {"codepoint", codepoint},
+    {"codepoints", codepoints},
     {"char", utfchar},
     {"len", utflen},
     {"codes", iter_codes},
@@ -0,0 +1,246 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lualib.h"
+
+#include <math.h>
+
+// note: the functions below have fast paths in lbuiltins.cpp which need to produce the same results
+// components are computed in single precision; dot products are summed in component order
+
+static void pushvector(lua_State* L, const float* v)
+{
+#if LUA_VECTOR_SIZE == 4
+    lua_pushvector(L, v[0], v[1], v[2], v[3]);
+#else
+    lua_pushvector(L, v[0], v[1], v[2]);
+#endif
+}
+
+static float dotproduct(const float* a, const float* b)
+{
+    float r = a[0] * b[0];
+
+    for (int i = 1; i < LUA_VECTOR_SIZE; ++i)
+    {
+        float p = a[i] * b[i];
+        r += p;
+    }
+
+    return r;
+}
+
+static int vector_create(lua_State* L)
+{
+    float r[4] = {};
+    r[0] = float(luaL_checknumber(L, 1));
+    r[1] = float(luaL_checknumber(L, 2));
+    r[2] = float(luaL_checknumber(L, 3));
+#if LUA_VECTOR_SIZE == 4
+    r[3] = float(luaL_optnumber(L, 4, 0.0));
+#endif
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_magnitude(lua_State* L)
+{
+    const float* v = luaL_checkvector(L, 1);
+
+    lua_pushnumber(L, sqrt(double(dotproduct(v, v))));
+    return 1;
+}
+
+static int vector_normalize(lua_State* L)
+{
+    const float* v = luaL_checkvector(L, 1);
+
+    float inv = float(1.0 / sqrt(double(dotproduct(v, v))));
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        r[i] = v[i] * inv;
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_cross(lua_State* L)
+{
+    const float* a = luaL_checkvector(L, 1);
+    const float* b = luaL_checkvector(L, 2);
+
+    float r[4] = {};
+    r[0] = a[1] * b[2] - a[2] * b[1];
+    r[1] = a[2] * b[0] - a[0] * b[2];
+    r[2] = a[0] * b[1] - a[1] * b[0];
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_dot(lua_State* L)
+{
+    const float* a = luaL_checkvector(L, 1);
+    const float* b = luaL_checkvector(L, 2);
+
+    lua_pushnumber(L, double(dotproduct(a, b)));
+    return 1;
+}
+
+static int vector_floor(lua_State* L)
+{
+    const float* v = luaL_checkvector(L, 1);
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        r[i] = floorf(v[i]);
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_ceil(lua_State* L)
+{
+    const float* v = luaL_checkvector(L, 1);
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        r[i] = ceilf(v[i]);
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_abs(lua_State* L)
+{
+    const float* v = luaL_checkvector(L, 1);
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        r[i] = fabsf(v[i]);
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_sign(lua_State* L)
+{
+    const float* v = luaL_checkvector(L, 1);
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        r[i] = v[i] > 0.0f ? 1.0f : v[i] < 0.0f ? -1.0f : 0.0f;
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_clamp(lua_State* L)
+{
+    const float* v = luaL_checkvector(L, 1);
+    const float* min = luaL_checkvector(L, 2);
+    const float* max = luaL_checkvector(L, 3);
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+    {
+        luaL_argcheck(L, min[i] <= max[i], 3, "max must be greater than or equal to min");
+
+        r[i] = v[i] < min[i] ? min[i] : v[i];
+        r[i] = r[i] > max[i] ? max[i] : r[i];
+    }
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_min(lua_State* L)
+{
+    int n = lua_gettop(L);
+    const float* v = luaL_checkvector(L, 1);
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        r[i] = v[i];
+
+    for (int arg = 2; arg <= n; ++arg)
+    {
+        const float* b = luaL_checkvector(L, arg);
+
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+            r[i] = b[i] < r[i] ? b[i] : r[i];
+    }
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_max(lua_State* L)
+{
+    int n = lua_gettop(L);
+    const float* v = luaL_checkvector(L, 1);
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+        r[i] = v[i];
+
+    for (int arg = 2; arg <= n; ++arg)
+    {
+        const float* b = luaL_checkvector(L, arg);
+
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+            r[i] = b[i] > r[i] ? b[i] : r[i];
+    }
+
+    pushvector(L, r);
+    return 1;
+}
+
+static int vector_lerp(lua_State* L)
+{
+    const float* a = luaL_checkvector(L, 1);
+    const float* b = luaL_checkvector(L, 2);
+    float t = float(luaL_checknumber(L, 3));
+
+    float r[4] = {};
+    for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+    {
+        float d = (b[i] - a[i]) * t;
+        r[i] = a[i] + d;
+    }
+
+    pushvector(L, r);
+    return 1;
+}
+
+static const luaL_Reg vectorlib[] = {
+    {"create", vector_create},
+    {"magnitude", vector_magnitude},
+    {"normalize", vector_normalize},
+    {"cross", vector_cross},
+    {"dot", vector_dot},
+    {"floor", vector_floor},
+    {"ceil", vector_ceil},
+    {"abs", vector_abs},
+    {"sign", vector_sign},
+    {"clamp", vector_clamp},
+    {"min", vector_min},
+    {"max", vector_max},
+    {"lerp", vector_lerp},
+    {NULL, NULL},
+};
+
+int luaopen_vector(lua_State* L)
+{
+    luaL_register(L, LUA_VECLIBNAME, vectorlib);
+
+    float zero[4] = {};
+    pushvector(L, zero);
+    lua_setfield(L, -2, "zero");
+
+    float one[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    pushvector(L, one);
+    lua_setfield(L, -2, "one");
+
+    return 1;
+}
@@ -11,6 +11,12 @@
 
 #define equalobj(L, o1, o2) (ttype(o1) == ttype(o2) && luaV_equalval(L, o1, o2))
 
+// secondary slot hint of GETTABLEKS/NAMECALL instruction at pc, or -1 if the hint of this function never changed
+#define luaV_slotcache(p, pc) ((p)->slotcache ? (p)->slotcache[(pc) - (p)->code] : -1)
+
+// value of a string key that GETTABLEKS/NAMECALL instruction at pc previously found through a chain of __index tables, or NULL
+#define luaV_indexchain(L, p, pc, t, key) ((p)->indexchain ? luaV_getindexchain(L, p, pc, t, key) : NULL)
+
 LUAI_FUNC int luaV_strcmp(const TString* ls, const TString* rs);
 LUAI_FUNC int luaV_lessthan(lua_State* L, const TValue* l, const TValue* r);
 LUAI_FUNC int luaV_lessequal(lua_State* L, const TValue* l, const TValue* r);
@@ -24,6 +30,11 @@ LUAI_FUNC const TValue* luaV_tonumber(const TValue* obj, TValue* n);
 LUAI_FUNC const float* luaV_tovector(const TValue* obj);
 LUAI_FUNC int luaV_tostring(lua_State* L, StkId obj);
 LUAI_FUNC void luaV_gettable(lua_State* L, const TValue* t, TValue* key, StkId val);
+LUAI_FUNC void luaV_patchslot(lua_State* L, Proto* p, const Instruction* pc, int slot);
+LUAI_FUNC const TValue* luaV_getindexchain(lua_State* L, Proto* p, const Instruction* pc, const TValue* t, TString* key);
+LUAI_FUNC void luaV_cacheindexchain(lua_State* L, Proto* p, const Instruction* pc, const TValue* t, TString* key);
+LUAI_FUNC void luaV_reporthot(lua_State* L, Proto* p);
+LUAI_FUNC void luaV_profileargs(Proto* p, const TValue* args, const TValue* argtop);
 LUAI_FUNC void luaV_settable(lua_State* L, const TValue* t, TValue* key, StkId val);
 LUAI_FUNC void luaV_concat(lua_State* L, int total, int last);
 LUAI_FUNC void luaV_getimport(lua_State* L, Table* env, TValue* k, StkId res, uint32_t id, bool propagatenil);
@@ -7,6 +7,7 @@
 #include "lfunc.h"
 #include "lstring.h"
 #include "lgc.h"
+#include "ludata.h"
 #include "lmem.h"
 #include "ldebug.h"
 #include "ldo.h"
@@ -55,6 +56,22 @@
         base = L->base; \
     }
 
+// Fallbacks from the fast path of an instruction (metamethods, generic table access and comparison) go through VM_SLOWPATH, which
+// attributes them to the executing opcode when collecting opcode statistics (see lua_setopcodestats) in single-step mode.
+#define VM_SLOWPATH(x) \
+    { \
+        if (SingleStep && L->global->opstats) \
+            luau_countslowpath(L->global->opstats); \
+        VM_PROTECT(x); \
+    }
+
+// Fastcalls that continue through the regular call are also counted when collecting opcode statistics
+#define VM_FASTCALL_FALLBACK(bfid) \
+    { \
+        if (SingleStep && L->global->opstats) \
+            L->global->opstats->fastcallfallback[bfid]++; \
+    }
+
 // Some external functions can cause an error, but never reallocate the stack; for these, VM_PROTECT_PC() is
 // a cheaper version of VM_PROTECT that can be called before the external call.
 #define VM_PROTECT_PC() L->ci->savedpc = pc
@@ -66,10 +83,17 @@
 #define VM_PATCH_C(pc, slot) *const_cast<Instruction*>(pc) = ((uint8_t(slot) << 24) | (0x00ffffffu & *(pc)))
 #define VM_PATCH_E(pc, slot) *const_cast<Instruction*>(pc) = ((uint32_t(slot) << 8) | (0x000000ffu & *(pc)))
 
+// loop back edges count towards the hot function threshold, see lua_sethotthreshold
+#define VM_HOTCOUNT() \
+    { \
+        if (LUAU_UNLIKELY(--cl->l.p->hotcount == 0)) \
+            VM_PROTECT(luaV_reporthot(L, cl->l.p)); \
+    }
+
 #define VM_INTERRUPT() \
     { \
         void (*interrupt)(lua_State*, int) = L->global->cb.interrupt; \
-        if (LUAU_UNLIKELY(!!interrupt)) \
+        if (LUAU_UNLIKELY(!!interrupt) && (L->interruptbudget <= 0 || --L->interruptbudget == 0)) \
         { /* the interrupt hook is called right before we advance pc */ \
             VM_PROTECT(L->ci->savedpc++; interrupt(L, -1)); \
             if (L->status != 0) \
@@ -191,6 +215,28 @@ inline bool luau_skipstep(uint8_t op)
     return op == LOP_PREPVARARGS || op == LOP_BREAK;
 }
 
+static void luau_countop(lua_OpcodeStats* stats, Instruction insn)
+{
+    uint8_t op = LUAU_INSN_OP(insn);
+
+    stats->exec[op]++;
+
+    if (stats->lastop >= 0)
+        stats->pairs[stats->lastop][op]++;
+
+    // lastop stays set while the instruction executes so that its slow paths can be attributed to it
+    stats->lastop = op;
+
+    if (op == LOP_FASTCALL || op == LOP_FASTCALL1 || op == LOP_FASTCALL2 || op == LOP_FASTCALL2K || op == LOP_FASTCALL3)
+        stats->fastcall[LUAU_INSN_A(insn)]++;
+}
+
+static void luau_countslowpath(lua_OpcodeStats* stats)
+{
+    if (stats->lastop >= 0)
+        stats->slowpath[stats->lastop]++;
+}
+
 template<bool SingleStep>
 static void luau_execute(lua_State* L)
 {
@@ -250,6 +296,10 @@ reentry:
                     goto exit;
             }
 
+            // instructions are counted after the hook so that instructions interrupted by a yielding hook aren't counted twice
+            if (L->global->opstats)
+                luau_countop(L->global->opstats, *pc);
+
 #if VM_USE_CGOTO
             VM_CONTINUE(LUAU_INSN_OP(*pc));
 #endif
@@ -343,7 +393,7 @@ reentry:
                     TValue g;
                     sethvalue(L, &g, h);
                     L->cachedslot = slot;
-                    VM_PROTECT(luaV_gettable(L, &g, kv, ra));
+                    VM_SLOWPATH(luaV_gettable(L, &g, kv, ra));
                     // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                     VM_PATCH_C(pc - 2, L->cachedslot);
                     VM_NEXT();
@@ -375,7 +425,7 @@ reentry:
                     TValue g;
                     sethvalue(L, &g, h);
                     L->cachedslot = slot;
-                    VM_PROTECT(luaV_settable(L, &g, kv, ra));
+                    VM_SLOWPATH(luaV_settable(L, &g, kv, ra));
                     // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                     VM_PATCH_C(pc - 2, L->cachedslot);
                     VM_NEXT();
@@ -432,7 +482,7 @@ reentry:
                 {
                     uint32_t aux = *pc++;
 
-                    VM_PROTECT(luaV_getimport(L, cl->env, k, ra, aux, /* propagatenil= */ false));
+                    VM_SLOWPATH(luaV_getimport(L, cl->env, k, ra, aux, /* propagatenil= */ false));
                     VM_NEXT();
                 }
             }
@@ -462,6 +512,16 @@ reentry:
                     }
                     else if (!h->metatable)
                     {
+                        // fast-path: value is in the secondary expected slot of a polymorphic instruction
+                        int polyslot = luaV_slotcache(cl->l.p, pc - 2);
+                        LuaNode* pn = &h->node[polyslot & h->nodemask8];
+
+                        if (polyslot >= 0 && ttisstring(gkey(pn)) && tsvalue(gkey(pn)) == tsvalue(kv) && !ttisnil(gval(pn)))
+                        {
+                            setobj2s(L, ra, gval(pn));
+                            VM_NEXT();
+                        }
+
                         // fast-path: value is not in expected slot, but the table lookup doesn't involve metatable
                         const TValue* res = luaH_getstr(h, tsvalue(kv));
 
@@ -469,17 +529,25 @@ reentry:
                         {
                             int cachedslot = gval2slot(h, res);
                             // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-                            VM_PATCH_C(pc - 2, cachedslot);
+                            VM_PROTECT(luaV_patchslot(L, cl->l.p, pc - 2, cachedslot));
+                            ra = VM_REG(LUAU_INSN_A(insn));
                         }
 
                         setobj2s(L, ra, res);
                         VM_NEXT();
                     }
+                    // fast-path: value is at the end of a chain of __index tables that was resolved before
+                    else if (const TValue* res = luaV_indexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)))
+                    {
+                        setobj2s(L, ra, res);
+                        VM_NEXT();
+                    }
                     else
                     {
                         // slow-path, may invoke Lua calls via __index metamethod
+                        VM_PROTECT(luaV_cacheindexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)));
                         L->cachedslot = slot;
-                        VM_PROTECT(luaV_gettable(L, rb, kv, ra));
+                        VM_SLOWPATH(luaV_gettable(L, rb, kv, ra));
                         // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                         VM_PATCH_C(pc - 2, L->cachedslot);
                         VM_NEXT();
@@ -500,7 +568,7 @@ reentry:
                         L->top = top + 3;
 
                         L->cachedslot = LUAU_INSN_C(insn);
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                         VM_PATCH_C(pc - 2, L->cachedslot);
                         VM_NEXT();
@@ -537,7 +605,7 @@ reentry:
                             L->top = top + 3;
 
                             L->cachedslot = LUAU_INSN_C(insn);
-                            VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                            VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                             // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                             VM_PATCH_C(pc - 2, L->cachedslot);
                             VM_NEXT();
@@ -550,7 +618,7 @@ reentry:
                 }
 
                 // slow-path, may invoke Lua calls via __index metamethod
-                VM_PROTECT(luaV_gettable(L, rb, kv, ra));
+                VM_SLOWPATH(luaV_gettable(L, rb, kv, ra));
                 VM_NEXT();
             }
 
@@ -594,7 +662,7 @@ reentry:
                     {
                         // slow-path, may invoke Lua calls via __newindex metamethod
                         L->cachedslot = slot;
-                        VM_PROTECT(luaV_settable(L, rb, kv, ra));
+                        VM_SLOWPATH(luaV_settable(L, rb, kv, ra));
                         // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                         VM_PATCH_C(pc - 2, L->cachedslot);
                         VM_NEXT();
@@ -616,7 +684,7 @@ reentry:
                         L->top = top + 4;
 
                         L->cachedslot = LUAU_INSN_C(insn);
-                        VM_PROTECT(luaV_callTM(L, 3, -1));
+                        VM_SLOWPATH(luaV_callTM(L, 3, -1));
                         // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                         VM_PATCH_C(pc - 2, L->cachedslot);
                         VM_NEXT();
@@ -624,7 +692,7 @@ reentry:
                     else
                     {
                         // slow-path, may invoke Lua calls via __newindex metamethod
-                        VM_PROTECT(luaV_settable(L, rb, kv, ra));
+                        VM_SLOWPATH(luaV_settable(L, rb, kv, ra));
                         VM_NEXT();
                     }
                 }
@@ -656,7 +724,7 @@ reentry:
                 }
 
                 // slow-path: handles out of bounds array lookups, non-integer numeric keys, non-array table lookup, __index MT calls
-                VM_PROTECT(luaV_gettable(L, rb, rc, ra));
+                VM_SLOWPATH(luaV_gettable(L, rb, rc, ra));
                 VM_NEXT();
             }
 
@@ -687,7 +755,7 @@ reentry:
                 }
 
                 // slow-path: handles out of bounds array assignments, non-integer numeric keys, non-array table access, __newindex MT calls
-                VM_PROTECT(luaV_settable(L, rb, rc, ra));
+                VM_SLOWPATH(luaV_settable(L, rb, rc, ra));
                 VM_NEXT();
             }
 
@@ -715,7 +783,7 @@ reentry:
                 // slow-path: handles out of bounds array lookups
                 TValue n;
                 setnvalue(&n, c + 1);
-                VM_PROTECT(luaV_gettable(L, rb, &n, ra));
+                VM_SLOWPATH(luaV_gettable(L, rb, &n, ra));
                 VM_NEXT();
             }
 
@@ -744,7 +812,7 @@ reentry:
                 // slow-path: handles out of bounds array lookups
                 TValue n;
                 setnvalue(&n, c + 1);
-                VM_PROTECT(luaV_settable(L, rb, &n, ra));
+                VM_SLOWPATH(luaV_settable(L, rb, &n, ra));
                 VM_NEXT();
             }
 
@@ -818,7 +886,8 @@ reentry:
                         setobj2s(L, ra, gval(n));
                     }
                     // fast-path: key is absent from the base, table has an __index table, and it has the result in the expected slot
-                    else if (gnext(n) == 0 && (mt = fasttm(L, hvalue(rb)->metatable, TM_INDEX)) && ttistable(mt) &&
+                    // note: long strings aren't interned, so a key mismatch in the main position doesn't prove that a long key is absent
+                    else if (isshortstr(tsvalue(kv)) && gnext(n) == 0 && (mt = fasttm(L, hvalue(rb)->metatable, TM_INDEX)) && ttistable(mt) &&
                              (mtn = &hvalue(mt)->node[LUAU_INSN_C(insn) & hvalue(mt)->nodemask8]) && ttisstring(gkey(mtn)) &&
                              tsvalue(gkey(mtn)) == tsvalue(kv) && !ttisnil(gval(mtn)))
                     {
@@ -826,14 +895,31 @@ reentry:
                         setobj2s(L, ra + 1, rb);
                         setobj2s(L, ra, gval(mtn));
                     }
+                    // fast-path: same as above, but the result is in the secondary expected slot of a polymorphic call site
+                    else if (mt && ttistable(mt) && luaV_slotcache(cl->l.p, pc - 2) >= 0 &&
+                             (mtn = &hvalue(mt)->node[luaV_slotcache(cl->l.p, pc - 2) & hvalue(mt)->nodemask8]) && ttisstring(gkey(mtn)) &&
+                             tsvalue(gkey(mtn)) == tsvalue(kv) && !ttisnil(gval(mtn)))
+                    {
+                        // note: order of copies allows rb to alias ra+1 or ra
+                        setobj2s(L, ra + 1, rb);
+                        setobj2s(L, ra, gval(mtn));
+                    }
+                    // fast-path: the result is at the end of a chain of __index tables that was resolved before
+                    else if (const TValue* res = luaV_indexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)))
+                    {
+                        // note: order of copies allows rb to alias ra+1 or ra
+                        setobj2s(L, ra + 1, rb);
+                        setobj2s(L, ra, res);
+                    }
                     else
                     {
                         // slow-path: handles full table lookup
                         setobj2s(L, ra + 1, rb);
+                        VM_PROTECT(luaV_cacheindexchain(L, cl->l.p, pc - 2, ra + 1, tsvalue(kv)));
                         L->cachedslot = LUAU_INSN_C(insn);
-                        VM_PROTECT(luaV_gettable(L, rb, kv, ra));
+                        VM_SLOWPATH(luaV_gettable(L, rb, kv, ra));
                         // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-                        VM_PATCH_C(pc - 2, L->cachedslot);
+                        VM_PROTECT(luaV_patchslot(L, cl->l.p, pc - 2, L->cachedslot));
                         // recompute ra since stack might have been reallocated
                         ra = VM_REG(LUAU_INSN_A(insn));
                         if (ttisnil(ra))
@@ -860,6 +946,9 @@ reentry:
                         int slot = LUAU_INSN_C(insn) & h->nodemask8;
                         LuaNode* n = &h->node[slot];
 
+                        int polyslot = luaV_slotcache(cl->l.p, pc - 2);
+                        LuaNode* pn = &h->node[polyslot & h->nodemask8];
+
                         // fast-path: metatable with __index that has method in expected slot
                         if (LUAU_LIKELY(ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv) && !ttisnil(gval(n))))
                         {
@@ -867,14 +956,29 @@ reentry:
                             setobj2s(L, ra + 1, rb);
                             setobj2s(L, ra, gval(n));
                         }
+                        // fast-path: method is in the secondary expected slot of a polymorphic call site
+                        else if (polyslot >= 0 && ttisstring(gkey(pn)) && tsvalue(gkey(pn)) == tsvalue(kv) && !ttisnil(gval(pn)))
+                        {
+                            // note: order of copies allows rb to alias ra+1 or ra
+                            setobj2s(L, ra + 1, rb);
+                            setobj2s(L, ra, gval(pn));
+                        }
+                        // fast-path: method is at the end of a chain of __index tables that was resolved before
+                        else if (const TValue* res = luaV_indexchain(L, cl->l.p, pc - 2, rb, tsvalue(kv)))
+                        {
+                            // note: order of copies allows rb to alias ra+1 or ra
+                            setobj2s(L, ra + 1, rb);
+                            setobj2s(L, ra, res);
+                        }
                         else
                         {
                             // slow-path: handles slot mismatch
                             setobj2s(L, ra + 1, rb);
+                            VM_PROTECT(luaV_cacheindexchain(L, cl->l.p, pc - 2, ra + 1, tsvalue(kv)));
                             L->cachedslot = slot;
-                            VM_PROTECT(luaV_gettable(L, rb, kv, ra));
+                            VM_SLOWPATH(luaV_gettable(L, rb, kv, ra));
                             // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-                            VM_PATCH_C(pc - 2, L->cachedslot);
+                            VM_PROTECT(luaV_patchslot(L, cl->l.p, pc - 2, L->cachedslot));
                             // recompute ra since stack might have been reallocated
                             ra = VM_REG(LUAU_INSN_A(insn));
                             if (ttisnil(ra))
@@ -885,7 +989,7 @@ reentry:
                     {
                         // slow-path: handles non-table __index
                         setobj2s(L, ra + 1, rb);
-                        VM_PROTECT(luaV_gettable(L, rb, kv, ra));
+                        VM_SLOWPATH(luaV_gettable(L, rb, kv, ra));
                         // recompute ra since stack might have been reallocated
                         ra = VM_REG(LUAU_INSN_A(insn));
                         if (ttisnil(ra))
@@ -950,6 +1054,16 @@ reentry:
                         setnilvalue(argi++); // complete missing arguments
                     L->top = p->is_vararg ? argi : ci->top;
 
+                    if (LUAU_UNLIKELY(p->argtypes != NULL))
+                        luaV_profileargs(p, L->base, argend);
+
+                    // the callback can compile the function, so this needs to happen before codeentry is read
+                    if (LUAU_UNLIKELY(--p->hotcount == 0))
+                    {
+                        ci->savedpc = p->code;
+                        luaV_reporthot(L, p);
+                    }
+
                     // reentry
                     // codeentry may point to NATIVECALL instruction when proto is compiled to native code
                     // this will result in execution continuing in native code, and is equivalent to if (p->execdata) but has no additional overhead
@@ -1123,6 +1237,10 @@ reentry:
                         VM_NEXT();
 
                     case LUA_TSTRING:
+                        pc += luaS_eqstr(tsvalue(ra), tsvalue(rb)) ? LUAU_INSN_D(insn) : 1;
+                        LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                        VM_NEXT();
+
                     case LUA_TFUNCTION:
                     case LUA_TTHREAD:
                     case LUA_TBUFFER:
@@ -1147,8 +1265,8 @@ reentry:
                         break;
 
                     case LUA_TUSERDATA:
-                        // fast-path: same metatable, no EQ metamethod or C metamethod
-                        if (uvalue(ra)->metatable == uvalue(rb)->metatable)
+                        // fast-path: same metatable, no EQ metamethod or C metamethod; native operators are handled in the slow path
+                        if (uvalue(ra)->metatable == uvalue(rb)->metatable && !udataops(L->global, uvalue(ra)))
                         {
                             const TValue* fn = fasttm(L, uvalue(ra)->metatable, TM_EQ);
 
@@ -1169,7 +1287,7 @@ reentry:
                                 int res = int(top - base);
                                 L->top = top + 3;
 
-                                VM_PROTECT(luaV_callTM(L, 2, res));
+                                VM_SLOWPATH(luaV_callTM(L, 2, res));
                                 pc += !l_isfalse(&base[res]) ? LUAU_INSN_D(insn) : 1;
                                 LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
                                 VM_NEXT();
@@ -1186,7 +1304,7 @@ reentry:
                     // slow-path: tables with metatables and userdata values
                     // note that we don't have a fast path for userdata values without metatables, since that's very rare
                     int res;
-                    VM_PROTECT(res = luaV_equalval(L, ra, rb));
+                    VM_SLOWPATH(res = luaV_equalval(L, ra, rb));
 
                     pc += (res == 1) ? LUAU_INSN_D(insn) : 1;
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -1238,6 +1356,10 @@ reentry:
                         VM_NEXT();
 
                     case LUA_TSTRING:
+                        pc += !luaS_eqstr(tsvalue(ra), tsvalue(rb)) ? LUAU_INSN_D(insn) : 1;
+                        LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                        VM_NEXT();
+
                     case LUA_TFUNCTION:
                     case LUA_TTHREAD:
                     case LUA_TBUFFER:
@@ -1262,8 +1384,8 @@ reentry:
                         break;
 
                     case LUA_TUSERDATA:
-                        // fast-path: same metatable, no EQ metamethod or C metamethod
-                        if (uvalue(ra)->metatable == uvalue(rb)->metatable)
+                        // fast-path: same metatable, no EQ metamethod or C metamethod; native operators are handled in the slow path
+                        if (uvalue(ra)->metatable == uvalue(rb)->metatable && !udataops(L->global, uvalue(ra)))
                         {
                             const TValue* fn = fasttm(L, uvalue(ra)->metatable, TM_EQ);
 
@@ -1284,7 +1406,7 @@ reentry:
                                 int res = int(top - base);
                                 L->top = top + 3;
 
-                                VM_PROTECT(luaV_callTM(L, 2, res));
+                                VM_SLOWPATH(luaV_callTM(L, 2, res));
                                 pc += l_isfalse(&base[res]) ? LUAU_INSN_D(insn) : 1;
                                 LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
                                 VM_NEXT();
@@ -1301,7 +1423,7 @@ reentry:
                     // slow-path: tables with metatables and userdata values
                     // note that we don't have a fast path for userdata values without metatables, since that's very rare
                     int res;
-                    VM_PROTECT(res = luaV_equalval(L, ra, rb));
+                    VM_SLOWPATH(res = luaV_equalval(L, ra, rb));
 
                     pc += (res == 0) ? LUAU_INSN_D(insn) : 1;
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -1340,7 +1462,7 @@ reentry:
                 else
                 {
                     int res;
-                    VM_PROTECT(res = luaV_lessequal(L, ra, rb));
+                    VM_SLOWPATH(res = luaV_lessequal(L, ra, rb));
 
                     pc += (res == 1) ? LUAU_INSN_D(insn) : 1;
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -1373,7 +1495,7 @@ reentry:
                 else
                 {
                     int res;
-                    VM_PROTECT(res = luaV_lessequal(L, ra, rb));
+                    VM_SLOWPATH(res = luaV_lessequal(L, ra, rb));
 
                     pc += (res == 0) ? LUAU_INSN_D(insn) : 1;
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -1406,7 +1528,7 @@ reentry:
                 else
                 {
                     int res;
-                    VM_PROTECT(res = luaV_lessthan(L, ra, rb));
+                    VM_SLOWPATH(res = luaV_lessthan(L, ra, rb));
 
                     pc += (res == 1) ? LUAU_INSN_D(insn) : 1;
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -1439,7 +1561,7 @@ reentry:
                 else
                 {
                     int res;
-                    VM_PROTECT(res = luaV_lessthan(L, ra, rb));
+                    VM_SLOWPATH(res = luaV_lessthan(L, ra, rb));
 
                     pc += (res == 0) ? LUAU_INSN_D(insn) : 1;
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -1471,7 +1593,8 @@ reentry:
                 {
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
-                    if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_ADD)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rb) && !udataops(L->global, uvalue(rb)) && (fn = luaT_gettmbyobj(L, rb, TM_ADD)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1481,13 +1604,13 @@ reentry:
                         setobj2s(L, top + 2, rc);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_ADD>(L, ra, rb, rc));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_ADD>(L, ra, rb, rc));
                         VM_NEXT();
                     }
                 }
@@ -1517,7 +1640,8 @@ reentry:
                 {
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
-                    if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_SUB)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rb) && !udataops(L->global, uvalue(rb)) && (fn = luaT_gettmbyobj(L, rb, TM_SUB)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1527,13 +1651,13 @@ reentry:
                         setobj2s(L, top + 2, rc);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_SUB>(L, ra, rb, rc));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_SUB>(L, ra, rb, rc));
                         VM_NEXT();
                     }
                 }
@@ -1578,7 +1702,8 @@ reentry:
                     // fast-path for userdata with C functions
                     StkId rbc = ttisnumber(rb) ? rc : rb;
                     const TValue* fn = 0;
-                    if (ttisuserdata(rbc) && (fn = luaT_gettmbyobj(L, rbc, TM_MUL)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rbc) && !udataops(L->global, uvalue(rbc)) && (fn = luaT_gettmbyobj(L, rbc, TM_MUL)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1588,13 +1713,13 @@ reentry:
                         setobj2s(L, top + 2, rc);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_MUL>(L, ra, rb, rc));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_MUL>(L, ra, rb, rc));
                         VM_NEXT();
                     }
                 }
@@ -1639,7 +1764,8 @@ reentry:
                     // fast-path for userdata with C functions
                     StkId rbc = ttisnumber(rb) ? rc : rb;
                     const TValue* fn = 0;
-                    if (ttisuserdata(rbc) && (fn = luaT_gettmbyobj(L, rbc, TM_DIV)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rbc) && !udataops(L->global, uvalue(rbc)) && (fn = luaT_gettmbyobj(L, rbc, TM_DIV)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1649,13 +1775,13 @@ reentry:
                         setobj2s(L, top + 2, rc);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_DIV>(L, ra, rb, rc));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_DIV>(L, ra, rb, rc));
                         VM_NEXT();
                     }
                 }
@@ -1687,7 +1813,8 @@ reentry:
                     // fast-path for userdata with C functions
                     StkId rbc = ttisnumber(rb) ? rc : rb;
                     const TValue* fn = 0;
-                    if (ttisuserdata(rbc) && (fn = luaT_gettmbyobj(L, rbc, TM_IDIV)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rbc) && !udataops(L->global, uvalue(rbc)) && (fn = luaT_gettmbyobj(L, rbc, TM_IDIV)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1697,13 +1824,13 @@ reentry:
                         setobj2s(L, top + 2, rc);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_IDIV>(L, ra, rb, rc));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_IDIV>(L, ra, rb, rc));
                         VM_NEXT();
                     }
                 }
@@ -1727,7 +1854,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_MOD>(L, ra, rb, rc));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_MOD>(L, ra, rb, rc));
                     VM_NEXT();
                 }
             }
@@ -1748,7 +1875,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_POW>(L, ra, rb, rc));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_POW>(L, ra, rb, rc));
                     VM_NEXT();
                 }
             }
@@ -1769,7 +1896,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_ADD>(L, ra, rb, kv));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_ADD>(L, ra, rb, kv));
                     VM_NEXT();
                 }
             }
@@ -1790,7 +1917,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_SUB>(L, ra, rb, kv));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_SUB>(L, ra, rb, kv));
                     VM_NEXT();
                 }
             }
@@ -1819,7 +1946,8 @@ reentry:
                 {
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
-                    if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_MUL)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rb) && !udataops(L->global, uvalue(rb)) && (fn = luaT_gettmbyobj(L, rb, TM_MUL)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1829,13 +1957,13 @@ reentry:
                         setobj2s(L, top + 2, kv);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_MUL>(L, ra, rb, kv));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_MUL>(L, ra, rb, kv));
                         VM_NEXT();
                     }
                 }
@@ -1865,7 +1993,8 @@ reentry:
                 {
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
-                    if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_DIV)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rb) && !udataops(L->global, uvalue(rb)) && (fn = luaT_gettmbyobj(L, rb, TM_DIV)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1875,13 +2004,13 @@ reentry:
                         setobj2s(L, top + 2, kv);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_DIV>(L, ra, rb, kv));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_DIV>(L, ra, rb, kv));
                         VM_NEXT();
                     }
                 }
@@ -1912,7 +2041,8 @@ reentry:
                 {
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
-                    if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_IDIV)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rb) && !udataops(L->global, uvalue(rb)) && (fn = luaT_gettmbyobj(L, rb, TM_IDIV)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 3 < L->stack + L->stacksize);
@@ -1922,13 +2052,13 @@ reentry:
                         setobj2s(L, top + 2, kv);
                         L->top = top + 3;
 
-                        VM_PROTECT(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 2, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_IDIV>(L, ra, rb, kv));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_IDIV>(L, ra, rb, kv));
                         VM_NEXT();
                     }
                 }
@@ -1952,7 +2082,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_MOD>(L, ra, rb, kv));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_MOD>(L, ra, rb, kv));
                     VM_NEXT();
                 }
             }
@@ -1979,7 +2109,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_POW>(L, ra, rb, kv));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_POW>(L, ra, rb, kv));
                     VM_NEXT();
                 }
             }
@@ -2077,7 +2207,8 @@ reentry:
                 {
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
-                    if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_UNM)) && ttisfunction(fn) && clvalue(fn)->isC)
+                    if (ttisuserdata(rb) && !udataops(L->global, uvalue(rb)) && (fn = luaT_gettmbyobj(L, rb, TM_UNM)) && ttisfunction(fn) &&
+                        clvalue(fn)->isC)
                     {
                         // note: it's safe to push arguments past top for complicated reasons (see top of the file)
                         LUAU_ASSERT(L->top + 2 < L->stack + L->stacksize);
@@ -2086,13 +2217,13 @@ reentry:
                         setobj2s(L, top + 1, rb);
                         L->top = top + 2;
 
-                        VM_PROTECT(luaV_callTM(L, 1, LUAU_INSN_A(insn)));
+                        VM_SLOWPATH(luaV_callTM(L, 1, LUAU_INSN_A(insn)));
                         VM_NEXT();
                     }
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_doarithimpl<TM_UNM>(L, ra, rb, rb));
+                        VM_SLOWPATH(luaV_doarithimpl<TM_UNM>(L, ra, rb, rb));
                         VM_NEXT();
                     }
                 }
@@ -2117,7 +2248,7 @@ reentry:
                     else
                     {
                         // slow-path, may invoke C/Lua via metamethods
-                        VM_PROTECT(luaV_dolen(L, ra, rb));
+                        VM_SLOWPATH(luaV_dolen(L, ra, rb));
                         VM_NEXT();
                     }
                 }
@@ -2131,7 +2262,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_dolen(L, ra, rb));
+                    VM_SLOWPATH(luaV_dolen(L, ra, rb));
                     VM_NEXT();
                 }
             }
@@ -2227,6 +2358,7 @@ reentry:
             VM_CASE(LOP_FORNLOOP)
             {
                 VM_INTERRUPT();
+                VM_HOTCOUNT();
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 LUAU_ASSERT(ttisnumber(ra + 0) && ttisnumber(ra + 1) && ttisnumber(ra + 2));
@@ -2312,6 +2444,7 @@ reentry:
             VM_CASE(LOP_FORGLOOP)
             {
                 VM_INTERRUPT();
+                VM_HOTCOUNT();
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 uint32_t aux = *pc;
@@ -2594,6 +2727,7 @@ reentry:
             VM_CASE(LOP_JUMPBACK)
             {
                 VM_INTERRUPT();
+                VM_HOTCOUNT();
                 Instruction insn = *pc++;
 
                 pc += LUAU_INSN_D(insn);
@@ -2661,12 +2795,14 @@ reentry:
                     else
                     {
                         // continue execution through the fallback code
+                        VM_FASTCALL_FALLBACK(bfid);
                         VM_NEXT();
                     }
                 }
                 else
                 {
                     // continue execution through the fallback code
+                    VM_FASTCALL_FALLBACK(bfid);
                     VM_NEXT();
                 }
             }
@@ -2705,7 +2841,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_SUB>(L, ra, kv, rc));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_SUB>(L, ra, kv, rc));
                     VM_NEXT();
                 }
             }
@@ -2733,7 +2869,7 @@ reentry:
                 else
                 {
                     // slow-path, may invoke C/Lua via metamethods
-                    VM_PROTECT(luaV_doarithimpl<TM_DIV>(L, ra, kv, rc));
+                    VM_SLOWPATH(luaV_doarithimpl<TM_DIV>(L, ra, kv, rc));
                     VM_NEXT();
                 }
             }
@@ -2776,12 +2912,14 @@ reentry:
                     else
                     {
                         // continue execution through the fallback code
+                        VM_FASTCALL_FALLBACK(bfid);
                         VM_NEXT();
                     }
                 }
                 else
                 {
                     // continue execution through the fallback code
+                    VM_FASTCALL_FALLBACK(bfid);
                     VM_NEXT();
                 }
             }
@@ -2826,12 +2964,14 @@ reentry:
                     else
                     {
                         // continue execution through the fallback code
+                        VM_FASTCALL_FALLBACK(bfid);
                         VM_NEXT();
                     }
                 }
                 else
                 {
                     // continue execution through the fallback code
+                    VM_FASTCALL_FALLBACK(bfid);
                     VM_NEXT();
                 }
             }
@@ -2876,12 +3016,14 @@ reentry:
                     else
                     {
                         // continue execution through the fallback code
+                        VM_FASTCALL_FALLBACK(bfid);
                         VM_NEXT();
                     }
                 }
                 else
                 {
                     // continue execution through the fallback code
+                    VM_FASTCALL_FALLBACK(bfid);
                     VM_NEXT();
                 }
             }
@@ -2930,12 +3072,14 @@ reentry:
                     else
                     {
                         // continue execution through the fallback code
+                        VM_FASTCALL_FALLBACK(bfid);
                         VM_NEXT();
                     }
                 }
                 else
                 {
                     // continue execution through the fallback code
+                    VM_FASTCALL_FALLBACK(bfid);
                     VM_NEXT();
                 }
             }
@@ -3013,7 +3157,7 @@ reentry:
                 TValue* kv = VM_KV(aux & 0xffffff);
                 LUAU_ASSERT(ttisstring(kv));
 
-                pc += int(ttisstring(ra) && gcvalue(ra) == gcvalue(kv)) != (aux >> 31) ? LUAU_INSN_D(insn) : 1;
+                pc += int(ttisstring(ra) && luaS_eqstr(tsvalue(kv), tsvalue(ra))) != (aux >> 31) ? LUAU_INSN_D(insn) : 1;
                 LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
                 VM_NEXT();
             }
@@ -3031,7 +3175,7 @@ exit:;
 
 void luau_execute(lua_State* L)
 {
-    if (L->singlestep)
+    if (L->singlestep || L->global->opstats)
         luau_execute<true>(L);
     else
         luau_execute<false>(L);
@@ -3072,6 +3216,9 @@ int luau_precall(lua_State* L, StkId func, int nresults)
             setnilvalue(argi++); // complete missing arguments
         L->top = p->is_vararg ? argi : ci->top;
 
+        if (LUAU_UNLIKELY(p->argtypes != NULL))
+            luaV_profileargs(p, L->base, argend);
+
         ci->savedpc = p->code;
 
 #if VM_HAS_NATIVE
@@ -136,6 +136,136 @@ static unsigned int readVarInt(const char* data, size_t size, size_t& offset)
     return result;
 }
 
+// table constants are only used as templates for DUPTABLE, which always clones them; this allows functions in the same module to share the
+// template when the keys are the same, which is common in data modules that construct many records of the same shape
+struct TableTemplateCache
+{
+    struct Entry
+    {
+        Table* table;
+        const TValue* k;
+        size_t keysOffset;
+        int keys;
+        unsigned int hash;
+    };
+
+    lua_State* L;
+    Entry* entries = nullptr;
+    size_t capacity = 0;
+    size_t count = 0;
+
+    TableTemplateCache(lua_State* L)
+        : L(L)
+    {
+    }
+
+    TableTemplateCache(const TableTemplateCache&) = delete;
+    TableTemplateCache& operator=(const TableTemplateCache&) = delete;
+
+    ~TableTemplateCache() noexcept
+    {
+        if (entries)
+            luaM_freearray(L, entries, capacity, Entry, 0);
+    }
+};
+
+static bool getTableTemplateHash(const char* data, size_t size, size_t offset, int keys, const TValue* k, unsigned int& hash)
+{
+    unsigned int h = unsigned(keys);
+
+    for (int i = 0; i < keys; ++i)
+    {
+        int key = readVarInt(data, size, offset);
+
+        // the key order matters since it determines the node layout of the cloned tables, which affects traversal order
+        if (!ttisstring(&k[key]))
+            return false;
+
+        h ^= (h << 5) + (h >> 2) + tsvalue(&k[key])->hash;
+    }
+
+    hash = h;
+    return true;
+}
+
+static bool equalTableTemplateKeys(const TableTemplateCache::Entry& entry, const char* data, size_t size, size_t offset, int keys, const TValue* k)
+{
+    if (entry.keys != keys)
+        return false;
+
+    size_t entryOffset = entry.keysOffset;
+
+    for (int i = 0; i < keys; ++i)
+    {
+        int key = readVarInt(data, size, offset);
+        int entryKey = readVarInt(data, size, entryOffset);
+
+        // strings are interned so pointer comparison is sufficient
+        if (tsvalue(&k[key]) != tsvalue(&entry.k[entryKey]))
+            return false;
+    }
+
+    return true;
+}
+
+static Table* findTableTemplate(TableTemplateCache& cache, const char* data, size_t size, size_t offset, int keys, const TValue* k, unsigned int hash)
+{
+    if (cache.count == 0)
+        return NULL;
+
+    size_t mask = cache.capacity - 1;
+
+    for (size_t i = hash & mask; cache.entries[i].table; i = (i + 1) & mask)
+    {
+        const TableTemplateCache::Entry& entry = cache.entries[i];
+
+        if (entry.hash == hash && equalTableTemplateKeys(entry, data, size, offset, keys, k))
+            return entry.table;
+    }
+
+    return NULL;
+}
+
+static void insertTableTemplate(TableTemplateCache& cache, const TableTemplateCache::Entry& entry)
+{
+    // keep the load factor under 0.5; capacity is always a power of two
+    if ((cache.count + 1) * 2 > cache.capacity)
+    {
+        size_t newcapacity = cache.capacity ? cache.capacity * 2 : 64;
+        TableTemplateCache::Entry* newentries = luaM_newarray(cache.L, newcapacity, TableTemplateCache::Entry, 0);
+
+        for (size_t i = 0; i < newcapacity; ++i)
+            newentries[i].table = NULL;
+
+        for (size_t i = 0; i < cache.capacity; ++i)
+        {
+            if (const TableTemplateCache::Entry& old = cache.entries[i]; old.table)
+            {
+                size_t j = old.hash & (newcapacity - 1);
+
+                while (newentries[j].table)
+                    j = (j + 1) & (newcapacity - 1);
+
+                newentries[j] = old;
+            }
+        }
+
+        if (cache.entries)
+            luaM_freearray(cache.L, cache.entries, cache.capacity, TableTemplateCache::Entry, 0);
+
+        cache.entries = newentries;
+        cache.capacity = newcapacity;
+    }
+
+    size_t i = entry.hash & (cache.capacity - 1);
+
+    while (cache.entries[i].table)
+        i = (i + 1) & (cache.capacity - 1);
+
+    cache.entries[i] = entry;
+    cache.count++;
+}
+
 static TString* readString(TempBuffer<TString*>& strings, const char* data, size_t size, size_t& offset)
 {
     unsigned int id = readVarInt(data, size, offset);
@@ -303,6 +433,7 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
     // string table
     unsigned int stringCount = readVarInt(data, size, offset);
     TempBuffer<TString*> strings(L, stringCount);
+    luaS_reserve(L, stringCount);
 
     for (unsigned int i = 0; i < stringCount; ++i)
     {
@@ -310,6 +441,9 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
 
         strings[i] = luaS_newlstr(L, data + offset, length);
         offset += length;
+
+        // long strings are hashed on demand, but constants are likely to be used as table keys
+        luaS_gethash(strings[i]);
     }
 
     // userdata type remapping table
@@ -341,6 +475,8 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
     unsigned int protoCount = readVarInt(data, size, offset);
     TempBuffer<Proto*> protos(L, protoCount);
 
+    TableTemplateCache tableTemplates(L);
+
     for (unsigned int i = 0; i < protoCount; ++i)
     {
         Proto* p = luaF_newproto(L);
@@ -352,6 +488,12 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
         p->nups = read<uint8_t>(data, size, offset);
         p->is_vararg = read<uint8_t>(data, size, offset);
 
+        if (L->global->typeprofiling && p->numparams != 0)
+        {
+            p->argtypes = luaM_newarray(L, p->numparams, uint8_t, p->memcat);
+            memset(p->argtypes, ARGTYPE_NONE, p->numparams);
+        }
+
         if (version >= 4)
         {
             p->flags = read<uint8_t>(data, size, offset);
@@ -418,8 +560,10 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
         p->code = luaM_newarray(L, sizecode, Instruction, p->memcat);
         p->sizecode = sizecode;
 
-        for (int j = 0; j < p->sizecode; ++j)
-            p->code[j] = read<uint32_t>(data, size, offset);
+        // instructions are read in the native byte order like the rest of the bytecode, so the stream is copied in one go; the copy can't be
+        // shared with the caller's data since the interpreter patches instructions to cache table slots and to set breakpoints
+        memcpy(p->code, data + offset, sizecode * sizeof(Instruction));
+        offset += sizecode * sizeof(Instruction);
 
         p->codeentry = p->code;
 
@@ -487,6 +631,20 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
             case LBC_CONSTANT_TABLE:
             {
                 int keys = readVarInt(data, size, offset);
+
+                size_t keysOffset = offset;
+                unsigned int hash = 0;
+                bool shareable = getTableTemplateHash(data, size, keysOffset, keys, p->k, hash);
+
+                if (Table* h = shareable ? findTableTemplate(tableTemplates, data, size, keysOffset, keys, p->k, hash) : NULL)
+                {
+                    for (int i = 0; i < keys; ++i)
+                        readVarInt(data, size, offset);
+
+                    sethvalue(L, &p->k[j], h);
+                    break;
+                }
+
                 Table* h = luaH_new(L, 0, keys);
                 for (int i = 0; i < keys; ++i)
                 {
@@ -495,6 +653,36 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
                     setnvalue(val, 0.0);
                 }
                 sethvalue(L, &p->k[j], h);
+
+                if (shareable)
+                    insertTableTemplate(tableTemplates, {h, p->k, keysOffset, keys, hash});
+                break;
+            }
+
+            case LBC_CONSTANT_TABLE_WITH_CONSTANTS:
+            {
+                // templates with values are specific to one constructor, so unlike key-only templates they aren't shared
+                int keys = readVarInt(data, size, offset);
+
+                Table* h = luaH_new(L, 0, keys);
+                for (int i = 0; i < keys; ++i)
+                {
+                    int key = readVarInt(data, size, offset);
+                    int32_t value = read<int32_t>(data, size, offset);
+                    TValue* val = luaH_set(L, h, &p->k[key]);
+
+                    // constants referenced by the template precede it in the constant table
+                    if (value >= 0)
+                    {
+                        LUAU_ASSERT(value < j);
+                        setobj2t(L, val, &p->k[value]);
+                    }
+                    else
+                    {
+                        setnvalue(val, 0.0);
+                    }
+                }
+                sethvalue(L, &p->k[j], h);
                 break;
             }
 
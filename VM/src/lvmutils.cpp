@@ -6,8 +6,11 @@
 #include "lstring.h"
 #include "ltable.h"
 #include "lgc.h"
+#include "ludata.h"
+#include "lmem.h"
 #include "ldo.h"
 #include "lnumutils.h"
+#include "lbytecode.h"
 
 #include <string.h>
 
@@ -128,6 +131,151 @@ void luaV_gettable(lua_State* L, const TValue* t, TValue* key, StkId val)
     luaG_runerror(L, "'__index' chain too long; possible loop");
 }
 
+void luaV_patchslot(lua_State* L, Proto* p, const Instruction* pc, int slot)
+{
+    int oldslot = LUAU_INSN_C(*pc);
+
+    if (oldslot == uint8_t(slot))
+        return;
+
+    // keep the previous hint so that instructions that alternate between two tables can hit either of them
+    if (!p->slotcache)
+    {
+        p->slotcache = luaM_newarray(L, p->sizecode, uint8_t, p->memcat);
+        memset(p->slotcache, 0, p->sizecode);
+    }
+
+    p->slotcache[pc - p->code] = uint8_t(oldslot);
+
+    *const_cast<Instruction*>(pc) = (uint8_t(slot) << 24) | (0x00ffffffu & *pc);
+}
+
+// checks that a key is absent from the hash part of the table by probing its main position without walking the collision chain
+static bool isabsentkey(Table* h, TString* key)
+{
+    // the key would be in its main position or in the collision chain that starts there
+    const LuaNode* n = &h->node[lmod(key->hash, sizenode(h))];
+
+    return !(ttisstring(gkey(n)) && tsvalue(gkey(n)) == key) && gnext(n) == 0;
+}
+
+const TValue* luaV_getindexchain(lua_State* L, Proto* p, const Instruction* pc, const TValue* t, TString* key)
+{
+    // long strings aren't interned, so the pointer comparisons below are only valid for short strings
+    if (!isshortstr(key))
+        return NULL;
+
+    const IndexChain& chain = p->indexchain[pc - p->code];
+
+    Table* mt = NULL;
+
+    if (ttistable(t))
+        mt = isabsentkey(hvalue(t), key) ? hvalue(t)->metatable : NULL;
+    else
+        mt = ttisuserdata(t) ? uvalue(t)->metatable : L->global->mt[ttype(t)];
+
+    TString* indexname = L->global->tmname[TM_INDEX];
+
+    // every step is validated against the current contents of the tables, so writes to the tables never have to invalidate the chain
+    for (int i = 0; i < chain.depth && mt; i++)
+    {
+        const LuaNode* in = &mt->node[chain.indexslot[i] & mt->nodemask8];
+
+        if (!ttisstring(gkey(in)) || tsvalue(gkey(in)) != indexname || !ttistable(gval(in)))
+            return NULL;
+
+        Table* h = hvalue(gval(in));
+
+        if (i + 1 == chain.depth)
+        {
+            const LuaNode* n = &h->node[chain.slot & h->nodemask8];
+
+            return ttisstring(gkey(n)) && tsvalue(gkey(n)) == key && !ttisnil(gval(n)) ? gval(n) : NULL;
+        }
+
+        if (!isabsentkey(h, key))
+            return NULL;
+
+        mt = h->metatable;
+    }
+
+    return NULL;
+}
+
+void luaV_cacheindexchain(lua_State* L, Proto* p, const Instruction* pc, const TValue* t, TString* key)
+{
+    // chains are validated with pointer comparisons that don't work for long strings, see luaV_getindexchain
+    if (!isshortstr(key))
+        return;
+
+    Table* mt = NULL;
+
+    if (ttistable(t))
+        mt = ttisnil(luaH_getstr(hvalue(t), key)) ? hvalue(t)->metatable : NULL;
+    else
+        mt = ttisuserdata(t) ? uvalue(t)->metatable : L->global->mt[ttype(t)];
+
+    IndexChain chain = {};
+
+    for (int i = 0; i < LUAI_MAXINDEXCHAIN && mt; i++)
+    {
+        const TValue* tm = fasttm(L, mt, TM_INDEX);
+
+        if (!tm || !ttistable(tm))
+            return;
+
+        Table* h = hvalue(tm);
+        const TValue* res = luaH_getstr(h, key);
+
+        chain.indexslot[i] = uint8_t(gval2slot(mt, tm));
+
+        if (!ttisnil(res))
+        {
+            // a single __index table is covered by the slot hint of the instruction
+            if (i == 0)
+                return;
+
+            chain.depth = uint8_t(i + 1);
+            chain.slot = uint8_t(gval2slot(h, res));
+
+            if (!p->indexchain)
+            {
+                p->indexchain = luaM_newarray(L, p->sizecode, IndexChain, p->memcat);
+                memset(p->indexchain, 0, p->sizecode * sizeof(IndexChain));
+            }
+
+            p->indexchain[pc - p->code] = chain;
+            return;
+        }
+
+        mt = h->metatable;
+    }
+}
+
+void luaV_reporthot(lua_State* L, Proto* p)
+{
+    global_State* g = L->global;
+
+    // resetting the counter defers the next report until it wraps around, which is also how disabled counters behave
+    p->hotcount = 0;
+
+    if (g->hotthreshold != 0 && g->cb.hotfunction && !p->execdata)
+        g->cb.hotfunction(L);
+}
+
+void luaV_profileargs(Proto* p, const TValue* args, const TValue* argtop)
+{
+    for (int i = 0; i < p->numparams; i++)
+    {
+        // missing arguments are going to be filled with nil
+        uint8_t tt = args + i < argtop ? uint8_t(ttype(args + i)) : uint8_t(LUA_TNIL);
+        uint8_t& seen = p->argtypes[i];
+
+        if (seen != tt)
+            seen = seen == ARGTYPE_NONE ? tt : ARGTYPE_MIXED;
+    }
+}
+
 void luaV_settable(lua_State* L, const TValue* t, TValue* key, StkId val)
 {
     int loop;
@@ -145,7 +293,12 @@ void luaV_settable(lua_State* L, const TValue* t, TValue* key, StkId val)
             if (!ttisnil(oldval) || (tm = fasttm(L, h->metatable, TM_NEWINDEX)) == NULL)
             {
                 if (h->readonly)
-                    luaG_readonlyerror(L);
+                {
+                    luaH_makewritable(L, h);
+
+                    // shared parts have been copied, so the slot has to be found again
+                    oldval = luaH_get(h, key);
+                }
 
                 // luaH_set would work but would repeat the lookup so we use luaH_setslot that can reuse oldval if it's safe
                 TValue* newval = luaH_setslot(L, h, oldval, key);
@@ -174,6 +327,62 @@ void luaV_settable(lua_State* L, const TValue* t, TValue* key, StkId val)
     luaG_runerror(L, "'__newindex' chain too long; possible loop");
 }
 
+static const lua_UserdataOps* getudataops(lua_State* L, const TValue* p1, const TValue* p2)
+{
+    if (!ttisuserdata(p1) || !ttisuserdata(p2) || uvalue(p1)->tag != uvalue(p2)->tag)
+        return NULL;
+
+    return udataops(L->global, uvalue(p1));
+}
+
+template<TMS op>
+static bool call_udataop(lua_State* L, StkId ra, const TValue* rb, const TValue* rc)
+{
+    const lua_UserdataOps* ops = getudataops(L, rb, rc);
+    if (!ops)
+        return false;
+
+    void (*fn)(lua_State*, void*, const void*, const void*) = NULL;
+
+    switch (op)
+    {
+    case TM_ADD:
+        fn = ops->add;
+        break;
+    case TM_SUB:
+        fn = ops->sub;
+        break;
+    case TM_MUL:
+        fn = ops->mul;
+        break;
+    case TM_DIV:
+        fn = ops->div;
+        break;
+    case TM_UNM:
+        if (!ops->unm)
+            return false;
+        break;
+    default:
+        return false;
+    }
+
+    if (op != TM_UNM && !fn)
+        return false;
+
+    Udata* a = uvalue(rb);
+    Udata* u = luaU_newudata(L, a->len, a->tag);
+    u->metatable = a->metatable;
+
+    if (op == TM_UNM)
+        ops->unm(L, u->data, a->data);
+    else
+        fn(L, u->data, a->data, uvalue(rc)->data);
+
+    setuvalue(L, ra, u);
+    luaC_checkGC(L);
+    return true;
+}
+
 static int call_binTM(lua_State* L, const TValue* p1, const TValue* p2, StkId res, TMS event)
 {
     const TValue* tm = luaT_gettmbyobj(L, p1, event); // try first operand
@@ -254,7 +463,12 @@ int luaV_lessthan(lua_State* L, const TValue* l, const TValue* r)
     else if (ttisstring(l))
         return luaV_strcmp(tsvalue(l), tsvalue(r)) < 0;
     else
+    {
+        if (const lua_UserdataOps* ops = getudataops(L, l, r); ops && ops->lt)
+            return ops->lt(L, uvalue(l)->data, uvalue(r)->data) != 0;
+
         return call_orderTM(L, l, r, TM_LT, /* error= */ true);
+    }
 }
 
 int luaV_lessequal(lua_State* L, const TValue* l, const TValue* r)
@@ -266,6 +480,8 @@ int luaV_lessequal(lua_State* L, const TValue* l, const TValue* r)
         return luai_numle(nvalue(l), nvalue(r));
     else if (ttisstring(l))
         return luaV_strcmp(tsvalue(l), tsvalue(r)) <= 0;
+    else if (const lua_UserdataOps* ops = getudataops(L, l, r); ops && ops->le)
+        return ops->le(L, uvalue(l)->data, uvalue(r)->data) != 0;
     else if ((res = call_orderTM(L, l, r, TM_LE)) != -1) // first try `le'
         return res;
     else if ((res = call_orderTM(L, r, l, TM_LT)) == -1) // error if not `lt'
@@ -291,6 +507,9 @@ int luaV_equalval(lua_State* L, const TValue* t1, const TValue* t2)
         return pvalue(t1) == pvalue(t2) && lightuserdatatag(t1) == lightuserdatatag(t2);
     case LUA_TUSERDATA:
     {
+        if (const lua_UserdataOps* ops = getudataops(L, t1, t2); ops && ops->eq)
+            return ops->eq(L, uvalue(t1)->data, uvalue(t2)->data) != 0;
+
         tm = get_compTM(L, uvalue(t1)->metatable, uvalue(t2)->metatable, TM_EQ);
         if (!tm)
             return uvalue(t1) == uvalue(t2);
@@ -303,6 +522,8 @@ int luaV_equalval(lua_State* L, const TValue* t1, const TValue* t2)
             return hvalue(t1) == hvalue(t2);
         break; // will try TM
     }
+    case LUA_TSTRING:
+        return luaS_eqstr(tsvalue(t1), tsvalue(t2));
     default:
         return gcvalue(t1) == gcvalue(t2);
     }
@@ -502,6 +723,9 @@ void luaV_doarithimpl(lua_State* L, StkId ra, const TValue* rb, const TValue* rc
     }
     else
     {
+        if (call_udataop<op>(L, ra, rb, rc))
+            return;
+
         if (!call_binTM(L, rb, rc, ra, op))
         {
             luaG_aritherror(L, rb, rc, op);
@@ -0,0 +1,24 @@
+local function prequire(name) local success, result = pcall(require, name); return if success then result else nil end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+function test()
+
+    local co = coroutine.wrap(function()
+        local n = 0
+        while true do
+            n += coroutine.yield(n)
+        end
+    end)
+
+    co(0)
+
+    local ts0 = os.clock()
+    for i=1,1000000 do
+        co(1)
+    end
+    local ts1 = os.clock()
+
+    return ts1-ts0
+end
+
+bench.runCode(test, "Coroutine: resume/yield round-trip")
@@ -0,0 +1,32 @@
+local function prequire(name) local success, result = pcall(require, name); return if success then result else nil end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+function test()
+
+    local lines = {}
+    for i=1,100 do
+        lines[i] = string.format("2024-01-%02d 12:%02d:%02d INFO [worker-%d] request id=%d user=user%d status=%d time=%dms", i % 28 + 1, i % 60, i % 60, i % 8, i * 7919, i, 200 + i % 3, i * 3)
+    end
+
+    local ts0 = os.clock()
+    local total = 0
+    for iter=1,1000 do
+        for _, line in lines do
+            local user = string.match(line, "user=(%w+)")
+            local status = string.match(line, "status=(%d+)")
+            local ms = string.match(line, "time=(%d+)ms")
+            if user and status and ms then
+                total += #user + tonumber(status) + tonumber(ms)
+            end
+            for k, v in string.gmatch(line, "(%a+)=(%w+)") do
+                total += #k
+            end
+        end
+    end
+    local ts1 = os.clock()
+
+    assert(total > 0)
+    return ts1-ts0
+end
+
+bench.runCode(test, "StringMatch: log line fields")
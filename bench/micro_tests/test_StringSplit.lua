@@ -0,0 +1,23 @@
+local function prequire(name) local success, result = pcall(require, name); return if success then result else nil end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+function test()
+
+    local fields = {}
+    for i=1,200 do
+        fields[i] = string.rep(string.char(97 + i % 26), 10 + i % 30)
+    end
+    local payload = table.concat(fields, ",")
+
+    local ts0 = os.clock()
+    local total = 0
+    for i=1,2000 do
+        total += #string.split(payload, ",")
+    end
+    local ts1 = os.clock()
+
+    assert(total == 2000 * 200)
+    return ts1-ts0
+end
+
+bench.runCode(test, "StringSplit: multi-KB payload")
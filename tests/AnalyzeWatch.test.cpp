@@ -0,0 +1,132 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "AnalyzeWatch.h"
+#include "FileUtils.h"
+
+#include "Luau/Ast.h"
+#include "Luau/Frontend.h"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <stdlib.h>
+#include <unistd.h>
+
+struct DiskFileResolver : Luau::FileResolver
+{
+    std::optional<Luau::SourceCode> readSource(const Luau::ModuleName& name) override
+    {
+        std::optional<std::string> source = readFile(name);
+        if (!source)
+            return std::nullopt;
+
+        return Luau::SourceCode{*source, Luau::SourceCode::Module};
+    }
+
+    std::optional<Luau::ModuleInfo> resolveModule(const Luau::ModuleInfo* context, Luau::AstExpr* expr) override
+    {
+        if (Luau::AstExprConstantString* str = expr->as<Luau::AstExprConstantString>())
+            return Luau::ModuleInfo{dir + "/" + std::string(str->value.data, str->value.size)};
+
+        return std::nullopt;
+    }
+
+    std::string dir;
+};
+
+// modification times can be coarse, so the file is rewritten until its timestamp changes
+static void rewriteFile(const std::string& path, const std::string& contents)
+{
+    std::optional<int64_t> before = getFileModificationTime(path);
+
+    for (int attempt = 0; attempt < 300; ++attempt)
+    {
+        REQUIRE(writeFile(path, contents));
+
+        if (getFileModificationTime(path) != before)
+            return;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    FAIL("modification time of " << path << " didn't change");
+}
+
+static std::vector<Luau::ModuleName> checkModules(Luau::Frontend& frontend, const std::vector<std::string>& files)
+{
+    for (const std::string& path : files)
+        frontend.queueModuleCheck(path);
+
+    std::vector<Luau::ModuleName> checked = frontend.checkQueuedModules();
+    std::sort(checked.begin(), checked.end());
+    return checked;
+}
+
+TEST_SUITE_BEGIN("AnalyzeWatchTests");
+
+TEST_CASE("AnalyzeWatchChangedFiles")
+{
+    char dir[] = "/tmp/luau-watch-XXXXXX";
+    REQUIRE(mkdtemp(dir));
+
+    std::string main = std::string(dir) + "/main.luau";
+    std::string lib = std::string(dir) + "/lib.luau";
+    std::string other = std::string(dir) + "/other.luau";
+    std::string extra = std::string(dir) + "/extra.luau";
+
+    REQUIRE(writeFile(lib, "return { value = 1 }\n"));
+    REQUIRE(writeFile(main, "local lib = require('lib.luau')\nlocal extra = require('extra.luau')\nreturn lib.value\n"));
+    REQUIRE(writeFile(other, "return 2\n"));
+
+    DiskFileResolver fileResolver;
+    fileResolver.dir = dir;
+    Luau::NullConfigResolver configResolver;
+    Luau::Frontend frontend(&fileResolver, &configResolver);
+
+    std::vector<std::string> files = {main, other};
+    CHECK(checkModules(frontend, files) == std::vector<Luau::ModuleName>{lib, main, other});
+
+    WatchedFiles watched;
+    addWatchedFiles(frontend, watched);
+
+    // required modules are watched even if they don't exist yet
+    REQUIRE(watched.count(extra));
+    CHECK(!watched[extra].timestamp);
+
+    CHECK(!markChangedFiles(frontend, watched));
+    CHECK(checkModules(frontend, files).empty());
+
+    // a changed module is checked again together with the modules requiring it
+    rewriteFile(lib, "return { value = 'changed' }\n");
+
+    CHECK(markChangedFiles(frontend, watched));
+    CHECK(frontend.isDirty(lib));
+    CHECK(frontend.isDirty(main));
+    CHECK(!frontend.isDirty(other));
+
+    CHECK(checkModules(frontend, files) == std::vector<Luau::ModuleName>{lib, main});
+    CHECK(!markChangedFiles(frontend, watched));
+
+    // creating a module that was missing re-checks the modules requiring it
+    REQUIRE(writeFile(extra, "return 3\n"));
+
+    CHECK(markChangedFiles(frontend, watched));
+    CHECK(frontend.isDirty(main));
+    CHECK(!frontend.isDirty(other));
+
+    CHECK(checkModules(frontend, files) == std::vector<Luau::ModuleName>{extra, main});
+
+    unlink(main.c_str());
+    unlink(lib.c_str());
+    unlink(other.c_str());
+    unlink(extra.c_str());
+    rmdir(dir);
+}
+
+TEST_SUITE_END();
+#endif
@@ -333,6 +333,44 @@ TEST_CASE_FIXTURE(Fixture, "find_expr_ancestry")
     CHECK(ancestry.back()->is<AstExprFunction>());
 }
 
+TEST_CASE_FIXTURE(Fixture, "ancestry_in_block_with_many_statements")
+{
+    std::string source;
+    for (int i = 0; i < 100; i++)
+        source += "local a" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+
+    source += "do\n    local b = a50 + a51\nend\n";
+
+    for (int i = 0; i < 100; i++)
+        source += "local c" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+
+    AstStatBlock* block = parse(source);
+    const Position pos(101, 15);
+
+    std::vector<AstNode*> ancestry = findAstAncestryOfPosition(block, pos);
+    REQUIRE_GE(ancestry.size(), 3);
+    CHECK(ancestry[1]->is<AstStatBlock>());
+    CHECK(ancestry.back()->is<AstExprLocal>());
+
+    std::vector<AstNode*> acAncestry = findAncestryAtPositionForAutocomplete(block, pos);
+    REQUIRE_GE(acAncestry.size(), 3);
+    CHECK(acAncestry[1]->is<AstStatBlock>());
+    CHECK(acAncestry.back()->is<AstExprLocal>());
+
+    CHECK(findNodeAtPosition(block, pos) == ancestry.back());
+
+    SourceModule sourceModule;
+    sourceModule.root = block;
+    CHECK(findExprOrLocalAtPosition(sourceModule, pos).getExpr() == ancestry.back());
+
+    // positions in the middle of the root block only visit the statement around them
+    std::vector<AstNode*> rootAncestry = findAncestryAtPositionForAutocomplete(block, Position(150, 5));
+    REQUIRE_GE(rootAncestry.size(), 2);
+    CHECK(rootAncestry[0] == block);
+    CHECK(rootAncestry[1]->is<AstStatLocal>());
+    CHECK(rootAncestry[1]->location.begin.line == 150);
+}
+
 TEST_CASE_FIXTURE(BuiltinsFixture, "find_binding_at_position_global_start_of_file")
 {
     ScopedFastFlag sff{FFlag::LuauFixBindingForGlobalPos, true};
@@ -1329,6 +1329,38 @@ TEST_CASE_FIXTURE(ACFixture, "sometimes_the_metatable_is_an_error")
     // Don't crash!
 }
 
+TEST_CASE_FIXTURE(ACFixture, "cached_member_completions_depend_on_location_and_module_version")
+{
+    check(R"(
+        local t = { alpha = 1, beta = "x" }
+        local n: number = t.@1
+        local s: string = t.@2
+    )");
+
+    for (int i = 0; i < 2; ++i)
+    {
+        auto ac = autocomplete('1');
+        CHECK_EQ(2, ac.entryMap.size());
+        CHECK_EQ(ac.entryMap["alpha"].typeCorrect, TypeCorrectKind::Correct);
+        CHECK_EQ(ac.entryMap["beta"].typeCorrect, TypeCorrectKind::None);
+    }
+
+    auto ac = autocomplete('2');
+    CHECK_EQ(2, ac.entryMap.size());
+    CHECK_EQ(ac.entryMap["alpha"].typeCorrect, TypeCorrectKind::None);
+    CHECK_EQ(ac.entryMap["beta"].typeCorrect, TypeCorrectKind::Correct);
+
+    check(R"(
+        local t = { alpha = 1, gamma = "x" }
+        local n: number = t.@1
+    )");
+
+    ac = autocomplete('1');
+    CHECK_EQ(2, ac.entryMap.size());
+    CHECK(ac.entryMap.count("alpha"));
+    CHECK(ac.entryMap.count("gamma"));
+}
+
 TEST_CASE_FIXTURE(ACFixture, "local_types_builtin")
 {
     check(R"(
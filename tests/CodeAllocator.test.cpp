@@ -119,6 +119,108 @@ TEST_CASE("CodeAllocationFailure")
     REQUIRE(!allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData, sizeNativeData, nativeEntry));
 }
 
+TEST_CASE("CodeAllocationReuse")
+{
+    size_t blockSize = 64 * 1024;
+    size_t maxTotalSize = 128 * 1024;
+    CodeAllocator allocator(blockSize, maxTotalSize);
+
+    uint8_t* nativeData1 = nullptr;
+    size_t sizeNativeData1 = 0;
+    uint8_t* nativeEntry1 = nullptr;
+
+    uint8_t* nativeData2 = nullptr;
+    size_t sizeNativeData2 = 0;
+    uint8_t* nativeEntry2 = nullptr;
+
+    std::vector<uint8_t> code;
+    code.resize(128);
+
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData1, sizeNativeData1, nativeEntry1));
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData2, sizeNativeData2, nativeEntry2));
+
+    CodeAllocationStats stats = allocator.getStats();
+    CHECK(stats.blockCount == 1);
+    CHECK(stats.allocatedSize != 0);
+    CHECK(stats.freeRangeCount == 0);
+
+    size_t allocatedSize = stats.allocatedSize;
+
+    allocator.deallocate(nativeData1, sizeNativeData1);
+
+    stats = allocator.getStats();
+    CHECK(stats.allocatedSize < allocatedSize);
+    CHECK(stats.freeRangeCount == 1);
+    CHECK(stats.freeRangeSize == allocatedSize - stats.allocatedSize);
+
+    // released memory is reused by the next allocation that fits
+    uint8_t* nativeData3 = nullptr;
+    size_t sizeNativeData3 = 0;
+    uint8_t* nativeEntry3 = nullptr;
+
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData3, sizeNativeData3, nativeEntry3));
+    CHECK(nativeData3 == nativeData1);
+    CHECK(allocator.getStats().freeRangeCount == 0);
+    CHECK(allocator.getStats().allocatedSize == allocatedSize);
+
+    // adjacent released ranges are merged
+    allocator.deallocate(nativeData3, sizeNativeData3);
+    allocator.deallocate(nativeData2, sizeNativeData2);
+
+    stats = allocator.getStats();
+    CHECK(stats.allocatedSize == 0);
+    CHECK(stats.freeRangeCount == 1);
+    CHECK(stats.largestFreeRange == allocatedSize);
+}
+
+TEST_CASE("CodeAllocationBlockRelease")
+{
+    struct AllocationData
+    {
+        size_t bytesAllocated = 0;
+        size_t bytesFreed = 0;
+    };
+
+    AllocationData allocationData{};
+
+    const auto allocationCallback = [](void* context, void* oldPointer, size_t oldSize, void* newPointer, size_t newSize) {
+        AllocationData& allocationData = *static_cast<AllocationData*>(context);
+
+        allocationData.bytesFreed += oldSize;
+        allocationData.bytesAllocated += newSize;
+    };
+
+    size_t blockSize = 64 * 1024;
+    size_t maxTotalSize = 128 * 1024;
+    CodeAllocator allocator(blockSize, maxTotalSize, allocationCallback, &allocationData);
+
+    uint8_t* nativeData[3] = {};
+    size_t sizeNativeData[3] = {};
+    uint8_t* nativeEntry[3] = {};
+
+    // each allocation takes most of a block
+    std::vector<uint8_t> code;
+    code.resize(blockSize - 4096);
+
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[0], sizeNativeData[0], nativeEntry[0]));
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[1], sizeNativeData[1], nativeEntry[1]));
+    REQUIRE(!allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[2], sizeNativeData[2], nativeEntry[2]));
+
+    CHECK(allocationData.bytesAllocated == 2 * blockSize);
+    CHECK(allocationData.bytesFreed == 0);
+
+    // the first block has no live allocations and we no longer allocate from it, so it is returned to the system
+    allocator.deallocate(nativeData[0], sizeNativeData[0]);
+
+    CHECK(allocationData.bytesFreed == blockSize);
+    CHECK(allocator.getStats().blockCount == 1);
+
+    // which makes room for a new block under the limit
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[2], sizeNativeData[2], nativeEntry[2]));
+    CHECK(allocator.getStats().blockCount == 2);
+    CHECK(allocationData.bytesAllocated == 3 * blockSize);
+}
+
 TEST_CASE("CodeAllocationWithUnwindCallbacks")
 {
     struct Info
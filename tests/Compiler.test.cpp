@@ -10,6 +10,8 @@
 #include <sstream>
 #include <string_view>
 
+#include <string.h>
+
 namespace Luau
 {
 std::string rep(const std::string& s, size_t n);
@@ -24,6 +26,10 @@ LUAU_FASTINT(LuauRecursionLimit)
 
 LUAU_FASTFLAG(LuauCompileUserdataInfo)
 LUAU_FASTFLAG(LuauCompileFastcall3)
+LUAU_FASTFLAG(LuauCompileVectorLibrary)
+LUAU_FASTFLAG(LuauCompileTableRemove)
+LUAU_FASTFLAG(LuauCompileTableConstants)
+LUAU_FASTFLAG(LuauCompileStringFormat)
 
 using namespace Luau;
 
@@ -622,6 +628,58 @@ RETURN R0 3
 )");
 }
 
+TEST_CASE("TableLiteralsConstantValues")
+{
+    ScopedFastFlag luauCompileTableConstants{FFlag::LuauCompileTableConstants, true};
+
+    // constant values are stored in the template
+    CHECK_EQ("\n" + compileFunction("local function f() return {a=1,b='x',c=true} end", 0), R"(
+DUPTABLE R0 6
+RETURN R0 1
+)");
+
+    // other values are assigned after the template is cloned; nil values are never stored in the template
+    CHECK_EQ("\n" + compileFunction("local function f(x) return {a=1,b=x,c=nil} end", 0), R"(
+DUPTABLE R1 4
+SETTABLEKS R0 R1 K2 ['b']
+LOADNIL R2
+SETTABLEKS R2 R1 K3 ['c']
+RETURN R1 1
+)");
+
+    // when the key is repeated, all values are assigned in order
+    CHECK_EQ("\n" + compileFunction("local function f(x) return {a=x,a=1} end", 0), R"(
+DUPTABLE R1 1
+SETTABLEKS R0 R1 K0 ['a']
+LOADN R2 1
+SETTABLEKS R2 R1 K0 ['a']
+RETURN R1 1
+)");
+
+    // templates are shared between literals with the same keys and values
+    CHECK_EQ("\n" + compileFunction("local function f() return {a=1,b=2},{a=1,b=3},{a=1,b=2} end", 0), R"(
+DUPTABLE R0 4
+DUPTABLE R1 6
+DUPTABLE R2 4
+RETURN R0 3
+)");
+
+    // top-level code outside of loops executes once, so values are assigned explicitly
+    CHECK_EQ("\n" + compileFunction0("local t = {a=1} for i=1,2 do t = {a=1} end return t"), R"(
+DUPTABLE R0 1
+LOADN R1 1
+SETTABLEKS R1 R0 K0 ['a']
+LOADN R3 1
+LOADN R1 2
+LOADN R2 1
+FORNPREP R1 L1
+L0: DUPTABLE R4 3
+MOVE R0 R4
+FORNLOOP R1 L0
+L1: RETURN R0 1
+)");
+}
+
 TEST_CASE("TableLiteralsNumberIndex")
 {
     // tables with [x] compile to SETTABLEN if the index is short
@@ -1371,6 +1429,34 @@ TEST_CASE("InterpStringRegisterLimit")
     CHECK_THROWS_AS(compileFunction0(("local a = `" + rep("{1}", 253) + "`").c_str()), std::exception);
 }
 
+TEST_CASE("InterpStringFastcall")
+{
+    ScopedFastFlag luauCompileStringFormat{FFlag::LuauCompileStringFormat, true};
+
+    CHECK_EQ("\n" + compileFunction0(R"(local a, b = ... return `{a}, {b}!`)"), R"(
+GETVARARGS R0 2
+LOADK R4 K0 ['%*, %*!']
+MOVE R5 R0
+MOVE R6 R1
+FASTCALL 91 L0
+NAMECALL R3 R4 K1 ['format']
+CALL R3 3 1
+L0: MOVE R2 R3
+RETURN R2 1
+)");
+
+    // string.format calls use the same builtin
+    CHECK_EQ("\n" + compileFunction0(R"(local a = ... return string.format("%d", a))"), R"(
+GETVARARGS R0 1
+LOADK R2 K0 ['%d']
+FASTCALL2 91 R2 R0 L0
+MOVE R3 R0
+GETIMPORT R1 3 [string.format]
+CALL R1 2 -1
+L0: RETURN R1 -1
+)");
+}
+
 TEST_CASE("ConstantFoldArith")
 {
     CHECK_EQ("\n" + compileFunction0("return 10 + 2"), R"(
@@ -1916,6 +2002,67 @@ RETURN R0 0
 )");
 }
 
+static void setTestGlobalConstant(const char* name, Luau::CompileConstant* constant)
+{
+    if (strcmp(name, "DEBUG") == 0)
+        Luau::setCompileConstantBoolean(constant, false);
+    else if (strcmp(name, "PLATFORM") == 0)
+        Luau::setCompileConstantString(constant, "server", 6);
+    else if (strcmp(name, "LIMIT") == 0)
+        Luau::setCompileConstantNumber(constant, 42);
+}
+
+static std::string compileWithGlobalConstants(const char* source)
+{
+    static const char* const kConstantGlobals[] = {"DEBUG", "PLATFORM", "LIMIT", "UNKNOWN", nullptr};
+
+    Luau::BytecodeBuilder bcb;
+    bcb.setDumpFlags(Luau::BytecodeBuilder::Dump_Code);
+    Luau::CompileOptions options;
+    options.constantGlobals = kConstantGlobals;
+    options.globalConstantCb = setTestGlobalConstant;
+    Luau::compileOrThrow(bcb, source, options);
+
+    return bcb.dumpFunction(0);
+}
+
+TEST_CASE("ConstantFoldHostGlobals")
+{
+    // branches on host-provided constants are removed
+    CHECK_EQ("\n" + compileWithGlobalConstants("if DEBUG then print('debug') end"), R"(
+RETURN R0 0
+)");
+
+    CHECK_EQ("\n" + compileWithGlobalConstants("if PLATFORM == 'server' then print(LIMIT * 2) end"), R"(
+GETIMPORT R0 1 [print]
+LOADN R1 84
+CALL R0 1 0
+RETURN R0 0
+)");
+
+    // globals that the callback doesn't provide a value for stay dynamic
+    CHECK_EQ("\n" + compileWithGlobalConstants("return UNKNOWN"), R"(
+GETIMPORT R0 1 [UNKNOWN]
+RETURN R0 1
+)");
+
+    // globals that are assigned in the module aren't folded
+    CHECK_EQ("\n" + compileWithGlobalConstants("DEBUG = true return DEBUG"), R"(
+LOADB R0 1
+SETGLOBAL R0 K0 ['DEBUG']
+GETGLOBAL R0 K0 ['DEBUG']
+RETURN R0 1
+)");
+
+    // getfenv/setfenv can replace the values of globals at runtime
+    CHECK_EQ("\n" + compileWithGlobalConstants("getfenv() return LIMIT"), R"(
+GETIMPORT R0 1 [getfenv]
+CALL R0 0 0
+GETIMPORT R0 3 [LIMIT]
+RETURN R0 1
+)");
+}
+
 TEST_CASE("LoopContinueIgnoresImplicitConstant")
 {
     // this used to crash the compiler :(
@@ -3222,6 +3369,73 @@ RETURN R0 0
 )");
 }
 
+TEST_CASE("RemoveRedundantInstructions")
+{
+    Luau::BytecodeBuilder bcb;
+    bcb.setDumpFlags(Luau::BytecodeBuilder::Dump_Code | Luau::BytecodeBuilder::Dump_Remarks);
+
+    uint32_t fid = bcb.beginFunction(1);
+
+    bcb.emitABC(LOP_LOADNIL, 1, 0, 0);
+
+    size_t jumpLabel = bcb.emitLabel();
+    bcb.emitAD(LOP_JUMP, 0, 0);
+
+    size_t targetLabel = bcb.emitLabel();
+    bcb.emitABC(LOP_MOVE, 1, 0, 0);
+    bcb.emitABC(LOP_MOVE, 0, 1, 0);
+    bcb.emitABC(LOP_RETURN, 1, 2, 0);
+    bcb.emitAD(LOP_LOADN, 1, 42);
+    bcb.emitABC(LOP_RETURN, 1, 2, 0);
+
+    CHECK(bcb.patchJumpD(jumpLabel, targetLabel));
+
+    bcb.removeRedundantInstructions();
+    bcb.endFunction(2, 0);
+
+    bcb.setMainFunction(fid);
+    bcb.finalize();
+
+    // the last instruction is always kept
+    CHECK_EQ("\n" + bcb.dumpFunction(0), R"(
+LOADNIL R1
+REMARK removed jump to next instruction
+MOVE R1 R0
+REMARK removed redundant MOVE R0 R1
+RETURN R1 1
+REMARK removed 1 unreachable instructions
+RETURN R1 1
+)");
+}
+
+TEST_CASE("RemoveRedundantJumpsAfterInline")
+{
+    const char* source = R"(
+local function pick(a, b)
+    if a then
+        return b
+    else
+        return -b
+    end
+end
+
+local x = ...
+return pick(x, 2) * 3
+)";
+
+    // the jump at the end of the last inlined return targets the next instruction and is removed
+    CHECK_EQ("\n" + compileFunction(source, 1, 2), R"(
+DUPCLOSURE R0 K0 ['pick']
+GETVARARGS R1 1
+JUMPIFNOT R1 L0
+LOADN R3 2
+JUMP L1
+L0: LOADN R3 -2
+L1: MULK R2 R3 K1 [3]
+RETURN R2 1
+)");
+}
+
 TEST_CASE("DebugTypes")
 {
     ScopedFastFlag luauCompileUserdataInfo{FFlag::LuauCompileUserdataInfo, true};
@@ -3551,13 +3765,23 @@ FORNLOOP R1 L1
 L3: RETURN R0 1
 )");
 
-    // currently we assume a single value return to avoid dealing with stack resizing
+    // multiple results are read directly as well, which covers forwarding of a suffix of the arguments
     CHECK_EQ("\n" + compileFunction0("return select('#', ...)"), R"(
-GETIMPORT R0 1 [select]
-LOADK R1 K2 ['#']
+LOADK R1 K0 ['#']
+FASTCALL1 57 R1 L0
+GETIMPORT R0 2 [select]
 GETVARARGS R2 -1
 CALL R0 -1 -1
-RETURN R0 -1
+L0: RETURN R0 -1
+)");
+
+    CHECK_EQ("\n" + compileFunction0("local a, b = select(2, ...) return a, b"), R"(
+LOADN R1 2
+FASTCALL1 57 R1 L0
+GETIMPORT R0 1 [select]
+GETVARARGS R2 -1
+CALL R0 -1 2
+L0: RETURN R0 2
 )");
 
     // note that select with a non-variadic second argument doesn't get optimized
@@ -4574,6 +4798,167 @@ L5: RETURN R0 0
 )");
 }
 
+TEST_CASE("HoistedLoopClosure")
+{
+    // closures in loops that capture immutable values from outside of the loop are created once before the loop
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(t, desc)
+    for _, v in t do
+        table.sort(v, function(a, b) return if desc then a > b else a < b end)
+    end
+end
+)",
+                        1),
+        R"(
+NEWCLOSURE R2 P0
+CAPTURE VAL R1
+MOVE R3 R0
+LOADNIL R4
+LOADNIL R5
+FORGPREP R3 L1
+L0: GETIMPORT R8 2 [table.sort]
+MOVE R9 R7
+MOVE R10 R2
+CALL R8 2 0
+L1: FORGLOOP R3 L0 2
+RETURN R0 0
+)");
+
+    // closures that capture loop variables or locals declared in the loop are created on every iteration
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(t)
+    for i = 1, #t do
+        local x = t[i]
+        t[i] = function() return i + x end
+    end
+end
+)",
+                        1),
+        R"(
+LOADN R3 1
+LENGTH R1 R0
+LOADN R2 1
+FORNPREP R1 L1
+L0: GETTABLE R4 R0 R3
+NEWCLOSURE R5 P0
+CAPTURE VAL R3
+CAPTURE VAL R4
+SETTABLE R5 R0 R3
+FORNLOOP R1 L0
+L1: RETURN R0 0
+)");
+
+    // ... as are closures that capture mutable values
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(t)
+    local sum = 0
+    while #t > 0 do
+        table.remove(t)(function() return sum end)
+    end
+    sum = 1
+end
+)",
+                        1),
+        R"(
+LOADN R1 0
+L0: LENGTH R2 R0
+LOADN R3 0
+JUMPIFNOTLT R3 R2 L1
+GETIMPORT R2 2 [table.remove]
+MOVE R3 R0
+CALL R2 1 1
+NEWCLOSURE R3 P0
+CAPTURE REF R1
+CALL R2 1 0
+JUMPBACK L0
+L1: LOADN R1 1
+CLOSEUPVALS R1
+RETURN R0 0
+)");
+
+    // closures in nested loops are hoisted out of the innermost loop that defines their upvalues
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(t)
+    for i = 1, #t do
+        for j = 1, #t[i] do
+            t[i][j](function() return i end)
+        end
+    end
+end
+)",
+                        1),
+        R"(
+LOADN R3 1
+LENGTH R1 R0
+LOADN R2 1
+FORNPREP R1 L3
+L0: NEWCLOSURE R4 P0
+CAPTURE VAL R3
+LOADN R7 1
+GETTABLE R8 R0 R3
+LENGTH R5 R8
+LOADN R6 1
+FORNPREP R5 L2
+L1: GETTABLE R9 R0 R3
+GETTABLE R8 R9 R7
+MOVE R9 R4
+CALL R8 1 0
+FORNLOOP R5 L1
+L2: FORNLOOP R1 L0
+L3: RETURN R0 0
+)");
+
+    // closures hoisted out of an outer loop are not hoisted again by the inner loops
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(t, desc)
+    for _, v in t do
+        for _, w in v do
+            table.sort(w, function(a, b) return if desc then a > b else a < b end)
+        end
+    end
+end
+)",
+                        1),
+        R"(
+NEWCLOSURE R2 P0
+CAPTURE VAL R1
+MOVE R3 R0
+LOADNIL R4
+LOADNIL R5
+FORGPREP R3 L3
+L0: MOVE R8 R7
+LOADNIL R9
+LOADNIL R10
+FORGPREP R8 L2
+L1: GETIMPORT R13 2 [table.sort]
+MOVE R14 R12
+MOVE R15 R2
+CALL R13 2 0
+L2: FORGLOOP R8 L1 2
+L3: FORGLOOP R3 L0 2
+RETURN R0 0
+)");
+
+    // the optimization requires optimization level 1
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(t, desc)
+    repeat
+        t(function() return desc end)
+    until not t
+end
+)",
+                        1, 0),
+        R"(
+L0: MOVE R2 R0
+NEWCLOSURE R3 P0
+CAPTURE VAL R1
+CALL R2 1 0
+JUMPIFNOT R0 L1
+JUMPBACK L0
+L1: RETURN R0 0
+)");
+}
+
 TEST_CASE("MutableGlobals")
 {
     const char* source = R"(
@@ -4720,6 +5105,41 @@ L0: RETURN R3 -1
 )");
 }
 
+TEST_CASE("HostBuiltinFastCall")
+{
+    const char* source = R"(
+local a, b = ...
+return lerp(a, b, 0.5), geom.dist(a, b), geom.other(a)
+)";
+
+    const char* hostBuiltins[] = {"lerp", "geom.dist", nullptr};
+
+    Luau::BytecodeBuilder bcb;
+    bcb.setDumpFlags(Luau::BytecodeBuilder::Dump_Code);
+    Luau::CompileOptions options;
+    options.hostBuiltins = hostBuiltins;
+    Luau::compileOrThrow(bcb, source, options);
+
+    CHECK_EQ("\n" + bcb.dumpFunction(0), R"(
+GETVARARGS R0 2
+MOVE R3 R0
+MOVE R4 R1
+LOADK R5 K0 [0.5]
+FASTCALL 224 L0
+GETIMPORT R2 2 [lerp]
+CALL R2 3 1
+L0: FASTCALL2 225 R0 R1 L1
+MOVE R4 R0
+MOVE R5 R1
+GETIMPORT R3 5 [geom.dist]
+CALL R3 2 1
+L1: GETIMPORT R4 7 [geom.other]
+MOVE R5 R0
+CALL R4 1 -1
+RETURN R2 -1
+)");
+}
+
 TEST_CASE("VectorLiterals")
 {
     CHECK_EQ("\n" + compileFunction("return Vector3.new(1, 2, 3)", 0, 2, /*enableVectors*/ true), R"(
@@ -5344,6 +5764,117 @@ L1: RETURN R0 0
 )");
 }
 
+TEST_CASE("LoopUnrollIpairs")
+{
+    // ipairs over a local array of constants that is never modified can be unrolled
+    CHECK_EQ("\n" + compileFunction(R"(
+local axes = {"x", "y", "z"}
+
+for i, a in ipairs(axes) do
+    print(i, a)
+end
+)",
+                        0, 2),
+        R"(
+NEWTABLE R0 0 3
+LOADK R1 K0 ['x']
+LOADK R2 K1 ['y']
+LOADK R3 K2 ['z']
+SETLIST R0 R1 3 [1]
+GETIMPORT R1 4 [print]
+LOADN R2 1
+LOADK R3 K0 ['x']
+CALL R1 2 0
+GETIMPORT R1 4 [print]
+LOADN R2 2
+LOADK R3 K1 ['y']
+CALL R1 2 0
+GETIMPORT R1 4 [print]
+LOADN R2 3
+LOADK R3 K2 ['z']
+CALL R1 2 0
+RETURN R0 0
+)");
+
+    // arrays that are modified or passed to other functions can't be unrolled
+    CHECK_EQ("\n" + compileFunction(R"(
+local t = {1, 2}
+t[1] = 0
+
+for _, v in ipairs(t) do
+    print(v)
+end
+
+local u = {1, 2}
+table.insert(u, 3)
+
+for _, v in ipairs(u) do
+    print(v)
+end
+)",
+                        0, 2),
+        R"(
+NEWTABLE R0 0 2
+LOADN R1 1
+LOADN R2 2
+SETLIST R0 R1 2 [1]
+LOADN R1 0
+SETTABLEN R1 R0 1
+GETIMPORT R1 1 [ipairs]
+MOVE R2 R0
+CALL R1 1 3
+FORGPREP_INEXT R1 L1
+L0: GETIMPORT R6 3 [print]
+MOVE R7 R5
+CALL R6 1 0
+L1: FORGLOOP R1 L0 2 [inext]
+NEWTABLE R1 0 2
+LOADN R2 1
+LOADN R3 2
+SETLIST R1 R2 2 [1]
+FASTCALL2K 52 R1 K4 L2 [3]
+MOVE R3 R1
+LOADK R4 K4 [3]
+GETIMPORT R2 7 [table.insert]
+CALL R2 2 0
+L2: GETIMPORT R2 1 [ipairs]
+MOVE R3 R1
+CALL R2 1 3
+FORGPREP_INEXT R2 L4
+L3: GETIMPORT R7 3 [print]
+MOVE R8 R6
+CALL R7 1 0
+L4: FORGLOOP R2 L3 2 [inext]
+RETURN R0 0
+)");
+
+    // ipairs stops at the first nil element, so all elements need to be known
+    CHECK_EQ("\n" + compileFunction(R"(
+local t = {1, nil, ...}
+
+for _, v in ipairs(t) do
+    print(v)
+end
+)",
+                        0, 2),
+        R"(
+NEWTABLE R0 0 2
+LOADN R1 1
+LOADNIL R2
+GETVARARGS R3 -1
+SETLIST R0 R1 -1 [1]
+GETIMPORT R1 1 [ipairs]
+MOVE R2 R0
+CALL R1 1 3
+FORGPREP_INEXT R1 L1
+L0: GETIMPORT R6 3 [print]
+MOVE R7 R5
+CALL R6 1 0
+L1: FORGLOOP R1 L0 2 [inext]
+RETURN R0 0
+)");
+}
+
 TEST_CASE("LoopUnrollCostBuiltins")
 {
     ScopedFastInt sfis[] = {
@@ -6222,6 +6753,111 @@ RETURN R3 1
 )");
 }
 
+TEST_CASE("FoldPureCalls")
+{
+    // on O3, calls to local functions with constant arguments are evaluated at compile time; compare with InlineChain
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(a, b)
+    return a + b
+end
+
+local function bar(x)
+    return foo(x, 1) * foo(x, -1)
+end
+
+local function baz()
+    return (bar(42))
+end
+
+return (baz())
+)",
+                        3, 3),
+        R"(
+DUPCLOSURE R0 K0 ['foo']
+DUPCLOSURE R1 K1 ['bar']
+DUPCLOSURE R2 K2 ['baz']
+LOADN R3 1763
+RETURN R3 1
+)");
+
+    // missing arguments are nil, and branches not taken don't need to be constant
+    CHECK_EQ("\n" + compileFunction(R"(
+local function opt(a, b)
+    return b == nil and a or b
+end
+
+local function pick(c, x)
+    return if c then x else tostring(x)
+end
+
+return opt(5), pick(true, 1), opt(1, 2)
+)",
+                        2, 3),
+        R"(
+DUPCLOSURE R0 K0 ['opt']
+DUPCLOSURE R1 K1 ['pick']
+LOADN R2 5
+LOADN R3 1
+LOADN R4 2
+RETURN R2 3
+)");
+
+    // functions that aren't a single expression, recursive functions and non-constant arguments don't fold
+    CHECK_EQ("\n" + compileFunction(R"(
+local function rec(x)
+    return rec(x)
+end
+
+local function id(x)
+    local y = x
+    return y
+end
+
+local function add(a, b)
+    return a + b
+end
+
+return rec(1), id(2), add(1, ...)
+)",
+                        3, 3),
+        R"(
+DUPCLOSURE R0 K0 ['rec']
+CAPTURE VAL R0
+DUPCLOSURE R1 K1 ['id']
+DUPCLOSURE R2 K2 ['add']
+MOVE R3 R0
+LOADN R4 1
+CALL R3 1 1
+LOADN R4 2
+GETVARARGS R6 1
+LOADN R7 1
+ADD R5 R7 R6
+RETURN R3 3
+)");
+
+    // calls aren't evaluated below O3
+    CHECK_EQ("\n" + compileFunction(R"(
+local function foo(a, b)
+    return a + b
+end
+
+local function bar(x)
+    return foo(x, 1) * foo(x, -1)
+end
+
+return (bar(42))
+)",
+                        2, 2),
+        R"(
+DUPCLOSURE R0 K0 ['foo']
+DUPCLOSURE R1 K1 ['bar']
+LOADN R3 43
+LOADN R4 41
+MUL R2 R3 R4
+RETURN R2 1
+)");
+}
+
 TEST_CASE("InlineThresholds")
 {
     ScopedFastInt sfis[] = {
@@ -6490,22 +7126,6 @@ L2: JUMPIFNOT R1 L3
 LOADNIL R1
 LOADB R2 1
 RETURN R2 1
-LOADB R2 1
-RETURN R2 1
-LOADB R2 1
-RETURN R2 1
-LOADB R2 1
-RETURN R2 1
-LOADB R2 1
-RETURN R2 1
-LOADB R2 1
-RETURN R2 1
-LOADB R2 1
-RETURN R2 1
-LOADB R2 1
-RETURN R2 1
-LOADB R2 1
-RETURN R2 1
 L3: RETURN R0 0
 )");
 }
@@ -7167,6 +7787,135 @@ RETURN R2 1
 )");
 }
 
+TEST_CASE("LocalDeadRegisterReuse")
+{
+    // on O2, registers of locals that aren't used by the rest of the block are reused for new locals
+    // native modules are used here because type information is needed to know that locals don't reference GC objects
+    CHECK_EQ("\n" + compileFunction(R"(
+--!native
+local function test(t, a: number, b: number)
+    local tmp1 = a + b
+    local tmp2 = tmp1 * 2
+    t.baz(tmp2)
+    local u1 = a - b
+    local u2 = -u1
+    t.qux(u2)
+    return u1
+end
+)",
+                        0, 2),
+        R"(
+ADD R3 R1 R2
+MULK R4 R3 K0 [2]
+GETTABLEKS R5 R0 K1 ['baz']
+MOVE R6 R4
+CALL R5 1 0
+SUB R3 R1 R2
+MINUS R4 R3
+GETTABLEKS R5 R0 K2 ['qux']
+MOVE R6 R4
+CALL R5 1 0
+RETURN R3 1
+)");
+
+    // locals used inside a loop stay alive until the end of the loop
+    CHECK_EQ("\n" + compileFunction(R"(
+--!native
+local function test(t, n: number)
+    local s = n * 2
+    for i = 1, n do
+        t.step(s, i)
+    end
+    local e = t.finish()
+    return e
+end
+)",
+                        0, 2),
+        R"(
+MULK R2 R1 K0 [2]
+LOADN R5 1
+MOVE R3 R1
+LOADN R4 1
+FORNPREP R3 L1
+L0: GETTABLEKS R6 R0 K1 ['step']
+MOVE R7 R2
+MOVE R8 R5
+CALL R6 2 0
+FORNLOOP R3 L0
+L1: GETTABLEKS R2 R0 K2 ['finish']
+CALL R2 0 1
+RETURN R2 1
+)");
+
+    // locals that may reference GC objects keep their register until the end of the block, so that object lifetime doesn't change
+    CHECK_EQ("\n" + compileFunction(R"(
+local function test(t, a)
+    local x = a > 0
+    local obj = a + 1
+    t.use(obj, x)
+    local y = not x
+    return y
+end
+)",
+                        0, 2),
+        R"(
+LOADN R3 0
+JUMPIFLT R3 R1 L0
+LOADB R2 0 +1
+L0: LOADB R2 1
+L1: ADDK R3 R1 K0 [1]
+GETTABLEKS R4 R0 K1 ['use']
+MOVE R5 R3
+MOVE R6 R2
+CALL R4 2 0
+NOT R4 R2
+RETURN R4 1
+)");
+
+    // locals referenced by closures keep their register, and so do locals that share a register with a live local
+    CHECK_EQ("\n" + compileFunction(R"(
+--!native
+local function test(t, a: number)
+    local x = a + 1
+    local f = function() return x end
+    t.f(f)
+    local y = a * 2
+    return y
+end
+)",
+                        1, 2),
+        R"(
+ADDK R2 R1 K0 [1]
+NEWCLOSURE R3 P0
+CAPTURE VAL R2
+GETTABLEKS R4 R0 K1 ['f']
+MOVE R5 R3
+CALL R4 1 0
+MULK R4 R1 K2 [2]
+RETURN R4 1
+)");
+
+    CHECK_EQ("\n" + compileFunction(R"(
+--!native
+local function test(t, a: number)
+    local x = a + 1
+    local b = x
+    t.use(x)
+    local c = t.c
+    return b, c
+end
+)",
+                        0, 2),
+        R"(
+ADDK R2 R1 K0 [1]
+GETTABLEKS R3 R0 K1 ['use']
+MOVE R4 R2
+CALL R3 1 0
+GETTABLEKS R3 R0 K2 ['c']
+RETURN R2 2
+)");
+}
+
 TEST_CASE("MultipleAssignments")
 {
     // order of assignments is left to right
@@ -7621,6 +8370,77 @@ L1: RETURN R3 1
 )");
 }
 
+TEST_CASE("VectorLibraryFastcall")
+{
+    // without the flag, vector library functions are regular calls
+    CHECK_EQ("\n" + compileFunction(R"(
+local a, b = ...
+return vector.dot(a, b)
+)",
+                        0, 2),
+        R"(
+GETVARARGS R0 2
+GETIMPORT R2 2 [vector.dot]
+MOVE R3 R0
+MOVE R4 R1
+CALL R2 2 -1
+RETURN R2 -1
+)");
+
+    ScopedFastFlag luauCompileVectorLibrary{FFlag::LuauCompileVectorLibrary, true};
+
+    CHECK_EQ("\n" + compileFunction(R"(
+local a, b = ...
+return vector.dot(a, b), vector.create(1, 2, 3), vector.max(a, b, vector.one)
+)",
+                        0, 2),
+        R"(
+GETVARARGS R0 2
+FASTCALL2 81 R0 R1 L0
+MOVE R3 R0
+MOVE R4 R1
+GETIMPORT R2 2 [vector.dot]
+CALL R2 2 1
+L0: LOADK R3 K3 [1, 2, 3]
+MOVE R5 R0
+MOVE R6 R1
+GETIMPORT R7 5 [vector.one]
+FASTCALL 88 L1
+GETIMPORT R4 7 [vector.max]
+CALL R4 3 1
+L1: RETURN R2 3
+)");
+}
+
+TEST_CASE("TableRemoveFastcall")
+{
+    ScopedFastFlag luauCompileTableRemove{FFlag::LuauCompileTableRemove, true};
+
+    CHECK_EQ("\n" + compileFunction(R"(
+local t = ...
+table.remove(t)
+return table.remove(t), table.remove(t, 1)
+)",
+                        0, 2),
+        R"(
+GETVARARGS R0 1
+FASTCALL1 90 R0 L0
+MOVE R2 R0
+GETIMPORT R1 2 [table.remove]
+CALL R1 1 0
+L0: FASTCALL1 90 R0 L1
+MOVE R2 R0
+GETIMPORT R1 2 [table.remove]
+CALL R1 1 1
+L1: FASTCALL2K 90 R0 K3 L2 [1]
+MOVE R3 R0
+LOADK R4 K3 [1]
+GETIMPORT R2 2 [table.remove]
+CALL R2 2 -1
+L2: RETURN R1 -1
+)");
+}
+
 TEST_CASE("EncodedTypeTable")
 {
     CHECK_EQ("\n" + compileTypeTable(R"(
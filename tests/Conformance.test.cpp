@@ -18,8 +18,12 @@
 #include "ScopedFlags.h"
 #include "ConformanceIrHooks.h"
 
+#include <algorithm>
 #include <fstream>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <math.h>
 
@@ -35,6 +39,10 @@ LUAU_FASTFLAG(DebugLuauAbortingChecks)
 LUAU_FASTINT(CodegenHeuristicsInstructionLimit)
 LUAU_FASTFLAG(LuauAttributeSyntax)
 LUAU_FASTFLAG(LuauNativeAttribute)
+LUAU_FASTFLAG(LuauCompileVectorLibrary)
+LUAU_FASTFLAG(LuauCompileTableRemove)
+LUAU_FASTFLAG(LuauCompileTableConstants)
+LUAU_FASTFLAG(LuauCompileStringFormat)
 
 static lua_CompileOptions defaultOptions()
 {
@@ -605,6 +613,50 @@ TEST_CASE("Buffers")
     runConformance("buffers.lua");
 }
 
+TEST_CASE("Json")
+{
+    runConformance("json.lua", [](lua_State* L) {
+        lua_pushcfunction(L, luaopen_json, NULL);
+        lua_call(L, 0, 0);
+    });
+}
+
+TEST_CASE("LargeAllocations")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    // array part starts below the large allocation threshold of the default allocator and grows past it
+    lua_createtable(L, 1000, 0);
+
+    for (int i = 1; i <= 1000000; ++i)
+    {
+        lua_pushnumber(L, i);
+        lua_rawseti(L, -2, i);
+    }
+
+    for (int i = 1; i <= 1000000; i += 997)
+    {
+        lua_rawgeti(L, -1, i);
+        CHECK(lua_tonumber(L, -1) == i);
+        lua_pop(L, 1);
+    }
+
+    lua_pop(L, 1);
+
+    // large buffer is allocated in a dedicated page
+    size_t size = 8 << 20;
+    char* data = (char*)lua_newbuffer(L, size);
+
+    for (size_t i = 0; i < size; i += 4096)
+        CHECK(data[i] == 0);
+
+    memset(data, 0xcc, size);
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+}
+
 TEST_CASE("Math")
 {
     runConformance("math.lua");
@@ -612,6 +664,9 @@ TEST_CASE("Math")
 
 TEST_CASE("Tables")
 {
+    ScopedFastFlag luauCompileTableRemove{FFlag::LuauCompileTableRemove, true};
+    ScopedFastFlag luauCompileTableConstants{FFlag::LuauCompileTableConstants, true};
+
     runConformance("tables.lua", [](lua_State* L) {
         lua_pushcfunction(
             L,
@@ -634,84 +689,1577 @@ TEST_CASE("Tables")
     });
 }
 
-TEST_CASE("PatternMatch")
-{
-    runConformance("pm.lua");
-}
+TEST_CASE("PatternMatch")
+{
+    runConformance("pm.lua");
+}
+
+TEST_CASE("Sort")
+{
+    runConformance("sort.lua");
+}
+
+TEST_CASE("Move")
+{
+    runConformance("move.lua");
+}
+
+TEST_CASE("Clear")
+{
+    runConformance("clear.lua");
+}
+
+TEST_CASE("Strings")
+{
+    runConformance("strings.lua");
+}
+
+TEST_CASE("StringInterp")
+{
+    ScopedFastFlag luauCompileStringFormat{FFlag::LuauCompileStringFormat, true};
+
+    runConformance("stringinterp.lua");
+}
+
+TEST_CASE("VarArg")
+{
+    runConformance("vararg.lua");
+}
+
+TEST_CASE("Locals")
+{
+    runConformance("locals.lua");
+}
+
+TEST_CASE("Literals")
+{
+    runConformance("literals.lua");
+}
+
+TEST_CASE("Errors")
+{
+    runConformance("errors.lua");
+}
+
+TEST_CASE("Events")
+{
+    runConformance("events.lua");
+}
+
+TEST_CASE("Constructs")
+{
+    runConformance("constructs.lua");
+}
+
+TEST_CASE("Closure")
+{
+    runConformance("closure.lua");
+}
+
+TEST_CASE("Calls")
+{
+    runConformance("calls.lua");
+}
+
+TEST_CASE("Attrib")
+{
+    runConformance("attrib.lua");
+}
+
+TEST_CASE("GC")
+{
+    runConformance("gc.lua");
+}
+
+TEST_CASE("GCGenerational")
+{
+    auto setup = [](lua_State* L) {
+        lua_gc(L, LUA_GCGEN, 1);
+    };
+
+    runConformance("gc.lua", setup);
+    runConformance("closure.lua", setup);
+    runConformance("coroutine.lua", setup);
+}
+
+TEST_CASE("GCGenerationalBarriers")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCGEN, 1) == 0);
+
+    // full collection promotes the table to the old generation
+    lua_newtable(L);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        // young objects are only reachable through the old table
+        lua_newtable(L);
+        lua_pushnumber(L, i);
+        lua_setfield(L, -2, "value");
+        lua_rawseti(L, -2, i + 1);
+
+        // short-lived garbage
+        lua_newtable(L);
+        lua_pop(L, 1);
+
+        lua_gc(L, LUA_GCSTEP, 1);
+        luaC_validate(L);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(lua_rawgeti(L, -1, i + 1) == LUA_TTABLE);
+        CHECK(lua_getfield(L, -1, "value") == LUA_TNUMBER);
+        CHECK(lua_tonumber(L, -1) == i);
+        lua_pop(L, 2);
+    }
+
+    CHECK(lua_gc(L, LUA_GCGEN, 0) == 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+}
+
+TEST_CASE("GCWeakTableWithoutReferences")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    // weak table that only holds numbers and strings is traversed as a strong table
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushstring(L, "kv");
+    lua_setfield(L, -2, "__mode");
+    lua_setmetatable(L, -2);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        lua_pushnumber(L, i);
+        lua_rawseti(L, -2, i + 1);
+        lua_pushfstring(L, "value%d", i);
+        lua_setfield(L, -2, "name");
+    }
+
+    // objects are stored at different points of the incremental cycle, some after the table has been traversed
+    for (int i = 0; i < 1000; ++i)
+    {
+        lua_newtable(L);
+        lua_rawseti(L, -2, 101 + i);
+
+        lua_newtable(L);
+        lua_pop(L, 1);
+
+        lua_gc(L, LUA_GCSTEP, 1);
+        luaC_validate(L);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(lua_rawgeti(L, -1, i + 1) == LUA_TNUMBER);
+        lua_pop(L, 1);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        CHECK(lua_rawgeti(L, -1, 101 + i) == LUA_TNIL);
+        lua_pop(L, 1);
+    }
+
+    CHECK(lua_getfield(L, -1, "name") == LUA_TSTRING);
+    lua_pop(L, 1);
+}
+
+static void gcParallelThreads(lua_State* L, int count, void (*job)(void* context, int index), void* context)
+{
+    std::vector<std::thread> threads;
+
+    for (int i = 1; i < count; ++i)
+        threads.emplace_back(job, context, i);
+
+    job(context, 0);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+TEST_CASE("GCParallelMark")
+{
+    runConformance("gc.lua", [](lua_State* L) {
+        lua_callbacks(L)->gcparallel = gcParallelThreads;
+        lua_gc(L, LUA_GCSETWORKERS, 4);
+    });
+}
+
+TEST_CASE("GCParallelMarkHeap")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_callbacks(L)->gcparallel = gcParallelThreads;
+    CHECK(lua_gc(L, LUA_GCSETWORKERS, 4) == 0);
+
+    // weak table that keeps values alive only as long as the strong table below references them
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushstring(L, "v");
+    lua_setfield(L, -2, "__mode");
+    lua_setmetatable(L, -2);
+
+    // strong table with a large graph of nested tables, strings and closures
+    lua_newtable(L);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        lua_newtable(L);
+        lua_pushnumber(L, i);
+        lua_setfield(L, -2, "value");
+        lua_pushfstring(L, "item%d", i);
+        lua_setfield(L, -2, "name");
+
+        if (i % 2 == 0)
+        {
+            lua_pushvalue(L, -1);
+            lua_rawseti(L, -4, i + 1);
+            lua_rawseti(L, -2, i + 1);
+        }
+        else
+        {
+            // odd items are only reachable through the weak table
+            lua_rawseti(L, -3, i + 1);
+        }
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        CHECK(lua_rawgeti(L, -2, i + 1) == (i % 2 == 0 ? LUA_TTABLE : LUA_TNIL));
+        lua_pop(L, 1);
+    }
+
+    for (int i = 0; i < 10000; i += 2)
+    {
+        REQUIRE(lua_rawgeti(L, -1, i + 1) == LUA_TTABLE);
+        CHECK(lua_getfield(L, -1, "name") == LUA_TSTRING);
+        CHECK(lua_tostring(L, -1) == "item" + std::to_string(i));
+        lua_pop(L, 2);
+    }
+}
+
+TEST_CASE("GCParallelMarkDeadKeys")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_callbacks(L)->gcparallel = gcParallelThreads;
+    lua_gc(L, LUA_GCSETWORKERS, 4);
+
+    auto pushkey = [](lua_State* L, int i) {
+        std::string key = std::string(2000, 'k') + std::to_string(i);
+        lua_pushlstring(L, key.data(), key.size());
+    };
+
+    // entries that were removed keep their keys in the hash part; long string keys are only referenced by the table
+    lua_newtable(L);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        pushkey(L, i);
+        lua_pushboolean(L, true);
+        lua_rawset(L, -3);
+    }
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        pushkey(L, i);
+        lua_pushnil(L);
+        lua_rawset(L, -3);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        pushkey(L, i);
+        CHECK(lua_rawget(L, -2) == (i % 2 == 0 ? LUA_TNIL : LUA_TBOOLEAN));
+        lua_pop(L, 1);
+    }
+}
+
+TEST_CASE("GCParallelSweep")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_callbacks(L)->gcparallel = gcParallelThreads;
+    lua_gc(L, LUA_GCSETWORKERS, 4);
+    lua_gc(L, LUA_GCGEN, 1);
+
+    lua_newtable(L);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        lua_pushfstring(L, "item%d", i);
+        lua_rawseti(L, -2, i + 1);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    int fullkb = lua_gc(L, LUA_GCCOUNT, 0);
+
+    // drop every other string, so that most pages end up with both dead and surviving objects
+    for (int i = 0; i < 20000; i += 2)
+    {
+        lua_pushnil(L);
+        lua_rawseti(L, -2, i + 1);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) < fullkb);
+
+    // surviving objects must be recolored for the next cycle to collect them
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) < fullkb / 2);
+}
+
+TEST_CASE("GCFrameBudget")
+{
+    runConformance("gc.lua", [](lua_State* L) {
+        lua_gc(L, LUA_GCSETFRAMEBUDGET, 50);
+    });
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCSETFRAMEBUDGET, 100) == 0);
+
+    int cycles = 0;
+    int maxkb = 0;
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        CHECK(lua_gc(L, LUA_GCFRAME, 0) >= 0);
+
+        // allocate garbage during the frame; assists are limited by the frame budget
+        for (int i = 0; i < 1000; ++i)
+        {
+            lua_createtable(L, 8, 0);
+            lua_pop(L, 1);
+        }
+
+        luaC_validate(L);
+
+        // remaining work is performed when the host is idle
+        cycles += lua_gc(L, LUA_GCIDLE, 1000);
+
+        int kb = lua_gc(L, LUA_GCCOUNT, 0);
+        maxkb = kb > maxkb ? kb : maxkb;
+    }
+
+    CHECK(cycles > 0);
+    CHECK(maxkb < 4096);
+
+    CHECK(lua_gc(L, LUA_GCSETFRAMEBUDGET, 0) == 100);
+}
+
+TEST_CASE("GCStepMany")
+{
+    std::vector<StateRef> states;
+    std::vector<lua_State*> list;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        states.emplace_back(luaL_newstate(), lua_close);
+        lua_State* L = states.back().get();
+
+        // live data keeps the heap goal above the garbage of a frame, so that assists respect the frame budget
+        lua_createtable(L, 20000, 0);
+
+        for (int j = 0; j < 20000; ++j)
+        {
+            lua_createtable(L, 4, 0);
+            lua_rawseti(L, -2, j + 1);
+        }
+
+        // a tiny frame budget postpones most of the GC work, so that the states accumulate debt during the frame
+        lua_gc(L, LUA_GCSETFRAMEBUDGET, 1);
+
+        list.push_back(L);
+    }
+
+    lua_callbacks(list[0])->gcparallel = gcParallelThreads;
+
+    int cycles = 0;
+    int maxdebt = 0;
+
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        int debt = 0;
+
+        for (lua_State* L : list)
+        {
+            lua_gc(L, LUA_GCFRAME, 0);
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                lua_createtable(L, 8, 0);
+                lua_pop(L, 1);
+            }
+
+            debt += lua_gc(L, LUA_GCDEBT, 0);
+        }
+
+        maxdebt = debt > maxdebt ? debt : maxdebt;
+
+        // work between frames is split between all states with debt
+        cycles += lua_gcstepmany(list.data(), int(list.size()), debt);
+
+        int remaining = 0;
+
+        for (lua_State* L : list)
+        {
+            luaC_validate(L);
+            remaining += lua_gc(L, LUA_GCDEBT, 0);
+        }
+
+        CHECK(remaining <= debt / 2);
+    }
+
+    CHECK(maxdebt > 0);
+    CHECK(cycles > 0);
+
+    for (lua_State* L : list)
+        CHECK(lua_gc(L, LUA_GCCOUNT, 0) < 16384);
+
+    // stopped collector has no debt and isn't stepped
+    lua_gc(list[0], LUA_GCSTOP, 0);
+    CHECK(lua_gc(list[0], LUA_GCDEBT, 0) == 0);
+    CHECK(lua_gcstepmany(list.data(), 1, 1024) == 0);
+}
+
+TEST_CASE("StackStats")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    lua_StackStats before;
+    lua_getstackstats(L, 5, &before);
+    CHECK(before.stackgrowths == 0);
+    CHECK(before.cigrowths == 0);
+
+    // threads created while category 5 is active are attributed to it
+    lua_setmemcat(L, 5);
+    lua_State* T = lua_newthread(L);
+    lua_setmemcat(L, 0);
+
+    const char* source = R"(
+        local function deep(n) if n == 0 then return 0 end return 1 + deep(n - 1) end
+        return deep(1000)
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(T, "=StackStats", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_resume(T, nullptr, 0) == LUA_OK);
+    CHECK(lua_tonumber(T, -1) == 1000);
+
+    lua_StackStats stats;
+    lua_getstackstats(L, 5, &stats);
+
+    CHECK(stats.stackgrowths > 0);
+    CHECK(stats.cigrowths > 0);
+    CHECK(stats.maxstacksize > 1000);
+    CHECK(stats.maxcisize > 1000);
+
+    lua_StackStats total;
+    lua_getstackstats(L, -1, &total);
+
+    CHECK(total.stackgrowths >= stats.stackgrowths);
+    CHECK(total.cigrowths >= stats.cigrowths);
+    CHECK(total.maxcisize >= stats.maxcisize);
+}
+
+TEST_CASE("OpcodeStats")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+    luaL_sandbox(L);
+
+    lua_setopcodestats(L, true);
+
+    const char* source = R"(
+        local t = setmetatable({}, { __index = function(t, k) return 1 end })
+        local sum = 0
+        for i = 1, 10 do
+            sum += t.x + math.abs(-i)
+        end
+        return sum + math.abs("-5")
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=OpcodeStats", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 70);
+
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_EXEC, LOP_FORNLOOP, 0) == 10);
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_EXEC, LOP_GETTABLEKS, 0) == 10);
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_SLOWPATH, LOP_GETTABLEKS, 0) == 10);
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_PAIR, LOP_ADD, LOP_FORNLOOP) == 10);
+
+    // the string argument doesn't have a fast path and goes through the regular call
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_FASTCALL, LBF_MATH_ABS, 0) == 11);
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_FASTCALLFALLBACK, LBF_MATH_ABS, 0) == 1);
+
+    // enabling the statistics again resets them
+    lua_setopcodestats(L, true);
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_EXEC, LOP_FORNLOOP, 0) == 0);
+
+    lua_setopcodestats(L, false);
+    CHECK(lua_getopcodestat(L, LUA_OPSTAT_EXEC, LOP_FORNLOOP, 0) == 0);
+}
+
+TEST_CASE("FrozenTablesEmptyEntries")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    // removed entries keep their keys in the hash part, and long strings are only referenced by the table
+    const char* source = R"(
+        local prefix = string.rep("k", 2000)
+        local t = {}
+        t[prefix .. "a"] = 1
+        t[prefix .. "b"] = 2
+        t[prefix .. "a"] = nil
+        return table.freeze(t)
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=FrozenTablesEmptyEntries", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    lua_freeze(L, -1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    std::string prefix(2000, 'k');
+
+    lua_pushstring(L, (prefix + "a").c_str());
+    CHECK(lua_rawget(L, -2) == LUA_TNIL);
+    lua_pop(L, 1);
+
+    lua_pushstring(L, (prefix + "b").c_str());
+    CHECK(lua_rawget(L, -2) == LUA_TNUMBER);
+    CHECK(lua_tonumber(L, -1) == 2);
+    lua_pop(L, 1);
+}
+
+TEST_CASE("FrozenTables")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    const char* source = R"(
+        local function build(depth)
+            local t = { name = "level" .. depth, values = { 1, 2, 3 } }
+            table.freeze(t.values)
+            if depth > 0 then
+                t.child = build(depth - 1)
+            end
+            return table.freeze(t)
+        end
+
+        local data = build(5)
+        local mutable = table.freeze({ inner = {} })
+        local withfunction = table.freeze({ f = print })
+
+        return data, mutable, withfunction
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=FrozenTables", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 3, 0) == LUA_OK);
+
+    lua_CFunction freeze = [](lua_State* L) {
+        lua_freeze(L, 1);
+        return 0;
+    };
+
+    // tables that aren't readonly and functions can't be frozen, and failure doesn't freeze anything
+    lua_pushcfunction(L, freeze, "freeze");
+    lua_pushvalue(L, -3);
+    CHECK(lua_pcall(L, 1, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot freeze a table that isn't readonly") == 0);
+    lua_pop(L, 1);
+
+    lua_pushcfunction(L, freeze, "freeze");
+    lua_pushvalue(L, -2);
+    CHECK(lua_pcall(L, 1, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot freeze a function value") == 0);
+    lua_pop(L, 1);
+
+    CHECK(!lua_getfrozen(L, -2));
+    CHECK(!lua_getfrozen(L, -1));
+    lua_pop(L, 2);
+
+    lua_freeze(L, -1);
+    CHECK(lua_getfrozen(L, -1));
+
+    lua_getfield(L, -1, "child");
+    CHECK(lua_getfrozen(L, -1));
+    lua_getfield(L, -1, "name");
+    CHECK(lua_getfrozen(L, -1));
+    CHECK(strcmp(lua_tostring(L, -1), "level4") == 0);
+    lua_pop(L, 2);
+
+    // frozen objects survive collections in all modes without being traversed
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    lua_gc(L, LUA_GCGEN, 1);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    lua_gc(L, LUA_GCSTEP, 0);
+    luaC_validate(L);
+    lua_gc(L, LUA_GCGEN, 0);
+
+    lua_gc(L, LUA_GCCOMPACT, 0);
+    luaC_validate(L);
+
+    lua_getfield(L, -1, "child");
+    lua_getfield(L, -1, "values");
+    lua_rawgeti(L, -1, 3);
+    CHECK(lua_tonumber(L, -1) == 3);
+    lua_pop(L, 3);
+
+    lua_getfield(L, -1, "name");
+    CHECK(strcmp(lua_tostring(L, -1), "level5") == 0);
+    lua_pop(L, 1);
+
+    // frozen strings are still interned, so equal strings created later are the same objects
+    lua_pushstring(L, "level5");
+    lua_getfield(L, -2, "name");
+    CHECK(lua_rawequal(L, -1, -2));
+    CHECK(lua_getfrozen(L, -2));
+    lua_pop(L, 2);
+}
+
+TEST_CASE("PublishedTables")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    const char* source = R"(
+        local list = { 10, 20, 30 }
+        local data = { config = { name = "shared", scale = 1.5, enabled = false }, list = list, alias = list, [list] = true }
+        return data, { f = print }, setmetatable({}, {})
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=PublishedTables", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 3, 0) == LUA_OK);
+
+    lua_CFunction publish = [](lua_State* L) {
+        lua_close(lua_publish(L, 1));
+        return 0;
+    };
+
+    lua_pushcfunction(L, publish, "publish");
+    lua_pushvalue(L, -3);
+    CHECK(lua_pcall(L, 1, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot publish a function value") == 0);
+    lua_pop(L, 1);
+
+    lua_pushcfunction(L, publish, "publish");
+    lua_pushvalue(L, -2);
+    CHECK(lua_pcall(L, 1, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot publish a table with a metatable") == 0);
+    lua_pop(L, 3);
+
+    StateRef published(lua_publish(L, -1), lua_close);
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    lua_Alloc alloc = [](void* ud, void* ptr, size_t osize, size_t nsize) -> void* {
+        if (nsize == 0)
+        {
+            free(ptr);
+            return nullptr;
+        }
+
+        return realloc(ptr, nsize);
+    };
+
+    const char* consumer = R"(
+        local data = ...
+        local sum = 0
+        for i, v in data.list do
+            sum += v
+        end
+        assert(data.alias == data.list and data[data.list] == true)
+        assert(data.config.scale == 1.5 and data.config.enabled == false)
+        assert(not pcall(function() data.config.name = "changed" end))
+        return data.config["na" .. "me"] == "shared" and #data.list == 3 and sum == 60
+    )";
+
+    bytecode = luau_compile(consumer, strlen(consumer), nullptr, &bytecodeSize);
+    std::string consumerBytecode(bytecode, bytecodeSize);
+    free(bytecode);
+
+    // states that share the published table can run on separate threads
+    std::vector<std::thread> threads;
+    std::atomic<int> succeeded = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]() {
+            StateRef shared(lua_newsharedstate(alloc, nullptr, published.get()), lua_close);
+            lua_State* S = shared.get();
+
+            luaL_openlibs(S);
+
+            for (int iteration = 0; iteration < 10; ++iteration)
+            {
+                if (luau_load(S, "=consumer", consumerBytecode.data(), consumerBytecode.size(), 0) != 0)
+                    return;
+
+                lua_getpublished(S);
+
+                if (lua_pcall(S, 1, 1, 0) != LUA_OK || !lua_toboolean(S, -1))
+                    return;
+
+                lua_pop(S, 1);
+                lua_gc(S, LUA_GCCOLLECT, 0);
+                luaC_validate(S);
+            }
+
+            // clones of a state share its published table as well
+            StateRef cloned(lua_clonestate(S), lua_close);
+            lua_State* C = cloned.get();
+
+            if (luau_load(C, "=consumer", consumerBytecode.data(), consumerBytecode.size(), 0) != 0)
+                return;
+
+            lua_getpublished(C);
+
+            if (lua_pcall(C, 1, 1, 0) != LUA_OK || !lua_toboolean(C, -1))
+                return;
+
+            lua_getpublished(S);
+            if (lua_getfrozen(S, -1))
+                succeeded++;
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CHECK(succeeded == 4);
+}
+
+TEST_CASE("PublishedTablesLength")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    const char* source = R"(
+        local trailing = table.create(8)
+        trailing[1], trailing[3] = 1, 3
+        return { holes = { 1, 2, nil, nil }, empty = table.create(4), trailing = trailing }
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=PublishedTablesLength", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    StateRef published(lua_publish(L, -1), lua_close);
+    lua_pop(L, 1);
+
+    void* ud = nullptr;
+    lua_Alloc alloc = lua_getallocf(L, &ud);
+
+    StateRef shared(lua_newsharedstate(alloc, ud, published.get()), lua_close);
+    lua_State* S = shared.get();
+
+    lua_getpublished(S);
+
+    // states on other threads read the length of published tables concurrently, so computing it must not update the table
+    for (const char* name : {"holes", "empty", "trailing"})
+    {
+        lua_getfield(S, -1, name);
+
+        char before[16];
+        memcpy(before, lua_topointer(S, -1), sizeof(before));
+
+        int length = lua_objlen(S, -1);
+        CHECK(memcmp(before, lua_topointer(S, -1), sizeof(before)) == 0);
+
+        if (strcmp(name, "holes") == 0)
+            CHECK(length == 2);
+        else if (strcmp(name, "empty") == 0)
+            CHECK(length == 0);
+        else
+            CHECK((length == 1 || length == 3));
+
+        lua_pop(S, 1);
+    }
+
+    lua_pop(S, 1);
+}
+
+TEST_CASE("CloneValues")
+{
+    StateRef sourceState(luaL_newstate(), lua_close);
+    StateRef targetState(luaL_newstate(), lua_close);
+    lua_State* L = sourceState.get();
+    lua_State* T = targetState.get();
+
+    luaL_openlibs(L);
+    luaL_openlibs(T);
+
+    const char* source = R"(
+        local list = { 10, 20, 30, "text" }
+        local data = { list = list, alias = list, [list] = true, blob = buffer.fromstring("bytes"), nested = { { { deep = 1.5 } } } }
+        data.self = data
+        return data, { f = print }, setmetatable({}, {})
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=CloneValues", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 3, 0) == LUA_OK);
+
+    const char* check = R"(
+        local data = ...
+        assert(data.self == data and data.alias == data.list and data[data.list] == true)
+        assert(#data.list == 4 and data.list[1] == 10 and data.list[4] == "text")
+        assert(buffer.tostring(data.blob) == "bytes" and data.nested[1][1].deep == 1.5)
+        return true
+    )";
+
+    bytecode = luau_compile(check, strlen(check), nullptr, &bytecodeSize);
+    std::string checkBytecode(bytecode, bytecodeSize);
+    free(bytecode);
+
+    auto runCheck = [&](lua_State* S) {
+        REQUIRE(luau_load(S, "=check", checkBytecode.data(), checkBytecode.size(), 0) == 0);
+        lua_insert(S, -2);
+        CHECK(lua_pcall(S, 1, 1, 0) == LUA_OK);
+        CHECK(lua_toboolean(S, -1));
+        lua_pop(S, 1);
+    };
+
+    lua_CFunction clone = [](lua_State* L) {
+        lua_xclone(L, (lua_State*)lua_tolightuserdata(L, lua_upvalueindex(1)), 1);
+        return 0;
+    };
+
+    lua_pushlightuserdata(L, T);
+    lua_pushcclosure(L, clone, "clone", 1);
+
+    lua_pushvalue(L, -1);
+    lua_pushvalue(L, -4);
+    CHECK(lua_pcall(L, 1, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot clone a function value") == 0);
+    lua_pop(L, 1);
+
+    lua_pushvalue(L, -1);
+    lua_pushvalue(L, -3);
+    CHECK(lua_pcall(L, 1, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot clone a table with a metatable") == 0);
+    lua_pop(L, 4);
+
+    CHECK(lua_gettop(T) == 0);
+
+    lua_xclone(L, T, -1);
+    lua_gc(T, LUA_GCCOLLECT, 0);
+    runCheck(T);
+    luaC_validate(T);
+
+    lua_xclone(L, L, -1);
+    runCheck(L);
+
+    lua_encodevalue(L, -1);
+    lua_decodevalue(L, -1);
+    lua_remove(L, -2);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    runCheck(L);
+    luaC_validate(L);
+
+    lua_pushcfunction(L, [](lua_State* L) {
+        lua_encodevalue(L, 1);
+        return 1;
+    }, "encode");
+    lua_getglobal(L, "print");
+    CHECK(lua_pcall(L, 1, 1, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot encode a function value") == 0);
+    lua_pop(L, 1);
+
+    lua_CFunction decode = [](lua_State* L) {
+        lua_decodevalue(L, 1);
+        return 1;
+    };
+
+    // truncated data, trailing data and a reference to an object that wasn't decoded yet
+    for (const char* data : {"\x01\x07\x02", "\x01\x00\x00", "\x01\x08\x00"})
+    {
+        lua_pushcfunction(L, decode, "decode");
+        memcpy(lua_newbuffer(L, 3), data, 3);
+        CHECK(lua_pcall(L, 1, 1, 0) == LUA_ERRRUN);
+        CHECK(strcmp(lua_tostring(L, -1), "malformed encoded value") == 0);
+        lua_pop(L, 1);
+    }
+}
+
+TEST_CASE("CloneState")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    // userdata with tag 1 carry a number and can be called to read it
+    lua_newtable(L);
+    lua_pushcfunction(L, [](lua_State* L) {
+        lua_pushnumber(L, *(double*)lua_touserdatatagged(L, 1, 1));
+        return 1;
+    }, "__call");
+    lua_setfield(L, -2, "__call");
+    lua_setuserdatametatable(L, 1, -1);
+
+    *(double*)lua_newuserdatatagged(L, sizeof(double), 1) = 42;
+    lua_getuserdatametatable(L, 1);
+    lua_setmetatable(L, -2);
+    lua_setglobal(L, "box");
+
+    const char* source = R"(
+        local count = 0
+        function increment() count += 1 return count end
+        function current() return count end
+
+        local class = {}
+        class.__index = class
+        function class:get() return self.value end
+        object = setmetatable({ value = "template" }, class)
+
+        list = {}
+        for i = 1, 1000 do list = { next = list, value = i } end
+
+        return true
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=CloneState", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    lua_pop(L, 1);
+
+    StateRef clonedState(lua_clonestate(L), lua_close);
+    lua_State* C = clonedState.get();
+
+    // the template is changed after the clone is created, which must not affect the clone
+    lua_getglobal(L, "increment");
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 1);
+    lua_pop(L, 1);
+
+    const char* check = R"(
+        assert(increment() == 1 and increment() == 2 and current() == 2)
+        assert(object:get() == "template" and box() == 42)
+        local depth = 0
+        while list.next do depth += 1 list = list.next end
+        assert(depth == 1000)
+        return string.format("%d", math.floor(1.5))
+    )";
+
+    bytecode = luau_compile(check, strlen(check), nullptr, &bytecodeSize);
+    result = luau_load(C, "=check", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    CHECK(lua_pcall(C, 0, 1, 0) == LUA_OK);
+    CHECK(strcmp(lua_tostring(C, -1), "1") == 0);
+    lua_pop(C, 1);
+
+    lua_gc(C, LUA_GCCOLLECT, 0);
+    luaC_validate(C);
+
+    lua_pushcfunction(L, [](lua_State* L) {
+        lua_close(lua_clonestate(L));
+        return 0;
+    }, "clonestate");
+
+    lua_newthread(L);
+    lua_setglobal(L, "thread");
+    lua_pushvalue(L, -1);
+    CHECK(lua_pcall(L, 0, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot clone a thread value") == 0);
+    lua_pop(L, 1);
+
+    lua_pushnil(L);
+    lua_setglobal(L, "thread");
+    lua_setuserdatadtor(L, 1, [](lua_State* L, void* data) {});
+    CHECK(lua_pcall(L, 0, 0, 0) == LUA_ERRRUN);
+    CHECK(strcmp(lua_tostring(L, -1), "cannot clone a userdata with a destructor") == 0);
+    lua_pop(L, 1);
+}
+
+TEST_CASE("GCMetrics")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    static int reported = 0;
+    reported = 0;
+
+    lua_callbacks(L)->gccycle = [](lua_State* L) {
+        lua_GCMetrics metrics;
+        lua_gcmetrics(L, &metrics);
+
+        CHECK(metrics.completedcycles == uint64_t(++reported));
+        CHECK(metrics.lastcycle.steps > 0);
+        CHECK(metrics.lastcycle.endtimestamp >= metrics.lastcycle.starttimestamp);
+    };
+
+    lua_GCMetrics metrics;
+    lua_gcmetrics(L, &metrics);
+    uint64_t startcycles = metrics.completedcycles;
+
+    // incremental cycles are driven by allocations
+    for (int i = 0; i < 100000; ++i)
+    {
+        lua_createtable(L, 8, 0);
+        lua_pop(L, 1);
+    }
+
+    lua_gcmetrics(L, &metrics);
+
+    CHECK(metrics.completedcycles > startcycles);
+    CHECK(metrics.completedcycles == uint64_t(reported));
+    CHECK(metrics.steps >= metrics.lastcycle.steps);
+    CHECK(metrics.assisttime > 0.0);
+    CHECK(metrics.maxsteptime >= metrics.lastcycle.maxsteptime);
+    CHECK(metrics.lastcycle.sweeptime > 0.0);
+    CHECK(metrics.lastcycle.endtotalsizebytes <= metrics.lastcycle.atomicstarttotalsizebytes);
+
+    uint64_t steps = metrics.steps;
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    lua_gcmetrics(L, &metrics);
+
+    // full collection is reported as a single step
+    CHECK(metrics.completedcycles == uint64_t(reported));
+    CHECK(metrics.steps == steps + 1);
+    CHECK(metrics.lastcycle.steps == 1);
+    CHECK(metrics.lastcycle.maxsteptime >= metrics.lastcycle.marktime);
+    CHECK(metrics.lastcycle.heapgoalsizebytes > metrics.lastcycle.endtotalsizebytes);
+}
+
+TEST_CASE("GCCompact")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    auto run = [](lua_State* L, const char* source) {
+        size_t bytecodeSize = 0;
+        char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+        int result = luau_load(L, "=GCCompact", bytecode, bytecodeSize, 0);
+        free(bytecode);
+
+        REQUIRE(result == 0);
+        lua_call(L, 0, 1);
+    };
+
+    // keep a small fraction of a large number of tables alive, referenced in all the ways a table can be referenced
+    run(L, R"(
+        local all = {}
+        for i = 1, 100000 do
+            all[i] = { value = i }
+        end
+
+        local keep, keys, meta = {}, {}, {}
+        for i = 1, 100000, 50 do
+            local t = all[i]
+            table.insert(keep, t)
+            keys[t] = i
+            meta[i] = setmetatable({}, { __index = t })
+        end
+
+        local shared = all[1]
+        local function get() return shared end
+
+        -- the clone shares the hash part with 'keys' while both are rehashed for the moved keys
+        local keyscopy = table.clone(keys)
+
+        all = nil
+        _G.state = { keep = keep, keys = keys, keyscopy = keyscopy, meta = meta, get = get }
+        return shared
+    )");
+
+    int ref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    size_t before = lua_totalbytes(L, 0);
+
+    CHECK(lua_gc(L, LUA_GCCOMPACT, 0) > 0);
+    luaC_validate(L);
+
+    CHECK(lua_totalbytes(L, 0) <= before);
+
+    run(L, R"(
+        local state = _G.state
+        local count = 0
+
+        for index, t in state.keep do
+            local i = t.value
+            assert(state.keys[t] == i)
+            assert(state.keyscopy[t] == i)
+            assert(state.meta[i].value == i)
+            count += 1
+        end
+
+        assert(state.get() == state.keep[1])
+        return count
+    )");
+
+    CHECK(lua_tointeger(L, -1) == 2000);
+    lua_pop(L, 1);
+
+    lua_getref(L, ref);
+    lua_getfield(L, -1, "value");
+    CHECK(lua_tointeger(L, -1) == 1);
+    lua_pop(L, 2);
+
+    lua_unref(L, ref);
+
+    // a second compaction has nothing left to do
+    CHECK(lua_gc(L, LUA_GCCOMPACT, 0) == 0);
+    luaC_validate(L);
+}
+
+TEST_CASE("GCCompactGenerational")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    lua_gc(L, LUA_GCGEN, 1);
+
+    auto run = [](lua_State* L, const char* source) {
+        size_t bytecodeSize = 0;
+        char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+        int result = luau_load(L, "=GCCompactGenerational", bytecode, bytecodeSize, 0);
+        free(bytecode);
+
+        REQUIRE(result == 0);
+        lua_call(L, 0, 0);
+    };
+
+    // weak tables and survivors of a generational collection are kept on collector lists between cycles
+    run(L, R"(
+        local all = {}
+        for i = 1, 100000 do
+            all[i] = { value = i }
+        end
+
+        local keep, weak = {}, setmetatable({}, { __mode = "k" })
+        for i = 1, 100000, 50 do
+            table.insert(keep, all[i])
+            weak[all[i]] = i
+        end
+
+        all = nil
+        _G.state = { keep = keep, weak = weak }
+    )");
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    CHECK(lua_gc(L, LUA_GCCOMPACT, 0) > 0);
+    luaC_validate(L);
+
+    run(L, R"(
+        local state = _G.state
+        for _, t in state.keep do
+            assert(state.weak[t] == t.value)
+        end
+        state.keep[1] = { value = 0 }
+    )");
+
+    // generational cycles continue to work after compaction
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    for (int i = 0; i < 100; i++)
+        lua_gc(L, LUA_GCSTEP, 100);
+    luaC_validate(L);
 
-TEST_CASE("Sort")
-{
-    runConformance("sort.lua");
+    CHECK(lua_gc(L, LUA_GCGEN, 0) == 1);
 }
 
-TEST_CASE("Move")
+TEST_CASE("GCTableShrink")
 {
-    runConformance("move.lua");
-}
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
 
-TEST_CASE("Clear")
-{
-    runConformance("clear.lua");
-}
+    luaL_openlibs(L);
 
-TEST_CASE("Strings")
-{
-    runConformance("strings.lua");
-}
+    auto run = [](lua_State* L, const char* source) {
+        size_t bytecodeSize = 0;
+        char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+        int result = luau_load(L, "=GCTableShrink", bytecode, bytecodeSize, 0);
+        free(bytecode);
 
-TEST_CASE("StringInterp")
-{
-    runConformance("stringinterp.lua");
-}
+        REQUIRE(result == 0);
+        lua_call(L, 0, 0);
+    };
 
-TEST_CASE("VarArg")
-{
-    runConformance("vararg.lua");
-}
+    // grow the hash and array parts of a table and then clear most of the elements
+    run(L, R"(
+        local cache, list = {}, {}
+        for i = 1, 100000 do
+            cache["key" .. i] = i
+            list[i] = i
+        end
+        for i = 1, 100000 do
+            if i % 100 ~= 0 then
+                cache["key" .. i] = nil
+            end
+        end
+        for i = 1001, 100000 do
+            list[i] = nil
+        end
+        _G.cache, _G.list = cache, list
+    )");
 
-TEST_CASE("Locals")
-{
-    runConformance("locals.lua");
-}
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    size_t before = lua_gc(L, LUA_GCCOUNT, 0);
 
-TEST_CASE("Literals")
-{
-    runConformance("literals.lua");
-}
+    CHECK(lua_gc(L, LUA_GCSETTABLESHRINK, 25) == 0);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
 
-TEST_CASE("Errors")
-{
-    runConformance("errors.lua");
-}
+    size_t after = lua_gc(L, LUA_GCCOUNT, 0);
+    CHECK(after < before / 2);
 
-TEST_CASE("Events")
-{
-    runConformance("events.lua");
+    run(L, R"(
+        local count = 0
+        for k, v in _G.cache do
+            assert(k == "key" .. v and v % 100 == 0)
+            count += 1
+        end
+        assert(count == 1000)
+        assert(#_G.list == 1000)
+        for i = 1, 1000 do
+            assert(_G.list[i] == i)
+        end
+        -- shrunk tables can grow again
+        for i = 1001, 2000 do
+            _G.list[i] = i
+        end
+        assert(#_G.list == 2000)
+    )");
+
+    // tables that are mostly full are left alone
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) <= after + 64);
+
+    // new tables keep their size until they survived a sweep, since native code relies on the size of tables it created
+    size_t base = lua_gc(L, LUA_GCCOUNT, 0);
+    lua_gc(L, LUA_GCSTOP, 0);
+    run(L, "_G.fresh = table.create(10000)");
+    lua_gc(L, LUA_GCRESTART, 0);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    size_t fresh = lua_gc(L, LUA_GCCOUNT, 0);
+    CHECK(fresh >= base + 128);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) + 128 < fresh);
+
+    CHECK(lua_gc(L, LUA_GCSETTABLESHRINK, 0) == 25);
 }
 
-TEST_CASE("Constructs")
+TEST_CASE("GCThreadPool")
 {
-    runConformance("constructs.lua");
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCSETTHREADPOOL, 4) == 0);
+
+    // collected threads from category 1 leave their stacks in the pool
+    lua_setmemcat(L, 1);
+    for (int i = 0; i < 8; i++)
+    {
+        lua_newthread(L);
+        lua_pop(L, 1);
+    }
+    lua_setmemcat(L, 0);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    CHECK(lua_totalbytes(L, 1) == 0);
+
+    // threads created in category 2 take the stacks over, along with their memory accounting
+    lua_setmemcat(L, 2);
+    lua_State* L1 = lua_newthread(L);
+    lua_setmemcat(L, 0);
+    CHECK(lua_totalbytes(L, 2) > 0);
+
+    for (int i = 0; i < LUA_MINSTACK; i++)
+        lua_pushinteger(L1, i);
+    CHECK(lua_tointeger(L1, 1) == 0);
+    CHECK(lua_tointeger(L1, -1) == LUA_MINSTACK - 1);
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+    CHECK(lua_totalbytes(L, 2) == 0);
+
+    // reused stacks count towards the limits of the new category
+    lua_setmemcatlimit(L, 3, 0, 512);
+    lua_pushcfunction(L, [](lua_State* L) { lua_newthread(L); return 1; }, "newthread");
+    lua_setmemcat(L, 3);
+    CHECK(lua_pcall(L, 0, 1, 0) == LUA_ERRMEM);
+    lua_setmemcat(L, 0);
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+    CHECK(lua_totalbytes(L, 3) == 0);
+
+    // lowering the limit releases the pooled stacks
+    size_t before = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
+    CHECK(lua_gc(L, LUA_GCSETTHREADPOOL, 0) == 4);
+    size_t after = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
+    CHECK(after < before);
 }
 
-TEST_CASE("Closure")
+static int memcatLimitCalls = 0;
+
+TEST_CASE("GCMemcatLimits")
 {
-    runConformance("closure.lua");
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    memcatLimitCalls = 0;
+
+    lua_callbacks(L)->memcatlimit = [](lua_State* L, int category, size_t size) {
+        CHECK(category == 1);
+        CHECK(size > 256 * 1024);
+        memcatLimitCalls++;
+    };
+
+    lua_setmemcatlimit(L, 1, 256 * 1024, 1024 * 1024);
+
+    const char* source = R"(
+        local garbage, live = 0, {}
+        for i = 1, 1000 do
+            local t = table.create(100, i)
+            garbage += #t
+        end
+        for i = 1, 100000 do
+            table.insert(live, { i })
+        end
+        return garbage
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+
+    lua_State* L1 = lua_newthread(L);
+    lua_setmemcat(L1, 1);
+    int result = luau_load(L1, "=GCMemcatLimits", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    lua_setmemcat(L1, 0);
+
+    REQUIRE(result == 0);
+
+    // the sandbox runs out of memory at the hard limit
+    lua_setmemcat(L1, 1);
+    CHECK(lua_pcall(L1, 0, 1, 0) == LUA_ERRMEM);
+    lua_setmemcat(L1, 0);
+
+    CHECK(memcatLimitCalls > 0);
+
+    lua_pop(L, 1);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    CHECK(lua_totalbytes(L, 1) < 256 * 1024);
+
+    // other categories aren't affected
+    lua_createtable(L, 1000000, 0);
+    CHECK(lua_totalbytes(L, 0) > 1024 * 1024);
+    lua_pop(L, 1);
+
+    // limits can be removed
+    lua_setmemcatlimit(L, 1, 0, 0);
+
+    lua_setmemcat(L, 1);
+    lua_createtable(L, 1000000, 0);
+    CHECK(lua_totalbytes(L, 1) > 1024 * 1024);
+    lua_pop(L, 1);
+    lua_setmemcat(L, 0);
 }
 
-TEST_CASE("Calls")
+TEST_CASE("GCMemcatLimitStep")
 {
-    runConformance("calls.lua");
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    // the heap goal after a full collection leaves plenty of room for the allocations below
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    lua_setmemcatlimit(L, 1, 1024, 0);
+    lua_setmemcat(L, 1);
+
+    lua_GCMetrics before = {};
+    lua_gcmetrics(L, &before);
+
+    // crossing the soft limit doesn't run the collector inside the allocation
+    lua_createtable(L, 1000, 0);
+
+    lua_GCMetrics crossed = {};
+    lua_gcmetrics(L, &crossed);
+    CHECK(crossed.steps == before.steps);
+
+    // the step runs at the next GC check
+    lua_createtable(L, 0, 0);
+
+    lua_GCMetrics after = {};
+    lua_gcmetrics(L, &after);
+    CHECK(after.steps == before.steps + 1);
+
+    lua_pop(L, 2);
+    lua_setmemcat(L, 0);
 }
 
-TEST_CASE("Attrib")
+TEST_CASE("GCAllocCache")
 {
-    runConformance("attrib.lua");
+    runConformance("gc.lua", [](lua_State* L) {
+        lua_gc(L, LUA_GCSETALLOCCACHE, 8);
+    });
+
+    runConformance("coroutine.lua", [](lua_State* L) {
+        lua_gc(L, LUA_GCSETALLOCCACHE, 8);
+    });
 }
 
-TEST_CASE("GC")
+TEST_CASE("GCAllocCacheThreads")
 {
-    runConformance("gc.lua");
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCSETALLOCCACHE, 16) == 0);
+    CHECK(lua_gc(L, LUA_GCALLOCCACHEHITRATE, 0) == 0);
+
+    lua_newtable(L);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        lua_State* L1 = lua_newthread(L);
+        lua_newtable(L1);
+
+        for (int j = 0; j < 100; ++j)
+        {
+            lua_newtable(L1);
+            lua_pushnumber(L1, j);
+            lua_setfield(L1, -2, "value");
+            lua_rawseti(L1, -2, j + 1);
+        }
+
+        // only keep every other thread alive so that caches of collected threads are returned to pages
+        if (i % 2 == 0)
+            lua_rawseti(L, -2, i + 1);
+        else
+            lua_pop(L, 1);
+
+        lua_gc(L, LUA_GCSTEP, 1);
+        luaC_validate(L);
+    }
+
+    CHECK(lua_gc(L, LUA_GCALLOCCACHEHITRATE, 1) > 50);
+    CHECK(lua_gc(L, LUA_GCALLOCCACHEHITRATE, 0) == 0);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        REQUIRE(lua_rawgeti(L, -1, i + 1) == LUA_TTHREAD);
+        lua_State* L1 = lua_tothread(L, -1);
+
+        for (int j = 0; j < 100; ++j)
+        {
+            REQUIRE(lua_rawgeti(L1, -1, j + 1) == LUA_TTABLE);
+            CHECK(lua_getfield(L1, -1, "value") == LUA_TNUMBER);
+            CHECK(lua_tonumber(L1, -1) == j);
+            lua_pop(L1, 2);
+        }
+
+        lua_pop(L, 1);
+    }
 }
 
 TEST_CASE("Bitwise")
@@ -729,6 +2277,93 @@ TEST_CASE("Coroutine")
     runConformance("coroutine.lua");
 }
 
+TEST_CASE("TaskLibrary")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    lua_pushcfunction(L, luaopen_task, NULL);
+    lua_call(L, 0, 0);
+
+    const char* source = R"(
+        log = {}
+        local function note(s) table.insert(log, s) end
+
+        task.spawn(function(a)
+            note("spawn " .. a)
+            local elapsed = task.wait(2)
+            note("waited " .. elapsed)
+        end, 1)
+
+        task.defer(function(a, b) note("defer " .. a + b) end, 2, 3)
+        task.delay(1, function(a) note("delay " .. a) end, 4)
+
+        local cancelled = task.delay(1, function() note("cancelled") end)
+        task.cancel(cancelled)
+
+        task.defer(function()
+            note("outer")
+            task.defer(function() note("inner") end)
+        end)
+
+        task.defer(function() error("oops") end)
+        task.defer(function() note("after error") end)
+
+        assert(not pcall(task.wait))
+        assert(not pcall(task.cancel, coroutine.running()))
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=TaskLibrary", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 0, 0) == LUA_OK);
+
+    auto getlog = [](lua_State* L) {
+        std::string log;
+        lua_getglobal(L, "log");
+        for (int i = 1; i <= lua_objlen(L, -1); i++)
+        {
+            lua_rawgeti(L, -1, i);
+            log += lua_tostring(L, -1);
+            log += ";";
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+        return log;
+    };
+
+    double next = -1;
+    CHECK(luaL_taskpending(L, &next) == 7);
+    CHECK(next == 0);
+
+    // a failing task stops the step, the rest of the queue runs in the next one
+    CHECK(luaL_taskstep(L, 0) == LUA_ERRRUN);
+    CHECK(std::string(lua_tostring(L, -1)) == "TaskLibrary:22: oops");
+    lua_pop(L, 1);
+    CHECK(getlog(L) == "spawn 1;defer 5;outer;");
+
+    CHECK(luaL_taskstep(L, 0) == LUA_OK);
+    CHECK(getlog(L) == "spawn 1;defer 5;outer;after error;inner;");
+
+    CHECK(luaL_taskpending(L, &next) == 3);
+    CHECK(next == 1);
+
+    CHECK(luaL_taskstep(L, 1.5) == LUA_OK);
+    CHECK(getlog(L) == "spawn 1;defer 5;outer;after error;inner;delay 4;");
+
+    CHECK(luaL_taskstep(L, 2.5) == LUA_OK);
+    CHECK(getlog(L) == "spawn 1;defer 5;outer;after error;inner;delay 4;waited 2.5;");
+
+    CHECK(luaL_taskpending(L, &next) == 0);
+
+    luaC_validate(L);
+}
+
 static int cxxthrow(lua_State* L)
 {
 #if LUA_USE_LONGJMP
@@ -814,6 +2449,28 @@ TEST_CASE("Vector")
         nullptr, nullptr, &copts, false, &nativeOpts);
 }
 
+TEST_CASE("VectorLibrary")
+{
+    ScopedFastFlag luauCompileVectorLibrary{FFlag::LuauCompileVectorLibrary, true};
+
+    lua_CompileOptions copts = defaultOptions();
+
+    SUBCASE("O0")
+    {
+        copts.optimizationLevel = 0;
+    }
+    SUBCASE("O1")
+    {
+        copts.optimizationLevel = 1;
+    }
+    SUBCASE("O2")
+    {
+        copts.optimizationLevel = 2;
+    }
+
+    runConformance("vector_library.lua", nullptr, nullptr, nullptr, &copts);
+}
+
 static void populateRTTI(lua_State* L, Luau::TypeId type)
 {
     if (auto p = Luau::get<Luau::PrimitiveType>(type))
@@ -1084,10 +2741,76 @@ TEST_CASE("Debugger")
         },
         nullptr, &copts, /* skipCodegen */ true); // Native code doesn't support debugging yet
 
-    CHECK(breakhits == 16); // 2 hits per breakpoint
+    CHECK(breakhits == 16); // 2 hits per breakpoint
+
+    if (singlestep)
+        CHECK(stephits > 100); // note; this will depend on number of instructions which can vary, so we just make sure the callback gets hit often
+}
+
+TEST_CASE("DebuggerNativeBreakpoints")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    static int breakhits = 0;
+    breakhits = 0;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luau_codegen_create(L);
+    luaL_openlibs(L);
+    setupNativeHelpers(L);
+    luaL_sandbox(L);
+
+    lua_callbacks(L)->debugbreak = [](lua_State* L, lua_Debug* ar) {
+        breakhits++;
+    };
+
+    const char* source = R"(
+local function a()
+    return is_native()
+end
+local function b()
+    return is_native()
+end
+return a, b
+)";
+
+    lua_CompileOptions copts = defaultOptions();
+    copts.debugLevel = 2;
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), &copts, &bytecodeSize);
+    int result = luau_load(L, "=DebuggerNativeBreakpoints", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    Luau::CodeGen::compile(L, -1, defaultCodegenOptions());
+    REQUIRE(lua_pcall(L, 0, 2, 0) == LUA_OK);
+
+    auto callNative = [&](int idx) {
+        lua_pushvalue(L, idx);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+        bool native = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        return native;
+    };
+
+    CHECK(callNative(-2));
+    CHECK(callNative(-1));
 
-    if (singlestep)
-        CHECK(stephits > 100); // note; this will depend on number of instructions which can vary, so we just make sure the callback gets hit often
+    // only the function with the breakpoint falls back to the interpreter
+    CHECK(lua_breakpoint(L, -2, 3, true) == 3);
+    CHECK(!callNative(-2));
+    CHECK(callNative(-1));
+    CHECK(breakhits == 1);
+
+    // native code is restored after the breakpoint is removed
+    CHECK(lua_breakpoint(L, -2, 3, false) == 3);
+    CHECK(callNative(-2));
+    CHECK(callNative(-1));
+    CHECK(breakhits == 1);
 }
 
 TEST_CASE("NDebugGetUpValue")
@@ -1251,6 +2974,30 @@ TEST_CASE("ApiTables")
     CHECK(lua_next(L, -2) == 0);
 
     lua_pop(L, 1);
+
+    // lua_createtablefrom
+    const char* keys[] = {"a", "b", "c", "a"};
+    lua_pushnumber(L, 1.0);
+    lua_pushstring(L, "two");
+    lua_pushnil(L);
+    lua_pushnumber(L, 4.0);
+    lua_createtablefrom(L, keys, 4);
+    CHECK(lua_gettop(L) == 1);
+
+    CHECK(lua_rawgetfield(L, -1, "a") == LUA_TNUMBER);
+    CHECK(lua_tonumber(L, -1) == 4.0);
+    lua_pop(L, 1);
+    CHECK(lua_rawgetfield(L, -1, "b") == LUA_TSTRING);
+    CHECK(strcmp(lua_tostring(L, -1), "two") == 0);
+    lua_pop(L, 1);
+    CHECK(lua_rawgetfield(L, -1, "c") == LUA_TNIL);
+    lua_pop(L, 1);
+
+    lua_createtablefrom(L, nullptr, 0);
+    lua_pushnil(L);
+    CHECK(lua_next(L, -2) == 0);
+
+    lua_pop(L, 2);
 }
 
 TEST_CASE("ApiIter")
@@ -1291,6 +3038,158 @@ TEST_CASE("ApiIter")
     lua_pop(L, 1);
 }
 
+struct RefsAllocState
+{
+    size_t failSize = 0;
+    std::unordered_map<void*, size_t> sizes;
+    int sizeMismatches = 0;
+};
+
+static void* refsRealloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+    RefsAllocState* state = (RefsAllocState*)ud;
+
+    if (ptr)
+    {
+        auto it = state->sizes.find(ptr);
+        if (it == state->sizes.end() || it->second != osize)
+            state->sizeMismatches++;
+    }
+
+    if (nsize == 0)
+    {
+        state->sizes.erase(ptr);
+        free(ptr);
+        return nullptr;
+    }
+
+    if (nsize == state->failSize)
+        return nullptr;
+
+    void* result = realloc(ptr, nsize);
+
+    if (result)
+    {
+        state->sizes.erase(ptr);
+        state->sizes[result] = nsize;
+    }
+
+    return result;
+}
+
+TEST_CASE("ApiRefsOutOfMemory")
+{
+    RefsAllocState state;
+
+    {
+        StateRef globalState(lua_newstate(refsRealloc, &state), lua_close);
+        lua_State* L = globalState.get();
+
+        lua_pushboolean(L, true);
+
+        // fill the slab up to 4096 slots, so that the next reference grows both arrays to 8192 slots
+        for (int i = 1; i < 4096; ++i)
+            lua_ref(L, -1);
+
+        // running out of memory for either array leaves the slab unchanged
+        for (size_t failSize : {8192, 8192 * 16})
+        {
+            state.failSize = failSize;
+            lua_pushcfunction(L, [](lua_State* L) { return lua_ref(L, 1); }, "ref");
+            lua_pushboolean(L, true);
+            CHECK(lua_pcall(L, 1, 1, 0) == LUA_ERRMEM);
+            lua_pop(L, 1);
+        }
+
+        state.failSize = 0;
+
+        int ref = lua_ref(L, -1);
+        CHECK(lua_getref(L, ref) == LUA_TBOOLEAN);
+        lua_pop(L, 2);
+    }
+
+    CHECK(state.sizeMismatches == 0);
+    CHECK(state.sizes.empty());
+}
+
+TEST_CASE("ApiRefs")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_pushnil(L);
+    CHECK(lua_ref(L, -1) == LUA_REFNIL);
+    lua_pop(L, 1);
+
+    CHECK(lua_getref(L, LUA_REFNIL) == LUA_TNIL);
+    CHECK(lua_getref(L, LUA_NOREF) == LUA_TNIL);
+    lua_pop(L, 2);
+
+    // references keep objects alive across full collections
+    std::vector<int> refs;
+    for (int i = 0; i < 1000; ++i)
+    {
+        lua_newtable(L);
+        lua_pushinteger(L, i);
+        lua_setfield(L, -2, "value");
+        refs.push_back(lua_ref(L, -1));
+        lua_pop(L, 1);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(lua_getref(L, refs[i]) == LUA_TTABLE);
+        lua_getfield(L, -1, "value");
+        CHECK(lua_tointeger(L, -1) == i);
+        lua_pop(L, 2);
+    }
+
+    // released slots are reused, but the old references are detected as stale
+    int stale = refs[10];
+    lua_unref(L, stale);
+
+    lua_pushstring(L, "reused");
+    int ref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    CHECK(ref != stale);
+    CHECK(lua_getref(L, stale) == LUA_TNIL);
+    CHECK(lua_getref(L, ref) == LUA_TSTRING);
+    CHECK(strcmp(lua_tostring(L, -1), "reused") == 0);
+    lua_pop(L, 2);
+
+    // objects are released once their references are
+    lua_unref(L, ref);
+    for (int i = 0; i < 1000; ++i)
+        if (i != 10)
+            lua_unref(L, refs[i]);
+
+    size_t before = lua_totalbytes(L, 0);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    CHECK(lua_totalbytes(L, 0) < before);
+
+    // references created during an incremental cycle stay alive until it completes
+    lua_gc(L, LUA_GCSTEP, 1);
+
+    lua_newtable(L);
+    ref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    while (!lua_gc(L, LUA_GCSTEP, 1))
+        ;
+    luaC_validate(L);
+
+    CHECK(lua_getref(L, ref) == LUA_TTABLE);
+    lua_pop(L, 1);
+
+    lua_unref(L, ref);
+}
+
 TEST_CASE("ApiCalls")
 {
     StateRef globalState = runConformance("apicalls.lua", nullptr, nullptr, lua_newstate(limitedRealloc, nullptr));
@@ -1318,6 +3217,54 @@ TEST_CASE("ApiCalls")
         lua_pop(L, 1);
     }
 
+    // prepared calls
+    {
+        lua_getfield(L, LUA_GLOBALSINDEX, "add");
+        int call = lua_preparecall(L, -1);
+        lua_pop(L, 1);
+
+        int top = lua_gettop(L);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            lua_pushnumber(L, i);
+            lua_pushnumber(L, 2);
+            CHECK(lua_pcallprepared(L, call, 2, 1) == LUA_OK);
+            CHECK(lua_tonumber(L, -1) == i + 2);
+            lua_pop(L, 1);
+        }
+
+        lua_pushnumber(L, 40);
+        lua_newtable(L);
+        CHECK(lua_pcallprepared(L, call, 2, 1) == LUA_ERRRUN);
+        CHECK(lua_isstring(L, -1));
+        lua_pop(L, 1);
+
+        CHECK(lua_gettop(L) == top);
+
+        // the function slot doesn't need to be reserved by the caller: C functions start with LUA_MINSTACK free slots, all used here
+        lua_pushcfunction(
+            L,
+            [](lua_State* L) {
+                int call = lua_tointeger(L, 1);
+
+                while (lua_gettop(L) < LUA_MINSTACK - 1)
+                    lua_pushnil(L);
+
+                lua_pushnumber(L, 40);
+                lua_pushnumber(L, 2);
+                CHECK(lua_pcallprepared(L, call, 2, 1) == LUA_OK);
+                return 1;
+            },
+            "fullstack");
+        lua_pushinteger(L, call);
+        lua_call(L, 1, 1);
+        CHECK(lua_tonumber(L, -1) == 42);
+        lua_pop(L, 1);
+
+        lua_unpreparecall(L, call);
+    }
+
     // lua_equal with a sleeping thread wake up
     {
         lua_State* L2 = lua_newthread(L);
@@ -1441,39 +3388,355 @@ TEST_CASE("ApiCalls")
     }
 }
 
-TEST_CASE("ApiAtoms")
-{
-    StateRef globalState(luaL_newstate(), lua_close);
-    lua_State* L = globalState.get();
+TEST_CASE("ApiAtoms")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_callbacks(L)->useratom = [](const char* s, size_t l) -> int16_t {
+        if (strcmp(s, "string") == 0)
+            return 0;
+        if (strcmp(s, "important") == 0)
+            return 1;
+
+        return -1;
+    };
+
+    lua_pushstring(L, "string");
+    lua_pushstring(L, "import");
+    lua_pushstring(L, "ant");
+    lua_concat(L, 2);
+    lua_pushstring(L, "unimportant");
+
+    int a1, a2, a3;
+    const char* s1 = lua_tostringatom(L, -3, &a1);
+    const char* s2 = lua_tostringatom(L, -2, &a2);
+    const char* s3 = lua_tostringatom(L, -1, &a3);
+
+    CHECK(strcmp(s1, "string") == 0);
+    CHECK(a1 == 0);
+
+    CHECK(strcmp(s2, "important") == 0);
+    CHECK(a2 == 1);
+
+    CHECK(strcmp(s3, "unimportant") == 0);
+    CHECK(a3 == -1);
+}
+
+TEST_CASE("ApiAtomTable")
+{
+    lua_Alloc alloc = [](void* ud, void* ptr, size_t osize, size_t nsize) -> void* {
+        if (nsize == 0)
+        {
+            free(ptr);
+            return nullptr;
+        }
+
+        return realloc(ptr, nsize);
+    };
+
+    std::string longname(100, 'x');
+    const char* names[] = {"string", "important", "string", longname.c_str()};
+
+    std::unique_ptr<lua_AtomTable, void (*)(lua_AtomTable*)> atoms(lua_newatomtable(alloc, nullptr, names, 4), lua_freeatomtable);
+    REQUIRE(atoms);
+
+    // the table is shared between states and takes precedence over the callback
+    StateRef state1(luaL_newstate(), lua_close);
+    StateRef state2(luaL_newstate(), lua_close);
+
+    for (lua_State* L : {state1.get(), state2.get()})
+    {
+        lua_callbacks(L)->useratom = [](const char* s, size_t l) -> int16_t {
+            return 42;
+        };
+
+        lua_setatomtable(L, atoms.get());
+
+        lua_pushstring(L, "string");
+        lua_pushstring(L, "import");
+        lua_pushstring(L, "ant");
+        lua_concat(L, 2);
+        lua_pushstring(L, longname.c_str());
+        lua_pushstring(L, "unimportant");
+
+        int a1, a2, a3, a4;
+        lua_tostringatom(L, -4, &a1);
+        lua_tostringatom(L, -3, &a2);
+        lua_tostringatom(L, -2, &a3);
+        lua_tostringatom(L, -1, &a4);
+
+        CHECK(a1 == 0); // duplicate names keep the first atom
+        CHECK(a2 == 1);
+        CHECK(a3 == 3);
+        CHECK(a4 == -1);
+
+        lua_pop(L, 4);
+    }
+
+    // namecall dispatch on the atom of the method name
+    lua_State* L = state1.get();
+    luaL_openlibs(L);
+
+    lua_newuserdata(L, 0);
+    lua_newtable(L);
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            int atom = -1;
+            CHECK(lua_namecallatom(L, &atom));
+            lua_pushinteger(L, atom);
+            return 1;
+        },
+        "__namecall");
+    lua_setfield(L, -2, "__namecall");
+    lua_setmetatable(L, -2);
+    lua_setglobal(L, "obj");
+
+    const char* source = "return obj:important() * 10 + obj:unimportant()";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=ApiAtomTable", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tointeger(L, -1) == 9);
+}
+
+static int hostBuiltinFastCalls = 0;
+static int hostBuiltinSlowCalls = 0;
+
+TEST_CASE("HostBuiltins")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    if (codegen && luau_codegen_supported())
+        luau_codegen_create(L);
+
+    luaL_openlibs(L);
+
+    hostBuiltinFastCalls = 0;
+    hostBuiltinSlowCalls = 0;
+
+    // regular implementations are used when the fast path is unavailable or refuses the arguments
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            hostBuiltinSlowCalls++;
+            double a = luaL_checknumber(L, 1);
+            double b = luaL_checknumber(L, 2);
+            double t = luaL_optnumber(L, 3, 0.5);
+            lua_pushnumber(L, a + (b - a) * t);
+            return 1;
+        },
+        "lerp");
+    lua_setglobal(L, "lerp");
+
+    lua_newtable(L);
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            hostBuiltinSlowCalls++;
+            lua_pushnumber(L, fabs(luaL_checknumber(L, 1) - luaL_checknumber(L, 2)));
+            return 1;
+        },
+        "dist");
+    lua_setfield(L, -2, "dist");
+    lua_setglobal(L, "geom");
+
+    lua_setsafeenv(L, LUA_GLOBALSINDEX, true);
+
+    lua_sethostbuiltin(L, 0, [](lua_State* L, double* res, const double* args, int nargs) {
+        if (nargs < 2)
+            return -1;
+
+        hostBuiltinFastCalls++;
+        res[0] = args[0] + (args[1] - args[0]) * (nargs > 2 ? args[2] : 0.5);
+        return 1;
+    });
+
+    // ids are distinct so that a misplaced entry in the builtin table calls the wrong function
+    lua_sethostbuiltin(L, 1, [](lua_State* L, double* res, const double* args, int nargs) {
+        if (nargs != 2)
+            return -1;
+
+        hostBuiltinFastCalls += 1000;
+        res[0] = fabs(args[0] - args[1]);
+        return 1;
+    });
+
+    const char* hostBuiltins[] = {"lerp", "geom.dist", nullptr};
+
+    lua_CompileOptions copts = defaultOptions();
+    copts.hostBuiltins = hostBuiltins;
+
+    const char* source = R"(
+local sum = 0
+for i = 1, 10 do
+    sum += lerp(i, 2 * i, 0.25) + geom.dist(i, 3)
+end
+local fallback = lerp("1", 3)
+return sum, fallback
+)";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), &copts, &bytecodeSize);
+    int result = luau_load(L, "=HostBuiltins", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    if (codegen && luau_codegen_supported())
+        luau_codegen_compile(L, -1);
+
+    REQUIRE(lua_pcall(L, 0, 2, 0) == LUA_OK);
+
+    // sum of 1.25 * i for 1..10 and |i - 3| for 1..10
+    CHECK(lua_tonumber(L, -2) == 68.75 + 31);
+    CHECK(lua_tonumber(L, -1) == 2);
+
+    CHECK(hostBuiltinFastCalls == 10 + 10 * 1000);
+    CHECK(hostBuiltinSlowCalls == 1);
+}
+
+static int userdataOpsNativeCalls = 0;
+static int userdataOpsMetamethodCalls = 0;
+
+TEST_CASE("UserdataOps")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    if (codegen && luau_codegen_supported())
+        luau_codegen_create(L);
+
+    luaL_openlibs(L);
+
+    userdataOpsNativeCalls = 0;
+    userdataOpsMetamethodCalls = 0;
+
+    const int kTag = 13;
+
+    // metamethods are used for operands that the native operators don't handle
+    lua_newtable(L);
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            userdataOpsMetamethodCalls++;
+            double a = lua_isuserdata(L, 1) ? *(double*)lua_touserdatatagged(L, 1, kTag) : luaL_checknumber(L, 1);
+            double b = lua_isuserdata(L, 2) ? *(double*)lua_touserdatatagged(L, 2, kTag) : luaL_checknumber(L, 2);
+            lua_pushnumber(L, a + b);
+            return 1;
+        },
+        "__add");
+    lua_setfield(L, -2, "__add");
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            userdataOpsMetamethodCalls++;
+            lua_pushboolean(L, false);
+            return 1;
+        },
+        "__eq");
+    lua_setfield(L, -2, "__eq");
+    lua_setuserdatametatable(L, kTag, -1);
+
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            double v = luaL_checknumber(L, 1);
+            *(double*)lua_newuserdatatagged(L, sizeof(double), kTag) = v;
+            lua_getuserdatametatable(L, kTag);
+            lua_setmetatable(L, -2);
+            return 1;
+        },
+        "num");
+    lua_setglobal(L, "num");
 
-    lua_callbacks(L)->useratom = [](const char* s, size_t l) -> int16_t {
-        if (strcmp(s, "string") == 0)
-            return 0;
-        if (strcmp(s, "important") == 0)
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            lua_pushnumber(L, *(double*)lua_touserdatatagged(L, 1, kTag));
             return 1;
+        },
+        "value");
+    lua_setglobal(L, "value");
 
-        return -1;
+    static const lua_UserdataOps ops = {
+        [](lua_State* L, void* res, const void* a, const void* b) {
+            userdataOpsNativeCalls++;
+            *(double*)res = *(const double*)a + *(const double*)b;
+        },
+        [](lua_State* L, void* res, const void* a, const void* b) {
+            userdataOpsNativeCalls++;
+            *(double*)res = *(const double*)a - *(const double*)b;
+        },
+        [](lua_State* L, void* res, const void* a, const void* b) {
+            userdataOpsNativeCalls++;
+            *(double*)res = *(const double*)a * *(const double*)b;
+        },
+        [](lua_State* L, void* res, const void* a, const void* b) {
+            userdataOpsNativeCalls++;
+            *(double*)res = *(const double*)a / *(const double*)b;
+        },
+        [](lua_State* L, void* res, const void* a) {
+            userdataOpsNativeCalls++;
+            *(double*)res = -*(const double*)a;
+        },
+        [](lua_State* L, const void* a, const void* b) {
+            userdataOpsNativeCalls++;
+            return int(*(const double*)a == *(const double*)b);
+        },
+        [](lua_State* L, const void* a, const void* b) {
+            userdataOpsNativeCalls++;
+            return int(*(const double*)a < *(const double*)b);
+        },
+        [](lua_State* L, const void* a, const void* b) {
+            userdataOpsNativeCalls++;
+            return int(*(const double*)a <= *(const double*)b);
+        },
     };
 
-    lua_pushstring(L, "string");
-    lua_pushstring(L, "import");
-    lua_pushstring(L, "ant");
-    lua_concat(L, 2);
-    lua_pushstring(L, "unimportant");
+    lua_setuserdataops(L, kTag, &ops);
 
-    int a1, a2, a3;
-    const char* s1 = lua_tostringatom(L, -3, &a1);
-    const char* s2 = lua_tostringatom(L, -2, &a2);
-    const char* s3 = lua_tostringatom(L, -1, &a3);
+    const char* source = R"(
+local a, b = num(3), num(4)
+local s = a
+for i = 1, 10 do
+    s = s + b
+end
+local d = (s - a) * b / b
+local n = -a
+assert(getmetatable(s) == getmetatable(a))
+return value(s), value(d), value(n), a == num(3), a ~= b, a < b, b <= a, a + 1
+)";
 
-    CHECK(strcmp(s1, "string") == 0);
-    CHECK(a1 == 0);
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=UserdataOps", bytecode, bytecodeSize, 0);
+    free(bytecode);
 
-    CHECK(strcmp(s2, "important") == 0);
-    CHECK(a2 == 1);
+    REQUIRE(result == 0);
 
-    CHECK(strcmp(s3, "unimportant") == 0);
-    CHECK(a3 == -1);
+    if (codegen && luau_codegen_supported())
+        luau_codegen_compile(L, -1);
+
+    REQUIRE(lua_pcall(L, 0, 8, 0) == LUA_OK);
+
+    CHECK(lua_tonumber(L, -8) == 43);
+    CHECK(lua_tonumber(L, -7) == 40);
+    CHECK(lua_tonumber(L, -6) == -3);
+    CHECK(lua_toboolean(L, -5) == 1);
+    CHECK(lua_toboolean(L, -4) == 1);
+    CHECK(lua_toboolean(L, -3) == 1);
+    CHECK(lua_toboolean(L, -2) == 0);
+    CHECK(lua_tonumber(L, -1) == 4);
+
+    CHECK(userdataOpsNativeCalls == 10 + 3 + 1 + 4);
+    CHECK(userdataOpsMetamethodCalls == 1);
 }
 
 static bool endsWith(const std::string& str, const std::string& suffix)
@@ -1746,6 +4009,80 @@ TEST_CASE("Coverage")
         nullptr, nullptr, &copts);
 }
 
+TEST_CASE("CoverageHitOnly")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luau_codegen_create(L);
+
+    const char* source = R"(
+        local s = 0
+        for i = 1, 10 do
+            s += i
+        end
+        return s
+    )";
+
+    lua_CompileOptions copts = defaultOptions();
+    copts.coverageLevel = 1;
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), &copts, &bytecodeSize);
+    int result = luau_load(L, "=CoverageHitOnly", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    Luau::CodeGen::CompilationOptions nativeOptions{Luau::CodeGen::CodeGen_ColdFunctions | Luau::CodeGen::CodeGen_CoverageHitOnly};
+    Luau::CodeGen::compile(L, -1, nativeOptions);
+
+    lua_pushvalue(L, -1);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 55);
+    lua_pop(L, 1);
+
+    static int maxHits = 0;
+    maxHits = 0;
+
+    lua_getcoverage(L, -1, nullptr, [](void* context, const char* function, int linedefined, int depth, const int* hits, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            maxHits = hits[i] > maxHits ? hits[i] : maxHits;
+    });
+
+    // the loop body runs 10 times but only the first hit is recorded
+    CHECK(maxHits == 1);
+
+    // hit counts that the interpreter recorded before the function was compiled are kept
+    bytecode = luau_compile(source, strlen(source), &copts, &bytecodeSize);
+    result = luau_load(L, "=CoverageHitOnly", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    lua_pushvalue(L, -1);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    lua_pop(L, 1);
+
+    Luau::CodeGen::compile(L, -1, nativeOptions);
+
+    lua_pushvalue(L, -1);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    lua_pop(L, 1);
+
+    maxHits = 0;
+
+    lua_getcoverage(L, -1, nullptr, [](void* context, const char* function, int linedefined, int depth, const int* hits, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            maxHits = hits[i] > maxHits ? hits[i] : maxHits;
+    });
+
+    CHECK(maxHits >= 10);
+}
+
 TEST_CASE("StringConversion")
 {
     runConformance("strconv.lua");
@@ -1847,6 +4184,154 @@ TEST_CASE("GCDump")
     CHECK(!ctx.edges.empty());
 }
 
+TEST_CASE("GCHeapSnapshot")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_newtable(L);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        lua_pushfstring(L, "item%d", i);
+        lua_rawseti(L, -2, i + 1);
+    }
+
+    // edge names come from string keys, which can be empty
+    lua_pushstring(L, "empty");
+    lua_setfield(L, -2, "");
+
+    std::vector<uint8_t> data;
+    int chunks = 0;
+
+    auto write = [](void* context, const void* chunk, size_t size) {
+        std::vector<uint8_t>& data = *(std::vector<uint8_t>*)context;
+        data.insert(data.end(), (const uint8_t*)chunk, (const uint8_t*)chunk + size);
+    };
+
+    lua_HeapSnapshot* snapshot = lua_heapsnapshotbegin(L, &data, write);
+
+    // the heap keeps changing between the steps
+    while (!lua_heapsnapshotstep(L, snapshot, 0.0))
+    {
+        lua_pushnil(L);
+        lua_rawseti(L, -2, chunks + 1);
+
+        lua_pushstring(L, "garbage");
+        lua_pop(L, 1);
+
+        lua_gc(L, LUA_GCSTEP, 8);
+        chunks++;
+    }
+
+    CHECK(lua_heapsnapshotstep(L, snapshot, 0.0));
+    lua_heapsnapshotend(L, snapshot);
+    CHECK(chunks > 1);
+
+    // decode the snapshot to make sure it's well-formed
+    size_t pos = 0;
+
+    auto readbyte = [&]() -> uint8_t {
+        REQUIRE(pos < data.size());
+        return data[pos++];
+    };
+
+    auto readvarint = [&]() -> uint64_t {
+        uint64_t result = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            uint8_t byte = readbyte();
+            result |= uint64_t(byte & 127) << shift;
+            if ((byte & 128) == 0)
+                return result;
+        }
+    };
+
+    auto readdelta = [&](uintptr_t base) -> uintptr_t {
+        uint64_t value = readvarint();
+        return base + uintptr_t(int64_t(value >> 1) ^ -int64_t(value & 1));
+    };
+
+    std::string names[256];
+
+    auto readname = [&]() -> std::optional<std::string> {
+        uint64_t value = readvarint();
+        if (value == 0)
+            return std::nullopt;
+        if (value & 1)
+            return names[value >> 1];
+
+        uint8_t slot = readbyte();
+        size_t length = (value >> 1) - 1;
+        REQUIRE(pos + length <= data.size());
+        names[slot] = std::string((const char*)&data[pos], length);
+        pos += length;
+        return names[slot];
+    };
+
+    REQUIRE(data.size() > 5);
+    CHECK(memcmp(data.data(), "LHSN", 4) == 0);
+    CHECK(data[4] == 2);
+    pos = 5;
+
+    uintptr_t lastnode = 0;
+    int strings = 0;
+    int items = 0;
+    int edges = 0;
+    int roots = 0;
+    int emptynames = 0;
+    bool end = false;
+
+    while (!end)
+    {
+        switch (readbyte())
+        {
+        case 0: // HS_END
+            CHECK(readvarint() > 0);
+            end = true;
+            break;
+        case 1: // HS_NODE
+        {
+            lastnode = readdelta(lastnode);
+            uint8_t tt = readbyte();
+            readbyte();
+            readvarint();
+            readname();
+            strings += tt == LUA_TSTRING;
+            break;
+        }
+        case 2: // HS_EDGE
+        {
+            uintptr_t from = readdelta(lastnode);
+            readdelta(from);
+            std::optional<std::string> name = readname();
+            items += name == "array";
+            emptynames += name == "";
+            edges++;
+            break;
+        }
+        case 3: // HS_ROOT
+            readdelta(0);
+            roots++;
+            CHECK(readname().value_or("") != "");
+            break;
+        case 4: // HS_CATEGORY
+            readbyte();
+            readvarint();
+            break;
+        default:
+            FAIL("Unexpected record");
+        }
+    }
+
+    CHECK(pos == data.size());
+    CHECK(roots == 2);
+    CHECK(edges > 0);
+    CHECK(strings > 5000);
+    CHECK(items > 5000);
+    CHECK(emptynames == 1);
+}
+
 TEST_CASE("Interrupt")
 {
     lua_CompileOptions copts = defaultOptions();
@@ -1968,6 +4453,252 @@ TEST_CASE("Interrupt")
     }
 }
 
+TEST_CASE("InterruptBudget")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    static int hits;
+    static int refill;
+    static bool quota;
+
+    lua_callbacks(L)->interrupt = [](lua_State* L, int gc) {
+        if (gc >= 0)
+            return;
+
+        hits++;
+
+        if (refill)
+            lua_setinterruptbudget(L, refill);
+        else if (quota && hits > 1)
+        {
+            lua_checkstack(L, 1); // the callback can be called from a Luau frame that doesn't reserve space for the error message
+            luaL_error(L, "quota exceeded");
+        }
+    };
+
+    const char* source = R"(
+        return function(n)
+            local s = 0
+            for i = 1, n do s += i end
+            return s
+        end
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=InterruptBudget", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    if (codegen && luau_codegen_supported())
+    {
+        luau_codegen_create(L);
+        Luau::CodeGen::compile(L, -1, Luau::CodeGen::CodeGen_ColdFunctions);
+    }
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    auto run = [&](int n) {
+        lua_pushvalue(L, -1);
+        lua_pushinteger(L, n);
+        int status = lua_pcall(L, 1, 1, 0);
+        lua_pop(L, 1);
+        return status;
+    };
+
+    // without a budget, the callback is called at every safepoint
+    hits = 0;
+    refill = 0;
+    quota = false;
+    CHECK(run(1000) == LUA_OK);
+
+    int safepoints = hits;
+    CHECK(safepoints >= 1000);
+
+    // with a budget that the callback refills, it's only called when the budget runs out
+    hits = 0;
+    refill = 100;
+    lua_setinterruptbudget(L, 100);
+    CHECK(run(1000) == LUA_OK);
+    CHECK(hits == safepoints / 100);
+    CHECK(lua_getinterruptbudget(L) == 100 - safepoints % 100);
+
+    // once the budget is exhausted, the callback is called at every safepoint until it sets a new one
+    hits = 0;
+    refill = 0;
+    quota = true;
+    lua_setinterruptbudget(L, 10);
+    CHECK(run(1000) == LUA_ERRRUN);
+    CHECK(hits == 2);
+    CHECK(lua_getinterruptbudget(L) == 0);
+
+    // budgets are per thread
+    lua_State* T = lua_newthread(L);
+    CHECK(lua_getinterruptbudget(T) == 0);
+    lua_pop(L, 1);
+}
+
+TEST_CASE("HotFunction")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    static std::vector<std::string> reported;
+    reported.clear();
+
+    lua_callbacks(L)->hotfunction = [](lua_State* L) {
+        lua_Debug ar = {};
+        lua_getinfo(L, 0, "n", &ar);
+        reported.push_back(ar.name ? ar.name : "?");
+    };
+
+    lua_sethotthreshold(L, 100);
+
+    const char* source = R"(
+        local function called(x) return x + 1 end
+        local function looped(n) local s = 0 for i = 1, n do s += i end return s end
+        local function cold(x) return x end
+
+        local s = 0
+        for i = 1, 99 do s = called(s) end
+        assert(s == 99)
+        assert(looped(50) == 1275)
+        assert(cold(1) == 1)
+        for i = 1, 1000 do s = called(s) end
+        assert(s == 1099)
+        assert(looped(1000) == 500500)
+        return s
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=HotFunction", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 1099);
+
+    // each function is reported once when it crosses the threshold; the main chunk loops long enough to be reported as well
+    REQUIRE(reported.size() == 3);
+    CHECK(reported[0] == "called");
+    CHECK(reported[1] == "?");
+    CHECK(reported[2] == "looped");
+}
+
+TEST_CASE("AllocationSampling")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    static size_t sampledBytes = 0;
+    static int samples = 0;
+    static int samplesInAllocate = 0;
+    sampledBytes = 0;
+    samples = 0;
+    samplesInAllocate = 0;
+
+    lua_callbacks(L)->allocsample = [](lua_State* L, int category, size_t size) {
+        CHECK(size % 1024 == 0);
+        sampledBytes += size;
+        samples++;
+
+        lua_Debug ar = {};
+        if (lua_getinfo(L, 0, "n", &ar) && ar.name && strcmp(ar.name, "allocate") == 0)
+            samplesInAllocate++;
+    };
+
+    const char* source = R"(
+        local function allocate(n) local t = {} for i = 1, n do t[i] = { i } end return t end
+        return #allocate(10000)
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=AllocationSampling", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    lua_setallocsamplerate(L, 1024);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    lua_setallocsamplerate(L, 0);
+
+    CHECK(lua_tonumber(L, -1) == 10000);
+
+    // 10000 tables with an array part each allocate more than half a megabyte, and most of it is attributed to allocate
+    CHECK(sampledBytes > 512 * 1024);
+    CHECK(samplesInAllocate > samples / 2);
+}
+
+TEST_CASE("TypeProfiling")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    lua_settypeprofiling(L, 1);
+
+    const char* source = R"(
+        local function add(a, b) return a + b end
+        local function mixed(a) return a end
+
+        for i = 1, 10 do add(i, 2) end
+        assert(mixed(1) == 1)
+        assert(mixed("x") == "x")
+        return add, mixed
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=TypeProfiling", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+    REQUIRE(lua_pcall(L, 0, 2, 0) == LUA_OK);
+
+    Luau::CodeGen::AssemblyOptions options;
+    options.target = Luau::CodeGen::AssemblyOptions::Target::X64_SystemV;
+    options.includeAssembly = false;
+    options.includeIr = true;
+    options.includeOutlinedCode = false;
+    options.includeIrPrefix = Luau::CodeGen::IncludeIrPrefix::No;
+    options.includeUseInfo = Luau::CodeGen::IncludeUseInfo::No;
+    options.includeCfgInfo = Luau::CodeGen::IncludeCfgInfo::No;
+    options.includeRegFlowInfo = Luau::CodeGen::IncludeRegFlowInfo::No;
+
+    // arguments that always had the same type get entry checks, just like annotated ones
+    std::string add = Luau::CodeGen::getAssembly(L, -2, options);
+    CHECK(add.find("CHECK_TAG R0, tnumber, exit(entry)") != std::string::npos);
+    CHECK(add.find("CHECK_TAG R1, tnumber, exit(entry)") != std::string::npos);
+
+    std::string mixed = Luau::CodeGen::getAssembly(L, -1, options);
+    CHECK(mixed.find("exit(entry)") == std::string::npos);
+
+    if (codegen && luau_codegen_supported())
+    {
+        luau_codegen_create(L);
+        Luau::CodeGen::compile(L, -2, Luau::CodeGen::CodeGen_ColdFunctions);
+
+        // specialized native code falls back to the interpreter for other types
+        lua_pushvalue(L, -2);
+        lua_pushstring(L, "1");
+        lua_pushnumber(L, 2);
+        REQUIRE(lua_pcall(L, 2, 1, 0) == LUA_OK);
+        CHECK(lua_tonumber(L, -1) == 3);
+        lua_pop(L, 1);
+    }
+}
+
 TEST_CASE("UserdataApi")
 {
     static int dtorhits = 0;
@@ -2067,6 +4798,84 @@ TEST_CASE("UserdataApi")
     CHECK(dtorhits == 42);
 }
 
+TEST_CASE("UserdataBatch")
+{
+    static int dtorcalls = 0;
+    static int dtorsum = 0;
+
+    dtorcalls = 0;
+    dtorsum = 0;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_setuserdatabatchdtor(L, 12, [](lua_State* L, void** data, int count) {
+        dtorcalls++;
+        for (int i = 0; i < count; ++i)
+            dtorsum += *(int*)data[i];
+    });
+
+    lua_newtable(L);
+    lua_pushstring(L, "handle");
+    lua_setfield(L, -2, "__type");
+    lua_setuserdatametatable(L, 12, -1);
+
+    const int count = 1000;
+    std::vector<void*> data(count);
+    lua_newuserdatataggedbatch(L, sizeof(int), 12, count, data.data());
+
+    for (int i = 0; i < count; ++i)
+        *(int*)data[i] = i + 1;
+
+    CHECK(lua_objlen(L, -1) == count);
+
+    lua_rawgeti(L, -1, 10);
+    CHECK(lua_touserdatatagged(L, -1, 12) == data[9]);
+    CHECK(strcmp(luaL_typename(L, -1), "handle") == 0);
+    lua_pop(L, 1);
+
+    // a single userdata that isn't part of a batch gets the same destructor
+    *(int*)lua_newuserdatatagged(L, sizeof(int), 12) = 1;
+
+    lua_pop(L, 2);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    CHECK(dtorsum == count * (count + 1) / 2 + 1);
+    CHECK(dtorcalls < count / 2);
+}
+
+TEST_CASE("UserdataBatchDtorPointers")
+{
+    static std::vector<void*> freed;
+
+    freed.clear();
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_setuserdatabatchdtor(L, 13, [](lua_State* L, void** data, int count) {
+        for (int i = 0; i < count; ++i)
+            freed.push_back(data[i]);
+    });
+
+    // destructor receives the addresses of userdata data during a collection
+    void* collected[2] = {lua_newuserdatatagged(L, sizeof(int), 13), lua_newuserdatatagged(L, sizeof(int), 13)};
+    lua_pop(L, 2);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    std::sort(collected, collected + 2);
+    std::sort(freed.begin(), freed.end());
+    CHECK(freed == std::vector<void*>(collected, collected + 2));
+
+    // and when the userdata is freed one at a time on close
+    freed.clear();
+
+    void* closed = lua_newuserdatatagged(L, sizeof(int), 13);
+    globalState.reset();
+
+    CHECK(freed == std::vector<void*>{closed});
+}
+
 TEST_CASE("LightuserdataApi")
 {
     StateRef globalState(luaL_newstate(), lua_close);
@@ -2129,6 +4938,120 @@ TEST_CASE("DebugApi")
     CHECK(lua_getinfo(L, -10, "f", &ar) == 0); // not on stack
 }
 
+static lua_TraceFrame traceFrames[8];
+static int traceFrameCount = 0;
+static std::vector<std::string> traceExpected;
+
+TEST_CASE("DebugCaptureTrace")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    if (codegen && luau_codegen_supported())
+        luau_codegen_create(L);
+
+    luaL_openlibs(L);
+
+    // records the stack and the way lua_getinfo describes it at the same point
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            int level = luaL_optinteger(L, 1, 0);
+            int size = luaL_optinteger(L, 2, 8);
+
+            traceFrameCount = lua_capturetrace(L, level, traceFrames, size);
+
+            lua_Debug ar;
+            for (int i = 0; i < size && lua_getinfo(L, level + i, "sln", &ar); ++i)
+                traceExpected.push_back(std::string(ar.short_src) + ":" + std::to_string(ar.currentline) + ":" + (ar.name ? ar.name : "?"));
+
+            return 0;
+        },
+        "capture");
+    lua_setglobal(L, "capture");
+
+    const char* source = R"(
+local function inner(...)
+    capture(...)
+end
+
+local function outer(...)
+    inner(...)
+    return 1
+end
+
+function skip()
+    outer(1, 2)
+end
+
+function past()
+    capture(1000)
+end
+
+return outer()
+)";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=DebugCaptureTrace", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    if (codegen && luau_codegen_supported())
+        luau_codegen_compile(L, -1);
+
+    traceFrameCount = 0;
+    traceExpected.clear();
+
+    // keep the chunk alive while the frames are symbolized
+    lua_pushvalue(L, -1);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    REQUIRE(traceFrameCount == 4);
+    REQUIRE(traceExpected.size() == 4);
+
+    for (int i = 0; i < traceFrameCount; ++i)
+    {
+        lua_Debug ar;
+        lua_gettraceframe(L, &traceFrames[i], "sln", &ar);
+        CHECK(std::string(ar.short_src) + ":" + std::to_string(ar.currentline) + ":" + (ar.name ? ar.name : "?") == traceExpected[i]);
+    }
+
+    CHECK(traceExpected[0] == "[C]:-1:capture");
+    CHECK(traceExpected[1] == "DebugCaptureTrace:3:inner");
+    CHECK(traceExpected[2] == "DebugCaptureTrace:7:outer");
+
+    // captures can skip levels and are truncated to the array size
+    traceFrameCount = 0;
+    traceExpected.clear();
+
+    lua_getglobal(L, "skip");
+    REQUIRE(lua_pcall(L, 0, 0, 0) == LUA_OK);
+
+    REQUIRE(traceFrameCount == 2);
+    REQUIRE(traceExpected.size() == 2);
+
+    for (int i = 0; i < traceFrameCount; ++i)
+    {
+        lua_Debug ar;
+        lua_gettraceframe(L, &traceFrames[i], "sln", &ar);
+        CHECK(std::string(ar.short_src) + ":" + std::to_string(ar.currentline) + ":" + (ar.name ? ar.name : "?") == traceExpected[i]);
+    }
+
+    CHECK(traceExpected[0] == "DebugCaptureTrace:3:inner");
+
+    // levels past the bottom of the call stack have no frames
+    traceFrameCount = -1;
+    traceExpected.clear();
+
+    lua_getglobal(L, "past");
+    REQUIRE(lua_pcall(L, 0, 0, 0) == LUA_OK);
+
+    CHECK(traceFrameCount == 0);
+    CHECK(traceExpected.empty());
+}
+
 TEST_CASE("Iter")
 {
     runConformance("iter.lua");
@@ -2367,6 +5290,8 @@ TEST_CASE("Native")
         FFlag::DebugLuauAbortingChecks.value = false;
     }
 
+    ScopedFastFlag luauCompileTableRemove{FFlag::LuauCompileTableRemove, true};
+
     runConformance("native.lua", [](lua_State* L) {
         setupNativeHelpers(L);
     });
@@ -2657,6 +5582,253 @@ TEST_CASE("IrInstructionLimit")
     CHECK(nativeStats.functionsCompiled < 101);
 }
 
+static void codegenParallelThreads(void* context, int count, void (*job)(void* jobContext, int index), void* jobContext)
+{
+    const int threadCount = 4;
+
+    auto worker = [&](int thread) {
+        for (int i = thread; i < count; i += threadCount)
+            job(jobContext, i);
+    };
+
+    std::vector<std::thread> threads;
+
+    for (int i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker, i);
+
+    worker(0);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+TEST_CASE("IrParallelCompilation")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    std::string source;
+
+    for (int fn = 0; fn < 50; fn++)
+    {
+        source += "local function fn" + std::to_string(fn) + "(a, b)\n";
+        source += "local t = {}\n";
+        source += "for i = 1, " + std::to_string(fn + 1) + " do t[i] = a * i + b end\n";
+        source += "return #t + t[1]\n";
+        source += "end\n";
+    }
+
+    source += "local sum = 0\n";
+
+    for (int fn = 0; fn < 50; fn++)
+        source += "sum += fn" + std::to_string(fn) + "(2, 1)\n";
+
+    source += "return sum\n";
+
+    auto compileAndRun = [&](bool parallel, Luau::CodeGen::CompilationStats& nativeStats) {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        luau_codegen_create(L);
+
+        size_t bytecodeSize = 0;
+        char* bytecode = luau_compile(source.data(), source.size(), nullptr, &bytecodeSize);
+        int result = luau_load(L, "=ParallelCompilation", bytecode, bytecodeSize, 0);
+        free(bytecode);
+
+        REQUIRE(result == 0);
+
+        Luau::CodeGen::CompilationOptions nativeOptions{Luau::CodeGen::CodeGen_ColdFunctions};
+
+        if (parallel)
+            nativeOptions.parallel = codegenParallelThreads;
+
+        Luau::CodeGen::CompilationResult nativeResult = Luau::CodeGen::compile(L, -1, nativeOptions, &nativeStats);
+        CHECK(nativeResult.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+        return lua_tonumber(L, -1);
+    };
+
+    Luau::CodeGen::CompilationStats serialStats = {};
+    Luau::CodeGen::CompilationStats parallelStats = {};
+
+    double serialResult = compileAndRun(false, serialStats);
+    double parallelResult = compileAndRun(true, parallelStats);
+
+    CHECK(serialResult == parallelResult);
+    CHECK(parallelStats.functionsCompiled == 51);
+    CHECK(parallelStats.functionsCompiled == serialStats.functionsCompiled);
+    CHECK(parallelStats.nativeCodeSizeBytes == serialStats.nativeCodeSizeBytes);
+}
+
+TEST_CASE("IrFunctionLayoutProfile")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local function cold(a) return a + 1 end
+local function hot(a) local s = 0 for i = 1, a do s += i end return s end
+local function warm(a) return a * 2 end
+return cold(1) + hot(10) + warm(3)
+)";
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luau_codegen_create(L);
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=FunctionLayout", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    Luau::CodeGen::CompilationOptions nativeOptions{Luau::CodeGen::CodeGen_ColdFunctions};
+    nativeOptions.functionWeight = [](void* context, const char* debugname, int line) -> uint32_t {
+        if (strcmp(debugname, "hot") == 0)
+            return 10;
+
+        if (strcmp(debugname, "warm") == 0)
+            return 1;
+
+        return 0;
+    };
+
+    // perf log reports the code range of each function, which gives the layout
+    std::vector<std::pair<uintptr_t, std::string>> functions;
+
+    Luau::CodeGen::setPerfLog(&functions, [](void* context, uintptr_t addr, unsigned size, const char* symbol) {
+        static_cast<std::vector<std::pair<uintptr_t, std::string>>*>(context)->push_back({addr, symbol});
+    });
+
+    Luau::CodeGen::CompilationStats nativeStats = {};
+    Luau::CodeGen::CompilationResult nativeResult = Luau::CodeGen::compile(L, -1, nativeOptions, &nativeStats);
+    Luau::CodeGen::setPerfLog(nullptr, nullptr);
+
+    CHECK(nativeResult.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+    // functions are placed by decreasing weight, and functions with equal weight keep bytecode order
+    std::sort(functions.begin(), functions.end());
+
+    std::vector<std::string> layout;
+    for (const auto& [addr, name] : functions)
+        layout.push_back(name);
+
+    CHECK_EQ(
+        layout,
+        std::vector<std::string>{
+            "<luau helpers>",
+            "<luau> FunctionLayout:3 hot",
+            "<luau> FunctionLayout:4 warm",
+            "<luau> FunctionLayout:2 cold",
+            "<luau> FunctionLayout:1 ",
+        }
+    );
+
+    CHECK(nativeStats.functionsCompiled == 4);
+    CHECK(nativeStats.functionsBound == 4);
+    CHECK(nativeStats.nativeHotCodeSizeBytes != 0);
+    CHECK(nativeStats.nativeHotCodeSizeBytes < nativeStats.nativeCodeSizeBytes);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 63);
+}
+
+TEST_CASE("CodeGenPerfLogLines")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local function add(a, b)
+  local c = a + b
+  local d = c * 2
+  return d
+end
+return add(1, 2)
+)";
+
+    struct PerfEvent
+    {
+        uintptr_t addr;
+        unsigned size;
+        std::string name;
+        int line; // 0 for function events
+    };
+
+    std::vector<PerfEvent> events;
+
+    Luau::CodeGen::setPerfLog(
+        &events,
+        [](void* context, uintptr_t addr, unsigned size, const char* symbol) {
+            static_cast<std::vector<PerfEvent>*>(context)->push_back({addr, size, symbol, 0});
+        },
+        [](void* context, uintptr_t addr, unsigned size, const char* source, int line) {
+            static_cast<std::vector<PerfEvent>*>(context)->push_back({addr, size, source, line});
+        }
+    );
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luau_codegen_create(L);
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=PerfLines", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    Luau::CodeGen::CompilationResult nativeResult = Luau::CodeGen::compile(L, -1, Luau::CodeGen::CodeGen_ColdFunctions);
+    Luau::CodeGen::setPerfLog(nullptr, nullptr);
+
+    CHECK(nativeResult.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+    auto fn = std::find_if(events.begin(), events.end(), [](const PerfEvent& e) {
+        return e.line == 0 && e.name == "<luau> PerfLines:2 add";
+    });
+    REQUIRE(fn != events.end());
+
+    // line ranges of a function are reported right before the function and cover disjoint parts of its code
+    auto firstLine = fn;
+    while (firstLine != events.begin() && (firstLine - 1)->line != 0)
+        --firstLine;
+
+    std::vector<int> lines;
+    uintptr_t lastEnd = 0;
+
+    for (auto it = firstLine; it != fn; ++it)
+    {
+        CHECK(it->name == "PerfLines");
+        CHECK(it->size > 0);
+        CHECK(it->addr >= fn->addr);
+        CHECK(it->addr + it->size <= fn->addr + fn->size);
+
+        if (!lines.empty())
+            CHECK(it->addr >= lastEnd);
+
+        lines.push_back(it->line);
+        lastEnd = it->addr + it->size;
+    }
+
+    CHECK(std::find(lines.begin(), lines.end(), 3) != lines.end());
+    CHECK(std::find(lines.begin(), lines.end(), 4) != lines.end());
+    CHECK(std::find(lines.begin(), lines.end(), 5) != lines.end());
+
+    for (int line : lines)
+    {
+        CHECK(line >= 2);
+        CHECK(line <= 5);
+    }
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 6);
+}
+
 TEST_CASE("BytecodeDistributionPerFunctionTest")
 {
     const char* source = R"(
@@ -2706,6 +5878,94 @@ end
             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 }
 
+TEST_CASE("CodeGenBenefitEstimate")
+{
+    const char* source = R"(
+local function loop(t)
+  local s = 0
+  for i = 1, #t do s += t[i] end
+  return s
+end
+
+local function math(a, b)
+  return a * b + a / b - 1
+end
+
+local function make(a, b)
+  return {a, b}, function() return a .. b end, tostring(a), print(b)
+end
+)";
+
+    std::vector<Luau::CodeGen::FunctionBytecodeSummary> summaries(analyzeFile(source, 0));
+    REQUIRE(summaries.size() == 5);
+
+    CHECK_EQ(summaries[0].getName(), "loop");
+    Luau::CodeGen::FunctionCodeGenEstimate loop = Luau::CodeGen::estimateCodeGenBenefit(summaries[0]);
+    CHECK(loop.hasLoops);
+    CHECK(loop.profitable);
+    CHECK(loop.nativeCodeSizeBytes != 0);
+
+    CHECK_EQ(summaries[1].getName(), "math");
+    Luau::CodeGen::FunctionCodeGenEstimate math = Luau::CodeGen::estimateCodeGenBenefit(summaries[1]);
+    CHECK(!math.hasLoops);
+    CHECK(math.profitable);
+    CHECK(math.fastInstructionCount == 4);
+    CHECK(math.helperInstructionCount == 1);
+
+    CHECK_EQ(summaries[3].getName(), "make");
+    Luau::CodeGen::FunctionCodeGenEstimate make = Luau::CodeGen::estimateCodeGenBenefit(summaries[3]);
+    CHECK(!make.hasLoops);
+    CHECK(!make.profitable);
+    CHECK(make.fastInstructionCount < make.helperInstructionCount);
+}
+
+TEST_CASE("CodeGenSkipLowBenefit")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local function math(a, b) return a * b + a / b - 1 end
+local function make(a, b) return {a, b}, tostring(a), print(b) end
+return math(2, 4)
+)";
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luau_codegen_create(L);
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=SkipLowBenefit", bytecode, bytecodeSize, 0);
+    free(bytecode);
+
+    REQUIRE(result == 0);
+
+    Luau::CodeGen::CompilationStats nativeStats = {};
+    Luau::CodeGen::CompilationResult nativeResult =
+        Luau::CodeGen::compile(L, -1, Luau::CodeGen::CodeGen_ColdFunctions | Luau::CodeGen::CodeGen_SkipLowBenefit, &nativeStats);
+    CHECK(nativeResult.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+    REQUIRE(!nativeResult.protoFailures.empty());
+
+    bool makeSkipped = false;
+
+    for (const Luau::CodeGen::ProtoCompilationFailure& failure : nativeResult.protoFailures)
+    {
+        CHECK(failure.result == Luau::CodeGen::CodeGenCompilationResult::CodeGenLowBenefit);
+
+        if (failure.debugname == "make")
+            makeSkipped = true;
+    }
+
+    CHECK(makeSkipped);
+    CHECK(nativeStats.functionsCompiled + nativeResult.protoFailures.size() == nativeStats.functionsTotal);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 7.5);
+}
+
 TEST_CASE("NativeAttribute")
 {
     if (!codegen || !luau_codegen_supported())
@@ -29,6 +29,19 @@ TEST_CASE_FIXTURE(ConstraintGeneratorFixture, "constraint_basics")
     CHECK("number" == toString(bType));
 }
 
+TEST_CASE_FIXTURE(ConstraintGeneratorFixture, "solver_stats_are_logged")
+{
+    solve(R"(
+        local a = 55
+        local b = a
+    )");
+
+    std::string output = logger.compileOutput();
+
+    CHECK(output.find("\"dispatchAttempts\":") != std::string::npos);
+    CHECK(output.find("\"dispatched\":") != std::string::npos);
+}
+
 TEST_CASE_FIXTURE(ConstraintGeneratorFixture, "generic_function")
 {
     solve(R"(
@@ -76,4 +76,95 @@ TEST_CASE("merging_another_map_and_resolve_conflicts_that_also_just_so_happens_t
     }
 }
 
+TEST_CASE("group_map_matches_dense_map")
+{
+    Luau::DenseHashMap<int, int> m1{-1};
+    Luau::DenseHashGroupMap<int, int> m2{-1};
+
+    // enough keys to go through several rehashes and probe across groups
+    for (int i = 0; i < 5000; ++i)
+    {
+        m1[i * 7] = i;
+        m2[i * 7] = i;
+    }
+
+    REQUIRE(m1.size() == m2.size());
+
+    for (int i = 0; i < 5000 * 7; ++i)
+    {
+        int* a = m1.find(i);
+        int* b = m2.find(i);
+
+        REQUIRE(bool(a) == bool(b));
+
+        if (a)
+            CHECK(*a == *b);
+    }
+
+    size_t count = 0;
+
+    for (auto [k, v] : m2)
+    {
+        CHECK(k == v * 7);
+        count++;
+    }
+
+    CHECK(count == m2.size());
+    CHECK(!m2.contains(-1));
+}
+
+TEST_CASE("group_set_with_colliding_hashes")
+{
+    struct BadHash
+    {
+        size_t operator()(int key) const
+        {
+            return key & 3;
+        }
+    };
+
+    Luau::DenseHashGroupSet<int, BadHash> s{-1};
+
+    for (int i = 0; i < 200; ++i)
+        s.insert(i);
+
+    REQUIRE(s.size() == 200);
+
+    for (int i = 0; i < 200; ++i)
+        CHECK(s.contains(i));
+
+    CHECK(!s.contains(200));
+
+    Luau::DenseHashGroupSet<int, BadHash> copy = s;
+    CHECK(copy == s);
+
+    s.clear();
+    CHECK(s.empty());
+    CHECK(!s.contains(0));
+
+    s.insert(5);
+    CHECK(s.size() == 1);
+    CHECK(copy.size() == 200);
+}
+
+TEST_CASE("group_map_overwriting_an_existing_field_when_full_shouldnt_rehash")
+{
+    // 14 is the number of items that fills the first 16 slots
+    Luau::DenseHashGroupMap<int, int> m{-1};
+    for (int i = 0; i < 14; ++i)
+        m[i] = i;
+
+    REQUIRE(m.size() == 14);
+
+    for (auto [k, a] : m)
+        m[k] = a + 1;
+
+    for (size_t i = 0; i < m.size(); ++i)
+    {
+        int* a = m.find(int(i));
+        REQUIRE(a);
+        CHECK(i + 1 == *a);
+    }
+}
+
 TEST_SUITE_END();
@@ -9,6 +9,8 @@
 #include "doctest.h"
 
 #include <algorithm>
+#include <mutex>
+#include <thread>
 
 using namespace Luau;
 
@@ -170,6 +172,277 @@ TEST_CASE_FIXTURE(FrontendFixture, "automatically_check_dependent_scripts")
         CHECK_EQ("{| b_value: number |}", toString(*bExports));
 }
 
+TEST_CASE_FIXTURE(FrontendFixture, "check_queued_modules_parses_in_parallel")
+{
+    fileResolver.source["game/Gui/Modules/A"] = "return {hello=5, world=true}";
+    fileResolver.source["game/Gui/Modules/B"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local A = require(Modules.A)
+        return {b_value = A.hello}
+    )";
+    fileResolver.source["game/Gui/Modules/C"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local A = require(Modules.A)
+        local B = require(Modules.B)
+        return {c_value = A.hello + B.b_value}
+    )";
+    fileResolver.source["game/Gui/Modules/D"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local C = require(Modules.C)
+        return {d_value = C.c_value}
+    )";
+
+    frontend.queueModuleCheck("game/Gui/Modules/D");
+    frontend.queueModuleCheck("game/Gui/Modules/B");
+
+    std::mutex mtx;
+    std::vector<std::thread> threads;
+
+    std::vector<ModuleName> checked = frontend.checkQueuedModules(std::nullopt, [&](std::function<void()> task) {
+        std::unique_lock guard(mtx);
+        threads.emplace_back(std::move(task));
+    });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CHECK_EQ(checked.size(), 4);
+
+    // every module is parsed once, even though sources are parsed in parallel before the graph is built
+    CHECK_EQ(frontend.stats.files, 4);
+
+    for (const char* name : {"game/Gui/Modules/A", "game/Gui/Modules/B", "game/Gui/Modules/C", "game/Gui/Modules/D"})
+    {
+        std::optional<CheckResult> result = frontend.getCheckResult(name, true);
+        REQUIRE(result);
+        LUAU_REQUIRE_NO_ERRORS(*result);
+    }
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "check_queued_modules_starts_long_chains_first")
+{
+    fileResolver.source["game/Gui/Modules/Leaf"] = "return {}";
+    fileResolver.source["game/Gui/Modules/Base"] = "return {}";
+    fileResolver.source["game/Gui/Modules/Mid"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local Base = require(Modules.Base)
+        return {}
+    )";
+    fileResolver.source["game/Gui/Modules/Top"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local Mid = require(Modules.Mid)
+        return {}
+    )";
+
+    std::vector<ModuleName> order;
+    frontend.prepareModuleScope = [&order](const ModuleName& name, const ScopePtr& scope, bool forAutocomplete) {
+        order.push_back(name);
+    };
+
+    frontend.queueModuleCheck("game/Gui/Modules/Leaf");
+    frontend.queueModuleCheck("game/Gui/Modules/Top");
+    frontend.checkQueuedModules();
+
+    // both Leaf and Base are ready at the start, but Base is at the bottom of a longer chain
+    std::vector<ModuleName> expected{"game/Gui/Modules/Base", "game/Gui/Modules/Leaf", "game/Gui/Modules/Mid", "game/Gui/Modules/Top"};
+    CHECK(order == expected);
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "check_queued_modules_skips_items_after_cancellation")
+{
+    fileResolver.source["game/Gui/Modules/A"] = "return {}";
+    fileResolver.source["game/Gui/Modules/B"] = "return {}";
+    fileResolver.source["game/Gui/Modules/C"] = "return {}";
+
+    FrontendOptions opts;
+    opts.cancellationToken = std::make_shared<FrontendCancellationToken>();
+
+    std::vector<ModuleName> order;
+    frontend.prepareModuleScope = [&order, &opts](const ModuleName& name, const ScopePtr& scope, bool forAutocomplete) {
+        order.push_back(name);
+        opts.cancellationToken->cancel();
+    };
+
+    frontend.queueModuleCheck("game/Gui/Modules/A");
+    frontend.queueModuleCheck("game/Gui/Modules/B");
+    frontend.queueModuleCheck("game/Gui/Modules/C");
+
+    // all three items are sent together, but only the first one starts before the cancellation
+    std::vector<ModuleName> checked = frontend.checkQueuedModules(opts);
+
+    CHECK(checked.empty());
+    CHECK(order.size() == 1);
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "shard_modules")
+{
+    fileResolver.source["game/Gui/Modules/A"] = "return {hello=5, world=true}";
+    fileResolver.source["game/Gui/Modules/B"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local A = require(Modules.A)
+        return {b_value = A.hello}
+    )";
+    fileResolver.source["game/Gui/Modules/C"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local B = require(Modules.B)
+        return {c_value = B.b_value}
+    )";
+    fileResolver.source["game/Gui/Modules/D"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local C = require(Modules.C)
+        return {d_value = C.c_value}
+    )";
+
+    std::vector<std::vector<ModuleName>> shards =
+        frontend.shardModules({"game/Gui/Modules/D", "game/Gui/Modules/A", "game/Gui/Modules/C", "game/Gui/Modules/B"}, 2);
+
+    // dependencies are placed first, and the split is balanced by module size
+    REQUIRE(shards.size() == 2);
+    CHECK(shards[0] == std::vector<ModuleName>{"game/Gui/Modules/A", "game/Gui/Modules/B"});
+    CHECK(shards[1] == std::vector<ModuleName>{"game/Gui/Modules/C", "game/Gui/Modules/D"});
+
+    // order of the input doesn't matter
+    std::vector<std::vector<ModuleName>> reordered =
+        frontend.shardModules({"game/Gui/Modules/A", "game/Gui/Modules/B", "game/Gui/Modules/C", "game/Gui/Modules/D"}, 2);
+    CHECK(shards == reordered);
+
+    // required modules that were not requested are not assigned
+    std::vector<std::vector<ModuleName>> single = frontend.shardModules({"game/Gui/Modules/D"}, 3);
+    REQUIRE(single.size() == 3);
+    CHECK(single[0].size() + single[1].size() + single[2].size() == 1);
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "check_queued_modules_dependencies_interface_only")
+{
+    fileResolver.source["game/Gui/Modules/A"] = R"(
+        --!strict
+        local x: number = "a"
+        return {hello=5}
+    )";
+    fileResolver.source["game/Gui/Modules/B"] = R"(
+        --!strict
+        local Modules = game:GetService('Gui').Modules
+        local A = require(Modules.A)
+        return {b_value = A.hello}
+    )";
+
+    FrontendOptions opts;
+    opts.dependenciesInterfaceOnly = true;
+
+    frontend.queueModuleCheck("game/Gui/Modules/B");
+    std::vector<ModuleName> checked = frontend.checkQueuedModules(opts);
+    CHECK(checked.size() == 2);
+
+    ModulePtr a = frontend.moduleResolver.getModule("game/Gui/Modules/A");
+    ModulePtr b = frontend.moduleResolver.getModule("game/Gui/Modules/B");
+    REQUIRE(a);
+    REQUIRE(b);
+    CHECK(a->interfaceOnly);
+    CHECK(!b->interfaceOnly);
+
+    // queueing the dependency itself checks it fully, and its dependents have to be checked again
+    frontend.queueModuleCheck("game/Gui/Modules/A");
+    checked = frontend.checkQueuedModules(opts);
+    CHECK(checked.size() == 1);
+    CHECK(frontend.isDirty("game/Gui/Modules/B"));
+
+    a = frontend.moduleResolver.getModule("game/Gui/Modules/A");
+    REQUIRE(a);
+    CHECK(!a->interfaceOnly);
+
+    std::optional<CheckResult> result = frontend.getCheckResult("game/Gui/Modules/A", false);
+    REQUIRE(result);
+    LUAU_REQUIRE_ERROR_COUNT(1, *result);
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "interface_only_check")
+{
+    fileResolver.source["game/A"] = R"(
+        --!strict
+        local x: number = "a"
+        return 5
+    )";
+
+    FrontendOptions opts;
+    opts.retainFullTypeGraphs = true;
+    opts.interfaceOnly = true;
+
+    frontend.check("game/A", opts);
+
+    ModulePtr a = frontend.moduleResolver.getModule("game/A");
+    REQUIRE(a);
+    CHECK(a->interfaceOnly);
+    CHECK(a->astTypes.empty());
+    CHECK_EQ("number", toString(a->returnType));
+
+    // a regular check doesn't reuse the incomplete result
+    opts.interfaceOnly = false;
+    CheckResult result = frontend.check("game/A", opts);
+    LUAU_REQUIRE_ERROR_COUNT(1, result);
+
+    a = frontend.moduleResolver.getModule("game/A");
+    REQUIRE(a);
+    CHECK(!a->interfaceOnly);
+    CHECK(!a->astTypes.empty());
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "retain_full_type_graphs_limit")
+{
+    fileResolver.source["game/A"] = "local a = 1 return {a = a}";
+    fileResolver.source["game/B"] = "local b = 'b' return {b = b}";
+
+    FrontendOptions opts;
+    opts.retainFullTypeGraphs = true;
+    opts.retainFullTypeGraphsLimit = 1;
+
+    frontend.check("game/A", opts);
+
+    ModulePtr a = frontend.moduleResolver.getModule("game/A");
+    REQUIRE(a);
+    CHECK(!a->astTypes.empty());
+
+    frontend.check("game/B", opts);
+
+    ModulePtr b = frontend.moduleResolver.getModule("game/B");
+    REQUIRE(b);
+    CHECK(!b->astTypes.empty());
+
+    // the least recently checked module only keeps its interface
+    CHECK(a->astTypes.empty());
+    CHECK(a->internalTypes.types.empty());
+    CHECK(first(a->returnType));
+
+    // checking a module again makes it the most recently checked one
+    frontend.markDirty("game/A");
+    frontend.check("game/A", opts);
+
+    a = frontend.moduleResolver.getModule("game/A");
+    REQUIRE(a);
+    CHECK(!a->astTypes.empty());
+    CHECK(b->astTypes.empty());
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "frontends_can_share_global_types")
+{
+    fileResolver.source["game/A"] = R"(
+        local x = math.abs(-1)
+        local y = string.rep("a", x)
+        return {value = y, place = game}
+    )";
+
+    Frontend second(frontend, &fileResolver, &configResolver);
+
+    CHECK(second.builtinTypes == frontend.builtinTypes);
+    CHECK(second.globals.globalScope == frontend.globals.globalScope);
+
+    CheckResult result = second.check("game/A");
+    LUAU_REQUIRE_NO_ERRORS(result);
+
+    // modules are owned by the frontend that checked them
+    CHECK(second.moduleResolver.getModule("game/A"));
+    CHECK(!frontend.moduleResolver.getModule("game/A"));
+}
+
 TEST_CASE_FIXTURE(FrontendFixture, "automatically_check_cyclically_dependent_scripts")
 {
     fileResolver.source["game/Gui/Modules/A"] = R"(
@@ -538,6 +811,26 @@ TEST_CASE_FIXTURE(FrontendFixture, "dont_reparse_clean_file_when_linting")
     CHECK_EQ(1, lintResult.warnings.size());
 }
 
+TEST_CASE_FIXTURE(FrontendFixture, "lint_pass_times")
+{
+    fileResolver.source["Modules/A"] = R"(
+        for i=#t,1 do
+        end
+    )";
+
+    configResolver.defaultConfig.enabledLint.enableWarning(LintWarning::Code_ForRange);
+
+    LintResult lintResult = lintModule("Modules/A");
+    CHECK_EQ(1, lintResult.warnings.size());
+
+    double total = 0;
+    for (double time : frontend.stats.timeLintPasses)
+        total += time;
+
+    CHECK(frontend.stats.timeLintPasses[LintWarning::Code_ForRange] > 0);
+    CHECK(total <= frontend.stats.timeLint);
+}
+
 TEST_CASE_FIXTURE(FrontendFixture, "dont_recheck_script_that_hasnt_been_marked_dirty")
 {
     fileResolver.source["game/Gui/Modules/A"] = "return {hello=5, world=true}";
@@ -2514,6 +2514,83 @@ bb_fallback_1:
 )");
 }
 
+TEST_CASE_FIXTURE(IrBuilderFixture, "BufferLengthChecksWithOffsetDelta")
+{
+    IrOp block = build.block(IrBlockKind::Internal);
+    IrOp fallback = build.block(IrBlockKind::Fallback);
+
+    build.beginBlock(block);
+
+    IrOp buffer = build.inst(IrCmd::LOAD_POINTER, build.vmReg(0));
+
+    // Integer offset with a constant added, first check is extended
+    IrOp index = build.inst(IrCmd::LOAD_INT, build.vmReg(1));
+    build.inst(IrCmd::CHECK_BUFFER_LEN, buffer, index, build.constInt(4), fallback);
+    build.inst(IrCmd::BUFFER_WRITEI32, buffer, index, build.constInt(1));
+    IrOp index4 = build.inst(IrCmd::ADD_INT, index, build.constInt(4));
+    build.inst(IrCmd::CHECK_BUFFER_LEN, buffer, index4, build.constInt(4), fallback);
+    build.inst(IrCmd::BUFFER_WRITEI32, buffer, index4, build.constInt(2));
+
+    // Access inside the range that is already checked
+    build.inst(IrCmd::CHECK_BUFFER_LEN, buffer, index, build.constInt(2), fallback);
+    build.inst(IrCmd::BUFFER_WRITEI16, buffer, index, build.constInt(3));
+
+    // Number offset with a constant added before the conversion
+    IrOp num = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(2));
+    IrOp numIndex = build.inst(IrCmd::NUM_TO_INT, num);
+    build.inst(IrCmd::CHECK_BUFFER_LEN, buffer, numIndex, build.constInt(2), fallback);
+    build.inst(IrCmd::BUFFER_WRITEI16, buffer, numIndex, build.constInt(4));
+    IrOp numIndex8 = build.inst(IrCmd::NUM_TO_INT, build.inst(IrCmd::ADD_NUM, num, build.constDouble(8.0)));
+    build.inst(IrCmd::CHECK_BUFFER_LEN, buffer, numIndex8, build.constInt(4), fallback);
+    build.inst(IrCmd::BUFFER_WRITEI32, buffer, numIndex8, build.constInt(5));
+
+    // Negative and fractional deltas are not merged
+    IrOp indexm4 = build.inst(IrCmd::ADD_INT, index, build.constInt(-4));
+    build.inst(IrCmd::CHECK_BUFFER_LEN, buffer, indexm4, build.constInt(4), fallback);
+    build.inst(IrCmd::BUFFER_WRITEI32, buffer, indexm4, build.constInt(6));
+    IrOp numIndexHalf = build.inst(IrCmd::NUM_TO_INT, build.inst(IrCmd::ADD_NUM, num, build.constDouble(0.5)));
+    build.inst(IrCmd::CHECK_BUFFER_LEN, buffer, numIndexHalf, build.constInt(4), fallback);
+    build.inst(IrCmd::BUFFER_WRITEI32, buffer, numIndexHalf, build.constInt(7));
+
+    build.inst(IrCmd::RETURN, build.vmReg(1), build.constUint(1));
+
+    build.beginBlock(fallback);
+    build.inst(IrCmd::RETURN, build.vmReg(0), build.constUint(1));
+
+    updateUseCounts(build.function);
+    constPropInBlockChains(build, true);
+
+    CHECK("\n" + toString(build.function, IncludeUseInfo::No) == R"(
+bb_0:
+   %0 = LOAD_POINTER R0
+   %1 = LOAD_INT R1
+   CHECK_BUFFER_LEN %0, %1, 8i, bb_fallback_1
+   BUFFER_WRITEI32 %0, %1, 1i
+   %4 = ADD_INT %1, 4i
+   BUFFER_WRITEI32 %0, %4, 2i
+   BUFFER_WRITEI16 %0, %1, 3i
+   %9 = LOAD_DOUBLE R2
+   %10 = NUM_TO_INT %9
+   CHECK_BUFFER_LEN %0, %10, 12i, bb_fallback_1
+   BUFFER_WRITEI16 %0, %10, 4i
+   %13 = ADD_NUM %9, 8
+   %14 = NUM_TO_INT %13
+   BUFFER_WRITEI32 %0, %14, 5i
+   %17 = ADD_INT %1, -4i
+   CHECK_BUFFER_LEN %0, %17, 4i, bb_fallback_1
+   BUFFER_WRITEI32 %0, %17, 6i
+   %20 = ADD_NUM %9, 0.5
+   %21 = NUM_TO_INT %20
+   CHECK_BUFFER_LEN %0, %21, 4i, bb_fallback_1
+   BUFFER_WRITEI32 %0, %21, 7i
+   RETURN R1, 1u
+
+bb_fallback_1:
+   RETURN R0, 1u
+
+)");
+}
+
 TEST_CASE_FIXTURE(IrBuilderFixture, "TagVectorSkipErrorFix")
 {
     IrOp block = build.block(IrBlockKind::Internal);
@@ -21,6 +21,8 @@ LUAU_FASTFLAG(LuauCodegenUserdataOps)
 LUAU_FASTFLAG(LuauCodegenUserdataAlloc)
 LUAU_FASTFLAG(LuauCompileFastcall3)
 LUAU_FASTFLAG(LuauCodegenFastcall3)
+LUAU_FASTFLAG(LuauCompileVectorLibrary)
+LUAU_FASTFLAG(LuauCompileTableRemove)
 
 static std::string getCodegenAssembly(const char* source, bool includeIrTypes = false, int debugLevel = 1)
 {
@@ -125,6 +127,62 @@ static std::string getCodegenHeader(const char* source)
     return assembly.substr(0, bytecodeStart);
 }
 
+static Luau::CodeGen::LoweringStats getA64LoweringStats(const std::string& source)
+{
+    Luau::CodeGen::AssemblyOptions options;
+
+    options.target = Luau::CodeGen::AssemblyOptions::Target::A64;
+    options.outputBinary = false;
+    options.includeAssembly = true;
+
+    Luau::CompileOptions copts = {};
+
+    copts.optimizationLevel = 2;
+    copts.debugLevel = 1;
+    copts.typeInfoLevel = 1;
+
+    Luau::BytecodeBuilder bcb;
+    Luau::compileOrThrow(bcb, source, copts);
+
+    std::string bytecode = bcb.getBytecode();
+    std::unique_ptr<lua_State, void (*)(lua_State*)> globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::LoweringStats stats;
+
+    if (luau_load(L, "name", bytecode.data(), bytecode.size(), 0) == 0)
+        Luau::CodeGen::getAssembly(L, -1, options, &stats);
+    else
+        FAIL("Failed to load bytecode");
+
+    return stats;
+}
+
+// Builds a function that keeps 'count' numbers live at once to force register spills
+static std::string getHighPressureSource(int count, bool conditional)
+{
+    std::string source = "local function test(x: number, y: number)\n";
+
+    if (conditional)
+        source += "if x > y then\n";
+
+    for (int i = 0; i < count; i++)
+        source += "local v" + std::to_string(i) + " = x * " + std::to_string(i + 2) + " + y\n";
+
+    source += "local r = 0\n";
+
+    for (int i = count - 1; i >= 0; i--)
+        source += "r += v" + std::to_string(i) + " * x\n";
+
+    source += "return r\n";
+
+    if (conditional)
+        source += "end\nreturn 0\n";
+
+    source += "end\n";
+    return source;
+}
+
 TEST_SUITE_BEGIN("IrLowering");
 
 TEST_CASE("VectorReciprocal")
@@ -513,6 +571,69 @@ bb_6:
 )");
 }
 
+TEST_CASE("VectorLibraryDot")
+{
+    ScopedFastFlag luauCompileVectorLibrary{FFlag::LuauCompileVectorLibrary, true};
+
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function foo(a: vector, b: vector)
+    return vector.dot(a, b) + vector.magnitude(a)
+end
+)"),
+        R"(
+; function foo($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, tvector, exit(entry)
+  CHECK_TAG R1, tvector, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  CHECK_SAFE_ENV exit(2)
+  %11 = LOAD_TVALUE R0
+  %12 = LOAD_TVALUE R1
+  %13 = DOT_VEC %11, %12
+  %20 = DOT_VEC %11, %11
+  %21 = SQRT_NUM %20
+  %30 = ADD_NUM %13, %21
+  STORE_DOUBLE R2, %30
+  STORE_TAG R2, tnumber
+  INTERRUPT 13u
+  RETURN R2, 1i
+)");
+}
+
+TEST_CASE("VectorLibraryNormalize")
+{
+    ScopedFastFlag luauCompileVectorLibrary{FFlag::LuauCompileVectorLibrary, true};
+
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function foo(a: vector)
+    return vector.normalize(a)
+end
+)"),
+        R"(
+; function foo($arg0) line 2
+bb_0:
+  CHECK_TAG R0, tvector, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  CHECK_SAFE_ENV exit(1)
+  %7 = LOAD_TVALUE R0
+  %8 = DOT_VEC %7, %7
+  %9 = SQRT_NUM %8
+  %10 = DIV_NUM 1, %9
+  %11 = NUM_TO_VEC %10
+  %12 = MUL_VEC %7, %11
+  %13 = TAG_VECTOR %12
+  STORE_TVALUE R1, %13
+  INTERRUPT 5u
+  RETURN R1, 1i
+)");
+}
+
 TEST_CASE("VectorCustomAccess")
 {
     CHECK_EQ("\n" + getCodegenAssembly(R"(
@@ -872,8 +993,6 @@ end
 bb_bytecode_0:
   CHECK_TAG R0, tvector, exit(0)
   %2 = LOAD_FLOAT R0, 0i
-  STORE_DOUBLE R4, %2
-  STORE_TAG R4, tnumber
   %7 = LOAD_FLOAT R0, 4i
   %16 = ADD_NUM %2, %7
   STORE_DOUBLE R3, %16
@@ -925,7 +1044,6 @@ bb_bytecode_0:
   STORE_TAG R2, tvector
   JUMP_IF_FALSY R1, bb_bytecode_1, bb_3
 bb_3:
-  CHECK_TAG R2, tvector, exit(9)
   %19 = LOAD_FLOAT R2, 0i
   %24 = LOAD_FLOAT R2, 4i
   %33 = ADD_NUM %19, %24
@@ -934,7 +1052,6 @@ bb_3:
   INTERRUPT 14u
   RETURN R3, 1i
 bb_bytecode_1:
-  CHECK_TAG R2, tvector, exit(15)
   %40 = LOAD_FLOAT R2, 8i
   STORE_DOUBLE R3, %40
   STORE_TAG R3, tnumber
@@ -1037,18 +1154,13 @@ bb_bytecode_1:
   INTERRUPT 5u
   STORE_DOUBLE R5, 10
   STORE_TAG R5, tnumber
-  CHECK_TAG R4, tnumber, bb_fallback_6
   JUMP_CMP_NUM R4, 10, not_lt, bb_bytecode_2, bb_5
 bb_5:
-  CHECK_TAG R1, tnumber, exit(8)
-  CHECK_TAG R4, tnumber, exit(8)
   %32 = LOAD_DOUBLE R1
   %34 = ADD_NUM %32, R4
   STORE_DOUBLE R1, %34
   JUMP bb_bytecode_3
 bb_bytecode_2:
-  CHECK_TAG R1, tnumber, exit(10)
-  CHECK_TAG R4, tnumber, exit(10)
   %41 = LOAD_DOUBLE R1
   %43 = MUL_NUM %41, R4
   STORE_DOUBLE R1, %43
@@ -1065,6 +1177,291 @@ bb_bytecode_4:
 )");
 }
 
+TEST_CASE("LoopInvariantTags")
+{
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function sum(t: {number}, n: number)
+    local s = 0
+    for i = 1, n do
+        s += math.abs(t[i])
+    end
+    return s
+end
+)"),
+        R"(
+; function sum($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, ttable, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_4
+bb_4:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  STORE_DOUBLE R2, 0
+  STORE_TAG R2, tnumber
+  STORE_DOUBLE R5, 1
+  STORE_TAG R5, tnumber
+  %10 = LOAD_TVALUE R1
+  STORE_TVALUE R3, %10
+  STORE_DOUBLE R4, 1
+  STORE_TAG R4, tnumber
+  %18 = LOAD_DOUBLE R3
+  JUMP_CMP_NUM 1, %18, not_le, bb_bytecode_3, bb_bytecode_2
+bb_bytecode_2:
+  INTERRUPT 5u
+  %26 = LOAD_POINTER R0
+  %27 = LOAD_DOUBLE R5
+  %28 = TRY_NUM_TO_INDEX %27, bb_fallback_5
+  %29 = SUB_INT %28, 1i
+  CHECK_ARRAY_SIZE %26, %29, bb_fallback_5
+  CHECK_NO_METATABLE %26, bb_fallback_5
+  %32 = GET_ARR_ADDR %26, %29
+  %33 = LOAD_TVALUE %32
+  STORE_TVALUE R7, %33
+  JUMP bb_6
+bb_6:
+  CHECK_SAFE_ENV exit(7)
+  CHECK_TAG R7, tnumber, exit(7)
+  %43 = ABS_NUM R7
+  STORE_DOUBLE R6, %43
+  STORE_TAG R6, tnumber
+  %50 = LOAD_DOUBLE R2
+  %52 = ADD_NUM %50, %43
+  STORE_DOUBLE R2, %52
+  %54 = LOAD_DOUBLE R3
+  %55 = LOAD_DOUBLE R5
+  %56 = ADD_NUM %55, 1
+  STORE_DOUBLE R5, %56
+  JUMP_CMP_NUM %56, %54, le, bb_bytecode_2, bb_bytecode_3
+bb_bytecode_3:
+  INTERRUPT 12u
+  RETURN R2, 1i
+)");
+}
+
+TEST_CASE("LoopInvariantTagsSelfLoop")
+{
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function f(n: number)
+    local s = 0
+    for i = 1, n do
+        s += i * 0.5
+    end
+    return s
+end
+)"),
+        R"(
+; function f($arg0) line 2
+bb_0:
+  CHECK_TAG R0, tnumber, exit(entry)
+  JUMP bb_4
+bb_4:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  STORE_DOUBLE R1, 0
+  STORE_TAG R1, tnumber
+  STORE_DOUBLE R4, 1
+  STORE_TAG R4, tnumber
+  %8 = LOAD_TVALUE R0
+  STORE_TVALUE R2, %8
+  STORE_DOUBLE R3, 1
+  STORE_TAG R3, tnumber
+  %16 = LOAD_DOUBLE R2
+  JUMP_CMP_NUM 1, %16, not_le, bb_bytecode_3, bb_bytecode_2
+bb_bytecode_2:
+  INTERRUPT 5u
+  %22 = LOAD_DOUBLE R4
+  %23 = MUL_NUM %22, 0.5
+  STORE_DOUBLE R5, %23
+  STORE_TAG R5, tnumber
+  %30 = LOAD_DOUBLE R1
+  %32 = ADD_NUM %30, %23
+  STORE_DOUBLE R1, %32
+  %34 = LOAD_DOUBLE R2
+  %36 = ADD_NUM %22, 1
+  STORE_DOUBLE R4, %36
+  JUMP_CMP_NUM %36, %34, le, bb_bytecode_2, bb_bytecode_3
+bb_bytecode_3:
+  INTERRUPT 8u
+  RETURN R1, 1i
+)");
+}
+
+TEST_CASE("JoinBlockTags")
+{
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function foo(a, c)
+    local x = 0
+    if c then
+        x = 1
+    end
+    return a + x
+end
+)"),
+        R"(
+; function foo($arg0, $arg1) line 2
+bb_bytecode_0:
+  STORE_DOUBLE R2, 0
+  STORE_TAG R2, tnumber
+  JUMP_IF_FALSY R1, bb_bytecode_1, bb_2
+bb_2:
+  STORE_DOUBLE R2, 1
+  STORE_TAG R2, tnumber
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  CHECK_TAG R0, tnumber, bb_fallback_3
+  %10 = LOAD_DOUBLE R0
+  %12 = ADD_NUM %10, R2
+  STORE_DOUBLE R3, %12
+  STORE_TAG R3, tnumber
+  JUMP bb_4
+bb_4:
+  INTERRUPT 4u
+  RETURN R3, 1i
+)");
+}
+
+TEST_CASE("TableSlotStoreToLoad")
+{
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function foo(a: number, b: number)
+    local p = {x = a * 2, y = b * 2}
+    return p.x + p.y
+end
+)"),
+        R"(
+; function foo($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, tnumber, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  SET_SAVEDPC 1u
+  %7 = LOAD_POINTER K2
+  %8 = DUP_TABLE %7
+  STORE_POINTER R2, %8
+  STORE_TAG R2, ttable
+  CHECK_GC
+  %14 = LOAD_DOUBLE R0
+  %15 = MUL_NUM %14, 2
+  STORE_DOUBLE R3, %15
+  STORE_TAG R3, tnumber
+  %21 = GET_SLOT_NODE_ADDR %8, 2u, K0
+  CHECK_SLOT_MATCH %21, K0, bb_fallback_3
+  CHECK_READONLY %8, bb_fallback_3
+  STORE_SPLIT_TVALUE %21, tnumber, %15, 0i
+  JUMP bb_linear_13
+bb_linear_13:
+  CHECK_TAG R1, tnumber, exit(4)
+  %85 = LOAD_DOUBLE R1
+  %86 = MUL_NUM %85, 2
+  STORE_DOUBLE R3, %86
+  %92 = GET_SLOT_NODE_ADDR %8, 5u, K1
+  CHECK_SLOT_MATCH %92, K1, bb_fallback_5
+  CHECK_READONLY %8, bb_fallback_5
+  STORE_SPLIT_TVALUE %92, tnumber, %86, 0i
+  %102 = LOAD_TVALUE %21, 0i, tnumber
+  STORE_TVALUE R4, %102
+  %110 = LOAD_TVALUE %92, 0i, tnumber
+  STORE_TVALUE R5, %110
+  %117 = LOAD_DOUBLE R4
+  %119 = ADD_NUM %117, R5
+  STORE_DOUBLE R3, %119
+  INTERRUPT 12u
+  RETURN R3, 1i
+bb_4:
+  CHECK_TAG R1, tnumber, exit(4)
+  %32 = LOAD_DOUBLE R1
+  %33 = MUL_NUM %32, 2
+  STORE_DOUBLE R3, %33
+  STORE_TAG R3, tnumber
+  CHECK_TAG R2, ttable, exit(5)
+  %38 = LOAD_POINTER R2
+  %39 = GET_SLOT_NODE_ADDR %38, 5u, K1
+  CHECK_SLOT_MATCH %39, K1, bb_fallback_5
+  CHECK_READONLY %38, bb_fallback_5
+  STORE_SPLIT_TVALUE %39, tnumber, %33, 0i
+  JUMP bb_6
+bb_6:
+  CHECK_TAG R2, ttable, exit(7)
+  %50 = LOAD_POINTER R2
+  %51 = GET_SLOT_NODE_ADDR %50, 7u, K0
+  CHECK_SLOT_MATCH %51, K0, bb_fallback_7
+  %53 = LOAD_TVALUE %51, 0i
+  STORE_TVALUE R4, %53
+  JUMP bb_8
+bb_8:
+  CHECK_TAG R2, ttable, exit(9)
+  %60 = LOAD_POINTER R2
+  %61 = GET_SLOT_NODE_ADDR %60, 9u, K1
+  CHECK_SLOT_MATCH %61, K1, bb_fallback_9
+  %63 = LOAD_TVALUE %61, 0i
+  STORE_TVALUE R5, %63
+  JUMP bb_10
+bb_10:
+  CHECK_TAG R4, tnumber, bb_fallback_11
+  CHECK_TAG R5, tnumber, bb_fallback_11
+  %72 = LOAD_DOUBLE R4
+  %74 = ADD_NUM %72, R5
+  STORE_DOUBLE R3, %74
+  STORE_TAG R3, tnumber
+  JUMP bb_12
+bb_12:
+  INTERRUPT 12u
+  RETURN R3, 1i
+)");
+}
+
+TEST_CASE("TableInsertRemoveArray")
+{
+    ScopedFastFlag luauCompileTableRemove{FFlag::LuauCompileTableRemove, true};
+
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function foo(t: {number}, v: number)
+    table.insert(t, v)
+    return table.remove(t)
+end
+)"),
+        R"(
+; function foo($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, ttable, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  CHECK_SAFE_ENV exit(2)
+  %9 = LOAD_POINTER R0
+  CHECK_READONLY %9, bb_fallback_3
+  %11 = TABLE_LEN %9
+  CHECK_ARRAY_SIZE %9, %11, bb_fallback_3
+  %13 = GET_ARR_ADDR %9, %11
+  %14 = LOAD_TVALUE R1
+  STORE_TVALUE %13, %14
+  JUMP bb_4
+bb_4:
+  CHECK_SAFE_ENV exit(8)
+  CHECK_TAG R0, ttable, exit(8)
+  %38 = LOAD_POINTER R0
+  CHECK_READONLY %38, bb_fallback_8
+  %40 = TABLE_LEN %38
+  %41 = SUB_INT %40, 1i
+  CHECK_ARRAY_SIZE %38, %41, bb_fallback_8
+  %43 = GET_ARR_ADDR %38, %41
+  %44 = LOAD_TVALUE %43
+  STORE_TVALUE R2, %44
+  STORE_TAG %43, tnil
+  ADJUST_STACK_TO_REG R2, 1i
+  JUMP bb_9
+bb_9:
+  INTERRUPT 12u
+  RETURN R2, -1i
+)");
+}
+
 TEST_CASE("ArgumentTypeRefinement")
 {
     ScopedFastFlag sffs[]{{FFlag::LuauCompileFastcall3, true}, {FFlag::LuauCodegenFastcall3, true}};
@@ -1913,4 +2310,22 @@ bb_bytecode_1:
 )");
 }
 
+TEST_CASE("A64SpillsUnderRegisterPressure")
+{
+    Luau::CodeGen::LoweringStats stats = getA64LoweringStats(getHighPressureSource(40, /* conditional */ false));
+
+    CHECK(stats.regAllocErrors == 0);
+    CHECK(stats.loweringErrors == 0);
+    CHECK(stats.spillsToSlot + stats.spillsToRestore > 0);
+}
+
+TEST_CASE("A64SpillsInsideConditionalBlock")
+{
+    Luau::CodeGen::LoweringStats stats = getA64LoweringStats(getHighPressureSource(40, /* conditional */ true));
+
+    CHECK(stats.regAllocErrors == 0);
+    CHECK(stats.loweringErrors == 0);
+    CHECK(stats.spillsToSlot + stats.spillsToRestore > 0);
+}
+
 TEST_SUITE_END();
@@ -242,4 +242,35 @@ TEST_CASE("string_interpolation_with_unicode_escape")
     CHECK_EQ(lexer.next().type, Lexeme::Eof);
 }
 
+TEST_CASE("shared_name_table")
+{
+    Luau::Allocator sharedAlloc;
+    AstNameTable shared(sharedAlloc);
+    AstName print = shared.getOrAdd("print");
+
+    Luau::Allocator alloc;
+    AstNameTable table(alloc, shared);
+
+    // names from the shared table are reused, so they compare equal across tables
+    CHECK(table.get("print") == print);
+
+    const std::string testInput = "print(value)";
+    Lexer lexer(testInput.c_str(), testInput.size(), table);
+
+    Lexeme lexeme = lexer.next();
+    CHECK_EQ(lexeme.type, Lexeme::Name);
+    CHECK(AstName(lexeme.name) == print);
+
+    CHECK_EQ(lexer.next().type, '(');
+
+    // new names are only added to the table that the lexer uses
+    lexeme = lexer.next();
+    CHECK_EQ(lexeme.type, Lexeme::Name);
+    CHECK(table.get("value") == AstName(lexeme.name));
+    CHECK(!shared.get("value").value);
+
+    CHECK(table.get("local") == shared.get("local"));
+    CHECK_EQ(table.getWithType("local", 5).second, Lexeme::ReservedLocal);
+}
+
 TEST_SUITE_END();
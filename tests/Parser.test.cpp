@@ -106,6 +106,54 @@ TEST_CASE("initial_double_is_aligned")
     CHECK_EQ(0, reinterpret_cast<intptr_t>(one) & (alignof(double) - 1));
 }
 
+TEST_CASE("allocations_larger_than_a_page")
+{
+    Luau::Allocator alloc(16);
+
+    char* small = static_cast<char*>(alloc.allocate(16));
+    char* large = static_cast<char*>(alloc.allocate(100000));
+    memset(small, 1, 16);
+    memset(large, 2, 100000);
+
+    char* next = static_cast<char*>(alloc.allocate(16));
+    memset(next, 3, 16);
+
+    CHECK_EQ(small[15], 1);
+    CHECK_EQ(large[0], 2);
+    CHECK_EQ(large[99999], 2);
+}
+
+TEST_CASE("reset_reuses_pages")
+{
+    Luau::Allocator alloc;
+
+    std::vector<int*> first;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        first.push_back(alloc.alloc<int>(i));
+        alloc.allocate(100);
+    }
+
+    for (int i = 0; i < 10000; ++i)
+        REQUIRE_EQ(*first[i], i);
+
+    alloc.reset();
+
+    // the first page is reused for the first allocation after reset
+    int* reused = alloc.alloc<int>(-1);
+    CHECK_EQ(reused, first[0]);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        int* value = alloc.alloc<int>(i);
+        alloc.allocate(100);
+        REQUIRE_EQ(*value, i);
+    }
+
+    CHECK_EQ(*reused, -1);
+}
+
 TEST_SUITE_END();
 
 TEST_SUITE_BEGIN("ParserTests");
@@ -3,15 +3,29 @@
 #include "lualib.h"
 
 #include "Repl.h"
+#include "FileUtils.h"
+
+#include "Luau/Compiler.h"
 
 #include "doctest.h"
 
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 struct Completion
 {
     std::string completion;
@@ -439,3 +453,194 @@ TEST_CASE_FIXTURE(ReplFixture, "InteractiveStackReserve2")
 }
 
 TEST_SUITE_END();
+
+#ifndef _WIN32
+TEST_SUITE_BEGIN("ReplServerTests");
+
+static pid_t spawnRepl(std::vector<std::string> args)
+{
+    pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        // keep script output and errors out of the test log
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, 1);
+        dup2(null, 2);
+
+        std::vector<char*> argv = {const_cast<char*>("luau")};
+        for (std::string& arg : args)
+            argv.push_back(arg.data());
+        argv.push_back(nullptr);
+
+        _exit(replMain(int(argv.size() - 1), argv.data()));
+    }
+
+    return pid;
+}
+
+static int waitRepl(pid_t pid)
+{
+    int status = 0;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFEXITED(status));
+    return WEXITSTATUS(status);
+}
+
+static int connectToServer(const std::string& path)
+{
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path.c_str());
+
+    // the server is started in another process and might not be listening yet
+    for (int attempt = 0; attempt < 500; attempt++)
+    {
+        int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+        REQUIRE(connection >= 0);
+
+        if (connect(connection, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0)
+            return connection;
+
+        close(connection);
+        usleep(10000);
+    }
+
+    return -1;
+}
+
+// Stops the server when the test ends, including when a REQUIRE fails
+struct ServerGuard
+{
+    pid_t pid;
+
+    ~ServerGuard()
+    {
+        kill(pid, SIGTERM);
+        waitpid(pid, nullptr, 0);
+    }
+};
+
+TEST_CASE("ServerRoundTrip")
+{
+    char dir[] = "/tmp/luau-server-XXXXXX";
+    REQUIRE(mkdtemp(dir));
+
+    std::string socketPath = std::string(dir) + "/server.sock";
+    std::string okPath = std::string(dir) + "/ok.luau";
+    std::string failPath = std::string(dir) + "/fail.luau";
+
+    std::ofstream(okPath) << "local a, b = ...\nassert(a == 'x' and b == 'y')\n";
+    std::ofstream(failPath) << "error('failed')\n";
+
+    pid_t server = spawnRepl({"--server=" + socketPath});
+    REQUIRE(server > 0);
+
+    ServerGuard guard{server};
+
+    // an empty connection is rejected without stopping the server
+    int probe = connectToServer(socketPath);
+    REQUIRE(probe >= 0);
+    close(probe);
+
+    // requests larger than the limit are rejected and the received descriptors are released
+    {
+        int connection = connectToServer(socketPath);
+        REQUIRE(connection >= 0);
+
+        int fds[4] = {0, 1, 2, 0};
+        uint32_t size = 0xffffffff;
+
+        iovec iov = {&size, sizeof(size)};
+        char control[CMSG_SPACE(sizeof(fds))] = {};
+
+        msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+        CHECK(sendmsg(connection, &msg, 0) == sizeof(size));
+
+        char result = 0;
+        CHECK(read(connection, &result, 1) == 0);
+        close(connection);
+    }
+
+    CHECK(waitRepl(spawnRepl({"--connect=" + socketPath, okPath, "-a", "x", "y"})) == 0);
+    CHECK(waitRepl(spawnRepl({"--connect=" + socketPath, okPath, "-a", "x", "z"})) == 1);
+    CHECK(waitRepl(spawnRepl({"--connect=" + socketPath, failPath})) == 1);
+
+    // loaded chunks are reused between requests
+    CHECK(waitRepl(spawnRepl({"--connect=" + socketPath, okPath, "-a", "x", "y"})) == 0);
+
+    // ... unless their source changes
+    std::ofstream(okPath) << "local a, b = ...\nassert(a == 'x' and b == 'z')\n";
+    CHECK(waitRepl(spawnRepl({"--connect=" + socketPath, okPath, "-a", "x", "z"})) == 0);
+
+    unlink(socketPath.c_str());
+    unlink(okPath.c_str());
+    unlink(failPath.c_str());
+    rmdir(dir);
+}
+
+TEST_CASE("CacheDir")
+{
+    char dir[] = "/tmp/luau-cache-XXXXXX";
+    REQUIRE(mkdtemp(dir));
+
+    std::string scriptPath = std::string(dir) + "/script.luau";
+    std::string cacheDir = std::string(dir) + "/cache";
+    REQUIRE(mkdir(cacheDir.c_str(), 0700) == 0);
+
+    auto getCacheEntries = [&]() {
+        std::vector<std::string> entries;
+        traverseDirectory(cacheDir, [&](const std::string& name) {
+            entries.push_back(name);
+        });
+        return entries;
+    };
+
+    std::ofstream(scriptPath) << "assert(1 + 1 == 2)\n";
+
+    // entries are keyed on the executable too, so that bytecode from other builds isn't reused
+    std::optional<std::string> executable = getExecutablePath();
+    REQUIRE(executable);
+    CHECK(getFileModificationTime(*executable));
+
+    // the first run compiles the script and stores the bytecode
+    CHECK(waitRepl(spawnRepl({"--cache-dir=" + cacheDir, scriptPath})) == 0);
+
+    std::vector<std::string> entries = getCacheEntries();
+    REQUIRE(entries.size() == 1);
+
+    // later runs load the stored bytecode instead of compiling the source
+    writeFile(entries[0], Luau::compile("error('loaded from cache')"));
+    CHECK(waitRepl(spawnRepl({"--cache-dir=" + cacheDir, scriptPath})) == 1);
+    CHECK(getCacheEntries().size() == 1);
+
+    // changed sources get separate entries
+    std::ofstream(scriptPath) << "assert(2 + 2 == 4)\n";
+    CHECK(waitRepl(spawnRepl({"--cache-dir=" + cacheDir, scriptPath})) == 0);
+    CHECK(getCacheEntries().size() == 2);
+
+    // ... as do compiler options
+    CHECK(waitRepl(spawnRepl({"--cache-dir=" + cacheDir, "-O2", scriptPath})) == 0);
+    CHECK(getCacheEntries().size() == 3);
+
+    for (const std::string& entry : getCacheEntries())
+        unlink(entry.c_str());
+
+    unlink(scriptPath.c_str());
+    rmdir(cacheDir.c_str());
+    rmdir(dir);
+}
+
+TEST_SUITE_END();
+#endif
@@ -380,6 +380,26 @@ TEST_CASE_FIXTURE(ReplWithPathFixture, "CheckCacheAfterRequireInitLua")
     REQUIRE_FALSE_MESSAGE(lua_isnil(L, -1), "Cache did not contain module result");
 }
 
+TEST_CASE_FIXTURE(ReplWithPathFixture, "RequireAgainAfterModuleCacheIsCleared")
+{
+    std::string relativePath = getLuauDirectory(PathType::Relative) + "/tests/require/without_config/module";
+    std::string absolutePath = getLuauDirectory(PathType::Absolute) + "/tests/require/without_config/module";
+
+    runProtectedRequire(relativePath);
+    assertOutputContainsAll({"true", "result from dependency", "required into module"});
+
+    // resolution of the path is remembered, but the module itself has to be loaded again
+    lua_pushnil(L);
+    lua_setfield(L, LUA_REGISTRYINDEX, "_MODULES");
+
+    runProtectedRequire(relativePath);
+    assertOutputContainsAll({"true", "result from dependency", "required into module"});
+
+    luaL_findtable(L, LUA_REGISTRYINDEX, "_MODULES", 1);
+    lua_getfield(L, -1, (absolutePath + ".luau").c_str());
+    REQUIRE_FALSE_MESSAGE(lua_isnil(L, -1), "Cache did not contain module result");
+}
+
 TEST_CASE_FIXTURE(ReplWithPathFixture, "LoadStringRelative")
 {
     runCode(L, "return pcall(function() return loadstring(\"require('a/relative/path')\")() end)");
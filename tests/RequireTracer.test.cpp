@@ -41,6 +41,31 @@ struct RequireTracerFixture
             return result.root;
     }
 
+    // scanRequires needs to match traceRequires on the parsed source
+    void checkScan(std::string_view src, bool parsed)
+    {
+        // each parse needs its own name table
+        Allocator scanAllocator;
+        AstNameTable scanNames(scanAllocator);
+
+        ParseResult parseResult = Parser::parse(src.data(), src.size(), scanNames, scanAllocator, ParseOptions{});
+        REQUIRE(parseResult.errors.empty());
+
+        AstStatBlock* block = parseResult.root;
+
+        RequireTraceResult expected = traceRequires(&fileResolver, block, "game/Module/Script");
+        RequireScanResult result = scanRequires(&fileResolver, src, "game/Module/Script");
+
+        CHECK_EQ(parsed, result.parsed);
+        REQUIRE_EQ(expected.requireList.size(), result.requireList.size());
+
+        for (size_t i = 0; i < expected.requireList.size(); ++i)
+        {
+            CHECK_EQ(expected.requireList[i].first, result.requireList[i].first);
+            CHECK_EQ(expected.requireList[i].second, result.requireList[i].second);
+        }
+    }
+
     Allocator allocator;
     AstNameTable names;
 
@@ -178,4 +203,95 @@ TEST_CASE_FIXTURE(RequireTracerFixture, "follow_string_indexexpr")
     CHECK_EQ("game/Test", result.exprs[local->values.data[0]].name);
 }
 
+TEST_CASE_FIXTURE(RequireTracerFixture, "scan_paths")
+{
+    RequireScanResult result = scanRequires(&fileResolver, R"(
+        local A = require(script.Parent.A)
+        local B = require(game:GetService("ReplicatedStorage").B)
+        local C = require(workspace["C"])
+        print(require(script.Parent.D).value, 'require(script.E)') -- require(script.F)
+        require()
+    )", "game/Module/Script");
+
+    CHECK(!result.parsed);
+    REQUIRE_EQ(4, result.requireList.size());
+    CHECK_EQ("game/Module/A", result.requireList[0].first);
+    CHECK_EQ(Location({1, 18}, {1, 42}), result.requireList[0].second);
+    CHECK_EQ("game/ReplicatedStorage/B", result.requireList[1].first);
+    CHECK_EQ("workspace/C", result.requireList[2].first);
+    CHECK_EQ("game/Module/D", result.requireList[3].first);
+
+    checkScan(R"(
+        local A = require(script.Parent.A)
+        local B = require(game:GetService("ReplicatedStorage").B)
+        local C = require(workspace["C"], 1)
+        local D = require(script.Parent.D).value
+    )", false);
+}
+
+TEST_CASE_FIXTURE(RequireTracerFixture, "scan_aliases")
+{
+    checkScan(R"(
+        local Packages = script.Parent.Packages
+        local Shared = Packages.Shared
+        local A = require(Packages.A)
+        local B = require(Shared.B)
+
+        local function f()
+            local C = require(Shared.C)
+            return C
+        end
+    )", false);
+}
+
+TEST_CASE_FIXTURE(RequireTracerFixture, "scan_type_assertions")
+{
+    checkScan(R"(
+        local A = require(script.A) :: any
+        local B = (require(script.B) :: any).B
+        local C = require(script.C)
+    )", false);
+}
+
+TEST_CASE_FIXTURE(RequireTracerFixture, "scan_falls_back_to_parsing")
+{
+    // shadowed or reassigned roots, aliases that aren't simple paths and redefined require all need the AST
+    checkScan(R"(
+        for _, script in workspace:GetChildren() do
+            require(script.A)
+        end
+    )", true);
+
+    checkScan(R"(
+        local Packages = script.Packages
+        Packages = workspace
+        local A = require(Packages.A)
+    )", true);
+
+    checkScan(R"(
+        local Packages = script.Packages or workspace
+        local A = require(Packages.A)
+    )", true);
+
+    checkScan(R"(
+        local function f(Packages)
+            return require(Packages.A)
+        end
+    )", true);
+
+    checkScan(R"(
+        local require = function(x) return x end
+        local A = require(script.A)
+    )", true);
+
+    checkScan(R"(
+        local A = require(if true then script.A else script.B)
+    )", true);
+
+    checkScan(R"(
+        local A = require(script.A :: any)
+        local B = script :: typeof(require(script.B))
+    )", true);
+}
+
 TEST_SUITE_END();
@@ -398,6 +398,40 @@ TEST_CASE("AnonymousModuleLifetime")
     // that there are no outstanding anonymous NativeModules.
 }
 
+TEST_CASE("ReleasedModuleMemoryIsReused")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    CodeAllocator codeAllocator{kBlockSize, kMaxTotalSize};
+    SharedCodeAllocator allocator{&codeAllocator};
+
+    const std::vector<uint8_t> data(8);
+    const std::vector<uint8_t> code(8);
+
+    NativeModuleRef modRefA = allocator.getOrInsertNativeModule(ModuleId{0x0a}, {}, data.data(), data.size(), code.data(), code.size()).first;
+    REQUIRE(!modRefA.empty());
+
+    const uint8_t* baseAddressA = modRefA->getModuleBaseAddress();
+
+    CodeAllocationStats stats = allocator.getCodeAllocationStats();
+    CHECK(stats.allocatedSize != 0);
+    CHECK(stats.freeRangeCount == 0);
+
+    // Releasing the last reference returns the module memory to the allocator:
+    modRefA.reset();
+
+    stats = allocator.getCodeAllocationStats();
+    CHECK(stats.allocatedSize == 0);
+    CHECK(stats.freeRangeCount == 1);
+
+    // And the next module is placed into it:
+    NativeModuleRef modRefB = allocator.getOrInsertNativeModule(ModuleId{0x0b}, {}, data.data(), data.size(), code.data(), code.size()).first;
+    REQUIRE(!modRefB.empty());
+    CHECK(modRefB->getModuleBaseAddress() == baseAddressA);
+    CHECK(allocator.getCodeAllocationStats().freeRangeCount == 0);
+}
+
 TEST_CASE("SharedAllocation")
 {
     if (!luau_codegen_supported())
@@ -447,4 +481,10 @@ TEST_CASE("SharedAllocation")
     // We should have bound all three functions both times through:
     REQUIRE(nativeStats1.functionsBound == 3);
     REQUIRE(nativeStats2.functionsBound == 3);
+
+    // Only the second compilation should have found the module compiled by the first one:
+    CHECK(nativeStats1.moduleCacheHits == 0);
+    CHECK(nativeStats1.moduleCacheMisses == 1);
+    CHECK(nativeStats2.moduleCacheHits == 1);
+    CHECK(nativeStats2.moduleCacheMisses == 0);
 }
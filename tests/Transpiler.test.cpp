@@ -694,4 +694,35 @@ TEST_CASE_FIXTURE(Fixture, "transpile_string_literal_escape")
     CHECK_EQ(code, transpile(code, {}, true).code);
 }
 
+TEST_CASE("transpile_streaming_output")
+{
+    std::string code = "local t = {}\n";
+
+    for (int i = 0; i < 5000; ++i)
+        code += format("t[%d] = function(a: number, b: string): string return b .. tostring(a + %d) end\n", i, i);
+
+    Allocator allocator;
+    AstNameTable names(allocator);
+    ParseResult parseResult = Parser::parse(code.data(), code.size(), names, allocator, {});
+    REQUIRE(parseResult.errors.empty());
+
+    std::string streamed;
+    size_t chunks = 0;
+    size_t largestChunk = 0;
+
+    transpile(
+        *parseResult.root,
+        [&](std::string_view chunk) {
+            streamed.append(chunk.data(), chunk.size());
+            chunks++;
+            largestChunk = std::max(largestChunk, chunk.size());
+        },
+        /* withTypes= */ true);
+
+    CHECK_EQ(streamed, transpileWithTypes(*parseResult.root));
+    CHECK_EQ(streamed, code);
+    CHECK(chunks > 1);
+    CHECK(largestChunk < 128 * 1024);
+}
+
 TEST_SUITE_END();
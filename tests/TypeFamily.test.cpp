@@ -555,6 +555,32 @@ TEST_CASE_FIXTURE(BuiltinsFixture, "rawkeyof_type_family_never_for_empty_table")
     CHECK(toString(requireType("foo")) == "never");
 }
 
+TEST_CASE_FIXTURE(ClassFixture, "reductions_of_equivalent_instances_are_shared")
+{
+    if (!FFlag::DebugLuauDeferredConstraintResolution)
+        return;
+
+    CheckResult result = check(R"(
+        local function f(a: Vector2, b: Vector2)
+            return a + b, a * 2
+        end
+
+        local function g(a: Vector2, b: Vector2)
+            return a + b, a * 2
+        end
+
+        local a, b = f(Vector2.New(1, 2), Vector2.New(3, 4))
+        local c, d = g(Vector2.New(1, 2), Vector2.New(3, 4))
+    )");
+
+    LUAU_REQUIRE_NO_ERRORS(result);
+
+    CHECK("Vector2" == toString(requireType("a")));
+    CHECK("Vector2" == toString(requireType("b")));
+    CHECK("Vector2" == toString(requireType("c")));
+    CHECK("Vector2" == toString(requireType("d")));
+}
+
 TEST_CASE_FIXTURE(ClassFixture, "keyof_type_family_works_on_classes")
 {
     if (!FFlag::DebugLuauDeferredConstraintResolution)
@@ -578,6 +578,18 @@ TEST_CASE_FIXTURE(BuiltinsFixture, "string_format_arg_types_inference")
     CHECK_EQ("(number, number, string) -> string", toString(requireType("f")));
 }
 
+TEST_CASE_FIXTURE(BuiltinsFixture, "string_unpack_accepts_buffers")
+{
+    CheckResult result = check(R"(
+        --!strict
+        local b = buffer.create(8)
+        local x = string.unpack("<i4", b)
+        local y = string.unpack("<i4", "abcd", 1)
+    )");
+
+    LUAU_REQUIRE_NO_ERRORS(result);
+}
+
 TEST_CASE_FIXTURE(BuiltinsFixture, "string_format_arg_count_mismatch")
 {
     CheckResult result = check(R"(
@@ -463,6 +463,36 @@ end
 
 boundchecksempty()
 
+-- consecutive accesses at offsets that differ by a constant
+local function boundchecksmerged(size, pos)
+  local b = buffer.create(size)
+
+  local function writepair(b, p, x, y)
+    buffer.writeu32(b, p, x)
+    buffer.writeu32(b, p + 4, y)
+  end
+
+  local function readpair(b, p)
+    return buffer.readu32(b, p), buffer.readu32(b, p + 4)
+  end
+
+  writepair(b, pos, 1, 2)
+  local x, y = readpair(b, pos)
+  assert(x == 1 and y == 2)
+
+  -- offset is truncated, so the second access starts 3 bytes after the first one
+  writepair(b, -0.5, 5, 6)
+  assert(buffer.readu8(b, 0) == 5)
+  assert(buffer.readu32(b, 3) == 6)
+
+  -- first access is still performed when the second one is out of bounds
+  assert(ecall(function() writepair(b, size - 6, 7, 8) end) == "buffer access out of bounds")
+  assert(buffer.readu32(b, size - 6) == 7)
+  assert(ecall(function() readpair(b, size - 4) end) == "buffer access out of bounds")
+end
+
+boundchecksmerged(16, 4)
+
 local function intuint()
   local b = buffer.create(32)
 
@@ -574,6 +604,116 @@ end
 
 fill()
 
+local function bulkops()
+  local a = buffer.fromstring("hello world")
+  local b = buffer.fromstring("world")
+
+  -- compare
+  assert(buffer.compare(a, 6, b) == 0)
+  assert(buffer.compare(a, 0, b) == -1)
+  assert(buffer.compare(b, 0, a, 0, 5) == 1)
+  assert(buffer.compare(a, 1, b, 1, 0) == 0)
+  assert(buffer.compare(a, 7, b, 1, 4) == 0)
+  assert(ecall(function() buffer.compare(a, 7, b) end) == "buffer access out of bounds")
+  assert(ecall(function() buffer.compare(a, 0, b, 3, 3) end) == "buffer access out of bounds")
+  assert(ecall(function() buffer.compare(a, -1, b, 0, 1) end) == "buffer access out of bounds")
+
+  -- find
+  assert(buffer.find(a, 0, "o") == 4)
+  assert(buffer.find(a, 5, "o") == 7)
+  assert(buffer.find(a, 0, "world") == 6)
+  assert(buffer.find(a, 0, "worlds") == nil)
+  assert(buffer.find(a, 0, "world", 10) == nil)
+  assert(buffer.find(a, 0, "d", 11) == 10)
+  assert(buffer.find(a, 3, "") == 3)
+  assert(buffer.find(a, 11, "o") == nil)
+  assert(buffer.find(buffer.fromstring("aaab"), 0, "ab") == 2)
+  assert(buffer.find(buffer.fromstring("a\0b"), 0, "\0b") == 1)
+  assert(ecall(function() buffer.find(a, 12, "o") end) == "buffer access out of bounds")
+  assert(ecall(function() buffer.find(a, 0, "o", 12) end) == "buffer access out of bounds")
+
+  -- crc32
+  assert(buffer.crc32(buffer.fromstring("123456789")) == 0xcbf43926)
+  assert(buffer.crc32(buffer.create(0)) == 0)
+  assert(buffer.crc32(a, 6) == buffer.crc32(b))
+  assert(buffer.crc32(a, 0, 5) == buffer.crc32(buffer.fromstring("hello")))
+  assert(ecall(function() buffer.crc32(a, 5, 7) end) == "buffer access out of bounds")
+
+  -- swap
+  local c = buffer.create(16)
+  buffer.writeu32(c, 0, 0x01020304)
+  buffer.writeu32(c, 4, 0x05060708)
+  buffer.swap(c, 0, 8, 4)
+  assert(buffer.readu32(c, 0) == 0x04030201)
+  assert(buffer.readu32(c, 4) == 0x08070605)
+  buffer.swap(c, 0, 8, 8)
+  assert(buffer.readu32(c, 0) == 0x05060708)
+  assert(buffer.readu32(c, 4) == 0x01020304)
+  buffer.swap(c, 2, 2, 2)
+  assert(buffer.readu32(c, 0) == 0x06050708)
+  assert(ecall(function() buffer.swap(c, 0, 6, 4) end) == "invalid argument #3 to 'swap' (count must be a multiple of width)")
+  assert(ecall(function() buffer.swap(c, 0, 4, 3) end) == "invalid argument #4 to 'swap' (width must be 2, 4 or 8)")
+  assert(ecall(function() buffer.swap(c, 12, 8, 4) end) == "buffer access out of bounds")
+end
+
+bulkops()
+
+local function numericops()
+  local a = buffer.create(80)
+  local b = buffer.create(80)
+
+  for i = 0, 9 do
+    buffer.writef64(a, i * 8, i + 1)
+    buffer.writef64(b, i * 8, 2)
+  end
+
+  -- sum/min/max
+  assert(buffer.sumf64(a, 0, 10) == 55)
+  assert(buffer.sumf64(a, 8, 3) == 9)
+  assert(buffer.sumf64(a, 0, 0) == 0)
+  assert(buffer.minf64(a, 16, 5) == 3)
+  assert(buffer.maxf64(a, 16, 5) == 7)
+  buffer.writef64(a, 24, 0/0)
+  assert(buffer.maxf64(a, 16, 5) == 7)
+  buffer.writef64(a, 24, 4)
+  assert(ecall(function() buffer.minf64(a, 0, 0) end) == "invalid argument #3 to 'minf64' (count)")
+  assert(ecall(function() buffer.sumf64(a, 8, 10) end) == "buffer access out of bounds")
+  assert(ecall(function() buffer.sumf64(a, 0, -1) end) == "invalid argument #3 to 'sumf64' (count)")
+
+  -- dot/axpy
+  assert(buffer.dotf64(a, 0, b, 0, 10) == 110)
+  assert(buffer.dotf64(a, 0, a, 0, 3) == 14)
+  buffer.axpyf64(b, 0, 0.5, a, 0, 10)
+  assert(buffer.readf64(b, 0) == 2.5)
+  assert(buffer.readf64(b, 72) == 7)
+  assert(ecall(function() buffer.dotf64(a, 0, b, 8, 10) end) == "buffer access out of bounds")
+  assert(ecall(function() buffer.axpyf64(a, 0, 1, b, 8, 10) end) == "buffer access out of bounds")
+
+  -- clamp
+  buffer.clampf64(a, 0, 10, 3, 8)
+  assert(buffer.readf64(a, 0) == 3)
+  assert(buffer.readf64(a, 32) == 5)
+  assert(buffer.readf64(a, 72) == 8)
+  assert(ecall(function() buffer.clampf64(a, 0, 10, 8, 3) end) == "invalid argument #5 to 'clampf64' (max must be greater than or equal to min)")
+
+  -- f32 versions use single precision storage but accumulate in double precision
+  local c = buffer.create(40)
+  for i = 0, 9 do
+    buffer.writef32(c, i * 4, 0.1)
+  end
+  assert(buffer.sumf32(c, 0, 10) == buffer.readf32(c, 0) * 10)
+  assert(buffer.minf32(c, 0, 10) == buffer.readf32(c, 0))
+  assert(buffer.maxf32(c, 4, 9) == buffer.readf32(c, 0))
+  assert(buffer.dotf32(c, 0, c, 0, 1) == buffer.readf32(c, 0) ^ 2)
+  buffer.axpyf32(c, 0, 2, c, 0, 10)
+  assert(buffer.readf32(c, 36) == buffer.readf32(c, 0))
+  buffer.clampf32(c, 0, 10, 0, 0.25)
+  assert(buffer.readf32(c, 0) == 0.25)
+  assert(ecall(function() buffer.sumf32(c, 4, 10) end) == "buffer access out of bounds")
+end
+
+numericops()
+
 local function misc(t16)
   local b = buffer.create(1000)
 
@@ -614,10 +754,13 @@ local function testslowcalls()
   boundcheckssmall()
   boundcheckssmallnonconst(0, 1, -1, -2, -4, -7, -8)
   boundchecksempty()
+  boundchecksmerged(16, 4)
   intuint()
   intuinttricky()
   fromtostring()
   fill()
+  bulkops()
+  numericops()
   misc(table.create(16, 0))
 end
 
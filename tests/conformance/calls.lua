@@ -236,4 +236,152 @@ if not limitedstack then
   assert(not err and string.find(msg, "error"))
 end
 
+-- polymorphic method calls and field accesses where the key is in a different slot for each table
+do
+  local classes = {}
+  for c = 1, 4 do
+    local class = {}
+    class.__index = class
+    -- pad each class with a different number of methods so that 'get' is in different slots
+    for i = 1, c * 3 do
+      class["pad" .. i] = function() end
+    end
+    function class.get(self) return c * 10 + self.value end
+    classes[c] = class
+  end
+
+  local objects = {}
+  for i = 1, 40 do
+    local object = { value = i % 7 }
+    for j = 1, i % 5 do
+      object["field" .. j] = j
+    end
+    objects[i] = setmetatable(object, classes[i % 4 + 1])
+  end
+
+  for iter = 1, 3 do
+    local sum, values = 0, 0
+    for i, object in objects do
+      sum += object:get()
+      values += object.value
+    end
+    assert(sum == 1120 and values == 120)
+  end
+end
+
+-- method calls and field accesses through deep chains of __index tables, with changes to the chain between calls
+do
+  local function class(base)
+    local c = {}
+    c.__index = c
+    return setmetatable(c, base)
+  end
+
+  local A = class(nil)
+  local B = class(A)
+  local C = class(B)
+  local D = class(C)
+
+  function A.name(self) return "A" end
+  A.kind = "a"
+
+  local obj = setmetatable({}, D)
+
+  local function call(o) return o:name() end
+  local function field(o) return o.kind end
+
+  for i = 1, 3 do
+    assert(call(obj) == "A" and field(obj) == "a")
+  end
+
+  -- overrides in the middle of the chain take precedence
+  function C.name(self) return "C" end
+  C.kind = "c"
+  assert(call(obj) == "C" and field(obj) == "c")
+  assert(call(obj) == "C" and field(obj) == "c")
+
+  -- removing the override restores the base method, even though the key remains in the table
+  C.name = nil
+  C.kind = nil
+  assert(call(obj) == "A" and field(obj) == "a")
+  assert(call(obj) == "A" and field(obj) == "a")
+
+  -- and bringing it back reuses the same key
+  C.name = function(self) return "C2" end
+  C.kind = "c2"
+  assert(call(obj) == "C2" and field(obj) == "c2")
+  C.name = nil
+  C.kind = nil
+
+  -- replacing the method in the base class is visible
+  function A.name(self) return "A2" end
+  A.kind = "a2"
+  assert(call(obj) == "A2" and field(obj) == "a2")
+
+  -- changing __index or the metatable of an intermediate class rewires the chain
+  local E = class(nil)
+  function E.name(self) return "E" end
+  E.kind = "e"
+  B.__index = E
+  assert(call(obj) == "E" and field(obj) == "e")
+  B.__index = B
+  assert(call(obj) == "A2" and field(obj) == "a2")
+  setmetatable(B, E)
+  assert(call(obj) == "E" and field(obj) == "e")
+  setmetatable(B, A)
+  assert(call(obj) == "A2" and field(obj) == "a2")
+
+  -- fields of the object itself shadow the chain
+  obj.kind = "own"
+  obj.name = function(self) return "own" end
+  assert(call(obj) == "own" and field(obj) == "own")
+  obj.kind = nil
+  obj.name = nil
+  assert(call(obj) == "A2" and field(obj) == "a2")
+
+  -- functions in the middle of the chain are called
+  C.__index = function(t, k) return k == "kind" and "fn" or function() return "fn" end end
+  assert(call(setmetatable({}, C)) == "fn" and field(setmetatable({}, C)) == "fn")
+  assert(call(obj) == "fn" and field(obj) == "fn")
+  C.__index = C
+  assert(call(obj) == "A2" and field(obj) == "a2")
+
+  -- many objects of different classes at different depths going through the same call site
+  local classes = { A, B, C, D }
+  local sum = 0
+  for i = 1, 100 do
+    local o = setmetatable({}, classes[i % 4 + 1])
+    sum += #call(o) + #field(o)
+  end
+  assert(sum == 400)
+
+  -- missing methods are still reported
+  assert(not pcall(function() return obj:missing() end))
+end
+
+-- long strings aren't interned, so a long key of the object itself can be a different string object than the key in the chain
+do
+  local long = string.rep("a", 2000)
+
+  local A = {}
+  A.__index = A
+
+  local B = setmetatable({}, A)
+  B.__index = B
+
+  -- the base field and the lookup use the same constant string object
+  local get = loadstring("local A = ... A." .. long .. " = 'base' return function(o) return o." .. long .. " end")(A)
+
+  local obj = setmetatable({}, B)
+  for i = 1, 3 do
+    assert(get(obj) == "base")
+  end
+
+  local own = setmetatable({}, B)
+  own[string.rep("a", 2000)] = "own"
+  assert(rawget(own, long) == "own")
+  assert(get(own) == "own")
+  assert(get(obj) == "base")
+end
+
 return('OK')
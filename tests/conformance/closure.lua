@@ -401,4 +401,33 @@ do
   end
 end
 
+-- closures in loops that only capture values defined outside of the loop
+do
+  local function run(n, k)
+    local res = {}
+    for i = 1, n do
+      local get = function() return k end
+      local inner = 0
+      while inner < 2 do
+        inner += 1
+        local f = function() return i * 10 + inner + get() end
+        res[#res + 1] = f()
+      end
+      repeat
+        local g = function() return k end
+        res[#res + 1] = g() + i
+      until true
+    end
+    return res
+  end
+
+  local r = run(2, 100)
+  assert(#r == 6)
+  assert(r[1] == 111 and r[2] == 112 and r[3] == 101)
+  assert(r[4] == 121 and r[5] == 122 and r[6] == 102)
+
+  local r2 = run(1, 5)
+  assert(r2[1] == 16 and r2[3] == 6)
+end
+
 return 'OK'
@@ -0,0 +1,119 @@
+-- This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+print("testing json library")
+
+local function ecall(fn, ...)
+  local ok, err = pcall(fn, ...)
+  assert(not ok)
+  return err
+end
+
+local function deepeq(a, b)
+  if type(a) ~= "table" or type(b) ~= "table" then
+    return a == b
+  end
+  for k, v in a do
+    if not deepeq(v, b[k]) then return false end
+  end
+  for k in b do
+    if a[k] == nil then return false end
+  end
+  return true
+end
+
+-- scalars
+assert(json.decode("true") == true)
+assert(json.decode("false") == false)
+assert(json.decode("null") == nil)
+assert(json.decode(" 42 ") == 42)
+assert(json.decode("-0.5e2") == -50)
+assert(json.decode("1E3") == 1000)
+assert(json.decode("123456789012345678901234567890") == 123456789012345678901234567890)
+assert(json.decode('"hello"') == "hello")
+
+-- strings
+assert(json.decode('"a\\"b\\\\c\\/d\\b\\f\\n\\r\\t"') == "a\"b\\c/d\b\f\n\r\t")
+assert(json.decode('"\\u0041\\u00e9\\u20ac"') == "A\u{e9}\u{20ac}")
+assert(json.decode('"\\ud83d\\ude00"') == "\u{1f600}")
+assert(json.decode('"\u{1f600}"') == "\u{1f600}")
+
+-- containers
+assert(deepeq(json.decode("[]"), {}))
+assert(deepeq(json.decode("{}"), {}))
+assert(deepeq(json.decode('[1, "two", [3], {"four": 4}]'), {1, "two", {3}, {four = 4}}))
+assert(deepeq(json.decode('{"a": {"b": {"c": [true, false]}}}'), {a = {b = {c = {true, false}}}}))
+assert(json.decode('[1, null, 3]')[3] == 3)
+assert(json.decode('{"a": 1, "a": 2}').a == 2)
+
+-- large containers are filled in several batches
+do
+  local parts, fields = {}, {}
+  for i = 1, 1000 do
+    parts[i] = tostring(i)
+    fields[i] = string.format('"k%d": %d', i, i)
+  end
+
+  local arr = json.decode("[" .. table.concat(parts, ",") .. "]")
+  assert(#arr == 1000)
+  for i = 1, 1000 do assert(arr[i] == i) end
+
+  local obj = json.decode("{" .. table.concat(fields, ",") .. "}")
+  for i = 1, 1000 do assert(obj["k" .. i] == i) end
+end
+
+-- repeated keys go through the key cache
+do
+  local items = {}
+  for i = 1, 100 do items[i] = string.format('{"id": %d, "name": "n%d", "tags": ["x"]}', i, i) end
+  local res = json.decode("[" .. table.concat(items, ",") .. "]")
+  for i = 1, 100 do assert(res[i].id == i and res[i].name == "n" .. i and res[i].tags[1] == "x") end
+end
+
+-- buffers are decoded in place
+assert(deepeq(json.decode(buffer.fromstring('{"x": [1, 2]}')), {x = {1, 2}}))
+
+-- errors
+assert(ecall(json.decode, "") == "invalid JSON at offset 0: unexpected end of input")
+assert(ecall(json.decode, "[1,]") == "invalid JSON at offset 3: unexpected character")
+assert(ecall(json.decode, "[1 2]") == "invalid JSON at offset 3: expected ',' or ']'")
+assert(ecall(json.decode, '{"a" 1}') == "invalid JSON at offset 5: expected ':'")
+assert(ecall(json.decode, '{1: 2}') == "invalid JSON at offset 1: expected string key")
+assert(ecall(json.decode, '"abc') == "invalid JSON at offset 4: unfinished string")
+assert(ecall(json.decode, '"a\\x"') == "invalid JSON at offset 3: invalid escape sequence")
+assert(ecall(json.decode, '"\\ud83d"') == "invalid JSON at offset 7: invalid unicode escape")
+assert(ecall(json.decode, '"a\nb"') == "invalid JSON at offset 2: control character in string")
+assert(ecall(json.decode, "01") == "invalid JSON at offset 1: unexpected character after the value")
+assert(ecall(json.decode, "1.") == "invalid JSON at offset 2: invalid number")
+assert(ecall(json.decode, "nul") == "invalid JSON at offset 0: unexpected character")
+assert(ecall(json.decode, "1 2") == "invalid JSON at offset 2: unexpected character after the value")
+assert(ecall(json.decode, string.rep("[", 200)) == "invalid JSON at offset 128: nesting is too deep")
+
+-- encoding
+assert(json.encode(nil) == "null")
+assert(json.encode(true) == "true")
+assert(json.encode(42) == "42")
+assert(json.encode(-0.5) == "-0.5")
+assert(json.encode(1e300) == "1e+300")
+assert(json.encode("a\"b\\c\n\1") == '"a\\"b\\\\c\\n\\u0001"')
+assert(json.encode("\u{1f600}") == '"\u{1f600}"')
+assert(json.encode({}) == "[]")
+assert(json.encode({1, "two", {3}}) == '[1,"two",[3]]')
+assert(json.encode({a = 1}) == '{"a":1}')
+assert(json.encode({a = {b = {true}}}) == '{"a":{"b":[true]}}')
+
+do
+  local value = {list = {1, 2.5, "three", false}, nested = {key = "value"}, text = string.rep("long text ", 200)}
+  assert(deepeq(json.decode(json.encode(value)), value))
+end
+
+assert(ecall(json.encode, 0/0) == "cannot encode JSON: number is not finite")
+assert(ecall(json.encode, {math.huge}) == "cannot encode JSON: number is not finite")
+assert(ecall(json.encode, {[true] = 1}) == "cannot encode JSON: object keys must be strings, got boolean")
+assert(ecall(json.encode, {print}) == "cannot encode JSON: unsupported type function")
+
+do
+  local cycle = {}
+  cycle[1] = cycle
+  assert(ecall(json.encode, cycle) == "cannot encode JSON: nesting is too deep or the table has a cycle")
+end
+
+return "OK"
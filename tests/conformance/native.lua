@@ -513,4 +513,155 @@ end
 assert(extramath3(2) == "number")
 assert(extramath3("2") == "number")
 
+local function stringbyte(s: string, i: number)
+  return string.byte(s, i)
+end
+
+assert(stringbyte("abc", 1) == 97)
+assert(stringbyte("abc", 3) == 99)
+assert(stringbyte("abc", 2.5) == 98)
+assert(stringbyte("abc", -1) == 99)
+assert(select('#', stringbyte("abc", 0)) == 0)
+assert(select('#', stringbyte("abc", 4)) == 0)
+assert(select('#', stringbyte("", 1)) == 0)
+
+local function stringbyteconst(s: string)
+  local a = string.byte(s, 1)
+  local b = string.byte(s, 5000)
+  return a, b
+end
+
+assert(stringbyteconst("abc") == 97)
+assert(select(2, stringbyteconst(string.rep("x", 4999) .. "y")) == 121)
+
+local function stringbytecount(s: string, c: number)
+  local n = 0
+  for i = 1, #s do
+    if string.byte(s, i) == c then n += 1 end
+  end
+  return n
+end
+
+assert(stringbytecount("a,b,,c", string.byte(",")) == 3)
+assert(stringbytecount("", 0) == 0)
+assert(stringbytecount("\0\255\0", 0) == 2)
+assert(pcall(stringbytecount, nil, 0) == false)
+
+local function arrayappend(n: number)
+  local t = {}
+  for i = 1, n do
+    table.insert(t, i)
+    t[#t + 1] = -i
+  end
+  return t
+end
+
+local function arraypop(t: {number}, n: number)
+  local sum = 0
+  for i = 1, n do
+    sum += table.remove(t) or 0
+  end
+  return sum
+end
+
+do
+  local t = arrayappend(100)
+  assert(#t == 200)
+  for i = 1, 100 do
+    assert(t[i * 2 - 1] == i and t[i * 2] == -i)
+  end
+
+  assert(arraypop(t, 151) == -25)
+  assert(#t == 49)
+  assert(arraypop(t, 60) == 25)
+  assert(#t == 0 and next(t) == nil)
+
+  -- length stays a border when elements are removed around the cached boundary
+  local t = arrayappend(8)
+  t[16] = nil
+  t[15] = nil
+  assert(#t == 14)
+  t[#t + 1] = 1
+  t[7] = nil
+  local n = #t
+  assert(t[n] ~= nil and t[n + 1] == nil)
+
+  -- readonly tables are handled by the library function
+  local ro = table.freeze({1, 2, 3})
+  assert(pcall(table.insert, ro, 4) == false)
+  assert(pcall(arraypop, ro, 1) == false)
+  assert(#ro == 3)
+
+  -- elements outside of the array part
+  local h = {}
+  h[1] = 1
+  h[2] = 2
+  h.x = 1
+  table.insert(h, 3)
+  assert(#h == 3 and table.remove(h) == 3 and table.remove(h) == 2 and #h == 1)
+  assert(table.remove({}) == nil)
+  assert(select('#', table.remove({})) == 0)
+end
+
+-- pairs/next iteration over the hash part skips empty nodes and nodes with dead keys
+local function hashsum(t)
+  assert(is_native())
+  local keys, sum = 0, 0
+  for k, v in pairs(t) do
+    keys += 1
+    sum += v
+  end
+  return keys, sum
+end
+
+local function hashcollect(t)
+  local seen = {}
+  for k, v in next, t do
+    assert(seen[k] == nil)
+    seen[k] = v
+  end
+  return seen
+end
+
+do
+  local t = {}
+  for i = 1, 100 do
+    t["k" .. i] = i
+  end
+
+  local keys, sum = hashsum(t)
+  assert(keys == 100 and sum == 5050)
+
+  -- removed entries keep their nodes with dead keys until the table is rehashed
+  for i = 1, 100, 2 do
+    t["k" .. i] = nil
+  end
+  collectgarbage()
+
+  keys, sum = hashsum(t)
+  assert(keys == 50 and sum == 2550)
+
+  -- keys of all types, with both array and hash parts
+  local mixed = {10, 20, 30, x = 1, [true] = 2, [1.5] = 3, [hashsum] = 4, [t] = 5}
+  mixed[vector.create(1, 2, 3)] = 6
+
+  local seen = hashcollect(mixed)
+  assert(seen[1] == 10 and seen[2] == 20 and seen[3] == 30)
+  assert(seen.x == 1 and seen[true] == 2 and seen[1.5] == 3 and seen[hashsum] == 4 and seen[t] == 5)
+  keys, sum = hashsum(mixed)
+  assert(keys == 9 and sum == 81)
+
+  -- existing entries can be cleared during traversal
+  local cleared = 0
+  for k, v in pairs(t) do
+    t[k] = nil
+    cleared += 1
+  end
+  assert(cleared == 50 and next(t) == nil)
+
+  -- empty tables and tables with only dead keys
+  assert(hashsum({}) == 0)
+  assert(hashsum(t) == 0)
+end
+
 return('OK')
@@ -264,4 +264,34 @@ if not limitedstack then
 	assert(count + 1 == 200) -- stack limit (MAXCCALLS) is 200, -1 for first pcall
 end
 
+-- errors caught by a pcall with discarded results skip building the message, but the message is still there when it can be observed
+do
+	local function indexnil() local t = nil; return t.field end
+	local function nested() indexnil() end
+
+	pcall(indexnil)
+	pcall(nested)
+
+	local ok, err = pcall(indexnil)
+	assert(not ok and err:match("attempt to index nil with 'field'"))
+
+	local seen
+	xpcall(indexnil, function(e) seen = e end)
+	assert(seen:match("attempt to index nil with 'field'"))
+
+	-- the inner pcall is observed even though the outer one is discarded
+	local inner
+	pcall(function() inner = select(2, pcall(nested)) end)
+	assert(inner:match("attempt to index nil with 'field'"))
+
+	-- errors raised in a coroutine are observed by resume
+	local co = coroutine.create(indexnil)
+	pcall(function() inner = select(2, coroutine.resume(co)) end)
+	assert(inner:match("attempt to index nil with 'field'"))
+
+	-- errors that cross a C frame can be observed by it
+	pcall(function() inner = select(2, pcall(table.sort, {1, 2}, function(a, b) return a < nil end)) end)
+	assert(inner:match("attempt to compare number < nil"))
+end
+
 return 'OK'
@@ -314,4 +314,27 @@ assert(string.match("abc\0\0\0", "%\0%\0?") == "\0\0")
 assert(string.find("abc\0\0","\0.") == 4)
 assert(string.find("abcx\0\0abc\0abc","x\0\0abc\0a.") == 4)
 
+-- unanchored searches skip positions where the first pattern item can't match
+assert(string.find("  key=value", "k(%w+)=") == 3)
+assert(string.match("  key=value", "((%a+)=(%a+))") == "key=value")
+assert(select(2, string.match("  key=value", "()(%a+)=")) == "key")
+assert(string.match("abc123def", "()%d") == 4)
+assert(string.match("abc123def", "[%d]+") == "123")
+assert(string.match("abc123def", "[^%a]+") == "123")
+assert(string.match("abc", "%d") == nil)
+assert(string.find("abc", "c", 4) == nil)
+assert(string.find("a.b", "%.") == 2)
+assert(string.find("ab", "b$") == 2)
+assert(string.find("a$b", "$b") == 2)
+assert(string.gsub("hello world", "o", "0") == "hell0 w0rld")
+assert(string.gsub("hello world", "%s+", "_") == "hello_world")
+assert(string.gsub("abc", "%d", "x") == "abc")
+assert(select(2, string.gsub("a1b22c333", "%d+", "")) == 3)
+assert(string.gsub("abc", "%", "x", 0) == "abc")
+do
+  local t = {}
+  for k, v in string.gmatch("a=1, bb=22, ccc=333", "(%a+)=(%d+)") do t[#t + 1] = k .. v end
+  assert(table.concat(t, " ") == "a1 bb22 ccc333")
+end
+
 return('OK')
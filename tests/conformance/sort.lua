@@ -33,6 +33,38 @@ checksort({3, 1, 1, 7, 1, 3, 5, 1, 9, 3}, nil, 1, 1, 1, 1, 3, 3, 3, 5, 7, 9)
 -- predicates
 checksort({3, 8, 1, 7, 10, 2, 5, 4, 9, 6}, function (a, b) return a > b end, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
 
+-- arrays of numbers or strings are sorted without calling the comparison metamethods
+do
+  local function check(t)
+    local copy = table.clone(t)
+    table.sort(copy)
+    for i = 2, #copy do assert(not (copy[i] < copy[i - 1])) end
+    table.sort(t, function(a, b) return a < b end)
+    for i = 1, #t do assert(copy[i] == t[i]) end
+  end
+
+  for _, n in {2, 16, 17, 100, 1000} do
+    local nums, strs, dups = {}, {}, {}
+    for i = 1, n do
+      nums[i] = (i * 7919) % 1009 - 500 + i / n
+      strs[i] = tostring((i * 7919) % 1009)
+      dups[i] = i % 3
+    end
+    check(nums)
+    check(strs)
+    check(dups)
+  end
+
+  check({-0.0, 0, 1, -1, math.huge, -math.huge})
+  check({"b", "a", "", "a\0", "a\0b", "ab"})
+
+  -- NaN and mixed types go through the generic path
+  local withnan = {3, 0/0, 1, 2}
+  table.sort(withnan)
+  assert(#withnan == 4)
+  assert(pcall(table.sort, {1, "a", 2}) == false)
+end
+
 -- can't sort readonly tables
 assert(pcall(table.sort, table.freeze({2, 1})) == false)
 
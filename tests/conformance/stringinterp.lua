@@ -56,4 +56,33 @@ assertEq(shadowsString(1), "Value is 1")
 
 assertEq(`\u{0041}\t`, "A\t")
 
+-- values are converted like tostring, including numbers that need more digits and values with __tostring metamethods
+assertEq(`{nil} {false} {0.1} {-0} {1e300} {1/0} {0/0 ~= 0/0}`, `nil false 0.1 -0 1e+300 inf true`)
+assertEq(`{setmetatable({}, { __tostring = function() return "custom" end })}%`, "custom%")
+assertEq(`{vector.create(1, 2, 3)}`, tostring(vector.create(1, 2, 3)))
+assert(not pcall(function() return `{setmetatable({}, { __tostring = function() return {} end })}` end))
+
+-- long results, with and without numbers
+local long = string.rep("x", 600)
+assertEq(`{long}%{long}`, long .. "%" .. long)
+assertEq(`{long}{1.5}{long}{2}`, long .. "1.5" .. long .. "2")
+assertEq(`{string.rep("y", 500)}{0.1}{0.2}`, string.rep("y", 500) .. "0.10.2")
+
+-- string.format uses the same path for format strings that only consist of %* and %% items
+assertEq(string.format("%*%%%*", 1, "a"), "1%a")
+assertEq(string.format("%* %d", 1, 2), "1 2")
+assert(not pcall(string.format, "%* %*", 1))
+
+local function loop(n)
+	local r = {}
+	for i = 1, n do
+		r[i] = `item {i}: {i % 2 == 0} {`nested {i}`}`
+	end
+	return r
+end
+
+local r = loop(100)
+assertEq(r[1], "item 1: false nested 1")
+assertEq(r[100], "item 100: true nested 100")
+
 return "OK"
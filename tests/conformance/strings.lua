@@ -127,6 +127,11 @@ assert(string.format("%c",34)..string.format("%c",48)..string.format("%c",90)..s
 assert(string.format("%s\0 is not \0%s", 'not be', 'be') == 'not be\0 is not \0be')
 assert(string.format("%%%d %010d", 10, 23) == "%10 0000000023")
 assert(tonumber(string.format("%f", 10.3)) == 10.3)
+assert(string.format("%d %i %d %d", 0, -7, 1234567890123, -2^63) == "0 -7 1234567890123 -9223372036854775808")
+assert(string.format("%d", 3.9) == "3" and string.format("%d", -3.9) == "-3")
+assert(string.format("%f %f %f", 0, -42, 2^52) == "0.000000 -42.000000 4503599627370496.000000")
+assert(string.format("%f %f %f", -0.0, 0.5, 2^60) == "-0.000000 0.500000 1152921504606846976.000000")
+assert(string.format("a%db%fc%%d", 1, 2) == "a1b2.000000c%d")
 x = string.format('"%-50s"', 'a')
 assert(#x == 52)
 assert(string.sub(x, 1, 4) == '"a  ')
@@ -223,6 +228,13 @@ do
   assert(eq(string.split("abc", "b"), {'a', 'c'}))
   assert(eq(string.split("abc", "d"), {'abc'}))
   assert(eq(string.split("abc", "c"), {'ab', ''}))
+  assert(eq(string.split("a,b,,c"), {'a', 'b', '', 'c'}))
+  assert(eq(string.split("", ","), {''}))
+  assert(eq(string.split("", ""), {}))
+  assert(eq(string.split("aaa", "aa"), {'', 'a'}))
+  assert(eq(string.split("x::y::z", "::"), {'x', 'y', 'z'}))
+  assert(eq(string.split("a\0b\0c", "\0"), {'a', 'b', 'c'}))
+  assert(eq(string.split("ab", "abc"), {'ab'}))
 end
 
 -- validate that variadic string fast calls get correct number of arguments
@@ -232,6 +244,93 @@ end
 
 assert(chr1("0") == "\0")
 
+-- long strings are not interned, but behave the same way as short strings
+do
+  local function long(n, c)
+    return string.rep(c or "x", n)
+  end
+
+  local a, b = long(5000), long(4999) .. "x"
+  assert(a == b and rawequal(a, b) and not (a ~= b))
+  assert(a ~= long(5000, "y") and a ~= long(4999))
+  assert(a == table.concat({long(2500), long(2500)}))
+  assert(a == buffer.tostring(buffer.fromstring(a)))
+
+  -- comparisons with constants
+  local function isconstant(s)
+    return s == [[
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz
+]]
+  end
+
+  local c = long(20, "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz\n")
+  assert(isconstant(c))
+  assert(not isconstant(long(20, "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz!")))
+
+  -- table keys
+  local t = {}
+  t[a] = 1
+  assert(t[b] == 1 and t[long(5000)] == 1)
+  t[b] = 2
+  assert(t[a] == 2)
+
+  local count = 0
+  for key, value in pairs(t) do
+    assert(key == a and value == 2)
+    count += 1
+  end
+  assert(count == 1)
+
+  t[long(5000)] = nil
+  assert(next(t) == nil)
+
+  for i = 1, 100 do
+    t[long(2000 + i)] = i
+  end
+  for i = 1, 100 do
+    assert(t[long(1999 + i) .. "x"] == i)
+  end
+
+  assert(({[a] = true})[b])
+  assert(table.find({long(10), long(5000)}, b) == 2)
+
+  -- method calls with a long name find methods of the object that are stored under a different string object
+  local base = {}
+  base.__index = base
+
+  local call = loadstring("local base = ... function base." .. long(1500, "m") .. "(self) return 'base' end " ..
+    "return function(o) return o:" .. long(1500, "m") .. "() end")(base)
+
+  local obj = setmetatable({}, base)
+  for i = 1, 3 do
+    assert(call(obj) == "base")
+  end
+
+  local own = setmetatable({}, base)
+  own[long(1500, "m")] = function(self) return "own" end
+  assert(call(own) == "own")
+  assert(call(obj) == "base")
+end
+
 --[[
 local locales = { "ptb", "ISO-8859-1", "pt_BR" }
 local function trylocale (w)
@@ -438,6 +438,17 @@ do
   assert(table.concat({1, 2, 3}, ",") == "1,2,3")
   assert(table.concat({"a", 2, "c"}, ",") == "a,2,c")
 
+  -- long results, which are sized exactly in advance when all values are strings
+  local parts = {}
+  for i = 1, 1000 do parts[i] = string.rep(string.char(97 + i % 26), i % 7) end
+  local joined = table.concat(parts, ", ")
+  local expected = ""
+  for i = 1, #parts do expected ..= (if i > 1 then ", " else "") .. parts[i] end
+  assert(joined == expected)
+  assert(table.concat(parts, "", 10, 20) == table.concat({table.unpack(parts, 10, 20)}))
+  assert(table.concat(parts, ",", 1000, 1000) == parts[1000])
+  assert(#table.concat(table.create(300, "abc")) == 900)
+
   -- error cases
   assert(pcall(table.concat, "") == false)
   assert(pcall(table.concat, t, false) == false)
@@ -564,6 +575,113 @@ do
   assert(not pcall(table.clone, 42))
 end
 
+-- test that clones share storage until either table is modified
+do
+  local function check(t, n, k)
+    assert(#t == n)
+    for i = 1, n do assert(t[i] == i) end
+    assert(t.k == k)
+  end
+
+  local function make()
+    local t = {k = "k"}
+    for i = 1, 100 do t[i] = i end
+    return t
+  end
+
+  -- all kinds of writes to either table
+  local writes = {
+    function(t) t[1] = 1 end,
+    function(t) t.k = "k" end,
+    function(t) t.new = true; t.new = nil end,
+    function(t) rawset(t, "k", "k") end,
+    function(t) table.insert(t, 101); table.remove(t) end,
+    function(t) table.sort(t) end,
+    function(t) table.move(t, 1, 100, 1) end,
+    function(t) local k = "k"; t[k] = "k" end,
+  }
+
+  for _, write in writes do
+    local t = make()
+    local tt = table.clone(t)
+    write(t)
+    t[1] = 0
+    assert(tt[1] == 1)
+    t[1] = 1
+    check(t, 100, "k")
+    check(tt, 100, "k")
+
+    t = make()
+    tt = table.clone(t)
+    write(tt)
+    tt.k = "kk"
+    tt[50] = 0
+    check(t, 100, "k")
+    assert(tt.k == "kk" and tt[50] == 0)
+  end
+
+  -- chains of clones
+  local t = make()
+  local c1 = table.clone(t)
+  local c2 = table.clone(c1)
+  local c3 = table.clone(t)
+  c2[1] = "c2"
+  c1.k = "c1"
+  check(t, 100, "k")
+  check(c3, 100, "k")
+  assert(c2[1] == "c2" and c2.k == "k")
+  assert(c1[1] == 1 and c1.k == "c1")
+  t = nil
+  c3 = nil
+  collectgarbage()
+  c2[2] = "c2"
+  assert(c1[2] == 2)
+  c1 = nil
+  c2 = nil
+  collectgarbage()
+
+  -- clones of frozen tables
+  local f = table.freeze(make())
+  local fc = table.clone(f)
+  assert(not table.isfrozen(fc))
+  check(fc, 100, "k")
+  fc[1] = "fc"
+  assert(f[1] == 1 and fc[1] == "fc")
+  assert(not pcall(function() f[1] = 2 end))
+  assert(not pcall(rawset, f, 1, 2))
+
+  -- freezing a clone doesn't affect the source
+  local t = make()
+  local tt = table.freeze(table.clone(t))
+  assert(table.isfrozen(tt) and not table.isfrozen(t))
+  t[1] = "t"
+  assert(tt[1] == 1)
+  assert(not pcall(function() tt[1] = 2 end))
+
+  -- clearing
+  local t = make()
+  local tt = table.clone(t)
+  table.clear(tt)
+  check(t, 100, "k")
+  assert(next(tt) == nil)
+
+  -- iteration over a clone after the source was modified
+  local t = make()
+  local tt = table.clone(t)
+  for i = 1, 100 do t[i] = nil end
+  local count = 0
+  for k, v in tt do count += 1 end
+  assert(count == 101)
+
+  -- weak clones
+  local w = setmetatable({}, {__mode = "k"})
+  w[{}] = 1
+  local wc = table.clone(w)
+  collectgarbage()
+  wc.x = 1
+  collectgarbage()
+end
+
 -- test boundary invariant maintenance during rehash
 do
   local arr = table.create(5, 42)
@@ -610,6 +728,24 @@ do
   assert(#t2 == 6)
 end
 
+-- test boundary hint maintenance in tables with a small hash part
+do
+  local t = {n = 0, x = 1}
+  for i = 1, 100 do
+    t[#t + 1] = i
+    assert(#t == i)
+  end
+  for i = 100, 1, -1 do
+    t[i] = nil
+    assert(#t == i - 1)
+  end
+  for i = 1, 8 do
+    t["k" .. i] = i -- fill the hash part so that free positions have to be searched for
+    t[#t + 1] = i
+    assert(#t == i)
+  end
+end
+
 -- test boundary invariant in sparse arrays or various kinds
 do
   local function obscuredalloc() return {} end
@@ -754,4 +890,66 @@ assert((function ()
   return t.hi
 end)() == nil)
 
+-- values stored into table fields are reused by later reads, including through other references to the same table
+do
+  local function f(a)
+    local t = {x = a, y = a}
+    local u = t
+    t.x = a * 2
+    u.x = a * 3
+    t.y = nil
+    return t.x, t.y, u.x
+  end
+
+  for i = 1, 3 do
+    local x, y, z = f(1)
+    assert(x == 3 and y == nil and z == 3)
+  end
+end
+
+-- tables constructed from the same shape in different functions are independent
+do
+  local function a(x) return {x = x, y = 1} end
+  local function b(x) return {x = x, y = 2} end
+  local function c(x) return {y = 3, x = x} end
+
+  local ta, tb, tc = a(1), b(2), c(3)
+  ta.z = true
+  tb.x = nil
+
+  assert(ta.x == 1 and ta.y == 1 and ta.z == true)
+  assert(tb.x == nil and tb.y == 2 and tb.z == nil)
+  assert(tc.x == 3 and tc.y == 3 and tc.z == nil)
+  assert(a(4).z == nil and b(5).x == 5)
+end
+
+-- tables constructed from templates with constant values are independent copies
+do
+  local function record(x) return {id = 1, name = "a", flag = true, v = x, id2 = 2.5} end
+
+  local r1, r2 = record(1), record(2)
+  r1.id = 10
+  r1.name = nil
+  r2.extra = r1
+
+  assert(r1.id == 10 and r1.name == nil and r1.flag == true and r1.v == 1 and r1.id2 == 2.5)
+  assert(r2.id == 1 and r2.name == "a" and r2.v == 2 and r2.extra == r1)
+  assert(record(3).id == 1 and record(3).name == "a" and record(3).extra == nil)
+
+  -- the last value of a repeated key wins
+  local function dup(x) return {a = x, a = 1}, {a = 1, a = x} end
+  local d1, d2 = dup(5)
+  assert(d1.a == 1 and d2.a == 5)
+
+  -- iteration visits every field once
+  local count = 0
+  for k, v in record(4) do count += 1 end
+  assert(count == 5)
+
+  local data = {}
+  for i = 1, 100 do data[i] = {kind = "item", weight = 0.5} end
+  data[1].weight = 1
+  assert(data[2].weight == 0.5 and data[100].kind == "item")
+end
+
 return"OK"
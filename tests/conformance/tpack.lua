@@ -326,4 +326,49 @@ do    -- testing out of range values
   checkerror("missing size", unpack, "c-2", "")
 end
 
+do    -- unpacking from buffers reads the data in place
+  local b = buffer.fromstring(pack("<i4zs1d", 42, "hello", "hi", 0.5))
+  local i, z, s, d, next = unpack("<i4zs1d", b)
+  assert(i == 42 and z == "hello" and s == "hi" and d == 0.5 and next == buffer.len(b) + 1)
+  assert(unpack("<i4", b, 1) == 42)
+  assert(unpack("z", b, 5) == "hello")
+  assert(unpack("c3", b, -3) == buffer.readstring(b, buffer.len(b) - 3, 3))
+  checkerror("data string too short", unpack, "<i8", buffer.create(4))
+  checkerror("out of string", unpack, "c0", buffer.create(4), 6)
+  -- buffers are not zero-terminated
+  checkerror("unfinished string", unpack, "z", buffer.fromstring("abc"))
+end
+
+do    -- parsed formats are reused by later calls
+  for i = 1, 3 do
+    local s = pack("<i4 >i4 !4 b Xi4 i2 s1", 1, 2, 3, 4, "x")
+    assert(s == "\1\0\0\0\0\0\0\2\3\0\0\0\0\4\1x")
+    local a, b, c, d, e, next = unpack("<i4 >i4 !4 b Xi4 i2 s1", s)
+    assert(a == 1 and b == 2 and c == 3 and d == 4 and e == "x" and next == #s + 1)
+    assert(packsize("<i4 >i4 !4 b Xi4 i2") == 14)
+  end
+
+  -- formats that fail are not reused, and don't break formats that succeed later
+  for i = 1, 3 do
+    checkerror("out of limits", pack, "i4i17", 1, 2)
+    checkerror("number expected", pack, "i4i4", 1, "x")
+    assert(pack("i4i4", 1, 2) == pack("i4", 1) .. pack("i4", 2))
+  end
+
+  -- formats with more options than the cache can hold are still correct
+  local long = string.rep("b", 40)
+  for i = 1, 3 do
+    assert(select("#", unpack(long, string.rep("\1", 40))) == 41)
+  end
+
+  -- many different formats sharing the cache
+  for i = 1, 100 do
+    local fmt = "<i" .. (i % 8 + 1) .. " c" .. i
+    local s = pack(fmt, i, "")
+    assert(#s == i % 8 + 1 + i)
+    local v, str = unpack(fmt, s)
+    assert(v == i and str == string.rep("\0", i))
+  end
+end
+
 return "OK"
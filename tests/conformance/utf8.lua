@@ -45,6 +45,10 @@ local function check (s, t)
   assert(#t == #t1)
   for i = 1, #t do assert(t[i] == t1[i]) end   -- 't' is equal to 't1'
 
+  local t2 = utf8.codepoints(s)
+  assert(#t == #t2)
+  for i = 1, #t do assert(t[i] == t2[i]) end
+
   for i = 1, l do   -- for all codepoints
     local pi = utf8.offset(s, i)        -- position of i-th char
     local pi1 = utf8.offset(s, 2, pi)   -- position of next char
@@ -139,6 +143,18 @@ checkerror("continuation byte", utf8.offset, "\x80", 1)
 checkerror("out of string", utf8.len, "abc", 0, 2)
 checkerror("out of string", utf8.len, "abc", 1, 4)
 
+-- long runs of ASCII characters mixed with multi-byte sequences
+do
+  local s = string.rep("abcdefghij", 5) .. "á" .. string.rep("xyz", 7) .. "汉"
+  assert(utf8.len(s) == 50 + 1 + 21 + 1)
+  assert(utf8.len(s, 3, 49) == 47)
+  assert(utf8.len(s, 45, 51) == 7)
+  assert(utf8.len(s, 53) == 22 and not utf8.len(s, 52))
+  assert(#utf8.codepoints(s) == 73)
+  assert(select(2, utf8.len(string.rep("a", 37) .. "" .. string.rep("a", 10))) == 38)
+  assert(select(2, utf8.len(string.rep("a", 16) .. "")) == 17)
+end
+
 
 local s = "hello World"
 local t = {string.byte(s, 1, -1)}
@@ -157,6 +173,12 @@ do
   assert(#t == 0)
   checkerror("out of range", utf8.codepoint, s, -(#s + 1), 1)
   checkerror("out of range", utf8.codepoint, s, 1, #s + 1)
+  t = utf8.codepoints(s, 1, #s - 1)
+  assert(#t == 3 and t[1] == 225 and t[2] == 233 and t[3] == 237)
+  assert(#utf8.codepoints(s, 4, 3) == 0)
+  assert(#utf8.codepoints("") == 0)
+  checkerror("invalid UTF%-8 code", utf8.codepoints, s)
+  checkerror("out of range", utf8.codepoints, s, 1, #s + 1)
   -- surrogates
   assert(utf8.codepoint("\u{D7FF}") == 0xD800 - 1)
   assert(utf8.codepoint("\u{E000}") == 0xDFFF + 1)
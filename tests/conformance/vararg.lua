@@ -151,6 +151,39 @@ assert(selectmany(-2, 10, 20, 30) == "20,30")
 assert(selectone('3', 10, 20, 30) == 30)
 assert(selectmany('3', 10, 20, 30) == "30")
 
+assert(selectmany(-1, 10, 20, 30) == "30")
+assert(selectmany(-3, 10, 20, 30) == "10,20,30")
+assert(not pcall(selectmany, -4, 10, 20, 30))
+assert(not pcall(selectmany, 0, 10, 20, 30))
+assert(not pcall(selectone, 0, 10, 20, 30))
+
+function selecttwo(n, ...)
+    local a, b = select(n, ...)
+    return a, b
+end
+
+assert(select('#', selecttwo(1, 10, 20, 30)) == 2)
+assert(selecttwo(2, 10, 20, 30) == 20 and select(2, selecttwo(2, 10, 20, 30)) == 30)
+assert(select(2, selecttwo(3, 10, 20, 30)) == nil)
+assert(selecttwo(-1, 10, nil) == nil)
+
+function forwardcount(...)
+    return select('#', ...)
+end
+
+function forwardrest(_, ...)
+    return select(2, ...)
+end
+
+assert(forwardcount() == 0 and forwardcount(nil, nil) == 2)
+assert(select('#', forwardrest(1, 2, nil, 4)) == 2)
+
+-- forwarding more values than fit into the current stack
+local many = {}
+for i = 1, 5000 do many[i] = i end
+assert(select('#', forwardrest(0, table.unpack(many))) == 4999)
+assert(select(4999, forwardrest(0, table.unpack(many))) == 5000)
+
 -- varargs for main chunks
 f = loadstring[[ return {...} ]]
 x = f(2,3)
@@ -0,0 +1,96 @@
+-- This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+print('testing vector library')
+
+function ecall(fn, ...)
+	local ok, err = pcall(fn, ...)
+	assert(not ok)
+	return err:sub((err:find(": ") or -1) + 2, #err)
+end
+
+-- calls through a function value are never compiled as builtins, so these check the library against the fast paths
+local function call(fn, ...)
+	return fn(...)
+end
+
+local function eq(a: vector, b: vector)
+	return a.x == b.x and a.y == b.y and a.z == b.z
+end
+
+-- creation and constants
+assert(eq(vector.create(1, 2, 3), call(vector.create, 1, 2, 3)))
+assert(vector.create(1, 2, 3).y == 2)
+assert(eq(vector.zero, vector.create(0, 0, 0)))
+assert(eq(vector.one, vector.create(1, 1, 1)))
+
+-- magnitude and dot
+assert(vector.magnitude(vector.create(3, 4, 0)) == 5)
+assert(vector.magnitude(vector.create(1, 2, 2)) == 3)
+assert(vector.dot(vector.create(1, 2, 3), vector.create(4, 5, 6)) == 32)
+assert(vector.dot(vector.create(1, 0, 0), vector.create(0, 1, 0)) == 0)
+
+local function checkdot(a: vector, b: vector)
+	assert(vector.dot(a, b) == call(vector.dot, a, b))
+	assert(vector.magnitude(a) == call(vector.magnitude, a))
+	assert(eq(vector.normalize(a), call(vector.normalize, a)))
+end
+
+checkdot(vector.create(0.1, 0.2, 0.3), vector.create(0.7, -1.3, 2.9))
+checkdot(vector.create(1e10, 1e-10, 3), vector.create(-1e10, 1e10, 0.25))
+checkdot(vector.create(123.456, -0.001, 7), vector.create(1 / 3, 2 / 3, 1))
+
+-- normalize
+assert(eq(vector.normalize(vector.create(0, 5, 0)), vector.create(0, 1, 0)))
+assert(math.abs(vector.magnitude(vector.normalize(vector.create(1, 2, 3))) - 1) < 1e-6)
+
+local n = vector.normalize(vector.zero)
+assert(n.x ~= n.x and n.y ~= n.y and n.z ~= n.z)
+
+-- cross
+assert(eq(vector.cross(vector.create(1, 0, 0), vector.create(0, 1, 0)), vector.create(0, 0, 1)))
+assert(eq(vector.cross(vector.create(0, 1, 0), vector.create(1, 0, 0)), vector.create(0, 0, -1)))
+assert(eq(vector.cross(vector.create(1, 2, 3), vector.create(4, 5, 6)), call(vector.cross, vector.create(1, 2, 3), vector.create(4, 5, 6))))
+
+-- component-wise functions
+assert(eq(vector.floor(vector.create(1.5, -1.5, 2)), vector.create(1, -2, 2)))
+assert(eq(vector.ceil(vector.create(1.5, -1.5, 2)), vector.create(2, -1, 2)))
+assert(eq(vector.abs(vector.create(-1, 2, -0.5)), vector.create(1, 2, 0.5)))
+assert(eq(vector.sign(vector.create(-3, 0, 4)), vector.create(-1, 0, 1)))
+
+assert(eq(vector.clamp(vector.create(-1, 5, 10), vector.create(0, 0, 0), vector.create(4, 4, 4)), vector.create(0, 4, 4)))
+assert(eq(vector.clamp(vector.create(1, 2, 3), vector.create(1, 2, 3), vector.create(1, 2, 3)), vector.create(1, 2, 3)))
+
+assert(eq(vector.min(vector.create(1, 5, 3)), vector.create(1, 5, 3)))
+assert(eq(vector.min(vector.create(1, 5, 3), vector.create(4, 2, 6)), vector.create(1, 2, 3)))
+assert(eq(vector.min(vector.create(1, 5, 3), vector.create(4, 2, 6), vector.create(0, 9, -1)), vector.create(0, 2, -1)))
+assert(eq(vector.max(vector.create(1, 5, 3), vector.create(4, 2, 6)), vector.create(4, 5, 6)))
+assert(eq(vector.max(vector.create(1, 5, 3), vector.create(4, 2, 6), vector.create(0, 9, -1)), vector.create(4, 9, 6)))
+
+assert(eq(vector.lerp(vector.create(0, 10, 20), vector.create(10, 20, 40), 0.5), vector.create(5, 15, 30)))
+assert(eq(vector.lerp(vector.create(1, 2, 3), vector.create(4, 5, 6), 0), vector.create(1, 2, 3)))
+assert(eq(vector.lerp(vector.create(1, 2, 3), vector.create(4, 5, 6), 1), vector.create(4, 5, 6)))
+
+-- errors are reported by the library function even when the fast path is taken
+assert(ecall(function() return vector.clamp(vector.one, vector.one, vector.zero) end) == "invalid argument #3 to 'clamp' (max must be greater than or equal to min)")
+assert(ecall(function() return vector.dot(vector.one, 1) end) == "invalid argument #2 to 'dot' (vector expected, got number)")
+assert(ecall(function() return vector.magnitude("x") end) == "invalid argument #1 to 'magnitude' (vector expected, got string)")
+assert(ecall(function() return vector.min(vector.one, vector.zero, 2) end) == "invalid argument #3 to 'min' (vector expected, got number)")
+assert(ecall(function() return vector.lerp(vector.one, vector.zero, "a") end) == "invalid argument #3 to 'lerp' (number expected, got string)")
+
+-- results in loops, which exercise native code paths after the first iteration
+local function accumulate(a: vector, b: vector, n: number)
+	local sum = 0
+	local acc = vector.zero
+
+	for i = 1, n do
+		sum += vector.dot(a, b) + vector.magnitude(a)
+		acc += vector.normalize(b)
+	end
+
+	return sum, acc
+end
+
+local sum, acc = accumulate(vector.create(1, 2, 2), vector.create(0, 0, 2), 4)
+assert(sum == (4 + 3) * 4)
+assert(eq(acc, vector.create(0, 0, 4)))
+
+return 'OK'
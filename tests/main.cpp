@@ -376,8 +376,8 @@ int main(int argc, char** argv)
     int level = -1;
     if (doctest::parseIntOption(argc, argv, "-O", doctest::option_int, level))
     {
-        if (level < 0 || level > 2)
-            fprintf(stderr, "Optimization level must be between 0 and 2 inclusive\n");
+        if (level < 0 || level > 3)
+            fprintf(stderr, "Optimization level must be between 0 and 3 inclusive\n");
         else
             optimizationLevel = level;
     }
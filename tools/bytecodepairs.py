@@ -0,0 +1,66 @@
+#!/usr/bin/python3
+# This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+
+# Given the output of luau-compile --text in stdin, this script outputs the most frequent pairs of adjacent bytecode instructions
+# Pairs are only counted within a function, and a pair is not counted when its second instruction is a jump target, since
+# such a sequence could not be replaced with a single fused instruction
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+# GETTABLEKS R10 R1 K18 ['s']
+# L1: DIV R14 R13 R3
+re_bc = re.compile(r'^(L\d+: )?([A-Z_]+)\b')
+re_function = re.compile(r'^Function \d+ ')
+
+def getArgs():
+    parser = argparse.ArgumentParser(description='Find frequent pairs of adjacent bytecode instructions')
+    parser.add_argument('--limit', dest='limit', type=int, default=30, help='Number of pairs to display (30 by default)')
+    parser.add_argument('--first', dest='first', help='Only display pairs that start with the given opcode')
+    return parser.parse_args()
+
+args = getArgs()
+
+count_op = defaultdict(int)
+count_pair = defaultdict(int)
+
+previous = None
+
+for line in sys.stdin.buffer.readlines():
+    line = line.decode('utf-8', errors='ignore').rstrip()
+
+    if re_function.match(line):
+        previous = None
+    elif m := re_bc.match(line):
+        op = m[2]
+
+        # compiler remarks are annotations and don't correspond to executed instructions
+        if op == 'REMARK':
+            continue
+
+        count_op[op] += 1
+
+        if previous and not m[1]:
+            count_pair[(previous, op)] += 1
+
+        previous = op
+
+total = sum(count_op.values())
+
+if total == 0:
+    print("No bytecode found; expected output of luau-compile --text")
+    sys.exit(1)
+
+print(f"{total} instructions, {len(count_op)} distinct opcodes")
+print()
+
+items = sorted(count_pair.items(), key=lambda p: p[1], reverse=True)
+
+if args.first:
+    items = [(k, v) for k, v in items if k[0] == args.first]
+
+for (first, second), v in items[:args.limit]:
+    # share of the second opcode executions that directly follow the first one, i.e. how often fusion would apply
+    print(f'  {first + " " + second:40}: {v} ({v/total*100:.1f}% of instructions, {v/count_op[second]*100:.1f}% of {second})')
@@ -0,0 +1,122 @@
+#!/usr/bin/python3
+# This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+
+# Given a binary heap snapshot, this tool gathers basic statistics about the allocated objects
+# To generate a snapshot, use luaC_heapsnapshotbegin/luaC_heapsnapshotstep/luaC_heapsnapshotend
+# With --json, the snapshot is converted to a JSON file with the list of nodes and edges instead
+
+import json
+import sys
+
+TYPES = ["nil", "boolean", "lightuserdata", "number", "vector", "string", "table", "function", "userdata", "thread", "buffer", "proto", "upvalue", "deadkey"]
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+        self.names = [None] * 256
+
+    def byte(self):
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def varint(self):
+        result = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            result |= (byte & 127) << shift
+            shift += 7
+            if byte & 128 == 0:
+                return result
+
+    def delta(self, base):
+        value = self.varint()
+        return (base + ((value >> 1) ^ -(value & 1))) & 0xffffffffffffffff
+
+    def name(self):
+        value = self.varint()
+        if value == 0:
+            return None
+        if value & 1:
+            return self.names[value >> 1]
+
+        slot = self.byte()
+        length = (value >> 1) - 1
+        name = self.data[self.pos:self.pos + length].decode("utf-8", errors="replace")
+        self.pos += length
+        self.names[slot] = name
+        return name
+
+def decode(data):
+    if data[0:4] != b"LHSN" or data[4] != 2:
+        raise Exception("Unsupported snapshot format")
+
+    reader = Reader(data)
+    reader.pos = 5
+
+    nodes = {}
+    edges = []
+    roots = {}
+    categories = {}
+    lastnode = 0
+
+    while True:
+        tag = reader.byte()
+
+        if tag == 0:
+            return { "nodes": nodes, "edges": edges, "roots": roots, "categories": categories, "size": reader.varint() }
+        elif tag == 1:
+            lastnode = reader.delta(lastnode)
+            tt = reader.byte()
+            cat = reader.byte()
+            size = reader.varint()
+            nodes[hex(lastnode)] = { "type": TYPES[tt] if tt < len(TYPES) else "native", "cat": cat, "size": size, "name": reader.name() }
+        elif tag == 2:
+            source = reader.delta(lastnode)
+            target = reader.delta(source)
+            edges.append((hex(source), hex(target), reader.name()))
+        elif tag == 3:
+            ptr = reader.delta(0)
+            roots[reader.name()] = hex(ptr)
+        elif tag == 4:
+            cat = reader.byte()
+            categories[cat] = reader.varint()
+        else:
+            raise Exception("Unexpected record {} at offset {}".format(tag, reader.pos - 1))
+
+def updatesize(d, k, s):
+    oc, os = d.get(k, (0, 0))
+    d[k] = (oc + 1, os + s)
+
+def sortedsize(p):
+    return sorted(p, key = lambda s: s[1][1], reverse = True)
+
+with open(sys.argv[-1], "rb") as f:
+    snapshot = decode(f.read())
+
+if "--json" in sys.argv:
+    json.dump(snapshot, sys.stdout, indent = 1)
+    sys.exit(0)
+
+size_type = {}
+size_category = {}
+
+for addr, obj in snapshot["nodes"].items():
+    updatesize(size_type, obj["type"], obj["size"])
+    updatesize(size_category, str(obj["cat"]), obj["size"])
+
+print("objects by type:")
+for type, (count, size) in sortedsize(size_type.items()):
+    print(type.ljust(10), str(size).rjust(8), "bytes", str(count).rjust(5), "objects")
+
+print()
+
+print("objects by category:")
+for type, (count, size) in sortedsize(size_category.items()):
+    print(type.ljust(20), str(size).rjust(8), "bytes", str(count).rjust(5), "objects")
+
+print()
+
+print("total heap size:", snapshot["size"], "bytes,", len(snapshot["nodes"]), "objects,", len(snapshot["edges"]), "references")
@@ -11,6 +11,7 @@ import json
 argumentParser = argparse.ArgumentParser(description='Generate flamegraph SVG from Luau sampling profiler dumps')
 argumentParser.add_argument('source_file', type=open)
 argumentParser.add_argument('--json', dest='useJson',action='store_const',const=1,default=0,help='Parse source_file as JSON')
+argumentParser.add_argument('--alloc', dest='useBytes',action='store_const',const=1,default=0,help='Treat samples as allocated bytes (for --profile-alloc dumps)')
 
 class Node(svg.Node):
     def __init__(self):
@@ -30,7 +31,8 @@ class Node(svg.Node):
             return self.function
 
     def details(self, root):
-        return "Function: {} [{}:{}] ({:,} usec, {:.1%}); self: {:,} usec".format(self.function, self.source, self.line, self.width, self.width / root.width, self.ticks)
+        unit = "bytes" if arguments.useBytes else "usec"
+        return "Function: {} [{}:{}] ({:,} {}, {:.1%}); self: {:,} {}".format(self.function, self.source, self.line, self.width, unit, self.width / root.width, self.ticks, unit)
 
 
 def nodeFromCallstackListFile(source_file):
@@ -174,4 +176,4 @@ else:
 
 
 svg.layout(root, lambda n: n.ticks)
-svg.display(root, "Flame Graph", "hot", flip = True)
+svg.display(root, "Allocation Graph" if arguments.useBytes else "Flame Graph", "hot", flip = True)